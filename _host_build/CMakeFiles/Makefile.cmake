@@ -0,0 +1,155 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/VerifyGlobs.cmake"
+  "CMakeFiles/cmake.verify_globs"
+  "/root/repo/demos/CMakeLists.txt"
+  "/root/repo/demos/ble/CMakeLists.txt"
+  "/root/repo/demos/defender/CMakeLists.txt"
+  "/root/repo/demos/dev_mode_key_provisioning/CMakeLists.txt"
+  "/root/repo/demos/greengrass_connectivity/CMakeLists.txt"
+  "/root/repo/demos/mqtt/CMakeLists.txt"
+  "/root/repo/demos/ota/CMakeLists.txt"
+  "/root/repo/demos/posix/CMakeLists.txt"
+  "/root/repo/demos/shadow/CMakeLists.txt"
+  "/root/repo/demos/tcp/CMakeLists.txt"
+  "/root/repo/demos/wifi_provisioning/CMakeLists.txt"
+  "/root/repo/libraries/3rdparty/CMakeLists.txt"
+  "/root/repo/libraries/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/ble_hal/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/pkcs11/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/platform/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/posix/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/secure_sockets/CMakeLists.txt"
+  "/root/repo/libraries/abstractions/wifi/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/aws/defender/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/aws/shadow/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/standard/ble/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/standard/common/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/standard/mqtt/CMakeLists.txt"
+  "/root/repo/libraries/c_sdk/standard/serializer/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/aws/greengrass/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/aws/ota/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/aws/ota/ota_job_doc_hash.cmake"
+  "/root/repo/libraries/freertos_plus/aws/ota/src/aws_iot_ota_agent.c"
+  "/root/repo/libraries/freertos_plus/aws/ota/src/aws_ota_job_doc_hash.h"
+  "/root/repo/libraries/freertos_plus/standard/crypto/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_posix/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/standard/tls/CMakeLists.txt"
+  "/root/repo/libraries/freertos_plus/standard/utils/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tools/cmake/afr.cmake"
+  "/root/repo/tools/cmake/afr_metadata.cmake"
+  "/root/repo/tools/cmake/afr_module.cmake"
+  "/root/repo/tools/cmake/afr_utils.cmake"
+  "/root/repo/vendors/beken/manifest.cmake"
+  "/root/repo/vendors/pc/boards/linux/CMakeLists.txt"
+  "/root/repo/vendors/pc/manifest.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython3.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "vendors/pc/boards/linux/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/aws/defender/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/aws/shadow/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/standard/ble/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/standard/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/standard/mqtt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/c_sdk/standard/serializer/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/aws/greengrass/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/aws/ota/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/standard/crypto/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/standard/freertos_plus_posix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/standard/freertos_plus_tcp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/standard/tls/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/freertos_plus/standard/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/ble_hal/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/pkcs11/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/platform/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/posix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/secure_sockets/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/abstractions/wifi/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libraries/3rdparty/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/ble/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/defender/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/dev_mode_key_provisioning/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/greengrass_connectivity/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/mqtt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/ota/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/posix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/shadow/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/tcp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demos/wifi_provisioning/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "CMakeFiles/afr_dev_mode_key_provisioning.dir/DependInfo.cmake"
+  "CMakeFiles/afr_defender.dir/DependInfo.cmake"
+  "CMakeFiles/afr_mqtt.dir/DependInfo.cmake"
+  "CMakeFiles/afr_serializer.dir/DependInfo.cmake"
+  "CMakeFiles/afr_shadow.dir/DependInfo.cmake"
+  "CMakeFiles/afr_greengrass.dir/DependInfo.cmake"
+  "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/DependInfo.cmake"
+  "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/DependInfo.cmake"
+  "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/DependInfo.cmake"
+  "vendors/pc/boards/linux/CMakeFiles/linux_tap_interface.dir/DependInfo.cmake"
+  "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/DependInfo.cmake"
+  "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,717 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.c")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/mbedtls/library/aes.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/aesni.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/arc4.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/asn1parse.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/asn1write.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/base64.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/bignum.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/blowfish.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/camellia.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ccm.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/certs.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/chacha20.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/chachapoly.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cipher.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cipher_wrap.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cmac.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ctr_drbg.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/debug.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/des.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/dhm.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecdh.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecdsa.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecjpake.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecp.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecp_curves.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/entropy.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/entropy_poll.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/error.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/gcm.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/havege.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/hmac_drbg.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md2.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md4.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md5.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md_wrap.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/memory_buffer_alloc.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/net_sockets.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/oid.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/padlock.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pem.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pk.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pk_wrap.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkcs12.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkcs5.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkparse.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkwrite.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/platform.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/platform_util.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/poly1305.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ripemd160.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/rsa.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/rsa_internal.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha1.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha256.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha512.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cache.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_ciphersuites.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cli.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cookie.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_srv.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_ticket.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_tls.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/threading.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/timing.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/version.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/version_features.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_create.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_crl.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_crt.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_csr.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509write_crt.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509write_csr.c"
+  "/root/repo/libraries/3rdparty/mbedtls/library/xtea.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.h")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecp_p256_tables.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/library/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.c")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.h")
+set(OLD_GLOB
+  "/root/repo/freertos_kernel/include/FreeRTOS.h"
+  "/root/repo/freertos_kernel/include/atomic.h"
+  "/root/repo/freertos_kernel/include/deprecated_definitions.h"
+  "/root/repo/freertos_kernel/include/event_groups.h"
+  "/root/repo/freertos_kernel/include/list.h"
+  "/root/repo/freertos_kernel/include/message_buffer.h"
+  "/root/repo/freertos_kernel/include/mpu_prototypes.h"
+  "/root/repo/freertos_kernel/include/mpu_wrappers.h"
+  "/root/repo/freertos_kernel/include/portable.h"
+  "/root/repo/freertos_kernel/include/projdefs.h"
+  "/root/repo/freertos_kernel/include/queue.h"
+  "/root/repo/freertos_kernel/include/semphr.h"
+  "/root/repo/freertos_kernel/include/stack_macros.h"
+  "/root/repo/freertos_kernel/include/stream_buffer.h"
+  "/root/repo/freertos_kernel/include/task.h"
+  "/root/repo/freertos_kernel/include/timers.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/freertos_kernel/include/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.c")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.h")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/aes.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/aesni.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/arc4.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/asn1.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/asn1write.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/base64.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/bignum.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/blowfish.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/bn_mul.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/camellia.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ccm.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/certs.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/chacha20.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/chachapoly.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/check_config.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/cipher.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/cipher_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/cmac.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/compat-1.3.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/config.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ctr_drbg.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/debug.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/des.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/dhm.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ecdh.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ecdsa.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ecjpake.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ecp.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ecp_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/entropy.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/entropy_poll.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/error.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/gcm.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/havege.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/hmac_drbg.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/md.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/md2.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/md4.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/md5.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/md_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/memory_buffer_alloc.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/net.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/net_sockets.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/oid.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/padlock.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/pem.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/pk.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/pk_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/pkcs12.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/pkcs5.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/platform.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/platform_time.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/platform_util.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/poly1305.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ripemd160.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/rsa.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/rsa_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/sha1.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/sha256.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/sha512.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl_cache.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl_ciphersuites.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl_cookie.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl_internal.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/ssl_ticket.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/threading.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/timing.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/version.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/x509.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/x509_crl.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/x509_crt.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/x509_csr.h"
+  "/root/repo/libraries/3rdparty/mbedtls/include/mbedtls/xtea.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/mbedtls/include/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.c")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/tinycrypt/asn1/asn1parse.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.h")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/tinycrypt/asn1/asn1.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/asn1/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.c")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/aes_decrypt.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/aes_encrypt.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/cbc_mode.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ccm_mode.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/cmac_mode.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ctr_mode.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ctr_prng.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ecc.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ecc_dh.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ecc_dsa.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/ecc_platform_specific.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/hmac.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/hmac_prng.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/sha256.c"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/source/utils.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.h")
+set(OLD_GLOB
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/aes.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/cbc_mode.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ccm_mode.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/cmac_mode.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/constants.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ctr_mode.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ctr_prng.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ecc.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ecc_dh.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ecc_dsa.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/ecc_platform_specific.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/hmac.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/hmac_prng.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/sha256.h"
+  "/root/repo/libraries/3rdparty/tinycrypt/lib/include/tinycrypt/utils.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/3rdparty/tinycrypt/lib/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.c")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.h")
+set(OLD_GLOB
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/errno.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/fcntl.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/mqueue.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/pthread.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/sched.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/semaphore.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/signal.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/sys/types.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/time.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/unistd.h"
+  "/root/repo/libraries/abstractions/posix/include/FreeRTOS_POSIX/utils.h"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/libraries/abstractions/posix/include/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.ASM")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.C")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.H")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.S")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.asm")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.c")
+set(OLD_GLOB
+  "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/main.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.h")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# glob_result at tools/cmake/afr_utils.cmake:118 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/*.s")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_host_build/CMakeFiles/cmake.verify_globs")
+endif()
@@ -0,0 +1,31 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/c_sdk/standard/common/iot_init.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_init.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_init.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/iot_static_memory_common.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_static_memory_common.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_static_memory_common.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/logging/aws_logging_task_dynamic_buffers.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/aws_logging_task_dynamic_buffers.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/aws_logging_task_dynamic_buffers.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/logging/iot_logging.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/iot_logging.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/iot_logging.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/taskpool/iot_taskpool.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/taskpool/iot_taskpool_static_memory.c" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool_static_memory.c.o" "gcc" "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool_static_memory.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
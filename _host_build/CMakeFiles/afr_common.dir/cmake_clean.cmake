@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_init.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_init.c.o.d"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_static_memory_common.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/iot_static_memory_common.c.o.d"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/aws_logging_task_dynamic_buffers.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/aws_logging_task_dynamic_buffers.c.o.d"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/iot_logging.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/logging/iot_logging.c.o.d"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool.c.o.d"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool_static_memory.c.o"
+  "CMakeFiles/afr_common.dir/libraries/c_sdk/standard/common/taskpool/iot_taskpool_static_memory.c.o.d"
+  "afr_common.a"
+  "afr_common.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/freertos_plus/standard/crypto/src/aws_crypto.c" "CMakeFiles/afr_crypto.dir/libraries/freertos_plus/standard/crypto/src/aws_crypto.c.o" "gcc" "CMakeFiles/afr_crypto.dir/libraries/freertos_plus/standard/crypto/src/aws_crypto.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_crypto.dir/libraries/freertos_plus/standard/crypto/src/aws_crypto.c.o"
+  "CMakeFiles/afr_crypto.dir/libraries/freertos_plus/standard/crypto/src/aws_crypto.c.o.d"
+  "afr_crypto.a"
+  "afr_crypto.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_crypto.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
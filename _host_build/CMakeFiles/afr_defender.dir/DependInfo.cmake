@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/c_sdk/aws/defender/src/aws_iot_defender_api.c" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_api.c.o" "gcc" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_api.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/defender/src/aws_iot_defender_collector.c" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_collector.c.o" "gcc" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_collector.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/defender/src/aws_iot_defender_mqtt.c" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_mqtt.c.o" "gcc" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_mqtt.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/defender/src/aws_iot_defender_v1.c" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_v1.c.o" "gcc" "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_v1.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_mqtt.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_serializer.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
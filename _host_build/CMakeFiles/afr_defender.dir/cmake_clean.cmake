@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_api.c.o"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_api.c.o.d"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_collector.c.o"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_collector.c.o.d"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_mqtt.c.o"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_mqtt.c.o.d"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_v1.c.o"
+  "CMakeFiles/afr_defender.dir/libraries/c_sdk/aws/defender/src/aws_iot_defender_v1.c.o.d"
+  "afr_defender.a"
+  "afr_defender.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_defender.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
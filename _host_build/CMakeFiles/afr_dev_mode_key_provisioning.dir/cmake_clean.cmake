@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_dev_mode_key_provisioning.dir/demos/dev_mode_key_provisioning/src/aws_dev_mode_key_provisioning.c.o"
+  "CMakeFiles/afr_dev_mode_key_provisioning.dir/demos/dev_mode_key_provisioning/src/aws_dev_mode_key_provisioning.c.o.d"
+  "CMakeFiles/afr_dev_mode_key_provisioning.dir/demos/dev_mode_key_provisioning/src/pem2der.c.o"
+  "CMakeFiles/afr_dev_mode_key_provisioning.dir/demos/dev_mode_key_provisioning/src/pem2der.c.o.d"
+  "afr_dev_mode_key_provisioning.a"
+  "afr_dev_mode_key_provisioning.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_dev_mode_key_provisioning.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "afr_dev_mode_key_provisioning.a"
+)
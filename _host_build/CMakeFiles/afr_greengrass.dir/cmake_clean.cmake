@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_greengrass.dir/libraries/3rdparty/jsmn/jsmn.c.o"
+  "CMakeFiles/afr_greengrass.dir/libraries/3rdparty/jsmn/jsmn.c.o.d"
+  "CMakeFiles/afr_greengrass.dir/libraries/freertos_plus/aws/greengrass/src/aws_greengrass_discovery.c.o"
+  "CMakeFiles/afr_greengrass.dir/libraries/freertos_plus/aws/greengrass/src/aws_greengrass_discovery.c.o.d"
+  "CMakeFiles/afr_greengrass.dir/libraries/freertos_plus/aws/greengrass/src/aws_helper_secure_connect.c.o"
+  "CMakeFiles/afr_greengrass.dir/libraries/freertos_plus/aws/greengrass/src/aws_helper_secure_connect.c.o.d"
+  "afr_greengrass.a"
+  "afr_greengrass.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_greengrass.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
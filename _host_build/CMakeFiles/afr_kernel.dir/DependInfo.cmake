@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/freertos_kernel/event_groups.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/event_groups.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/event_groups.c.o.d"
+  "/root/repo/freertos_kernel/list.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/list.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/list.c.o.d"
+  "/root/repo/freertos_kernel/portable/MemMang/heap_4.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/MemMang/heap_4.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/MemMang/heap_4.c.o.d"
+  "/root/repo/freertos_kernel/portable/ThirdParty/GCC/Posix/port.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/ThirdParty/GCC/Posix/port.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/ThirdParty/GCC/Posix/port.c.o.d"
+  "/root/repo/freertos_kernel/queue.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/queue.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/queue.c.o.d"
+  "/root/repo/freertos_kernel/stream_buffer.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/stream_buffer.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/stream_buffer.c.o.d"
+  "/root/repo/freertos_kernel/tasks.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/tasks.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/tasks.c.o.d"
+  "/root/repo/freertos_kernel/timers.c" "CMakeFiles/afr_kernel.dir/freertos_kernel/timers.c.o" "gcc" "CMakeFiles/afr_kernel.dir/freertos_kernel/timers.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
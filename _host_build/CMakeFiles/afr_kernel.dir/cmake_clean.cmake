@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/event_groups.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/event_groups.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/list.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/list.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/MemMang/heap_4.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/MemMang/heap_4.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/ThirdParty/GCC/Posix/port.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/portable/ThirdParty/GCC/Posix/port.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/queue.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/queue.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/stream_buffer.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/stream_buffer.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/tasks.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/tasks.c.o.d"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/timers.c.o"
+  "CMakeFiles/afr_kernel.dir/freertos_kernel/timers.c.o.d"
+  "afr_kernel.a"
+  "afr_kernel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_kernel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/aws_mqtt_agent.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/aws_mqtt_agent.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_api.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_api.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_network.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_network.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_operation.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_operation.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_serialize.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_serialize.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_static_memory.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_static_memory.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_subscription.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_subscription.c.o.d"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_validate.c.o"
+  "CMakeFiles/afr_mqtt.dir/libraries/c_sdk/standard/mqtt/src/iot_mqtt_validate.c.o.d"
+  "afr_mqtt.a"
+  "afr_mqtt.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_mqtt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
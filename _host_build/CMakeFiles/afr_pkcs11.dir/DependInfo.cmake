@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/abstractions/pkcs11/mbedtls/aws_pkcs11_mbedtls.c" "CMakeFiles/afr_pkcs11.dir/libraries/abstractions/pkcs11/mbedtls/aws_pkcs11_mbedtls.c.o" "gcc" "CMakeFiles/afr_pkcs11.dir/libraries/abstractions/pkcs11/mbedtls/aws_pkcs11_mbedtls.c.o.d"
+  "/root/repo/vendors/pc/boards/linux/ports/pkcs11/aws_pkcs11_pal.c" "CMakeFiles/afr_pkcs11.dir/vendors/pc/boards/linux/ports/pkcs11/aws_pkcs11_pal.c.o" "gcc" "CMakeFiles/afr_pkcs11.dir/vendors/pc/boards/linux/ports/pkcs11/aws_pkcs11_pal.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
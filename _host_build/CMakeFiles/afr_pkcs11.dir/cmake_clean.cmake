@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_pkcs11.dir/libraries/abstractions/pkcs11/mbedtls/aws_pkcs11_mbedtls.c.o"
+  "CMakeFiles/afr_pkcs11.dir/libraries/abstractions/pkcs11/mbedtls/aws_pkcs11_mbedtls.c.o.d"
+  "CMakeFiles/afr_pkcs11.dir/vendors/pc/boards/linux/ports/pkcs11/aws_pkcs11_pal.c.o"
+  "CMakeFiles/afr_pkcs11.dir/vendors/pc/boards/linux/ports/pkcs11/aws_pkcs11_pal.c.o.d"
+  "afr_pkcs11.a"
+  "afr_pkcs11.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_pkcs11.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/abstractions/platform/freertos/iot_clock_afr.c" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_clock_afr.c.o" "gcc" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_clock_afr.c.o.d"
+  "/root/repo/libraries/abstractions/platform/freertos/iot_metrics.c" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_metrics.c.o" "gcc" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_metrics.c.o.d"
+  "/root/repo/libraries/abstractions/platform/freertos/iot_network_afr.c" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_network_afr.c.o" "gcc" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_network_afr.c.o.d"
+  "/root/repo/libraries/abstractions/platform/freertos/iot_threads_afr.c" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_threads_afr.c.o" "gcc" "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_threads_afr.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_clock_afr.c.o"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_clock_afr.c.o.d"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_metrics.c.o"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_metrics.c.o.d"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_network_afr.c.o"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_network_afr.c.o.d"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_threads_afr.c.o"
+  "CMakeFiles/afr_platform.dir/libraries/abstractions/platform/freertos/iot_threads_afr.c.o.d"
+  "afr_platform.a"
+  "afr_platform.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_platform.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
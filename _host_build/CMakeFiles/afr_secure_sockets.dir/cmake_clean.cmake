@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_secure_sockets.dir/libraries/abstractions/secure_sockets/posix/aws_secure_sockets.c.o"
+  "CMakeFiles/afr_secure_sockets.dir/libraries/abstractions/secure_sockets/posix/aws_secure_sockets.c.o.d"
+  "afr_secure_sockets.a"
+  "afr_secure_sockets.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_secure_sockets.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_decoder.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_decoder.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_decoder.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_encoder.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_encoder.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_encoder.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/src/iot_json_utils.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_json_utils.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_json_utils.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/src/iot_serializer_static_memory.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_serializer_static_memory.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_serializer_static_memory.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_decoder.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_decoder.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_decoder.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_encoder.c" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_encoder.c.o" "gcc" "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_encoder.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_decoder.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_decoder.c.o.d"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_encoder.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/cbor/iot_serializer_tinycbor_encoder.c.o.d"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_json_utils.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_json_utils.c.o.d"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_serializer_static_memory.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/iot_serializer_static_memory.c.o.d"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_decoder.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_decoder.c.o.d"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_encoder.c.o"
+  "CMakeFiles/afr_serializer.dir/libraries/c_sdk/standard/serializer/src/json/aws_iot_serializer_json_encoder.c.o.d"
+  "afr_serializer.a"
+  "afr_serializer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_serializer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
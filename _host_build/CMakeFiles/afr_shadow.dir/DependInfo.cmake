@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_api.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_api.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_api.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_operation.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_operation.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_operation.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_parser.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_parser.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_parser.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_static_memory.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_static_memory.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_static_memory.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_subscription.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_subscription.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_subscription.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/src/aws_shadow.c" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_shadow.c.o" "gcc" "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_shadow.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_serializer.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_mqtt.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_api.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_api.c.o.d"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_operation.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_operation.c.o.d"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_parser.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_parser.c.o.d"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_static_memory.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_static_memory.c.o.d"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_subscription.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_iot_shadow_subscription.c.o.d"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_shadow.c.o"
+  "CMakeFiles/afr_shadow.dir/libraries/c_sdk/aws/shadow/src/aws_shadow.c.o.d"
+  "afr_shadow.a"
+  "afr_shadow.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_shadow.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
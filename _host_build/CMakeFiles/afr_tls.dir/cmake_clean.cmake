@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_tls.dir/libraries/freertos_plus/standard/tls/src/aws_tls.c.o"
+  "CMakeFiles/afr_tls.dir/libraries/freertos_plus/standard/tls/src/aws_tls.c.o.d"
+  "afr_tls.a"
+  "afr_tls.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_tls.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
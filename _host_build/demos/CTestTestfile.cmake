@@ -0,0 +1,16 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/demos
+# Build directory: /root/repo/_host_build/demos
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("ble")
+subdirs("defender")
+subdirs("dev_mode_key_provisioning")
+subdirs("greengrass_connectivity")
+subdirs("mqtt")
+subdirs("ota")
+subdirs("posix")
+subdirs("shadow")
+subdirs("tcp")
+subdirs("wifi_provisioning")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/demos/defender
+# Build directory: /root/repo/_host_build/demos/defender
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/demos/dev_mode_key_provisioning
+# Build directory: /root/repo/_host_build/demos/dev_mode_key_provisioning
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,62 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/3rdparty/lwip/src/api/api_lib.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_lib.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_lib.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/api_msg.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_msg.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_msg.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/err.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/err.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/err.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/netbuf.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netbuf.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netbuf.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/netdb.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netdb.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netdb.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/netifapi.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netifapi.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netifapi.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/sockets.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/sockets.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/sockets.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/api/tcpip.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/tcpip.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/tcpip.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/def.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/def.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/def.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/dns.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/dns.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/dns.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/inet_chksum.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/inet_chksum.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/inet_chksum.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/init.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/init.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/init.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ip.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ip.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ip.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/autoip.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/autoip.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/autoip.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/dhcp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/dhcp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/dhcp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/etharp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/etharp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/etharp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/icmp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/icmp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/icmp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/igmp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/igmp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/igmp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/ip4.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/ip4_addr.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_addr.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_addr.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv4/ip4_frag.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_frag.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_frag.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/dhcp6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/dhcp6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/dhcp6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/ethip6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ethip6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ethip6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/icmp6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/icmp6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/icmp6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/inet6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/inet6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/inet6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/ip6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/ip6_addr.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_addr.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_addr.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/ip6_frag.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_frag.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_frag.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/mld6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/mld6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/mld6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/ipv6/nd6.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/nd6.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/nd6.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/mem.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/mem.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/mem.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/memp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/memp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/memp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/netif.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/netif.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/netif.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/pbuf.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/pbuf.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/pbuf.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/raw.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/raw.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/raw.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/stats.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/stats.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/stats.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/sys.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/sys.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/sys.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/tcp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/tcp_in.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_in.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_in.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/tcp_out.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_out.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_out.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/timeouts.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/timeouts.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/timeouts.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/core/udp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/udp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/udp.c.o.d"
+  "/root/repo/libraries/3rdparty/lwip/src/netif/ethernet.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/netif/ethernet.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/netif/ethernet.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
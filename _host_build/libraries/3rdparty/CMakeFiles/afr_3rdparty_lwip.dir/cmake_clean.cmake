@@ -0,0 +1,95 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_lib.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_lib.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_msg.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/api_msg.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/err.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/err.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netbuf.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netbuf.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netdb.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netdb.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netifapi.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/netifapi.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/sockets.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/sockets.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/tcpip.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/api/tcpip.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/def.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/def.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/dns.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/dns.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/inet_chksum.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/inet_chksum.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/init.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/init.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ip.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ip.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/autoip.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/autoip.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/dhcp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/dhcp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/etharp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/etharp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/icmp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/icmp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/igmp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/igmp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_addr.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_addr.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_frag.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv4/ip4_frag.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/dhcp6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/dhcp6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ethip6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ethip6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/icmp6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/icmp6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/inet6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/inet6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_addr.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_addr.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_frag.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/ip6_frag.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/mld6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/mld6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/nd6.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/ipv6/nd6.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/mem.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/mem.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/memp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/memp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/netif.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/netif.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/pbuf.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/pbuf.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/raw.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/raw.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/stats.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/stats.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/sys.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/sys.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_in.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_in.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_out.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/tcp_out.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/timeouts.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/timeouts.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/udp.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/core/udp.c.o.d"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/netif/ethernet.c.o"
+  "CMakeFiles/afr_3rdparty_lwip.dir/lwip/src/netif/ethernet.c.o.d"
+  "afr_3rdparty_lwip.a"
+  "afr_3rdparty_lwip.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_3rdparty_lwip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
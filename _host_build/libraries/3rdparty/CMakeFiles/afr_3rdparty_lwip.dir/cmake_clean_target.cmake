@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "afr_3rdparty_lwip.a"
+)
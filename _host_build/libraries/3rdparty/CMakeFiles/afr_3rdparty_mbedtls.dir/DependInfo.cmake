@@ -0,0 +1,94 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/3rdparty/mbedtls/library/aes.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aes.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aes.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/aesni.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aesni.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aesni.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/arc4.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/arc4.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/arc4.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/asn1parse.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1parse.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1parse.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/asn1write.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1write.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1write.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/base64.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/base64.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/base64.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/bignum.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/bignum.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/bignum.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/blowfish.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/blowfish.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/blowfish.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/camellia.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/camellia.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/camellia.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ccm.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ccm.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ccm.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/certs.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/certs.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/certs.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/chacha20.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chacha20.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chacha20.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/chachapoly.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chachapoly.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chachapoly.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cipher.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cipher_wrap.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher_wrap.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher_wrap.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/cmac.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cmac.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cmac.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ctr_drbg.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ctr_drbg.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ctr_drbg.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/debug.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/debug.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/debug.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/des.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/des.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/des.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/dhm.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/dhm.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/dhm.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecdh.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdh.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdh.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecdsa.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdsa.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdsa.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecjpake.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecjpake.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecjpake.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecp.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ecp_curves.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp_curves.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp_curves.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/entropy.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/entropy_poll.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy_poll.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy_poll.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/error.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/error.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/error.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/gcm.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/gcm.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/gcm.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/havege.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/havege.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/havege.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/hmac_drbg.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/hmac_drbg.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/hmac_drbg.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md2.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md2.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md2.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md4.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md4.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md4.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md5.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md5.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md5.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/md_wrap.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md_wrap.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md_wrap.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/memory_buffer_alloc.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/memory_buffer_alloc.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/memory_buffer_alloc.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/net_sockets.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/net_sockets.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/net_sockets.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/oid.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/oid.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/oid.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/padlock.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/padlock.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/padlock.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pem.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pem.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pem.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pk.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pk_wrap.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk_wrap.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk_wrap.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkcs12.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs12.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs12.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkcs5.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs5.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs5.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkparse.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkparse.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkparse.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/pkwrite.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkwrite.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkwrite.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/platform.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/platform_util.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform_util.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform_util.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/poly1305.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/poly1305.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/poly1305.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ripemd160.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ripemd160.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ripemd160.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/rsa.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/rsa_internal.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa_internal.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa_internal.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha1.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha1.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha1.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha256.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha256.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha256.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/sha512.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha512.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha512.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cache.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cache.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cache.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_ciphersuites.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ciphersuites.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ciphersuites.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cli.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cli.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cli.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_cookie.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cookie.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cookie.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_srv.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_srv.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_srv.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_ticket.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ticket.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ticket.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/ssl_tls.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_tls.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_tls.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/threading.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/threading.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/threading.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/timing.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/timing.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/timing.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/version.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/version_features.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version_features.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version_features.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_create.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_create.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_create.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_crl.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crl.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crl.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_crt.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crt.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crt.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509_csr.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_csr.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_csr.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509write_crt.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_crt.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_crt.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/x509write_csr.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_csr.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_csr.c.o.d"
+  "/root/repo/libraries/3rdparty/mbedtls/library/xtea.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/xtea.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/xtea.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
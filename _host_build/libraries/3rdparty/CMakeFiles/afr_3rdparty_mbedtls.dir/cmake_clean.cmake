@@ -0,0 +1,159 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aes.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aes.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aesni.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/aesni.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/arc4.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/arc4.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1parse.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1parse.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1write.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/asn1write.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/base64.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/base64.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/bignum.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/bignum.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/blowfish.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/blowfish.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/camellia.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/camellia.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ccm.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ccm.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/certs.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/certs.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chacha20.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chacha20.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chachapoly.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/chachapoly.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher_wrap.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cipher_wrap.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cmac.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/cmac.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ctr_drbg.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ctr_drbg.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/debug.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/debug.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/des.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/des.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/dhm.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/dhm.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdh.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdh.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdsa.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecdsa.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecjpake.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecjpake.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp_curves.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ecp_curves.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy_poll.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/entropy_poll.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/error.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/error.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/gcm.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/gcm.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/havege.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/havege.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/hmac_drbg.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/hmac_drbg.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md2.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md2.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md4.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md4.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md5.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md5.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md_wrap.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/md_wrap.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/memory_buffer_alloc.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/memory_buffer_alloc.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/net_sockets.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/net_sockets.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/oid.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/oid.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/padlock.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/padlock.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pem.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pem.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk_wrap.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pk_wrap.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs12.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs12.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs5.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkcs5.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkparse.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkparse.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkwrite.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/pkwrite.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform_util.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/platform_util.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/poly1305.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/poly1305.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ripemd160.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ripemd160.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa_internal.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/rsa_internal.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha1.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha1.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha256.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha256.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha512.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/sha512.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cache.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cache.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ciphersuites.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ciphersuites.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cli.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cli.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cookie.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_cookie.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_srv.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_srv.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ticket.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_ticket.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_tls.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/ssl_tls.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/threading.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/threading.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/timing.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/timing.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version_features.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/version_features.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_create.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_create.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crl.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crl.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crt.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_crt.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_csr.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509_csr.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_crt.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_crt.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_csr.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/x509write_csr.c.o.d"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/xtea.c.o"
+  "CMakeFiles/afr_3rdparty_mbedtls.dir/mbedtls/library/xtea.c.o.d"
+  "afr_3rdparty_mbedtls.a"
+  "afr_3rdparty_mbedtls.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_3rdparty_mbedtls.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/3rdparty/tinycbor/cborencoder.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder.c.o.d"
+  "/root/repo/libraries/3rdparty/tinycbor/cborencoder_close_container_checked.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder_close_container_checked.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder_close_container_checked.c.o.d"
+  "/root/repo/libraries/3rdparty/tinycbor/cborerrorstrings.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborerrorstrings.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborerrorstrings.c.o.d"
+  "/root/repo/libraries/3rdparty/tinycbor/cborparser.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser.c.o.d"
+  "/root/repo/libraries/3rdparty/tinycbor/cborparser_dup_string.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser_dup_string.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser_dup_string.c.o.d"
+  "/root/repo/libraries/3rdparty/tinycbor/cborpretty.c" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborpretty.c.o" "gcc" "libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborpretty.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder.c.o.d"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder_close_container_checked.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborencoder_close_container_checked.c.o.d"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborerrorstrings.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborerrorstrings.c.o.d"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser.c.o.d"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser_dup_string.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborparser_dup_string.c.o.d"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborpretty.c.o"
+  "CMakeFiles/afr_3rdparty_tinycbor.dir/tinycbor/cborpretty.c.o.d"
+  "afr_3rdparty_tinycbor.a"
+  "afr_3rdparty_tinycbor.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/afr_3rdparty_tinycbor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
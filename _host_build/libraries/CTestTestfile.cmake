@@ -0,0 +1,26 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libraries
+# Build directory: /root/repo/_host_build/libraries
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("c_sdk/aws/defender")
+subdirs("c_sdk/aws/shadow")
+subdirs("c_sdk/standard/ble")
+subdirs("c_sdk/standard/common")
+subdirs("c_sdk/standard/mqtt")
+subdirs("c_sdk/standard/serializer")
+subdirs("freertos_plus/aws/greengrass")
+subdirs("freertos_plus/aws/ota")
+subdirs("freertos_plus/standard/crypto")
+subdirs("freertos_plus/standard/freertos_plus_posix")
+subdirs("freertos_plus/standard/freertos_plus_tcp")
+subdirs("freertos_plus/standard/tls")
+subdirs("freertos_plus/standard/utils")
+subdirs("abstractions/ble_hal")
+subdirs("abstractions/pkcs11")
+subdirs("abstractions/platform")
+subdirs("abstractions/posix")
+subdirs("abstractions/secure_sockets")
+subdirs("abstractions/wifi")
+subdirs("3rdparty")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libraries/c_sdk/aws/shadow
+# Build directory: /root/repo/_host_build/libraries/c_sdk/aws/shadow
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
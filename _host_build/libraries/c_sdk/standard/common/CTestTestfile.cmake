@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libraries/c_sdk/standard/common
+# Build directory: /root/repo/_host_build/libraries/c_sdk/standard/common
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libraries/freertos_plus/aws/greengrass
+# Build directory: /root/repo/_host_build/libraries/freertos_plus/aws/greengrass
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,68 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/3rdparty/jsmn/jsmn.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/jsmn/jsmn.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/jsmn/jsmn.c.o.d"
+  "/root/repo/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o.d"
+  "/root/repo/libraries/3rdparty/unity/src/unity.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o.d"
+  "/root/repo/libraries/abstractions/pkcs11/test/aws_test_pkcs11.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/pkcs11/test/aws_test_pkcs11.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/pkcs11/test/aws_test_pkcs11.c.o.d"
+  "/root/repo/libraries/abstractions/platform/test/iot_test_platform_clock.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_clock.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_clock.c.o.d"
+  "/root/repo/libraries/abstractions/platform/test/iot_test_platform_threads.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_threads.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_threads.c.o.d"
+  "/root/repo/libraries/abstractions/secure_sockets/test/aws_test_tcp.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/secure_sockets/test/aws_test_tcp.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/secure_sockets/test/aws_test_tcp.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/defender/test/aws_iot_tests_defender_api.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/defender/test/aws_iot_tests_defender_api.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/defender/test/aws_iot_tests_defender_api.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/test/aws_test_shadow.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/aws_test_shadow.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/aws_test_shadow.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/test/system/aws_iot_tests_shadow_system.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/system/aws_iot_tests_shadow_system.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/system/aws_iot_tests_shadow_system.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_api.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_api.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_api.c.o.d"
+  "/root/repo/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_parser.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_parser.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_parser.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/test/aws_memory_leak.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/aws_memory_leak.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/aws_memory_leak.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/common/test/iot_tests_taskpool.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/iot_tests_taskpool.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/iot_tests_taskpool.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/aws_test_mqtt_agent.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/aws_test_mqtt_agent.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/aws_test_mqtt_agent.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/system/iot_tests_mqtt_system.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/system/iot_tests_mqtt_system.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/system/iot_tests_mqtt_system.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_api.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_api.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_api.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_receive.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_receive.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_receive.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_subscription.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_subscription.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_subscription.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_validate.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_validate.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_validate.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_cbor.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_cbor.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_cbor.c.o.d"
+  "/root/repo/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_json.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_json.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_json.c.o.d"
+  "/root/repo/libraries/freertos_plus/aws/greengrass/test/aws_test_greengrass_discovery.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_greengrass_discovery.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_greengrass_discovery.c.o.d"
+  "/root/repo/libraries/freertos_plus/aws/greengrass/test/aws_test_helper_secure_connect.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_helper_secure_connect.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_helper_secure_connect.c.o.d"
+  "/root/repo/libraries/freertos_plus/aws/ota/src/aws_ota_http.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/src/aws_ota_http.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/src/aws_ota_http.c.o.d"
+  "/root/repo/libraries/freertos_plus/aws/ota/test/aws_test_ota_http.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/test/aws_test_ota_http.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/test/aws_test_ota_http.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/crypto/test/aws_test_crypto.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/crypto/test/aws_test_crypto.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/crypto/test/aws_test_crypto.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/tls/test/aws_test_tls.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/tls/test/aws_test_tls.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/tls/test/aws_test_tls.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/utils/src/aws_system_init.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/utils/src/aws_system_init.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/utils/src/aws_system_init.c.o.d"
+  "/root/repo/tests/common/aws_test.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test.c.o.d"
+  "/root/repo/tests/common/aws_test_framework.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o.d"
+  "/root/repo/tests/common/aws_test_runner.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o.d"
+  "/root/repo/tests/common/iot_test_afr.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_test_afr.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_test_afr.c.o.d"
+  "/root/repo/tests/common/iot_tests_network.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_tests_network.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_tests_network.c.o.d"
+  "/root/repo/vendors/pc/boards/linux/aws_tests/application_code/main.c" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/aws_tests/application_code/main.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/aws_tests.dir/aws_tests/application_code/main.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_secure_sockets.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_defender.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_shadow.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_serializer.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_tinycbor.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_greengrass.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_mqtt.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_common.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_platform.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_dev_mode_key_provisioning.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_tls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_pkcs11.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_crypto.dir/DependInfo.cmake"
+  "/root/repo/_host_build/libraries/3rdparty/CMakeFiles/afr_3rdparty_mbedtls.dir/DependInfo.cmake"
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
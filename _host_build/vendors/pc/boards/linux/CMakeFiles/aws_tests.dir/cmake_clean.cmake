@@ -0,0 +1,79 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/jsmn/jsmn.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/jsmn/jsmn.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/pkcs11/test/aws_test_pkcs11.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/pkcs11/test/aws_test_pkcs11.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_clock.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_clock.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_threads.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/platform/test/iot_test_platform_threads.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/secure_sockets/test/aws_test_tcp.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/abstractions/secure_sockets/test/aws_test_tcp.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/defender/test/aws_iot_tests_defender_api.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/defender/test/aws_iot_tests_defender_api.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/aws_test_shadow.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/aws_test_shadow.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/system/aws_iot_tests_shadow_system.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/system/aws_iot_tests_shadow_system.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_api.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_api.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_parser.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/aws/shadow/test/unit/aws_iot_tests_shadow_parser.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/aws_memory_leak.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/aws_memory_leak.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/iot_tests_taskpool.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/common/test/iot_tests_taskpool.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/aws_test_mqtt_agent.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/aws_test_mqtt_agent.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/system/iot_tests_mqtt_system.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/system/iot_tests_mqtt_system.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_api.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_api.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_receive.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_receive.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_subscription.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_subscription.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_validate.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/mqtt/test/unit/iot_tests_mqtt_validate.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_cbor.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_cbor.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_json.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/c_sdk/standard/serializer/test/iot_tests_serializer_json.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_greengrass_discovery.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_greengrass_discovery.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_helper_secure_connect.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/greengrass/test/aws_test_helper_secure_connect.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/src/aws_ota_http.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/src/aws_ota_http.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/test/aws_test_ota_http.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/aws/ota/test/aws_test_ota_http.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/crypto/test/aws_test_crypto.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/crypto/test/aws_test_crypto.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/tls/test/aws_test_tls.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/tls/test/aws_test_tls.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/utils/src/aws_system_init.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/libraries/freertos_plus/standard/utils/src/aws_system_init.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_test_afr.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_test_afr.c.o.d"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_tests_network.c.o"
+  "CMakeFiles/aws_tests.dir/__/__/__/__/tests/common/iot_tests_network.c.o.d"
+  "CMakeFiles/aws_tests.dir/aws_tests/application_code/main.c.o"
+  "CMakeFiles/aws_tests.dir/aws_tests/application_code/main.c.o.d"
+  "aws_tests"
+  "aws_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/aws_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
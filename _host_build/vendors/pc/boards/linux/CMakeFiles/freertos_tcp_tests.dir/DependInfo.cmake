@@ -0,0 +1,37 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o.d"
+  "/root/repo/libraries/3rdparty/unity/src/unity.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/test/aws_test_freertos_tcp.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/test/aws_test_freertos_tcp.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/test/aws_test_freertos_tcp.c.o.d"
+  "/root/repo/tests/common/aws_test.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test.c.o.d"
+  "/root/repo/tests/common/aws_test_framework.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o.d"
+  "/root/repo/tests/common/aws_test_runner.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o.d"
+  "/root/repo/vendors/pc/boards/linux/tcp_tests/application_code/main.c" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/tcp_tests/application_code/main.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/freertos_tcp_tests.dir/tcp_tests/application_code/main.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/extras/fixture/src/unity_fixture.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/3rdparty/unity/src/unity.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/test/aws_test_freertos_tcp.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/test/aws_test_freertos_tcp.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_framework.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/__/__/__/__/tests/common/aws_test_runner.c.o.d"
+  "CMakeFiles/freertos_tcp_tests.dir/tcp_tests/application_code/main.c.o"
+  "CMakeFiles/freertos_tcp_tests.dir/tcp_tests/application_code/main.c.o.d"
+  "freertos_tcp_tests"
+  "freertos_tcp_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/freertos_tcp_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
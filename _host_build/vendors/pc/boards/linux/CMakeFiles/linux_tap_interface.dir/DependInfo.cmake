@@ -0,0 +1,19 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxTAP/NetworkInterface.c" "vendors/pc/boards/linux/CMakeFiles/linux_tap_interface.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxTAP/NetworkInterface.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/linux_tap_interface.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxTAP/NetworkInterface.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/linux_tap_interface.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxTAP/NetworkInterface.c.o"
+  "CMakeFiles/linux_tap_interface.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxTAP/NetworkInterface.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/linux_tap_interface.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
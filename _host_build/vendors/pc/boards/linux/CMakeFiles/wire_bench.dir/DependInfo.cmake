@@ -0,0 +1,31 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o.d"
+  "/root/repo/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o.d"
+  "/root/repo/vendors/pc/boards/linux/wire_bench/application_code/main.c" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/wire_bench/application_code/main.c.o" "gcc" "vendors/pc/boards/linux/CMakeFiles/wire_bench.dir/wire_bench/application_code/main.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_host_build/CMakeFiles/afr_kernel.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
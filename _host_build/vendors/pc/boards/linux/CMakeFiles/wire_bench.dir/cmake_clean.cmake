@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_ARP.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DHCP.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_DNS.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_IP.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Sockets.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_Stream_Buffer.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_IP.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_TCP_WIN.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/FreeRTOS_UDP_IP.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/BufferManagement/BufferAllocation_2.c.o.d"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o"
+  "CMakeFiles/wire_bench.dir/__/__/__/__/libraries/freertos_plus/standard/freertos_plus_tcp/source/portable/NetworkInterface/LinuxWire/NetworkInterface.c.o.d"
+  "CMakeFiles/wire_bench.dir/wire_bench/application_code/main.c.o"
+  "CMakeFiles/wire_bench.dir/wire_bench/application_code/main.c.o.d"
+  "wire_bench"
+  "wire_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/wire_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/vendors/pc/boards/linux
+# Build directory: /root/repo/_host_build/vendors/pc/boards/linux
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(host_echo_server_start "/root/.pyenv/shims/python3" "/root/repo/tools/echo_server/echo_server.py" "--port" "9923" "--daemon" "--pid-file" "/root/repo/_host_build/echo_server.pid")
+set_tests_properties(host_echo_server_start PROPERTIES  FIXTURES_SETUP "host_echo" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;251;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(host_echo_server_stop "/root/.pyenv/shims/python3" "/root/repo/tools/echo_server/echo_server.py" "--stop" "--pid-file" "/root/repo/_host_build/echo_server.pid")
+set_tests_properties(host_echo_server_stop PROPERTIES  FIXTURES_CLEANUP "host_echo" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;256;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(host_http_server_start "/root/.pyenv/shims/python3" "/root/repo/tools/http_range_server/http_range_server.py" "--port" "9924" "--daemon" "--pid-file" "/root/repo/_host_build/http_range_server.pid")
+set_tests_properties(host_http_server_start PROPERTIES  FIXTURES_SETUP "host_http" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;266;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(host_http_server_stop "/root/.pyenv/shims/python3" "/root/repo/tools/http_range_server/http_range_server.py" "--stop" "--pid-file" "/root/repo/_host_build/http_range_server.pid")
+set_tests_properties(host_http_server_stop PROPERTIES  FIXTURES_CLEANUP "host_http" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;271;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(aws_tests "/root/repo/_host_build/vendors/pc/boards/linux/aws_tests")
+set_tests_properties(aws_tests PROPERTIES  FIXTURES_REQUIRED "host_echo;host_http" TIMEOUT "1800" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;278;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(freertos_tcp_tests "/root/repo/_host_build/vendors/pc/boards/linux/freertos_tcp_tests")
+set_tests_properties(freertos_tcp_tests PROPERTIES  TIMEOUT "600" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;287;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
+add_test(wire_bench "/root/repo/_host_build/vendors/pc/boards/linux/wire_bench")
+set_tests_properties(wire_bench PROPERTIES  TIMEOUT "600" _BACKTRACE_TRIPLES "/root/repo/vendors/pc/boards/linux/CMakeLists.txt;290;add_test;/root/repo/vendors/pc/boards/linux/CMakeLists.txt;0;")
@@ -52,6 +52,9 @@
 /* Key provisioning includes. */
 #include "aws_dev_mode_key_provisioning.h"
 
+/* TLS includes. */
+#include "aws_tls.h"
+
 /* mbedTLS includes. */
 #include "mbedtls/base64.h"
 /*-----------------------------------------------------------*/
@@ -302,6 +305,9 @@ CK_RV xProvisionDevice( CK_SESSION_HANDLE xSession,
         configPRINTF( ( "ERROR: Failed to provision private key %d.\r\n", xResult ) );
     }
 
+    /* Stop TLS from using credentials it decoded from the previous objects. */
+    TLS_InvalidateCredentials();
+
     return xResult;
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,511 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for a POSIX host, such as
+ * Linux.
+ *
+ * Each task is a host thread, and only one of them runs at a time: the others
+ * wait on a condition variable of their own.  A context switch wakes the
+ * thread of the task switched in, then makes the thread of the task switched
+ * out wait.
+ *
+ * The tick interrupt is SIGALRM, from an interval timer.  The running task is
+ * the only thread that does not block signals, outside critical sections, so
+ * the tick always interrupts the running task.  Threads that are not tasks
+ * must block all signals, and must not call FreeRTOS API functions.
+ *
+ * A task blocked in a host system call still holds the processor, as a task
+ * busy waiting would on a target.  System calls that the host does not
+ * restart, such as poll(), fail with EINTR when the tick interrupts them.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*-----------------------------------------------------------*/
+
+/* Only sent to the thread that started the scheduler, to end it. */
+#define portSIG_RESUME		SIGUSR1
+
+typedef struct THREAD
+{
+	pthread_t pthread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	BaseType_t xDying;
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	BaseType_t xResumed;
+} Thread_t;
+
+/*
+ * The additional per-thread data is stored at the beginning of the task's
+ * stack.
+ */
+static inline Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+
+/*-----------------------------------------------------------*/
+
+static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
+static sigset_t xAllSignals;
+static sigset_t xSchedulerOriginalSignalMask;
+static pthread_t hMainThread;
+static volatile UBaseType_t uxCriticalNesting;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+static struct timespec xStartTime;
+
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignalsAndSchedulerPolicy( void );
+static void prvSetupTimerInterrupt( void );
+static void *prvWaitForStart( void * pvParams );
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+static void prvSuspendSelf( Thread_t *pxThread );
+static void prvResumeThread( Thread_t *pxThread );
+static void prvSystemTickHandler( int iSignal );
+static void prvResumeSignalHandler( int iSignal );
+
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char *pcCall, int iErrno )
+{
+	fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack,
+									StackType_t *pxEndOfStack,
+									TaskFunction_t pxCode,
+									void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xThreadAttributes;
+size_t xStackSize;
+int iRet;
+
+	( void ) pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
+
+	/* Store the additional thread data at the start of the stack.  The
+	kernel keeps the returned top of stack in the TCB, from where
+	prvGetThreadFromTask() finds the data again. */
+	pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+	configASSERT( pxTopOfStack >= pxEndOfStack );
+
+	xStackSize = ( size_t ) ( pxTopOfStack + 1 - pxEndOfStack ) * sizeof( StackType_t );
+
+	if( xStackSize < portMIN_HOST_STACK_SIZE )
+	{
+		xStackSize = portMIN_HOST_STACK_SIZE;
+	}
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	pxThread->xResumed = pdFALSE;
+	( void ) pthread_mutex_init( &pxThread->xMutex, NULL );
+	( void ) pthread_cond_init( &pxThread->xCond, NULL );
+
+	( void ) pthread_attr_init( &xThreadAttributes );
+	( void ) pthread_attr_setstacksize( &xThreadAttributes, xStackSize );
+
+	/* The new thread inherits the signal mask, so it must be created with
+	the signals blocked. */
+	vPortEnterCritical();
+
+	iRet = pthread_create( &pxThread->pthread, &xThreadAttributes, prvWaitForStart, pxThread );
+	if( iRet != 0 )
+	{
+		prvFatalError( "pthread_create", iRet );
+	}
+
+	vPortExitCritical();
+
+	( void ) pthread_attr_destroy( &xThreadAttributes );
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+int iSignal;
+sigset_t xSignals;
+
+	hMainThread = pthread_self();
+
+	/* Start the timer that generates the tick interrupt.  Interrupts are
+	disabled here already. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	prvResumeThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+
+	/* Wait until signalled by vPortEndScheduler(). */
+	( void ) sigemptyset( &xSignals );
+	( void ) sigaddset( &xSignals, portSIG_RESUME );
+
+	while( xSchedulerEnd == pdFALSE )
+	{
+		( void ) sigwait( &xSignals, &iSignal );
+	}
+
+	/* Restore the original signal mask. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xSchedulerOriginalSignalMask, NULL );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+struct sigaction xTick;
+
+	/* Stop the timer and ignore any pending tick, which would otherwise run
+	on the thread that started the scheduler. */
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	memset( &xTick, 0, sizeof( xTick ) );
+	xTick.sa_handler = SIG_IGN;
+	( void ) sigemptyset( &xTick.sa_mask );
+	( void ) sigaction( SIGALRM, &xTick, NULL );
+
+	/* Have xPortStartScheduler() return, and stop the calling task. */
+	vPortDisableInterrupts();
+	xSchedulerEnd = pdTRUE;
+	( void ) pthread_kill( hMainThread, portSIG_RESUME );
+
+	prvSuspendSelf( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == 0 )
+	{
+		vPortDisableInterrupts();
+	}
+
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	uxCriticalNesting--;
+
+	/* If we have reached 0 then re-enable the interrupts. */
+	if( uxCriticalNesting == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	vPortEnterCritical();
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	vTaskSwitchContext();
+
+	pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+sigset_t xPrevious;
+
+	/* Signals are always blocked in the tick handler, and in tasks inside
+	critical sections. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPrevious );
+
+	return ( UBaseType_t ) sigismember( &xPrevious, SIGALRM );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the timer to generate the tick interrupts at the required frequency.
+ */
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+	xTimer.it_value = xTimer.it_interval;
+
+	if( setitimer( ITIMER_REAL, &xTimer, NULL ) != 0 )
+	{
+		prvFatalError( "setitimer", errno );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSystemTickHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	( void ) iSignal;
+
+	/* Signals are blocked in this handler, and must stay so when a critical
+	section inside it ends. */
+	uxCriticalNesting++;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		/* Select the next task. */
+		vTaskSwitchContext();
+
+		pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+		prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+	}
+
+	uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeSignalHandler( int iSignal )
+{
+	/* Never called, as the signal is only taken by sigwait(). */
+	( void ) iSignal;
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	( void ) pxPendYield;
+
+	/* The thread ends when the task switches out, rather than waiting. */
+	pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	/* The thread is not running: it either ended as its task deleted itself,
+	or waits to be resumed, so it can be cancelled. */
+	( void ) pthread_cancel( pxThread->pthread );
+	( void ) pthread_join( pxThread->pthread, NULL );
+	( void ) pthread_cond_destroy( &pxThread->xCond );
+	( void ) pthread_mutex_destroy( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void * pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvSuspendSelf( pxThread );
+
+	/* Resumed for the first time, unblocks all signals. */
+	uxCriticalNesting = 0;
+	vPortEnableInterrupts();
+
+	/* Call the task's entry point. */
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to.  If a task wants to exit it
+	should instead call vTaskDelete( NULL ). */
+	configASSERT( pdFALSE );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+
+	if( pxThreadToSuspend != pxThreadToResume )
+	{
+		/* The critical section nesting is per task, so save it on the stack
+		of the thread switched out, and restore it when it switches back in. */
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		prvResumeThread( pxThreadToResume );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		prvSuspendSelf( pxThreadToSuspend );
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockOnCancel( void *pvMutex )
+{
+	( void ) pthread_mutex_unlock( ( pthread_mutex_t * ) pvMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSelf( Thread_t *pxThread )
+{
+	/* A suspended thread must not handle signals, so this is only called
+	inside a critical section, from the tick handler, or from a thread that
+	has not started its task yet, all with the signals blocked. */
+	( void ) pthread_mutex_lock( &pxThread->xMutex );
+	pthread_cleanup_push( prvUnlockOnCancel, &pxThread->xMutex );
+
+	while( pxThread->xResumed == pdFALSE )
+	{
+		( void ) pthread_cond_wait( &pxThread->xCond, &pxThread->xMutex );
+	}
+
+	pxThread->xResumed = pdFALSE;
+
+	pthread_cleanup_pop( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( Thread_t *pxThread )
+{
+	( void ) pthread_mutex_lock( &pxThread->xMutex );
+	pxThread->xResumed = pdTRUE;
+	( void ) pthread_cond_signal( &pxThread->xCond );
+	( void ) pthread_mutex_unlock( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignalsAndSchedulerPolicy( void )
+{
+struct sigaction xResume;
+struct sigaction xTick;
+
+	hMainThread = pthread_self();
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xStartTime );
+
+	/* Don't block SIGINT, so that it can still break into a debugger
+	inside a critical section. */
+	( void ) sigfillset( &xAllSignals );
+	( void ) sigdelset( &xAllSignals, SIGINT );
+
+	/* Block all signals in this thread so that every new thread inherits
+	this mask.  A thread unblocks them when it is resumed for the first
+	time. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, &xSchedulerOriginalSignalMask );
+
+	/* portSIG_RESUME is only used with sigwait(), but must not be ignored,
+	as the host may then discard it. */
+	memset( &xResume, 0, sizeof( xResume ) );
+	xResume.sa_handler = prvResumeSignalHandler;
+	( void ) sigfillset( &xResume.sa_mask );
+
+	/* System calls that the tick interrupts carry on afterwards, where the
+	host allows it. */
+	memset( &xTick, 0, sizeof( xTick ) );
+	xTick.sa_flags = SA_RESTART;
+	xTick.sa_handler = prvSystemTickHandler;
+	( void ) sigfillset( &xTick.sa_mask );
+
+	if( sigaction( portSIG_RESUME, &xResume, NULL ) != 0 )
+	{
+		prvFatalError( "sigaction", errno );
+	}
+
+	if( sigaction( SIGALRM, &xTick, NULL ) != 0 )
+	{
+		prvFatalError( "sigaction", errno );
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTime( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( unsigned long ) ( ( xNow.tv_sec - xStartTime.tv_sec ) * 1000000L +
+							   ( xNow.tv_nsec - xStartTime.tv_nsec ) / 1000L );
+}
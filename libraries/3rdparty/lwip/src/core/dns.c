@@ -93,6 +93,10 @@
 #include "lwip/dns.h"
 #include "lwip/prot/dns.h"
 
+#ifdef LWIP_HOOK_FILENAME
+#include LWIP_HOOK_FILENAME
+#endif
+
 #include <string.h>
 
 /** Random generator function to create random TXIDs and source ports for queries */
@@ -629,6 +633,9 @@ dns_lookup(const char *name, ip_addr_t *addr LWIP_DNS_ADDRTYPE_ARG(u8_t dns_addr
       if (addr) {
         ip_addr_copy(*addr, dns_table[i].ipaddr);
       }
+#ifdef LWIP_HOOK_DNS_ANSWER
+      LWIP_HOOK_DNS_ANSWER(name, &dns_table[i].ipaddr, dns_table[i].ttl);
+#endif
       return ERR_OK;
     }
   }
@@ -1113,6 +1120,9 @@ dns_correct_response(u8_t idx, u32_t ttl)
   if (entry->ttl > DNS_MAX_TTL) {
     entry->ttl = DNS_MAX_TTL;
   }
+#ifdef LWIP_HOOK_DNS_ANSWER
+  LWIP_HOOK_DNS_ANSWER(entry->name, &entry->ipaddr, entry->ttl);
+#endif
   dns_call_found(idx, &entry->ipaddr);
 
   if (entry->ttl == 0) {
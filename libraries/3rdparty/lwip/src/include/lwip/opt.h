@@ -2574,6 +2574,20 @@
 #define LWIP_HOOK_VLAN_SET(netif, p, src, dst, eth_type)
 #endif
 
+/**
+ * LWIP_HOOK_DNS_ANSWER(name, addr, ttl):
+ * - called from the tcpip thread when a host name is resolved, before the
+ *   callbacks waiting for it, whether from a DNS response or from the
+ *   dns_table
+ * - name: the host name (const char *)
+ * - addr: the address found (const ip_addr_t *)
+ * - ttl: seconds for which the address may still be used (u32_t), at most
+ *   DNS_MAX_TTL; 0 means that it must not be cached
+ */
+#ifdef __DOXYGEN__
+#define LWIP_HOOK_DNS_ANSWER(name, addr, ttl)
+#endif
+
 /**
  * LWIP_HOOK_MEMP_AVAILABLE(memp_t_type):
  * - called from memp_free() when a memp pool was empty and an item is now available
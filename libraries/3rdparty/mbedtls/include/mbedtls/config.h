@@ -743,6 +743,42 @@
  */
 //#define MBEDTLS_ECP_RESTARTABLE
 
+/**
+ * \def MBEDTLS_ECP_P256_STATIC_TABLES
+ *
+ * Use precomputed tables of multiples of the secp256r1 base point, stored in
+ * read-only memory, instead of computing them at run time.
+ *
+ * Without this option, the first multiplication of the base point with a
+ * given group (key generation, ECDSA signature, ECDH key exchange) computes
+ * a table of points and keeps it in the group, which takes time and about
+ * 1.5 KB of RAM. As the TLS stack loads a new group for every handshake, the
+ * table is usually computed again for every operation. The tables add about
+ * 3 KB of read-only data.
+ *
+ * The tables are generated by programs/ecp/gen_p256_tables.c.
+ *
+ * Requires: MBEDTLS_ECP_DP_SECP256R1_ENABLED
+ *
+ * Comment this macro to compute the tables at run time.
+ */
+#define MBEDTLS_ECP_P256_STATIC_TABLES
+
+/**
+ * \def MBEDTLS_ECP_MULADD_WNAF
+ *
+ * Compute the linear combinations used by ECDSA signature verification,
+ * mbedtls_ecp_muladd(), with interleaved width-w NAF. Both multiplications
+ * then share their doublings and need fewer additions. The method is not
+ * constant-time, which is fine as it only handles public data.
+ *
+ * Restartable linear combinations (see MBEDTLS_ECP_RESTARTABLE) still use
+ * two separate comb multiplications.
+ *
+ * Comment this macro to compute the two multiplications separately.
+ */
+#define MBEDTLS_ECP_MULADD_WNAF
+
 /**
  * \def MBEDTLS_ECDSA_DETERMINISTIC
  *
@@ -1402,6 +1438,25 @@
  */
 #define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 
+/**
+ * \def MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+ *
+ * Shrink the record buffers of a connection once its handshake is over.
+ *
+ * The input and output buffers are allocated with their full size
+ * (#MBEDTLS_SSL_IN_CONTENT_LEN and #MBEDTLS_SSL_OUT_CONTENT_LEN plus the
+ * record overhead) for the handshake. When it completes, they are
+ * reallocated to the largest record that can still be received or sent:
+ * the output buffer to the configured maximum fragment length, and the
+ * input buffer to the maximum fragment length if the peer accepted the
+ * extension. They grow back before any new handshake.
+ *
+ * Requires: MBEDTLS_SSL_MAX_FRAGMENT_LENGTH to have any effect.
+ *
+ * Comment this macro to keep full size buffers for the whole connection.
+ */
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+
 /**
  * \def MBEDTLS_SSL_PROTO_SSL3
  *
@@ -1546,7 +1601,7 @@
  *
  * Comment this macro to disable support for SSL session tickets
  */
-//#define MBEDTLS_SSL_SESSION_TICKETS
+#define MBEDTLS_SSL_SESSION_TICKETS
 
 /**
  * \def MBEDTLS_SSL_EXPORT_KEYS
@@ -2052,7 +2107,7 @@
  *
  * Module:  library/chacha20.c
  */
-//#define MBEDTLS_CHACHA20_C
+#define MBEDTLS_CHACHA20_C
 
 /**
  * \def MBEDTLS_CHACHAPOLY_C
@@ -2063,7 +2118,7 @@
  *
  * This module requires: MBEDTLS_CHACHA20_C, MBEDTLS_POLY1305_C
  */
-//#define MBEDTLS_CHACHAPOLY_C
+#define MBEDTLS_CHACHAPOLY_C
 
 /**
  * \def MBEDTLS_CIPHER_C
@@ -2630,7 +2685,7 @@
  * Module:  library/poly1305.c
  * Caller:  library/chachapoly.c
  */
-//#define MBEDTLS_POLY1305_C
+#define MBEDTLS_POLY1305_C
 
 /**
  * \def MBEDTLS_RIPEMD160_C
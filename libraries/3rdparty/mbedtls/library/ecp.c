@@ -104,6 +104,12 @@
 
 #include "mbedtls/ecp_internal.h"
 
+#if defined(MBEDTLS_ECP_P256_STATIC_TABLES) && \
+    defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+#include "ecp_p256_tables.h"
+#define ECP_P256_STATIC_TABLES
+#endif
+
 #if ( defined(__ARMCC_VERSION) || defined(_MSC_VER) ) && \
     !defined(inline) && !defined(__cplusplus)
 #define inline __inline
@@ -2029,6 +2035,17 @@ static int ecp_mul_comb( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
         T_ok = 1;
     }
     else
+#if defined(ECP_P256_STATIC_TABLES)
+    /* Pre-computed table: is it in flash? */
+    if( p_eq_g && grp->id == MBEDTLS_ECP_DP_SECP256R1 &&
+        w == ECP_P256_COMB_W )
+    {
+        /* read-only, never modified by the functions below */
+        T = (mbedtls_ecp_point *) secp256r1_comb_T;
+        T_ok = 1;
+    }
+    else
+#endif
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     /* Pre-computed table: do we have one in progress? complete? */
     if( rs_ctx != NULL && rs_ctx->rsm != NULL && rs_ctx->rsm->T != NULL )
@@ -2083,6 +2100,12 @@ cleanup:
     if( T == grp->T )
         T = NULL;
 
+#if defined(ECP_P256_STATIC_TABLES)
+    /* is T in flash? */
+    if( T == secp256r1_comb_T )
+        T = NULL;
+#endif
+
     /* does T belong to the restart context? */
 #if defined(MBEDTLS_ECP_RESTARTABLE)
     if( rs_ctx != NULL && rs_ctx->rsm != NULL && ret == MBEDTLS_ERR_ECP_IN_PROGRESS && T != NULL )
@@ -2476,6 +2499,237 @@ cleanup:
     return( ret );
 }
 
+#if defined(MBEDTLS_ECP_MULADD_WNAF)
+/*
+ * Window size of the wNAF table computed at run time for a variable point.
+ * 2^(w-2) points are precomputed, at a cost of 1D + (2^(w-2) - 1)A + 1N(t).
+ */
+#if MBEDTLS_ECP_WINDOW_SIZE < 5
+#define ECP_WNAF_W      MBEDTLS_ECP_WINDOW_SIZE
+#else
+#define ECP_WNAF_W      5
+#endif
+
+/*
+ * Width-w non-adjacent form of |m| (HMV, algorithm 3.35):
+ * |m| = sum_i naf[i] 2^i, where each naf[i] is zero or odd with
+ * |naf[i]| < 2^(w-1), and any w consecutive digits hold at most one
+ * non-zero digit. The digits are negated if m is negative.
+ *
+ * len must be at least mbedtls_mpi_bitlen( m ) + 1.
+ */
+static void ecp_wnaf_recode( signed char naf[], size_t len,
+                             const mbedtls_mpi *m, unsigned char w )
+{
+    size_t i = 0, j, now;
+    int carry = 0, word;
+
+    memset( naf, 0, len );
+
+    while( i < len )
+    {
+        if( mbedtls_mpi_get_bit( m, i ) == carry )
+        {
+            i++;
+            continue;
+        }
+
+        now = len - i < w ? len - i : w;
+
+        word = carry;
+        for( j = 0; j < now; j++ )
+            word += mbedtls_mpi_get_bit( m, i + j ) << j;
+
+        /* word is odd: keep it if below 2^(w-1), else borrow from the next
+         * window and make it negative */
+        carry = ( word >> ( w - 1 ) ) & 1;
+        word -= carry << w;
+
+        naf[i] = (signed char) ( m->s < 0 ? -word : word );
+        i += now;
+    }
+}
+
+/*
+ * Odd multiples P, 3P, .., (2^(w-1) - 1)P in affine coordinates
+ */
+static int ecp_wnaf_precompute( const mbedtls_ecp_group *grp,
+                                mbedtls_ecp_point T[], unsigned char T_size,
+                                const mbedtls_ecp_point *P )
+{
+    int ret;
+    unsigned char i;
+    mbedtls_ecp_point P2;
+    mbedtls_ecp_point *TT[ 1U << ( ECP_WNAF_W - 2 ) ];
+
+    mbedtls_ecp_point_init( &P2 );
+
+    MBEDTLS_MPI_CHK( mbedtls_ecp_copy( &T[0], P ) );
+    MBEDTLS_MPI_CHK( ecp_normalize_jac( grp, &T[0] ) );
+
+    if( T_size > 1 )
+    {
+        MBEDTLS_MPI_CHK( ecp_double_jac( grp, &P2, &T[0] ) );
+        MBEDTLS_MPI_CHK( ecp_normalize_jac( grp, &P2 ) );
+
+        for( i = 1; i < T_size; i++ )
+        {
+            MBEDTLS_MPI_CHK( ecp_add_mixed( grp, &T[i], &T[i-1], &P2 ) );
+            TT[i-1] = &T[i];
+        }
+
+        MBEDTLS_MPI_CHK( ecp_normalize_jac_many( grp, TT, T_size - 1 ) );
+    }
+
+cleanup:
+    mbedtls_ecp_point_free( &P2 );
+
+    return( ret );
+}
+
+/*
+ * R += d * T[(|d| - 1) / 2] for an odd wNAF digit d
+ */
+static int ecp_wnaf_add( const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                         const mbedtls_ecp_point T[], signed char d,
+                         mbedtls_ecp_point *tmp )
+{
+    int ret;
+    const mbedtls_ecp_point *Ti = &T[ ( ( d < 0 ? -d : d ) - 1 ) / 2 ];
+
+    /* Always add a copy with an explicit Z = 1: if R happens to be zero,
+     * ecp_add_mixed() returns a copy of it, which must not look like zero */
+    MBEDTLS_MPI_CHK( mbedtls_mpi_copy( &tmp->X, &Ti->X ) );
+    if( d < 0 )
+        MBEDTLS_MPI_CHK( mbedtls_mpi_sub_mpi( &tmp->Y, &grp->P, &Ti->Y ) );
+    else
+        MBEDTLS_MPI_CHK( mbedtls_mpi_copy( &tmp->Y, &Ti->Y ) );
+    MBEDTLS_MPI_CHK( mbedtls_mpi_lset( &tmp->Z, 1 ) );
+
+    MBEDTLS_MPI_CHK( ecp_add_mixed( grp, R, R, tmp ) );
+
+cleanup:
+    return( ret );
+}
+
+/*
+ * Linear combination R = m * P + n * Q using interleaved wNAF (HMV,
+ * algorithm 3.51): both scalars share a single chain of doublings, and only
+ * about 1/(w+1) of the digits of each require an addition.
+ * With MBEDTLS_ECP_P256_STATIC_TABLES, the table for the secp256r1 base
+ * point is read from flash instead of being computed.
+ * NOT constant-time - only for public data such as signature verification.
+ */
+static int ecp_muladd_wnaf( const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                            const mbedtls_mpi *m, const mbedtls_ecp_point *P,
+                            const mbedtls_mpi *n, const mbedtls_ecp_point *Q )
+{
+    int ret;
+    const mbedtls_mpi *k[2];
+    const mbedtls_ecp_point *X[2];
+    const mbedtls_ecp_point *T[2];
+    mbedtls_ecp_point *TT[2] = { NULL, NULL };
+    signed char *naf[2] = { NULL, NULL };
+    unsigned char w, T_size = 1U << ( ECP_WNAF_W - 2 );
+    mbedtls_ecp_point tmp;
+    size_t len, i, j;
+    int started = 0;
+
+    k[0] = m; X[0] = P;
+    k[1] = n; X[1] = Q;
+
+    mbedtls_ecp_point_init( &tmp );
+
+    /* Same checks as mbedtls_ecp_mul_shortcuts() */
+    for( j = 0; j < 2; j++ )
+    {
+        if( mbedtls_mpi_cmp_int( k[j], 1 ) == 0 ||
+            mbedtls_mpi_cmp_int( k[j], -1 ) == 0 )
+            continue;
+
+        MBEDTLS_MPI_CHK( mbedtls_ecp_check_privkey( grp, k[j] ) );
+        MBEDTLS_MPI_CHK( mbedtls_ecp_check_pubkey( grp, X[j] ) );
+    }
+
+    len = mbedtls_mpi_bitlen( m );
+    if( mbedtls_mpi_bitlen( n ) > len )
+        len = mbedtls_mpi_bitlen( n );
+    len++;
+
+    for( j = 0; j < 2; j++ )
+    {
+        if( ( naf[j] = mbedtls_calloc( len, 1 ) ) == NULL )
+        {
+            ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+            goto cleanup;
+        }
+
+#if defined(ECP_P256_STATIC_TABLES)
+        if( grp->id == MBEDTLS_ECP_DP_SECP256R1 &&
+            mbedtls_mpi_cmp_mpi( &X[j]->Y, &grp->G.Y ) == 0 &&
+            mbedtls_mpi_cmp_mpi( &X[j]->X, &grp->G.X ) == 0 )
+        {
+            T[j] = secp256r1_wnaf_T;
+            w = ECP_P256_WNAF_W;
+        }
+        else
+#endif
+        {
+            TT[j] = mbedtls_calloc( T_size, sizeof( mbedtls_ecp_point ) );
+            if( TT[j] == NULL )
+            {
+                ret = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+                goto cleanup;
+            }
+
+            for( i = 0; i < T_size; i++ )
+                mbedtls_ecp_point_init( &TT[j][i] );
+
+            MBEDTLS_MPI_CHK( ecp_wnaf_precompute( grp, TT[j], T_size, X[j] ) );
+            T[j] = TT[j];
+            w = ECP_WNAF_W;
+        }
+
+        ecp_wnaf_recode( naf[j], len, k[j], w );
+    }
+
+    MBEDTLS_MPI_CHK( mbedtls_ecp_set_zero( R ) );
+
+    for( i = len; i-- > 0; )
+    {
+        /* Skip the doublings of zero until the first addition */
+        if( started )
+            MBEDTLS_MPI_CHK( ecp_double_jac( grp, R, R ) );
+
+        for( j = 0; j < 2; j++ )
+        {
+            if( naf[j][i] != 0 )
+            {
+                MBEDTLS_MPI_CHK( ecp_wnaf_add( grp, R, T[j], naf[j][i], &tmp ) );
+                started = 1;
+            }
+        }
+    }
+
+    MBEDTLS_MPI_CHK( ecp_normalize_jac( grp, R ) );
+
+cleanup:
+    mbedtls_ecp_point_free( &tmp );
+    for( j = 0; j < 2; j++ )
+    {
+        if( TT[j] != NULL )
+        {
+            for( i = 0; i < T_size; i++ )
+                mbedtls_ecp_point_free( &TT[j][i] );
+            mbedtls_free( TT[j] );
+        }
+        mbedtls_free( naf[j] );
+    }
+
+    return( ret );
+}
+#endif /* MBEDTLS_ECP_MULADD_WNAF */
+
 /*
  * Restartable linear combination
  * NOT constant-time
@@ -2505,6 +2759,21 @@ int mbedtls_ecp_muladd_restartable(
 
     mbedtls_ecp_point_init( &mP );
 
+#if defined(MBEDTLS_ECP_MULADD_WNAF)
+    /* The interleaved method cannot be interrupted: keep the separate
+     * multiplications for restartable operations */
+    if( rs_ctx == NULL )
+    {
+#if defined(MBEDTLS_ECP_INTERNAL_ALT)
+        if( ( is_grp_capable = mbedtls_internal_ecp_grp_capable( grp ) ) )
+            MBEDTLS_MPI_CHK( mbedtls_internal_ecp_init( grp ) );
+#endif /* MBEDTLS_ECP_INTERNAL_ALT */
+
+        MBEDTLS_MPI_CHK( ecp_muladd_wnaf( grp, R, m, P, n, Q ) );
+        goto cleanup;
+    }
+#endif /* MBEDTLS_ECP_MULADD_WNAF */
+
     ECP_RS_ENTER( ma );
 
 #if defined(MBEDTLS_ECP_RESTARTABLE)
@@ -0,0 +1,464 @@
+/*
+ *  Precomputed secp256r1 generator point tables
+ *
+ *  Generated by programs/ecp/gen_p256_tables.c, do not edit.
+ */
+
+#ifndef MBEDTLS_ECP_P256_TABLES_H
+#define MBEDTLS_ECP_P256_TABLES_H
+
+#if !defined(BYTES_TO_T_UINT_8)
+#if defined(MBEDTLS_HAVE_INT32)
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h )     \
+    ( (mbedtls_mpi_uint) a <<  0 ) |                    \
+    ( (mbedtls_mpi_uint) b <<  8 ) |                    \
+    ( (mbedtls_mpi_uint) c << 16 ) |                    \
+    ( (mbedtls_mpi_uint) d << 24 ),                     \
+    ( (mbedtls_mpi_uint) e <<  0 ) |                    \
+    ( (mbedtls_mpi_uint) f <<  8 ) |                    \
+    ( (mbedtls_mpi_uint) g << 16 ) |                    \
+    ( (mbedtls_mpi_uint) h << 24 )
+#else
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h )     \
+    ( (mbedtls_mpi_uint) a <<  0 ) |                    \
+    ( (mbedtls_mpi_uint) b <<  8 ) |                    \
+    ( (mbedtls_mpi_uint) c << 16 ) |                    \
+    ( (mbedtls_mpi_uint) d << 24 ) |                    \
+    ( (mbedtls_mpi_uint) e << 32 ) |                    \
+    ( (mbedtls_mpi_uint) f << 40 ) |                    \
+    ( (mbedtls_mpi_uint) g << 48 ) |                    \
+    ( (mbedtls_mpi_uint) h << 56 )
+#endif
+#endif /* !BYTES_TO_T_UINT_8 */
+
+#define ECP_P256_COMB_W    5
+#define ECP_P256_WNAF_W    6
+
+#define ECP_POINT_INIT_XY( x, y )                                       \
+    { { 1, sizeof( x ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) x }, \
+      { 1, sizeof( y ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) y }, \
+      { 1, 0, NULL } }
+
+static const mbedtls_mpi_uint secp256r1_comb_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xC2, 0x98, 0xD8, 0x45, 0x39, 0xA1, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x33, 0xEB, 0x2D, 0x81, 0x7D, 0x03, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x40, 0xA4, 0x63, 0xE5, 0xE6, 0xBC, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x47, 0x42, 0x2C, 0xE1, 0xF2, 0xD1, 0x17, 0x6B ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF5, 0x51, 0xBF, 0x37, 0x68, 0x40, 0xB6, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xCE, 0x5E, 0x31, 0x6B, 0x57, 0x33, 0xCE, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x16, 0x9E, 0x0F, 0x7C, 0x4A, 0xEB, 0xE7, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x7F, 0x1A, 0xFE, 0xE2, 0x42, 0xE3, 0x4F ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0x70, 0xC8, 0xBA, 0x04, 0xB7, 0x4B, 0xD2, 0xF7 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0xC6, 0x23, 0x3A, 0xA0, 0x09, 0x3A, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x1D, 0x9D, 0x4C, 0xF9, 0x58, 0x23, 0xCC, 0xDF ),
+    BYTES_TO_T_UINT_8( 0x02, 0xED, 0x7B, 0x29, 0x87, 0x0F, 0xFA, 0x3C ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0x40, 0x69, 0xF2, 0x40, 0x0B, 0xA3, 0x98, 0xCE ),
+    BYTES_TO_T_UINT_8( 0xAF, 0xA8, 0x48, 0x02, 0x0D, 0x1C, 0x12, 0x62 ),
+    BYTES_TO_T_UINT_8( 0x9B, 0xAF, 0x09, 0x83, 0x80, 0xAA, 0x58, 0xA7 ),
+    BYTES_TO_T_UINT_8( 0xC6, 0x12, 0xBE, 0x70, 0x94, 0x76, 0xE3, 0xE4 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0x7D, 0x7D, 0xEF, 0x86, 0xFF, 0xE3, 0x37, 0xDD ),
+    BYTES_TO_T_UINT_8( 0xDB, 0x86, 0x8B, 0x08, 0x27, 0x7C, 0xD7, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0x91, 0x54, 0x4C, 0x25, 0x4F, 0x9A, 0xFE, 0x28 ),
+    BYTES_TO_T_UINT_8( 0x5E, 0xFD, 0xF0, 0x6D, 0x37, 0x03, 0x69, 0xD6 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xD5, 0xDA, 0xAD, 0x92, 0x49, 0xF0, 0x9F ),
+    BYTES_TO_T_UINT_8( 0xF9, 0x73, 0x43, 0x9E, 0xAF, 0xA7, 0xD1, 0xF3 ),
+    BYTES_TO_T_UINT_8( 0x67, 0x41, 0x07, 0xDF, 0x78, 0x95, 0x3E, 0xA1 ),
+    BYTES_TO_T_UINT_8( 0x22, 0x3D, 0xD1, 0xE6, 0x3C, 0xA5, 0xE2, 0x20 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0xBF, 0x6A, 0x5D, 0x52, 0x35, 0xD7, 0xBF, 0xAE ),
+    BYTES_TO_T_UINT_8( 0x5A, 0xA2, 0xBE, 0x96, 0xF4, 0xF8, 0x02, 0xC3 ),
+    BYTES_TO_T_UINT_8( 0xA4, 0x20, 0x49, 0x54, 0xEA, 0xB3, 0x82, 0xDB ),
+    BYTES_TO_T_UINT_8( 0x2E, 0xDB, 0xEA, 0x02, 0xD1, 0x75, 0x1C, 0x62 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF0, 0x85, 0xF4, 0x9E, 0x4C, 0xDC, 0x39, 0x89 ),
+    BYTES_TO_T_UINT_8( 0x63, 0x6D, 0xC4, 0x57, 0xD8, 0x03, 0x5D, 0x22 ),
+    BYTES_TO_T_UINT_8( 0x70, 0x7F, 0x2D, 0x52, 0x6F, 0xC9, 0xDA, 0x4F ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x64, 0xFA, 0xB4, 0xFE, 0xA4, 0xC4, 0xD7 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0x2A, 0x37, 0xB9, 0xC0, 0xAA, 0x59, 0xC6, 0x8B ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x58, 0xD9, 0xED, 0x58, 0x99, 0x65, 0xF7 ),
+    BYTES_TO_T_UINT_8( 0x88, 0x7D, 0x26, 0x8C, 0x4A, 0xF9, 0x05, 0x9F ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x73, 0x9A, 0xC9, 0xE7, 0x46, 0xDC, 0x00 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF2, 0xD0, 0x55, 0xDF, 0x00, 0x0A, 0xF5, 0x4A ),
+    BYTES_TO_T_UINT_8( 0x6A, 0xBF, 0x56, 0x81, 0x2D, 0x20, 0xEB, 0xB5 ),
+    BYTES_TO_T_UINT_8( 0x11, 0xC1, 0x28, 0x52, 0xAB, 0xE3, 0xD1, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x24, 0x34, 0x79, 0x45, 0x57, 0xA5, 0x12, 0x03 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0xEE, 0xCF, 0xB8, 0x7E, 0xF7, 0x92, 0x96, 0x8D ),
+    BYTES_TO_T_UINT_8( 0x3D, 0x01, 0x8C, 0x0D, 0x23, 0xF2, 0xE3, 0x05 ),
+    BYTES_TO_T_UINT_8( 0x59, 0x2E, 0xE3, 0x84, 0x52, 0x7A, 0x34, 0x76 ),
+    BYTES_TO_T_UINT_8( 0xE5, 0xA1, 0xB0, 0x15, 0x90, 0xE2, 0x53, 0x3C ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xD4, 0x98, 0xE7, 0xFA, 0xA5, 0x7D, 0x8B, 0x53 ),
+    BYTES_TO_T_UINT_8( 0x91, 0x35, 0xD2, 0x00, 0xD1, 0x1B, 0x9F, 0x1B ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x69, 0x08, 0x9A, 0x72, 0xF0, 0xA9, 0x11 ),
+    BYTES_TO_T_UINT_8( 0xB3, 0xFE, 0x0E, 0x14, 0xDA, 0x7C, 0x0E, 0xD3 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x83, 0xF6, 0xE8, 0xF8, 0x87, 0xF7, 0xFC, 0x6D ),
+    BYTES_TO_T_UINT_8( 0x90, 0xBE, 0x7F, 0x3F, 0x7A, 0x2B, 0xD7, 0x13 ),
+    BYTES_TO_T_UINT_8( 0xCF, 0x32, 0xF2, 0x2D, 0x94, 0x6D, 0x42, 0xFD ),
+    BYTES_TO_T_UINT_8( 0xAD, 0x9A, 0xE3, 0x5F, 0x42, 0xBB, 0x84, 0xED ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0xFC, 0x95, 0x29, 0x73, 0xA1, 0x67, 0x3E, 0x02 ),
+    BYTES_TO_T_UINT_8( 0xE3, 0x30, 0x54, 0x35, 0x8E, 0x0A, 0xDD, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x03, 0xD7, 0xA1, 0x97, 0x61, 0x3B, 0xF8, 0x0C ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x33, 0x3C, 0x58, 0x55, 0x34, 0x23, 0xA3 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0x99, 0x5D, 0x16, 0x5F, 0x7B, 0xBC, 0xBB, 0xCE ),
+    BYTES_TO_T_UINT_8( 0x61, 0xEE, 0x4E, 0x8A, 0xC1, 0x51, 0xCC, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x1F, 0x0D, 0x4D, 0x1B, 0x53, 0x23, 0x1D, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x2A, 0x38, 0x66, 0x52, 0x84, 0xE1, 0x95 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5B, 0x9B, 0x83, 0x0A, 0x81, 0x4F, 0xAD, 0xAC ),
+    BYTES_TO_T_UINT_8( 0x0F, 0xFF, 0x42, 0x41, 0x6E, 0xA9, 0xA2, 0xA0 ),
+    BYTES_TO_T_UINT_8( 0x2F, 0xA1, 0x4F, 0x1F, 0x89, 0x82, 0xAA, 0x3E ),
+    BYTES_TO_T_UINT_8( 0xF3, 0xB8, 0x0F, 0x6B, 0x8F, 0x8C, 0xD6, 0x68 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_8_X[] = {
+    BYTES_TO_T_UINT_8( 0xF1, 0xB3, 0xBB, 0x51, 0x69, 0xA2, 0x11, 0x93 ),
+    BYTES_TO_T_UINT_8( 0x65, 0x4F, 0x0F, 0x8D, 0xBD, 0x26, 0x0F, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0xB9, 0xCB, 0xEC, 0x6B, 0x34, 0xC3, 0x3D, 0x9D ),
+    BYTES_TO_T_UINT_8( 0xE4, 0x5D, 0x1E, 0x10, 0xD5, 0x44, 0xE2, 0x54 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_8_Y[] = {
+    BYTES_TO_T_UINT_8( 0x28, 0x9E, 0xB1, 0xF1, 0x6E, 0x4C, 0xAD, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0xE3, 0xC2, 0x58, 0xC0, 0xFB, 0x34, 0x43 ),
+    BYTES_TO_T_UINT_8( 0x25, 0x9C, 0xDF, 0x35, 0x07, 0x41, 0xBD, 0x19 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x6E, 0x10, 0xEC, 0x0E, 0xEC, 0xBB, 0xD6 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_9_X[] = {
+    BYTES_TO_T_UINT_8( 0xC8, 0xCF, 0xEF, 0x3F, 0x83, 0x1A, 0x88, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0x0B, 0x29, 0xB5, 0xB9, 0xE0, 0xC9, 0xA3, 0xAE ),
+    BYTES_TO_T_UINT_8( 0x88, 0x46, 0x1E, 0x77, 0xCD, 0x7E, 0xB3, 0x10 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x21, 0xD0, 0xD4, 0xA3, 0x16, 0x08, 0xEE ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_9_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA1, 0xCA, 0xA8, 0xB3, 0xBF, 0x29, 0x99, 0x8E ),
+    BYTES_TO_T_UINT_8( 0xD1, 0xF2, 0x05, 0xC1, 0xCF, 0x5D, 0x91, 0x48 ),
+    BYTES_TO_T_UINT_8( 0x9F, 0x01, 0x49, 0xDB, 0x82, 0xDF, 0x5F, 0x3A ),
+    BYTES_TO_T_UINT_8( 0xE1, 0x06, 0x90, 0xAD, 0xE3, 0x38, 0xA4, 0xC4 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_10_X[] = {
+    BYTES_TO_T_UINT_8( 0xC9, 0xD2, 0x3A, 0xE8, 0x03, 0xC5, 0x6D, 0x5D ),
+    BYTES_TO_T_UINT_8( 0xBE, 0x35, 0xD0, 0xAE, 0x1D, 0x7A, 0x9F, 0xCA ),
+    BYTES_TO_T_UINT_8( 0x33, 0x1E, 0xD2, 0xCB, 0xAC, 0x88, 0x27, 0x55 ),
+    BYTES_TO_T_UINT_8( 0xF0, 0xB9, 0x9C, 0xE0, 0x31, 0xDD, 0x99, 0x86 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_10_Y[] = {
+    BYTES_TO_T_UINT_8( 0x61, 0xF9, 0x9B, 0x32, 0x96, 0x41, 0x58, 0x38 ),
+    BYTES_TO_T_UINT_8( 0xF9, 0x5A, 0x2A, 0xB8, 0x96, 0x0E, 0xB2, 0x4C ),
+    BYTES_TO_T_UINT_8( 0xC1, 0x78, 0x2C, 0xC7, 0x08, 0x99, 0x19, 0x24 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0x59, 0x28, 0xE9, 0x84, 0x54, 0xE6, 0x16 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_11_X[] = {
+    BYTES_TO_T_UINT_8( 0xDD, 0x38, 0x30, 0xDB, 0x70, 0x2C, 0x0A, 0xA2 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x5C, 0x9D, 0xE9, 0xD5, 0x46, 0x0B, 0x5F ),
+    BYTES_TO_T_UINT_8( 0x83, 0x0B, 0x60, 0x4B, 0x37, 0x7D, 0xB9, 0xC9 ),
+    BYTES_TO_T_UINT_8( 0x5E, 0x24, 0xF3, 0x3D, 0x79, 0x7F, 0x6C, 0x18 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_11_Y[] = {
+    BYTES_TO_T_UINT_8( 0x7F, 0xE5, 0x1C, 0x4F, 0x60, 0x24, 0xF7, 0x2A ),
+    BYTES_TO_T_UINT_8( 0xED, 0xD8, 0xE2, 0x91, 0x7F, 0x89, 0x49, 0x92 ),
+    BYTES_TO_T_UINT_8( 0x97, 0xA7, 0x2E, 0x8D, 0x6A, 0xB3, 0x39, 0x81 ),
+    BYTES_TO_T_UINT_8( 0x13, 0x89, 0xB5, 0x9A, 0xB8, 0x8D, 0x42, 0x9C ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_12_X[] = {
+    BYTES_TO_T_UINT_8( 0x8D, 0x45, 0xE6, 0x4B, 0x3F, 0x4F, 0x1E, 0x1F ),
+    BYTES_TO_T_UINT_8( 0x47, 0x65, 0x5E, 0x59, 0x22, 0xCC, 0x72, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xF1, 0x93, 0x1A, 0x27, 0x1E, 0x34, 0xC5, 0x5B ),
+    BYTES_TO_T_UINT_8( 0x63, 0xF2, 0xA5, 0x58, 0x5C, 0x15, 0x2E, 0xC6 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_12_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF4, 0x7F, 0xBA, 0x58, 0x5A, 0x84, 0x6F, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xAD, 0xA6, 0x36, 0x7E, 0xDC, 0xF7, 0xE1, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x04, 0x4D, 0xAA, 0xEE, 0x57, 0x76, 0x3A, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0x4E, 0x7E, 0x26, 0x18, 0x22, 0x23, 0x9F, 0xFF ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_13_X[] = {
+    BYTES_TO_T_UINT_8( 0x1D, 0x4C, 0x64, 0xC7, 0x55, 0x02, 0x3F, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0xD8, 0x02, 0x90, 0xBB, 0xC3, 0xEC, 0x30, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x9F, 0x6F, 0x64, 0xF4, 0x16, 0x69, 0x48, 0xA4 ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x44, 0x9C, 0x95, 0x0C, 0x7D, 0x67, 0x5E ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_13_Y[] = {
+    BYTES_TO_T_UINT_8( 0x44, 0x91, 0x8B, 0xD8, 0xD0, 0xD7, 0xE7, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0x1F, 0xF9, 0x48, 0x62, 0x6F, 0xA8, 0x93, 0x5D ),
+    BYTES_TO_T_UINT_8( 0xEA, 0x3A, 0x99, 0x02, 0xD5, 0x0B, 0x3D, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0x1E, 0xD3, 0x00, 0x31, 0xE6, 0x0C, 0x9F, 0x44 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_14_X[] = {
+    BYTES_TO_T_UINT_8( 0x56, 0xB2, 0xAA, 0xFD, 0x88, 0x15, 0xDF, 0x52 ),
+    BYTES_TO_T_UINT_8( 0x4C, 0x35, 0x27, 0x31, 0x44, 0xCD, 0xC0, 0x68 ),
+    BYTES_TO_T_UINT_8( 0x53, 0xF8, 0x91, 0xA5, 0x71, 0x94, 0x84, 0x2A ),
+    BYTES_TO_T_UINT_8( 0x92, 0xCB, 0xD0, 0x93, 0xE9, 0x88, 0xDA, 0xE4 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_14_Y[] = {
+    BYTES_TO_T_UINT_8( 0x24, 0xC6, 0x39, 0x16, 0x5D, 0xA3, 0x1E, 0x6D ),
+    BYTES_TO_T_UINT_8( 0xBA, 0x07, 0x37, 0x26, 0x36, 0x2A, 0xFE, 0x60 ),
+    BYTES_TO_T_UINT_8( 0x51, 0xBC, 0xF3, 0xD0, 0xDE, 0x50, 0xFC, 0x97 ),
+    BYTES_TO_T_UINT_8( 0x80, 0x2E, 0x06, 0x10, 0x15, 0x4D, 0xFA, 0xF7 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_15_X[] = {
+    BYTES_TO_T_UINT_8( 0x27, 0x65, 0x69, 0x5B, 0x66, 0xA2, 0x75, 0x2E ),
+    BYTES_TO_T_UINT_8( 0x9C, 0x16, 0x00, 0x5A, 0xB0, 0x30, 0x25, 0x1A ),
+    BYTES_TO_T_UINT_8( 0x42, 0xFB, 0x86, 0x42, 0x80, 0xC1, 0xC4, 0x76 ),
+    BYTES_TO_T_UINT_8( 0x5B, 0x1D, 0x83, 0x8E, 0x94, 0x01, 0x5F, 0x82 ),
+};
+static const mbedtls_mpi_uint secp256r1_comb_T_15_Y[] = {
+    BYTES_TO_T_UINT_8( 0x39, 0x37, 0x70, 0xEF, 0x1F, 0xA1, 0xF0, 0xDB ),
+    BYTES_TO_T_UINT_8( 0x6A, 0x10, 0x5B, 0xCE, 0xC4, 0x9B, 0x6F, 0x10 ),
+    BYTES_TO_T_UINT_8( 0x50, 0x11, 0x11, 0x24, 0x4F, 0x4C, 0x79, 0x61 ),
+    BYTES_TO_T_UINT_8( 0x17, 0x3A, 0x72, 0xBC, 0xFE, 0x72, 0x58, 0x43 ),
+};
+static const mbedtls_ecp_point secp256r1_comb_T[16] = {
+    ECP_POINT_INIT_XY( secp256r1_comb_T_0_X, secp256r1_comb_T_0_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_1_X, secp256r1_comb_T_1_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_2_X, secp256r1_comb_T_2_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_3_X, secp256r1_comb_T_3_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_4_X, secp256r1_comb_T_4_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_5_X, secp256r1_comb_T_5_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_6_X, secp256r1_comb_T_6_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_7_X, secp256r1_comb_T_7_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_8_X, secp256r1_comb_T_8_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_9_X, secp256r1_comb_T_9_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_10_X, secp256r1_comb_T_10_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_11_X, secp256r1_comb_T_11_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_12_X, secp256r1_comb_T_12_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_13_X, secp256r1_comb_T_13_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_14_X, secp256r1_comb_T_14_Y ),
+    ECP_POINT_INIT_XY( secp256r1_comb_T_15_X, secp256r1_comb_T_15_Y ),
+};
+
+static const mbedtls_mpi_uint secp256r1_wnaf_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xC2, 0x98, 0xD8, 0x45, 0x39, 0xA1, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x33, 0xEB, 0x2D, 0x81, 0x7D, 0x03, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x40, 0xA4, 0x63, 0xE5, 0xE6, 0xBC, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x47, 0x42, 0x2C, 0xE1, 0xF2, 0xD1, 0x17, 0x6B ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF5, 0x51, 0xBF, 0x37, 0x68, 0x40, 0xB6, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xCE, 0x5E, 0x31, 0x6B, 0x57, 0x33, 0xCE, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x16, 0x9E, 0x0F, 0x7C, 0x4A, 0xEB, 0xE7, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x7F, 0x1A, 0xFE, 0xE2, 0x42, 0xE3, 0x4F ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0x6C, 0xFD, 0xE7, 0xC6, 0x1B, 0x66, 0x41, 0xFB ),
+    BYTES_TO_T_UINT_8( 0x85, 0xA9, 0xAD, 0xEF, 0x21, 0xB7, 0xC6, 0xE6 ),
+    BYTES_TO_T_UINT_8( 0x65, 0xF1, 0x4B, 0x1D, 0x95, 0xEF, 0xF7, 0xC8 ),
+    BYTES_TO_T_UINT_8( 0x44, 0x0A, 0x33, 0xA6, 0xD1, 0xE4, 0xCB, 0x5E ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0x32, 0x50, 0x7D, 0xA2, 0x27, 0xB1, 0x79, 0x9A ),
+    BYTES_TO_T_UINT_8( 0x3D, 0xB8, 0x4F, 0x38, 0x36, 0xB0, 0x2A, 0xD8 ),
+    BYTES_TO_T_UINT_8( 0xEC, 0xA2, 0x64, 0x1A, 0xCE, 0x06, 0x4B, 0x37 ),
+    BYTES_TO_T_UINT_8( 0x7E, 0xFF, 0x98, 0x49, 0x0C, 0x64, 0x34, 0x87 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0xED, 0x33, 0xD0, 0xC3, 0x0D, 0x4A, 0x55, 0x21 ),
+    BYTES_TO_T_UINT_8( 0x24, 0xE5, 0x5B, 0x1F, 0xFD, 0x82, 0x8C, 0xEF ),
+    BYTES_TO_T_UINT_8( 0xDF, 0x8F, 0x66, 0x08, 0x56, 0xC8, 0x84, 0xD7 ),
+    BYTES_TO_T_UINT_8( 0xD2, 0x40, 0x51, 0x51, 0x7A, 0x0B, 0x59, 0x51 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA4, 0x6D, 0xA1, 0xFD, 0x44, 0xBB, 0xD0, 0xD1 ),
+    BYTES_TO_T_UINT_8( 0x88, 0x08, 0xD8, 0xD4, 0x00, 0x2F, 0x01, 0x0D ),
+    BYTES_TO_T_UINT_8( 0x26, 0x79, 0x8A, 0xBF, 0x36, 0xBF, 0xE1, 0x8A ),
+    BYTES_TO_T_UINT_8( 0x7D, 0x72, 0x4A, 0x90, 0xA8, 0x7D, 0xC1, 0xE0 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0xA3, 0xB2, 0x87, 0x31, 0x70, 0x28, 0x06, 0x30 ),
+    BYTES_TO_T_UINT_8( 0x5B, 0xEF, 0x0F, 0xA8, 0xB8, 0xF8, 0xF9, 0x7E ),
+    BYTES_TO_T_UINT_8( 0x60, 0xFB, 0x01, 0x7C, 0x66, 0x30, 0xBB, 0x25 ),
+    BYTES_TO_T_UINT_8( 0x46, 0x7B, 0xBF, 0xA0, 0x6F, 0x3B, 0x53, 0x8E ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0xB4, 0x00, 0xF4, 0xC1, 0x86, 0x1A, 0x5E, 0xC5 ),
+    BYTES_TO_T_UINT_8( 0x21, 0x1B, 0x04, 0xCB, 0x33, 0x36, 0xC7, 0x53 ),
+    BYTES_TO_T_UINT_8( 0x00, 0x90, 0xF5, 0xA6, 0x83, 0x9F, 0x06, 0x6D ),
+    BYTES_TO_T_UINT_8( 0x36, 0x18, 0x33, 0xE0, 0xBD, 0x1D, 0xEB, 0x73 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0xE0, 0x9E, 0x94, 0x90, 0x4B, 0x8A, 0x9E, 0xD7 ),
+    BYTES_TO_T_UINT_8( 0xB3, 0xF8, 0x6D, 0x2C, 0x8C, 0xCB, 0x0A, 0x9E ),
+    BYTES_TO_T_UINT_8( 0x72, 0xF8, 0x71, 0x1D, 0xD5, 0x38, 0x89, 0x87 ),
+    BYTES_TO_T_UINT_8( 0x71, 0x0B, 0xDF, 0xFE, 0xB6, 0xD7, 0x68, 0xEA ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0xFA, 0x48, 0xD0, 0x4D, 0x4A, 0x22, 0x5A, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x82, 0xDE, 0xA4, 0xEA, 0x4F, 0x71, 0x4D ),
+    BYTES_TO_T_UINT_8( 0xC8, 0xA0, 0x8E, 0x4A, 0x96, 0x4A, 0x01, 0x87 ),
+    BYTES_TO_T_UINT_8( 0xE7, 0xFC, 0xC9, 0x72, 0xC9, 0x44, 0x27, 0x2A ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0xD1, 0x21, 0xBC, 0x74, 0xD3, 0x91, 0x33, 0x43 ),
+    BYTES_TO_T_UINT_8( 0xBF, 0x48, 0x50, 0x25, 0xD0, 0x2E, 0x74, 0x16 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x1C, 0xC2, 0xB0, 0x9D, 0x37, 0x38, 0x06 ),
+    BYTES_TO_T_UINT_8( 0x59, 0x4C, 0x3B, 0x88, 0xB7, 0x13, 0xD1, 0x3E ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0x40, 0x37, 0x2A, 0xE8, 0xFC, 0xEE, 0xF8, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x89, 0x98, 0x5E, 0xDA, 0x04, 0x0D, 0x09 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0xC6, 0xF4, 0xA4, 0xAF, 0x43, 0xC8, 0x24 ),
+    BYTES_TO_T_UINT_8( 0xA2, 0xC8, 0xC4, 0xCC, 0x9A, 0x20, 0x99, 0x90 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x01, 0x2C, 0x07, 0x46, 0x9D, 0x5D, 0xE1, 0x98 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0xD5, 0xEA, 0x65, 0x4B, 0x28, 0x2E, 0x79 ),
+    BYTES_TO_T_UINT_8( 0xFC, 0xE2, 0x5E, 0xD8, 0xF2, 0x5D, 0x80, 0x61 ),
+    BYTES_TO_T_UINT_8( 0x5A, 0x49, 0xAC, 0xE0, 0x7A, 0x83, 0x7C, 0x17 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0xD8, 0xBF, 0xC7, 0xEF, 0xE2, 0xBB, 0x43, 0x9C ),
+    BYTES_TO_T_UINT_8( 0xF3, 0x4D, 0xFB, 0xA1, 0xC3, 0x14, 0xEE, 0x26 ),
+    BYTES_TO_T_UINT_8( 0x72, 0x4E, 0x0F, 0xB4, 0xAD, 0x91, 0x40, 0xA2 ),
+    BYTES_TO_T_UINT_8( 0x58, 0xA5, 0xBE, 0x4E, 0xCD, 0x58, 0xBB, 0x63 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0x5F, 0x9D, 0x9B, 0xE5, 0x63, 0x8C, 0x66, 0x63 ),
+    BYTES_TO_T_UINT_8( 0xF1, 0x0E, 0x3A, 0xDE, 0x92, 0xAF, 0x03, 0xAE ),
+    BYTES_TO_T_UINT_8( 0x65, 0x82, 0x88, 0x99, 0x89, 0x37, 0xFB, 0xAD ),
+    BYTES_TO_T_UINT_8( 0xE7, 0xBA, 0x1A, 0x97, 0xC6, 0x4D, 0x45, 0xF0 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x36, 0x4F, 0x03, 0x0D, 0xDE, 0x9C, 0xE5, 0x47 ),
+    BYTES_TO_T_UINT_8( 0x3F, 0xFA, 0xB5, 0x75, 0xCE, 0x21, 0x3B, 0x2A ),
+    BYTES_TO_T_UINT_8( 0xE6, 0x43, 0x96, 0x1F, 0xE5, 0x94, 0x65, 0x4E ),
+    BYTES_TO_T_UINT_8( 0x1F, 0x2D, 0x2E, 0x59, 0xE3, 0x3E, 0xB9, 0xB5 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_8_X[] = {
+    BYTES_TO_T_UINT_8( 0x3E, 0xA7, 0x38, 0x47, 0xE3, 0xBC, 0x1A, 0xBA ),
+    BYTES_TO_T_UINT_8( 0xF8, 0x4A, 0xD6, 0xF0, 0x78, 0x86, 0xA6, 0x5F ),
+    BYTES_TO_T_UINT_8( 0x1A, 0x30, 0x75, 0x6F, 0xB6, 0x84, 0x09, 0x9C ),
+    BYTES_TO_T_UINT_8( 0x3A, 0xCC, 0xF1, 0xC0, 0x04, 0x69, 0x77, 0x47 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_8_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDC, 0xFC, 0xF1, 0x71, 0xFF, 0x87, 0xF7, 0x32 ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x73, 0xD5, 0x28, 0x44, 0x80, 0xB2, 0x81 ),
+    BYTES_TO_T_UINT_8( 0x83, 0x8E, 0x64, 0x77, 0x65, 0x85, 0x31, 0x62 ),
+    BYTES_TO_T_UINT_8( 0x28, 0x57, 0xB9, 0xB5, 0xE6, 0x5E, 0x00, 0xAA ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_9_X[] = {
+    BYTES_TO_T_UINT_8( 0x83, 0xED, 0x03, 0xAB, 0x74, 0x7B, 0xFC, 0xC1 ),
+    BYTES_TO_T_UINT_8( 0x95, 0x48, 0x88, 0x57, 0x22, 0x45, 0x2C, 0x78 ),
+    BYTES_TO_T_UINT_8( 0x07, 0xC5, 0x08, 0x71, 0xC1, 0xB7, 0x39, 0xCE ),
+    BYTES_TO_T_UINT_8( 0x25, 0x0C, 0x2C, 0x10, 0x61, 0x28, 0x6D, 0xCB ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_9_Y[] = {
+    BYTES_TO_T_UINT_8( 0xAA, 0xCD, 0xCE, 0x2B, 0x75, 0x50, 0x91, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0x03, 0x3E, 0xFA, 0x30, 0x6E, 0x71, 0x96, 0xA4 ),
+    BYTES_TO_T_UINT_8( 0xE4, 0x6C, 0x6D, 0x0D, 0x10, 0xE7, 0x35, 0x5C ),
+    BYTES_TO_T_UINT_8( 0x51, 0xEF, 0xD9, 0x24, 0x4B, 0x61, 0xD7, 0x58 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_10_X[] = {
+    BYTES_TO_T_UINT_8( 0x83, 0x9E, 0x39, 0x67, 0x4E, 0x36, 0x76, 0xFD ),
+    BYTES_TO_T_UINT_8( 0x23, 0x15, 0x2B, 0xF4, 0x39, 0x21, 0x58, 0x3A ),
+    BYTES_TO_T_UINT_8( 0xA5, 0xBC, 0x73, 0xB4, 0x6E, 0xC8, 0x4A, 0x2E ),
+    BYTES_TO_T_UINT_8( 0x7B, 0x7C, 0x63, 0x86, 0xF6, 0xFC, 0x50, 0x32 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_10_Y[] = {
+    BYTES_TO_T_UINT_8( 0x09, 0x8C, 0xD4, 0x71, 0xA0, 0x24, 0xDE, 0x15 ),
+    BYTES_TO_T_UINT_8( 0x82, 0x6A, 0x56, 0x3B, 0xC3, 0xD3, 0x7C, 0x89 ),
+    BYTES_TO_T_UINT_8( 0x8C, 0xB8, 0x7E, 0x1D, 0x0D, 0x09, 0xB3, 0x97 ),
+    BYTES_TO_T_UINT_8( 0x93, 0x35, 0x7D, 0x66, 0x42, 0xC3, 0xE7, 0x42 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_11_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0x78, 0xCA, 0x45, 0x30, 0x57, 0x2E, 0x67 ),
+    BYTES_TO_T_UINT_8( 0xFE, 0xA4, 0x64, 0xDF, 0xA5, 0xC0, 0x0B, 0x3C ),
+    BYTES_TO_T_UINT_8( 0xA6, 0x3F, 0x58, 0xD4, 0x39, 0x3E, 0x8A, 0xD2 ),
+    BYTES_TO_T_UINT_8( 0xD7, 0x40, 0x26, 0x9C, 0x23, 0xC7, 0x91, 0x0E ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_11_Y[] = {
+    BYTES_TO_T_UINT_8( 0x55, 0xAD, 0x40, 0x31, 0x54, 0x46, 0x80, 0x13 ),
+    BYTES_TO_T_UINT_8( 0xAE, 0xA5, 0xE7, 0x75, 0x35, 0x83, 0x68, 0x7E ),
+    BYTES_TO_T_UINT_8( 0x6D, 0xBD, 0xE0, 0xB8, 0x3B, 0x73, 0x22, 0x1A ),
+    BYTES_TO_T_UINT_8( 0x22, 0xBA, 0x0D, 0x55, 0x3B, 0x5C, 0xF6, 0x5D ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_12_X[] = {
+    BYTES_TO_T_UINT_8( 0x87, 0xD6, 0x00, 0xF2, 0x45, 0xDC, 0xA4, 0x84 ),
+    BYTES_TO_T_UINT_8( 0x24, 0x1B, 0x6F, 0xB7, 0xC5, 0x2F, 0x65, 0x41 ),
+    BYTES_TO_T_UINT_8( 0x84, 0xFA, 0x07, 0x8C, 0x2D, 0xF5, 0xF4, 0x85 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x0B, 0x0C, 0x4B, 0x55, 0xE2, 0x67, 0x3A ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_12_Y[] = {
+    BYTES_TO_T_UINT_8( 0x24, 0x93, 0xF7, 0x02, 0xB3, 0x16, 0xED, 0xA9 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0x61, 0xA7, 0x35, 0xF7, 0x8A, 0x18, 0x8C ),
+    BYTES_TO_T_UINT_8( 0x0D, 0xFB, 0x3A, 0x16, 0x67, 0xF2, 0xDA, 0x26 ),
+    BYTES_TO_T_UINT_8( 0x43, 0xCF, 0x1F, 0x2F, 0x87, 0xF1, 0xD0, 0x27 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_13_X[] = {
+    BYTES_TO_T_UINT_8( 0xD1, 0x83, 0x08, 0x3B, 0x17, 0x01, 0xE2, 0xF2 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0x54, 0x3E, 0x68, 0xBD, 0x55, 0x63, 0x57 ),
+    BYTES_TO_T_UINT_8( 0x78, 0xF3, 0x11, 0x46, 0xAC, 0x2F, 0xBA, 0xDE ),
+    BYTES_TO_T_UINT_8( 0x51, 0x0D, 0xD8, 0x19, 0x58, 0xFA, 0x4F, 0x18 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_13_Y[] = {
+    BYTES_TO_T_UINT_8( 0x6F, 0x6E, 0x90, 0x60, 0xC2, 0x42, 0xD2, 0x20 ),
+    BYTES_TO_T_UINT_8( 0x16, 0x49, 0xF0, 0x63, 0xCC, 0xEC, 0xBD, 0x45 ),
+    BYTES_TO_T_UINT_8( 0x95, 0x99, 0xCB, 0x26, 0x08, 0xD9, 0xC6, 0xA4 ),
+    BYTES_TO_T_UINT_8( 0x59, 0xF3, 0x88, 0x66, 0x27, 0x6E, 0xA6, 0xC0 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_14_X[] = {
+    BYTES_TO_T_UINT_8( 0xEF, 0x4D, 0x78, 0x1C, 0x3D, 0x69, 0xDD, 0xDE ),
+    BYTES_TO_T_UINT_8( 0x41, 0x8A, 0xB5, 0x88, 0xC6, 0xD1, 0x8C, 0xFD ),
+    BYTES_TO_T_UINT_8( 0x8C, 0x3B, 0x85, 0x90, 0xA0, 0x6D, 0xC3, 0xA7 ),
+    BYTES_TO_T_UINT_8( 0x07, 0x5B, 0x19, 0xFA, 0xDE, 0x3A, 0xD3, 0xD6 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_14_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA6, 0xBC, 0xD1, 0x93, 0x45, 0x12, 0x0C, 0x55 ),
+    BYTES_TO_T_UINT_8( 0xED, 0xED, 0x95, 0x4B, 0xAB, 0x66, 0xA1, 0x09 ),
+    BYTES_TO_T_UINT_8( 0xCB, 0x5D, 0x8A, 0x55, 0x5F, 0x24, 0x78, 0x3F ),
+    BYTES_TO_T_UINT_8( 0x7E, 0x5D, 0x19, 0xEE, 0x16, 0xBA, 0xAA, 0x84 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_15_X[] = {
+    BYTES_TO_T_UINT_8( 0x8B, 0x5B, 0xB4, 0xA1, 0xA0, 0x9A, 0x3F, 0x3E ),
+    BYTES_TO_T_UINT_8( 0x3E, 0x5B, 0xA9, 0x52, 0x7D, 0xDB, 0xC9, 0xFA ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x9A, 0xAE, 0xA7, 0x26, 0xA0, 0x5D, 0xA8 ),
+    BYTES_TO_T_UINT_8( 0x5D, 0xE0, 0xC7, 0x2D, 0x50, 0x9E, 0x1D, 0x30 ),
+};
+static const mbedtls_mpi_uint secp256r1_wnaf_T_15_Y[] = {
+    BYTES_TO_T_UINT_8( 0x67, 0xE2, 0x7E, 0xA1, 0xAE, 0xB6, 0x8D, 0xD5 ),
+    BYTES_TO_T_UINT_8( 0x61, 0xCA, 0x87, 0x68, 0xE4, 0x9A, 0x8D, 0x29 ),
+    BYTES_TO_T_UINT_8( 0x72, 0x7D, 0x01, 0x6B, 0x02, 0x3C, 0xD2, 0xE0 ),
+    BYTES_TO_T_UINT_8( 0x23, 0x12, 0x06, 0xB3, 0xF6, 0xB6, 0x51, 0x65 ),
+};
+static const mbedtls_ecp_point secp256r1_wnaf_T[16] = {
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_0_X, secp256r1_wnaf_T_0_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_1_X, secp256r1_wnaf_T_1_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_2_X, secp256r1_wnaf_T_2_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_3_X, secp256r1_wnaf_T_3_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_4_X, secp256r1_wnaf_T_4_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_5_X, secp256r1_wnaf_T_5_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_6_X, secp256r1_wnaf_T_6_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_7_X, secp256r1_wnaf_T_7_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_8_X, secp256r1_wnaf_T_8_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_9_X, secp256r1_wnaf_T_9_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_10_X, secp256r1_wnaf_T_10_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_11_X, secp256r1_wnaf_T_11_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_12_X, secp256r1_wnaf_T_12_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_13_X, secp256r1_wnaf_T_13_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_14_X, secp256r1_wnaf_T_14_Y ),
+    ECP_POINT_INIT_XY( secp256r1_wnaf_T_15_X, secp256r1_wnaf_T_15_Y ),
+};
+
+#endif /* MBEDTLS_ECP_P256_TABLES_H */
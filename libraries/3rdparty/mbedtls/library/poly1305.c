@@ -0,0 +1,483 @@
+/**
+ * \file poly1305.c
+ *
+ * \brief Poly1305 authentication algorithm.
+ *
+ *  Copyright (C) 2006-2018, Arm Limited (or its affiliates), All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * The arithmetic follows the 32-bit variant of poly1305-donna by Andrew
+ * Moon: the 130-bit numbers are split in five 26-bit limbs, so that a block
+ * costs 25 multiplications of 32-bit limbs into 64-bit sums and one carry
+ * chain, without any multi-word carry propagation.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_POLY1305_C)
+
+#include "mbedtls/poly1305.h"
+#include "mbedtls/platform_util.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_SELF_TEST)
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#define mbedtls_printf printf
+#endif /* MBEDTLS_PLATFORM_C */
+#endif /* MBEDTLS_SELF_TEST */
+
+#if !defined(MBEDTLS_POLY1305_ALT)
+
+/* Parameter validation macros */
+#define POLY1305_VALIDATE_RET( cond )                                       \
+    MBEDTLS_INTERNAL_VALIDATE_RET( cond, MBEDTLS_ERR_POLY1305_BAD_INPUT_DATA )
+#define POLY1305_VALIDATE( cond )                                           \
+    MBEDTLS_INTERNAL_VALIDATE( cond )
+
+#define POLY1305_BLOCK_SIZE_BYTES ( 16U )
+
+#define POLY1305_LIMB_MASK ( 0x3ffffffU )
+
+#define BYTES_TO_U32_LE( data, offset )                           \
+    ( (uint32_t) (data)[offset]                                   \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 1] << 8 )     \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 2] << 16 )    \
+      | (uint32_t) ( (uint32_t) (data)[( offset ) + 3] << 24 )    \
+    )
+
+#define U32_TO_BYTES_LE( value, data, offset )                    \
+    do {                                                          \
+        (data)[offset    ] = (unsigned char) ( (value)       );   \
+        (data)[offset + 1] = (unsigned char) ( (value) >>  8 );   \
+        (data)[offset + 2] = (unsigned char) ( (value) >> 16 );   \
+        (data)[offset + 3] = (unsigned char) ( (value) >> 24 );   \
+    } while( 0 )
+
+/**
+ * \brief                   Process blocks with Poly1305.
+ *
+ * \param ctx               The Poly1305 context.
+ * \param nblocks           Number of blocks to process. Note that this
+ *                          function only processes full blocks.
+ * \param input             Buffer containing the input block(s).
+ * \param needs_padding     Set to 0 if the padding bit has already been
+ *                          applied to the input data before calling this
+ *                          function.  Otherwise, set this parameter to 1.
+ */
+static void poly1305_process( mbedtls_poly1305_context *ctx,
+                              size_t nblocks,
+                              const unsigned char *input,
+                              uint32_t needs_padding )
+{
+    const uint32_t hibit = needs_padding << 24;
+    const uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2];
+    const uint32_t r3 = ctx->r[3], r4 = ctx->r[4];
+    /* 2^130 = 5 mod p: limbs that overflow 2^130 come back multiplied by 5 */
+    const uint32_t s1 = r1 * 5U, s2 = r2 * 5U, s3 = r3 * 5U, s4 = r4 * 5U;
+    uint32_t h0 = ctx->acc[0], h1 = ctx->acc[1], h2 = ctx->acc[2];
+    uint32_t h3 = ctx->acc[3], h4 = ctx->acc[4];
+    uint64_t d0, d1, d2, d3, d4;
+    uint32_t c;
+    size_t offset = 0U;
+
+    while( nblocks-- > 0U )
+    {
+        /* acc += m, the block being split in 26-bit limbs */
+        h0 += ( BYTES_TO_U32_LE( input, offset      )      ) & POLY1305_LIMB_MASK;
+        h1 += ( BYTES_TO_U32_LE( input, offset +  3 ) >> 2 ) & POLY1305_LIMB_MASK;
+        h2 += ( BYTES_TO_U32_LE( input, offset +  6 ) >> 4 ) & POLY1305_LIMB_MASK;
+        h3 += ( BYTES_TO_U32_LE( input, offset +  9 ) >> 6 ) & POLY1305_LIMB_MASK;
+        h4 += ( BYTES_TO_U32_LE( input, offset + 12 ) >> 8 ) | hibit;
+
+        /* acc *= r */
+        d0 = (uint64_t) h0 * r0 + (uint64_t) h1 * s4 + (uint64_t) h2 * s3 +
+             (uint64_t) h3 * s2 + (uint64_t) h4 * s1;
+        d1 = (uint64_t) h0 * r1 + (uint64_t) h1 * r0 + (uint64_t) h2 * s4 +
+             (uint64_t) h3 * s3 + (uint64_t) h4 * s2;
+        d2 = (uint64_t) h0 * r2 + (uint64_t) h1 * r1 + (uint64_t) h2 * r0 +
+             (uint64_t) h3 * s4 + (uint64_t) h4 * s3;
+        d3 = (uint64_t) h0 * r3 + (uint64_t) h1 * r2 + (uint64_t) h2 * r1 +
+             (uint64_t) h3 * r0 + (uint64_t) h4 * s4;
+        d4 = (uint64_t) h0 * r4 + (uint64_t) h1 * r3 + (uint64_t) h2 * r2 +
+             (uint64_t) h3 * r1 + (uint64_t) h4 * r0;
+
+        /* Partial reduction mod 2^130 - 5 */
+        c = (uint32_t) ( d0 >> 26 ); h0 = (uint32_t) d0 & POLY1305_LIMB_MASK;
+        d1 += c; c = (uint32_t) ( d1 >> 26 ); h1 = (uint32_t) d1 & POLY1305_LIMB_MASK;
+        d2 += c; c = (uint32_t) ( d2 >> 26 ); h2 = (uint32_t) d2 & POLY1305_LIMB_MASK;
+        d3 += c; c = (uint32_t) ( d3 >> 26 ); h3 = (uint32_t) d3 & POLY1305_LIMB_MASK;
+        d4 += c; c = (uint32_t) ( d4 >> 26 ); h4 = (uint32_t) d4 & POLY1305_LIMB_MASK;
+        h0 += c * 5U; c = h0 >> 26; h0 &= POLY1305_LIMB_MASK;
+        h1 += c;
+
+        offset += POLY1305_BLOCK_SIZE_BYTES;
+    }
+
+    ctx->acc[0] = h0;
+    ctx->acc[1] = h1;
+    ctx->acc[2] = h2;
+    ctx->acc[3] = h3;
+    ctx->acc[4] = h4;
+}
+
+/**
+ * \brief                   Compute the Poly1305 MAC
+ *
+ * \param ctx               The Poly1305 context.
+ * \param mac               The buffer to where the MAC is written. Must be
+ *                          big enough to contain the 16-byte MAC.
+ */
+static void poly1305_compute_mac( const mbedtls_poly1305_context *ctx,
+                                  unsigned char mac[16] )
+{
+    uint32_t h0 = ctx->acc[0], h1 = ctx->acc[1], h2 = ctx->acc[2];
+    uint32_t h3 = ctx->acc[3], h4 = ctx->acc[4];
+    uint32_t g0, g1, g2, g3, g4;
+    uint32_t c, mask;
+    uint64_t f;
+
+    /* Full carry */
+    c = h1 >> 26; h1 &= POLY1305_LIMB_MASK;
+    h2 += c; c = h2 >> 26; h2 &= POLY1305_LIMB_MASK;
+    h3 += c; c = h3 >> 26; h3 &= POLY1305_LIMB_MASK;
+    h4 += c; c = h4 >> 26; h4 &= POLY1305_LIMB_MASK;
+    h0 += c * 5U; c = h0 >> 26; h0 &= POLY1305_LIMB_MASK;
+    h1 += c;
+
+    /* g = acc - ( 2^130 - 5 ) */
+    g0 = h0 + 5U; c = g0 >> 26; g0 &= POLY1305_LIMB_MASK;
+    g1 = h1 + c;  c = g1 >> 26; g1 &= POLY1305_LIMB_MASK;
+    g2 = h2 + c;  c = g2 >> 26; g2 &= POLY1305_LIMB_MASK;
+    g3 = h3 + c;  c = g3 >> 26; g3 &= POLY1305_LIMB_MASK;
+    g4 = h4 + c - ( 1UL << 26 );
+
+    /* Select acc if g is negative, g otherwise, in constant time */
+    mask = ( g4 >> 31 ) - 1U;
+    g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+    mask = ~mask;
+    h0 = ( h0 & mask ) | g0;
+    h1 = ( h1 & mask ) | g1;
+    h2 = ( h2 & mask ) | g2;
+    h3 = ( h3 & mask ) | g3;
+    h4 = ( h4 & mask ) | g4;
+
+    /* Back to 32-bit words, acc mod 2^128 */
+    h0 = ( h0       ) | ( h1 << 26 );
+    h1 = ( h1 >>  6 ) | ( h2 << 20 );
+    h2 = ( h2 >> 12 ) | ( h3 << 14 );
+    h3 = ( h3 >> 18 ) | ( h4 <<  8 );
+
+    /* mac = ( acc + s ) mod 2^128 */
+    f = (uint64_t) h0 + ctx->s[0];             h0 = (uint32_t) f;
+    f = (uint64_t) h1 + ctx->s[1] + ( f >> 32 ); h1 = (uint32_t) f;
+    f = (uint64_t) h2 + ctx->s[2] + ( f >> 32 ); h2 = (uint32_t) f;
+    f = (uint64_t) h3 + ctx->s[3] + ( f >> 32 ); h3 = (uint32_t) f;
+
+    U32_TO_BYTES_LE( h0, mac,  0 );
+    U32_TO_BYTES_LE( h1, mac,  4 );
+    U32_TO_BYTES_LE( h2, mac,  8 );
+    U32_TO_BYTES_LE( h3, mac, 12 );
+}
+
+void mbedtls_poly1305_init( mbedtls_poly1305_context *ctx )
+{
+    POLY1305_VALIDATE( ctx != NULL );
+
+    mbedtls_platform_zeroize( ctx, sizeof( mbedtls_poly1305_context ) );
+}
+
+void mbedtls_poly1305_free( mbedtls_poly1305_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    mbedtls_platform_zeroize( ctx, sizeof( mbedtls_poly1305_context ) );
+}
+
+int mbedtls_poly1305_starts( mbedtls_poly1305_context *ctx,
+                             const unsigned char key[32] )
+{
+    POLY1305_VALIDATE_RET( ctx != NULL );
+    POLY1305_VALIDATE_RET( key != NULL );
+
+    /* r &= 0x0ffffffc0ffffffc0ffffffc0fffffff, in 26-bit limbs */
+    ctx->r[0] = ( BYTES_TO_U32_LE( key,  0 )      ) & 0x3ffffffU;
+    ctx->r[1] = ( BYTES_TO_U32_LE( key,  3 ) >> 2 ) & 0x3ffff03U;
+    ctx->r[2] = ( BYTES_TO_U32_LE( key,  6 ) >> 4 ) & 0x3ffc0ffU;
+    ctx->r[3] = ( BYTES_TO_U32_LE( key,  9 ) >> 6 ) & 0x3f03fffU;
+    ctx->r[4] = ( BYTES_TO_U32_LE( key, 12 ) >> 8 ) & 0x00fffffU;
+
+    ctx->s[0] = BYTES_TO_U32_LE( key, 16 );
+    ctx->s[1] = BYTES_TO_U32_LE( key, 20 );
+    ctx->s[2] = BYTES_TO_U32_LE( key, 24 );
+    ctx->s[3] = BYTES_TO_U32_LE( key, 28 );
+
+    /* Initial accumulator state */
+    ctx->acc[0] = 0U;
+    ctx->acc[1] = 0U;
+    ctx->acc[2] = 0U;
+    ctx->acc[3] = 0U;
+    ctx->acc[4] = 0U;
+
+    /* Queue initially empty */
+    mbedtls_platform_zeroize( ctx->queue, sizeof( ctx->queue ) );
+    ctx->queue_len = 0U;
+
+    return( 0 );
+}
+
+int mbedtls_poly1305_update( mbedtls_poly1305_context *ctx,
+                             const unsigned char *input,
+                             size_t ilen )
+{
+    size_t offset    = 0U;
+    size_t remaining = ilen;
+    size_t queue_free_len;
+    size_t nblocks;
+    POLY1305_VALIDATE_RET( ctx != NULL );
+    POLY1305_VALIDATE_RET( ilen == 0 || input != NULL );
+
+    if( ( remaining > 0U ) && ( ctx->queue_len > 0U ) )
+    {
+        queue_free_len = ( POLY1305_BLOCK_SIZE_BYTES - ctx->queue_len );
+
+        if( ilen < queue_free_len )
+        {
+            /* Not enough data to complete the block.
+             * Store this data with the other leftovers.
+             */
+            memcpy( &ctx->queue[ctx->queue_len],
+                    input,
+                    ilen );
+
+            ctx->queue_len += ilen;
+
+            remaining = 0U;
+        }
+        else
+        {
+            /* Enough data to produce a complete block */
+            memcpy( &ctx->queue[ctx->queue_len],
+                    input,
+                    queue_free_len );
+
+            ctx->queue_len = 0U;
+
+            poly1305_process( ctx, 1U, ctx->queue, 1U ); /* add padding bit */
+
+            offset    += queue_free_len;
+            remaining -= queue_free_len;
+        }
+    }
+
+    if( remaining >= POLY1305_BLOCK_SIZE_BYTES )
+    {
+        nblocks = remaining / POLY1305_BLOCK_SIZE_BYTES;
+
+        poly1305_process( ctx, nblocks, &input[offset], 1U );
+
+        offset += nblocks * POLY1305_BLOCK_SIZE_BYTES;
+        remaining %= POLY1305_BLOCK_SIZE_BYTES;
+    }
+
+    if( remaining > 0U )
+    {
+        /* Store partial block */
+        ctx->queue_len = remaining;
+        memcpy( ctx->queue, &input[offset], remaining );
+    }
+
+    return( 0 );
+}
+
+int mbedtls_poly1305_finish( mbedtls_poly1305_context *ctx,
+                             unsigned char mac[16] )
+{
+    POLY1305_VALIDATE_RET( ctx != NULL );
+    POLY1305_VALIDATE_RET( mac != NULL );
+
+    /* Process any leftover data */
+    if( ctx->queue_len > 0U )
+    {
+        /* Add padding bit */
+        ctx->queue[ctx->queue_len] = 1U;
+        ctx->queue_len++;
+
+        /* Pad with zeroes */
+        memset( &ctx->queue[ctx->queue_len],
+                0,
+                POLY1305_BLOCK_SIZE_BYTES - ctx->queue_len );
+
+        poly1305_process( ctx, 1U,          /* Process 1 block */
+                          ctx->queue, 0U ); /* Already padded above */
+    }
+
+    poly1305_compute_mac( ctx, mac );
+
+    return( 0 );
+}
+
+int mbedtls_poly1305_mac( const unsigned char key[32],
+                          const unsigned char *input,
+                          size_t ilen,
+                          unsigned char mac[16] )
+{
+    mbedtls_poly1305_context ctx;
+    int ret;
+    POLY1305_VALIDATE_RET( key != NULL );
+    POLY1305_VALIDATE_RET( mac != NULL );
+    POLY1305_VALIDATE_RET( ilen == 0 || input != NULL );
+
+    mbedtls_poly1305_init( &ctx );
+
+    ret = mbedtls_poly1305_starts( &ctx, key );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = mbedtls_poly1305_update( &ctx, input, ilen );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = mbedtls_poly1305_finish( &ctx, mac );
+
+cleanup:
+    mbedtls_poly1305_free( &ctx );
+    return( ret );
+}
+
+#endif /* MBEDTLS_POLY1305_ALT */
+
+#if defined(MBEDTLS_SELF_TEST)
+
+static const unsigned char test_keys[2][32] =
+{
+    {
+        0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+        0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+        0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+        0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b
+    },
+    {
+        0x1c, 0x92, 0x40, 0xa5, 0xeb, 0x55, 0xd3, 0x8a,
+        0xf3, 0x33, 0x88, 0x86, 0x04, 0xf6, 0xb5, 0xf0,
+        0x47, 0x39, 0x17, 0xc1, 0x40, 0x2b, 0x80, 0x09,
+        0x9d, 0xca, 0x5c, 0xbc, 0x20, 0x70, 0x75, 0xc0
+    }
+};
+
+static const unsigned char test_data[2][127] =
+{
+    {
+        0x43, 0x72, 0x79, 0x70, 0x74, 0x6f, 0x67, 0x72,
+        0x61, 0x70, 0x68, 0x69, 0x63, 0x20, 0x46, 0x6f,
+        0x72, 0x75, 0x6d, 0x20, 0x52, 0x65, 0x73, 0x65,
+        0x61, 0x72, 0x63, 0x68, 0x20, 0x47, 0x72, 0x6f,
+        0x75, 0x70
+    },
+    {
+        0x27, 0x54, 0x77, 0x61, 0x73, 0x20, 0x62, 0x72,
+        0x69, 0x6c, 0x6c, 0x69, 0x67, 0x2c, 0x20, 0x61,
+        0x6e, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73,
+        0x6c, 0x69, 0x74, 0x68, 0x79, 0x20, 0x74, 0x6f,
+        0x76, 0x65, 0x73, 0x0a, 0x44, 0x69, 0x64, 0x20,
+        0x67, 0x79, 0x72, 0x65, 0x20, 0x61, 0x6e, 0x64,
+        0x20, 0x67, 0x69, 0x6d, 0x62, 0x6c, 0x65, 0x20,
+        0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x77,
+        0x61, 0x62, 0x65, 0x3a, 0x0a, 0x41, 0x6c, 0x6c,
+        0x20, 0x6d, 0x69, 0x6d, 0x73, 0x79, 0x20, 0x77,
+        0x65, 0x72, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20,
+        0x62, 0x6f, 0x72, 0x6f, 0x67, 0x6f, 0x76, 0x65,
+        0x73, 0x2c, 0x0a, 0x41, 0x6e, 0x64, 0x20, 0x74,
+        0x68, 0x65, 0x20, 0x6d, 0x6f, 0x6d, 0x65, 0x20,
+        0x72, 0x61, 0x74, 0x68, 0x73, 0x20, 0x6f, 0x75,
+        0x74, 0x67, 0x72, 0x61, 0x62, 0x65, 0x2e
+    }
+};
+
+static const size_t test_data_len[2] =
+{
+    34U,
+    127U
+};
+
+static const unsigned char test_mac[2][16] =
+{
+    {
+        0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+        0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9
+    },
+    {
+        0x45, 0x41, 0x66, 0x9a, 0x7e, 0xaa, 0xee, 0x61,
+        0xe7, 0x08, 0xdc, 0x7c, 0xbc, 0xc5, 0xeb, 0x62
+    }
+};
+
+#define ASSERT( cond, args )            \
+    do                                  \
+    {                                   \
+        if( ! ( cond ) )                \
+        {                               \
+            if( verbose != 0 )          \
+                mbedtls_printf args;    \
+                                        \
+            return( -1 );               \
+        }                               \
+    }                                   \
+    while( 0 )
+
+int mbedtls_poly1305_self_test( int verbose )
+{
+    unsigned char mac[16];
+    unsigned i;
+    int ret;
+
+    for( i = 0U; i < 2U; i++ )
+    {
+        if( verbose != 0 )
+            mbedtls_printf( "  Poly1305 test %u ", i );
+
+        ret = mbedtls_poly1305_mac( test_keys[i],
+                                    test_data[i],
+                                    test_data_len[i],
+                                    mac );
+        ASSERT( 0 == ret, ( "error code: %i\n", ret ) );
+
+        ASSERT( 0 == memcmp( mac, test_mac[i], 16U ), ( "failed (mac)\n" ) );
+
+        if( verbose != 0 )
+            mbedtls_printf( "passed\n" );
+    }
+
+    if( verbose != 0 )
+        mbedtls_printf( "\n" );
+
+    return( 0 );
+}
+
+#endif /* MBEDTLS_SELF_TEST */
+
+#endif /* MBEDTLS_POLY1305_C */
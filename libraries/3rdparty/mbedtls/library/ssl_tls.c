@@ -125,10 +125,10 @@ static size_t ssl_get_maximum_datagram_size( mbedtls_ssl_context const *ssl )
 {
     size_t mtu = ssl_get_current_mtu( ssl );
 
-    if( mtu != 0 && mtu < MBEDTLS_SSL_OUT_BUFFER_LEN )
+    if( mtu != 0 && mtu < mbedtls_ssl_out_buf_len( ssl ) )
         return( mtu );
 
-    return( MBEDTLS_SSL_OUT_BUFFER_LEN );
+    return( mbedtls_ssl_out_buf_len( ssl ) );
 }
 
 static int ssl_get_remaining_space_in_datagram( mbedtls_ssl_context const *ssl )
@@ -2410,7 +2410,7 @@ static int ssl_compress_buf( mbedtls_ssl_context *ssl )
     ssl->transform_out->ctx_deflate.next_in = msg_pre;
     ssl->transform_out->ctx_deflate.avail_in = len_pre;
     ssl->transform_out->ctx_deflate.next_out = msg_post;
-    ssl->transform_out->ctx_deflate.avail_out = MBEDTLS_SSL_OUT_BUFFER_LEN - bytes_written;
+    ssl->transform_out->ctx_deflate.avail_out = mbedtls_ssl_out_buf_len( ssl ) - bytes_written;
 
     ret = deflate( &ssl->transform_out->ctx_deflate, Z_SYNC_FLUSH );
     if( ret != Z_OK )
@@ -2419,7 +2419,7 @@ static int ssl_compress_buf( mbedtls_ssl_context *ssl )
         return( MBEDTLS_ERR_SSL_COMPRESSION_FAILED );
     }
 
-    ssl->out_msglen = MBEDTLS_SSL_OUT_BUFFER_LEN -
+    ssl->out_msglen = mbedtls_ssl_out_buf_len( ssl ) -
                       ssl->transform_out->ctx_deflate.avail_out - bytes_written;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "after compression: msglen = %d, ",
@@ -2457,7 +2457,7 @@ static int ssl_decompress_buf( mbedtls_ssl_context *ssl )
     ssl->transform_in->ctx_inflate.next_in = msg_pre;
     ssl->transform_in->ctx_inflate.avail_in = len_pre;
     ssl->transform_in->ctx_inflate.next_out = msg_post;
-    ssl->transform_in->ctx_inflate.avail_out = MBEDTLS_SSL_IN_BUFFER_LEN -
+    ssl->transform_in->ctx_inflate.avail_out = mbedtls_ssl_in_buf_len( ssl ) -
                                                header_bytes;
 
     ret = inflate( &ssl->transform_in->ctx_inflate, Z_SYNC_FLUSH );
@@ -2467,7 +2467,7 @@ static int ssl_decompress_buf( mbedtls_ssl_context *ssl )
         return( MBEDTLS_ERR_SSL_COMPRESSION_FAILED );
     }
 
-    ssl->in_msglen = MBEDTLS_SSL_IN_BUFFER_LEN -
+    ssl->in_msglen = mbedtls_ssl_in_buf_len( ssl ) -
                      ssl->transform_in->ctx_inflate.avail_out - header_bytes;
 
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "after decompression: msglen = %d, ",
@@ -2542,7 +2542,7 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
     }
 
-    if( nb_want > MBEDTLS_SSL_IN_BUFFER_LEN - (size_t)( ssl->in_hdr - ssl->in_buf ) )
+    if( nb_want > mbedtls_ssl_in_buf_len( ssl ) - (size_t)( ssl->in_hdr - ssl->in_buf ) )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "requesting more data than fits" ) );
         return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
@@ -2628,7 +2628,7 @@ int mbedtls_ssl_fetch_input( mbedtls_ssl_context *ssl, size_t nb_want )
         }
         else
         {
-            len = MBEDTLS_SSL_IN_BUFFER_LEN - ( ssl->in_hdr - ssl->in_buf );
+            len = mbedtls_ssl_in_buf_len( ssl ) - ( ssl->in_hdr - ssl->in_buf );
 
             if( ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER )
                 timeout = ssl->handshake->retransmit_timeout;
@@ -4088,7 +4088,7 @@ static int ssl_parse_record_header( mbedtls_ssl_context *ssl )
     }
 
     /* Check length against the size of our buffer */
-    if( ssl->in_msglen > MBEDTLS_SSL_IN_BUFFER_LEN
+    if( ssl->in_msglen > mbedtls_ssl_in_buf_len( ssl )
                          - (size_t)( ssl->in_msg - ssl->in_buf ) )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "bad message length" ) );
@@ -4877,7 +4877,7 @@ static int ssl_load_buffered_record( mbedtls_ssl_context *ssl )
     MBEDTLS_SSL_DEBUG_MSG( 2, ( "Found buffered record from current epoch - load" ) );
 
     /* Double-check that the record is not too large */
-    if( rec_len > MBEDTLS_SSL_IN_BUFFER_LEN -
+    if( rec_len > mbedtls_ssl_in_buf_len( ssl ) -
         (size_t)( ssl->in_hdr - ssl->in_buf ) )
     {
         MBEDTLS_SSL_DEBUG_MSG( 1, ( "should never happen" ) );
@@ -6304,6 +6304,128 @@ static void ssl_calc_finished_tls_sha384(
 #endif /* MBEDTLS_SHA512_C */
 #endif /* MBEDTLS_SSL_PROTO_TLS1_2 */
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+/*
+ * Size of the input buffer needed once the handshake is over: the largest
+ * record the peer may still send, which is bounded by the maximum fragment
+ * length only if the peer agreed to it.
+ */
+static size_t ssl_get_in_buf_len_needed( const mbedtls_ssl_context *ssl )
+{
+    size_t len = MBEDTLS_SSL_IN_CONTENT_LEN;
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    /* A client only records the code when the server echoed its own */
+    if( ssl->session != NULL &&
+        ssl->session->mfl_code != MBEDTLS_SSL_MAX_FRAG_LEN_NONE &&
+        ( ssl->conf->endpoint == MBEDTLS_SSL_IS_SERVER ||
+          ssl->session->mfl_code == ssl->conf->mfl_code ) &&
+        ssl_mfl_code_to_length( ssl->session->mfl_code ) < len )
+    {
+        len = ssl_mfl_code_to_length( ssl->session->mfl_code );
+    }
+#endif
+
+    return( MBEDTLS_SSL_HEADER_LEN + MBEDTLS_SSL_PAYLOAD_OVERHEAD + len );
+}
+
+/*
+ * Size of the output buffer needed once the handshake is over: we never
+ * send records longer than our own maximum fragment length.
+ */
+static size_t ssl_get_out_buf_len_needed( const mbedtls_ssl_context *ssl )
+{
+    size_t len = MBEDTLS_SSL_OUT_CONTENT_LEN;
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if( mbedtls_ssl_get_max_frag_len( ssl ) < len )
+        len = mbedtls_ssl_get_max_frag_len( ssl );
+#endif
+
+    return( MBEDTLS_SSL_HEADER_LEN + MBEDTLS_SSL_PAYLOAD_OVERHEAD + len );
+}
+
+/*
+ * Move a record buffer to a new allocation of new_len bytes, keeping its
+ * first used bytes, and rebase the given pointers into it.
+ */
+static int ssl_resize_buffer( unsigned char **buf, size_t *buf_len,
+                              size_t new_len, size_t used,
+                              unsigned char **ptrs[], size_t ptrs_count )
+{
+    unsigned char *new_buf;
+    size_t i;
+
+    if( ( new_buf = mbedtls_calloc( 1, new_len ) ) == NULL )
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+
+    memcpy( new_buf, *buf, used );
+
+    for( i = 0; i < ptrs_count; i++ )
+    {
+        if( *ptrs[i] != NULL )
+            *ptrs[i] = new_buf + ( *ptrs[i] - *buf );
+    }
+
+    mbedtls_platform_zeroize( *buf, *buf_len );
+    mbedtls_free( *buf );
+
+    *buf = new_buf;
+    *buf_len = new_len;
+
+    return( 0 );
+}
+
+/*
+ * Resize the record buffers. A buffer is left alone if it already has the
+ * requested size, or if it holds more data than would fit.
+ */
+static int ssl_set_buffer_lengths( mbedtls_ssl_context *ssl,
+                                   size_t in_len, size_t out_len )
+{
+    unsigned char **in_ptrs[] = { &ssl->in_ctr, &ssl->in_hdr, &ssl->in_len,
+                                  &ssl->in_iv, &ssl->in_msg, &ssl->in_offt };
+    unsigned char **out_ptrs[] = { &ssl->out_ctr, &ssl->out_hdr, &ssl->out_len,
+                                   &ssl->out_iv, &ssl->out_msg };
+    size_t in_used, out_used;
+    int ret;
+
+    /* Pending input runs up to in_hdr + in_left, and the current message
+     * up to in_msg + in_msglen; pending output up to out_hdr. */
+    in_used = (size_t)( ssl->in_hdr - ssl->in_buf ) + ssl->in_left;
+    if( (size_t)( ssl->in_msg - ssl->in_buf ) + ssl->in_msglen > in_used )
+        in_used = (size_t)( ssl->in_msg - ssl->in_buf ) + ssl->in_msglen;
+
+    out_used = (size_t)( ssl->out_hdr - ssl->out_buf );
+    if( (size_t)( ssl->out_msg - ssl->out_buf ) + ssl->out_msglen > out_used )
+        out_used = (size_t)( ssl->out_msg - ssl->out_buf ) + ssl->out_msglen;
+
+    if( in_len != ssl->in_buf_len && in_used <= in_len )
+    {
+        if( ( ret = ssl_resize_buffer( &ssl->in_buf, &ssl->in_buf_len,
+                                       in_len, in_used, in_ptrs,
+                                       sizeof( in_ptrs ) / sizeof( in_ptrs[0] ) ) ) != 0 )
+            return( ret );
+
+        MBEDTLS_SSL_DEBUG_MSG( 2, ( "input buffer resized to %d bytes",
+                                    (int) in_len ) );
+    }
+
+    if( out_len != ssl->out_buf_len && out_used <= out_len )
+    {
+        if( ( ret = ssl_resize_buffer( &ssl->out_buf, &ssl->out_buf_len,
+                                       out_len, out_used, out_ptrs,
+                                       sizeof( out_ptrs ) / sizeof( out_ptrs[0] ) ) ) != 0 )
+            return( ret );
+
+        MBEDTLS_SSL_DEBUG_MSG( 2, ( "output buffer resized to %d bytes",
+                                    (int) out_len ) );
+    }
+
+    return( 0 );
+}
+#endif /* MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH */
+
 static void ssl_handshake_wrapup_free_hs_transform( mbedtls_ssl_context *ssl )
 {
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "=> handshake wrapup: final free" ) );
@@ -6326,6 +6448,18 @@ static void ssl_handshake_wrapup_free_hs_transform( mbedtls_ssl_context *ssl )
     ssl->transform = ssl->transform_negotiate;
     ssl->transform_negotiate = NULL;
 
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /*
+     * Only records of the negotiated size can follow: give back the rest
+     * of the buffers. This is not an error if memory is too fragmented.
+     */
+    if( ssl_set_buffer_lengths( ssl, ssl_get_in_buf_len_needed( ssl ),
+                                ssl_get_out_buf_len_needed( ssl ) ) != 0 )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "could not shrink the record buffers" ) );
+    }
+#endif
+
     MBEDTLS_SSL_DEBUG_MSG( 3, ( "<= handshake wrapup: final free" ) );
 }
 
@@ -6664,6 +6798,16 @@ void mbedtls_ssl_session_init( mbedtls_ssl_session *session )
 
 static int ssl_handshake_init( mbedtls_ssl_context *ssl )
 {
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    /* Handshake messages are only bounded by the full buffer sizes */
+    if( ssl_set_buffer_lengths( ssl, MBEDTLS_SSL_IN_BUFFER_LEN,
+                                MBEDTLS_SSL_OUT_BUFFER_LEN ) != 0 )
+    {
+        MBEDTLS_SSL_DEBUG_MSG( 1, ( "alloc() of record buffers failed" ) );
+        return( MBEDTLS_ERR_SSL_ALLOC_FAILED );
+    }
+#endif
+
     /* Clear old handshake information if present */
     if( ssl->transform_negotiate )
         mbedtls_ssl_transform_free( ssl->transform_negotiate );
@@ -6886,6 +7030,9 @@ int mbedtls_ssl_setup( mbedtls_ssl_context *ssl,
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
         goto error;
     }
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->in_buf_len = MBEDTLS_SSL_IN_BUFFER_LEN;
+#endif
 
     ssl->out_buf = mbedtls_calloc( 1, MBEDTLS_SSL_OUT_BUFFER_LEN );
     if( ssl->out_buf == NULL )
@@ -6894,6 +7041,9 @@ int mbedtls_ssl_setup( mbedtls_ssl_context *ssl,
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
         goto error;
     }
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->out_buf_len = MBEDTLS_SSL_OUT_BUFFER_LEN;
+#endif
 
     ssl_reset_in_out_pointers( ssl );
 
@@ -6910,6 +7060,10 @@ error:
 
     ssl->in_buf = NULL;
     ssl->out_buf = NULL;
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    ssl->in_buf_len = 0;
+    ssl->out_buf_len = 0;
+#endif
 
     ssl->in_hdr = NULL;
     ssl->in_ctr = NULL;
@@ -6991,14 +7145,14 @@ static int ssl_session_reset_int( mbedtls_ssl_context *ssl, int partial )
     ssl->session_in = NULL;
     ssl->session_out = NULL;
 
-    memset( ssl->out_buf, 0, MBEDTLS_SSL_OUT_BUFFER_LEN );
+    memset( ssl->out_buf, 0, mbedtls_ssl_out_buf_len( ssl ) );
 
 #if defined(MBEDTLS_SSL_DTLS_CLIENT_PORT_REUSE) && defined(MBEDTLS_SSL_SRV_C)
     if( partial == 0 )
 #endif /* MBEDTLS_SSL_DTLS_CLIENT_PORT_REUSE && MBEDTLS_SSL_SRV_C */
     {
         ssl->in_left = 0;
-        memset( ssl->in_buf, 0, MBEDTLS_SSL_IN_BUFFER_LEN );
+        memset( ssl->in_buf, 0, mbedtls_ssl_in_buf_len( ssl ) );
     }
 
 #if defined(MBEDTLS_SSL_HW_RECORD_ACCEL)
@@ -8935,13 +9089,13 @@ void mbedtls_ssl_free( mbedtls_ssl_context *ssl )
 
     if( ssl->out_buf != NULL )
     {
-        mbedtls_platform_zeroize( ssl->out_buf, MBEDTLS_SSL_OUT_BUFFER_LEN );
+        mbedtls_platform_zeroize( ssl->out_buf, mbedtls_ssl_out_buf_len( ssl ) );
         mbedtls_free( ssl->out_buf );
     }
 
     if( ssl->in_buf != NULL )
     {
-        mbedtls_platform_zeroize( ssl->in_buf, MBEDTLS_SSL_IN_BUFFER_LEN );
+        mbedtls_platform_zeroize( ssl->in_buf, mbedtls_ssl_in_buf_len( ssl ) );
         mbedtls_free( ssl->in_buf );
     }
 
@@ -0,0 +1,309 @@
+/*
+ *  TLS record protection benchmark: AES-128-GCM vs ChaCha20-Poly1305
+ *
+ *  Copyright (C) 2006-2018, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * Usage: aead_bench [--check]
+ *
+ * Without arguments, reports the cost per byte of protecting TLS 1.2
+ * records of a few typical sizes, through the same cipher layer calls as
+ * ssl_tls.c: a 13-byte additional data block, a 16-byte tag, and a new
+ * nonce for every record.
+ *
+ * With --check, runs the self tests of the modules instead and checks that
+ * feeding ChaCha20-Poly1305 and Poly1305 in pieces of every size gives the
+ * same result as a single call.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/aes.h"
+#include "mbedtls/chacha20.h"
+#include "mbedtls/chachapoly.h"
+#include "mbedtls/cipher.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/poly1305.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT    "cycles"
+static uint64_t bench_now( void )
+{
+    return( __rdtsc() );
+}
+#else
+#define BENCH_UNIT    "ns"
+static uint64_t bench_now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return( (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec );
+}
+#endif
+
+/* Bytes protected per measurement, whatever the record size */
+#define BENCH_VOLUME    ( 1024 * 1024 )
+
+#define RECORD_MAX      16384
+
+static unsigned char plain[RECORD_MAX];
+static unsigned char cipher[RECORD_MAX];
+
+static void fill( unsigned char *buf, size_t len, uint32_t seed )
+{
+    size_t i;
+
+    for( i = 0; i < len; i++ )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        buf[i] = (unsigned char) seed;
+    }
+}
+
+/*
+ * Encrypt and authenticate BENCH_VOLUME bytes in records of len bytes.
+ * Returns the cost per byte, or a negative value on error.
+ */
+static double bench_cipher( mbedtls_cipher_type_t type, size_t len )
+{
+    mbedtls_cipher_context_t ctx;
+    unsigned char key[32], iv[12], aad[13], tag[16];
+    size_t olen, records, i;
+    uint64_t start, elapsed;
+    double result = -1.0;
+
+    mbedtls_cipher_init( &ctx );
+    fill( key, sizeof( key ), 1 );
+    fill( iv, sizeof( iv ), 2 );
+    fill( aad, sizeof( aad ), 3 );
+
+    if( mbedtls_cipher_setup( &ctx, mbedtls_cipher_info_from_type( type ) ) != 0 ||
+        mbedtls_cipher_setkey( &ctx, key,
+                               (int) mbedtls_cipher_get_key_bitlen( &ctx ),
+                               MBEDTLS_ENCRYPT ) != 0 )
+        goto exit;
+
+    records = BENCH_VOLUME / len;
+
+    start = bench_now();
+    for( i = 0; i < records; i++ )
+    {
+        /* Explicit part of the nonce, as ssl_encrypt_buf() derives it */
+        iv[11] = (unsigned char) i;
+        iv[10] = (unsigned char)( i >> 8 );
+
+        if( mbedtls_cipher_auth_encrypt( &ctx, iv, sizeof( iv ),
+                                         aad, sizeof( aad ),
+                                         plain, len, cipher, &olen,
+                                         tag, sizeof( tag ) ) != 0 )
+            goto exit;
+    }
+    elapsed = bench_now() - start;
+
+    result = (double) elapsed / (double)( records * len );
+
+exit:
+    mbedtls_cipher_free( &ctx );
+    return( result );
+}
+
+static int bench( void )
+{
+    static const size_t sizes[] = { 64, 512, 1024, 4096, 16384 };
+    double gcm, chachapoly;
+    size_t i;
+
+    fill( plain, sizeof( plain ), 4 );
+
+    printf( "%-8s %18s %18s\n", "record",
+            "AES-128-GCM", "CHACHA20-POLY1305" );
+
+    for( i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); i++ )
+    {
+        gcm = bench_cipher( MBEDTLS_CIPHER_AES_128_GCM, sizes[i] );
+        chachapoly = bench_cipher( MBEDTLS_CIPHER_CHACHA20_POLY1305,
+                                   sizes[i] );
+
+        if( gcm < 0 || chachapoly < 0 )
+        {
+            printf( "cipher error\n" );
+            return( 1 );
+        }
+
+        printf( "%-8u %10.1f %s/B %10.1f %s/B\n", (unsigned) sizes[i],
+                gcm, BENCH_UNIT, chachapoly, BENCH_UNIT );
+    }
+
+    return( 0 );
+}
+
+#define CHECK_LEN    300
+
+/*
+ * Process every length up to CHECK_LEN, in pieces of every size, and
+ * compare with the single call result.
+ */
+static int check_pieces( void )
+{
+    mbedtls_chachapoly_context ctx;
+    unsigned char key[32], nonce[12], aad[CHECK_LEN];
+    unsigned char ref[CHECK_LEN], out[CHECK_LEN], back[CHECK_LEN];
+    unsigned char ref_tag[16], mac_tag[16], tag[16];
+    size_t len, piece, off, n;
+    int ret = 1;
+
+    mbedtls_chachapoly_init( &ctx );
+    fill( key, sizeof( key ), 5 );
+    fill( nonce, sizeof( nonce ), 6 );
+    fill( aad, sizeof( aad ), 7 );
+    fill( plain, CHECK_LEN, 8 );
+
+    if( mbedtls_chachapoly_setkey( &ctx, key ) != 0 )
+        goto exit;
+
+    for( len = 0; len <= CHECK_LEN; len++ )
+    {
+        if( mbedtls_chachapoly_encrypt_and_tag( &ctx, len, nonce, aad, len % 29,
+                                                plain, ref, ref_tag ) != 0 )
+            goto exit;
+
+        for( piece = 1; piece <= 67; piece++ )
+        {
+            if( mbedtls_chachapoly_starts( &ctx, nonce,
+                                           MBEDTLS_CHACHAPOLY_ENCRYPT ) != 0 )
+                goto exit;
+
+            for( off = 0; off < len % 29; off += n )
+            {
+                n = len % 29 - off < piece ? len % 29 - off : piece;
+                if( mbedtls_chachapoly_update_aad( &ctx, aad + off, n ) != 0 )
+                    goto exit;
+            }
+
+            for( off = 0; off < len; off += n )
+            {
+                n = len - off < piece ? len - off : piece;
+                if( mbedtls_chachapoly_update( &ctx, n, plain + off,
+                                               out + off ) != 0 )
+                    goto exit;
+            }
+
+            if( mbedtls_chachapoly_finish( &ctx, tag ) != 0 ||
+                memcmp( out, ref, len ) != 0 ||
+                memcmp( tag, ref_tag, sizeof( tag ) ) != 0 )
+            {
+                printf( "  ChaCha20-Poly1305 mismatch, length %u piece %u\n",
+                        (unsigned) len, (unsigned) piece );
+                goto exit;
+            }
+
+            if( mbedtls_poly1305_mac( key, plain, len, mac_tag ) != 0 )
+                goto exit;
+
+            {
+                mbedtls_poly1305_context poly;
+
+                mbedtls_poly1305_init( &poly );
+                if( mbedtls_poly1305_starts( &poly, key ) != 0 )
+                    goto exit;
+
+                for( off = 0; off < len; off += n )
+                {
+                    n = len - off < piece ? len - off : piece;
+                    if( mbedtls_poly1305_update( &poly, plain + off, n ) != 0 )
+                        goto exit;
+                }
+
+                if( mbedtls_poly1305_finish( &poly, tag ) != 0 ||
+                    memcmp( tag, mac_tag, sizeof( tag ) ) != 0 )
+                {
+                    printf( "  Poly1305 mismatch, length %u piece %u\n",
+                            (unsigned) len, (unsigned) piece );
+                    goto exit;
+                }
+
+                mbedtls_poly1305_free( &poly );
+            }
+        }
+
+        /* Decrypt in place from an odd offset, then reject a bad tag */
+        memcpy( back + 1, ref, len > CHECK_LEN - 1 ? CHECK_LEN - 1 : len );
+        n = len > CHECK_LEN - 1 ? CHECK_LEN - 1 : len;
+        if( mbedtls_chachapoly_encrypt_and_tag( &ctx, n, nonce, aad, 0,
+                                                plain, ref, ref_tag ) != 0 ||
+            mbedtls_chachapoly_auth_decrypt( &ctx, n, nonce, aad, 0, ref_tag,
+                                             ref, back + 1 ) != 0 ||
+            memcmp( back + 1, plain, n ) != 0 )
+        {
+            printf( "  ChaCha20-Poly1305 decryption failed, length %u\n",
+                    (unsigned) n );
+            goto exit;
+        }
+
+        ref_tag[len % 16] ^= 1;
+        if( mbedtls_chachapoly_auth_decrypt( &ctx, n, nonce, aad, 0, ref_tag,
+                                             ref, back ) !=
+            MBEDTLS_ERR_CHACHAPOLY_AUTH_FAILED )
+        {
+            printf( "  ChaCha20-Poly1305 accepted a bad tag, length %u\n",
+                    (unsigned) n );
+            goto exit;
+        }
+    }
+
+    printf( "  ChaCha20-Poly1305 and Poly1305 in pieces: passed\n" );
+    ret = 0;
+
+exit:
+    mbedtls_chachapoly_free( &ctx );
+    return( ret );
+}
+
+static int check( void )
+{
+    if( mbedtls_aes_self_test( 1 ) != 0 ||
+        mbedtls_gcm_self_test( 1 ) != 0 ||
+        mbedtls_chacha20_self_test( 1 ) != 0 ||
+        mbedtls_poly1305_self_test( 1 ) != 0 ||
+        mbedtls_chachapoly_self_test( 1 ) != 0 )
+        return( 1 );
+
+    return( check_pieces() );
+}
+
+int main( int argc, char *argv[] )
+{
+    if( argc > 1 && strcmp( argv[1], "--check" ) == 0 )
+        return( check() );
+
+    return( bench() );
+}
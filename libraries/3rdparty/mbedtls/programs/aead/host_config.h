@@ -0,0 +1,40 @@
+/*
+ *  Minimal configuration for building the AEAD throughput benchmark on the
+ *  host.
+ *
+ *  Copyright (C) 2006-2018, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef MBEDTLS_AEAD_HOST_CONFIG_H
+#define MBEDTLS_AEAD_HOST_CONFIG_H
+
+/* Same cipher set as the target: software AES with the tables in RAM,
+ * GCM with the 4-bit GHASH tables, and ChaCha20-Poly1305. No AES-NI or
+ * PCLMUL, so that the host figures compare like for like. */
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_AES_C
+#define MBEDTLS_GCM_C
+#define MBEDTLS_CHACHA20_C
+#define MBEDTLS_POLY1305_C
+#define MBEDTLS_CHACHAPOLY_C
+
+#define MBEDTLS_SELF_TEST
+
+#include "mbedtls/check_config.h"
+
+#endif /* MBEDTLS_AEAD_HOST_CONFIG_H */
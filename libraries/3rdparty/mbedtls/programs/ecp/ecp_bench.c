@@ -0,0 +1,301 @@
+/*
+ *  secp256r1 sign / verify / ECDH benchmark and known-answer output
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * Usage: ecp_bench [--kat]
+ *
+ * Without arguments, reports the average cost of an ECDSA signature, an
+ * ECDSA verification and an ECDH exchange (key generation plus shared
+ * secret). As in the TLS stack, every operation loads a fresh group, so the
+ * cost of the base point precomputation is included.
+ *
+ * With --kat, prints the results of a fixed set of operations instead, so
+ * that builds with different options can be compared with diff.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ecdsa.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT    "cycles"
+static uint64_t bench_now( void )
+{
+    return( __rdtsc() );
+}
+#else
+#define BENCH_UNIT    "ns"
+static uint64_t bench_now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return( (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec );
+}
+#endif
+
+#define BENCH_ROUNDS    100
+
+/* Deterministic xorshift generator: reproducible, NOT for real keys */
+static int bench_rng( void *p_rng, unsigned char *output, size_t len )
+{
+    uint32_t *state = (uint32_t *) p_rng;
+    size_t i;
+
+    for( i = 0; i < len; i++ )
+    {
+        *state ^= *state << 13;
+        *state ^= *state >> 17;
+        *state ^= *state << 5;
+        output[i] = (unsigned char) *state;
+    }
+
+    return( 0 );
+}
+
+#define CHK( f ) do { if( ( ret = ( f ) ) != 0 ) goto exit; } while( 0 )
+
+static void print_mpi( const char *name, const mbedtls_mpi *X )
+{
+    unsigned char buf[32];
+    size_t i;
+
+    if( mbedtls_mpi_write_binary( X, buf, sizeof( buf ) ) != 0 )
+    {
+        printf( "%s = (too large)\n", name );
+        return;
+    }
+
+    printf( "%s = ", name );
+    for( i = 0; i < sizeof( buf ); i++ )
+        printf( "%02X", buf[i] );
+    printf( "\n" );
+}
+
+static void print_point( const char *name, const mbedtls_ecp_point *P )
+{
+    char coord[32];
+
+    if( mbedtls_mpi_cmp_int( &P->Z, 0 ) == 0 )
+    {
+        printf( "%s = 0\n", name );
+        return;
+    }
+
+    snprintf( coord, sizeof( coord ), "%s.X", name );
+    print_mpi( coord, &P->X );
+    snprintf( coord, sizeof( coord ), "%s.Y", name );
+    print_mpi( coord, &P->Y );
+}
+
+static int kat( void )
+{
+    static const int small[] = { 1, -1, 2, 3, 31, 32, 33, 63 };
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R, P, Q;
+    mbedtls_mpi m, n, d, r, s;
+    unsigned char hash[32];
+    uint32_t state = 0x12345678;
+    char name[32];
+    size_t i;
+    int ret;
+
+    mbedtls_ecp_group_init( &grp );
+    mbedtls_ecp_point_init( &R );
+    mbedtls_ecp_point_init( &P );
+    mbedtls_ecp_point_init( &Q );
+    mbedtls_mpi_init( &m ); mbedtls_mpi_init( &n ); mbedtls_mpi_init( &d );
+    mbedtls_mpi_init( &r ); mbedtls_mpi_init( &s );
+
+    CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+
+    /* k G for small, random and large k */
+    for( i = 0; i < 20; i++ )
+    {
+        if( i < 8 )
+            CHK( mbedtls_mpi_lset( &m, small[i] > 0 ? small[i] : 1 ) );
+        else if( i < 16 )
+            CHK( mbedtls_ecp_gen_privkey( &grp, &m, bench_rng, &state ) );
+        else
+            CHK( mbedtls_mpi_sub_int( &m, &grp.N, 20 - i ) );
+
+        CHK( mbedtls_ecp_mul( &grp, &R, &m, &grp.G, bench_rng, &state ) );
+        snprintf( name, sizeof( name ), "mul[%u]", (unsigned) i );
+        print_point( name, &R );
+    }
+
+    /* m G + n Q and m P + n Q, including the special scalars */
+    CHK( mbedtls_ecp_gen_keypair( &grp, &d, &Q, bench_rng, &state ) );
+    CHK( mbedtls_ecp_gen_keypair( &grp, &d, &P, bench_rng, &state ) );
+
+    for( i = 0; i < 24; i++ )
+    {
+        if( i < 8 )
+        {
+            CHK( mbedtls_mpi_lset( &m, small[i] ) );
+            CHK( mbedtls_ecp_gen_privkey( &grp, &n, bench_rng, &state ) );
+        }
+        else if( i < 16 )
+        {
+            CHK( mbedtls_ecp_gen_privkey( &grp, &m, bench_rng, &state ) );
+            CHK( mbedtls_mpi_lset( &n, small[i - 8] ) );
+        }
+        else
+        {
+            CHK( mbedtls_ecp_gen_privkey( &grp, &m, bench_rng, &state ) );
+            CHK( mbedtls_ecp_gen_privkey( &grp, &n, bench_rng, &state ) );
+        }
+
+        CHK( mbedtls_ecp_muladd( &grp, &R, &m, &grp.G, &n, &Q ) );
+        snprintf( name, sizeof( name ), "muladd_g[%u]", (unsigned) i );
+        print_point( name, &R );
+
+        CHK( mbedtls_ecp_muladd( &grp, &R, &m, &P, &n, &Q ) );
+        snprintf( name, sizeof( name ), "muladd_p[%u]", (unsigned) i );
+        print_point( name, &R );
+    }
+
+    /* G - G, which adds a point to its opposite */
+    CHK( mbedtls_mpi_lset( &m, 1 ) );
+    CHK( mbedtls_mpi_lset( &n, -1 ) );
+    CHK( mbedtls_ecp_muladd( &grp, &R, &m, &grp.G, &n, &grp.G ) );
+    print_point( "muladd_zero", &R );
+
+    /* Signatures and their verification, valid and corrupted */
+    for( i = 0; i < 8; i++ )
+    {
+        CHK( bench_rng( &state, hash, sizeof( hash ) ) );
+        CHK( mbedtls_ecdsa_sign( &grp, &r, &s, &d, hash, sizeof( hash ),
+                                 bench_rng, &state ) );
+        snprintf( name, sizeof( name ), "sign[%u].r", (unsigned) i );
+        print_mpi( name, &r );
+        snprintf( name, sizeof( name ), "sign[%u].s", (unsigned) i );
+        print_mpi( name, &s );
+
+        printf( "verify[%u] = %d\n", (unsigned) i,
+                mbedtls_ecdsa_verify( &grp, hash, sizeof( hash ), &P, &r, &s ) );
+
+        hash[i] ^= 1;
+        printf( "verify_bad[%u] = %d\n", (unsigned) i,
+                mbedtls_ecdsa_verify( &grp, hash, sizeof( hash ), &P, &r, &s ) );
+    }
+
+exit:
+    mbedtls_ecp_group_free( &grp );
+    mbedtls_ecp_point_free( &R );
+    mbedtls_ecp_point_free( &P );
+    mbedtls_ecp_point_free( &Q );
+    mbedtls_mpi_free( &m ); mbedtls_mpi_free( &n ); mbedtls_mpi_free( &d );
+    mbedtls_mpi_free( &r ); mbedtls_mpi_free( &s );
+
+    return( ret );
+}
+
+static int bench( void )
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q, Qpeer;
+    mbedtls_mpi d, dpeer, r, s, z;
+    unsigned char hash[32];
+    uint32_t state = 0x9E3779B9;
+    uint64_t t_sign = 0, t_verify = 0, t_ecdh = 0, t;
+    int ret, i;
+
+    mbedtls_ecp_group_init( &grp );
+    mbedtls_ecp_point_init( &Q ); mbedtls_ecp_point_init( &Qpeer );
+    mbedtls_mpi_init( &d ); mbedtls_mpi_init( &dpeer );
+    mbedtls_mpi_init( &r ); mbedtls_mpi_init( &s ); mbedtls_mpi_init( &z );
+
+    CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+    CHK( mbedtls_ecp_gen_keypair( &grp, &d, &Q, bench_rng, &state ) );
+    CHK( mbedtls_ecp_gen_keypair( &grp, &dpeer, &Qpeer, bench_rng, &state ) );
+    mbedtls_ecp_group_free( &grp );
+
+    for( i = 0; i < BENCH_ROUNDS; i++ )
+    {
+        CHK( bench_rng( &state, hash, sizeof( hash ) ) );
+
+        t = bench_now();
+        mbedtls_ecp_group_init( &grp );
+        CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+        CHK( mbedtls_ecdsa_sign( &grp, &r, &s, &d, hash, sizeof( hash ),
+                                 bench_rng, &state ) );
+        mbedtls_ecp_group_free( &grp );
+        t_sign += bench_now() - t;
+
+        t = bench_now();
+        mbedtls_ecp_group_init( &grp );
+        CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+        CHK( mbedtls_ecdsa_verify( &grp, hash, sizeof( hash ), &Q, &r, &s ) );
+        mbedtls_ecp_group_free( &grp );
+        t_verify += bench_now() - t;
+
+        t = bench_now();
+        mbedtls_ecp_group_init( &grp );
+        CHK( mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) );
+        CHK( mbedtls_ecdh_gen_public( &grp, &dpeer, &Qpeer, bench_rng, &state ) );
+        CHK( mbedtls_ecdh_compute_shared( &grp, &z, &Q, &dpeer,
+                                          bench_rng, &state ) );
+        mbedtls_ecp_group_free( &grp );
+        t_ecdh += bench_now() - t;
+    }
+
+    printf( "  ECDSA sign   : %10llu %s\n",
+            (unsigned long long) ( t_sign / BENCH_ROUNDS ), BENCH_UNIT );
+    printf( "  ECDSA verify : %10llu %s\n",
+            (unsigned long long) ( t_verify / BENCH_ROUNDS ), BENCH_UNIT );
+    printf( "  ECDH         : %10llu %s\n",
+            (unsigned long long) ( t_ecdh / BENCH_ROUNDS ), BENCH_UNIT );
+
+exit:
+    mbedtls_ecp_group_free( &grp );
+    mbedtls_ecp_point_free( &Q ); mbedtls_ecp_point_free( &Qpeer );
+    mbedtls_mpi_free( &d ); mbedtls_mpi_free( &dpeer );
+    mbedtls_mpi_free( &r ); mbedtls_mpi_free( &s ); mbedtls_mpi_free( &z );
+
+    return( ret );
+}
+
+int main( int argc, char *argv[] )
+{
+    int ret;
+
+    if( argc > 1 && strcmp( argv[1], "--kat" ) == 0 )
+        ret = kat();
+    else
+        ret = bench();
+
+    if( ret != 0 )
+        fprintf( stderr, "ecp_bench: error -0x%04X\n", (unsigned) -ret );
+
+    return( ret != 0 );
+}
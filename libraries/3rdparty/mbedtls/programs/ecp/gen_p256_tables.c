@@ -0,0 +1,194 @@
+/*
+ *  Generator for the precomputed secp256r1 generator point tables
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+/*
+ * Prints library/ecp_p256_tables.h. The points are computed with the public
+ * ECP API of a build that does not use the tables itself:
+ *
+ * - the comb table used by ecp_mul_comb() when P == G, for the window
+ *   w = ECP_P256_COMB_W and d = ceil( 256 / w ):
+ *   T[i] = ( 1 + sum_{l = 1}^{w - 1} bit_{l - 1}( i ) * 2^{d l} ) G
+ *   which is what ecp_precompute_comb() computes at run time;
+ * - the odd multiples 1G, 3G, .., ( 2^{w - 1} - 1 ) G used by the wNAF
+ *   linear combination in mbedtls_ecp_muladd(), for w = ECP_P256_WNAF_W.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ecp.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ECP_P256_COMB_W    5
+#define ECP_P256_WNAF_W    6
+
+static int print_mpi( const char *name, const mbedtls_mpi *X )
+{
+    unsigned char buf[32];
+    int ret, i;
+
+    if( ( ret = mbedtls_mpi_write_binary( X, buf, sizeof( buf ) ) ) != 0 )
+        return( ret );
+
+    printf( "static const mbedtls_mpi_uint %s[] = {\n", name );
+
+    /* Limbs are little endian, the binary form is big endian */
+    for( i = sizeof( buf ) - 1; i >= 0; i -= 8 )
+    {
+        printf( "    BYTES_TO_T_UINT_8( 0x%02X, 0x%02X, 0x%02X, 0x%02X, "
+                "0x%02X, 0x%02X, 0x%02X, 0x%02X ),\n",
+                buf[i], buf[i - 1], buf[i - 2], buf[i - 3],
+                buf[i - 4], buf[i - 5], buf[i - 6], buf[i - 7] );
+    }
+
+    printf( "};\n" );
+
+    return( 0 );
+}
+
+static int print_table( mbedtls_ecp_group *grp, const char *prefix,
+                        const mbedtls_mpi k[], size_t count )
+{
+    mbedtls_ecp_point R;
+    char name[64];
+    size_t i;
+    int ret = 0;
+
+    mbedtls_ecp_point_init( &R );
+
+    for( i = 0; i < count && ret == 0; i++ )
+    {
+        if( ( ret = mbedtls_ecp_mul( grp, &R, &k[i], &grp->G, NULL, NULL ) ) != 0 )
+            break;
+
+        snprintf( name, sizeof( name ), "%s_%u_X", prefix, (unsigned) i );
+        if( ( ret = print_mpi( name, &R.X ) ) != 0 )
+            break;
+
+        snprintf( name, sizeof( name ), "%s_%u_Y", prefix, (unsigned) i );
+        ret = print_mpi( name, &R.Y );
+    }
+
+    printf( "static const mbedtls_ecp_point %s[%u] = {\n", prefix, (unsigned) count );
+    for( i = 0; i < count; i++ )
+        printf( "    ECP_POINT_INIT_XY( %s_%u_X, %s_%u_Y ),\n",
+                prefix, (unsigned) i, prefix, (unsigned) i );
+    printf( "};\n\n" );
+
+    mbedtls_ecp_point_free( &R );
+
+    return( ret );
+}
+
+int main( void )
+{
+    mbedtls_ecp_group grp;
+    mbedtls_mpi k[16]; /* Largest of the two table sizes */
+    size_t comb_size = 1 << ( ECP_P256_COMB_W - 1 );
+    size_t wnaf_size = 1 << ( ECP_P256_WNAF_W - 2 );
+    size_t d, i, l;
+    int ret;
+
+    mbedtls_ecp_group_init( &grp );
+    for( i = 0; i < sizeof( k ) / sizeof( k[0] ); i++ )
+        mbedtls_mpi_init( &k[i] );
+
+    if( ( ret = mbedtls_ecp_group_load( &grp, MBEDTLS_ECP_DP_SECP256R1 ) ) != 0 )
+        goto exit;
+
+    d = ( grp.nbits + ECP_P256_COMB_W - 1 ) / ECP_P256_COMB_W;
+
+    printf( "/*\n"
+            " *  Precomputed secp256r1 generator point tables\n"
+            " *\n"
+            " *  Generated by programs/ecp/gen_p256_tables.c, do not edit.\n"
+            " */\n\n"
+            "#ifndef MBEDTLS_ECP_P256_TABLES_H\n"
+            "#define MBEDTLS_ECP_P256_TABLES_H\n\n"
+            "#if !defined(BYTES_TO_T_UINT_8)\n"
+            "#if defined(MBEDTLS_HAVE_INT32)\n"
+            "#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h )     \\\n"
+            "    ( (mbedtls_mpi_uint) a <<  0 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) b <<  8 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) c << 16 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) d << 24 ),                     \\\n"
+            "    ( (mbedtls_mpi_uint) e <<  0 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) f <<  8 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) g << 16 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) h << 24 )\n"
+            "#else\n"
+            "#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h )     \\\n"
+            "    ( (mbedtls_mpi_uint) a <<  0 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) b <<  8 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) c << 16 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) d << 24 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) e << 32 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) f << 40 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) g << 48 ) |                    \\\n"
+            "    ( (mbedtls_mpi_uint) h << 56 )\n"
+            "#endif\n"
+            "#endif /* !BYTES_TO_T_UINT_8 */\n\n"
+            "#define ECP_P256_COMB_W    %d\n"
+            "#define ECP_P256_WNAF_W    %d\n\n"
+            "#define ECP_POINT_INIT_XY( x, y )                                       \\\n"
+            "    { { 1, sizeof( x ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) x }, \\\n"
+            "      { 1, sizeof( y ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) y }, \\\n"
+            "      { 1, 0, NULL } }\n\n",
+            ECP_P256_COMB_W, ECP_P256_WNAF_W );
+
+    for( i = 0; i < comb_size; i++ )
+    {
+        if( ( ret = mbedtls_mpi_lset( &k[i], 1 ) ) != 0 )
+            goto exit;
+
+        for( l = 1; l < ECP_P256_COMB_W; l++ )
+            if( ( i >> ( l - 1 ) ) & 1 )
+                if( ( ret = mbedtls_mpi_set_bit( &k[i], d * l, 1 ) ) != 0 )
+                    goto exit;
+    }
+
+    if( ( ret = print_table( &grp, "secp256r1_comb_T", k, comb_size ) ) != 0 )
+        goto exit;
+
+    for( i = 0; i < wnaf_size; i++ )
+        if( ( ret = mbedtls_mpi_lset( &k[i], 2 * i + 1 ) ) != 0 )
+            goto exit;
+
+    if( ( ret = print_table( &grp, "secp256r1_wnaf_T", k, wnaf_size ) ) != 0 )
+        goto exit;
+
+    printf( "#endif /* MBEDTLS_ECP_P256_TABLES_H */\n" );
+
+exit:
+    for( i = 0; i < sizeof( k ) / sizeof( k[0] ); i++ )
+        mbedtls_mpi_free( &k[i] );
+    mbedtls_ecp_group_free( &grp );
+
+    if( ret != 0 )
+        fprintf( stderr, "gen_p256_tables: error -0x%04X\n", (unsigned) -ret );
+
+    return( ret != 0 );
+}
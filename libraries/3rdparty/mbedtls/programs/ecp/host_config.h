@@ -0,0 +1,55 @@
+/*
+ *  Minimal configuration for building the ECP table generator and the ECP
+ *  benchmark on the host.
+ *
+ *  Copyright (C) 2006-2015, ARM Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef MBEDTLS_ECP_HOST_CONFIG_H
+#define MBEDTLS_ECP_HOST_CONFIG_H
+
+/* Use portable 32-bit limbs like the target unless the build asks for the
+ * native ones. */
+#if defined(ECP_HOST_INT64)
+#define MBEDTLS_HAVE_ASM
+#else
+#define MBEDTLS_HAVE_INT32
+#endif
+
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECDSA_C
+#define MBEDTLS_ECDH_C
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+#define MBEDTLS_MD_C
+#define MBEDTLS_SHA256_C
+
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+
+/* The reference build, which also generates the tables, leaves the
+ * optimizations out. */
+#if !defined(ECP_HOST_REFERENCE)
+#define MBEDTLS_ECP_P256_STATIC_TABLES
+#define MBEDTLS_ECP_MULADD_WNAF
+#endif
+
+#include "mbedtls/check_config.h"
+
+#endif /* MBEDTLS_ECP_HOST_CONFIG_H */
@@ -66,12 +66,69 @@ typedef int ( * pfnMbedTlsSign )( void * ctx,
 /* The size of the buffer malloc'ed for the exported public key in C_GenerateKeyPair */
 #define pkcs11KEY_GEN_MAX_DER_SIZE    200
 
+/* The number of token objects kept in RAM. */
+#ifndef pkcs11configMAX_CACHED_OBJECTS
+    #define pkcs11configMAX_CACHED_OBJECTS    4
+#endif
+
+/* The number of keys kept parsed for signing and verification. */
+#ifndef pkcs11configMAX_PARSED_KEYS
+    #define pkcs11configMAX_PARSED_KEYS    2
+#endif
+
+/* The key type of a cached object that has not been parsed yet. */
+#define pkcs11KEY_TYPE_UNKNOWN        ( ( CK_KEY_TYPE ) ~0 )
+
+/**
+ * @brief RAM copy of a token object.
+ *
+ * Filled on first use, so that the TLS handshakes after the first one find,
+ * read and parse the credentials without going to storage. The value of a
+ * private object is never kept; its parsed form lives in a P11Key_t instead.
+ * Neither is the value of a public object that the PAL stores with a private
+ * one, such as a public key read from the file of its private key: that value
+ * is read from storage whenever it is needed.
+ */
+typedef struct P11Object
+{
+    CK_OBJECT_HANDLE xHandle; /* 0 if the entry is free. */
+    uint8_t * pucLabel;       /* NULL if only the handle is known. */
+    uint8_t ucLabelLength;
+    CK_BBOOL xIsLoaded;       /* xIsPrivate and the value are valid. */
+    CK_BBOOL xIsPrivate;
+    uint8_t * pucValue;       /* NULL if the value is not kept in RAM. */
+    uint32_t ulValueLength;
+    CK_KEY_TYPE xKeyType;
+    uint32_t ulLastUsed;
+} P11Object_t;
+
+/**
+ * @brief A key parsed for C_Sign or C_Verify.
+ *
+ * Each key has its own mutex, so that sessions signing with different keys do
+ * not wait for each other. An entry in use is never given to another key.
+ */
+typedef struct P11Key
+{
+    SemaphoreHandle_t xMutex;   /* Held while the key is parsed or used. */
+    CK_OBJECT_HANDLE xHandle;   /* 0 if the entry is free, or dropped while in use. */
+    CK_BBOOL xIsPrivate;
+    CK_BBOOL xIsParsed;         /* xContext holds the key. */
+    mbedtls_pk_context xContext;
+    uint32_t ulUsers;           /* Sessions between prvKeyAcquire and prvKeyRelease. */
+    uint32_t ulLastUsed;
+} P11Key_t;
+
 /* PKCS#11 Object */
 typedef struct P11Struct_t
 {
     CK_BBOOL xIsInitialized;
     mbedtls_ctr_drbg_context xMbedDrbgCtx;
     mbedtls_entropy_context xMbedEntropyContext;
+    SemaphoreHandle_t xObjectMutex; /* Protects the object cache. */
+    P11Object_t xObjects[ pkcs11configMAX_CACHED_OBJECTS ];
+    uint32_t ulObjectUseCount;
+    P11Key_t xKeys[ pkcs11configMAX_PARSED_KEYS ]; /* Assigned under xObjectMutex. */
 } P11Struct_t, * P11Context_t;
 
 static P11Struct_t xP11Context;
@@ -89,10 +146,8 @@ typedef struct P11Session
     CK_BBOOL xFindObjectComplete;
     uint8_t * xFindObjectLabel;
     uint8_t xFindObjectLabelLength;
-    SemaphoreHandle_t xVerifyMutex; /* Protects the verification key from being modified while in use. */
-    mbedtls_pk_context xVerifyKey;
-    SemaphoreHandle_t xSignMutex;   /* Protects the signing key from being modified while in use. */
-    mbedtls_pk_context xSignKey;
+    CK_OBJECT_HANDLE xVerifyKeyHandle; /* The key of C_VerifyInit, 0 if none. */
+    CK_OBJECT_HANDLE xSignKeyHandle;   /* The key of C_SignInit, 0 if none. */
     mbedtls_sha256_context xSHA256Context;
 } P11Session_t, * P11SessionPtr_t;
 
@@ -147,6 +202,12 @@ extern BaseType_t PKCS11_PAL_GetObjectValue( CK_OBJECT_HANDLE xHandle,
 extern void PKCS11_PAL_GetObjectValueCleanup( uint8_t * pucBuffer,
                                               uint32_t ulBufferSize );
 
+/**
+ *  @brief Tell whether the storage of an object also holds the value of a
+ *  private object, in which case the value is not kept in RAM.
+ */
+extern CK_BBOOL PKCS11_PAL_SharesPrivateStorage( CK_OBJECT_HANDLE xHandle );
+
 /*-----------------------------------------------------------*/
 
 
@@ -252,6 +313,495 @@ P11SessionPtr_t prvSessionPointerFromHandle( CK_SESSION_HANDLE xSession )
     return ( P11SessionPtr_t ) xSession; /*lint !e923 Allow casting integer type to pointer for handle. */
 }
 
+/*-----------------------------------------------------------*/
+/*------------------- Token object cache --------------------*/
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Releases the memory held by a cache entry and marks it free.
+ */
+static void prvObjectFree( P11Object_t * pxObject )
+{
+    if( NULL != pxObject->pucValue )
+    {
+        vPortFree( pxObject->pucValue );
+    }
+
+    if( NULL != pxObject->pucLabel )
+    {
+        vPortFree( pxObject->pucLabel );
+    }
+
+    memset( pxObject, 0, sizeof( P11Object_t ) );
+}
+
+/**
+ * @brief Marks a cache entry as the most recently used one.
+ */
+static void prvObjectTouch( P11Object_t * pxObject )
+{
+    xP11Context.ulObjectUseCount++;
+    pxObject->ulLastUsed = xP11Context.ulObjectUseCount;
+}
+
+/**
+ * @brief Finds the cache entry of an object by handle.
+ *
+ * Must be called with xObjectMutex held.
+ */
+static P11Object_t * prvObjectFindHandle( CK_OBJECT_HANDLE xHandle )
+{
+    P11Object_t * pxObject = NULL;
+    uint32_t i;
+
+    for( i = 0; i < pkcs11configMAX_CACHED_OBJECTS; i++ )
+    {
+        if( ( 0 != xHandle ) && ( xP11Context.xObjects[ i ].xHandle == xHandle ) )
+        {
+            pxObject = &xP11Context.xObjects[ i ];
+            break;
+        }
+    }
+
+    return pxObject;
+}
+
+/**
+ * @brief Finds the cache entry of an object by label.
+ *
+ * Must be called with xObjectMutex held.
+ */
+static P11Object_t * prvObjectFindLabel( const uint8_t * pucLabel,
+                                         uint8_t ucLabelLength )
+{
+    P11Object_t * pxObject = NULL;
+    uint32_t i;
+
+    for( i = 0; i < pkcs11configMAX_CACHED_OBJECTS; i++ )
+    {
+        if( ( NULL != xP11Context.xObjects[ i ].pucLabel ) &&
+            ( xP11Context.xObjects[ i ].ucLabelLength == ucLabelLength ) &&
+            ( 0 == memcmp( xP11Context.xObjects[ i ].pucLabel, pucLabel, ucLabelLength ) ) )
+        {
+            pxObject = &xP11Context.xObjects[ i ];
+            break;
+        }
+    }
+
+    return pxObject;
+}
+
+/**
+ * @brief Takes a free cache entry for an object, evicting the least recently
+ * used one if there is none.
+ *
+ * Must be called with xObjectMutex held.
+ */
+static P11Object_t * prvObjectAdd( CK_OBJECT_HANDLE xHandle )
+{
+    P11Object_t * pxObject = &xP11Context.xObjects[ 0 ];
+    uint32_t i;
+
+    for( i = 0; i < pkcs11configMAX_CACHED_OBJECTS; i++ )
+    {
+        if( 0 == xP11Context.xObjects[ i ].xHandle )
+        {
+            pxObject = &xP11Context.xObjects[ i ];
+            break;
+        }
+
+        if( xP11Context.xObjects[ i ].ulLastUsed < pxObject->ulLastUsed )
+        {
+            pxObject = &xP11Context.xObjects[ i ];
+        }
+    }
+
+    prvObjectFree( pxObject );
+    pxObject->xHandle = xHandle;
+    pxObject->xKeyType = pkcs11KEY_TYPE_UNKNOWN;
+
+    return pxObject;
+}
+
+/**
+ * @brief Reads an object from storage into its cache entry, unless it is
+ * there already.
+ *
+ * Only the privacy flag is kept for private objects and for objects whose
+ * storage holds a private value. Must be called with xObjectMutex held.
+ */
+static CK_RV prvObjectLoad( P11Object_t * pxObject )
+{
+    CK_RV xResult = CKR_OK;
+    CK_BBOOL xIsPrivate = CK_TRUE;
+    uint8_t * pucData = NULL;
+    uint32_t ulDataLength = 0;
+
+    if( CK_FALSE == pxObject->xIsLoaded )
+    {
+        xResult = PKCS11_PAL_GetObjectValue( pxObject->xHandle, &pucData, &ulDataLength, &xIsPrivate );
+
+        if( CKR_OK == xResult )
+        {
+            /* The PAL may hand out its own storage, so keep a copy. */
+            if( ( CK_FALSE == xIsPrivate ) &&
+                ( CK_FALSE == PKCS11_PAL_SharesPrivateStorage( pxObject->xHandle ) ) )
+            {
+                pxObject->pucValue = pvPortMalloc( ulDataLength + 1 );
+
+                if( NULL != pxObject->pucValue )
+                {
+                    memcpy( pxObject->pucValue, pucData, ulDataLength );
+                    pxObject->ulValueLength = ulDataLength;
+                }
+                else
+                {
+                    xResult = CKR_HOST_MEMORY;
+                }
+            }
+
+            if( CKR_OK == xResult )
+            {
+                pxObject->xIsPrivate = xIsPrivate;
+                pxObject->xIsLoaded = CK_TRUE;
+            }
+
+            PKCS11_PAL_GetObjectValueCleanup( pucData, ulDataLength );
+        }
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Gets the value of a loaded object, from RAM if it is kept there and
+ * from storage otherwise.
+ *
+ * Release the value with prvObjectValueCleanup(). Must be called with
+ * xObjectMutex held.
+ */
+static CK_RV prvObjectValue( P11Object_t * pxObject,
+                             uint8_t ** ppucData,
+                             uint32_t * pulDataLength )
+{
+    CK_RV xResult = CKR_OK;
+    CK_BBOOL xIsPrivate = CK_TRUE;
+
+    if( NULL != pxObject->pucValue )
+    {
+        *ppucData = pxObject->pucValue;
+        *pulDataLength = pxObject->ulValueLength;
+    }
+    else
+    {
+        xResult = PKCS11_PAL_GetObjectValue( pxObject->xHandle, ppucData, pulDataLength, &xIsPrivate );
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Releases a value returned by prvObjectValue().
+ */
+static void prvObjectValueCleanup( P11Object_t * pxObject,
+                                   uint8_t * pucData,
+                                   uint32_t ulDataLength )
+{
+    if( pucData != pxObject->pucValue )
+    {
+        PKCS11_PAL_GetObjectValueCleanup( pucData, ulDataLength );
+    }
+}
+
+/**
+ * @brief Parses a loaded object once to learn its key type.
+ *
+ * An object whose value is not cached is read from storage again for this.
+ * Must be called with xObjectMutex held.
+ */
+static CK_RV prvObjectKeyType( P11Object_t * pxObject )
+{
+    CK_RV xResult = CKR_OK;
+    mbedtls_pk_context xKeyContext;
+    uint8_t * pucData = NULL;
+    uint32_t ulDataLength = 0;
+
+    if( pkcs11KEY_TYPE_UNKNOWN == pxObject->xKeyType )
+    {
+        xResult = prvObjectValue( pxObject, &pucData, &ulDataLength );
+
+        if( CKR_OK == xResult )
+        {
+            mbedtls_pk_init( &xKeyContext );
+
+            if( 0 != mbedtls_pk_parse_key( &xKeyContext, pucData, ulDataLength, NULL, 0 ) )
+            {
+                xResult = CKR_FUNCTION_FAILED;
+            }
+            else
+            {
+                switch( mbedtls_pk_get_type( &xKeyContext ) )
+                {
+                    case MBEDTLS_PK_RSA:
+                    case MBEDTLS_PK_RSA_ALT:
+                    case MBEDTLS_PK_RSASSA_PSS:
+                        pxObject->xKeyType = CKK_RSA;
+                        break;
+
+                    case MBEDTLS_PK_ECKEY:
+                    case MBEDTLS_PK_ECKEY_DH:
+                        pxObject->xKeyType = CKK_EC;
+                        break;
+
+                    case MBEDTLS_PK_ECDSA:
+                        pxObject->xKeyType = CKK_ECDSA;
+                        break;
+
+                    default:
+                        xResult = CKR_ATTRIBUTE_VALUE_INVALID;
+                        break;
+                }
+            }
+
+            /* Free the mbedTLS structure used to parse the key. */
+            mbedtls_pk_free( &xKeyContext );
+
+            prvObjectValueCleanup( pxObject, pucData, ulDataLength );
+        }
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Frees a parsed key and marks its entry free.
+ *
+ * Must be called with xObjectMutex held, on an entry no session uses.
+ */
+static void prvKeyDrop( P11Key_t * pxKey )
+{
+    mbedtls_pk_free( &pxKey->xContext );
+    mbedtls_pk_init( &pxKey->xContext );
+    pxKey->xHandle = 0;
+    pxKey->xIsParsed = CK_FALSE;
+    pxKey->ulLastUsed = 0;
+}
+
+/**
+ * @brief Parses a key from storage into a mbedTLS context.
+ */
+static CK_RV prvKeyParse( mbedtls_pk_context * pxKeyContext,
+                          CK_OBJECT_HANDLE xKey,
+                          CK_BBOOL xWantPrivate )
+{
+    CK_RV xResult = CKR_OK;
+    CK_BBOOL xIsPrivate = CK_TRUE;
+    uint8_t * pucKeyData = NULL;
+    uint32_t ulKeyDataLength = 0;
+
+    xResult = PKCS11_PAL_GetObjectValue( xKey, &pucKeyData, &ulKeyDataLength, &xIsPrivate );
+
+    if( CKR_OK == xResult )
+    {
+        if( xIsPrivate != xWantPrivate )
+        {
+            xResult = CKR_KEY_TYPE_INCONSISTENT;
+        }
+        else if( CK_TRUE == xIsPrivate )
+        {
+            if( 0 != mbedtls_pk_parse_key( pxKeyContext, pucKeyData, ulKeyDataLength, NULL, 0 ) )
+            {
+                xResult = CKR_KEY_HANDLE_INVALID;
+            }
+        }
+        else if( 0 != mbedtls_pk_parse_public_key( pxKeyContext, pucKeyData, ulKeyDataLength ) )
+        {
+            if( 0 != mbedtls_pk_parse_key( pxKeyContext, pucKeyData, ulKeyDataLength, NULL, 0 ) )
+            {
+                xResult = CKR_KEY_HANDLE_INVALID;
+            }
+        }
+
+        PKCS11_PAL_GetObjectValueCleanup( pucKeyData, ulKeyDataLength );
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Takes a session off a parsed key, and frees the key if it was
+ * dropped while in use.
+ */
+static void prvKeyUnuse( P11Key_t * pxKey )
+{
+    if( pdTRUE == xSemaphoreTake( xP11Context.xObjectMutex, portMAX_DELAY ) )
+    {
+        pxKey->ulUsers--;
+
+        if( ( 0 == pxKey->ulUsers ) && ( 0 == pxKey->xHandle ) )
+        {
+            prvKeyDrop( pxKey );
+        }
+
+        xSemaphoreGive( xP11Context.xObjectMutex );
+    }
+}
+
+/**
+ * @brief Unlocks a key taken with prvKeyAcquire().
+ */
+static void prvKeyRelease( P11Key_t * pxKey )
+{
+    if( NULL == pxKey->xMutex )
+    {
+        /* The spare of a single call. */
+        mbedtls_pk_free( &pxKey->xContext );
+    }
+    else
+    {
+        xSemaphoreGive( pxKey->xMutex );
+        prvKeyUnuse( pxKey );
+    }
+}
+
+/**
+ * @brief Gets the parsed form of a key and locks it for the caller, parsing
+ * it unless another session has done so already.
+ *
+ * If every entry is in use by other keys, the key is parsed into pxSpare for
+ * this one call. Either way the key must be handed back with prvKeyRelease().
+ */
+static CK_RV prvKeyAcquire( CK_OBJECT_HANDLE xKey,
+                            CK_BBOOL xWantPrivate,
+                            P11Key_t * pxSpare,
+                            P11Key_t ** ppxKey )
+{
+    CK_RV xResult = CKR_OK;
+    P11Key_t * pxKey = NULL;
+    P11Key_t * pxIdle = NULL;
+    uint32_t i;
+
+    memset( pxSpare, 0, sizeof( P11Key_t ) );
+    mbedtls_pk_init( &pxSpare->xContext );
+    *ppxKey = NULL;
+
+    if( 0 == xKey )
+    {
+        xResult = CKR_KEY_HANDLE_INVALID;
+    }
+    else if( pdTRUE == xSemaphoreTake( xP11Context.xObjectMutex, portMAX_DELAY ) )
+    {
+        for( i = 0; i < pkcs11configMAX_PARSED_KEYS; i++ )
+        {
+            if( ( xP11Context.xKeys[ i ].xHandle == xKey ) &&
+                ( xP11Context.xKeys[ i ].xIsPrivate == xWantPrivate ) )
+            {
+                pxKey = &xP11Context.xKeys[ i ];
+                break;
+            }
+
+            /* Free entries have never been used, so they come first. */
+            if( ( 0 == xP11Context.xKeys[ i ].ulUsers ) &&
+                ( ( NULL == pxIdle ) || ( xP11Context.xKeys[ i ].ulLastUsed < pxIdle->ulLastUsed ) ) )
+            {
+                pxIdle = &xP11Context.xKeys[ i ];
+            }
+        }
+
+        if( ( NULL == pxKey ) && ( NULL != pxIdle ) )
+        {
+            prvKeyDrop( pxIdle );
+            pxIdle->xHandle = xKey;
+            pxIdle->xIsPrivate = xWantPrivate;
+            pxKey = pxIdle;
+        }
+
+        if( NULL != pxKey )
+        {
+            pxKey->ulUsers++;
+            xP11Context.ulObjectUseCount++;
+            pxKey->ulLastUsed = xP11Context.ulObjectUseCount;
+        }
+
+        xSemaphoreGive( xP11Context.xObjectMutex );
+    }
+    else
+    {
+        xResult = CKR_CANT_LOCK;
+    }
+
+    if( CKR_OK == xResult )
+    {
+        if( NULL == pxKey )
+        {
+            pxKey = pxSpare;
+        }
+        else if( pdTRUE != xSemaphoreTake( pxKey->xMutex, portMAX_DELAY ) )
+        {
+            prvKeyUnuse( pxKey );
+            xResult = CKR_CANT_LOCK;
+        }
+    }
+
+    if( CKR_OK == xResult )
+    {
+        if( CK_FALSE == pxKey->xIsParsed )
+        {
+            xResult = prvKeyParse( &pxKey->xContext, xKey, xWantPrivate );
+        }
+
+        if( CKR_OK == xResult )
+        {
+            pxKey->xIsParsed = CK_TRUE;
+            *ppxKey = pxKey;
+        }
+        else
+        {
+            /* Leave the entry empty for the next attempt. */
+            mbedtls_pk_free( &pxKey->xContext );
+            mbedtls_pk_init( &pxKey->xContext );
+            prvKeyRelease( pxKey );
+        }
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Drops every cached object and parsed key after the token has been
+ * written.
+ *
+ * A PAL may keep several labels in one file, so a write can change more
+ * objects than the one it names.
+ */
+static void prvObjectInvalidate( void )
+{
+    uint32_t i;
+
+    if( pdTRUE == xSemaphoreTake( xP11Context.xObjectMutex, portMAX_DELAY ) )
+    {
+        for( i = 0; i < pkcs11configMAX_CACHED_OBJECTS; i++ )
+        {
+            prvObjectFree( &xP11Context.xObjects[ i ] );
+        }
+
+        /* A key in use is freed by its last user. */
+        for( i = 0; i < pkcs11configMAX_PARSED_KEYS; i++ )
+        {
+            if( 0 == xP11Context.xKeys[ i ].ulUsers )
+            {
+                prvKeyDrop( &xP11Context.xKeys[ i ] );
+            }
+            else
+            {
+                xP11Context.xKeys[ i ].xHandle = 0;
+            }
+        }
+
+        xSemaphoreGive( xP11Context.xObjectMutex );
+    }
+}
+
 
 /*
  * PKCS#11 module implementation.
@@ -335,9 +885,40 @@ static CK_FUNCTION_LIST prvP11FunctionList =
 
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Frees the object cache, the parsed keys and their mutexes.
+ */
+static void prvMbedTLS_Release( void )
+{
+    uint32_t i;
+
+    for( i = 0; i < pkcs11configMAX_CACHED_OBJECTS; i++ )
+    {
+        prvObjectFree( &xP11Context.xObjects[ i ] );
+    }
+
+    for( i = 0; i < pkcs11configMAX_PARSED_KEYS; i++ )
+    {
+        prvKeyDrop( &xP11Context.xKeys[ i ] );
+
+        if( NULL != xP11Context.xKeys[ i ].xMutex )
+        {
+            vSemaphoreDelete( xP11Context.xKeys[ i ].xMutex );
+            xP11Context.xKeys[ i ].xMutex = NULL;
+        }
+    }
+
+    if( NULL != xP11Context.xObjectMutex )
+    {
+        vSemaphoreDelete( xP11Context.xObjectMutex );
+        xP11Context.xObjectMutex = NULL;
+    }
+}
+
 CK_RV prvMbedTLS_Initialize( void )
 {
     CK_RV xResult = CKR_OK;
+    uint32_t i;
 
     if( xP11Context.xIsInitialized == CK_TRUE )
     {
@@ -359,12 +940,36 @@ CK_RV prvMbedTLS_Initialize( void )
         mbedtls_entropy_init( &xP11Context.xMbedEntropyContext );
         mbedtls_ctr_drbg_init( &xP11Context.xMbedDrbgCtx );
 
-        if( 0 != mbedtls_ctr_drbg_seed( &xP11Context.xMbedDrbgCtx,
-                                        mbedtls_entropy_func,
-                                        &xP11Context.xMbedEntropyContext,
-                                        NULL,
-                                        0 ) )
+        /* The object cache and the parsed keys shared by all sessions. */
+        xP11Context.xObjectMutex = xSemaphoreCreateMutex();
+
+        if( NULL == xP11Context.xObjectMutex )
         {
+            xResult = CKR_HOST_MEMORY;
+        }
+
+        for( i = 0; i < pkcs11configMAX_PARSED_KEYS; i++ )
+        {
+            mbedtls_pk_init( &xP11Context.xKeys[ i ].xContext );
+            xP11Context.xKeys[ i ].xMutex = xSemaphoreCreateMutex();
+
+            if( NULL == xP11Context.xKeys[ i ].xMutex )
+            {
+                xResult = CKR_HOST_MEMORY;
+            }
+        }
+
+        if( CKR_OK != xResult )
+        {
+            prvMbedTLS_Release();
+        }
+        else if( 0 != mbedtls_ctr_drbg_seed( &xP11Context.xMbedDrbgCtx,
+                                             mbedtls_entropy_func,
+                                             &xP11Context.xMbedEntropyContext,
+                                             NULL,
+                                             0 ) )
+        {
+            prvMbedTLS_Release();
             xResult = CKR_FUNCTION_FAILED;
         }
         else
@@ -418,6 +1023,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_Finalize )( CK_VOID_PTR pvReserved )
             mbedtls_ctr_drbg_free( &xP11Context.xMbedDrbgCtx );
         }
 
+        prvMbedTLS_Release();
+
         xP11Context.xIsInitialized = CK_FALSE;
     }
 
@@ -527,20 +1134,6 @@ CK_DEFINE_FUNCTION( CK_RV, C_OpenSession )( CK_SLOT_ID xSlotID,
         {
             memset( pxSessionObj, 0, sizeof( P11Session_t ) );
         }
-
-        pxSessionObj->xSignMutex = xSemaphoreCreateMutex();
-
-        if( NULL == pxSessionObj->xSignMutex )
-        {
-            xResult = CKR_HOST_MEMORY;
-        }
-
-        pxSessionObj->xVerifyMutex = xSemaphoreCreateMutex();
-
-        if( NULL == pxSessionObj->xVerifyMutex )
-        {
-            xResult = CKR_HOST_MEMORY;
-        }
     }
 
     if( CKR_OK == xResult )
@@ -587,30 +1180,10 @@ CK_DEFINE_FUNCTION( CK_RV, C_CloseSession )( CK_SESSION_HANDLE xSession )
     if( NULL != pxSession )
     {
         /*
-         * Tear down the session.
+         * Tear down the session. The keys it used stay parsed in the module
+         * for the next session.
          */
 
-        if( NULL != pxSession->xSignKey.pk_ctx )
-        {
-            mbedtls_pk_free( &pxSession->xSignKey );
-        }
-
-        if( NULL != pxSession->xSignMutex )
-        {
-            vSemaphoreDelete( pxSession->xSignMutex );
-        }
-
-        /* Free the public key context if it exists. */
-        if( NULL != pxSession->xVerifyKey.pk_ctx )
-        {
-            mbedtls_pk_free( &pxSession->xVerifyKey );
-        }
-
-        if( NULL != pxSession->xVerifyMutex )
-        {
-            vSemaphoreDelete( pxSession->xVerifyMutex );
-        }
-
         if( NULL != &pxSession->xSHA256Context )
         {
             mbedtls_sha256_free( &pxSession->xSHA256Context );
@@ -803,6 +1376,12 @@ CK_DEFINE_FUNCTION( CK_RV, C_CreateObject )( CK_SESSION_HANDLE xSession,
         }
     }
 
+    /* A write to storage, even a failed one, makes the cache stale. */
+    if( ( CKR_OK == xResult ) || ( CKR_DEVICE_ERROR == xResult ) )
+    {
+        prvObjectInvalidate();
+    }
+
     return xResult;
 }
 
@@ -815,6 +1394,11 @@ CK_DEFINE_FUNCTION( CK_RV, C_DestroyObject )( CK_SESSION_HANDLE xSession,
     /* TODO: Delete objects from NVM. */
     ( void ) xSession;
     ( void ) xObject;
+
+    /* Drop the RAM copies, so that the object is read again if it is
+     * still in storage. */
+    prvObjectInvalidate();
+
     return CKR_OK;
 }
 
@@ -828,14 +1412,10 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
 {
     /*lint !e9072 It's OK to have different parameter name. */
     CK_RV xResult = CKR_OK;
-    CK_BBOOL xIsPrivate = CK_TRUE;
     CK_ULONG iAttrib;
-    mbedtls_pk_context privateKeyContext;
-    mbedtls_pk_type_t xKeyType;
-    CK_KEY_TYPE xPkcsKeyType = ( CK_KEY_TYPE ) ~0;
-
-    uint8_t * pxObjectValue = NULL;
-    uint32_t ulLength = 0;
+    P11Object_t * pxObject = NULL;
+    uint8_t * pucData = NULL;
+    uint32_t ulDataLength = 0;
 
     /* Avoid warnings about unused parameters. */
     ( void ) xSession;
@@ -844,12 +1424,33 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
     {
         xResult = CKR_ARGUMENTS_BAD;
     }
+    else if( pdTRUE != xSemaphoreTake( xP11Context.xObjectMutex, portMAX_DELAY ) )
+    {
+        xResult = CKR_CANT_LOCK;
+    }
     else
     {
         /*
-         * Copy the object into a buffer.
+         * Find the object in RAM, reading it from storage the first time.
          */
-        xResult = PKCS11_PAL_GetObjectValue( xObject, &pxObjectValue, &ulLength, &xIsPrivate );
+        pxObject = prvObjectFindHandle( xObject );
+
+        if( NULL == pxObject )
+        {
+            pxObject = prvObjectAdd( xObject );
+        }
+
+        xResult = prvObjectLoad( pxObject );
+
+        if( CKR_OK != xResult )
+        {
+            prvObjectFree( pxObject );
+            xSemaphoreGive( xP11Context.xObjectMutex );
+        }
+        else
+        {
+            prvObjectTouch( pxObject );
+        }
     }
 
     if( xResult == CKR_OK )
@@ -860,24 +1461,31 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
             {
                 case CKA_VALUE:
 
-                    if( xIsPrivate == CK_TRUE )
+                    if( pxObject->xIsPrivate == CK_TRUE )
                     {
                         pxTemplate[ iAttrib ].ulValueLen = CK_UNAVAILABLE_INFORMATION;
                         xResult = CKR_ATTRIBUTE_SENSITIVE;
                     }
                     else
                     {
-                        if( pxTemplate[ iAttrib ].pValue == NULL )
-                        {
-                            pxTemplate[ iAttrib ].ulValueLen = ulLength;
-                        }
-                        else if( pxTemplate[ iAttrib ].ulValueLen < ulLength )
-                        {
-                            xResult = CKR_BUFFER_TOO_SMALL;
-                        }
-                        else
+                        xResult = prvObjectValue( pxObject, &pucData, &ulDataLength );
+
+                        if( CKR_OK == xResult )
                         {
-                            memcpy( pxTemplate[ iAttrib ].pValue, pxObjectValue, ulLength );
+                            if( pxTemplate[ iAttrib ].pValue == NULL )
+                            {
+                                pxTemplate[ iAttrib ].ulValueLen = ulDataLength;
+                            }
+                            else if( pxTemplate[ iAttrib ].ulValueLen < ulDataLength )
+                            {
+                                xResult = CKR_BUFFER_TOO_SMALL;
+                            }
+                            else
+                            {
+                                memcpy( pxTemplate[ iAttrib ].pValue, pucData, ulDataLength );
+                            }
+
+                            prvObjectValueCleanup( pxObject, pucData, ulDataLength );
                         }
                     }
 
@@ -895,44 +1503,12 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
                     }
                     else
                     {
-                        mbedtls_pk_init( &privateKeyContext );
-                        xResult = mbedtls_pk_parse_key( &privateKeyContext, pxObjectValue, ulLength, NULL, 0 );
+                        xResult = prvObjectKeyType( pxObject );
 
-                        if( 0 != xResult )
+                        if( CKR_OK == xResult )
                         {
-                            xResult = CKR_FUNCTION_FAILED;
+                            memcpy( pxTemplate[ iAttrib ].pValue, &pxObject->xKeyType, sizeof( CK_KEY_TYPE ) );
                         }
-                        else
-                        {
-                            xKeyType = mbedtls_pk_get_type( &privateKeyContext );
-
-                            switch( xKeyType )
-                            {
-                                case MBEDTLS_PK_RSA:
-                                case MBEDTLS_PK_RSA_ALT:
-                                case MBEDTLS_PK_RSASSA_PSS:
-                                    xPkcsKeyType = CKK_RSA;
-                                    break;
-
-                                case MBEDTLS_PK_ECKEY:
-                                case MBEDTLS_PK_ECKEY_DH:
-                                    xPkcsKeyType = CKK_EC;
-                                    break;
-
-                                case MBEDTLS_PK_ECDSA:
-                                    xPkcsKeyType = CKK_ECDSA;
-                                    break;
-
-                                default:
-                                    xResult = CKR_ATTRIBUTE_VALUE_INVALID;
-                                    break;
-                            }
-
-                            memcpy( pxTemplate[ iAttrib ].pValue, &xPkcsKeyType, sizeof( CK_KEY_TYPE ) );
-                        }
-
-                        /* Free the mbedTLS structure used to parse the key. */
-                        mbedtls_pk_free( &privateKeyContext );
                     }
 
                     break;
@@ -942,8 +1518,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
             }
         }
 
-        /* Free the buffer where object was stored. */
-        PKCS11_PAL_GetObjectValueCleanup( pxObjectValue, ulLength );
+        xSemaphoreGive( xP11Context.xObjectMutex );
     }
 
     return xResult;
@@ -1012,6 +1587,63 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjectsInit )( CK_SESSION_HANDLE xSession,
     return xResult;
 }
 
+/**
+ * @brief Looks up an object handle by label, asking the PAL only the first
+ * time.
+ *
+ * Objects that are not found are not remembered, so that they can be
+ * provisioned later.
+ */
+static CK_OBJECT_HANDLE prvFindObject( uint8_t * pucLabel,
+                                       uint8_t ucLabelLength )
+{
+    CK_OBJECT_HANDLE xHandle = 0;
+    P11Object_t * pxObject;
+
+    if( pdTRUE == xSemaphoreTake( xP11Context.xObjectMutex, portMAX_DELAY ) )
+    {
+        pxObject = prvObjectFindLabel( pucLabel, ucLabelLength );
+
+        if( NULL == pxObject )
+        {
+            xHandle = PKCS11_PAL_FindObject( pucLabel, ucLabelLength );
+
+            if( 0 != xHandle )
+            {
+                pxObject = prvObjectFindHandle( xHandle );
+
+                if( NULL == pxObject )
+                {
+                    pxObject = prvObjectAdd( xHandle );
+                }
+
+                /* Without a copy of the label, the handle is just looked up
+                 * again next time. */
+                if( NULL == pxObject->pucLabel )
+                {
+                    pxObject->pucLabel = pvPortMalloc( ucLabelLength );
+
+                    if( NULL != pxObject->pucLabel )
+                    {
+                        memcpy( pxObject->pucLabel, pucLabel, ucLabelLength );
+                        pxObject->ucLabelLength = ucLabelLength;
+                    }
+                }
+            }
+        }
+
+        if( NULL != pxObject )
+        {
+            xHandle = pxObject->xHandle;
+            prvObjectTouch( pxObject );
+        }
+
+        xSemaphoreGive( xP11Context.xObjectMutex );
+    }
+
+    return xHandle;
+}
+
 /**
  * @brief Query the objects of the requested type.
  */
@@ -1056,7 +1688,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjects )( CK_SESSION_HANDLE xSession,
 
     if( ( pdFALSE == xDone ) )
     {
-        *pxObject = PKCS11_PAL_FindObject( pxSession->xFindObjectLabel, pxSession->xFindObjectLabelLength );
+        *pxObject = prvFindObject( pxSession->xFindObjectLabel, pxSession->xFindObjectLabelLength );
 
         if( *pxObject != 0 ) /* 0 is always an invalid handle. */
         {
@@ -1221,12 +1853,11 @@ CK_DEFINE_FUNCTION( CK_RV, C_SignInit )( CK_SESSION_HANDLE xSession,
                                          CK_OBJECT_HANDLE xKey )
 {
     CK_RV xResult = CKR_OK;
-    CK_BBOOL xIsPrivate;
+    P11Key_t xSpare;
+    P11Key_t * pxKey = NULL;
 
     /*lint !e9072 It's OK to have different parameter name. */
     P11SessionPtr_t pxSession = prvSessionPointerFromHandle( xSession );
-    uint8_t * keyData = NULL;
-    uint32_t ulKeyDataLength = 0;
 
     if( NULL == pxMechanism )
     {
@@ -1234,50 +1865,23 @@ CK_DEFINE_FUNCTION( CK_RV, C_SignInit )( CK_SESSION_HANDLE xSession,
     }
     else
     {
-        xResult = PKCS11_PAL_GetObjectValue( xKey, &keyData, &ulKeyDataLength, &xIsPrivate );
-
-        if( xIsPrivate != CK_TRUE )
-        {
-            xResult = CKR_KEY_TYPE_INCONSISTENT;
-        }
+        /* Parse the key now, unless another session has done so, so that
+         * C_Sign finds it ready.
+         * TODO: Check the mechanism.  Note: Currently, mechanism is being set to CKM_SHA256, rather than
+         * CKM_RSA_PKCS
+         * CKM_SHA256_RSA_PKCS
+         * CKM_ECDSA
+         * Calling function does not know whether key is RSA or ECDSA.
+         * xKeyType = mbedtls_pk_get_type( &pxKey->xContext );
+         */
+        xResult = prvKeyAcquire( xKey, CK_TRUE, &xSpare, &pxKey );
 
-        if( xResult == CKR_OK )
+        if( CKR_OK == xResult )
         {
-            if( pdTRUE == xSemaphoreTake( pxSession->xSignMutex, portMAX_DELAY ) )
-            {
-                /* Free the private key context if it exists.
-                * TODO: Check if the key is the same as was used previously. */
-                if ( NULL != pxSession->xSignKey.pk_ctx )
-                {
-                    mbedtls_pk_free( &pxSession->xSignKey );
-                }
-
-                mbedtls_pk_init( &pxSession->xSignKey );
-
-                if( 0 == mbedtls_pk_parse_key( &pxSession->xSignKey, keyData, ulKeyDataLength, NULL, 0 ) )
-                {
-                    /* TODO: Check the mechanism.  Note: Currently, mechanism is being set to CKM_SHA256, rather than
-                     * CKM_RSA_PKCS
-                     * CKM_SHA256_RSA_PKCS
-                     * CKM_ECDSA
-                     * Calling function does not know whether key is RSA or ECDSA.
-                     * xKeyType = mbedtls_pk_get_type( &pxSession->xSignKey );
-                     */
-                }
-                else
-                {
-                    xResult = CKR_KEY_HANDLE_INVALID;
-                }
-
-                xSemaphoreGive( pxSession->xSignMutex );
-            }
-            else
-            {
-                xResult = CKR_CANT_LOCK;
-            }
+            prvKeyRelease( pxKey );
         }
 
-        PKCS11_PAL_GetObjectValueCleanup( keyData, ulKeyDataLength );
+        pxSession->xSignKeyHandle = ( CKR_OK == xResult ) ? xKey : 0;
     }
 
     return xResult;
@@ -1293,6 +1897,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
                                      CK_ULONG_PTR pulSignatureLen )
 {   /*lint !e9072 It's OK to have different parameter name. */
     CK_RV xResult = CKR_OK;
+    P11Key_t xSpare;
+    P11Key_t * pxKey = NULL;
     P11SessionPtr_t pxSessionObj = prvSessionPointerFromHandle( xSession );
 
     if( NULL == pulSignatureLen )
@@ -1325,9 +1931,20 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
 
             if( CKR_OK == xResult )
             {
-                if( pdTRUE == xSemaphoreTake( pxSessionObj->xSignMutex, portMAX_DELAY ) )
+                if( 0 == pxSessionObj->xSignKeyHandle )
+                {
+                    xResult = CKR_OPERATION_NOT_INITIALIZED;
+                }
+                else
+                {
+                    /* The key may have been dropped since C_SignInit, if it
+                     * was replaced or other keys took its entry. */
+                    xResult = prvKeyAcquire( pxSessionObj->xSignKeyHandle, CK_TRUE, &xSpare, &pxKey );
+                }
+
+                if( CKR_OK == xResult )
                 {
-                    BaseType_t x = mbedtls_pk_sign( &pxSessionObj->xSignKey,
+                    BaseType_t x = mbedtls_pk_sign( &pxKey->xContext,
                                                     MBEDTLS_MD_SHA256,
                                                     pucData,
                                                     ulDataLen,
@@ -1341,11 +1958,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
                         xResult = CKR_FUNCTION_FAILED;
                     }
 
-                    xSemaphoreGive( pxSessionObj->xSignMutex );
-                }
-                else
-                {
-                    xResult = CKR_CANT_LOCK;
+                    prvKeyRelease( pxKey );
                 }
             }
         }
@@ -1362,10 +1975,9 @@ CK_DEFINE_FUNCTION( CK_RV, C_VerifyInit )( CK_SESSION_HANDLE xSession,
                                            CK_OBJECT_HANDLE xKey )
 {
     CK_RV xResult = CKR_OK;
-    CK_BBOOL xIsPrivate = CK_TRUE;
+    P11Key_t xSpare;
+    P11Key_t * pxKey = NULL;
     P11SessionPtr_t pxSession;
-    uint8_t * keyData = NULL;
-    uint32_t ulKeyDataLength = 0;
 
     /*lint !e9072 It's OK to have different parameter name. */
     ( void ) ( xSession );
@@ -1379,44 +1991,15 @@ CK_DEFINE_FUNCTION( CK_RV, C_VerifyInit )( CK_SESSION_HANDLE xSession,
 
     if( xResult == CKR_OK )
     {
-        xResult = PKCS11_PAL_GetObjectValue( xKey, &keyData, &ulKeyDataLength, &xIsPrivate );
-    }
-
-    if( ( xResult == CKR_OK ) && ( xIsPrivate != CK_FALSE ) )
-    {
-        xResult = CKR_KEY_TYPE_INCONSISTENT;
-        PKCS11_PAL_GetObjectValueCleanup( keyData, ulKeyDataLength );
-    }
+        /* Parse the key now, unless another session has done so. */
+        xResult = prvKeyAcquire( xKey, CK_FALSE, &xSpare, &pxKey );
 
-    if( xResult == CKR_OK )
-    {
-        if( pdTRUE == xSemaphoreTake( pxSession->xVerifyMutex, portMAX_DELAY ) )
-        {
-            /* Free the public key context if it exists.
-            * TODO: Check if the key is the same as used by last verify operation. */
-            if ( NULL != pxSession->xVerifyKey.pk_ctx )
-            {
-                mbedtls_pk_free( &pxSession->xVerifyKey );
-            }
-
-            mbedtls_pk_init( &pxSession->xVerifyKey );
-
-            if( 0 != mbedtls_pk_parse_public_key( &pxSession->xVerifyKey, keyData, ulKeyDataLength ) )
-            {
-                if( 0 != mbedtls_pk_parse_key( &pxSession->xVerifyKey, keyData, ulKeyDataLength, NULL, 0 ) )
-                {
-                    xResult = CKR_KEY_HANDLE_INVALID;
-                }
-            }
-
-            xSemaphoreGive( pxSession->xVerifyMutex );
-        }
-        else
+        if( CKR_OK == xResult )
         {
-            xResult = CKR_CANT_LOCK;
+            prvKeyRelease( pxKey );
         }
 
-        PKCS11_PAL_GetObjectValueCleanup( keyData, ulKeyDataLength );
+        pxSession->xVerifyKeyHandle = ( CKR_OK == xResult ) ? xKey : 0;
     }
 
     return xResult;
@@ -1433,6 +2016,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                                        CK_ULONG ulSignatureLen )
 {
     CK_RV xResult = CKR_OK;
+    P11Key_t xSpare;
+    P11Key_t * pxKey = NULL;
     P11SessionPtr_t pxSessionObj;
 
     /*
@@ -1447,12 +2032,14 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
     {
         pxSessionObj = prvSessionPointerFromHandle( xSession ); /*lint !e9072 It's OK to have different parameter name. */
 
-        if( pdTRUE == xSemaphoreTake( pxSessionObj->xVerifyMutex, portMAX_DELAY ) )
+        /* Verify the signature. If a public key is present, use it. */
+        if( 0 != pxSessionObj->xVerifyKeyHandle )
         {
-            /* Verify the signature. If a public key is present, use it. */
-            if( NULL != pxSessionObj->xVerifyKey.pk_ctx )
+            xResult = prvKeyAcquire( pxSessionObj->xVerifyKeyHandle, CK_FALSE, &xSpare, &pxKey );
+
+            if( CKR_OK == xResult )
             {
-                if( 0 != mbedtls_pk_verify( &pxSessionObj->xVerifyKey,
+                if( 0 != mbedtls_pk_verify( &pxKey->xContext,
                                             MBEDTLS_MD_SHA256,
                                             pucData,
                                             ulDataLen,
@@ -1461,13 +2048,9 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                 {
                     xResult = CKR_SIGNATURE_INVALID;
                 }
-            }
 
-            xSemaphoreGive( pxSessionObj->xVerifyMutex );
-        }
-        else
-        {
-            xResult = CKR_CANT_LOCK;
+                prvKeyRelease( pxKey );
+            }
         }
 
         /* TODO: Deleted else. */
@@ -1554,6 +2137,9 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
         /* FIXME: This is a hack.*/
         *pxPublicKey = *pxPrivateKey + 1;
         xResult = CKR_OK;
+
+        /* The new key replaces whatever the cache holds for its label. */
+        prvObjectInvalidate();
     }
     else
     {
@@ -1125,6 +1125,7 @@ TEST_GROUP_RUNNER( Full_PKCS11_CryptoOperation )
     RUN_TEST_CASE( Full_PKCS11_CryptoOperation, AFQP_FindObjects_InvalidParams );
     RUN_TEST_CASE( Full_PKCS11_CryptoOperation, AFQP_FindObjectsInit_InvalidParams );
     RUN_TEST_CASE( Full_PKCS11_CryptoOperation, AFQP_GetAttributeValue_InvalidParams );
+    RUN_TEST_CASE( Full_PKCS11_CryptoOperation, AFQP_GetAttributeValue_AfterReprovision );
 
     /* Generated Random tests. */
     RUN_TEST_CASE( Full_PKCS11_CryptoOperation, AFQP_GenerateRandom_InvalidParams );
@@ -1715,6 +1716,40 @@ TEST( Full_PKCS11_CryptoOperation, AFQP_GetAttributeValue_InvalidParams )
     TEST_ASSERT_EQUAL_INT32( 0, xResult );
 }
 
+/* The module keeps objects in RAM, so check that reprovisioning still shows
+ * through. */
+TEST( Full_PKCS11_CryptoOperation, AFQP_GetAttributeValue_AfterReprovision )
+{
+    CK_RV xResult = 0;
+    CK_OBJECT_HANDLE xPrivateKey = 0;
+    CK_KEY_TYPE xKeyType = 0;
+    CK_ATTRIBUTE xTemplate;
+
+    xTemplate.type = CKA_KEY_TYPE;
+    xTemplate.pValue = &xKeyType;
+    xTemplate.ulValueLen = sizeof( xKeyType );
+
+    xResult = prvReprovision( pcValidRSACertificate, pcValidRSAPrivateKey, CKK_RSA );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+
+    xResult = prvGetPrivateKeyHandle( pxGlobalFunctionList, xGlobalSession, &xPrivateKey );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+
+    xResult = pxGlobalFunctionList->C_GetAttributeValue( xGlobalSession, xPrivateKey, &xTemplate, 1 );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+    TEST_ASSERT_EQUAL_INT32_MESSAGE( CKK_RSA, xKeyType, "Unexpected key type for the RSA key." );
+
+    xResult = prvReprovision( pcValidECDSACertificate, pcValidECDSAPrivateKey, CKK_EC );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+
+    xResult = prvGetPrivateKeyHandle( pxGlobalFunctionList, xGlobalSession, &xPrivateKey );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+
+    xResult = pxGlobalFunctionList->C_GetAttributeValue( xGlobalSession, xPrivateKey, &xTemplate, 1 );
+    TEST_ASSERT_EQUAL_INT32( CKR_OK, xResult );
+    TEST_ASSERT_EQUAL_INT32_MESSAGE( CKK_EC, xKeyType, "Key type of the previous key returned after reprovisioning." );
+}
+
 TEST( Full_PKCS11_CryptoOperation, AFQP_GenerateRandom_HappyPath )
 {
     CK_RV xResult = 0;
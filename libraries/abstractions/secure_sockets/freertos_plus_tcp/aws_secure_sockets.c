@@ -58,6 +58,10 @@ typedef struct SSOCKETContext
     BaseType_t xConnectAttempted;
 } SSOCKETContext_t, * SSOCKETContextPtr_t;
 
+/* Lookups made through SOCKETS_GetHostByName(). Caching is left to
+ * FreeRTOS_gethostbyname(), so each of them counts as a miss here. */
+static uint32_t ulHostByNameLookups = 0;
+
 /*
  * Helper routines.
  */
@@ -206,12 +210,45 @@ int32_t SOCKETS_Connect( Socket_t xSocket,
 }
 /*-----------------------------------------------------------*/
 
+int32_t SOCKETS_ConnectAsync( Socket_t xSocket,
+                              SocketsSockaddr_t * pxAddress,
+                              Socklen_t xAddressLength,
+                              SocketsConnectCallback_t pxCallback,
+                              void * pvCallbackContext )
+{
+    int32_t lStatus = SOCKETS_EINVAL;
+
+    if( pxCallback != NULL )
+    {
+        /* There is no task here to drive the connection in the background,
+         * so connect in the calling task and report the outcome at once. */
+        lStatus = SOCKETS_Connect( xSocket, pxAddress, xAddressLength );
+        pxCallback( xSocket, lStatus, pvCallbackContext );
+        lStatus = SOCKETS_ERROR_NONE;
+    }
+
+    return lStatus;
+}
+/*-----------------------------------------------------------*/
+
 uint32_t SOCKETS_GetHostByName( const char * pcHostName )
 {
+    ulHostByNameLookups++;
+
     return FreeRTOS_gethostbyname( pcHostName );
 }
 /*-----------------------------------------------------------*/
 
+void SOCKETS_GetDnsCacheStats( SocketsDnsCacheStats_t * pxStats )
+{
+    if( pxStats != NULL )
+    {
+        memset( pxStats, 0, sizeof( *pxStats ) );
+        pxStats->ulMisses = ulHostByNameLookups;
+    }
+}
+/*-----------------------------------------------------------*/
+
 int32_t SOCKETS_Recv( Socket_t xSocket,
                       void * pvBuffer,
                       size_t xBufferLength,
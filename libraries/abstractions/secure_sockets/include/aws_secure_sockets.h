@@ -201,6 +201,19 @@ typedef struct SocketsSockaddr
     uint32_t ulAddress;     /**< IP Address. Convention is to call this sin_addr. */
 } SocketsSockaddr_t;
 
+/**
+ * @ingroup SecureSockets_datatypes_paramstructs
+ * @brief Called once when a connect started by SOCKETS_ConnectAsync() ends.
+ *
+ * @param[in] xSocket The socket passed to SOCKETS_ConnectAsync().
+ * @param[in] lStatus @ref SOCKETS_ERROR_NONE if the connection, and the TLS
+ * session if one was required, is established; a negative error otherwise.
+ * @param[in] pvContext The context passed to SOCKETS_ConnectAsync().
+ */
+typedef void (* SocketsConnectCallback_t)( Socket_t xSocket,
+                                           int32_t lStatus,
+                                           void * pvContext );
+
 /**
  * @brief Well-known port numbers.
  */
@@ -286,6 +299,42 @@ int32_t SOCKETS_Connect( Socket_t xSocket,
                          Socklen_t xAddressLength );
 /* @[declare_secure_sockets_connect] */
 
+/**
+ * @brief Starts connecting a socket without waiting for the connection.
+ *
+ * Does what SOCKETS_Connect() does, TLS handshake included, but returns as
+ * soon as the connection is under way. The port then drives the connection
+ * as the network allows, and calls pxCallback once with the outcome. Each
+ * step may wait for as long as the @ref SOCKETS_SO_RCVTIMEO of the socket.
+ *
+ * Until pxCallback is called the socket must not be used, except to close it,
+ * which cancels the connection without calling back. If the outcome is an
+ * error the socket is considered invalid.
+ *
+ * \note A port that cannot connect in the background connects in the calling
+ * task, and calls pxCallback before returning.
+ *
+ * @param[in] xSocket The handle of the socket to be connected.
+ * @param[in] pxAddress A pointer to a SocketsSockaddr_t structure that contains the
+ * the address to connect the socket to.
+ * @param[in] xAddressLength Should be set to sizeof( @ref SocketsSockaddr_t ).
+ * @param[in] pxCallback Called when the connection is established or fails.
+ * @param[in] pvCallbackContext Passed to pxCallback.
+ *
+ * @return
+ * * @ref SOCKETS_ERROR_NONE if the connection was started, and pxCallback
+ *   will be called.
+ * * If an error occurred, a negative value is returned, and pxCallback
+ *   will not be called. @ref SocketsErrors
+ */
+/* @[declare_secure_sockets_connectasync] */
+int32_t SOCKETS_ConnectAsync( Socket_t xSocket,
+                              SocketsSockaddr_t * pxAddress,
+                              Socklen_t xAddressLength,
+                              SocketsConnectCallback_t pxCallback,
+                              void * pvCallbackContext );
+/* @[declare_secure_sockets_connectasync] */
+
 /**
  * @brief Receive data from a TCP socket.
  *
@@ -500,6 +549,29 @@ int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
 uint32_t SOCKETS_GetHostByName( const char * pcHostName );
 /* @[declare_secure_sockets_gethostbyname] */
 
+/**
+ * @ingroup SecureSockets_datatypes_paramstructs
+ * @brief Counts of how SOCKETS_GetHostByName() lookups were answered.
+ */
+typedef struct SocketsDnsCacheStats
+{
+    uint32_t ulHits;       /**< Answered from the cache, within the TTL. */
+    uint32_t ulStaleHits;  /**< Answered from the cache past the TTL, while resolved again. */
+    uint32_t ulMisses;     /**< Waited for the name to be resolved. */
+    uint32_t ulPrefetches; /**< Resolved in the background to keep the cache fresh. */
+} SocketsDnsCacheStats_t;
+
+/**
+ * @brief Reports how SOCKETS_GetHostByName() lookups were answered so far.
+ *
+ * Ports that do not cache host names count every lookup as a miss.
+ *
+ * @param[out] pxStats Filled with the counts.
+ */
+/* @[declare_secure_sockets_getdnscachestats] */
+void SOCKETS_GetDnsCacheStats( SocketsDnsCacheStats_t * pxStats );
+/* @[declare_secure_sockets_getdnscachestats] */
+
 
 
 /**
@@ -46,6 +46,7 @@
 #include "FreeRTOSConfig.h"
 
 #include "task.h"
+#include "semphr.h"
 
 #include <stdbool.h>
 
@@ -57,27 +58,85 @@
 #define SS_STATUS_SECURED       (2)
 
 /*
- * secure socket context.
+ * connect progress, while the socket is non-blocking.
  */
-typedef enum E_AWS_SOCkET_RX_STATE
-{
-    SST_RX_IDLE,
-    SST_RX_READY,
-    SST_RX_CLOSING,
-    SST_RX_CLOSED,
-} T_AWS_SOCKET_RX_STATE;
+#define SS_CONNECT_IDLE         (0)
+#define SS_CONNECT_TCP          (1)
+#define SS_CONNECT_TLS_READ     (2)
+#define SS_CONNECT_TLS_WRITE    (3)
+
+/*
+ * Stack depth and priority of the task that calls the receive callbacks.
+ */
+#ifndef socketsconfigRX_SELECT_TASK_STACK_SIZE
+    #define socketsconfigRX_SELECT_TASK_STACK_SIZE    ( 512 )
+#endif
+
+#ifndef socketsconfigRX_SELECT_TASK_PRIORITY
+    #define socketsconfigRX_SELECT_TASK_PRIORITY      ( 1 )
+#endif
+
+/*
+ * Host names cached by SOCKETS_GetHostByName(), and for how long past its
+ * TTL an address is still served while it is resolved again. An answer
+ * whose TTL lwIP does not report is kept for the default TTL.
+ *
+ * socketsconfigDNS_PREFETCH_HOSTS may list host names, separated by commas,
+ * that are kept resolved in the background from SOCKETS_Init() on.
+ */
+#ifndef socketsconfigDNS_CACHE_ENTRIES
+    #define socketsconfigDNS_CACHE_ENTRIES            ( 4 )
+#endif
+
+#ifndef socketsconfigDNS_CACHE_DEFAULT_TTL_S
+    #define socketsconfigDNS_CACHE_DEFAULT_TTL_S      ( 60 )
+#endif
+
+#ifndef socketsconfigDNS_CACHE_MAX_TTL_S
+    #define socketsconfigDNS_CACHE_MAX_TTL_S          ( 86400 )
+#endif
+
+#ifndef socketsconfigDNS_CACHE_STALE_S
+    #define socketsconfigDNS_CACHE_STALE_S            ( 3600 )
+#endif
+
+#ifndef socketsconfigDNS_RETRY_MAX_S
+    #define socketsconfigDNS_RETRY_MAX_S              ( 60 )
+#endif
+
+#ifndef socketsconfigDNS_PREFETCH_TASK_STACK_SIZE
+    #define socketsconfigDNS_PREFETCH_TASK_STACK_SIZE ( 512 )
+#endif
+
+#ifndef socketsconfigDNS_PREFETCH_TASK_PRIORITY
+    #define socketsconfigDNS_PREFETCH_TASK_PRIORITY   ( 1 )
+#endif
 
+/*
+ * secure socket context.
+ */
 typedef struct _ss_ctx_t
 {
     int     ip_socket;
 
-    int     state;
     unsigned int    status;
     int     send_flag;
     int     recv_flag;
+    TickType_t      rx_timeout;
+
+    int             connect_state;
+    TickType_t      connect_start;
+    SocketsConnectCallback_t connect_callback;
+    void *          connect_context;
 
-    TaskHandle_t    rx_handle;
     void            (*rx_callback)( Socket_t pxSocket );
+    struct _ss_ctx_t * rx_next;
+    volatile bool   rx_armed;
+
+    bool            busy;           /* a connect step runs, unlocked */
+    bool            close_pending;  /* closed meanwhile, the task frees it */
+    bool            rx_pending;     /* callback changed meanwhile, to apply */
+    void            (*rx_pending_callback)( Socket_t pxSocket );
 
     bool    enforce_tls;
     void    *tls_ctx;
@@ -91,6 +150,23 @@ typedef struct _ss_ctx_t
 
 } ss_ctx_t;
 
+/*
+ * cached host name.
+ */
+typedef struct
+{
+    char *      name;
+    uint32_t    address;    /* network byte order, 0 until resolved */
+    TickType_t  answered;   /* when the address was last confirmed */
+    TickType_t  ttl;        /* ticks for which it is fresh from then */
+    TickType_t  used;       /* last lookup, to pick an entry to reuse */
+    TickType_t  refresh_at; /* when the prefetch task resolves it again */
+    TickType_t  backoff;    /* before retrying a failed refresh */
+    bool        pinned;     /* configured host, kept fresh even if unused */
+    bool        refresh;    /* refresh_at is set */
+    bool        reported;   /* lwIP reported the answer of the last lookup */
+} dns_entry_t;
+
 /*-----------------------------------------------------------*/
 
 //#define SUPPORTED_DESCRIPTORS  (2)
@@ -100,6 +176,35 @@ typedef struct _ss_ctx_t
 //static int8_t sockets_allocated = SUPPORTED_DESCRIPTORS;
 static int8_t sockets_allocated = socketsconfigDEFAULT_MAX_NUM_SECURE_SOCKETS;
 
+/*
+ * Receive callbacks are called from one task, which selects across all the
+ * sockets that have one set. The same task drives the connects started by
+ * SOCKETS_ConnectAsync(), TLS handshake included, so its stack must suit
+ * mbedTLS. The sockets are linked through rx_next, and the list is guarded
+ * by xRxSelectMutex; callbacks run with it held. Connect steps run without
+ * it, as a handshake step can take long: the socket is marked busy instead,
+ * and closing it or changing its receive callback meanwhile is left to the
+ * task, which does so once the step is over. A datagram sent to
+ * rx_wakeup_socket wakes the task when the list changes.
+ */
+static SemaphoreHandle_t    xRxSelectMutex   = NULL;
+static TaskHandle_t         xRxSelectTask    = NULL;
+static ss_ctx_t *           pxRxSelectList   = NULL;
+static int                  rx_wakeup_socket = -1;
+static struct sockaddr_in   rx_wakeup_addr;
+
+/*
+ * The host name cache is guarded by xDnsCacheMutex, which is never held
+ * across a lookup: lwIP takes it too, to report answers.
+ */
+static SemaphoreHandle_t        xDnsCacheMutex   = NULL;
+static TaskHandle_t             xDnsPrefetchTask = NULL;
+static dns_entry_t              dns_cache[ socketsconfigDNS_CACHE_ENTRIES ];
+static SocketsDnsCacheStats_t   dns_stats;
+
+#ifdef socketsconfigDNS_PREFETCH_HOSTS
+static const char * const       dns_prefetch_hosts[] = { socketsconfigDNS_PREFETCH_HOSTS };
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -113,6 +218,11 @@ static int8_t sockets_allocated = socketsconfigDEFAULT_MAX_NUM_SECURE_SOCKETS;
  */
 #define TICK_TO_US( _t_ )   ( (_t_) * 1000 / configTICK_RATE_HZ * 1000 )
 
+/*
+ * whether tick _t_ is reached at _now_, across tick count overflows.
+ */
+#define TICK_REACHED( _now_, _t_ )  ( ( TickType_t ) ( (_now_) - (_t_) ) < ( portMAX_DELAY / 2 ) )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -129,6 +239,13 @@ static BaseType_t prvNetworkSend( void * pvContext,
                          xDataLength,
                          ctx->send_flag );
 
+    /* The handshake resumes once the socket is writable. */
+    if( ( 0 > ret ) && ( SS_CONNECT_IDLE != ctx->connect_state ) &&
+        ( errno == EWOULDBLOCK || errno == EAGAIN ) )
+    {
+        return TLS_ERROR_WANT_WRITE;
+    }
+
     return ( BaseType_t )ret;
 }
 
@@ -165,6 +282,12 @@ static BaseType_t prvNetworkRecv( void * pvContext,
          */
         if( errno == EWOULDBLOCK || errno == EAGAIN )
         {
+            /* The handshake resumes once the socket is readable. */
+            if( SS_CONNECT_IDLE != ctx->connect_state )
+            {
+                return TLS_ERROR_WANT_READ;
+            }
+
             return SOCKETS_ERROR_NONE; // timeout or would block
         }
 
@@ -187,78 +310,786 @@ static BaseType_t prvNetworkRecv( void * pvContext,
 
 /*-----------------------------------------------------------*/
 
-static void vTaskRxSelect( void * param )
+/*
+ * @brief Ticks left before the current connect step times out, or
+ * portMAX_DELAY if it may wait forever, as a receive without timeout does.
+ */
+static TickType_t prvConnectTimeLeft( const ss_ctx_t * ctx,
+                                      TickType_t now )
+{
+    TickType_t elapsed = now - ctx->connect_start;
+
+    if( ( 0 == ctx->rx_timeout ) || ( portMAX_DELAY == ctx->rx_timeout ) )
+    {
+        return portMAX_DELAY;
+    }
+
+    return ( elapsed < ctx->rx_timeout ) ? ctx->rx_timeout - elapsed : 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Starts a TCP connect on a socket made non-blocking for the duration
+ * of the connect.
+ *
+ * @return SOCKETS_EWOULDBLOCK once the connect is under way.
+ */
+static int32_t prvConnectStart( ss_ctx_t * ctx,
+                                const SocketsSockaddr_t * pxAddress )
 {
-    ss_ctx_t *  ctx = ( ss_ctx_t * )param;
-    int         s   = ctx->ip_socket;
+    struct sockaddr_in sa_addr = { 0 };
+    int opt = 1;
+    int ret;
+
+    sa_addr.sin_family      = pxAddress->ucSocketDomain ? pxAddress->ucSocketDomain : AF_INET;
+    sa_addr.sin_addr.s_addr = pxAddress->ulAddress;
+    sa_addr.sin_port        = pxAddress->usPort;
+
+    if( 0 != lwip_ioctl( ctx->ip_socket, FIONBIO, &opt ) )
+    {
+        configPRINTF(("LwIP ioctl fail %d\n", errno));
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    ctx->connect_state = SS_CONNECT_TCP;
+    ctx->connect_start = xTaskGetTickCount();
+
+    ret = lwip_connect( ctx->ip_socket,
+                        (struct sockaddr *) &sa_addr,
+                        sizeof(sa_addr));
 
-    fd_set      read_fds;
-    fd_set      write_fds;
-    fd_set      err_fds;
+    if( ( 0 != ret ) && ( EINPROGRESS != errno ) )
+    {
+        configPRINTF(("LwIP connect fail %d %d\n", ret, errno));
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    return SOCKETS_EWOULDBLOCK;
+}
 
-    FD_ZERO (&read_fds);
-    FD_ZERO (&write_fds);
-    FD_ZERO (&err_fds);
+/*-----------------------------------------------------------*/
 
-    FD_SET  (s, &read_fds);
-    FD_SET  (s, &err_fds);
+/*
+ * @brief Advances a connect once the socket is ready for it.
+ *
+ * @return SOCKETS_EWOULDBLOCK until the socket is connected, and secured if
+ * TLS is required; SOCKETS_ERROR_NONE then, or an error.
+ */
+static int32_t prvConnectStep( ss_ctx_t * ctx )
+{
+    BaseType_t status;
 
-    ctx->state = SST_RX_READY;
-    while( 1 )
+    if( SS_CONNECT_TCP == ctx->connect_state )
     {
-        if (ctx->state == SST_RX_CLOSING)
+        TLSParams_t         tls_params = { 0 };
+        struct sockaddr_in  sa_addr;
+        socklen_t           sa_len = sizeof( sa_addr );
+
+        /* A ready socket without a peer failed to connect. SO_ERROR cannot
+         * tell, lwIP keeps reporting EINPROGRESS once connected. */
+        if( 0 != lwip_getpeername( ctx->ip_socket,
+                                   (struct sockaddr *) &sa_addr,
+                                   &sa_len ) )
         {
-            ctx->state = SST_RX_CLOSED;
-            vTaskDelete( NULL );
+            configPRINTF(("LwIP connect fail %d\n", errno));
+            return SOCKETS_SOCKET_ERROR;
         }
-        if( lwip_select( s + 1, &read_fds, &write_fds, &err_fds, NULL ) == -1 )
+
+        ctx->status |= SS_STATUS_CONNECTED;
+
+        if( ! ctx->enforce_tls )
         {
-            //TaskHandle_t rx_handle = ctx->rx_handle;
+            return SOCKETS_ERROR_NONE;
+        }
 
-            //ctx->rx_handle   = NULL;
-            //ctx->rx_callback = NULL;
+        tls_params.ulSize                    = sizeof( tls_params );
+        tls_params.pcDestination             = ctx->destination;
+        tls_params.pcServerCertificate       = ctx->server_cert;
+        tls_params.ulServerCertificateLength = ctx->server_cert_len;
+        tls_params.pvCallerContext           = ctx;
+        tls_params.pxNetworkRecv             = prvNetworkRecv;
+        tls_params.pxNetworkSend             = prvNetworkSend;
+        tls_params.ppcAlpnProtocols          = ( const char ** ) ctx->ppcAlpnProtocols;
+        tls_params.ulAlpnProtocolsCount      = ctx->ulAlpnProtocolsCount;
 
-            //vTaskDelete( rx_handle );
-            vTaskDelete( NULL );
-            return;
+        status = TLS_Init( &ctx->tls_ctx, &tls_params );
+
+        if( pdFREERTOS_ERRNO_NONE != status )
+        {
+            configPRINTF(("TLS_Init fail\n"));
+            return SOCKETS_SOCKET_ERROR;
+        }
+
+        status = TLS_ConnectStart( ctx->tls_ctx );
+
+        if( pdFREERTOS_ERRNO_NONE != status )
+        {
+            configPRINTF( ( "TLS_Connect fail (0x%x, %s)\n", ( unsigned int ) -status, ctx->destination ? ctx->destination : "NULL" ) );
+            return SOCKETS_SOCKET_ERROR;
+        }
+
+        /* The ClientHello goes first. */
+        ctx->connect_state = SS_CONNECT_TLS_WRITE;
+    }
+
+    status = TLS_ConnectStep( ctx->tls_ctx );
+
+    if( TLS_ERROR_WANT_READ == status )
+    {
+        ctx->connect_state = SS_CONNECT_TLS_READ;
+        return SOCKETS_EWOULDBLOCK;
+    }
+
+    if( TLS_ERROR_WANT_WRITE == status )
+    {
+        ctx->connect_state = SS_CONNECT_TLS_WRITE;
+        return SOCKETS_EWOULDBLOCK;
+    }
+
+    if( pdFREERTOS_ERRNO_NONE != status )
+    {
+        configPRINTF( ( "TLS_Connect fail (0x%x, %s)\n", ( unsigned int ) -status, ctx->destination ? ctx->destination : "NULL" ) );
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    ctx->status |= SS_STATUS_SECURED;
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Puts the socket back in blocking mode once a connect is over.
+ */
+static int32_t prvConnectEnd( ss_ctx_t * ctx,
+                              int32_t lStatus )
+{
+    int opt = 0;
+
+    ctx->connect_state = SS_CONNECT_IDLE;
+
+    ( void ) lwip_ioctl( ctx->ip_socket, FIONBIO, &opt );
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Waits, for up to the receive timeout, until the socket is ready for
+ * the next connect step.
+ *
+ * @return pdTRUE if it is, pdFALSE on timeout or error.
+ */
+static BaseType_t prvConnectWait( ss_ctx_t * ctx )
+{
+    fd_set          ready_fds;
+    fd_set          except_fds;
+    struct timeval  tv;
+    struct timeval  * ptv = NULL;
+    TickType_t      ticks;
+
+    FD_ZERO( &ready_fds );
+    FD_ZERO( &except_fds );
+    FD_SET( ctx->ip_socket, &ready_fds );
+    FD_SET( ctx->ip_socket, &except_fds );
+
+    ctx->connect_start = xTaskGetTickCount();
+    ticks              = prvConnectTimeLeft( ctx, ctx->connect_start );
+
+    if( portMAX_DELAY != ticks )
+    {
+        tv.tv_sec  = TICK_TO_S ( ticks );
+        tv.tv_usec = TICK_TO_US( ticks % configTICK_RATE_HZ );
+        ptv        = &tv;
+    }
+
+    return ( 0 < lwip_select( ctx->ip_socket + 1,
+                              ( SS_CONNECT_TLS_READ == ctx->connect_state ) ? &ready_fds : NULL,
+                              ( SS_CONNECT_TLS_READ == ctx->connect_state ) ? NULL : &ready_fds,
+                              &except_fds,
+                              ptv ) ) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Wakes the receive select task out of lwip_select(), so that it picks
+ * up a change to the set of sockets it waits on.
+ */
+static void prvRxSelectWake( void )
+{
+    char cWakeup = 0;
+
+    /* A failure means that wakeups are already queued, which is enough. */
+    ( void ) lwip_sendto( rx_wakeup_socket,
+                          &cWakeup,
+                          sizeof( cWakeup ),
+                          0,
+                          ( struct sockaddr * ) &rx_wakeup_addr,
+                          sizeof( rx_wakeup_addr ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Adds a socket to the list of the receive select task.
+ *
+ * Called with xRxSelectMutex held, if the socket has neither callback set.
+ */
+static void prvRxSelectLink( ss_ctx_t * ctx )
+{
+    ctx->rx_next   = pxRxSelectList;
+    pxRxSelectList = ctx;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Removes a socket from the list of the receive select task, if there.
+ *
+ * Called with xRxSelectMutex held.
+ */
+static void prvRxSelectUnlink( ss_ctx_t * ctx )
+{
+    ss_ctx_t ** ppxLink;
+
+    for( ppxLink = &pxRxSelectList; NULL != *ppxLink; ppxLink = &( *ppxLink )->rx_next )
+    {
+        if( *ppxLink == ctx )
+        {
+            *ppxLink = ctx->rx_next;
+            break;
+        }
+    }
+
+    ctx->rx_next = NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Ends a connect started by SOCKETS_ConnectAsync(), and calls back.
+ *
+ * Called with xRxSelectMutex held.
+ */
+static void prvConnectComplete( ss_ctx_t * ctx,
+                                int32_t lStatus )
+{
+    SocketsConnectCallback_t    pxCallback = ctx->connect_callback;
+    void                        * pvContext = ctx->connect_context;
+
+    ( void ) prvConnectEnd( ctx, lStatus );
+
+    ctx->connect_callback = NULL;
+    ctx->connect_context  = NULL;
+
+    if( NULL == ctx->rx_callback )
+    {
+        prvRxSelectUnlink( ctx );
+    }
+
+    pxCallback( ( Socket_t ) ctx, lStatus, pvContext );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Releases a socket and everything it holds.
+ */
+static void prvSocketFree( ss_ctx_t * ctx )
+{
+    uint32_t ulProtocol;
+
+    /* Clean-up application protocol array. */
+    if( NULL != ctx->ppcAlpnProtocols )
+    {
+        for( ulProtocol = 0;
+             ulProtocol < ctx->ulAlpnProtocolsCount;
+             ulProtocol++ )
+        {
+            if( NULL != ctx->ppcAlpnProtocols[ ulProtocol ] )
+            {
+                vPortFree( ctx->ppcAlpnProtocols[ ulProtocol ] );
+            }
+        }
+
+        vPortFree( ctx->ppcAlpnProtocols );
+    }
+
+    if ( true == ctx->enforce_tls )
+    {
+        TLS_Cleanup( ctx->tls_ctx );
+    }
+
+    if( 0 <= ctx->ip_socket )
+    {
+        lwip_close( ctx->ip_socket );
+
+        sockets_allocated ++;
+    }
+
+    if( ctx->server_cert )
+    {
+        vPortFree( ctx->server_cert );
+    }
+
+    if( ctx->destination )
+    {
+        vPortFree( ctx->destination );
+    }
+
+    vPortFree( ctx );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Takes a connect step with xRxSelectMutex released, then carries out
+ * what the application asked for the socket meanwhile.
+ *
+ * Called with xRxSelectMutex held.
+ *
+ * @return The result of the step, or SOCKETS_ECLOSED if the socket was closed
+ * during it and is now freed.
+ */
+static int32_t prvRxSelectConnectStep( ss_ctx_t * ctx )
+{
+    int32_t lStatus;
+
+    ctx->busy = true;
+    ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+
+    lStatus = prvConnectStep( ctx );
+
+    ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+    ctx->busy = false;
+
+    if( ctx->close_pending )
+    {
+        prvRxSelectUnlink( ctx );
+        prvSocketFree( ctx );
+        return SOCKETS_ECLOSED;
+    }
+
+    if( ctx->rx_pending )
+    {
+        ctx->rx_callback = ctx->rx_pending_callback;
+        ctx->rx_armed    = ( NULL != ctx->rx_callback );
+        ctx->rx_pending  = false;
+    }
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Advances every connect that is ready or timed out, and calls the
+ * receive callback of every armed socket that is ready.
+ *
+ * Called with xRxSelectMutex held, so that a socket cannot be closed while
+ * its callback runs. The mutex is released during connect steps.
+ */
+static void prvRxSelectDispatch( fd_set * read_fds,
+                                 fd_set * write_fds,
+                                 fd_set * except_fds )
+{
+    ss_ctx_t *  ctx = pxRxSelectList;
+    int32_t     lStatus;
+
+    while( NULL != ctx )
+    {
+        if( NULL != ctx->connect_callback )
+        {
+            if( FD_ISSET( ctx->ip_socket, read_fds ) ||
+                FD_ISSET( ctx->ip_socket, write_fds ) ||
+                FD_ISSET( ctx->ip_socket, except_fds ) )
+            {
+                FD_CLR( ctx->ip_socket, read_fds );
+                FD_CLR( ctx->ip_socket, write_fds );
+                FD_CLR( ctx->ip_socket, except_fds );
+
+                lStatus = prvRxSelectConnectStep( ctx );
+
+                if( SOCKETS_ECLOSED == lStatus )
+                {
+                    ctx = pxRxSelectList;
+                    continue;
+                }
+            }
+            else if( 0 == prvConnectTimeLeft( ctx, xTaskGetTickCount() ) )
+            {
+                configPRINTF(("Connect timed out\n"));
+                lStatus = SOCKETS_SOCKET_ERROR;
+            }
+            else
+            {
+                ctx = ctx->rx_next;
+                continue;
+            }
+
+            if( SOCKETS_EWOULDBLOCK == lStatus )
+            {
+                /* Other sockets may have been closed during the step. */
+                ctx->connect_start = xTaskGetTickCount();
+                ctx = pxRxSelectList;
+                continue;
+            }
+
+            prvConnectComplete( ctx, lStatus );
+
+            /* The callback may have closed sockets, this one included. */
+            ctx = pxRxSelectList;
+        }
+        else if( ctx->rx_armed && FD_ISSET( ctx->ip_socket, read_fds ) )
+        {
+            /* Stay quiet until the application reads from the socket,
+             * rather than calling back for as long as data is pending. */
+            ctx->rx_armed = false;
+            FD_CLR( ctx->ip_socket, read_fds );
+
+            ctx->rx_callback( ( Socket_t ) ctx );
+
+            /* The callback may have closed sockets, this one included. */
+            ctx = pxRxSelectList;
+        }
+        else
+        {
+            ctx = ctx->rx_next;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Task that dispatches the receive callbacks of every socket, and
+ * drives the connects in progress.
+ */
+static void vTaskRxSelect( void * param )
+{
+    ss_ctx_t *  ctx;
+    int         max_fd;
+    int         nready;
+    char        cWakeup;
+    TickType_t  now;
+    TickType_t  ticks;
+    TickType_t  wait;
+
+    fd_set          read_fds;
+    fd_set          write_fds;
+    fd_set          except_fds;
+    struct timeval  tv;
+
+    ( void ) param;
+
+    for( ; ; )
+    {
+        FD_ZERO( &read_fds );
+        FD_ZERO( &write_fds );
+        FD_ZERO( &except_fds );
+        FD_SET( rx_wakeup_socket, &read_fds );
+        max_fd = rx_wakeup_socket;
+        wait   = portMAX_DELAY;
+
+        ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+
+        now = xTaskGetTickCount();
+
+        for( ctx = pxRxSelectList; NULL != ctx; ctx = ctx->rx_next )
+        {
+            if( NULL != ctx->connect_callback )
+            {
+                /* A TCP connect completes, or fails, with the socket
+                 * writable; the handshake waits on either direction. */
+                FD_SET( ctx->ip_socket,
+                        ( SS_CONNECT_TLS_READ == ctx->connect_state ) ? &read_fds : &write_fds );
+                FD_SET( ctx->ip_socket, &except_fds );
+
+                ticks = prvConnectTimeLeft( ctx, now );
+
+                if( ticks < wait )
+                {
+                    wait = ticks;
+                }
+            }
+            else if( ctx->rx_armed && ( ctx->status & SS_STATUS_CONNECTED ) )
+            {
+                FD_SET( ctx->ip_socket, &read_fds );
+            }
+            else
+            {
+                continue;
+            }
+
+            if( ctx->ip_socket > max_fd )
+            {
+                max_fd = ctx->ip_socket;
+            }
+        }
+
+        ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+
+        if( portMAX_DELAY != wait )
+        {
+            tv.tv_sec  = TICK_TO_S ( wait );
+            tv.tv_usec = TICK_TO_US( wait % configTICK_RATE_HZ );
+        }
+
+        nready = lwip_select( max_fd + 1,
+                              &read_fds,
+                              &write_fds,
+                              &except_fds,
+                              ( portMAX_DELAY != wait ) ? &tv : NULL );
+
+        if( 0 > nready )
+        {
+            vTaskDelay( 1 );
+            continue;
+        }
+
+        if( 0 == nready )
+        {
+            /* Timed out: only the connects that ran out of time move on. */
+            FD_ZERO( &read_fds );
+            FD_ZERO( &write_fds );
+            FD_ZERO( &except_fds );
+        }
+        else if( FD_ISSET( rx_wakeup_socket, &read_fds ) )
+        {
+            while( lwip_recv( rx_wakeup_socket, &cWakeup, sizeof( cWakeup ), MSG_DONTWAIT ) > 0 )
+            {
+            }
+        }
+
+        ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+        prvRxSelectDispatch( &read_fds, &write_fds, &except_fds );
+        ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Starts the receive select task and its wakeup socket, on first use.
+ *
+ * Called with xRxSelectMutex held.
+ */
+static int32_t prvRxSelectStart( void )
+{
+    socklen_t xAddressLength = sizeof( rx_wakeup_addr );
+
+    if( NULL != xRxSelectTask )
+    {
+        return SOCKETS_ERROR_NONE;
+    }
+
+    /* The task waits on a loopback UDP socket as well as on the TCP sockets,
+     * so that it can be woken to pick up changes to the set. */
+    if( 0 > rx_wakeup_socket )
+    {
+        rx_wakeup_socket = lwip_socket( AF_INET, SOCK_DGRAM, 0 );
+
+        if( 0 > rx_wakeup_socket )
+        {
+            return SOCKETS_ENOMEM;
         }
 
-        if( FD_ISSET( s, &read_fds ) )
+        memset( &rx_wakeup_addr, 0, sizeof( rx_wakeup_addr ) );
+        rx_wakeup_addr.sin_family      = AF_INET;
+        rx_wakeup_addr.sin_addr.s_addr = lwip_htonl( INADDR_LOOPBACK );
+
+        if( ( 0 != lwip_bind( rx_wakeup_socket,
+                              ( struct sockaddr * ) &rx_wakeup_addr,
+                              sizeof( rx_wakeup_addr ) ) ) ||
+            ( 0 != lwip_getsockname( rx_wakeup_socket,
+                                     ( struct sockaddr * ) &rx_wakeup_addr,
+                                     &xAddressLength ) ) )
         {
-            configASSERT( ctx->rx_callback );
-            ctx->rx_callback( ( Socket_t )ctx );
-            //vTaskDelay( 10 ); // delay a little bit to yield time for RX
+            lwip_close( rx_wakeup_socket );
+            rx_wakeup_socket = -1;
+            return SOCKETS_SOCKET_ERROR;
         }
     }
+
+    if( pdPASS != xTaskCreate( vTaskRxSelect,
+                               "rxs",
+                               socketsconfigRX_SELECT_TASK_STACK_SIZE,
+                               NULL,
+                               socketsconfigRX_SELECT_TASK_PRIORITY,
+                               &xRxSelectTask ) )
+    {
+        xRxSelectTask = NULL;
+        return SOCKETS_ENOMEM;
+    }
+
+    return SOCKETS_ERROR_NONE;
 }
 
 /*-----------------------------------------------------------*/
 
-static void prvRxSelectSet( ss_ctx_t * ctx, const void * pvOptionValue )
+static int32_t prvRxSelectSet( ss_ctx_t * ctx, const void * pvOptionValue )
 {
-    BaseType_t xReturned;
-    TaskHandle_t xHandle = NULL;
+    int32_t lStatus;
+
+    if( NULL == xRxSelectMutex )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+
+    lStatus = prvRxSelectStart();
 
-    ctx->rx_callback = (void (*)(Socket_t))pvOptionValue;
+    if( ( SOCKETS_ERROR_NONE == lStatus ) && ctx->busy )
+    {
+        /* The socket stays listed for its connect; the task sets the
+         * callback after the step. */
+        ctx->rx_pending          = true;
+        ctx->rx_pending_callback = (void (*)(Socket_t))pvOptionValue;
+    }
+    else if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        if( ( NULL == ctx->rx_callback ) && ( NULL == ctx->connect_callback ) )
+        {
+            prvRxSelectLink( ctx );
+        }
+
+        ctx->rx_callback = (void (*)(Socket_t))pvOptionValue;
+        ctx->rx_armed    = true;
+    }
 
-    xReturned = xTaskCreate( vTaskRxSelect,   /* pvTaskCode */
-                               "rxs",         /* pcName */
-                               512,           /* usStackDepth */
-                               ctx,           /* pvParameters */
-                               1,             /* uxPriority */
-                               &xHandle );    /* pxCreatedTask */
+    ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
 
-    configASSERT( xReturned == pdPASS );
-    configASSERT( xHandle != NULL );
+    if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        prvRxSelectWake();
+    }
 
-    ctx->rx_handle   = xHandle;
+    return lStatus;
 }
 
 /*-----------------------------------------------------------*/
 
+/*
+ * @brief Stops calling back for a socket.
+ *
+ * On return, the callback is not running, unless it is the caller.
+ */
 static void prvRxSelectClear( ss_ctx_t * ctx )
 {
-    // TODO
+    if( NULL == xRxSelectMutex )
+    {
+        return;
+    }
+
+    ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+
+    if( ctx->busy )
+    {
+        /* No receive callback runs during a connect step; the task clears
+         * it after the step. */
+        ctx->rx_pending          = true;
+        ctx->rx_pending_callback = NULL;
+        ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+        return;
+    }
+
+    if( NULL == ctx->rx_callback )
+    {
+        ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+        return;
+    }
+
+    if( NULL == ctx->connect_callback )
+    {
+        prvRxSelectUnlink( ctx );
+    }
+
+    ctx->rx_callback = NULL;
+    ctx->rx_armed    = false;
+
+    ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+
+    /* Have the task drop the socket from its select set. */
+    prvRxSelectWake();
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Drops a socket that is being closed from the receive select task,
+ * cancelling its connect if one is in progress.
+ *
+ * On return, neither callback is running, unless it is the caller.
+ *
+ * @return true if the caller frees the socket, false if a connect step is
+ * running on it and the task frees it once the step is over.
+ */
+static bool prvRxSelectRemove( ss_ctx_t * ctx )
+{
+    bool listed;
+
+    if( NULL == xRxSelectMutex )
+    {
+        return true;
+    }
+
+    /* Taken even if no callback appears set, as the task clears the connect
+     * callback just before calling it. */
+    ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+
+    if( ctx->busy )
+    {
+        ctx->close_pending    = true;
+        ctx->connect_callback = NULL;
+        ctx->connect_context  = NULL;
+        ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+        return false;
+    }
+
+    listed = ( NULL != ctx->rx_callback ) || ( NULL != ctx->connect_callback );
+
+    if( listed )
+    {
+        prvRxSelectUnlink( ctx );
+    }
+
+    ctx->rx_callback      = NULL;
+    ctx->rx_armed         = false;
+    ctx->connect_callback = NULL;
+    ctx->connect_context  = NULL;
+
+    ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+
+    if( listed )
+    {
+        prvRxSelectWake();
+    }
+
+    return true;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Calls back again once data arrives, now that the application reads.
+ */
+static void prvRxSelectArm( ss_ctx_t * ctx )
+{
+    if( ( NULL != ctx->rx_callback ) && ! ctx->rx_armed )
+    {
+        ctx->rx_armed = true;
+
+        /* The task rebuilds its select set after dispatching anyway. */
+        if( xTaskGetCurrentTaskHandle() != xRxSelectTask )
+        {
+            prvRxSelectWake();
+        }
+    }
 }
 
 /*-----------------------------------------------------------*/
@@ -288,7 +1119,8 @@ Socket_t SOCKETS_Socket( int32_t lDomain,
     {
         memset( ctx, 0, sizeof ( *ctx ) );
 
-        ctx->ip_socket = lwip_socket( lDomain, lType, lProtocol );
+        ctx->rx_timeout = pdMS_TO_TICKS( socketsconfigDEFAULT_RECV_TIMEOUT );
+        ctx->ip_socket  = lwip_socket( lDomain, lType, lProtocol );
 
         if( ctx->ip_socket >= 0 )
         {
@@ -335,70 +1167,103 @@ int32_t SOCKETS_Connect( Socket_t xSocket,
 
     if( 0 <= ctx->ip_socket )
     {
-        struct sockaddr_in sa_addr = { 0 };
-        int ret;
-
-        sa_addr.sin_family      = pxAddress->ucSocketDomain ? pxAddress->ucSocketDomain : AF_INET;
-        sa_addr.sin_addr.s_addr = pxAddress->ulAddress;
-        sa_addr.sin_port        = pxAddress->usPort;
+        int32_t lStatus;
 
-        ret = lwip_connect( ctx->ip_socket,
-                            (struct sockaddr *) &sa_addr,
-                            sizeof(sa_addr));
+        /* The steps SOCKETS_ConnectAsync() takes in the background, taken
+         * here as soon as the socket is ready for each. */
+        lStatus = prvConnectStart( ctx, pxAddress );
 
-        if( 0 == ret )
+        while( SOCKETS_EWOULDBLOCK == lStatus )
         {
-            TLSParams_t     tls_params = { 0 };
-            BaseType_t      status;
-
-            ctx->status |= SS_STATUS_CONNECTED;
-
-            if( ! ctx->enforce_tls )
+            if( pdFALSE == prvConnectWait( ctx ) )
             {
-                return SOCKETS_ERROR_NONE;
+                configPRINTF(("Connect timed out\n"));
+                lStatus = SOCKETS_SOCKET_ERROR;
             }
+            else
+            {
+                lStatus = prvConnectStep( ctx );
+            }
+        }
 
-            tls_params.ulSize                    = sizeof( tls_params );
-            tls_params.pcDestination             = ctx->destination;
-            tls_params.pcServerCertificate       = ctx->server_cert;
-            tls_params.ulServerCertificateLength = ctx->server_cert_len;
-            tls_params.pvCallerContext           = ctx;
-            tls_params.pxNetworkRecv             = prvNetworkRecv;
-            tls_params.pxNetworkSend             = prvNetworkSend;
-            tls_params.ppcAlpnProtocols          = ( const char ** ) ctx->ppcAlpnProtocols;
-            tls_params.ulAlpnProtocolsCount      = ctx->ulAlpnProtocolsCount;
+        return prvConnectEnd( ctx, lStatus );
+    }
+    else
+    {
+        configPRINTF(("Invalid ip socket\n"));
+    }
 
-            status = TLS_Init( &ctx->tls_ctx, &tls_params );
+    return SOCKETS_SOCKET_ERROR;
+}
 
-            if( pdFREERTOS_ERRNO_NONE != status )
-            {
-                configPRINTF(("TLS_Init fail\n"));
-                return SOCKETS_SOCKET_ERROR;
-            }
+/*-----------------------------------------------------------*/
 
-            status = TLS_Connect( ctx->tls_ctx );
+int32_t SOCKETS_ConnectAsync( Socket_t xSocket,
+                              SocketsSockaddr_t * pxAddress,
+                              Socklen_t xAddressLength,
+                              SocketsConnectCallback_t pxCallback,
+                              void * pvCallbackContext )
+{
+    ss_ctx_t * ctx;
+    int32_t    lStatus;
 
-            if( pdFREERTOS_ERRNO_NONE == status )
-            {
-                ctx->status |= SS_STATUS_SECURED;
-                return SOCKETS_ERROR_NONE;
-            }
-            else
-            {
-                configPRINTF( ( "TLS_Connect fail (0x%x, %s)\n", ( unsigned int ) -status, ctx->destination ? ctx->destination : "NULL" ) );
-            }
-        }
-        else
+    ( void ) xAddressLength;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket || NULL == pxAddress || NULL == pxCallback )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    // support only SOCKETS_AF_INET for now
+    pxAddress->ucSocketDomain = SOCKETS_AF_INET;
+
+    ctx = ( ss_ctx_t * )xSocket;
+
+    if( 0 > ctx->ip_socket || NULL == xRxSelectMutex )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ( ctx->status & SS_STATUS_CONNECTED ) || SS_CONNECT_IDLE != ctx->connect_state )
+    {
+        return SOCKETS_EISCONN;
+    }
+
+    ( void ) xSemaphoreTakeRecursive( xRxSelectMutex, portMAX_DELAY );
+
+    lStatus = prvRxSelectStart();
+
+    if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        lStatus = prvConnectStart( ctx, pxAddress );
+    }
+
+    if( SOCKETS_EWOULDBLOCK == lStatus )
+    {
+        /* The receive select task takes it from here. */
+        if( NULL == ctx->rx_callback )
         {
-            configPRINTF(("LwIP connect fail %d %d\n", ret, errno));
+            prvRxSelectLink( ctx );
         }
+
+        ctx->connect_callback = pxCallback;
+        ctx->connect_context  = pvCallbackContext;
+
+        lStatus = SOCKETS_ERROR_NONE;
     }
     else
     {
-        configPRINTF(("Invalid ip socket\n"));
+        ( void ) prvConnectEnd( ctx, lStatus );
     }
 
-    return SOCKETS_SOCKET_ERROR;
+    ( void ) xSemaphoreGiveRecursive( xRxSelectMutex );
+
+    if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        prvRxSelectWake();
+    }
+
+    return lStatus;
 }
 
 /*-----------------------------------------------------------*/
@@ -409,6 +1274,7 @@ int32_t SOCKETS_Recv( Socket_t xSocket,
                       uint32_t ulFlags )
 {
     ss_ctx_t * ctx = ( ss_ctx_t * )xSocket;
+    int32_t    ret;
 
     if( ( ctx->status & SS_STATUS_CONNECTED ) != SS_STATUS_CONNECTED )
     {
@@ -435,12 +1301,17 @@ int32_t SOCKETS_Recv( Socket_t xSocket,
     if( ctx->enforce_tls )
     {
         /* Receive through TLS pipe, if negotiated. */
-        return TLS_Recv( ctx->tls_ctx, pvBuffer, xBufferLength );
+        ret = TLS_Recv( ctx->tls_ctx, pvBuffer, xBufferLength );
     }
     else
     {
-        return prvNetworkRecv( ( void * ) ctx, pvBuffer, xBufferLength );
+        ret = prvNetworkRecv( ( void * ) ctx, pvBuffer, xBufferLength );
     }
+
+    /* Only after the read, or the data just read would call back again. */
+    prvRxSelectArm( ctx );
+
+    return ret;
 }
 
 /*-----------------------------------------------------------*/
@@ -510,68 +1381,27 @@ int32_t SOCKETS_Shutdown( Socket_t xSocket,
     return SOCKETS_ERROR_NONE;
 }
 
-/*-----------------------------------------------------------*/
-
-int32_t SOCKETS_Close( Socket_t xSocket )
-{
-    ss_ctx_t * ctx;
-
-    uint32_t ulProtocol;
-
-    if( SOCKETS_INVALID_SOCKET == xSocket )
-    {
-        return SOCKETS_EINVAL;
-    }
-
-    ctx = ( ss_ctx_t * )xSocket;
-
-    /* Clean-up application protocol array. */
-    if( NULL != ctx->ppcAlpnProtocols )
-    {
-        for( ulProtocol = 0;
-             ulProtocol < ctx->ulAlpnProtocolsCount;
-             ulProtocol++ )
-        {
-            if( NULL != ctx->ppcAlpnProtocols[ ulProtocol ] )
-            {
-                vPortFree( ctx->ppcAlpnProtocols[ ulProtocol ] );
-            }
-        }
-
-        vPortFree( ctx->ppcAlpnProtocols );
-    }
-
-    if ( true == ctx->enforce_tls )
-    {
-        TLS_Cleanup( ctx->tls_ctx );
-    }
-
-    if( 0 <= ctx->ip_socket )
-    {
-        int   cnt = 0;
-        ctx->state = SST_RX_CLOSING;
-        while ((ctx->state != SST_RX_CLOSED) && (cnt<30))
-        {
-            cnt++;
-            vTaskDelay( 10 );
-        }
-        lwip_close( ctx->ip_socket );
+/*-----------------------------------------------------------*/
 
-        sockets_allocated ++;
-    }
+int32_t SOCKETS_Close( Socket_t xSocket )
+{
+    ss_ctx_t * ctx;
 
-    if( ctx->server_cert )
+    if( SOCKETS_INVALID_SOCKET == xSocket )
     {
-        vPortFree( ctx->server_cert );
+        return SOCKETS_EINVAL;
     }
 
-    if( ctx->destination )
+    ctx = ( ss_ctx_t * )xSocket;
+
+    /* Make sure the receive and connect callbacks are done with the socket.
+     * If a connect step is running on it, the receive select task frees it
+     * once the step is over. */
+    if( prvRxSelectRemove( ctx ) )
     {
-        vPortFree( ctx->destination );
+        prvSocketFree( ctx );
     }
 
-    vPortFree( ctx );
-
     return SOCKETS_ERROR_NONE;
 }
 
@@ -625,6 +1455,12 @@ int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
                 return SOCKETS_EINVAL;
             }
 
+            /* Also bounds each step of a connect. */
+            if( lOptionName == SOCKETS_SO_RCVTIMEO )
+            {
+                ctx->rx_timeout = ticks;
+            }
+
             break;
         }
 
@@ -725,7 +1561,12 @@ int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
             if( xOptionLength == sizeof( void * ) &&
                 pvOptionValue != NULL )
             {
-                prvRxSelectSet( ctx, pvOptionValue );
+                ret = prvRxSelectSet( ctx, pvOptionValue );
+
+                if( SOCKETS_ERROR_NONE != ret )
+                {
+                    return ret;
+                }
             }
             else
             {
@@ -788,18 +1629,367 @@ int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
 
 /*-----------------------------------------------------------*/
 
-uint32_t SOCKETS_GetHostByName( const char * pcHostName )
+/*
+ * @brief Resolves a host name, waiting for the answer.
+ */
+static uint32_t prvDnsResolve( const char * pcHostName )
 {
-    uint32_t addr;
+    uint32_t addr = 0;
 
-    if( strlen( pcHostName ) <= ( size_t ) securesocketsMAX_DNS_NAME_LENGTH )
+    if( eWiFiSuccess != WIFI_GetHostIP( ( char * ) pcHostName, ( uint8_t * ) &addr ) )
     {
-        WIFI_GetHostIP( ( char * ) pcHostName, ( uint8_t * ) &addr );
+        addr = 0;
     }
-    else
+
+    return addr;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Finds the cache entry of a host name.
+ *
+ * Called with xDnsCacheMutex held.
+ */
+static dns_entry_t * prvDnsFind( const char * pcHostName )
+{
+    int i;
+
+    for( i = 0; i < socketsconfigDNS_CACHE_ENTRIES; i++ )
+    {
+        if( ( NULL != dns_cache[ i ].name ) &&
+            ( 0 == lwip_stricmp( dns_cache[ i ].name, pcHostName ) ) )
+        {
+            return &dns_cache[ i ];
+        }
+    }
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Takes a free cache entry for a host name, or else the one that was
+ * looked up least recently, unless it is pinned.
+ *
+ * Called with xDnsCacheMutex held.
+ */
+static dns_entry_t * prvDnsAlloc( const char * pcHostName )
+{
+    dns_entry_t *   entry = NULL;
+    TickType_t      now   = xTaskGetTickCount();
+    size_t          len   = strlen( pcHostName );
+    int             i;
+
+    for( i = 0; i < socketsconfigDNS_CACHE_ENTRIES; i++ )
+    {
+        if( NULL == dns_cache[ i ].name )
+        {
+            entry = &dns_cache[ i ];
+            break;
+        }
+
+        if( ! dns_cache[ i ].pinned &&
+            ( ( NULL == entry ) || ( now - dns_cache[ i ].used > now - entry->used ) ) )
+        {
+            entry = &dns_cache[ i ];
+        }
+    }
+
+    if( NULL == entry )
+    {
+        return NULL;
+    }
+
+    if( NULL != entry->name )
+    {
+        vPortFree( entry->name );
+    }
+
+    memset( entry, 0, sizeof( *entry ) );
+
+    entry->name = pvPortMalloc( len + 1 );
+
+    if( NULL == entry->name )
+    {
+        return NULL;
+    }
+
+    memcpy( entry->name, pcHostName, len + 1 );
+    entry->used = now;
+
+    return entry;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Records an answer for a cached host name.
+ *
+ * Called with xDnsCacheMutex held.
+ */
+static void prvDnsStore( dns_entry_t * entry,
+                         uint32_t address,
+                         uint32_t ttl_s )
+{
+    if( ttl_s > socketsconfigDNS_CACHE_MAX_TTL_S )
+    {
+        ttl_s = socketsconfigDNS_CACHE_MAX_TTL_S;
+    }
+
+    entry->address  = address;
+    entry->answered = xTaskGetTickCount();
+    entry->ttl      = ( TickType_t ) ttl_s * configTICK_RATE_HZ;
+    entry->backoff  = 0;
+    entry->reported = true;
+
+    /* lwIP serves the same answer from its own table until the TTL runs
+     * out, so there is nothing new to fetch before then. */
+    entry->refresh    = entry->pinned;
+    entry->refresh_at = entry->answered + entry->ttl;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Task that resolves the cached host names that are due again.
+ */
+static void vTaskDnsPrefetch( void * param )
+{
+    char            name[ securesocketsMAX_DNS_NAME_LENGTH + 1 ];
+    dns_entry_t *   entry;
+    TickType_t      now;
+    TickType_t      wait;
+    uint32_t        addr;
+    int             i;
+
+    ( void ) param;
+
+    for( ; ; )
+    {
+        name[ 0 ] = '\0';
+        wait      = portMAX_DELAY;
+
+        ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+        now = xTaskGetTickCount();
+
+        for( i = 0; i < socketsconfigDNS_CACHE_ENTRIES; i++ )
+        {
+            entry = &dns_cache[ i ];
+
+            if( ( NULL == entry->name ) || ! entry->refresh )
+            {
+                continue;
+            }
+
+            if( TICK_REACHED( now, entry->refresh_at ) )
+            {
+                /* Names longer than the buffer are never cached. */
+                strcpy( name, entry->name );
+                entry->reported = false;
+                break;
+            }
+
+            if( entry->refresh_at - now < wait )
+            {
+                wait = entry->refresh_at - now;
+            }
+        }
+
+        ( void ) xSemaphoreGive( xDnsCacheMutex );
+
+        if( '\0' == name[ 0 ] )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, wait );
+            continue;
+        }
+
+        addr = prvDnsResolve( name );
+
+        ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+        dns_stats.ulPrefetches++;
+        entry = prvDnsFind( name );
+
+        if( NULL != entry )
+        {
+            if( 0 == addr )
+            {
+                /* Keep serving the stale address, and try again later. */
+                entry->backoff = ( 0 == entry->backoff ) ? configTICK_RATE_HZ : entry->backoff * 2;
+
+                if( entry->backoff > socketsconfigDNS_RETRY_MAX_S * configTICK_RATE_HZ )
+                {
+                    entry->backoff = socketsconfigDNS_RETRY_MAX_S * configTICK_RATE_HZ;
+                }
+
+                entry->refresh_at = xTaskGetTickCount() + entry->backoff;
+            }
+            else if( ! entry->reported )
+            {
+                prvDnsStore( entry, addr, socketsconfigDNS_CACHE_DEFAULT_TTL_S );
+            }
+        }
+
+        ( void ) xSemaphoreGive( xDnsCacheMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Starts the prefetch task on first use, and wakes it to look at the
+ * cache again.
+ *
+ * Called with xDnsCacheMutex held.
+ */
+static void prvDnsPrefetchWake( void )
+{
+    if( NULL == xDnsPrefetchTask )
+    {
+        if( pdPASS != xTaskCreate( vTaskDnsPrefetch,
+                                   "dns",
+                                   socketsconfigDNS_PREFETCH_TASK_STACK_SIZE,
+                                   NULL,
+                                   socketsconfigDNS_PREFETCH_TASK_PRIORITY,
+                                   &xDnsPrefetchTask ) )
+        {
+            /* Stale addresses are then served until they are too old. */
+            xDnsPrefetchTask = NULL;
+            return;
+        }
+    }
+
+    ( void ) xTaskNotifyGive( xDnsPrefetchTask );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Called by lwIP, through LWIP_HOOK_DNS_ANSWER, whenever it resolves
+ * a host name, with the TTL of the answer.
+ */
+void vSocketsDnsAnswer( const char * pcHostName,
+                        u32_t ulAddress,
+                        u32_t ulTTL )
+{
+    dns_entry_t * entry;
+
+    if( NULL == xDnsCacheMutex )
+    {
+        return;
+    }
+
+    ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+    entry = prvDnsFind( pcHostName );
+
+    /* An answer with no TTL must not be cached. */
+    if( ( NULL != entry ) && ( 0 != ulAddress ) && ( 0 != ulTTL ) )
+    {
+        prvDnsStore( entry, ulAddress, ulTTL );
+    }
+
+    ( void ) xSemaphoreGive( xDnsCacheMutex );
+}
+
+/*-----------------------------------------------------------*/
+
+uint32_t SOCKETS_GetHostByName( const char * pcHostName )
+{
+    uint32_t        addr = 0;
+    dns_entry_t *   entry;
+    TickType_t      now;
+    TickType_t      age;
+
+    if( strlen( pcHostName ) > ( size_t ) securesocketsMAX_DNS_NAME_LENGTH )
     {
-        addr = 0;
         configPRINTF( ( "Host name (%s) too long!", pcHostName ) );
+        return 0;
+    }
+
+    if( NULL == xDnsCacheMutex )
+    {
+        return prvDnsResolve( pcHostName );
+    }
+
+    ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+    now   = xTaskGetTickCount();
+    entry = prvDnsFind( pcHostName );
+
+    if( ( NULL != entry ) && ( 0 != entry->address ) )
+    {
+        age = now - entry->answered;
+
+        if( age < entry->ttl )
+        {
+            dns_stats.ulHits++;
+            addr = entry->address;
+
+            /* Still in use near the end of its TTL: resolve it again as the
+             * TTL runs out, rather than when it is next looked up. */
+            if( ! entry->refresh && ( age >= entry->ttl - entry->ttl / 10 ) )
+            {
+                entry->refresh    = true;
+                entry->refresh_at = entry->answered + entry->ttl;
+                prvDnsPrefetchWake();
+            }
+        }
+        else if( age - entry->ttl < ( TickType_t ) socketsconfigDNS_CACHE_STALE_S * configTICK_RATE_HZ )
+        {
+            dns_stats.ulStaleHits++;
+            addr = entry->address;
+
+            if( ! entry->refresh )
+            {
+                entry->refresh    = true;
+                entry->refresh_at = now;
+                prvDnsPrefetchWake();
+            }
+        }
+
+        entry->used = now;
+    }
+
+    if( 0 == addr )
+    {
+        dns_stats.ulMisses++;
+
+        if( NULL == entry )
+        {
+            entry = prvDnsAlloc( pcHostName );
+        }
+
+        if( NULL != entry )
+        {
+            entry->reported = false;
+        }
+    }
+
+    ( void ) xSemaphoreGive( xDnsCacheMutex );
+
+    if( 0 != addr )
+    {
+        return addr;
+    }
+
+    addr = prvDnsResolve( pcHostName );
+
+    if( 0 != addr )
+    {
+        ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+        entry = prvDnsFind( pcHostName );
+
+        if( ( NULL != entry ) && ! entry->reported )
+        {
+            prvDnsStore( entry, addr, socketsconfigDNS_CACHE_DEFAULT_TTL_S );
+        }
+
+        ( void ) xSemaphoreGive( xDnsCacheMutex );
     }
 
     return addr;
@@ -807,10 +1997,89 @@ uint32_t SOCKETS_GetHostByName( const char * pcHostName )
 
 /*-----------------------------------------------------------*/
 
+void SOCKETS_GetDnsCacheStats( SocketsDnsCacheStats_t * pxStats )
+{
+    if( NULL == pxStats )
+    {
+        return;
+    }
+
+    if( NULL == xDnsCacheMutex )
+    {
+        memset( pxStats, 0, sizeof( *pxStats ) );
+        return;
+    }
+
+    ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+    *pxStats = dns_stats;
+    ( void ) xSemaphoreGive( xDnsCacheMutex );
+}
+
+/*-----------------------------------------------------------*/
+
 BaseType_t SOCKETS_Init( void )
 {
     BaseType_t xResult = pdPASS;
+
+    if( NULL == xRxSelectMutex )
+    {
+        xRxSelectMutex = xSemaphoreCreateRecursiveMutex();
+
+        if( NULL == xRxSelectMutex )
+        {
+            xResult = pdFAIL;
+        }
+    }
+
+    if( NULL == xDnsCacheMutex )
+    {
+        xDnsCacheMutex = xSemaphoreCreateMutex();
+
+        if( NULL == xDnsCacheMutex )
+        {
+            xResult = pdFAIL;
+        }
+#ifdef socketsconfigDNS_PREFETCH_HOSTS
+        else
+        {
+            dns_entry_t * entry;
+            size_t        i;
+
+            ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+            for( i = 0; i < sizeof( dns_prefetch_hosts ) / sizeof( dns_prefetch_hosts[ 0 ] ); i++ )
+            {
+                /* Skips the endpoint left blank in a fresh configuration. */
+                if( ( '\0' == dns_prefetch_hosts[ i ][ 0 ] ) ||
+                    ( strlen( dns_prefetch_hosts[ i ] ) > ( size_t ) securesocketsMAX_DNS_NAME_LENGTH ) )
+                {
+                    continue;
+                }
+
+                entry = prvDnsAlloc( dns_prefetch_hosts[ i ] );
+
+                if( NULL != entry )
+                {
+                    /* Resolved as soon as the network allows. */
+                    entry->pinned     = true;
+                    entry->refresh    = true;
+                    entry->refresh_at = xTaskGetTickCount();
+
+                    prvDnsPrefetchWake();
+                }
+            }
+
+            ( void ) xSemaphoreGive( xDnsCacheMutex );
+        }
+#endif
+    }
+
     return xResult;
 }
 
 /*-----------------------------------------------------------*/
+
+/* Provide access to private members for testing. */
+#ifdef AMAZON_FREERTOS_ENABLE_UNIT_TESTS
+    #include "aws_secure_sockets_test_access_lwip_define.h"
+#endif
@@ -0,0 +1,1674 @@
+/*
+ * Amazon FreeRTOS Secure Sockets V1.1.5
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_secure_sockets.c
+ * @brief Secure Socket interface implementation over the sockets of a POSIX
+ * host, such as Linux.
+ *
+ * Lets the secure sockets tests and the applications built on them run on a
+ * host, against local servers. TLS goes through the same mbedTLS based TLS
+ * layer as on the targets, and the options behave as in the lwIP port.
+ *
+ * Host sockets never block: a blocking call waits in FreeRTOS, a tick at a
+ * time, so that the other tasks run meanwhile. The receive and connect
+ * callbacks are called from a FreeRTOS task that this file starts, which
+ * polls the host sockets as the interrupts of a network interface would
+ * report them. Callbacks may call any API a task may.
+ */
+
+/* Define _SECURE_SOCKETS_WRAPPER_NOT_REDEFINE to prevent secure sockets functions
+ * from redefining in aws_secure_sockets_wrapper_metrics.h */
+#define _SECURE_SOCKETS_WRAPPER_NOT_REDEFINE
+
+/* Socket interface includes. */
+#include "aws_secure_sockets.h"
+
+#include "aws_tls.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#undef _SECURE_SOCKETS_WRAPPER_NOT_REDEFINE
+
+/*-----------------------------------------------------------*/
+
+#define SS_STATUS_CONNECTED     (1)
+#define SS_STATUS_SECURED       (2)
+
+/*
+ * connect progress.
+ */
+#define SS_CONNECT_IDLE         (0)
+#define SS_CONNECT_TCP          (1)
+#define SS_CONNECT_TLS_READ     (2)
+#define SS_CONNECT_TLS_WRITE    (3)
+
+/*
+ * secure socket context.
+ */
+typedef struct _ss_ctx_t
+{
+    int     ip_socket;
+
+    unsigned int    status;
+    int     send_flag;
+    int     recv_flag;
+    TickType_t      rx_timeout;
+    TickType_t      tx_timeout;
+    bool            nonblocking;
+
+    int             connect_state;
+    TickType_t      connect_start;
+    SocketsConnectCallback_t connect_callback;
+    void *          connect_context;
+
+    void            (*rx_callback)( Socket_t pxSocket );
+    struct _ss_ctx_t * rx_next;
+    volatile bool   rx_armed;
+
+    bool            busy;           /* a connect step runs, unlocked */
+    bool            close_pending;  /* closed meanwhile, the task frees it */
+    bool            rx_pending;     /* callback changed meanwhile, to apply */
+    void            (*rx_pending_callback)( Socket_t pxSocket );
+
+    bool    enforce_tls;
+    void    *tls_ctx;
+    char    *destination;
+
+    char    *server_cert;
+    int     server_cert_len;
+
+    char ** ppcAlpnProtocols;
+    uint32_t ulAlpnProtocolsCount;
+
+} ss_ctx_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Priority of the task that calls back.
+ *
+ * Highest by default, as the task stands in for the interrupts of a network
+ * interface.
+ */
+#ifndef socketsconfigRX_TASK_PRIORITY
+    #define socketsconfigRX_TASK_PRIORITY      ( configMAX_PRIORITIES - 1 )
+#endif
+
+/**
+ * @brief Stack size of the task that calls back, in words.
+ *
+ * The TLS handshakes of SOCKETS_ConnectAsync() run on it.
+ */
+#ifndef socketsconfigRX_TASK_STACK_SIZE
+    #define socketsconfigRX_TASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 16 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Receive callbacks are called from one task, which polls all the sockets
+ * that have one set. The same task drives the connects started by
+ * SOCKETS_ConnectAsync(), TLS handshake included. The sockets are linked
+ * through rx_next, and the list is guarded by rx_mutex, which is recursive;
+ * callbacks run with it held. Connect steps run without it, as a handshake
+ * step can take long: the socket is marked busy instead, and closing it or
+ * changing its receive callback meanwhile is left to the task, which does so
+ * once the step is over. The task sleeps while the list is empty, until
+ * notified that a socket joined it.
+ */
+static SemaphoreHandle_t    rx_mutex          = NULL;
+static TaskHandle_t         rx_task           = NULL;
+static ss_ctx_t *           rx_list           = NULL;
+
+/* Guarded by a critical section. */
+static int32_t              sockets_allocated = socketsconfigDEFAULT_MAX_NUM_SECURE_SOCKETS;
+
+/*
+ * The host resolver keeps whatever cache the host has, so every lookup is
+ * counted as a miss. Guarded by a critical section.
+ */
+static SocketsDnsCacheStats_t   dns_stats;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Makes a socket blocking or non-blocking.
+ */
+static int prvSetNonBlocking( int fd,
+                              bool nonblocking )
+{
+    int flags = fcntl( fd, F_GETFL, 0 );
+
+    if( 0 > flags )
+    {
+        return -1;
+    }
+
+    flags = nonblocking ? ( flags | O_NONBLOCK ) : ( flags & ~O_NONBLOCK );
+
+    return fcntl( fd, F_SETFL, flags );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Ticks a blocking call may wait for, given a socket timeout.
+ *
+ * Zero ticks, as portMAX_DELAY, waits forever.
+ */
+static TickType_t prvBlockTime( TickType_t ticks )
+{
+    return ( 0 == ticks ) ? portMAX_DELAY : ticks;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Waits, for up to ticks, until a socket is ready for events.
+ *
+ * The host socket is polled without blocking, once a tick: a task blocked in
+ * the host would keep every other task from running meanwhile.
+ *
+ * @return pdTRUE if the socket is ready, or if poll() failed, which leaves
+ * the call that follows to find out why; pdFALSE on timeout.
+ */
+static BaseType_t prvWaitReady( int fd,
+                                short events,
+                                TickType_t ticks )
+{
+    struct pollfd   pfd;
+    TickType_t      start = xTaskGetTickCount();
+    int             ret;
+
+    for( ; ; )
+    {
+        pfd.fd      = fd;
+        pfd.events  = events;
+        pfd.revents = 0;
+
+        ret = poll( &pfd, 1, 0 );
+
+        if( ( 0 < ret ) || ( ( 0 > ret ) && ( EINTR != errno ) ) )
+        {
+            return pdTRUE;
+        }
+
+        if( ( portMAX_DELAY != ticks ) && ( ( xTaskGetTickCount() - start ) >= ticks ) )
+        {
+            return pdFALSE;
+        }
+
+        vTaskDelay( 1 );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Network send callback.
+ *
+ * A blocking send waits until all the data is sent, or the send timeout
+ * expires.
+ */
+static BaseType_t prvNetworkSend( void * pvContext,
+                                  const unsigned char * pucData,
+                                  size_t xDataLength )
+{
+    ss_ctx_t *  ctx  = ( ss_ctx_t * ) pvContext;
+    size_t      sent = 0;
+    ssize_t     ret;
+    TimeOut_t   timeout;
+    TickType_t  ticks = prvBlockTime( ctx->tx_timeout );
+
+    vTaskSetTimeOutState( &timeout );
+
+    while( sent < xDataLength )
+    {
+        /* A peer that went away is reported by the return value, rather than
+         * by a SIGPIPE that would end the process. */
+        ret = send( ctx->ip_socket,
+                    pucData + sent,
+                    xDataLength - sent,
+                    ctx->send_flag | MSG_NOSIGNAL | MSG_DONTWAIT );
+
+        if( 0 < ret )
+        {
+            sent += ( size_t ) ret;
+            continue;
+        }
+
+        if( ( 0 > ret ) && ( EINTR == errno ) )
+        {
+            continue;
+        }
+
+        if( ( 0 > ret ) && ( EWOULDBLOCK != errno ) && ( EAGAIN != errno ) )
+        {
+            return ( 0 < sent ) ? ( BaseType_t ) sent : SOCKETS_SOCKET_ERROR;
+        }
+
+        /* The handshake resumes once the socket is writable. */
+        if( ( SS_CONNECT_IDLE != ctx->connect_state ) && ( 0 == sent ) )
+        {
+            return TLS_ERROR_WANT_WRITE;
+        }
+
+        if( ( SS_CONNECT_IDLE != ctx->connect_state ) || ctx->nonblocking ||
+            ( pdFALSE != xTaskCheckForTimeOut( &timeout, &ticks ) ) ||
+            ( pdFALSE == prvWaitReady( ctx->ip_socket, POLLOUT, ticks ) ) )
+        {
+            break;
+        }
+    }
+
+    return ( BaseType_t ) sent;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Network receive callback.
+ *
+ * A blocking receive waits until data arrives, or the receive timeout
+ * expires.
+ */
+static BaseType_t prvNetworkRecv( void * pvContext,
+                                  unsigned char * pucReceiveBuffer,
+                                  size_t xReceiveLength )
+{
+    ss_ctx_t * ctx;
+    ssize_t    ret;
+
+    ctx = ( ss_ctx_t * ) pvContext;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ( SS_CONNECT_IDLE == ctx->connect_state ) && ! ctx->nonblocking &&
+        ( pdFALSE == prvWaitReady( ctx->ip_socket, POLLIN, prvBlockTime( ctx->rx_timeout ) ) ) )
+    {
+        return SOCKETS_ERROR_NONE; // timeout
+    }
+
+    do
+    {
+        ret = recv( ctx->ip_socket,
+                    pucReceiveBuffer,
+                    xReceiveLength,
+                    ctx->recv_flag | MSG_DONTWAIT );
+    } while( ( -1 == ret ) && ( EINTR == errno ) );
+
+    if( -1 == ret )
+    {
+        /*
+         * EWOULDBLOCK or EAGAIN if there is no data when recv is called: the
+         * socket is non-blocking, or the data was ready for a moment only.
+         */
+        if( errno == EWOULDBLOCK || errno == EAGAIN )
+        {
+            /* The handshake resumes once the socket is readable. */
+            if( SS_CONNECT_IDLE != ctx->connect_state )
+            {
+                return TLS_ERROR_WANT_READ;
+            }
+
+            return SOCKETS_ERROR_NONE; // timeout or would block
+        }
+
+        /*
+         * socket is not connected.
+         */
+        if( errno == EBADF || errno == ENOTCONN )
+        {
+            return SOCKETS_ECLOSED;
+        }
+    }
+
+    /* The peer closed its end. */
+    if( 0 == ret )
+    {
+        return SOCKETS_ECLOSED;
+    }
+
+    return ( BaseType_t )ret;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Ticks left before the current connect step times out, or
+ * portMAX_DELAY if it may wait forever, as a receive without timeout does.
+ */
+static TickType_t prvConnectTimeLeft( const ss_ctx_t * ctx,
+                                      TickType_t now )
+{
+    TickType_t elapsed = now - ctx->connect_start;
+
+    if( portMAX_DELAY == prvBlockTime( ctx->rx_timeout ) )
+    {
+        return portMAX_DELAY;
+    }
+
+    return ( elapsed < ctx->rx_timeout ) ? ctx->rx_timeout - elapsed : 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Starts a TCP connect.
+ *
+ * @return SOCKETS_EWOULDBLOCK once the connect is under way.
+ */
+static int32_t prvConnectStart( ss_ctx_t * ctx,
+                                const SocketsSockaddr_t * pxAddress )
+{
+    struct sockaddr_in sa_addr;
+    int ret;
+
+    /* The host would take 0.0.0.0 for itself, a device has no such address. */
+    if( 0 == pxAddress->ulAddress )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    memset( &sa_addr, 0, sizeof( sa_addr ) );
+    sa_addr.sin_family      = AF_INET;
+    sa_addr.sin_addr.s_addr = pxAddress->ulAddress;
+    sa_addr.sin_port        = pxAddress->usPort;
+
+    ctx->connect_state = SS_CONNECT_TCP;
+    ctx->connect_start = xTaskGetTickCount();
+
+    ret = connect( ctx->ip_socket,
+                   (struct sockaddr *) &sa_addr,
+                   sizeof(sa_addr));
+
+    /* An interrupted connect carries on in the background, as one in
+     * progress does. */
+    if( ( 0 != ret ) && ( EINPROGRESS != errno ) && ( EINTR != errno ) )
+    {
+        configPRINTF(("connect fail %d %d\n", ret, errno));
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    return SOCKETS_EWOULDBLOCK;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Advances a connect once the socket is ready for it.
+ *
+ * @return SOCKETS_EWOULDBLOCK until the socket is connected, and secured if
+ * TLS is required; SOCKETS_ERROR_NONE then, or an error.
+ */
+static int32_t prvConnectStep( ss_ctx_t * ctx )
+{
+    BaseType_t status;
+
+    if( SS_CONNECT_TCP == ctx->connect_state )
+    {
+        TLSParams_t tls_params = { 0 };
+        int         error      = 0;
+        socklen_t   error_len  = sizeof( error );
+
+        /* The outcome of the TCP connect, now that the socket is ready. */
+        if( ( 0 != getsockopt( ctx->ip_socket, SOL_SOCKET, SO_ERROR, &error, &error_len ) ) ||
+            ( 0 != error ) )
+        {
+            configPRINTF(("connect fail %d\n", error ? error : errno));
+            return SOCKETS_SOCKET_ERROR;
+        }
+
+        ctx->status |= SS_STATUS_CONNECTED;
+
+        if( ! ctx->enforce_tls )
+        {
+            return SOCKETS_ERROR_NONE;
+        }
+
+        tls_params.ulSize                    = sizeof( tls_params );
+        tls_params.pcDestination             = ctx->destination;
+        tls_params.pcServerCertificate       = ctx->server_cert;
+        tls_params.ulServerCertificateLength = ctx->server_cert_len;
+        tls_params.pvCallerContext           = ctx;
+        tls_params.pxNetworkRecv             = prvNetworkRecv;
+        tls_params.pxNetworkSend             = prvNetworkSend;
+        tls_params.ppcAlpnProtocols          = ( const char ** ) ctx->ppcAlpnProtocols;
+        tls_params.ulAlpnProtocolsCount      = ctx->ulAlpnProtocolsCount;
+
+        status = TLS_Init( &ctx->tls_ctx, &tls_params );
+
+        if( pdFREERTOS_ERRNO_NONE != status )
+        {
+            configPRINTF(("TLS_Init fail\n"));
+            return SOCKETS_SOCKET_ERROR;
+        }
+
+        status = TLS_ConnectStart( ctx->tls_ctx );
+
+        if( pdFREERTOS_ERRNO_NONE != status )
+        {
+            configPRINTF( ( "TLS_Connect fail (0x%x, %s)\n", ( unsigned int ) -status, ctx->destination ? ctx->destination : "NULL" ) );
+            return SOCKETS_SOCKET_ERROR;
+        }
+
+        /* The ClientHello goes first. */
+        ctx->connect_state = SS_CONNECT_TLS_WRITE;
+    }
+
+    status = TLS_ConnectStep( ctx->tls_ctx );
+
+    if( TLS_ERROR_WANT_READ == status )
+    {
+        ctx->connect_state = SS_CONNECT_TLS_READ;
+        return SOCKETS_EWOULDBLOCK;
+    }
+
+    if( TLS_ERROR_WANT_WRITE == status )
+    {
+        ctx->connect_state = SS_CONNECT_TLS_WRITE;
+        return SOCKETS_EWOULDBLOCK;
+    }
+
+    if( pdFREERTOS_ERRNO_NONE != status )
+    {
+        configPRINTF( ( "TLS_Connect fail (0x%x, %s)\n", ( unsigned int ) -status, ctx->destination ? ctx->destination : "NULL" ) );
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    ctx->status |= SS_STATUS_SECURED;
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Marks a connect over.
+ */
+static int32_t prvConnectEnd( ss_ctx_t * ctx,
+                              int32_t lStatus )
+{
+    ctx->connect_state = SS_CONNECT_IDLE;
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Poll events the next connect step waits for: a TCP connect
+ * completes, or fails, with the socket writable; the handshake waits on
+ * either direction.
+ */
+static short prvConnectEvents( const ss_ctx_t * ctx )
+{
+    return ( SS_CONNECT_TLS_READ == ctx->connect_state ) ? POLLIN : POLLOUT;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Waits, for up to the receive timeout, until the socket is ready for
+ * the next connect step.
+ *
+ * @return pdTRUE if it is, pdFALSE on timeout.
+ */
+static BaseType_t prvConnectWait( ss_ctx_t * ctx )
+{
+    ctx->connect_start = xTaskGetTickCount();
+
+    /* POLLERR and POLLHUP, which poll() always reports, leave the step to
+     * find out what failed. */
+    return prvWaitReady( ctx->ip_socket,
+                         prvConnectEvents( ctx ),
+                         prvConnectTimeLeft( ctx, ctx->connect_start ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Creates rx_mutex, on first use.
+ */
+static BaseType_t prvRxInit( void )
+{
+    if( NULL == rx_mutex )
+    {
+        /* No other task may create it meanwhile. */
+        vTaskSuspendAll();
+
+        if( NULL == rx_mutex )
+        {
+            rx_mutex = xSemaphoreCreateRecursiveMutex();
+        }
+
+        ( void ) xTaskResumeAll();
+    }
+
+    return ( NULL != rx_mutex ) ? pdPASS : pdFAIL;
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvRxLock( void )
+{
+    configASSERT( pdPASS == prvRxInit() );
+
+    ( void ) xSemaphoreTakeRecursive( rx_mutex, portMAX_DELAY );
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvRxUnlock( void )
+{
+    ( void ) xSemaphoreGiveRecursive( rx_mutex );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Adds a socket to the list of the receive task, and wakes the task
+ * in case the list was empty.
+ *
+ * Called with rx_mutex held, if the socket has neither callback set.
+ */
+static void prvRxSelectLink( ss_ctx_t * ctx )
+{
+    ctx->rx_next = rx_list;
+    rx_list      = ctx;
+
+    ( void ) xTaskNotifyGive( rx_task );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Removes a socket from the list of the receive task, if there.
+ *
+ * Called with rx_mutex held.
+ */
+static void prvRxSelectUnlink( ss_ctx_t * ctx )
+{
+    ss_ctx_t ** ppxLink;
+
+    for( ppxLink = &rx_list; NULL != *ppxLink; ppxLink = &( *ppxLink )->rx_next )
+    {
+        if( *ppxLink == ctx )
+        {
+            *ppxLink = ctx->rx_next;
+            break;
+        }
+    }
+
+    ctx->rx_next = NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Ends a connect started by SOCKETS_ConnectAsync(), and calls back.
+ *
+ * Called with rx_mutex held.
+ */
+static void prvConnectComplete( ss_ctx_t * ctx,
+                                int32_t lStatus )
+{
+    SocketsConnectCallback_t    pxCallback = ctx->connect_callback;
+    void                        * pvContext = ctx->connect_context;
+
+    ( void ) prvConnectEnd( ctx, lStatus );
+
+    ctx->connect_callback = NULL;
+    ctx->connect_context  = NULL;
+
+    if( NULL == ctx->rx_callback )
+    {
+        prvRxSelectUnlink( ctx );
+    }
+
+    pxCallback( ( Socket_t ) ctx, lStatus, pvContext );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Takes the events poll() reported for a socket, so that a socket is
+ * dispatched at most once per poll() even as the list is walked again.
+ */
+static short prvRxSelectTake( struct pollfd * pfds,
+                              int nfds,
+                              int fd )
+{
+    short revents;
+    int   i;
+
+    for( i = 0; i < nfds; i++ )
+    {
+        if( pfds[ i ].fd == fd )
+        {
+            revents           = pfds[ i ].revents;
+            pfds[ i ].revents = 0;
+            return revents;
+        }
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Releases a socket and everything it holds.
+ */
+static void prvSocketFree( ss_ctx_t * ctx )
+{
+    uint32_t ulProtocol;
+
+    /* Clean-up application protocol array. */
+    if( NULL != ctx->ppcAlpnProtocols )
+    {
+        for( ulProtocol = 0;
+             ulProtocol < ctx->ulAlpnProtocolsCount;
+             ulProtocol++ )
+        {
+            if( NULL != ctx->ppcAlpnProtocols[ ulProtocol ] )
+            {
+                vPortFree( ctx->ppcAlpnProtocols[ ulProtocol ] );
+            }
+        }
+
+        vPortFree( ctx->ppcAlpnProtocols );
+    }
+
+    if ( true == ctx->enforce_tls )
+    {
+        TLS_Cleanup( ctx->tls_ctx );
+    }
+
+    if( 0 <= ctx->ip_socket )
+    {
+        close( ctx->ip_socket );
+
+        taskENTER_CRITICAL();
+        sockets_allocated ++;
+        taskEXIT_CRITICAL();
+    }
+
+    if( ctx->server_cert )
+    {
+        vPortFree( ctx->server_cert );
+    }
+
+    if( ctx->destination )
+    {
+        vPortFree( ctx->destination );
+    }
+
+    vPortFree( ctx );
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Takes a connect step with rx_mutex released, then carries out what
+ * the application asked for the socket meanwhile.
+ *
+ * Called with rx_mutex held.
+ *
+ * @return The result of the step, or SOCKETS_ECLOSED if the socket was closed
+ * during it and is now freed.
+ */
+static int32_t prvRxSelectConnectStep( ss_ctx_t * ctx )
+{
+    int32_t lStatus;
+
+    ctx->busy = true;
+    prvRxUnlock();
+
+    lStatus = prvConnectStep( ctx );
+
+    prvRxLock();
+    ctx->busy = false;
+
+    if( ctx->close_pending )
+    {
+        prvRxSelectUnlink( ctx );
+        prvSocketFree( ctx );
+        return SOCKETS_ECLOSED;
+    }
+
+    if( ctx->rx_pending )
+    {
+        ctx->rx_callback = ctx->rx_pending_callback;
+        ctx->rx_armed    = ( NULL != ctx->rx_callback );
+        ctx->rx_pending  = false;
+    }
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Advances every connect that is ready or timed out, and calls the
+ * receive callback of every armed socket that is ready.
+ *
+ * Called with rx_mutex held, so that a socket cannot be closed while its
+ * callback runs. The mutex is released during connect steps.
+ */
+static void prvRxSelectDispatch( struct pollfd * pfds,
+                                 int nfds )
+{
+    ss_ctx_t *  ctx = rx_list;
+    int32_t     lStatus;
+    short       revents;
+
+    while( NULL != ctx )
+    {
+        revents = prvRxSelectTake( pfds, nfds, ctx->ip_socket );
+
+        if( NULL != ctx->connect_callback )
+        {
+            if( 0 != revents )
+            {
+                lStatus = prvRxSelectConnectStep( ctx );
+
+                if( SOCKETS_ECLOSED == lStatus )
+                {
+                    ctx = rx_list;
+                    continue;
+                }
+            }
+            else if( 0 == prvConnectTimeLeft( ctx, xTaskGetTickCount() ) )
+            {
+                configPRINTF(("Connect timed out\n"));
+                lStatus = SOCKETS_SOCKET_ERROR;
+            }
+            else
+            {
+                ctx = ctx->rx_next;
+                continue;
+            }
+
+            if( SOCKETS_EWOULDBLOCK == lStatus )
+            {
+                /* Other sockets may have been closed during the step. */
+                ctx->connect_start = xTaskGetTickCount();
+                ctx = rx_list;
+                continue;
+            }
+
+            prvConnectComplete( ctx, lStatus );
+
+            /* The callback may have closed sockets, this one included. */
+            ctx = rx_list;
+        }
+        else if( ctx->rx_armed && ( 0 != revents ) )
+        {
+            /* Stay quiet until the application reads from the socket,
+             * rather than calling back for as long as data is pending. A
+             * closed or failed socket calls back too, so that the read finds
+             * out. */
+            ctx->rx_armed = false;
+
+            ctx->rx_callback( ( Socket_t ) ctx );
+
+            /* The callback may have closed sockets, this one included. */
+            ctx = rx_list;
+        }
+        else
+        {
+            ctx = ctx->rx_next;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Task that dispatches the receive callbacks of every socket, and
+ * drives the connects in progress.
+ *
+ * It stands in for the interrupts of a network interface: the sockets are
+ * polled without blocking, once a tick for as long as any is listed.
+ */
+static void prvRxSelectTask( void * pvParameters )
+{
+    struct pollfd   pfds[ socketsconfigDEFAULT_MAX_NUM_SECURE_SOCKETS ];
+    ss_ctx_t *      ctx;
+    int             nfds;
+    int             nready;
+    TickType_t      wait;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        nfds = 0;
+
+        prvRxLock();
+
+        for( ctx = rx_list; NULL != ctx; ctx = ctx->rx_next )
+        {
+            if( NULL != ctx->connect_callback )
+            {
+                pfds[ nfds ].events = prvConnectEvents( ctx );
+            }
+            else if( ctx->rx_armed && ( ctx->status & SS_STATUS_CONNECTED ) )
+            {
+                pfds[ nfds ].events = POLLIN;
+            }
+            else
+            {
+                continue;
+            }
+
+            /* Every socket counts against sockets_allocated, so the list
+             * cannot outgrow pfds. */
+            pfds[ nfds ].fd      = ctx->ip_socket;
+            pfds[ nfds ].revents = 0;
+            nfds++;
+        }
+
+        if( 0 < nfds )
+        {
+            do
+            {
+                nready = poll( pfds, nfds, 0 );
+            } while( ( 0 > nready ) && ( EINTR == errno ) );
+
+            if( 0 > nready )
+            {
+                nfds = 0;
+            }
+        }
+
+        /* With nothing ready, only the connects that ran out of time move
+         * on. */
+        prvRxSelectDispatch( pfds, nfds );
+
+        wait = ( NULL != rx_list ) ? 1 : portMAX_DELAY;
+
+        prvRxUnlock();
+
+        ( void ) ulTaskNotifyTake( pdTRUE, wait );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Starts the receive task, on first use.
+ *
+ * Called with rx_mutex held.
+ */
+static int32_t prvRxSelectStart( void )
+{
+    if( NULL != rx_task )
+    {
+        return SOCKETS_ERROR_NONE;
+    }
+
+    if( pdPASS != xTaskCreate( prvRxSelectTask,
+                               "SocketsRx",
+                               socketsconfigRX_TASK_STACK_SIZE,
+                               NULL,
+                               socketsconfigRX_TASK_PRIORITY,
+                               &rx_task ) )
+    {
+        return SOCKETS_ENOMEM;
+    }
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+static int32_t prvRxSelectSet( ss_ctx_t * ctx, const void * pvOptionValue )
+{
+    int32_t lStatus;
+
+    prvRxLock();
+
+    lStatus = prvRxSelectStart();
+
+    if( ( SOCKETS_ERROR_NONE == lStatus ) && ctx->busy )
+    {
+        /* The socket stays listed for its connect; the task sets the
+         * callback after the step. */
+        ctx->rx_pending          = true;
+        ctx->rx_pending_callback = (void (*)(Socket_t))pvOptionValue;
+    }
+    else if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        if( ( NULL == ctx->rx_callback ) && ( NULL == ctx->connect_callback ) )
+        {
+            prvRxSelectLink( ctx );
+        }
+
+        ctx->rx_callback = (void (*)(Socket_t))pvOptionValue;
+        ctx->rx_armed    = true;
+    }
+
+    prvRxUnlock();
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Stops calling back for a socket.
+ *
+ * On return, the callback is not running, unless it is the caller.
+ */
+static void prvRxSelectClear( ss_ctx_t * ctx )
+{
+    prvRxLock();
+
+    if( ctx->busy )
+    {
+        /* No receive callback runs during a connect step; the task clears
+         * it after the step. */
+        ctx->rx_pending          = true;
+        ctx->rx_pending_callback = NULL;
+    }
+    else if( NULL != ctx->rx_callback )
+    {
+        if( NULL == ctx->connect_callback )
+        {
+            prvRxSelectUnlink( ctx );
+        }
+
+        ctx->rx_callback = NULL;
+        ctx->rx_armed    = false;
+    }
+
+    prvRxUnlock();
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Drops a socket that is being closed from the receive task,
+ * cancelling its connect if one is in progress.
+ *
+ * On return, neither callback is running, unless it is the caller.
+ *
+ * @return true if the caller frees the socket, false if a connect step is
+ * running on it and the task frees it once the step is over.
+ */
+static bool prvRxSelectRemove( ss_ctx_t * ctx )
+{
+    /* Taken even if no callback appears set, as the task clears the
+     * connect callback just before calling it. */
+    prvRxLock();
+
+    if( ctx->busy )
+    {
+        ctx->close_pending    = true;
+        ctx->connect_callback = NULL;
+        ctx->connect_context  = NULL;
+        prvRxUnlock();
+        return false;
+    }
+
+    if( ( NULL != ctx->rx_callback ) || ( NULL != ctx->connect_callback ) )
+    {
+        prvRxSelectUnlink( ctx );
+    }
+
+    ctx->rx_callback      = NULL;
+    ctx->rx_armed         = false;
+    ctx->connect_callback = NULL;
+    ctx->connect_context  = NULL;
+
+    prvRxUnlock();
+
+    return true;
+}
+
+/*-----------------------------------------------------------*/
+
+/*
+ * @brief Calls back again once data arrives, now that the application reads.
+ *
+ * The receive task polls again within a tick.
+ */
+static void prvRxSelectArm( ss_ctx_t * ctx )
+{
+    if( NULL != ctx->rx_callback )
+    {
+        ctx->rx_armed = true;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+Socket_t SOCKETS_Socket( int32_t lDomain,
+                         int32_t lType,
+                         int32_t lProtocol )
+{
+    ss_ctx_t * ctx;
+
+    configASSERT( lDomain   == SOCKETS_AF_INET     );
+    configASSERT( lType     == SOCKETS_SOCK_STREAM );
+    configASSERT( lProtocol == SOCKETS_IPPROTO_TCP );
+
+    if( lDomain           != SOCKETS_AF_INET     ||
+        lType             != SOCKETS_SOCK_STREAM ||
+        lProtocol         != SOCKETS_IPPROTO_TCP )
+    {
+        return SOCKETS_INVALID_SOCKET;
+    }
+
+    taskENTER_CRITICAL();
+
+    if( sockets_allocated <= 0 )
+    {
+        taskEXIT_CRITICAL();
+        return SOCKETS_INVALID_SOCKET;
+    }
+
+    sockets_allocated--;
+
+    taskEXIT_CRITICAL();
+
+    ctx = ( ss_ctx_t * ) pvPortMalloc ( sizeof ( *ctx ) );
+
+    if( ctx )
+    {
+        memset( ctx, 0, sizeof ( *ctx ) );
+
+        ctx->rx_timeout = pdMS_TO_TICKS( socketsconfigDEFAULT_RECV_TIMEOUT );
+        ctx->tx_timeout = pdMS_TO_TICKS( socketsconfigDEFAULT_SEND_TIMEOUT );
+        ctx->ip_socket  = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+
+        if( ctx->ip_socket >= 0 )
+        {
+            ( void ) fcntl( ctx->ip_socket, F_SETFD, FD_CLOEXEC );
+
+            /* Blocking calls wait in FreeRTOS, not in the host. */
+            if( 0 == prvSetNonBlocking( ctx->ip_socket, true ) )
+            {
+                return ( Socket_t ) ctx;
+            }
+
+            close( ctx->ip_socket );
+        }
+
+        vPortFree( ctx );
+    }
+
+    taskENTER_CRITICAL();
+    sockets_allocated++;
+    taskEXIT_CRITICAL();
+
+    return ( Socket_t ) SOCKETS_INVALID_SOCKET;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_Connect( Socket_t xSocket,
+                         SocketsSockaddr_t * pxAddress,
+                         Socklen_t xAddressLength )
+{
+    ss_ctx_t * ctx;
+
+    ( void ) xAddressLength;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    if( pxAddress == NULL )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    // support only SOCKETS_AF_INET for now
+    pxAddress->ucSocketDomain = SOCKETS_AF_INET;
+
+    ctx = ( ss_ctx_t * )xSocket;
+
+    if( 0 <= ctx->ip_socket )
+    {
+        int32_t lStatus;
+
+        /* The steps SOCKETS_ConnectAsync() takes in the background, taken
+         * here as soon as the socket is ready for each. */
+        lStatus = prvConnectStart( ctx, pxAddress );
+
+        while( SOCKETS_EWOULDBLOCK == lStatus )
+        {
+            if( pdFALSE == prvConnectWait( ctx ) )
+            {
+                configPRINTF(("Connect timed out\n"));
+                lStatus = SOCKETS_SOCKET_ERROR;
+            }
+            else
+            {
+                lStatus = prvConnectStep( ctx );
+            }
+        }
+
+        return prvConnectEnd( ctx, lStatus );
+    }
+    else
+    {
+        configPRINTF(("Invalid ip socket\n"));
+    }
+
+    return SOCKETS_SOCKET_ERROR;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_ConnectAsync( Socket_t xSocket,
+                              SocketsSockaddr_t * pxAddress,
+                              Socklen_t xAddressLength,
+                              SocketsConnectCallback_t pxCallback,
+                              void * pvCallbackContext )
+{
+    ss_ctx_t * ctx;
+    int32_t    lStatus;
+
+    ( void ) xAddressLength;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket || NULL == pxAddress || NULL == pxCallback )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    // support only SOCKETS_AF_INET for now
+    pxAddress->ucSocketDomain = SOCKETS_AF_INET;
+
+    ctx = ( ss_ctx_t * )xSocket;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ( ctx->status & SS_STATUS_CONNECTED ) || SS_CONNECT_IDLE != ctx->connect_state )
+    {
+        return SOCKETS_EISCONN;
+    }
+
+    prvRxLock();
+
+    lStatus = prvRxSelectStart();
+
+    if( SOCKETS_ERROR_NONE == lStatus )
+    {
+        lStatus = prvConnectStart( ctx, pxAddress );
+    }
+
+    if( SOCKETS_EWOULDBLOCK == lStatus )
+    {
+        /* The receive task takes it from here. */
+        if( NULL == ctx->rx_callback )
+        {
+            prvRxSelectLink( ctx );
+        }
+
+        ctx->connect_callback = pxCallback;
+        ctx->connect_context  = pvCallbackContext;
+
+        lStatus = SOCKETS_ERROR_NONE;
+    }
+    else
+    {
+        ( void ) prvConnectEnd( ctx, lStatus );
+    }
+
+    prvRxUnlock();
+
+    return lStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_Recv( Socket_t xSocket,
+                      void * pvBuffer,
+                      size_t xBufferLength,
+                      uint32_t ulFlags )
+{
+    ss_ctx_t * ctx = ( ss_ctx_t * )xSocket;
+    int32_t    ret;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ( ctx->status & SS_STATUS_CONNECTED ) != SS_STATUS_CONNECTED )
+    {
+        return SOCKETS_ENOTCONN;
+    }
+
+    if( NULL == pvBuffer || 0 == xBufferLength )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    ctx->recv_flag = ulFlags;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ctx->enforce_tls )
+    {
+        /* Receive through TLS pipe, if negotiated. */
+        ret = TLS_Recv( ctx->tls_ctx, pvBuffer, xBufferLength );
+    }
+    else
+    {
+        ret = prvNetworkRecv( ( void * ) ctx, pvBuffer, xBufferLength );
+    }
+
+    /* Only after the read, or the data just read would call back again. */
+    prvRxSelectArm( ctx );
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_Send( Socket_t xSocket,
+                      const void * pvBuffer,
+                      size_t xDataLength,
+                      uint32_t ulFlags )
+{
+    ss_ctx_t * ctx;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( NULL == pvBuffer || 0 == xDataLength )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    ctx            = ( ss_ctx_t * )xSocket;
+    ctx->send_flag = ulFlags;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    if( ctx->enforce_tls )
+    {
+        /* Send through TLS pipe, if negotiated. */
+        return TLS_Send( ctx->tls_ctx, pvBuffer, xDataLength );
+    }
+    else
+    {
+        return prvNetworkSend( ( void * ) ctx, pvBuffer, xDataLength );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_Shutdown( Socket_t xSocket,
+                          uint32_t ulHow )
+{
+    ss_ctx_t  * ctx;
+    int         ret;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    ctx            = ( ss_ctx_t * )xSocket;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    /* SOCKETS_SHUTDOWN_* take the POSIX values. */
+    ret = shutdown( ctx->ip_socket, (int) ulHow );
+    if( 0 > ret )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_Close( Socket_t xSocket )
+{
+    ss_ctx_t * ctx;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    ctx = ( ss_ctx_t * )xSocket;
+
+    /* Make sure the receive and connect callbacks are done with the socket.
+     * If a connect step is running on it, the receive task frees it once
+     * the step is over. */
+    if( prvRxSelectRemove( ctx ) )
+    {
+        prvSocketFree( ctx );
+    }
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
+                            int32_t lLevel,
+                            int32_t lOptionName,
+                            const void * pvOptionValue,
+                            size_t xOptionLength )
+{
+    ss_ctx_t * ctx;
+    int        ret;
+    char ** ppcAlpnIn = ( char ** ) pvOptionValue;
+    size_t xLength = 0;
+    uint32_t ulProtocol;
+
+    ( void ) lLevel;
+
+    if( SOCKETS_INVALID_SOCKET == xSocket )
+    {
+        return SOCKETS_EINVAL;
+    }
+
+    ctx            = ( ss_ctx_t * )xSocket;
+
+    if( 0 > ctx->ip_socket )
+    {
+        return SOCKETS_SOCKET_ERROR;
+    }
+
+    switch( lOptionName )
+    {
+        case SOCKETS_SO_RCVTIMEO:
+        case SOCKETS_SO_SNDTIMEO:
+        {
+            TickType_t ticks;
+
+            ticks = *( ( const TickType_t * ) pvOptionValue );
+
+            /* The receive timeout also bounds each step of a connect. */
+            if( lOptionName == SOCKETS_SO_RCVTIMEO )
+            {
+                ctx->rx_timeout = ticks;
+            }
+            else
+            {
+                ctx->tx_timeout = ticks;
+            }
+
+            break;
+        }
+
+        case SOCKETS_SO_NONBLOCK:
+        {
+            if( ( ctx->status & SS_STATUS_CONNECTED ) != SS_STATUS_CONNECTED )
+            {
+                return SOCKETS_ENOTCONN;
+            }
+
+            ctx->nonblocking = true;
+
+            break;
+        }
+
+        case SOCKETS_SO_REQUIRE_TLS:
+        {
+            if( ctx->status & SS_STATUS_CONNECTED )
+            {
+                return SOCKETS_EISCONN;
+            }
+
+            ctx->enforce_tls = true;
+            break;
+        }
+
+        case SOCKETS_SO_TRUSTED_SERVER_CERTIFICATE:
+        {
+            if( ctx->status & SS_STATUS_CONNECTED )
+            {
+                return SOCKETS_EISCONN;
+            }
+
+            if( NULL == pvOptionValue || 0 == xOptionLength )
+            {
+                return SOCKETS_EINVAL;
+            }
+
+            if( ctx->server_cert )
+            {
+                vPortFree( ctx->server_cert );
+            }
+
+            ctx->server_cert = pvPortMalloc ( xOptionLength+1 );
+
+            if( NULL == ctx->server_cert )
+            {
+                return SOCKETS_ENOMEM;
+            }
+            memset(ctx->server_cert, 0, xOptionLength+1);
+            memcpy( ctx->server_cert, pvOptionValue, xOptionLength );
+            ctx->server_cert_len = xOptionLength;
+
+            break;
+        }
+
+        case SOCKETS_SO_SERVER_NAME_INDICATION:
+        {
+            if( ctx->status & SS_STATUS_CONNECTED )
+            {
+                return SOCKETS_EISCONN;
+            }
+
+            if( NULL == pvOptionValue || 0 == xOptionLength )
+            {
+                return SOCKETS_EINVAL;
+            }
+
+            if( ctx->destination )
+            {
+                vPortFree( ctx->destination );
+            }
+
+            ctx->destination = pvPortMalloc ( xOptionLength + 1 );
+
+            if( NULL == ctx->destination )
+            {
+                return SOCKETS_ENOMEM;
+            }
+
+            memcpy( ctx->destination, pvOptionValue, xOptionLength );
+            ctx->destination[ xOptionLength ] = '\0';
+
+            break;
+        }
+
+        case SOCKETS_SO_WAKEUP_CALLBACK:
+        {
+            if( xOptionLength == sizeof( void * ) &&
+                pvOptionValue != NULL )
+            {
+                ret = prvRxSelectSet( ctx, pvOptionValue );
+
+                if( SOCKETS_ERROR_NONE != ret )
+                {
+                    return ret;
+                }
+            }
+            else
+            {
+                prvRxSelectClear( ctx );
+            }
+
+            break;
+        }
+
+        case SOCKETS_SO_ALPN_PROTOCOLS:
+        {
+            /* Do not set the ALPN option if the socket is already connected. */
+            if( ctx->status & SS_STATUS_CONNECTED )
+            {
+                return SOCKETS_EISCONN;
+            }
+
+
+            /* Allocate a sufficiently long array of pointers. */
+            ctx->ulAlpnProtocolsCount = 1 + xOptionLength;
+
+            if( NULL == ( ctx->ppcAlpnProtocols =
+                              ( char ** ) pvPortMalloc( ctx->ulAlpnProtocolsCount * sizeof( char * ) ) ) )
+            {
+                return SOCKETS_ENOMEM;
+            }
+            else
+            {
+                memset( ctx->ppcAlpnProtocols, 0, ctx->ulAlpnProtocolsCount * sizeof( char * ) );
+            }
+
+            /* Copy each protocol string. */
+            for( ulProtocol = 0; ( ulProtocol < ctx->ulAlpnProtocolsCount - 1 ) ; ulProtocol++ )
+            {
+                xLength = strlen( ppcAlpnIn[ ulProtocol ] );
+
+                if( NULL == ( ctx->ppcAlpnProtocols[ ulProtocol ] =
+                                  ( char * ) pvPortMalloc( 1 + xLength ) ) )
+                {
+                    return SOCKETS_ENOMEM;
+                }
+                else
+                {
+                    memcpy( ctx->ppcAlpnProtocols[ ulProtocol ],
+                            ppcAlpnIn[ ulProtocol ],
+                            xLength );
+                    ctx->ppcAlpnProtocols[ ulProtocol ][ xLength ] = '\0';
+                }
+            }
+
+            break;
+        }
+        default:
+            return SOCKETS_ENOPROTOOPT;
+    }
+
+    return SOCKETS_ERROR_NONE;
+}
+
+/*-----------------------------------------------------------*/
+
+uint32_t SOCKETS_GetHostByName( const char * pcHostName )
+{
+    struct addrinfo     hints;
+    struct addrinfo *   res  = NULL;
+    uint32_t            addr = 0;
+
+    if( strlen( pcHostName ) > ( size_t ) securesocketsMAX_DNS_NAME_LENGTH )
+    {
+        configPRINTF( ( "Host name (%s) too long!", pcHostName ) );
+        return 0;
+    }
+
+    memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    /* No other task runs while the host resolver may hold its locks, as one
+     * that blocked on them would keep the holder from running. */
+    vTaskSuspendAll();
+
+    if( 0 == getaddrinfo( pcHostName, NULL, &hints, &res ) )
+    {
+        if( NULL != res )
+        {
+            addr = ( ( struct sockaddr_in * ) res->ai_addr )->sin_addr.s_addr;
+        }
+
+        freeaddrinfo( res );
+    }
+
+    ( void ) xTaskResumeAll();
+
+    taskENTER_CRITICAL();
+    dns_stats.ulMisses++;
+    taskEXIT_CRITICAL();
+
+    return addr;
+}
+
+/*-----------------------------------------------------------*/
+
+void SOCKETS_GetDnsCacheStats( SocketsDnsCacheStats_t * pxStats )
+{
+    if( NULL == pxStats )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *pxStats = dns_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t SOCKETS_Init( void )
+{
+    return prvRxInit();
+}
+
+/*-----------------------------------------------------------*/
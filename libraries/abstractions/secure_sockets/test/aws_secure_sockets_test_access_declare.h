@@ -0,0 +1,49 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_secure_sockets_test_access_declare.h
+ * @brief Function wrappers that access private members of the secure sockets
+ * ports, for the ports that provide them.
+ */
+
+#ifndef _AWS_SECURE_SOCKETS_TEST_ACCESS_DECLARE_H_
+#define _AWS_SECURE_SOCKETS_TEST_ACCESS_DECLARE_H_
+
+/*
+ * Moves the answer cached for a host name back in time, so that its TTL runs
+ * out lMsLeft milliseconds from now, or ran out -lMsLeft milliseconds ago.
+ * Returns pdFALSE if no address is cached for the name.
+ */
+BaseType_t TEST_SOCKETS_DnsCacheAge( const char * pcHostName,
+                                     int32_t lMsLeft );
+
+/*
+ * Returns for how long past its TTL a cached address is still served, in
+ * milliseconds.
+ */
+uint32_t TEST_SOCKETS_DnsCacheStaleMs( void );
+
+#endif /* ifndef _AWS_SECURE_SOCKETS_TEST_ACCESS_DECLARE_H_ */
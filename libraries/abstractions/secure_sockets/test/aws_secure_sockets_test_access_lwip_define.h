@@ -0,0 +1,94 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_secure_sockets_test_access_lwip_define.h
+ * @brief Function wrappers that access private members of the lwIP port of
+ * the secure sockets.
+ *
+ * Needed for testing the host name cache without waiting for TTL's to run out.
+ */
+
+#ifndef _AWS_SECURE_SOCKETS_TEST_ACCESS_LWIP_DEFINE_H_
+#define _AWS_SECURE_SOCKETS_TEST_ACCESS_LWIP_DEFINE_H_
+
+#include "aws_secure_sockets_test_access_declare.h"
+
+/*-----------------------------------------------------------*/
+
+BaseType_t TEST_SOCKETS_DnsCacheAge( const char * pcHostName,
+                                     int32_t lMsLeft )
+{
+    BaseType_t      xResult = pdFALSE;
+    dns_entry_t *   entry;
+    TickType_t      now;
+
+    if( NULL == xDnsCacheMutex )
+    {
+        return pdFALSE;
+    }
+
+    ( void ) xSemaphoreTake( xDnsCacheMutex, portMAX_DELAY );
+
+    now   = xTaskGetTickCount();
+    entry = prvDnsFind( pcHostName );
+
+    if( ( NULL != entry ) && ( 0 != entry->address ) )
+    {
+        if( lMsLeft >= 0 )
+        {
+            entry->answered = now - entry->ttl + pdMS_TO_TICKS( ( uint32_t ) lMsLeft );
+        }
+        else
+        {
+            entry->answered = now - entry->ttl - pdMS_TO_TICKS( ( uint32_t ) -lMsLeft );
+        }
+
+        /* Forget the refreshes planned for the old age. */
+        entry->refresh    = entry->pinned;
+        entry->refresh_at = entry->answered + entry->ttl;
+        entry->backoff    = 0;
+
+        if( entry->pinned )
+        {
+            prvDnsPrefetchWake();
+        }
+
+        xResult = pdTRUE;
+    }
+
+    ( void ) xSemaphoreGive( xDnsCacheMutex );
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t TEST_SOCKETS_DnsCacheStaleMs( void )
+{
+    return ( uint32_t ) socketsconfigDNS_CACHE_STALE_S * 1000UL;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* ifndef _AWS_SECURE_SOCKETS_TEST_ACCESS_LWIP_DEFINE_H_ */
@@ -115,6 +115,22 @@ static void prvEchoClientTxTask( void * pvParameters );
     #define tcptestTCP_ECHO_TASKS_PRIORITY      ( tskIDLE_PRIORITY )
 #endif
 
+/* Set tcptestDNS_CACHE to 1 in aws_test_tcp_config.h when the port caches host
+ * names, as the lwIP port does, to test the cache through the test hooks of the
+ * port. */
+#ifndef tcptestDNS_CACHE
+    #define tcptestDNS_CACHE    0
+#endif
+
+#if ( tcptestDNS_CACHE == 1 )
+    #include "aws_secure_sockets_test_access_declare.h"
+
+/* TTL left to a cached answer when it is looked up near the end of its TTL. */
+    #define tcptestDNS_TTL_LEFT_MS         ( 100 )
+/* Time given to the port to resolve a host name again in the background. */
+    #define tcptestDNS_PREFETCH_WAIT_MS    ( 10000 )
+#endif
+
 /* The queue used by prvEchoClientTxTask() to send the next socket to use to
  * prvEchoClientRxTask(). */
 static volatile QueueHandle_t xSocketPassingQueue = NULL;
@@ -786,6 +802,8 @@ TEST_GROUP_RUNNER( Full_TCP )
     RUN_TEST_CASE( Full_TCP, AFQP_SOCKETS_Recv_Invalid );
     RUN_TEST_CASE( Full_TCP, AFQP_SOCKETS_htons_HappyCase );
     RUN_TEST_CASE( Full_TCP, AFQP_SOCKETS_inet_addr_quick_HappyCase );
+    RUN_TEST_CASE( Full_TCP, AFQP_SOCKETS_WakeupCallback );
+    RUN_TEST_CASE( Full_TCP, AFQP_SOCKETS_GetHostByName_Repeat );
 
     #if ( tcptestSECURE_SERVER == 1 )
         RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_CloseInvalidParams );
@@ -813,6 +831,8 @@ TEST_GROUP_RUNNER( Full_TCP )
         RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_NonBlockingConnect );
         RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_TwoSecureConnections );
         RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_SetSecureOptionsAfterConnect );
+        RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_WakeupCallback );
+        RUN_TEST_CASE( Full_TCP, AFQP_SECURE_SOCKETS_ConnectAsync );
     #endif /* if ( tcptestSECURE_SERVER == 1 ) */
 
     /* Thread safety tests */
@@ -1345,7 +1365,7 @@ static void prvSOCKETS_Shutdown( Server_t xConn )
         xResult = SOCKETS_Recv( xSocket, &ucBuf, 1, 0 );
     } while( xResult >= 0 );
 
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
 
     xResult = prvCloseHelper( xSocket, &xSocketOpen );
     TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
@@ -1368,7 +1388,7 @@ static void prvSOCKETS_Shutdown( Server_t xConn )
      *  xResult = SOCKETS_Send( xSocket, &ucBuf, 1, 0 );
      * }
      * while( xResult >= 0 );
-     * TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+     * TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
      */
 
     xResult = prvCloseHelper( xSocket, &xSocketOpen );
@@ -1388,7 +1408,7 @@ static void prvSOCKETS_Shutdown( Server_t xConn )
         xResult = SOCKETS_Recv( xSocket, &ucBuf, 1, 0 );
     } while( xResult >= 0 );
 
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
 
     xResult = prvCloseHelper( xSocket, &xSocketOpen );
     TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
@@ -1433,9 +1453,9 @@ static void prvTestSOCKETS_Close( Server_t xConn )
 
     /* Closed socket should not connect, send or receive */
     xResult = SOCKETS_Send( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
     xResult = SOCKETS_Recv( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
 
     /* Close a connected socket */
     xResult = prvConnectHelperWithRetry( &xSocket, xConn, xReceiveTimeOut, xSendTimeOut, &xSocketOpen );
@@ -1449,9 +1469,9 @@ static void prvTestSOCKETS_Close( Server_t xConn )
 
     /* Closed socket should not connect, send or receive */
     xResult = SOCKETS_Send( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
     xResult = SOCKETS_Recv( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
 
     /* Close a shutdown socket */
     xResult = prvConnectHelperWithRetry( &xSocket, xConn, xReceiveTimeOut, xSendTimeOut, &xSocketOpen );
@@ -1468,9 +1488,9 @@ static void prvTestSOCKETS_Close( Server_t xConn )
 
     /* Closed socket should not connect, send or receive */
     xResult = SOCKETS_Send( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
     xResult = SOCKETS_Recv( xSocket, &ucBuf, 1, 0 );
-    TEST_ASSERT_LESS_THAN_UINT32( 0, xResult );
+    TEST_ASSERT_LESS_THAN_INT32( 0, xResult );
 
     tcptestPRINTF( ( "%s passed\r\n", __FUNCTION__ ) );
 }
@@ -2982,6 +3002,390 @@ TEST( Full_TCP, AFQP_SECURE_SOCKETS_SetSecureOptionsAfterConnect )
     TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
 }
 
+/*-----------------------------------------------------------*/
+
+/* The test task, woken by the wakeup callback. */
+static TaskHandle_t xWakeupTask;
+
+/* Sockets under test, and the tick at which each last called back. */
+static volatile Socket_t xWakeupSockets[ 2 ];
+static volatile TickType_t xWakeupTicks[ 2 ];
+
+static void prvWakeupCallback( Socket_t xCallbackSocket )
+{
+    uint32_t ulIndex;
+
+    for( ulIndex = 0; ulIndex < 2; ulIndex++ )
+    {
+        if( xWakeupSockets[ ulIndex ] == xCallbackSocket )
+        {
+            xWakeupTicks[ ulIndex ] = xTaskGetTickCount();
+        }
+    }
+
+    xTaskNotifyGive( xWakeupTask );
+}
+
+/* Reports the heap taken by a receive callback and the time from sending to
+ * the echo server to the callback for the echo, then checks that a socket
+ * whose callback has been cleared no longer calls back. */
+static void prvSOCKETS_WakeupCallback( Server_t xConn )
+{
+    BaseType_t xResult;
+    uint32_t ulRound;
+    size_t xHeapBefore;
+    size_t xHeapFirst;
+    size_t xHeapSecond;
+    TickType_t xSent;
+    TickType_t xLatency;
+    TickType_t xLatencyMax = 0;
+    TickType_t xLatencyTotal = 0;
+    volatile Socket_t xSecondSocket = SOCKETS_INVALID_SOCKET;
+    volatile BaseType_t xSecondSocketOpen = pdFALSE;
+    uint8_t * pucTxBuffer = ( uint8_t * ) pcTxBuffer;
+    uint8_t * pucRxBuffer = ( uint8_t * ) pcRxBuffer;
+    const uint32_t ulRounds = 10;
+    const size_t xMessageLength = 8;
+
+    if( TEST_PROTECT() )
+    {
+        xWakeupTask = xTaskGetCurrentTaskHandle();
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+        xResult = prvConnectHelperWithRetry( &xSocket, xConn, xReceiveTimeOut, xSendTimeOut, &xSocketOpen );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to connect" );
+        xResult = prvConnectHelperWithRetry( &xSecondSocket, xConn, xReceiveTimeOut, xSendTimeOut, &xSecondSocketOpen );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to connect second socket" );
+
+        xWakeupSockets[ 0 ] = xSocket;
+        xWakeupSockets[ 1 ] = xSecondSocket;
+
+        xHeapBefore = xPortGetFreeHeapSize();
+        xResult = SOCKETS_SetSockOpt( xSocket,
+                                      0,
+                                      SOCKETS_SO_WAKEUP_CALLBACK,
+                                      ( void * ) prvWakeupCallback,
+                                      sizeof( void * ) );
+
+        if( SOCKETS_ENOPROTOOPT == xResult )
+        {
+            TEST_IGNORE_MESSAGE( "SOCKETS_SO_WAKEUP_CALLBACK is not supported." );
+        }
+
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to set wakeup callback" );
+        xHeapFirst = xPortGetFreeHeapSize();
+
+        xResult = SOCKETS_SetSockOpt( xSecondSocket,
+                                      0,
+                                      SOCKETS_SO_WAKEUP_CALLBACK,
+                                      ( void * ) prvWakeupCallback,
+                                      sizeof( void * ) );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to set second wakeup callback" );
+        xHeapSecond = xPortGetFreeHeapSize();
+
+        configPRINTF( ( "Wakeup callback heap: first socket %u bytes, second socket %u bytes\r\n",
+                        ( unsigned ) ( xHeapBefore - xHeapFirst ),
+                        ( unsigned ) ( xHeapFirst - xHeapSecond ) ) );
+
+        /* Each echo calls back once; reading it arms the callback again. */
+        for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+        {
+            prvCreateTxData( ( char * ) pucTxBuffer, xMessageLength, ulRound );
+            xWakeupTicks[ 0 ] = 0;
+            xSent = xTaskGetTickCount();
+
+            xResult = prvSendHelper( xSocket, pucTxBuffer, xMessageLength );
+            TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data failed to send" );
+
+            TEST_ASSERT_NOT_EQUAL_MESSAGE( 0, ulTaskNotifyTake( pdTRUE, xEchoTestRxTxTimeOut ), "No wakeup callback for the echo" );
+            TEST_ASSERT_NOT_EQUAL_MESSAGE( 0, xWakeupTicks[ 0 ], "Wakeup callback for the wrong socket" );
+
+            xLatency = xWakeupTicks[ 0 ] - xSent;
+            xLatencyTotal += xLatency;
+
+            if( xLatency > xLatencyMax )
+            {
+                xLatencyMax = xLatency;
+            }
+
+            memset( pucRxBuffer, tcptestRX_BUFFER_FILLER, tcptestBUFFER_SIZE );
+            xResult = prvRecvHelper( xSocket, pucRxBuffer, xMessageLength );
+            TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data was not received" );
+            xResult = prvCheckRxTxBuffers( pucTxBuffer, pucRxBuffer, xMessageLength );
+            TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Received data does not match" );
+        }
+
+        configPRINTF( ( "Wakeup callback after echo: average %u ms, worst %u ms\r\n",
+                        ( unsigned ) ( xLatencyTotal * portTICK_PERIOD_MS / ulRounds ),
+                        ( unsigned ) ( xLatencyMax * portTICK_PERIOD_MS ) ) );
+
+        /* Once cleared, the second socket must stay quiet. */
+        xResult = SOCKETS_SetSockOpt( xSecondSocket, 0, SOCKETS_SO_WAKEUP_CALLBACK, NULL, 0 );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to clear wakeup callback" );
+        xWakeupTicks[ 1 ] = 0;
+
+        prvCreateTxData( ( char * ) pucTxBuffer, xMessageLength, ulRounds );
+        xResult = prvSendHelper( xSecondSocket, pucTxBuffer, xMessageLength );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data failed to send" );
+        xResult = prvRecvHelper( xSecondSocket, pucRxBuffer, xMessageLength );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data was not received" );
+
+        vTaskDelay( tcptestLOOP_DELAY );
+        TEST_ASSERT_EQUAL_MESSAGE( 0, xWakeupTicks[ 1 ], "Wakeup callback after it was cleared" );
+    }
+
+    if( xSecondSocketOpen == pdTRUE )
+    {
+        xResult = prvCloseHelper( xSecondSocket, &xSecondSocketOpen );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
+    }
+
+    if( xSocketOpen == pdTRUE )
+    {
+        xResult = prvCloseHelper( xSocket, &xSocketOpen );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
+    }
+}
+
+TEST( Full_TCP, AFQP_SOCKETS_WakeupCallback )
+{
+    tcptestPRINTF( ( "Starting %s.\r\n", __FUNCTION__ ) );
+
+    prvSOCKETS_WakeupCallback( eNonsecure );
+}
+
+TEST( Full_TCP, AFQP_SECURE_SOCKETS_WakeupCallback )
+{
+    tcptestPRINTF( ( "Starting %s.\r\n", __FUNCTION__ ) );
+
+    prvSOCKETS_WakeupCallback( eSecure );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The test task, woken by the connect callback, and what it was passed. */
+static TaskHandle_t xConnectTask;
+static volatile int32_t lConnectStatus;
+static void * volatile pvConnectContext;
+
+static void prvConnectCallback( Socket_t xConnectSocket,
+                                int32_t lStatus,
+                                void * pvContext )
+{
+    ( void ) xConnectSocket;
+
+    lConnectStatus = lStatus;
+    pvConnectContext = pvContext;
+
+    xTaskNotifyGive( xConnectTask );
+}
+
+/* Starts a secure connection in the background, reports how long the caller
+ * was held and how long the connection took, then echoes over it. */
+TEST( Full_TCP, AFQP_SECURE_SOCKETS_ConnectAsync )
+{
+    BaseType_t xResult;
+    SocketsSockaddr_t xEchoServerAddress;
+    TickType_t xStart;
+    TickType_t xReturned;
+    TickType_t xConnected;
+    uint32_t ulCallerLoops = 0;
+    uint8_t * pucTxBuffer = ( uint8_t * ) pcTxBuffer;
+    uint8_t * pucRxBuffer = ( uint8_t * ) pcRxBuffer;
+    const size_t xMessageLength = 8;
+
+    tcptestPRINTF( ( "Starting %s.\r\n", __FUNCTION__ ) );
+
+    if( TEST_PROTECT() )
+    {
+        xConnectTask = xTaskGetCurrentTaskHandle();
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+        lConnectStatus = SOCKETS_SOCKET_ERROR;
+        pvConnectContext = NULL;
+
+        xSocket = prvTcpSocketHelper( &xSocketOpen );
+        TEST_ASSERT_NOT_EQUAL_MESSAGE( SOCKETS_INVALID_SOCKET, xSocket, "Socket creation failed" );
+
+        xResult = prvSetSockOptHelper( xSocket, xReceiveTimeOut, xSendTimeOut );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to set timeouts" );
+        xResult = prvSecureConnectHelper( xSocket, &xEchoServerAddress );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to set secure options" );
+
+        xStart = xTaskGetTickCount();
+        xResult = SOCKETS_ConnectAsync( xSocket,
+                                        &xEchoServerAddress,
+                                        sizeof( xEchoServerAddress ),
+                                        prvConnectCallback,
+                                        &xEchoServerAddress );
+        xReturned = xTaskGetTickCount();
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Failed to start connecting" );
+
+        /* The caller keeps running while the handshake proceeds. */
+        while( 0 == ulTaskNotifyTake( pdTRUE, 1 ) )
+        {
+            ulCallerLoops++;
+            TEST_ASSERT_LESS_THAN_UINT32_MESSAGE( 4 * xReceiveTimeOut,
+                                                  xTaskGetTickCount() - xStart,
+                                                  "No connect callback" );
+        }
+
+        xConnected = xTaskGetTickCount();
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, lConnectStatus, "Failed to connect" );
+        TEST_ASSERT_EQUAL_PTR_MESSAGE( &xEchoServerAddress, pvConnectContext, "Wrong callback context" );
+
+        configPRINTF( ( "Async connect: returned after %u ms, connected after %u ms, caller ran %u times\r\n",
+                        ( unsigned ) ( ( xReturned - xStart ) * portTICK_PERIOD_MS ),
+                        ( unsigned ) ( ( xConnected - xStart ) * portTICK_PERIOD_MS ),
+                        ( unsigned ) ulCallerLoops ) );
+
+        prvCreateTxData( ( char * ) pucTxBuffer, xMessageLength, 0 );
+        xResult = prvSendHelper( xSocket, pucTxBuffer, xMessageLength );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data failed to send" );
+
+        memset( pucRxBuffer, tcptestRX_BUFFER_FILLER, tcptestBUFFER_SIZE );
+        xResult = prvRecvHelper( xSocket, pucRxBuffer, xMessageLength );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Data was not received" );
+        xResult = prvCheckRxTxBuffers( pucTxBuffer, pucRxBuffer, xMessageLength );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( pdPASS, xResult, "Received data does not match" );
+    }
+
+    if( xSocketOpen == pdTRUE )
+    {
+        xResult = prvCloseHelper( xSocket, &xSocketOpen );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket failed to close" );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( tcptestDNS_CACHE == 1 )
+
+/* Waits until the port has resolved a host name in the background since
+ * pxBefore was taken. */
+static void prvDnsWaitForPrefetch( const SocketsDnsCacheStats_t * pxBefore )
+{
+    SocketsDnsCacheStats_t xStats;
+    TickType_t xStart = xTaskGetTickCount();
+
+    do
+    {
+        vTaskDelay( pdMS_TO_TICKS( 100 ) );
+        SOCKETS_GetDnsCacheStats( &xStats );
+    } while( ( xStats.ulPrefetches == pxBefore->ulPrefetches ) &&
+             ( ( xTaskGetTickCount() - xStart ) < pdMS_TO_TICKS( tcptestDNS_PREFETCH_WAIT_MS ) ) );
+
+    TEST_ASSERT_NOT_EQUAL_MESSAGE( pxBefore->ulPrefetches, xStats.ulPrefetches,
+                                   "The host name was not resolved again in the background." );
+}
+
+/* Looks the host name up once more, and returns how the look up was counted
+ * in pxBefore and pxAfter. */
+static uint32_t prvDnsCountedLookUp( SocketsDnsCacheStats_t * pxBefore,
+                                     SocketsDnsCacheStats_t * pxAfter )
+{
+    uint32_t ulAddress;
+
+    SOCKETS_GetDnsCacheStats( pxBefore );
+    ulAddress = SOCKETS_GetHostByName( tcptestDNS_HOST_NAME );
+    SOCKETS_GetDnsCacheStats( pxAfter );
+
+    TEST_ASSERT_NOT_EQUAL_MESSAGE( 0, ulAddress, "DNS look up failed." );
+
+    return ulAddress;
+}
+
+/* Ages the answer cached for the host name, whose address is ulAddress, and
+ * checks that it is resolved again near the end of its TTL, served stale past
+ * its TTL, and resolved at once when too old to be served. */
+static void prvDnsCacheAging( uint32_t ulAddress )
+{
+    SocketsDnsCacheStats_t xBefore;
+    SocketsDnsCacheStats_t xAfter;
+
+    /* Near the end of its TTL, the answer is served and resolved again in
+     * the background, so that it is still fresh once the TTL has run out. */
+    TEST_ASSERT_TRUE( TEST_SOCKETS_DnsCacheAge( tcptestDNS_HOST_NAME, tcptestDNS_TTL_LEFT_MS ) );
+    TEST_ASSERT_EQUAL_UINT32( ulAddress, prvDnsCountedLookUp( &xBefore, &xAfter ) );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulHits + 1, xAfter.ulHits, "A fresh answer was not served." );
+    prvDnsWaitForPrefetch( &xBefore );
+    ( void ) prvDnsCountedLookUp( &xBefore, &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulHits + 1, xAfter.ulHits, "The answer was not refreshed before its TTL ran out." );
+
+    /* Past its TTL, the answer is served stale while it is resolved again. */
+    TEST_ASSERT_TRUE( TEST_SOCKETS_DnsCacheAge( tcptestDNS_HOST_NAME, -1000 ) );
+    ( void ) prvDnsCountedLookUp( &xBefore, &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulStaleHits + 1, xAfter.ulStaleHits, "An expired answer was not served stale." );
+    prvDnsWaitForPrefetch( &xBefore );
+    ( void ) prvDnsCountedLookUp( &xBefore, &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulHits + 1, xAfter.ulHits, "A stale answer was not refreshed." );
+
+    /* Too long past its TTL, the name is resolved before it is answered. */
+    TEST_ASSERT_TRUE( TEST_SOCKETS_DnsCacheAge( tcptestDNS_HOST_NAME,
+                                                -( int32_t ) ( TEST_SOCKETS_DnsCacheStaleMs() + 1000u ) ) );
+    ( void ) prvDnsCountedLookUp( &xBefore, &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulMisses + 1, xAfter.ulMisses, "An answer too old was served." );
+    ( void ) prvDnsCountedLookUp( &xBefore, &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBefore.ulHits + 1, xAfter.ulHits, "The new answer was not cached." );
+}
+
+#endif /* if ( tcptestDNS_CACHE == 1 ) */
+
+/* Resolves a host name twice, and reports how long each look up took and how
+ * the port answered them. A port that caches host names must answer the second
+ * look up from its cache, and is then checked for how it ages the answer; any
+ * other port must count both look ups as misses. */
+TEST( Full_TCP, AFQP_SOCKETS_GetHostByName_Repeat )
+{
+    uint32_t ulAddress;
+    TickType_t xStart;
+    TickType_t xFirst;
+    TickType_t xSecond;
+    SocketsDnsCacheStats_t xBefore;
+    SocketsDnsCacheStats_t xBetween;
+    SocketsDnsCacheStats_t xAfter;
+
+    tcptestPRINTF( ( "Starting %s.\r\n", __FUNCTION__ ) );
+
+    SOCKETS_GetDnsCacheStats( &xBefore );
+
+    xStart = xTaskGetTickCount();
+    ulAddress = SOCKETS_GetHostByName( tcptestDNS_HOST_NAME );
+    xFirst = xTaskGetTickCount() - xStart;
+    TEST_ASSERT_NOT_EQUAL_MESSAGE( 0, ulAddress, "DNS look up failed." );
+
+    SOCKETS_GetDnsCacheStats( &xBetween );
+
+    xStart = xTaskGetTickCount();
+    ulAddress = SOCKETS_GetHostByName( tcptestDNS_HOST_NAME );
+    xSecond = xTaskGetTickCount() - xStart;
+    TEST_ASSERT_NOT_EQUAL_MESSAGE( 0, ulAddress, "Second DNS look up failed." );
+
+    SOCKETS_GetDnsCacheStats( &xAfter );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( 2,
+                                      ( xAfter.ulHits + xAfter.ulStaleHits + xAfter.ulMisses ) -
+                                      ( xBefore.ulHits + xBefore.ulStaleHits + xBefore.ulMisses ),
+                                      "Each look up must be counted once." );
+
+    #if ( tcptestDNS_CACHE == 1 )
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE( xBetween.ulHits + 1, xAfter.ulHits, "The second look up must hit the cache." );
+    #else
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE( 2, xAfter.ulMisses - xBefore.ulMisses, "Without a cache, each look up is a miss." );
+        ( void ) xBetween;
+    #endif
+
+    configPRINTF( ( "Host look ups: first %u ms, second %u ms; hits %u, stale %u, misses %u, prefetches %u\r\n",
+                    ( unsigned ) ( xFirst * portTICK_PERIOD_MS ),
+                    ( unsigned ) ( xSecond * portTICK_PERIOD_MS ),
+                    ( unsigned ) xAfter.ulHits,
+                    ( unsigned ) xAfter.ulStaleHits,
+                    ( unsigned ) xAfter.ulMisses,
+                    ( unsigned ) xAfter.ulPrefetches ) );
+
+    #if ( tcptestDNS_CACHE == 1 )
+        prvDnsCacheAging( ulAddress );
+    #endif
+}
+
 /* TODO: Investigate tests for loopback, other reserved IP addresses */
 /* TODO: Implement tests with a bad TCP connection (dropped packets, repeated packets, connection refused etc */
 /* TODO: Implement tests that have memory allocation errors (freertos heap is full) */
@@ -154,6 +154,8 @@ typedef uint32_t OTA_Err_t;
 #define kOTA_Err_UserAbort               0x28000000UL     /*!< User aborted the active OTA. */
 #define kOTA_Err_ResetNotSupported       0x29000000UL     /*!< We tried to reset the device but the device doesn't support it. */
 #define kOTA_Err_TopicTooLarge           0x2a000000UL     /*!< Attempt to build a topic string larger than the supplied buffer. */
+#define kOTA_Err_NoResumeState           0x2b000000UL     /*!< There is no saved transfer state matching the file being received. */
+#define kOTA_Err_BadDownloadUrl          0x2c000000UL     /*!< The file URL in the job document is not an http or https URL the agent can download from. */
 
 /**
  * @brief OTA Job callback events.
@@ -237,6 +239,12 @@ typedef struct
     uint8_t * pucCertFilepath;   /*!< Pathname of the certificate file used to validate the receive file. */
     uint32_t ulUpdaterVersion;   /*!< Used by OTA self-test detection, the version of FW that did the update. */
     bool_t xIsInSelfTest;        /*!< True if the job is in self test mode. */
+    uint32_t ulCompression;      /*!< Compression scheme of the file payload (see aws_ota_decompress.h). */
+    uint32_t ulImageSize;        /*!< Size of the image in the receive file once decompressed, zero if the same as ulFileSize. */
+    void * pvDecompressor;       /*!< Streaming decompressor state, only allocated for compressed files. */
+    uint32_t ulImageOffset;      /*!< Write frontier of the receive file (end of the highest byte written). */
+    uint8_t * pucUpdateUrl;      /*!< Pre-signed URL of the file when it is downloaded over HTTP(S) rather than MQTT. */
+    void * pvHttpClient;         /*!< HTTP range request client, only allocated for URL downloads. */
 } OTA_FileContext_t;
 
 
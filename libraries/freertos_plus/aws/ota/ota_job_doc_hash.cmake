@@ -0,0 +1,255 @@
+# -------------------------------------------------------------------------------------------------
+# Perfect hash of the OTA job document model keys
+# -------------------------------------------------------------------------------------------------
+# The OTA agent finds the model parameter of a JSON key with one FNV-1a hash and one string
+# compare, using the seed and slot table of src/aws_ota_job_doc_hash.h. This script reads the key
+# strings and the order of the model from src/aws_iot_ota_agent.c and generates that header. Keys
+# that are not string literals of the agent, like the signature key that each port defines, are
+# left out of the table and compared directly.
+#
+# The OTA module checks the header when it is configured. Regenerate it after changing the keys
+# or the model with:
+#
+#     cmake -P libraries/freertos_plus/aws/ota/ota_job_doc_hash.cmake
+
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    cmake_minimum_required(VERSION 3.13)
+endif()
+
+# Must match JSON_DOC_MODEL_HASH_SLOTS and OTA_HASH_PRIME of the agent.
+set(__ota_hash_slots 128)
+set(__ota_hash_prime 16777619)
+
+# The seeds tried, in order: the FNV-1a offset basis, then steps of the golden ratio.
+set(__ota_hash_basis 2166136261)
+set(__ota_hash_seed_step 2654435769)
+set(__ota_hash_max_seeds 65536)
+
+set(__ota_hash_dir "${CMAKE_CURRENT_LIST_DIR}")
+
+# Slot of a key, as prvHashModelKey() computes it.
+function(__ota_hash_key arg_seed arg_key arg_slot)
+    set(hash ${arg_seed})
+    string(HEX "${arg_key}" hex)
+    string(LENGTH "${hex}" length)
+    set(index 0)
+    while(index LESS length)
+        string(SUBSTRING "${hex}" ${index} 2 byte)
+        math(EXPR hash "((${hash} ^ 0x${byte}) * ${__ota_hash_prime}) & 0xFFFFFFFF")
+        math(EXPR index "${index} + 2")
+    endwhile()
+    math(EXPR hash "(${hash} ^ (${hash} >> 16)) & (${__ota_hash_slots} - 1)")
+    set(${arg_slot} ${hash} PARENT_SCOPE)
+endfunction()
+
+# Fixed width upper case hexadecimal.
+function(__ota_hash_hex arg_value arg_hex)
+    math(EXPR hex "${arg_value}" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING "${hex}" 2 -1 hex)
+    string(TOUPPER "${hex}" hex)
+    string(LENGTH "${hex}" length)
+    while(length LESS 8)
+        set(hex "0${hex}")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    set(${arg_hex} "0x${hex}" PARENT_SCOPE)
+endfunction()
+
+# Generate the content of the header from the source of the agent.
+function(__ota_hash_generate arg_agent arg_content)
+    file(READ "${arg_agent}" source)
+    string(REPLACE "\r" "" source "${source}")
+
+    # The key strings of the agent, directly or through a define.
+    string(REGEX MATCHALL "#define[ \t]+[A-Za-z0-9_]+[ \t]+\"[^\"\n]*\"" defines "${source}")
+    # A semicolon would split the matches of a list, so they end before it.
+    string(REGEX MATCHALL "static const char [A-Za-z0-9_]+\\[\\] = [^;\n]+" literals "${source}")
+    foreach(literal IN LISTS literals)
+        string(REGEX REPLACE "static const char ([A-Za-z0-9_]+)\\[\\] = (.+)" "\\1" name "${literal}")
+        string(REGEX REPLACE "static const char ([A-Za-z0-9_]+)\\[\\] = (.+)" "\\2" value "${literal}")
+        if(value MATCHES "^\"([^\"]*)\"$")
+            set(key_${name} "${CMAKE_MATCH_1}")
+        elseif(value MATCHES "^[A-Za-z0-9_]+$")
+            foreach(define IN LISTS defines)
+                if(define MATCHES "#define[ \t]+${value}[ \t]+\"([^\"]*)\"")
+                    set(key_${name} "${CMAKE_MATCH_1}")
+                endif()
+            endforeach()
+        endif()
+    endforeach()
+
+    # The parameters of the model, in order.
+    string(FIND "${source}" "xOTA_JobDocModelParamStructure[ OTA_NUM_JOB_PARAMS ] =" start)
+    if(start EQUAL -1)
+        message(FATAL_ERROR "${arg_agent}: xOTA_JobDocModelParamStructure not found.")
+    endif()
+    string(SUBSTRING "${source}" ${start} -1 model)
+    string(FIND "${model}" "\n    };" end)
+    string(SUBSTRING "${model}" 0 ${end} model)
+    string(REGEX MATCHALL "\n[ \t]*{[ \t]*[A-Za-z0-9_]+[ \t]*," entries "${model}")
+
+    set(names "")
+    set(keys "")
+    foreach(entry IN LISTS entries)
+        string(REGEX REPLACE "\n[ \t]*{[ \t]*([A-Za-z0-9_]+)[ \t]*," "\\1" name "${entry}")
+        list(APPEND names ${name})
+        if(DEFINED key_${name})
+            if("${key_${name}}" IN_LIST keys)
+                message(FATAL_ERROR "${arg_agent}: duplicate job document key \"${key_${name}}\".")
+            endif()
+            list(APPEND keys "${key_${name}}")
+        endif()
+    endforeach()
+    list(LENGTH names num_params)
+    if(num_params EQUAL 0 OR num_params GREATER 32)
+        message(FATAL_ERROR "${arg_agent}: the job document model has ${num_params} parameters.")
+    endif()
+
+    # The first seed that gives every hashed key its own slot.
+    set(attempt 0)
+    set(seed "")
+    while(attempt LESS __ota_hash_max_seeds AND seed STREQUAL "")
+        math(EXPR try "(${__ota_hash_basis} + ${attempt} * ${__ota_hash_seed_step}) & 0xFFFFFFFF")
+        set(seed ${try})
+        set(used "")
+        foreach(key IN LISTS keys)
+            __ota_hash_key(${try} "${key}" slot)
+            if(slot IN_LIST used)
+                set(seed "")
+                break()
+            endif()
+            list(APPEND used ${slot})
+        endforeach()
+        math(EXPR attempt "${attempt} + 1")
+    endwhile()
+    if(seed STREQUAL "")
+        message(FATAL_ERROR "${arg_agent}: no seed gives every job document key its own slot.")
+    endif()
+
+    # Fill the slots, and collect the parameters that are compared directly.
+    set(index 0)
+    set(unhashed 0)
+    set(unhashed_names "")
+    foreach(name IN LISTS names)
+        math(EXPR index_plus_one "${index} + 1")
+        if(DEFINED key_${name})
+            __ota_hash_key(${seed} "${key_${name}}" slot)
+            set(slot_${slot} ${index_plus_one})
+        else()
+            math(EXPR unhashed "${unhashed} | (1 << ${index})")
+            list(APPEND unhashed_names ${name})
+        endif()
+        set(index ${index_plus_one})
+    endforeach()
+
+    if(unhashed_names)
+        string(REPLACE ";" ", " unhashed_names "${unhashed_names}")
+    else()
+        set(unhashed_names "none")
+    endif()
+
+    set(rows "")
+    set(slot 0)
+    while(slot LESS __ota_hash_slots)
+        math(EXPR column "${slot} % 16")
+        if(column EQUAL 0)
+            if(NOT slot EQUAL 0)
+                string(APPEND rows ", \\\n")
+            endif()
+            string(APPEND rows "       ")
+        else()
+            string(APPEND rows ",")
+        endif()
+        if(NOT DEFINED slot_${slot})
+            set(slot_${slot} 0)
+        endif()
+        if(slot_${slot} LESS 10)
+            string(APPEND rows "  ${slot_${slot}}")
+        else()
+            string(APPEND rows " ${slot_${slot}}")
+        endif()
+        math(EXPR slot "${slot} + 1")
+    endwhile()
+
+    __ota_hash_hex(${seed} seed_hex)
+    __ota_hash_hex(${unhashed} unhashed_hex)
+
+    set(content [=[
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Generated from aws_iot_ota_agent.c by ota_job_doc_hash.cmake, do not edit. The
+ * OTA module fails to configure when this file does not match the agent. */
+
+#ifndef _AWS_OTA_JOB_DOC_HASH_H_
+#define _AWS_OTA_JOB_DOC_HASH_H_
+
+/* The number of parameters of the job document model. */
+#define OTA_JOB_DOC_HASH_NUM_PARAMS    @num_params@U
+
+/* The seed that gives every hashed key its own slot. */
+#define OTA_JOB_DOC_HASH_SEED          @seed_hex@UL
+
+/* The parameters compared directly: @unhashed_names@. */
+#define OTA_JOB_DOC_HASH_UNHASHED      @unhashed_hex@UL
+
+/* Model parameter index plus one of each slot, or zero. */
+#define OTA_JOB_DOC_HASH_SLOTS \
+    { \
+@rows@ \
+    }
+
+#endif /* ifndef _AWS_OTA_JOB_DOC_HASH_H_ */
+]=])
+    string(CONFIGURE "${content}" content @ONLY)
+    set(${arg_content} "${content}" PARENT_SCOPE)
+endfunction()
+
+# Fail the configuration if the header does not match the agent.
+function(afr_ota_check_job_doc_hash)
+    set(agent "${__ota_hash_dir}/src/aws_iot_ota_agent.c")
+    set(header "${__ota_hash_dir}/src/aws_ota_job_doc_hash.h")
+
+    # Check again whenever the agent changes.
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${agent}" "${header}")
+
+    __ota_hash_generate("${agent}" expected)
+    file(READ "${header}" current)
+    string(REPLACE "\r" "" current "${current}")
+
+    if(NOT current STREQUAL expected)
+        message(FATAL_ERROR
+            "${header} does not match the job document model of ${agent}. Regenerate it with:\n"
+            "    cmake -P ${__ota_hash_dir}/ota_job_doc_hash.cmake"
+        )
+    endif()
+endfunction()
+
+# Run as a script, regenerate the header. The sources of the agent have Windows line endings.
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    __ota_hash_generate("${__ota_hash_dir}/src/aws_iot_ota_agent.c" content)
+    string(REPLACE "\n" "\r\n" content "${content}")
+    file(WRITE "${__ota_hash_dir}/src/aws_ota_job_doc_hash.h" "${content}")
+endif()
@@ -37,12 +37,17 @@
 #include "event_groups.h"
 #include "aws_clientcredential.h"
 #include "aws_ota_cbor.h"
+#include "aws_ota_decompress.h"
+#include "aws_ota_http.h"
 #include "aws_application_version.h"
 #include "aws_ota_agent_config.h"
 
 /* Internal header file for shared definitions. */
 #include "aws_ota_agent_internal.h"
 
+/* Perfect hash of the job document model keys, generated by ota_job_doc_hash.cmake. */
+#include "aws_ota_job_doc_hash.h"
+
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"     /*lint !e537 intentional include of all interfaces used by this file. */
 #include "timers.h"       /*lint !e537 intentional include of all interfaces used by this file. */
@@ -100,6 +105,7 @@
 /* Job document parser constants. */
 
 #define OTA_MAX_JSON_TOKENS    64U                      /* Number of JSON tokens supported in a single parser call. */
+#define OTA_HASH_PRIME         16777619UL               /* FNV-1a prime, also used by ota_job_doc_hash.cmake. */
 #define OTA_MAX_TOPIC_LEN      256U                     /* Max length of a dynamically generated topic string (usually on the stack). */
 
 /* When subscribing to MQTT topics with a callback handler, we use the callback
@@ -129,13 +135,26 @@ typedef struct
     };                             /*lint !e658 Anonymous union is intentional as we use prefixes and don't need a union name. */
 } OTA_PubMsg_t;
 
+/* State shared with the HTTP body callback while a range of file blocks is downloaded. */
+typedef struct
+{
+    OTA_FileContext_t * C;       /* The file being received. */
+    IngestResult_t eResult;      /* Ingest result of the last block of the range. */
+    OTA_Err_t xCloseResult;      /* Close result or error detail of the last block. */
+} OTA_HttpBlockContext_t;
+
 
 /* The OTA job document contains parameters that are required for us to build the
  * stream request message and manage the OTA process. Including info like file name,
  * size, attributes, etc. The following value specifies the number of parameters
  * that are included in the job document model although some may be optional. */
 
-#define OTA_NUM_JOB_PARAMS         ( 16 ) /* Number of parameters in the job document. */
+#define OTA_NUM_JOB_PARAMS         ( 19 ) /* Number of parameters in the job document. */
+
+#if ( OTA_NUM_JOB_PARAMS != OTA_JOB_DOC_HASH_NUM_PARAMS )
+    #error "aws_ota_job_doc_hash.h does not match the job document model, regenerate it."
+#endif
+
 /* We need the following string to match in a couple places in the code so use a #define. */
 #define OTA_JSON_UPDATED_BY_KEY    "updatedBy"
 
@@ -154,6 +173,9 @@ static const char pcOTA_JSON_FileSizeKey[] = "filesize";
 static const char pcOTA_JSON_FileIDKey[] = "fileid";
 static const char pcOTA_JSON_FileAttributeKey[] = "attr";
 static const char pcOTA_JSON_FileCertNameKey[] = "certfile";
+static const char pcOTA_JSON_FileCompressionKey[] = "compression";
+static const char pcOTA_JSON_FileImageSizeKey[] = "imagesize";
+static const char pcOTA_JSON_FileURLKey[] = "url";
 
 enum
 {
@@ -235,7 +257,9 @@ typedef enum
     eOTA_JobParseErr_ZeroFileSize,        /* Job document specified a zero sized file. This is not allowed. */
     eOTA_JobParseErr_NonConformingJobDoc, /* The job document failed to fulfill the model requirements. */
     eOTA_JobParseErr_BadModelInitParams,  /* There was an invalid initialization parameter used in the document model. */
-    eOTA_JobParseErr_NoContextAvailable   /* There wasn't an OTA context available. */
+    eOTA_JobParseErr_NoContextAvailable,  /* There wasn't an OTA context available. */
+    eOTA_JobParseErr_UnsupportedCompression, /* The job document specified a compression scheme we don't support. */
+    eOTA_JobParseErr_ZeroImageSize           /* A compressed file without the size of the decompressed image. */
 } OTA_JobParseErr_t;
 
 
@@ -333,6 +357,24 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                                           uint32_t ulMsgSize,
                                           OTA_Err_t * pxCloseResult );
 
+/* Validate a file block and write it to the receive file. */
+
+static IngestResult_t prvProcessDataBlock( OTA_FileContext_t * C,
+                                           uint32_t ulBlockIndex,
+                                           uint32_t ulBlockSize,
+                                           uint8_t * pucPayload,
+                                           OTA_Err_t * pxCloseResult );
+
+/* Save the transfer state of the file so the download can continue after a reset. */
+
+static void prvSaveResumeState( OTA_FileContext_t * C,
+                                uint32_t ulBitmapLen );
+
+/* Continue an interrupted transfer of the file if a matching transfer state was saved. */
+
+static OTA_Err_t prvResumeFileForRx( OTA_FileContext_t * C,
+                                     uint32_t ulBitmapLen );
+
 /* Called when the OTA agent receives an OTA version message. */
 
 static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
@@ -373,6 +415,16 @@ static void prvUpdateJobStatus( OTA_FileContext_t * C,
 
 static OTA_Err_t prvPublishGetStreamMessage( OTA_FileContext_t * C );
 
+/* Prepare the HTTP client used to download a file that has a URL in the job document. */
+
+static bool_t prvInitHttpDownload( OTA_FileContext_t * C );
+
+/* Download the next run of missing file blocks with a single HTTP range request. */
+
+static OTA_Err_t prvRequestFileBlocksHttp( OTA_FileContext_t * C,
+                                           IngestResult_t * pxResult,
+                                           OTA_Err_t * pxCloseResult );
+
 /* Internal function to set the image state including an optional reason code. */
 
 static OTA_Err_t prvSetImageStateWithReason( OTA_ImageState_t eState,
@@ -386,6 +438,18 @@ static void prvDefaultOTACompleteCallback( OTA_JobEvent_t eEvent );
 
 static void prvAgentShutdownCleanup( void );
 
+/* Stop the transfer of the current file after a negative ingest result. */
+
+static void prvFinishFileTransfer( OTA_FileContext_t * C,
+                                   IngestResult_t xResult,
+                                   OTA_Err_t xCloseResult );
+
+/* Hash a JSON key into a slot of the document model hash. */
+
+static uint32_t prvHashModelKey( uint32_t ulSeed,
+                                 const char * pcKey,
+                                 uint32_t ulKeyLen );
+
 /* Search the document model for a key that matches the specified JSON key. */
 
 static DocParseErr_t prvSearchModelForTokenKey( JSON_DocModel_t * pxDocModel,
@@ -400,7 +464,8 @@ static DocParseErr_t prvInitDocModel( JSON_DocModel_t * pxDocModel,
                                       const JSON_DocParam_t * pxBodyDef,
                                       uint32_t ulContextBaseAddr,
                                       uint32_t ulContextSize,
-                                      uint16_t usNumJobParams );
+                                      uint16_t usNumJobParams,
+                                      const JSON_DocModelHash_t * pxKeyHash );
 
 /* Attempt to force reset the device. Normally called by the agent when a self test rejects the update. */
 
@@ -981,6 +1046,12 @@ static OTA_Err_t prvSetImageStateWithReason( OTA_ImageState_t eState,
 
         xOTA_Agent.eImageState = eState;
 
+        if( ( eState == eOTA_ImageState_Aborted ) || ( eState == eOTA_ImageState_Rejected ) )
+        {
+            /* A failed job is never resumed. */
+            ( void ) prvPAL_ClearTransferState();
+        }
+
         if( xOTA_Agent.pcOTA_Singleton_ActiveJobName != NULL )
         {
             if( eState == eOTA_ImageState_Testing )
@@ -1295,6 +1366,170 @@ static OTA_Err_t prvPublishGetStreamMessage( OTA_FileContext_t * C )
     return xErr;
 }
 
+/* Prepare the HTTP client used to download a file that has a URL in the job document. */
+
+static bool_t prvInitHttpDownload( OTA_FileContext_t * C )
+{
+    DEFINE_OTA_METHOD_NAME( "prvInitHttpDownload" );
+
+    bool_t xResult = pdFALSE;
+    OTA_Err_t xErr = kOTA_Err_BadDownloadUrl;
+
+    C->pvHttpClient = pvPortMalloc( sizeof( OTA_HttpClient_t ) );
+
+    if( C->pvHttpClient == NULL )
+    {
+        xErr = kOTA_Err_OutOfMemory;
+    }
+    else if( OTA_HTTP_Init( ( OTA_HttpClient_t * ) C->pvHttpClient, ( const char * ) C->pucUpdateUrl ) == eOTA_HTTP_Ok )
+    {
+        OTA_LOG_L1( "[%s] Downloading file %u over HTTP.\r\n", OTA_METHOD_NAME, C->ulServerFileID );
+        xResult = pdTRUE;
+    }
+    else
+    {
+        vPortFree( C->pvHttpClient );
+        C->pvHttpClient = NULL;
+    }
+
+    if( xResult == pdFALSE )
+    {
+        OTA_LOG_L1( "[%s] Can't download from the file URL (0x%08x).\r\n", OTA_METHOD_NAME, xErr );
+        ( void ) prvSetImageStateWithReason( eOTA_ImageState_Aborted, xErr );
+    }
+
+    return xResult;
+}
+
+
+/* Called by the HTTP client for every file block of a range response. */
+
+static BaseType_t prvHttpBlockCallback( void * pvContext,
+                                        uint32_t ulOffset,
+                                        uint8_t * pucData,
+                                        uint32_t ulSize )
+{
+    OTA_HttpBlockContext_t * pxBlockContext = ( OTA_HttpBlockContext_t * ) pvContext; /*lint !e9079 The context is always our block context. */
+    OTA_FileContext_t * C = pxBlockContext->C;
+    BaseType_t xContinue = pdFALSE;
+
+    pxBlockContext->xCloseResult = kOTA_Err_GenericIngestError; /* Default to a generic ingest function error until we prove success. */
+    pxBlockContext->eResult = prvProcessDataBlock( C,
+                                                   ulOffset >> otaconfigLOG2_FILE_BLOCK_SIZE,
+                                                   ulSize,
+                                                   pucData,
+                                                   &pxBlockContext->xCloseResult );
+
+    if( pxBlockContext->eResult >= eIngest_Result_Accepted_Continue )
+    {
+        /* Same as for a stream block: reset the momentum and update the job status as needed. */
+        C->ulRequestMomentum = 0;
+        prvUpdateJobStatus( C, eJobStatus_InProgress, ( int32_t ) eJobReason_Receiving, ( int32_t ) NULL );
+        xContinue = pdTRUE;
+    }
+
+    return xContinue;
+}
+
+
+/* Download the next run of missing file blocks with a single HTTP range request.
+ * Transfer errors count towards the request momentum like unanswered stream
+ * requests do. A negative *pxResult means the transfer must be finished. */
+
+static OTA_Err_t prvRequestFileBlocksHttp( OTA_FileContext_t * C,
+                                           IngestResult_t * pxResult,
+                                           OTA_Err_t * pxCloseResult )
+{
+    DEFINE_OTA_METHOD_NAME( "prvRequestFileBlocksHttp" );
+
+    OTA_Err_t xErr = kOTA_Err_None;
+    OTA_HttpBlockContext_t xBlockContext;
+    OTA_HttpResult_t eHttpResult = eOTA_HTTP_BadParams;
+    uint8_t * pucBlock;
+    uint32_t ulNumBlocks, ulFirst, ulCount, ulOffset, ulLength;
+
+    xBlockContext.C = C;
+    xBlockContext.eResult = eIngest_Result_Accepted_Continue;
+    xBlockContext.xCloseResult = kOTA_Err_None;
+
+    if( C->ulRequestMomentum < OTA_MAX_STREAM_REQUEST_MOMENTUM )
+    {
+        ulNumBlocks = ( C->ulFileSize + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE;
+
+        /* Find the first block we don't have and the run of missing blocks that follows it.
+         * A set bit in the bitmap means the block has not been received yet. */
+        for( ulFirst = 0U; ulFirst < ulNumBlocks; ulFirst++ )
+        {
+            if( ( C->pucRxBlockBitmap[ ulFirst >> LOG2_BITS_PER_BYTE ] & ( 1U << ( ulFirst % BITS_PER_BYTE ) ) ) != 0U )
+            {
+                break;
+            }
+        }
+
+        for( ulCount = 0U; ( ulCount < otaconfigHTTP_BLOCKS_PER_REQUEST ) && ( ( ulFirst + ulCount ) < ulNumBlocks ); ulCount++ )
+        {
+            if( ( C->pucRxBlockBitmap[ ( ulFirst + ulCount ) >> LOG2_BITS_PER_BYTE ] & ( 1U << ( ( ulFirst + ulCount ) % BITS_PER_BYTE ) ) ) == 0U )
+            {
+                break;
+            }
+        }
+
+        if( ulCount > 0U )
+        {
+            ulOffset = ulFirst << otaconfigLOG2_FILE_BLOCK_SIZE;
+            ulLength = ulCount << otaconfigLOG2_FILE_BLOCK_SIZE;
+
+            if( ulLength > ( C->ulFileSize - ulOffset ) )
+            {
+                ulLength = C->ulFileSize - ulOffset; /* The last block is short. */
+            }
+
+            /* Each request increases the momentum until a block is accepted. */
+            C->ulRequestMomentum++;
+            pucBlock = ( uint8_t * ) pvPortMalloc( OTA_FILE_BLOCK_SIZE ); /*lint !e9079 FreeRTOS malloc port returns void*. */
+
+            if( pucBlock != NULL )
+            {
+                OTA_LOG_L1( "[%s] Requesting blocks %u to %u.\r\n", OTA_METHOD_NAME, ulFirst, ( ulFirst + ulCount ) - 1U );
+                eHttpResult = OTA_HTTP_GetRange( ( OTA_HttpClient_t * ) C->pvHttpClient,
+                                                 ulOffset,
+                                                 ulLength,
+                                                 pucBlock,
+                                                 OTA_FILE_BLOCK_SIZE,
+                                                 prvHttpBlockCallback,
+                                                 &xBlockContext );
+                vPortFree( pucBlock );
+            }
+
+            if( ( eHttpResult == eOTA_HTTP_Ok ) || ( eHttpResult == eOTA_HTTP_BodyRejected ) )
+            {
+                if( ( xBlockContext.eResult >= eIngest_Result_Accepted_Continue ) && ( C->ulBlocksRemaining > 0U ) )
+                {
+                    /* Go straight on to the next range. Using the event keeps the agent
+                     * responsive to shutdown and abort requests between ranges. */
+                    ( void ) xEventGroupSetBits( xOTA_Agent.xOTA_EventFlags, OTA_EVT_MASK_REQ_TIMEOUT );
+                }
+            }
+            else
+            {
+                /* Don't return an error. Retry after the request wait and let max momentum catch it. */
+                OTA_LOG_L1( "[%s] HTTP range request failed (%d).\r\n", OTA_METHOD_NAME, ( int32_t ) eHttpResult );
+                prvStartRequestTimer( C );
+            }
+        }
+    }
+    else
+    {
+        /* Too many range requests in a row failed. Abort. Store attempt count in low bits. */
+        xErr = ( uint32_t ) kOTA_Err_MomentumAbort | ( OTA_MAX_STREAM_REQUEST_MOMENTUM & ( uint32_t ) kOTA_PAL_ErrMask );
+    }
+
+    *pxResult = xBlockContext.eResult;
+    *pxCloseResult = xBlockContext.xCloseResult;
+
+    return xErr;
+}
+
 /* This function is called whenever we receive a MQTT publish message on one of our OTA topics. */
 static void prvOTAPublishCallback( void * pvCallbackContext,
                                    IotMqttCallbackParam_t * const pxPublishData )
@@ -1361,6 +1596,58 @@ static void prvOTAPublishCallback( void * pvCallbackContext,
 
 /* NOTE: This implementation only supports 1 OTA context. Concurrent OTA is not supported. */
 
+/* Stop the transfer of the current file after a negative ingest result, which means the
+ * file is either complete or can't be received, and release its resources. */
+
+static void prvFinishFileTransfer( OTA_FileContext_t * C,
+                                   IngestResult_t xResult,
+                                   OTA_Err_t xCloseResult )
+{
+    DEFINE_OTA_METHOD_NAME( "prvFinishFileTransfer" );
+
+    OTA_Err_t xErr;
+
+    /* There is nothing left to resume. */
+    ( void ) prvPAL_ClearTransferState();
+
+    if( xResult == eIngest_Result_FileComplete )
+    {
+        /* File receive is complete and authenticated. Update the job status with the self_test ready identifier. */
+        prvUpdateJobStatus( C, eJobStatus_InProgress, ( int32_t ) eJobReason_SigCheckPassed, ( int32_t ) NULL );
+    }
+    else
+    {
+        OTA_LOG_L1( "[%s] Aborting due to IngestResult_t error %d\r\n", OTA_METHOD_NAME, ( int32_t ) xResult );
+        /* Call the platform specific code to reject the image. */
+        xErr = prvPAL_SetPlatformImageState( eOTA_ImageState_Rejected );
+
+        if( xErr != kOTA_Err_None )
+        {
+            OTA_LOG_L2( "[%s] Error trying to set platform image state (0x%08x)\r\n", OTA_METHOD_NAME, ( int32_t ) xErr );
+        }
+        else
+        {
+            /* Nothing special to do on success. */
+        }
+
+        prvUpdateJobStatus( C, eJobStatus_FailedWithVal, ( int32_t ) xCloseResult, ( int32_t ) xResult );
+    }
+
+    /* Release all remaining resources of the OTA file. The caller must not use the context after this. */
+    ( void ) prvOTA_Close( C );
+
+    /* Let main application know of our result. */
+    xOTA_Agent.pxOTAJobCompleteCallback( ( xResult == eIngest_Result_FileComplete ) ? eOTA_JobEvent_Activate : eOTA_JobEvent_Fail );
+
+    /* Free any remaining string memory holding the job name since this job is done. */
+    if( xOTA_Agent.pcOTA_Singleton_ActiveJobName != NULL )
+    {
+        vPortFree( xOTA_Agent.pcOTA_Singleton_ActiveJobName );
+        xOTA_Agent.pcOTA_Singleton_ActiveJobName = NULL;
+    }
+}
+
+
 static void prvOTAUpdateTask( void * pvUnused )
 {
     DEFINE_OTA_METHOD_NAME( "prvOTAUpdateTask" );
@@ -1422,7 +1709,23 @@ static void prvOTAUpdateTask( void * pvUnused )
                 {
                     if( C->ulBlocksRemaining > 0U )
                     {
-                        xErr = prvPublishGetStreamMessage( C );
+                        if( C->pvHttpClient != NULL )
+                        {
+                            OTA_Err_t xCloseResult;
+                            IngestResult_t xResult;
+
+                            xErr = prvRequestFileBlocksHttp( C, &xResult, &xCloseResult );
+
+                            if( ( xErr == kOTA_Err_None ) && ( xResult < eIngest_Result_Accepted_Continue ) )
+                            {
+                                prvFinishFileTransfer( C, xResult, xCloseResult );
+                                C = NULL;
+                            }
+                        }
+                        else
+                        {
+                            xErr = prvPublishGetStreamMessage( C );
+                        }
 
                         if( xErr != kOTA_Err_None )
                         {                               /* Abort the current OTA. */
@@ -1504,43 +1807,8 @@ static void prvOTAUpdateTask( void * pvUnused )
                                         /* Negative result codes mean we should stop the OTA process
                                          * because we are either done or in an unrecoverable error state.
                                          * We don't want to hang on to the resources. */
-
-                                        if( xResult == eIngest_Result_FileComplete )
-                                        {
-                                            /* File receive is complete and authenticated. Update the job status with the self_test ready identifier. */
-                                            prvUpdateJobStatus( C, eJobStatus_InProgress, ( int32_t ) eJobReason_SigCheckPassed, ( int32_t ) NULL );
-                                        }
-                                        else
-                                        {
-                                            OTA_LOG_L1( "[%s] Aborting due to IngestResult_t error %d\r\n", OTA_METHOD_NAME, ( int32_t ) xResult );
-                                            /* Call the platform specific code to reject the image. */
-                                            xErr = prvPAL_SetPlatformImageState( eOTA_ImageState_Rejected );
-
-                                            if( xErr != kOTA_Err_None )
-                                            {
-                                                OTA_LOG_L2( "[%s] Error trying to set platform image state (0x%08x)\r\n", OTA_METHOD_NAME, ( int32_t ) xErr );
-                                            }
-                                            else
-                                            {
-                                                /* Nothing special to do on success. */
-                                            }
-
-                                            prvUpdateJobStatus( C, eJobStatus_FailedWithVal, ( int32_t ) xCloseResult, ( int32_t ) xResult );
-                                        }
-
-                                        /* Release all remaining resources of the OTA file. */
-                                        ( void ) prvOTA_Close( C ); /* Ignore false result since we're setting the pointer to null on the next line. */
+                                        prvFinishFileTransfer( C, xResult, xCloseResult );
                                         C = NULL;
-
-                                        /* Let main application know of our result. */
-                                        xOTA_Agent.pxOTAJobCompleteCallback( ( xResult == eIngest_Result_FileComplete ) ? eOTA_JobEvent_Activate : eOTA_JobEvent_Fail );
-
-                                        /* Free any remaining string memory holding the job name since this job is done. */
-                                        if( xOTA_Agent.pcOTA_Singleton_ActiveJobName != NULL )
-                                        {
-                                            vPortFree( xOTA_Agent.pcOTA_Singleton_ActiveJobName );
-                                            xOTA_Agent.pcOTA_Singleton_ActiveJobName = NULL;
-                                        }
                                     }
                                     else
                                     { /* We're actively receiving a file so update the job status as needed. */
@@ -1759,10 +2027,21 @@ static bool_t prvOTA_Close( OTA_FileContext_t * const C )
             C->xRequestTimer = NULL;
         }
 
+        if( C->pvHttpClient != NULL )
+        {
+            OTA_HTTP_Close( ( OTA_HttpClient_t * ) C->pvHttpClient ); /* Close any kept alive download connection. */
+            vPortFree( C->pvHttpClient );
+            C->pvHttpClient = NULL;
+        }
+
         if( C->pucStreamName != NULL )
         {
-            ( void ) prvUnSubscribeFromDataStream( C ); /* Unsubscribe from the data stream if needed. */
-            vPortFree( C->pucStreamName );              /* Free any previously allocated stream name memory. */
+            if( C->pucUpdateUrl == NULL )
+            {
+                ( void ) prvUnSubscribeFromDataStream( C ); /* Unsubscribe from the data stream if needed. */
+            }
+
+            vPortFree( C->pucStreamName ); /* Free any previously allocated stream name memory. */
             C->pucStreamName = NULL;
         }
 
@@ -1796,6 +2075,18 @@ static bool_t prvOTA_Close( OTA_FileContext_t * const C )
             C->pucCertFilepath = NULL;
         }
 
+        if( C->pvDecompressor != NULL )
+        {
+            vPortFree( C->pvDecompressor ); /* Free the decompression window. */
+            C->pvDecompressor = NULL;
+        }
+
+        if( C->pucUpdateUrl != NULL )
+        {
+            vPortFree( C->pucUpdateUrl ); /* Free the download URL string memory. */
+            C->pucUpdateUrl = NULL;
+        }
+
         /* Abort any active file access and release the file resource, if needed. */
         ( void ) prvPAL_Abort( C );
         memset( C, 0, sizeof( OTA_FileContext_t ) ); /* Clear the entire structure now that it is free. */
@@ -1853,6 +2144,27 @@ bool_t JSON_IsCStringEqual( const char * pcJSONString,
 }
 
 
+/* Hash a JSON key with FNV-1a and fold the result into a slot of the model hash. */
+
+static uint32_t prvHashModelKey( uint32_t ulSeed,
+                                 const char * pcKey,
+                                 uint32_t ulKeyLen )
+{
+    uint32_t ulHash = ulSeed;
+    uint32_t ulIndex;
+
+    for( ulIndex = 0U; ulIndex < ulKeyLen; ulIndex++ )
+    {
+        ulHash ^= ( uint32_t ) ( uint8_t ) pcKey[ ulIndex ];
+        ulHash *= OTA_HASH_PRIME;
+    }
+
+    ulHash ^= ulHash >> 16;
+
+    return ulHash & ( JSON_DOC_MODEL_HASH_SLOTS - 1U );
+}
+
+
 /* Search our document model for a key match with the given token. */
 
 static DocParseErr_t prvSearchModelForTokenKey( JSON_DocModel_t * pxDocModel,
@@ -1861,27 +2173,62 @@ static DocParseErr_t prvSearchModelForTokenKey( JSON_DocModel_t * pxDocModel,
                                                 uint16_t * pulMatchingIndexResult )
 {
     DocParseErr_t eErr = eDocParseErr_ParamKeyNotInModel;
-    uint16_t usParamIndex;
+    const JSON_DocModelHash_t * pxKeyHash = pxDocModel->pxKeyHash;
+    uint16_t usParamIndex = pxDocModel->usNumModelParams;
+    uint32_t ulScanIndex;
+    uint8_t ucSlot;
 
-    for( usParamIndex = 0; usParamIndex < pxDocModel->usNumModelParams; usParamIndex++ )
+    if( pxKeyHash != NULL )
     {
-        if( JSON_IsCStringEqual( pcJSONString, ulStrLen,
-                                 pxDocModel->pxBodyDef[ usParamIndex ].pcSrcKey ) == ( bool_t ) pdTRUE )
+        /* The only hashed model key that can match is the one in the key's slot. */
+        ucSlot = pxKeyHash->ucSlots[ prvHashModelKey( pxKeyHash->ulSeed, pcJSONString, ulStrLen ) ];
+
+        if( ( ucSlot != 0U ) &&
+            ( JSON_IsCStringEqual( pcJSONString, ulStrLen,
+                                   pxDocModel->pxBodyDef[ ucSlot - 1U ].pcSrcKey ) == ( bool_t ) pdTRUE ) )
         {
-            /* Per Security, don't allow multiple entries of the same parameter. */
-            if( ( pxDocModel->ulParamsReceivedBitmap & ( 1U << usParamIndex ) ) != 0U ) /*lint !e9032 usParamIndex will never be greater than kDocModel_MaxParams, which is the the size of the bitmap. */
+            usParamIndex = ( uint16_t ) ( ucSlot - 1U );
+        }
+        else
+        {
+            /* Keys that are not known when the hash is generated are compared directly. */
+            for( ulScanIndex = 0U; ulScanIndex < pxDocModel->usNumModelParams; ulScanIndex++ )
             {
-                eErr = eDocParseErr_DuplicatesNotAllowed;
+                if( ( ( pxKeyHash->ulUnhashedBitmap & ( 1UL << ulScanIndex ) ) != 0U ) &&
+                    ( JSON_IsCStringEqual( pcJSONString, ulStrLen,
+                                           pxDocModel->pxBodyDef[ ulScanIndex ].pcSrcKey ) == ( bool_t ) pdTRUE ) )
+                {
+                    usParamIndex = ( uint16_t ) ulScanIndex;
+                    break;
+                }
             }
-            else
+        }
+    }
+    else
+    {
+        for( usParamIndex = 0; usParamIndex < pxDocModel->usNumModelParams; usParamIndex++ )
+        {
+            if( JSON_IsCStringEqual( pcJSONString, ulStrLen,
+                                     pxDocModel->pxBodyDef[ usParamIndex ].pcSrcKey ) == ( bool_t ) pdTRUE )
             {
-                /* Mark parameter as received in the bitmap. */
-                pxDocModel->ulParamsReceivedBitmap |= ( 1U << usParamIndex ); /*lint !e9032 usParamIndex will never be greater than kDocModel_MaxParams, which is the the size of the bitmap. */
-                *pulMatchingIndexResult = usParamIndex;                       /* Save result index for caller. */
-                eErr = eDocParseErr_None;                                     /* We found a matching key in the document model. */
+                break; /* We found a key match so stop searching. */
             }
+        }
+    }
 
-            break; /* We found a key match so stop searching. */
+    if( usParamIndex < pxDocModel->usNumModelParams )
+    {
+        /* Per Security, don't allow multiple entries of the same parameter. */
+        if( ( pxDocModel->ulParamsReceivedBitmap & ( 1U << usParamIndex ) ) != 0U ) /*lint !e9032 usParamIndex will never be greater than kDocModel_MaxParams, which is the the size of the bitmap. */
+        {
+            eErr = eDocParseErr_DuplicatesNotAllowed;
+        }
+        else
+        {
+            /* Mark parameter as received in the bitmap. */
+            pxDocModel->ulParamsReceivedBitmap |= ( 1U << usParamIndex ); /*lint !e9032 usParamIndex will never be greater than kDocModel_MaxParams, which is the the size of the bitmap. */
+            *pulMatchingIndexResult = usParamIndex;                       /* Save result index for caller. */
+            eErr = eDocParseErr_None;                                     /* We found a matching key in the document model. */
         }
     }
 
@@ -1900,7 +2247,9 @@ static DocParseErr_t prvParseJSONbyModel( const char * pcJSON,
 
     const JSON_DocParam_t * pxModelParam;
     jsmn_parser xParser;
-    jsmntok_t * pxTokens, * pxValTok;
+    jsmntok_t xTokens[ OTA_MAX_JSON_TOKENS ]; /* The document is tokenized in one pass into this fixed array. */
+    jsmntok_t * pxValTok;
+    int32_t lNumTokens;
     uint32_t ulNumTokens, ulTokenLen;
     MultiParmPtr_t xParamAddr; /*lint !e9018 We intentionally use this union to cast the parameter address to the proper type. */
     uint32_t ulIndex;
@@ -1937,268 +2286,251 @@ static DocParseErr_t prvParseJSONbyModel( const char * pcJSON,
     {
         pxModelParam = pxDocModel->pxBodyDef;
 
-        /* Count the total number of tokens in our JSON document. */
-        ulNumTokens = ( uint32_t ) jsmn_parse( &xParser, pcJSON, ( size_t ) ulMsgLen, NULL, 1UL );
+        /* Tokenize the JSON document in a single pass. */
+        lNumTokens = ( int32_t ) jsmn_parse( &xParser, pcJSON, ( size_t ) ulMsgLen, xTokens, OTA_MAX_JSON_TOKENS );
 
-        if( ulNumTokens > 0U )
+        if( lNumTokens == ( int32_t ) JSMN_ERROR_NOMEM )
         {
-            /* If the JSON document isn't too big for our token array... */
-            if( ulNumTokens <= OTA_MAX_JSON_TOKENS )
-            {
-                /* Allocate space for the document JSON tokens. */
-                void * pvTokenArray = pvPortMalloc( ulNumTokens * sizeof( jsmntok_t ) ); /* Allocate space on heap for temporary token array. */
-                pxTokens = ( jsmntok_t * ) pvTokenArray;                                 /*lint !e9079 !e9087 heap allocations return void* so we allow casting to a pointer to the actual type. */
+            OTA_LOG_L1( "[%s] Document has too many keys.\r\n", OTA_METHOD_NAME );
+            eErr = eDocParseErr_TooManyTokens;
+        }
+        else if( lNumTokens <= 0 )
+        {
+            OTA_LOG_L1( "[%s] Invalid JSON document. No tokens parsed. \r\n", OTA_METHOD_NAME );
+            eErr = eDocParseErr_NoTokens;
+        }
+        else
+        {
+            ulNumTokens = ( uint32_t ) lNumTokens;
 
-                if( pxTokens != NULL )
+            /* Start the parser in an error free state. */
+            eErr = eDocParseErr_None;
+
+            /* Examine each JSON token, searching for job parameters based on our document model. */
+            for( ulIndex = 0U; ( eErr == eDocParseErr_None ) && ( ulIndex < ulNumTokens ); ulIndex++ )
+            {
+                /* All parameter keys are JSON strings. */
+                if( xTokens[ ulIndex ].type == JSMN_STRING )
                 {
-                    /* Reset Jasmine again and tokenize the document for real. */
-                    jsmn_init( &xParser );
-                    ulIndex = ( uint32_t ) jsmn_parse( &xParser, pcJSON, ulMsgLen, pxTokens, ulNumTokens );
+                    /* Search the document model to see if it matches the current key. */
+                    ulTokenLen = ( uint32_t ) xTokens[ ulIndex ].end - ( uint32_t ) xTokens[ ulIndex ].start;
+                    eErr = prvSearchModelForTokenKey( pxDocModel, &pcJSON[ xTokens[ ulIndex ].start ], ulTokenLen, &usModelParamIndex );
+
+                    /* If we didn't find a match in the model, skip over it and its descendants. */
+                    if( eErr == eDocParseErr_ParamKeyNotInModel )
+                    {
+                        int32_t iRoot = ( int32_t ) ulIndex; /* Create temp root from the unrecognized tokens index. Use signed int since the parent index is signed. */
+                        ulIndex++;                           /* Skip the active key since it's the one we don't recognize. */
+
+                        /* Skip tokens whose parents are equal to or deeper than the unrecognized temporary root token level. */
+                        while( ( ulIndex < ulNumTokens ) && ( xTokens[ ulIndex ].parent >= iRoot ) )
+                        {
+                            ulIndex++; /* Skip over all descendants of the unknown parent. */
+                        }
 
-                    if( ulIndex == ulNumTokens )
+                        --ulIndex;                /* Adjust for outer for-loop increment. */
+                        eErr = eDocParseErr_None; /* Unknown key structures are simply skipped so clear the error state to continue. */
+                    }
+                    else if( eErr == eDocParseErr_None )
                     {
-                        /* Start the parser in an error free state. */
-                        eErr = eDocParseErr_None;
+                        /* We found the parameter key in the document model. */
 
-                        /* Examine each JSON token, searching for job parameters based on our document model. */
-                        for( ulIndex = 0U; ( eErr == eDocParseErr_None ) && ( ulIndex < ulNumTokens ); ulIndex++ )
+                        /* Get the value field (i.e. the following token) for the parameter. */
+                        pxValTok = &xTokens[ ulIndex + 1UL ];
+
+                        /* Verify the field type is what we expect for this parameter. */
+                        if( ( ulIndex + 1UL ) >= ulNumTokens )
+                        {
+                            OTA_LOG_L1( "[%s] parameter has no value [ %s ]\r\n", OTA_METHOD_NAME, pxModelParam[ usModelParamIndex ].pcSrcKey );
+                            eErr = eDocParseErr_MalformedDoc;
+                        }
+                        else if( pxValTok->type != pxModelParam[ usModelParamIndex ].eJasmineType )
+                        {
+                            ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
+                            OTA_LOG_L1( "[%s] parameter type mismatch [ %s : %.*s ] type %u, expected %u\r\n",
+                                        OTA_METHOD_NAME, pxModelParam[ usModelParamIndex ].pcSrcKey, ulTokenLen,
+                                        &pcJSON[ pxValTok->start ],
+                                        pxValTok->type, pxModelParam[ usModelParamIndex ].eJasmineType );
+                            eErr = eDocParseErr_FieldTypeMismatch;
+                            /* break; */
+                        }
+                        else if( OTA_DONT_STORE_PARAM == pxModelParam[ usModelParamIndex ].ulDestOffset )
+                        {
+                            /* Nothing to do with this parameter since we're not storing it. */
+                        }
+                        else
                         {
-                            /* All parameter keys are JSON strings. */
-                            if( pxTokens[ ulIndex ].type == JSMN_STRING )
+                            /* Get destination offset to parameter storage location. */
+
+                            /* If it's within the models context structure, add in the context instance base address. */
+                            if( pxModelParam[ usModelParamIndex ].ulDestOffset < pxDocModel->ulContextSize )
+                            {
+                                xParamAddr.ulVal = pxDocModel->ulContextBase + pxModelParam[ usModelParamIndex ].ulDestOffset;
+                            }
+                            else
                             {
-                                /* Search the document model to see if it matches the current key. */
-                                ulTokenLen = ( uint32_t ) pxTokens[ ulIndex ].end - ( uint32_t ) pxTokens[ ulIndex ].start;
-                                eErr = prvSearchModelForTokenKey( pxDocModel, &pcJSON[ pxTokens[ ulIndex ].start ], ulTokenLen, &usModelParamIndex );
+                                /* It's a raw pointer so keep it as is. */
+                                xParamAddr.ulVal = pxModelParam[ usModelParamIndex ].ulDestOffset;
+                            }
 
-                                /* If we didn't find a match in the model, skip over it and its descendants. */
-                                if( eErr == eDocParseErr_ParamKeyNotInModel )
-                                {
-                                    int32_t iRoot = ( int32_t ) ulIndex; /* Create temp root from the unrecognized tokens index. Use signed int since the parent index is signed. */
-                                    ulIndex++;                           /* Skip the active key since it's the one we don't recognize. */
+                            if( eModelParamType_StringCopy == pxModelParam[ usModelParamIndex ].xModelParamType )
+                            {
+                                /* Malloc memory for a copy of the value string plus a zero terminator. */
+                                ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
+                                void * pvStringCopy = pvPortMalloc( ulTokenLen + 1U );
 
-                                    /* Skip tokens whose parents are equal to or deeper than the unrecognized temporary root token level. */
-                                    while( ( ulIndex < ulNumTokens ) && ( pxTokens[ ulIndex ].parent >= iRoot ) )
-                                    {
-                                        ulIndex++; /* Skip over all descendants of the unknown parent. */
-                                    }
+                                if( pvStringCopy != NULL )
+                                {
+                                    *xParamAddr.ppvPtr = pvStringCopy;
+                                    char * pcStringCopy = *xParamAddr.ppcPtr;
+                                    /* Copy parameter string into newly allocated memory. */
+                                    memcpy( pcStringCopy, &pcJSON[ pxValTok->start ], ulTokenLen );
+                                    /* Zero terminate the new string. */
+                                    pcStringCopy[ ulTokenLen ] = '\0';
+                                    OTA_LOG_L1( "[%s] Extracted parameter [ %s: %s ]\r\n",
+                                                OTA_METHOD_NAME,
+                                                pxModelParam[ usModelParamIndex ].pcSrcKey,
+                                                pcStringCopy );
+                                }
+                                else
+                                { /* Stop processing on error. */
+                                    eErr = eDocParseErr_OutOfMemory;
+                                    /* break; */
+                                }
+                            }
+                            else if( eModelParamType_StringInDoc == pxModelParam[ usModelParamIndex ].xModelParamType )
+                            {
+                                /* Copy pointer to source string instead of duplicating the string. */
+                                const char * pcStringInDoc = &pcJSON[ pxValTok->start ];
 
-                                    --ulIndex;                /* Adjust for outer for-loop increment. */
-                                    eErr = eDocParseErr_None; /* Unknown key structures are simply skipped so clear the error state to continue. */
+                                if( pcStringInDoc != NULL ) /*lint !e774 This can result in NULL if offset rolls the address around. */
+                                {
+                                    *xParamAddr.ppccPtr = pcStringInDoc;
+                                    ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
+                                    OTA_LOG_L1( "[%s] Extracted parameter [ %s: %.*s ]\r\n",
+                                                OTA_METHOD_NAME,
+                                                pxModelParam[ usModelParamIndex ].pcSrcKey,
+                                                ulTokenLen, pcStringInDoc );
                                 }
-                                else if( eErr == eDocParseErr_None )
+                                else
                                 {
-                                    /* We found the parameter key in the document model. */
+                                    /* This should never happen unless there's a bug or memory is corrupted. */
+                                    OTA_LOG_L1( "[%s] Error! JSON token produced a null pointer for parameter [ %s ]\r\n",
+                                                OTA_METHOD_NAME,
+                                                pxModelParam[ usModelParamIndex ].pcSrcKey );
+                                    eErr = eDocParseErr_InvalidToken;
+                                }
+                            }
+                            else if( eModelParamType_UInt32 == pxModelParam[ usModelParamIndex ].xModelParamType )
+                            {
+                                char * pEnd;
+                                const char * pStart = &pcJSON[ pxValTok->start ];
+                                *xParamAddr.pulPtr = strtoul( pStart, &pEnd, 0 );
 
-                                    /* Get the value field (i.e. the following token) for the parameter. */
-                                    pxValTok = &pxTokens[ ulIndex + 1UL ];
+                                if( pEnd == &pcJSON[ pxValTok->end ] )
+                                {
+                                    OTA_LOG_L1( "[%s] Extracted parameter [ %s: %u ]\r\n",
+                                                OTA_METHOD_NAME,
+                                                pxModelParam[ usModelParamIndex ].pcSrcKey,
+                                                *xParamAddr.pulPtr );
+                                }
+                                else
+                                {
+                                    eErr = eDocParseErr_InvalidNumChar;
+                                }
+                            }
+                            else if( eModelParamType_SigBase64 == pxModelParam[ usModelParamIndex ].xModelParamType )
+                            {
+                                /* Allocate space for and decode the base64 signature. */
+                                void * pvSignature = pvPortMalloc( sizeof( Sig256_t ) );
 
-                                    /* Verify the field type is what we expect for this parameter. */
-                                    if( pxValTok->type != pxModelParam[ usModelParamIndex ].eJasmineType )
-                                    {
-                                        ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
-                                        OTA_LOG_L1( "[%s] parameter type mismatch [ %s : %.*s ] type %u, expected %u\r\n",
-                                                    OTA_METHOD_NAME, pxModelParam[ usModelParamIndex ].pcSrcKey, ulTokenLen,
-                                                    &pcJSON[ pxValTok->start ],
-                                                    pxValTok->type, pxModelParam[ usModelParamIndex ].eJasmineType );
-                                        eErr = eDocParseErr_FieldTypeMismatch;
+                                if( pvSignature != NULL )
+                                {
+                                    size_t xActualLen;
+                                    *xParamAddr.ppvPtr = pvSignature;
+                                    Sig256_t * pxSig256 = *xParamAddr.ppxSig256Ptr;
+                                    ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
+
+                                    if( mbedtls_base64_decode( pxSig256->ucData, sizeof( pxSig256->ucData ), &xActualLen,
+                                                               ( const uint8_t * ) &pcJSON[ pxValTok->start ], ulTokenLen ) != 0 )
+                                    { /* Stop processing on error. */
+                                        OTA_LOG_L1( "[%s] mbedtls_base64_decode failed.\r\n", OTA_METHOD_NAME );
+                                        eErr = eDocParseErr_Base64Decode;
                                         /* break; */
                                     }
-                                    else if( OTA_DONT_STORE_PARAM == pxModelParam[ usModelParamIndex ].ulDestOffset )
-                                    {
-                                        /* Nothing to do with this parameter since we're not storing it. */
-                                        continue;
-                                    }
                                     else
                                     {
-                                        /* Get destination offset to parameter storage location. */
-
-                                        /* If it's within the models context structure, add in the context instance base address. */
-                                        if( pxModelParam[ usModelParamIndex ].ulDestOffset < pxDocModel->ulContextSize )
-                                        {
-                                            xParamAddr.ulVal = pxDocModel->ulContextBase + pxModelParam[ usModelParamIndex ].ulDestOffset;
-                                        }
-                                        else
-                                        {
-                                            /* It's a raw pointer so keep it as is. */
-                                            xParamAddr.ulVal = pxModelParam[ usModelParamIndex ].ulDestOffset;
-                                        }
-
-                                        if( eModelParamType_StringCopy == pxModelParam[ usModelParamIndex ].xModelParamType )
-                                        {
-                                            /* Malloc memory for a copy of the value string plus a zero terminator. */
-                                            ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
-                                            void * pvStringCopy = pvPortMalloc( ulTokenLen + 1U );
-
-                                            if( pvStringCopy != NULL )
-                                            {
-                                                *xParamAddr.ppvPtr = pvStringCopy;
-                                                char * pcStringCopy = *xParamAddr.ppcPtr;
-                                                /* Copy parameter string into newly allocated memory. */
-                                                memcpy( pcStringCopy, &pcJSON[ pxValTok->start ], ulTokenLen );
-                                                /* Zero terminate the new string. */
-                                                pcStringCopy[ ulTokenLen ] = '\0';
-                                                OTA_LOG_L1( "[%s] Extracted parameter [ %s: %s ]\r\n",
-                                                            OTA_METHOD_NAME,
-                                                            pxModelParam[ usModelParamIndex ].pcSrcKey,
-                                                            pcStringCopy );
-                                            }
-                                            else
-                                            { /* Stop processing on error. */
-                                                eErr = eDocParseErr_OutOfMemory;
-                                                /* break; */
-                                            }
-                                        }
-                                        else if( eModelParamType_StringInDoc == pxModelParam[ usModelParamIndex ].xModelParamType )
-                                        {
-                                            /* Copy pointer to source string instead of duplicating the string. */
-                                            const char * pcStringInDoc = &pcJSON[ pxValTok->start ];
-
-                                            if( pcStringInDoc != NULL ) /*lint !e774 This can result in NULL if offset rolls the address around. */
-                                            {
-                                                *xParamAddr.ppccPtr = pcStringInDoc;
-                                                ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
-                                                OTA_LOG_L1( "[%s] Extracted parameter [ %s: %.*s ]\r\n",
-                                                            OTA_METHOD_NAME,
-                                                            pxModelParam[ usModelParamIndex ].pcSrcKey,
-                                                            ulTokenLen, pcStringInDoc );
-                                            }
-                                            else
-                                            {
-                                                /* This should never happen unless there's a bug or memory is corrupted. */
-                                                OTA_LOG_L1( "[%s] Error! JSON token produced a null pointer for parameter [ %s ]\r\n",
-                                                            OTA_METHOD_NAME,
-                                                            pxModelParam[ usModelParamIndex ].pcSrcKey );
-                                                eErr = eDocParseErr_InvalidToken;
-                                            }
-                                        }
-                                        else if( eModelParamType_UInt32 == pxModelParam[ usModelParamIndex ].xModelParamType )
-                                        {
-                                            char * pEnd;
-                                            const char * pStart = &pcJSON[ pxValTok->start ];
-                                            *xParamAddr.pulPtr = strtoul( pStart, &pEnd, 0 );
-
-                                            if( pEnd == &pcJSON[ pxValTok->end ] )
-                                            {
-                                                OTA_LOG_L1( "[%s] Extracted parameter [ %s: %u ]\r\n",
-                                                            OTA_METHOD_NAME,
-                                                            pxModelParam[ usModelParamIndex ].pcSrcKey,
-                                                            *xParamAddr.pulPtr );
-                                            }
-                                            else
-                                            {
-                                                eErr = eDocParseErr_InvalidNumChar;
-                                            }
-                                        }
-                                        else if( eModelParamType_SigBase64 == pxModelParam[ usModelParamIndex ].xModelParamType )
-                                        {
-                                            /* Allocate space for and decode the base64 signature. */
-                                            void * pvSignature = pvPortMalloc( sizeof( Sig256_t ) );
-
-                                            if( pvSignature != NULL )
-                                            {
-                                                size_t xActualLen;
-                                                *xParamAddr.ppvPtr = pvSignature;
-                                                Sig256_t * pxSig256 = *xParamAddr.ppxSig256Ptr;
-                                                ulTokenLen = ( uint32_t ) ( pxValTok->end ) - ( uint32_t ) ( pxValTok->start );
-
-                                                if( mbedtls_base64_decode( pxSig256->ucData, sizeof( pxSig256->ucData ), &xActualLen,
-                                                                           ( const uint8_t * ) &pcJSON[ pxValTok->start ], ulTokenLen ) != 0 )
-                                                { /* Stop processing on error. */
-                                                    OTA_LOG_L1( "[%s] mbedtls_base64_decode failed.\r\n", OTA_METHOD_NAME );
-                                                    eErr = eDocParseErr_Base64Decode;
-                                                    /* break; */
-                                                }
-                                                else
-                                                {
-                                                    pxSig256->usSize = ( uint16_t ) xActualLen;
-                                                    OTA_LOG_L1( "[%s] Extracted parameter [ %s: %.32s... ]\r\n",
-                                                                OTA_METHOD_NAME,
-                                                                pxModelParam[ usModelParamIndex ].pcSrcKey,
-                                                                &pcJSON[ pxValTok->start ] );
-                                                }
-                                            }
-                                            else
-                                            {
-                                                /* We failed to allocate needed memory. Everything will be freed below upon failure. */
-                                                eErr = eDocParseErr_OutOfMemory;
-                                            }
-                                        }
-                                        else if( eModelParamType_Ident == pxModelParam[ usModelParamIndex ].xModelParamType )
-                                        {
-                                            OTA_LOG_L1( "[%s] Identified parameter [ %s ]\r\n",
-                                                        OTA_METHOD_NAME,
-                                                        pxModelParam[ usModelParamIndex ].pcSrcKey );
-                                            *xParamAddr.pxBoolPtr = pdTRUE;
-                                        }
-                                        else
-                                        {
-                                            /* Ignore invalid document model type. */
-                                        }
+                                        pxSig256->usSize = ( uint16_t ) xActualLen;
+                                        OTA_LOG_L1( "[%s] Extracted parameter [ %s: %.32s... ]\r\n",
+                                                    OTA_METHOD_NAME,
+                                                    pxModelParam[ usModelParamIndex ].pcSrcKey,
+                                                    &pcJSON[ pxValTok->start ] );
                                     }
                                 }
                                 else
                                 {
-                                    /* Nothing special to do. The error will break us out of the loop. */
+                                    /* We failed to allocate needed memory. Everything will be freed below upon failure. */
+                                    eErr = eDocParseErr_OutOfMemory;
                                 }
                             }
-                            else
+                            else if( eModelParamType_Ident == pxModelParam[ usModelParamIndex ].xModelParamType )
                             {
-                                /* Ignore tokens that are not strings and move on to the next. */
+                                OTA_LOG_L1( "[%s] Identified parameter [ %s ]\r\n",
+                                            OTA_METHOD_NAME,
+                                            pxModelParam[ usModelParamIndex ].pcSrcKey );
+                                *xParamAddr.pxBoolPtr = pdTRUE;
                             }
-                        }
-
-                        /* Free the token memory. */
-                        vPortFree( pxTokens ); /*lint !e850 ulIndex is intentionally modified within the loop to skip over unknown tags. */
-
-                        if( eErr == eDocParseErr_None )
-                        {
-                            uint32_t ulMissingParams = ( pxDocModel->ulParamsReceivedBitmap & pxDocModel->ulParamsRequiredBitmap )
-                                                       ^ pxDocModel->ulParamsRequiredBitmap;
-
-                            if( ulMissingParams != 0U )
+                            else
                             {
-                                /* The job document did not have all required document model parameters. */
-                                for( ulScanIndex = 0UL; ulScanIndex < pxDocModel->usNumModelParams; ulScanIndex++ )
-                                {
-                                    if( ( ulMissingParams & ( 1UL << ulScanIndex ) ) != 0UL )
-                                    {
-                                        OTA_LOG_L1( "[%s] parameter not present: %s\r\n",
-                                                    OTA_METHOD_NAME,
-                                                    pxModelParam[ ulScanIndex ].pcSrcKey );
-                                    }
-                                }
-
-                                eErr = eDocParseErr_MalformedDoc;
+                                /* Ignore invalid document model type. */
                             }
                         }
-                        else
+
+                        /* A string or primitive value can't be a key so step over it. Object and
+                         * array values are walked since they hold the keys of nested parameters. */
+                        if( ( eErr == eDocParseErr_None ) &&
+                            ( ( pxValTok->type == JSMN_STRING ) || ( pxValTok->type == JSMN_PRIMITIVE ) ) )
                         {
-                            OTA_LOG_L1( "[%s] Error (%d) parsing JSON document.\r\n", OTA_METHOD_NAME, ( int32_t ) eErr );
+                            ulIndex++;
                         }
                     }
                     else
                     {
-                        OTA_LOG_L1( "[%s] jsmn_parse didn't match token count when parsing.\r\n", OTA_METHOD_NAME );
-                        eErr = eDocParseErr_JasmineCountMismatch;
+                        /* Nothing special to do. The error will break us out of the loop. */
                     }
                 }
                 else
                 {
-                    OTA_LOG_L1( "[%s] No memory for JSON tokens.\r\n", OTA_METHOD_NAME );
-                    eErr = eDocParseErr_OutOfMemory;
+                    /* Ignore tokens that are not strings and move on to the next. */
+                }
+            }
+
+            if( eErr == eDocParseErr_None )
+            {
+                uint32_t ulMissingParams = ( pxDocModel->ulParamsReceivedBitmap & pxDocModel->ulParamsRequiredBitmap )
+                                           ^ pxDocModel->ulParamsRequiredBitmap;
+
+                if( ulMissingParams != 0U )
+                {
+                    /* The job document did not have all required document model parameters. */
+                    for( ulScanIndex = 0UL; ulScanIndex < pxDocModel->usNumModelParams; ulScanIndex++ )
+                    {
+                        if( ( ulMissingParams & ( 1UL << ulScanIndex ) ) != 0UL )
+                        {
+                            OTA_LOG_L1( "[%s] parameter not present: %s\r\n",
+                                        OTA_METHOD_NAME,
+                                        pxModelParam[ ulScanIndex ].pcSrcKey );
+                        }
+                    }
+
+                    eErr = eDocParseErr_MalformedDoc;
                 }
             }
             else
             {
-                OTA_LOG_L1( "[%s] Document has too many keys.\r\n", OTA_METHOD_NAME );
-                eErr = eDocParseErr_TooManyTokens;
+                OTA_LOG_L1( "[%s] Error (%d) parsing JSON document.\r\n", OTA_METHOD_NAME, ( int32_t ) eErr );
             }
         }
-        else
-        {
-            OTA_LOG_L1( "[%s] Invalid JSON document. No tokens parsed. \r\n", OTA_METHOD_NAME );
-            eErr = eDocParseErr_NoTokens;
-        }
     }
 
     configASSERT( eErr != eDocParseErr_Unknown );
@@ -2213,7 +2545,8 @@ static DocParseErr_t prvInitDocModel( JSON_DocModel_t * pxDocModel,
                                       const JSON_DocParam_t * pxBodyDef,
                                       uint32_t ulContextBaseAddr,
                                       uint32_t ulContextSize,
-                                      uint16_t usNumJobParams )
+                                      uint16_t usNumJobParams,
+                                      const JSON_DocModelHash_t * pxKeyHash )
 {
     DEFINE_OTA_METHOD_NAME( "prvInitDocModel" );
 
@@ -2246,6 +2579,7 @@ static DocParseErr_t prvInitDocModel( JSON_DocModel_t * pxDocModel,
         pxDocModel->usNumModelParams = usNumJobParams;
         pxDocModel->ulParamsReceivedBitmap = 0;
         pxDocModel->ulParamsRequiredBitmap = 0;
+        pxDocModel->pxKeyHash = pxKeyHash;
 
         /* Scan the model and detect all required parameters (i.e. not optional). */
         for( ulScanIndex = 0; ulScanIndex < pxDocModel->usNumModelParams; ulScanIndex++ )
@@ -2294,6 +2628,17 @@ static OTA_FileContext_t * prvParseJobDoc( const char * pcJSON,
         { pcOTA_JSON_FileCertNameKey,  OTA_JOB_PARAM_REQUIRED, { OFFSET_OF( OTA_FileContext_t, pucCertFilepath )}, eModelParamType_StringCopy,  JSMN_STRING    },
         { cOTA_JSON_FileSignatureKey, OTA_JOB_PARAM_REQUIRED, { OFFSET_OF( OTA_FileContext_t, pxSignature )   }, eModelParamType_SigBase64,   JSMN_STRING    },
         { pcOTA_JSON_FileAttributeKey, OTA_JOB_PARAM_OPTIONAL, { OFFSET_OF( OTA_FileContext_t, ulFileAttributes )}, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { pcOTA_JSON_FileCompressionKey, OTA_JOB_PARAM_OPTIONAL, { OFFSET_OF( OTA_FileContext_t, ulCompression )}, eModelParamType_UInt32,    JSMN_PRIMITIVE },
+        { pcOTA_JSON_FileImageSizeKey, OTA_JOB_PARAM_OPTIONAL, { OFFSET_OF( OTA_FileContext_t, ulImageSize )   }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { pcOTA_JSON_FileURLKey,       OTA_JOB_PARAM_OPTIONAL, { OFFSET_OF( OTA_FileContext_t, pucUpdateUrl )  }, eModelParamType_StringCopy,  JSMN_STRING    },
+    };
+
+    /* Perfect hash of the job document model keys, generated from the model above. */
+    static const JSON_DocModelHash_t xOTA_JobDocModelHash =
+    {
+        OTA_JOB_DOC_HASH_SEED,
+        OTA_JOB_DOC_HASH_UNHASHED,
+        OTA_JOB_DOC_HASH_SLOTS
     };
 
     OTA_JobParseErr_t eErr = eOTA_JobParseErr_Unknown;
@@ -2315,7 +2660,8 @@ static OTA_FileContext_t * prvParseJobDoc( const char * pcJSON,
                              xOTA_JobDocModelParamStructure,
                              ( uint32_t ) C, /*lint !e9078 !e923 Intentionally casting context pointer to a value for prvInitDocModel. */
                              sizeof( OTA_FileContext_t ),
-                             OTA_NUM_JOB_PARAMS ) != eDocParseErr_None )
+                             OTA_NUM_JOB_PARAMS,
+                             &xOTA_JobDocModelHash ) != eDocParseErr_None )
         {
             eErr = eOTA_JobParseErr_BadModelInitParams;
         }
@@ -2323,11 +2669,27 @@ static OTA_FileContext_t * prvParseJobDoc( const char * pcJSON,
         { /* Validate the job document parameters. */
             eErr = eOTA_JobParseErr_None;
 
+            if( C->ulCompression == OTA_COMPRESSION_NONE )
+            {
+                C->ulImageSize = C->ulFileSize; /* The file is written as it is received. */
+            }
+
             if( C->ulFileSize == 0U )
             {
                 OTA_LOG_L1( "[%s] Zero file size is not allowed!\r\n", OTA_METHOD_NAME );
                 eErr = eOTA_JobParseErr_ZeroFileSize;
             }
+            else if( ( C->ulCompression != OTA_COMPRESSION_NONE ) && ( C->ulCompression != OTA_COMPRESSION_HEATSHRINK ) )
+            {
+                OTA_LOG_L1( "[%s] Unsupported compression scheme %u.\r\n", OTA_METHOD_NAME, C->ulCompression );
+                eErr = eOTA_JobParseErr_UnsupportedCompression;
+            }
+            else if( ( C->ulCompression != OTA_COMPRESSION_NONE ) && ( C->ulImageSize == 0U ) )
+            {
+                /* The decompressed size bounds what is written to the receive file, the PAL checks it fits. */
+                OTA_LOG_L1( "[%s] Compressed file without an image size.\r\n", OTA_METHOD_NAME );
+                eErr = eOTA_JobParseErr_ZeroImageSize;
+            }
             /* If there's an active job, verify that it's the same as what's being reported now. */
             /* We already checked for missing parameters so we SHOULD have a job name in the context. */
             else if( xOTA_Agent.pcOTA_Singleton_ActiveJobName != NULL )
@@ -2489,6 +2851,7 @@ static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
     uint32_t ulBitmapLen;              /* Length of the file block bitmap in bytes. */
     OTA_FileContext_t * pstUpdateFile; /* Pointer to an OTA update context. */
     OTA_Err_t xErr = kOTA_Err_Uninitialized;
+    bool_t xDataPlaneReady;            /* True once the file blocks can be requested. */
 
     /* Populate an OTA update context from the OTA job document. */
 
@@ -2509,9 +2872,36 @@ static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
         ulBitmapLen = ( ulNumBlocks + ( BITS_PER_BYTE - 1U ) ) >> LOG2_BITS_PER_BYTE;
         pstUpdateFile->pucRxBlockBitmap = ( uint8_t * ) pvPortMalloc( ulBitmapLen ); /*lint !e9079 FreeRTOS malloc port returns void*. */
 
+        /* Compressed files are decompressed on the fly so the window is only needed for the transfer. */
+        if( ( pstUpdateFile->pucRxBlockBitmap != NULL ) && ( pstUpdateFile->ulCompression == OTA_COMPRESSION_HEATSHRINK ) )
+        {
+            pstUpdateFile->pvDecompressor = pvPortMalloc( sizeof( OTA_Decompressor_t ) );
+
+            if( pstUpdateFile->pvDecompressor != NULL )
+            {
+                OTA_Decompress_Init( ( OTA_Decompressor_t * ) pstUpdateFile->pvDecompressor );
+                pstUpdateFile->ulImageOffset = 0U;
+            }
+            else
+            {
+                vPortFree( pstUpdateFile->pucRxBlockBitmap );
+                pstUpdateFile->pucRxBlockBitmap = NULL;
+            }
+        }
+
         if( pstUpdateFile->pucRxBlockBitmap != NULL )
         {
-            if( ( BaseType_t ) ( prvSubscribeToDataStream( pstUpdateFile ) ) == pdTRUE )
+            /* Files with a download URL are fetched with HTTP range requests instead of the MQTT data stream. */
+            if( pstUpdateFile->pucUpdateUrl != NULL )
+            {
+                xDataPlaneReady = prvInitHttpDownload( pstUpdateFile );
+            }
+            else
+            {
+                xDataPlaneReady = prvSubscribeToDataStream( pstUpdateFile );
+            }
+
+            if( ( BaseType_t ) xDataPlaneReady == pdTRUE )
             {
                 /* Set all bits in the bitmap to the erased state (we use 1 for erased just like flash memory). */
                 memset( pstUpdateFile->pucRxBlockBitmap, ( int ) OTA_ERASED_BLOCKS_VAL, ulBitmapLen );
@@ -2535,8 +2925,14 @@ static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
                 pstUpdateFile->ulBlocksRemaining = ulNumBlocks; /* Initialize our blocks remaining counter. */
                 prvStartRequestTimer( pstUpdateFile );
 
-                /* Create/Open the OTA file on the file system. */
-                xErr = prvPAL_CreateFileForRx( pstUpdateFile );
+                /* Create/Open the OTA file on the file system, unless this continues an
+                 * interrupted transfer of the same file. */
+                xErr = prvResumeFileForRx( pstUpdateFile, ulBitmapLen );
+
+                if( xErr != kOTA_Err_None )
+                {
+                    xErr = prvPAL_CreateFileForRx( pstUpdateFile );
+                }
 
                 if( xErr != kOTA_Err_None )
                 {
@@ -2547,7 +2943,7 @@ static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
             }
             else
             {
-                /* Can't receive the image without a subscription. */
+                /* Can't receive the image without a subscription or a usable download URL. */
                 ( void ) prvOTA_Close( pstUpdateFile ); /* Ignore false result since we're setting the pointer to null on the next line. */
                 pstUpdateFile = NULL;
             }
@@ -2565,6 +2961,352 @@ static OTA_FileContext_t * prvProcessOTAJobMsg( const char * pcRawMsg,
 
 
 
+/* Save the transfer state of the file so the download can continue after a reset. */
+
+static void prvSaveResumeState( OTA_FileContext_t * C,
+                                uint32_t ulBitmapLen )
+{
+    DEFINE_OTA_METHOD_NAME( "prvSaveResumeState" );
+
+    OTA_ResumeState_t * pxState;
+    const char * pcJobName = ( const char * ) xOTA_Agent.pcOTA_Singleton_ActiveJobName;
+    const char * pcStreamName = ( const char * ) C->pucStreamName;
+    OTA_Err_t xErr;
+
+    /* Compressed transfers are not resumable since the decompressor state isn't saved. */
+    if( ( C->pvDecompressor == NULL ) &&
+        ( pcJobName != NULL ) && ( strlen( pcJobName ) < OTA_RESUME_MAX_NAME_SIZE ) &&
+        ( pcStreamName != NULL ) && ( strlen( pcStreamName ) < OTA_RESUME_MAX_NAME_SIZE ) )
+    {
+        pxState = ( OTA_ResumeState_t * ) pvPortMalloc( sizeof( OTA_ResumeState_t ) + ulBitmapLen ); /*lint !e9079 FreeRTOS malloc port returns void*. */
+
+        if( pxState != NULL )
+        {
+            memset( pxState, 0, sizeof( OTA_ResumeState_t ) );
+            pxState->ulMagic = OTA_RESUME_STATE_MAGIC;
+            pxState->ulServerFileID = C->ulServerFileID;
+            pxState->ulFileSize = C->ulFileSize;
+            pxState->ulBlocksRemaining = C->ulBlocksRemaining;
+            pxState->ulImageOffset = C->ulImageOffset;
+            pxState->ulBitmapLen = ulBitmapLen;
+            memcpy( pxState->cJobName, pcJobName, strlen( pcJobName ) );
+            memcpy( pxState->cStreamName, pcStreamName, strlen( pcStreamName ) );
+            memcpy( &( ( uint8_t * ) pxState )[ sizeof( OTA_ResumeState_t ) ], C->pucRxBlockBitmap, ulBitmapLen );
+
+            xErr = prvPAL_SaveTransferState( ( const uint8_t * ) pxState, sizeof( OTA_ResumeState_t ) + ulBitmapLen );
+
+            if( xErr != kOTA_Err_None )
+            {
+                OTA_LOG_L1( "[%s] Failed to save the transfer state (0x%08x).\r\n", OTA_METHOD_NAME, xErr );
+            }
+
+            vPortFree( pxState );
+        }
+    }
+}
+
+
+/* Continue an interrupted transfer of the file if a matching transfer state was saved.
+ * On success the receive file is reopened without erasing it and the bitmap and block
+ * count are restored, so only the missing blocks are requested. */
+
+static OTA_Err_t prvResumeFileForRx( OTA_FileContext_t * C,
+                                     uint32_t ulBitmapLen )
+{
+    DEFINE_OTA_METHOD_NAME( "prvResumeFileForRx" );
+
+    OTA_Err_t xErr = kOTA_Err_NoResumeState;
+    OTA_ResumeState_t * pxState = NULL;
+    const uint8_t * pucBitmap;
+    uint32_t ulStateSize = sizeof( OTA_ResumeState_t ) + ulBitmapLen;
+    uint32_t ulMissing = 0U;
+    uint32_t ulIndex;
+    uint8_t ucBits;
+
+    if( ( otaconfigRESUME_SAVE_INTERVAL_BLOCKS > 0U ) &&
+        ( C->pvDecompressor == NULL ) &&
+        ( xOTA_Agent.pcOTA_Singleton_ActiveJobName != NULL ) &&
+        ( C->pucStreamName != NULL ) )
+    {
+        pxState = ( OTA_ResumeState_t * ) pvPortMalloc( ulStateSize ); /*lint !e9079 FreeRTOS malloc port returns void*. */
+    }
+
+    if( pxState != NULL )
+    {
+        if( prvPAL_LoadTransferState( ( uint8_t * ) pxState, &ulStateSize ) == kOTA_Err_None )
+        {
+            pucBitmap = &( ( const uint8_t * ) pxState )[ sizeof( OTA_ResumeState_t ) ];
+            pxState->cJobName[ OTA_RESUME_MAX_NAME_SIZE - 1U ] = '\0';
+            pxState->cStreamName[ OTA_RESUME_MAX_NAME_SIZE - 1U ] = '\0';
+
+            /* Count the missing blocks to make sure the bitmap agrees with the saved count. */
+            for( ulIndex = 0U; ( ulIndex < ulBitmapLen ) && ( ulStateSize == ( sizeof( OTA_ResumeState_t ) + ulBitmapLen ) ); ulIndex++ )
+            {
+                for( ucBits = pucBitmap[ ulIndex ]; ucBits != 0U; ucBits &= ( uint8_t ) ( ucBits - 1U ) )
+                {
+                    ulMissing++;
+                }
+            }
+
+            if( ( ulStateSize == ( sizeof( OTA_ResumeState_t ) + ulBitmapLen ) ) &&
+                ( pxState->ulMagic == OTA_RESUME_STATE_MAGIC ) &&
+                ( pxState->ulServerFileID == C->ulServerFileID ) &&
+                ( pxState->ulFileSize == C->ulFileSize ) &&
+                ( pxState->ulBitmapLen == ulBitmapLen ) &&
+                ( pxState->ulBlocksRemaining == ulMissing ) &&
+                ( strcmp( pxState->cJobName, ( const char * ) xOTA_Agent.pcOTA_Singleton_ActiveJobName ) == 0 ) &&
+                ( strcmp( pxState->cStreamName, ( const char * ) C->pucStreamName ) == 0 ) )
+            {
+                C->ulImageOffset = pxState->ulImageOffset;
+                xErr = prvPAL_ResumeFileForRx( C );
+
+                if( xErr == kOTA_Err_None )
+                {
+                    memcpy( C->pucRxBlockBitmap, pucBitmap, ulBitmapLen );
+                    C->ulBlocksRemaining = pxState->ulBlocksRemaining;
+                    OTA_LOG_L1( "[%s] Resuming transfer, %u blocks remaining.\r\n", OTA_METHOD_NAME, C->ulBlocksRemaining );
+                }
+                else
+                {
+                    OTA_LOG_L1( "[%s] Failed to reopen the receive file (0x%08x).\r\n", OTA_METHOD_NAME, xErr );
+                    C->ulImageOffset = 0U;
+                }
+            }
+            else
+            {
+                /* The saved state belongs to another transfer and can never be resumed. */
+                OTA_LOG_L1( "[%s] Discarding saved transfer state of another file.\r\n", OTA_METHOD_NAME );
+                ( void ) prvPAL_ClearTransferState();
+            }
+        }
+
+        vPortFree( pxState );
+    }
+
+    return xErr;
+}
+
+
+/* Output callback of the streaming decompressor. Append the decompressed data to the receive file. */
+
+static BaseType_t prvWriteDecompressedData( void * pvContext,
+                                            const uint8_t * pucData,
+                                            uint32_t ulSize )
+{
+    DEFINE_OTA_METHOD_NAME( "prvWriteDecompressedData" );
+
+    OTA_FileContext_t * C = ( OTA_FileContext_t * ) pvContext;
+    BaseType_t xResult = pdFALSE;
+    int32_t iBytesWritten;
+
+    /* A small compressed file can expand to any size. The output may not go past the image
+     * size of the job document, which the PAL checked against the size of the partition. */
+    if( ( C->ulImageOffset > C->ulImageSize ) || ( ulSize > ( C->ulImageSize - C->ulImageOffset ) ) )
+    {
+        OTA_LOG_L1( "[%s] Error: decompressed data at offset %u exceeds the image size %u\r\n", OTA_METHOD_NAME, C->ulImageOffset, C->ulImageSize );
+    }
+    else
+    {
+        iBytesWritten = prvPAL_WriteBlock( C, C->ulImageOffset, ( uint8_t * ) pucData, ulSize ); /*lint !e9005 The PAL doesn't modify the data. */
+
+        if( iBytesWritten == ( int32_t ) ulSize )
+        {
+            C->ulImageOffset += ulSize;
+            xResult = pdTRUE;
+        }
+        else
+        {
+            OTA_LOG_L1( "[%s] Error (%d) writing decompressed data at offset %u\r\n", OTA_METHOD_NAME, iBytesWritten, C->ulImageOffset );
+        }
+    }
+
+    return xResult;
+}
+
+
+/* Write a received block to the receive file. Compressed files are passed through the
+ * decompressor, which writes its output contiguously from the start of the file. */
+
+static int32_t prvWriteFileBlock( OTA_FileContext_t * C,
+                                  uint32_t ulBlockIndex,
+                                  uint8_t * pucPayload,
+                                  uint32_t ulBlockSize,
+                                  bool_t xIsLastBlock )
+{
+    int32_t iBytesWritten;
+    OTA_DecompressResult_t eResult;
+    OTA_Decompressor_t * pxDecompressor = ( OTA_Decompressor_t * ) C->pvDecompressor;
+
+    if( pxDecompressor == NULL )
+    {
+        iBytesWritten = prvPAL_WriteBlock( C, ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ), pucPayload, ulBlockSize );
+
+        if( ( iBytesWritten > 0 ) && ( ( ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ) + ulBlockSize ) > C->ulImageOffset ) )
+        {
+            C->ulImageOffset = ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ) + ulBlockSize;
+        }
+    }
+    else
+    {
+        eResult = OTA_Decompress_Feed( pxDecompressor, pucPayload, ulBlockSize, prvWriteDecompressedData, C );
+
+        if( ( eResult == eOTA_Decompress_Ok ) && ( xIsLastBlock == ( bool_t ) pdTRUE ) )
+        {
+            eResult = OTA_Decompress_Flush( pxDecompressor, prvWriteDecompressedData, C );
+
+            if( ( eResult == eOTA_Decompress_Ok ) && ( C->ulImageOffset != C->ulImageSize ) )
+            {
+                /* The stream ended before the image was complete. */
+                eResult = eOTA_Decompress_BadData;
+            }
+        }
+
+        iBytesWritten = ( eResult == eOTA_Decompress_Ok ) ? ( int32_t ) ulBlockSize : -( int32_t ) eResult;
+    }
+
+    return iBytesWritten;
+}
+
+
+/* Validate a file block and write it to the receive file. The file is closed and
+ * authenticated after the last block. */
+
+static IngestResult_t prvProcessDataBlock( OTA_FileContext_t * C,
+                                           uint32_t ulBlockIndex,
+                                           uint32_t ulBlockSize,
+                                           uint8_t * pucPayload,
+                                           OTA_Err_t * pxCloseResult )
+{
+    DEFINE_OTA_METHOD_NAME( "prvProcessDataBlock" );
+
+    IngestResult_t eIngestResult = eIngest_Result_Uninitialized;
+
+    /* Validate the block index and size. */
+    /* If it is NOT the last block, it MUST be equal to a full block size. */
+    /* If it IS the last block, it MUST be equal to the expected remainder. */
+    /* If the block ID is out of range, that's an error so abort. */
+    uint32_t iLastBlock = ( ( C->ulFileSize + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE ) - 1U;
+
+    if( ( ( ( uint32_t ) ulBlockIndex < iLastBlock ) && ( ulBlockSize == OTA_FILE_BLOCK_SIZE ) ) ||
+        ( ( ( uint32_t ) ulBlockIndex == iLastBlock ) && ( ( uint32_t ) ulBlockSize == ( C->ulFileSize - ( iLastBlock * OTA_FILE_BLOCK_SIZE ) ) ) ) )
+    {
+        OTA_LOG_L1( "[%s] Received file block %u, size %u\r\n", OTA_METHOD_NAME, ulBlockIndex, ulBlockSize );
+
+        /* Create bit mask for use in our bitmap. */
+        uint8_t ulBitMask = 1U << ( ulBlockIndex % BITS_PER_BYTE ); /*lint !e9031 The composite expression will never be greater than BITS_PER_BYTE(8). */
+        /* Calculate byte offset into bitmap. */
+        uint32_t ulByte = ulBlockIndex >> LOG2_BITS_PER_BYTE;
+
+        if( ( C->pucRxBlockBitmap[ ulByte ] & ulBitMask ) == 0U ) /* If we've already received this block... */
+        {
+            OTA_LOG_L1( "[%s] block %u is a DUPLICATE. %u blocks remaining.\r\n", OTA_METHOD_NAME,
+                        ulBlockIndex,
+                        C->ulBlocksRemaining );
+            eIngestResult = eIngest_Result_Duplicate_Continue;
+            *pxCloseResult = kOTA_Err_None; /* This is a success path. */
+        }
+        /* The decompressor needs the blocks in order. Blocks received so far are exactly
+         * the first (iLastBlock + 1 - ulBlocksRemaining) so anything else is dropped
+         * and requested again by the next stream request. */
+        else if( ( C->pvDecompressor != NULL ) && ( ulBlockIndex != ( ( iLastBlock + 1U ) - C->ulBlocksRemaining ) ) )
+        {
+            OTA_LOG_L1( "[%s] block %u is ahead of the decompressor. Dropping it.\r\n", OTA_METHOD_NAME, ulBlockIndex );
+            eIngestResult = eIngest_Result_OutOfOrder_Continue;
+            *pxCloseResult = kOTA_Err_None; /* This is a success path. */
+        }
+        else /* Otherwise, process it normally... */
+        {
+            if( C->pucFile != NULL )
+            {
+                int32_t iBytesWritten = prvWriteFileBlock( C, ulBlockIndex, pucPayload, ( uint32_t ) ulBlockSize,
+                                                           ( ulBlockIndex == iLastBlock ) ? ( bool_t ) pdTRUE : ( bool_t ) pdFALSE );
+
+                if( iBytesWritten < 0 )
+                {
+                    OTA_LOG_L1( "[%s] Error (%d) writing file block\r\n", OTA_METHOD_NAME, iBytesWritten );
+                    eIngestResult = ( C->pvDecompressor != NULL ) ? eIngest_Result_DecompressFailed : eIngest_Result_WriteBlockFailed;
+                }
+                else
+                {
+                    C->pucRxBlockBitmap[ ulByte ] &= ~ulBitMask; /* Mark this block as received in our bitmap. */
+                    C->ulBlocksRemaining--;
+                    eIngestResult = eIngest_Result_Accepted_Continue;
+                    *pxCloseResult = kOTA_Err_None; /* This is a success path. */
+
+                    /* Periodically save our progress. The block was written before the
+                     * bitmap so a saved state never claims a block that isn't in flash. */
+                    if( ( otaconfigRESUME_SAVE_INTERVAL_BLOCKS > 0U ) &&
+                        ( C->ulBlocksRemaining > 0U ) &&
+                        ( ( C->ulBlocksRemaining % otaconfigRESUME_SAVE_INTERVAL_BLOCKS ) == 0U ) )
+                    {
+                        prvSaveResumeState( C, ( iLastBlock + BITS_PER_BYTE ) >> LOG2_BITS_PER_BYTE );
+                    }
+                }
+            }
+            else
+            {
+                OTA_LOG_L1( "[%s] Error: Unable to write block, file handle is NULL.\r\n", OTA_METHOD_NAME );
+                eIngestResult = eIngest_Result_BadFileHandle;
+            }
+
+            if( C->ulBlocksRemaining == 0U )
+            {
+                OTA_LOG_L1( "[%s] Received final expected block of file.\r\n", OTA_METHOD_NAME );
+                prvStopRequestTimer( C );         /* Don't request any more since we're done. */
+                vPortFree( C->pucRxBlockBitmap ); /* Free the bitmap now that we're done with the download. */
+                C->pucRxBlockBitmap = NULL;
+
+                if( C->pucFile != NULL )
+                {
+                    *pxCloseResult = prvPAL_CloseFile( C );
+
+                    if( *pxCloseResult == kOTA_Err_None )
+                    {
+                        OTA_LOG_L1( "[%s] File receive complete and signature is valid.\r\n", OTA_METHOD_NAME );
+                        eIngestResult = eIngest_Result_FileComplete;
+                    }
+                    else
+                    {
+                        uint32_t ulCloseResult = ( uint32_t ) *pxCloseResult;
+                        OTA_LOG_L1( "[%s] Error (%u:0x%06x) closing OTA file.\r\n",
+                                    OTA_METHOD_NAME,
+                                    ulCloseResult >> kOTA_MainErrShiftDownBits,
+                                    ulCloseResult & ( uint32_t ) kOTA_PAL_ErrMask );
+
+                        if( ( ulCloseResult & kOTA_Main_ErrMask ) == kOTA_Err_SignatureCheckFailed )
+                        {
+                            eIngestResult = eIngest_Result_SigCheckFail;
+                        }
+                        else
+                        {
+                            eIngestResult = eIngest_Result_FileCloseFail;
+                        }
+                    }
+
+                    C->pucFile = NULL; /* File is now closed so clear the file handle in the context. */
+                }
+                else
+                {
+                    OTA_LOG_L1( "[%s] Error: File handle is NULL after last block received.\r\n", OTA_METHOD_NAME );
+                    eIngestResult = eIngest_Result_BadFileHandle;
+                }
+            }
+            else
+            {
+                OTA_LOG_L1( "[%s] Remaining: %u\r\n", OTA_METHOD_NAME, C->ulBlocksRemaining );
+            }
+        }
+    }
+    else
+    {
+        OTA_LOG_L1( "[%s] Error! Block %u out of expected range! Size %u\r\n", OTA_METHOD_NAME, ulBlockIndex, ulBlockSize );
+        eIngestResult = eIngest_Result_BlockOutOfRange;
+    }
+
+    return eIngestResult;
+}
+
+
 /* prvIngestDataBlock
  *
  * A block of file data was received by the application via some configured communication protocol.
@@ -2614,108 +3356,7 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                 }
                 else
                 {
-                    /* Validate the block index and size. */
-                    /* If it is NOT the last block, it MUST be equal to a full block size. */
-                    /* If it IS the last block, it MUST be equal to the expected remainder. */
-                    /* If the block ID is out of range, that's an error so abort. */
-                    uint32_t iLastBlock = ( ( C->ulFileSize + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE ) - 1U;
-
-                    if( ( ( ( uint32_t ) ulBlockIndex < iLastBlock ) && ( ulBlockSize == OTA_FILE_BLOCK_SIZE ) ) ||
-                        ( ( ( uint32_t ) ulBlockIndex == iLastBlock ) && ( ( uint32_t ) ulBlockSize == ( C->ulFileSize - ( iLastBlock * OTA_FILE_BLOCK_SIZE ) ) ) ) )
-                    {
-                        OTA_LOG_L1( "[%s] Received file block %u, size %u\r\n", OTA_METHOD_NAME, ulBlockIndex, ulBlockSize );
-
-                        /* Create bit mask for use in our bitmap. */
-                        uint8_t ulBitMask = 1U << ( ulBlockIndex % BITS_PER_BYTE ); /*lint !e9031 The composite expression will never be greater than BITS_PER_BYTE(8). */
-                        /* Calculate byte offset into bitmap. */
-                        uint32_t ulByte = ulBlockIndex >> LOG2_BITS_PER_BYTE;
-
-                        if( ( C->pucRxBlockBitmap[ ulByte ] & ulBitMask ) == 0U ) /* If we've already received this block... */
-                        {
-                            OTA_LOG_L1( "[%s] block %u is a DUPLICATE. %u blocks remaining.\r\n", OTA_METHOD_NAME,
-                                        ulBlockIndex,
-                                        C->ulBlocksRemaining );
-                            eIngestResult = eIngest_Result_Duplicate_Continue;
-                            *pxCloseResult = kOTA_Err_None; /* This is a success path. */
-                        }
-                        else /* Otherwise, process it normally... */
-                        {
-                            if( C->pucFile != NULL )
-                            {
-                                int32_t iBytesWritten = prvPAL_WriteBlock( C, ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ), pucPayload, ( uint32_t ) ulBlockSize );
-
-                                if( iBytesWritten < 0 )
-                                {
-                                    OTA_LOG_L1( "[%s] Error (%d) writing file block\r\n", OTA_METHOD_NAME, iBytesWritten );
-                                    eIngestResult = eIngest_Result_WriteBlockFailed;
-                                }
-                                else
-                                {
-                                    C->pucRxBlockBitmap[ ulByte ] &= ~ulBitMask; /* Mark this block as received in our bitmap. */
-                                    C->ulBlocksRemaining--;
-                                    eIngestResult = eIngest_Result_Accepted_Continue;
-                                    *pxCloseResult = kOTA_Err_None; /* This is a success path. */
-                                }
-                            }
-                            else
-                            {
-                                OTA_LOG_L1( "[%s] Error: Unable to write block, file handle is NULL.\r\n", OTA_METHOD_NAME );
-                                eIngestResult = eIngest_Result_BadFileHandle;
-                            }
-
-                            if( C->ulBlocksRemaining == 0U )
-                            {
-                                OTA_LOG_L1( "[%s] Received final expected block of file.\r\n", OTA_METHOD_NAME );
-                                prvStopRequestTimer( C );         /* Don't request any more since we're done. */
-                                vPortFree( C->pucRxBlockBitmap ); /* Free the bitmap now that we're done with the download. */
-                                C->pucRxBlockBitmap = NULL;
-
-                                if( C->pucFile != NULL )
-                                {
-                                    *pxCloseResult = prvPAL_CloseFile( C );
-
-                                    if( *pxCloseResult == kOTA_Err_None )
-                                    {
-                                        OTA_LOG_L1( "[%s] File receive complete and signature is valid.\r\n", OTA_METHOD_NAME );
-                                        eIngestResult = eIngest_Result_FileComplete;
-                                    }
-                                    else
-                                    {
-                                        uint32_t ulCloseResult = ( uint32_t ) *pxCloseResult;
-                                        OTA_LOG_L1( "[%s] Error (%u:0x%06x) closing OTA file.\r\n",
-                                                    OTA_METHOD_NAME,
-                                                    ulCloseResult >> kOTA_MainErrShiftDownBits,
-                                                    ulCloseResult & ( uint32_t ) kOTA_PAL_ErrMask );
-
-                                        if( ( ulCloseResult & kOTA_Main_ErrMask ) == kOTA_Err_SignatureCheckFailed )
-                                        {
-                                            eIngestResult = eIngest_Result_SigCheckFail;
-                                        }
-                                        else
-                                        {
-                                            eIngestResult = eIngest_Result_FileCloseFail;
-                                        }
-                                    }
-
-                                    C->pucFile = NULL; /* File is now closed so clear the file handle in the context. */
-                                }
-                                else
-                                {
-                                    OTA_LOG_L1( "[%s] Error: File handle is NULL after last block received.\r\n", OTA_METHOD_NAME );
-                                    eIngestResult = eIngest_Result_BadFileHandle;
-                                }
-                            }
-                            else
-                            {
-                                OTA_LOG_L1( "[%s] Remaining: %u\r\n", OTA_METHOD_NAME, C->ulBlocksRemaining );
-                            }
-                        }
-                    }
-                    else
-                    {
-                        OTA_LOG_L1( "[%s] Error! Block %u out of expected range! Size %u\r\n", OTA_METHOD_NAME, ulBlockIndex, ulBlockSize );
-                        eIngestResult = eIngest_Result_BlockOutOfRange;
-                    }
+                    eIngestResult = prvProcessDataBlock( C, ulBlockIndex, ulBlockSize, pucPayload, pxCloseResult );
                 }
             }
             else
@@ -39,6 +39,31 @@
 #define BITS_PER_BYTE          ( 1UL << LOG2_BITS_PER_BYTE )            /* Number of bits in a byte. This is used by the block bitmap implementation. */
 #define OTA_FILE_BLOCK_SIZE    ( 1UL << otaconfigLOG2_FILE_BLOCK_SIZE ) /* Data section size of the file data block message (excludes the header). */
 
+/* Number of received blocks between saves of the transfer state. Saving more often
+ * means fewer blocks are downloaded again after a reset but costs more flash wear.
+ * Set to 0 to disable resuming interrupted transfers. */
+#ifndef otaconfigRESUME_SAVE_INTERVAL_BLOCKS
+    #define otaconfigRESUME_SAVE_INTERVAL_BLOCKS    32U
+#endif
+
+#define OTA_RESUME_STATE_MAGIC      0x4f544131UL /* "OTA1". Change if the layout of OTA_ResumeState_t changes. */
+#define OTA_RESUME_MAX_NAME_SIZE    65U          /* Job and stream names of up to 64 characters can be resumed. */
+
+/* Transfer state saved through the PAL so an interrupted download can continue
+ * after a reset or reconnect. The receive block bitmap immediately follows it. */
+
+typedef struct
+{
+    uint32_t ulMagic;                             /* Must be OTA_RESUME_STATE_MAGIC. */
+    uint32_t ulServerFileID;                      /* The file ID from the job document. */
+    uint32_t ulFileSize;                          /* The file size from the job document. */
+    uint32_t ulBlocksRemaining;                   /* Blocks still missing when the state was saved. */
+    uint32_t ulImageOffset;                       /* Write frontier of the receive file. */
+    uint32_t ulBitmapLen;                         /* Size in bytes of the block bitmap that follows. */
+    char cJobName[ OTA_RESUME_MAX_NAME_SIZE ];    /* Zero terminated name of the job. */
+    char cStreamName[ OTA_RESUME_MAX_NAME_SIZE ]; /* Zero terminated name of the stream. */
+} OTA_ResumeState_t;
+
 typedef enum
 {
     eIngest_Result_FileComplete = -1,       /* The file transfer is complete and the signature check passed. */
@@ -51,9 +76,11 @@ typedef enum
     eIngest_Result_BadData = -8,            /* The data block from the server was malformed. */
     eIngest_Result_WriteBlockFailed = -9,   /* The PAL layer failed to write the file block. */
     eIngest_Result_NullResultPointer = -10, /* The pointer to the close result pointer was null. */
+    eIngest_Result_DecompressFailed = -11,  /* The compressed file data could not be decompressed. */
     eIngest_Result_Uninitialized = -127,    /* Software BUG: We forgot to set the result code. */
     eIngest_Result_Accepted_Continue = 0,   /* The block was accepted and we're expecting more. */
     eIngest_Result_Duplicate_Continue = 1,  /* The block was a duplicate but that's OK. Continue. */
+    eIngest_Result_OutOfOrder_Continue = 2, /* A compressed file block arrived ahead of the decompressor. It will be requested again. */
 } IngestResult_t;
 
 /* Generic JSON document parser errors. */
@@ -68,7 +95,6 @@ typedef enum
     eDocParseErr_InvalidNumChar,        /* There was an invalid character in a numeric value field. */
     eDocParseErr_DuplicatesNotAllowed,  /* A duplicate parameter was found in the job document. */
     eDocParseErr_MalformedDoc,          /* The document didn't fulfill the model requirements. */
-    eDocParseErr_JasmineCountMismatch,  /* The second pass of jsmn_parse() didn't match the first pass. */
     eDocParseErr_TooManyTokens,         /* We can't support the number of JSON tokens in the document. */
     eDocParseErr_NoTokens,              /* No JSON tokens were detected in the document. */
     eDocParseErr_NullModelPointer,      /* The pointer to the document model was NULL. */
@@ -121,6 +147,24 @@ typedef struct
 } JSON_DocParam_t;
 
 
+/* Number of slots in the perfect hash of a document model. A power of two with
+ * several slots per model parameter keeps the search for a seed short. */
+
+#define JSON_DOC_MODEL_HASH_SLOTS    128U
+
+/* Perfect hash of the keys of a document model. It is generated with the model and
+ * gives every key of the model its own slot, so finding the model parameter of a JSON
+ * key costs one hash and one string compare regardless of the size of the model. Keys
+ * whose value is not known when the hash is generated are compared directly.
+ */
+typedef struct
+{
+    const uint32_t ulSeed;                              /* Hash seed that gives every hashed model key its own slot. */
+    const uint32_t ulUnhashedBitmap;                    /* Bitmap of the model parameters that are not in the slots. */
+    const uint8_t ucSlots[ JSON_DOC_MODEL_HASH_SLOTS ]; /* Model parameter index plus one, or zero for an empty slot. */
+} JSON_DocModelHash_t;
+
+
 /* The document model is currently limited to 32 parameters per the implementation,
  * although it may be easily expanded to more in the future by simply expanding
  * the parameter bitmap.
@@ -132,12 +176,13 @@ typedef struct
  */
 typedef struct
 {
-    uint32_t ulContextBase;            /* The base address of the destination OTA context structure. */
-    uint32_t ulContextSize;            /* The size, in bytes, of the destination context structure. */
-    const JSON_DocParam_t * pxBodyDef; /* Pointer to the document model body definition. */
-    uint16_t usNumModelParams;         /* The number of entries in the document model (limited to 32). */
-    uint32_t ulParamsReceivedBitmap;   /* Bitmap of the parameters received based on the model. */
-    uint32_t ulParamsRequiredBitmap;   /* Bitmap of the parameters required from the model. */
+    uint32_t ulContextBase;                /* The base address of the destination OTA context structure. */
+    uint32_t ulContextSize;                /* The size, in bytes, of the destination context structure. */
+    const JSON_DocParam_t * pxBodyDef;     /* Pointer to the document model body definition. */
+    uint16_t usNumModelParams;             /* The number of entries in the document model (limited to 32). */
+    uint32_t ulParamsReceivedBitmap;       /* Bitmap of the parameters received based on the model. */
+    uint32_t ulParamsRequiredBitmap;       /* Bitmap of the parameters required from the model. */
+    const JSON_DocModelHash_t * pxKeyHash; /* Perfect hash of the model keys or NULL to search the model for each key. */
 } JSON_DocModel_t;
 
 #endif /* ifndef _AWS_OTA_AGENT_INTERAL_H_ */
@@ -0,0 +1,311 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_ota_decompress.c
+ * @brief Streaming heatshrink (LZSS) decoder for compressed OTA images.
+ */
+
+/* Standard library includes. */
+#include <string.h>
+
+/* OTA includes. */
+#include "aws_ota_decompress.h"
+
+#define OTA_DECOMPRESS_WINDOW_MASK    ( ( uint16_t ) ( OTA_DECOMPRESS_WINDOW_SIZE - 1UL ) )
+#define OTA_DECOMPRESS_NO_BITS        0xffffU /* Returned by prvGetBits() when the input is exhausted. */
+
+/* Decoder states. Every state consumes at most 8 bits so it can be suspended
+ * and resumed at any input boundary. */
+typedef enum
+{
+    eDecompressState_TagBit = 0,
+    eDecompressState_Literal,
+    eDecompressState_IndexMSB,
+    eDecompressState_IndexLSB,
+    eDecompressState_CountMSB,
+    eDecompressState_CountLSB,
+    eDecompressState_YieldBackref
+} OTA_DecompressState_t;
+
+/* Cursor over the caller's input buffer. */
+typedef struct
+{
+    const uint8_t * pucIn;
+    uint32_t ulRemaining;
+} OTA_DecompressInput_t;
+
+/*-----------------------------------------------------------*/
+
+/* Take ucCount (1 to 8) bits from the input, most significant bit first. */
+
+static uint16_t prvGetBits( OTA_Decompressor_t * pxDec,
+                            OTA_DecompressInput_t * pxIn,
+                            uint8_t ucCount )
+{
+    uint16_t usBits = OTA_DECOMPRESS_NO_BITS;
+
+    if( pxDec->ucBitsAvailable < ucCount )
+    {
+        if( pxIn->ulRemaining > 0UL )
+        {
+            pxDec->usBitBuffer = ( uint16_t ) ( ( pxDec->usBitBuffer << 8 ) | *pxIn->pucIn );
+            pxDec->ucBitsAvailable += 8U;
+            pxIn->pucIn++;
+            pxIn->ulRemaining--;
+        }
+    }
+
+    if( pxDec->ucBitsAvailable >= ucCount )
+    {
+        pxDec->ucBitsAvailable -= ucCount;
+        usBits = ( uint16_t ) ( ( pxDec->usBitBuffer >> pxDec->ucBitsAvailable ) & ( ( 1U << ucCount ) - 1U ) );
+    }
+
+    return usBits;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Emit one decompressed byte, flushing the staging buffer when it is full. */
+
+static BaseType_t prvPutByte( OTA_Decompressor_t * pxDec,
+                              uint8_t ucByte,
+                              OTA_DecompressOutput_t xOutput,
+                              void * pvContext )
+{
+    BaseType_t xResult = pdTRUE;
+
+    pxDec->ucWindow[ pxDec->usWindowHead & OTA_DECOMPRESS_WINDOW_MASK ] = ucByte;
+    pxDec->usWindowHead++;
+    pxDec->ulTotalOut++;
+    pxDec->ucOutput[ pxDec->usOutputLen ] = ucByte;
+    pxDec->usOutputLen++;
+
+    if( pxDec->usOutputLen == otaconfigDECOMPRESS_OUTPUT_BUF_SIZE )
+    {
+        xResult = xOutput( pvContext, pxDec->ucOutput, pxDec->usOutputLen );
+        pxDec->usOutputLen = 0U;
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+void OTA_Decompress_Init( OTA_Decompressor_t * pxDec )
+{
+    if( pxDec != NULL )
+    {
+        /* The encoder assumes a zero filled window at the start of the stream. */
+        memset( pxDec, 0, sizeof( OTA_Decompressor_t ) );
+        pxDec->ucState = ( uint8_t ) eDecompressState_TagBit;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+OTA_DecompressResult_t OTA_Decompress_Feed( OTA_Decompressor_t * pxDec,
+                                            const uint8_t * pucIn,
+                                            uint32_t ulInSize,
+                                            OTA_DecompressOutput_t xOutput,
+                                            void * pvContext )
+{
+    OTA_DecompressResult_t eResult = eOTA_Decompress_Ok;
+    OTA_DecompressInput_t xIn;
+    uint16_t usBits;
+    BaseType_t xMoreBits = pdTRUE;
+
+    if( ( pxDec == NULL ) || ( xOutput == NULL ) || ( ( pucIn == NULL ) && ( ulInSize > 0UL ) ) )
+    {
+        eResult = eOTA_Decompress_BadParams;
+        xMoreBits = pdFALSE;
+    }
+
+    xIn.pucIn = pucIn;
+    xIn.ulRemaining = ulInSize;
+
+    while( ( xMoreBits == pdTRUE ) && ( eResult == eOTA_Decompress_Ok ) )
+    {
+        switch( ( OTA_DecompressState_t ) pxDec->ucState )
+        {
+            case eDecompressState_TagBit:
+                usBits = prvGetBits( pxDec, &xIn, 1U );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else if( usBits != 0U )
+                {
+                    pxDec->ucState = ( uint8_t ) eDecompressState_Literal;
+                }
+                else
+                {
+                    pxDec->usBackrefIndex = 0U;
+                    pxDec->ucState = ( uint8_t ) ( ( otaconfigDECOMPRESS_WINDOW_BITS > 8U ) ?
+                                                   eDecompressState_IndexMSB : eDecompressState_IndexLSB );
+                }
+
+                break;
+
+            case eDecompressState_Literal:
+                usBits = prvGetBits( pxDec, &xIn, 8U );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else
+                {
+                    if( prvPutByte( pxDec, ( uint8_t ) usBits, xOutput, pvContext ) != pdTRUE )
+                    {
+                        eResult = eOTA_Decompress_OutputFailed;
+                    }
+
+                    pxDec->ucState = ( uint8_t ) eDecompressState_TagBit;
+                }
+
+                break;
+
+            case eDecompressState_IndexMSB:
+                usBits = prvGetBits( pxDec, &xIn, ( uint8_t ) ( otaconfigDECOMPRESS_WINDOW_BITS - 8U ) );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else
+                {
+                    pxDec->usBackrefIndex = ( uint16_t ) ( usBits << 8 );
+                    pxDec->ucState = ( uint8_t ) eDecompressState_IndexLSB;
+                }
+
+                break;
+
+            case eDecompressState_IndexLSB:
+                usBits = prvGetBits( pxDec, &xIn, ( uint8_t ) ( ( otaconfigDECOMPRESS_WINDOW_BITS > 8U ) ? 8U : otaconfigDECOMPRESS_WINDOW_BITS ) );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else
+                {
+                    pxDec->usBackrefIndex = ( uint16_t ) ( ( pxDec->usBackrefIndex | usBits ) + 1U );
+                    pxDec->usBackrefCount = 0U;
+                    pxDec->ucState = ( uint8_t ) ( ( otaconfigDECOMPRESS_LOOKAHEAD_BITS > 8U ) ?
+                                                   eDecompressState_CountMSB : eDecompressState_CountLSB );
+                }
+
+                break;
+
+            case eDecompressState_CountMSB:
+                usBits = prvGetBits( pxDec, &xIn, ( uint8_t ) ( otaconfigDECOMPRESS_LOOKAHEAD_BITS - 8U ) );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else
+                {
+                    pxDec->usBackrefCount = ( uint16_t ) ( usBits << 8 );
+                    pxDec->ucState = ( uint8_t ) eDecompressState_CountLSB;
+                }
+
+                break;
+
+            case eDecompressState_CountLSB:
+                usBits = prvGetBits( pxDec, &xIn, ( uint8_t ) ( ( otaconfigDECOMPRESS_LOOKAHEAD_BITS > 8U ) ? 8U : otaconfigDECOMPRESS_LOOKAHEAD_BITS ) );
+
+                if( usBits == OTA_DECOMPRESS_NO_BITS )
+                {
+                    xMoreBits = pdFALSE;
+                }
+                else
+                {
+                    pxDec->usBackrefCount = ( uint16_t ) ( ( pxDec->usBackrefCount | usBits ) + 1U );
+                    pxDec->ucState = ( uint8_t ) eDecompressState_YieldBackref;
+                }
+
+                break;
+
+            case eDecompressState_YieldBackref:
+
+                /* Copying needs no input so a back-reference always completes here. References
+                 * reaching before the start of the stream read the zero filled window, exactly
+                 * as the encoder assumed. */
+                while( ( pxDec->usBackrefCount > 0U ) && ( eResult == eOTA_Decompress_Ok ) )
+                {
+                    uint8_t ucByte = pxDec->ucWindow[ ( uint16_t ) ( pxDec->usWindowHead - pxDec->usBackrefIndex ) & OTA_DECOMPRESS_WINDOW_MASK ];
+                    pxDec->usBackrefCount--;
+
+                    if( prvPutByte( pxDec, ucByte, xOutput, pvContext ) != pdTRUE )
+                    {
+                        eResult = eOTA_Decompress_OutputFailed;
+                    }
+                }
+
+                pxDec->ucState = ( uint8_t ) eDecompressState_TagBit;
+                break;
+
+            default:
+                /* Memory corruption. */
+                eResult = eOTA_Decompress_BadData;
+                break;
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+OTA_DecompressResult_t OTA_Decompress_Flush( OTA_Decompressor_t * pxDec,
+                                             OTA_DecompressOutput_t xOutput,
+                                             void * pvContext )
+{
+    OTA_DecompressResult_t eResult = eOTA_Decompress_Ok;
+
+    if( ( pxDec == NULL ) || ( xOutput == NULL ) )
+    {
+        eResult = eOTA_Decompress_BadParams;
+    }
+    else if( pxDec->usOutputLen > 0U )
+    {
+        if( xOutput( pvContext, pxDec->ucOutput, pxDec->usOutputLen ) != pdTRUE )
+        {
+            eResult = eOTA_Decompress_OutputFailed;
+        }
+
+        pxDec->usOutputLen = 0U;
+    }
+    else
+    {
+        /* Nothing staged. */
+    }
+
+    return eResult;
+}
@@ -0,0 +1,149 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_ota_decompress.h
+ * @brief Streaming decompressor for compressed OTA images.
+ *
+ * The compressed stream uses the heatshrink LZSS bit format (a tag bit followed by
+ * either an 8 bit literal or a window index / count back-reference), so images can
+ * be produced on the host with "heatshrink -e -w <W> -l <L>". The decoder keeps
+ * only the sliding window and a small output staging buffer in RAM and may be fed
+ * input of any length, including a single byte at a time.
+ */
+
+#ifndef _AWS_OTA_DECOMPRESS_H_
+#define _AWS_OTA_DECOMPRESS_H_
+
+#include "FreeRTOS.h"
+#include "aws_ota_agent_config.h"
+
+/**
+ * @brief Log base 2 of the decompression window size in bytes.
+ *
+ * Must match the -w parameter used to compress the image. The window is the
+ * dominant RAM cost of a compressed OTA transfer.
+ */
+#ifndef otaconfigDECOMPRESS_WINDOW_BITS
+    #define otaconfigDECOMPRESS_WINDOW_BITS       10U
+#endif
+
+/**
+ * @brief Log base 2 of the maximum back-reference length.
+ *
+ * Must match the -l parameter used to compress the image.
+ */
+#ifndef otaconfigDECOMPRESS_LOOKAHEAD_BITS
+    #define otaconfigDECOMPRESS_LOOKAHEAD_BITS    4U
+#endif
+
+/**
+ * @brief Size of the buffer used to stage decompressed output before it is flushed.
+ */
+#ifndef otaconfigDECOMPRESS_OUTPUT_BUF_SIZE
+    #define otaconfigDECOMPRESS_OUTPUT_BUF_SIZE    256U
+#endif
+
+#if ( otaconfigDECOMPRESS_WINDOW_BITS < 4U ) || ( otaconfigDECOMPRESS_WINDOW_BITS > 15U )
+    #error "otaconfigDECOMPRESS_WINDOW_BITS must be in the range 4 to 15."
+#endif
+
+#if ( otaconfigDECOMPRESS_LOOKAHEAD_BITS < 3U ) || ( otaconfigDECOMPRESS_LOOKAHEAD_BITS >= otaconfigDECOMPRESS_WINDOW_BITS )
+    #error "otaconfigDECOMPRESS_LOOKAHEAD_BITS must be at least 3 and smaller than the window bits."
+#endif
+
+#define OTA_DECOMPRESS_WINDOW_SIZE    ( 1UL << otaconfigDECOMPRESS_WINDOW_BITS )
+
+/* Compression schemes that may be specified by the "compression" key of the job document. */
+#define OTA_COMPRESSION_NONE          0UL /* The file is sent as is. */
+#define OTA_COMPRESSION_HEATSHRINK    1UL /* The file is a heatshrink LZSS stream of the image. */
+
+/**
+ * @brief Callback used by the decompressor to flush staged output.
+ *
+ * @param[in] pvContext The context passed to OTA_Decompress_Feed().
+ * @param[in] pucData Decompressed data.
+ * @param[in] ulSize Number of decompressed bytes in pucData.
+ *
+ * @return pdTRUE if the data was consumed, pdFALSE to stop decompression.
+ */
+typedef BaseType_t (* OTA_DecompressOutput_t)( void * pvContext,
+                                               const uint8_t * pucData,
+                                               uint32_t ulSize );
+
+/**
+ * @brief Decompressor state.
+ *
+ * The structure is self contained so it can be allocated only for the duration of a
+ * compressed transfer. Its size is the peak RAM cost of decompression.
+ */
+typedef struct OTA_Decompressor
+{
+    uint32_t ulTotalOut;        /* Number of bytes produced since OTA_Decompress_Init(). */
+    uint16_t usWindowHead;      /* Next write position in the sliding window. */
+    uint16_t usBackrefIndex;    /* Distance of the back-reference being decoded. */
+    uint16_t usBackrefCount;    /* Remaining length of the back-reference being decoded. */
+    uint16_t usOutputLen;       /* Number of bytes staged in ucOutput. */
+    uint16_t usBitBuffer;       /* Input bits not yet consumed, MSB first. */
+    uint8_t ucBitsAvailable;    /* Number of valid bits in usBitBuffer. */
+    uint8_t ucState;            /* Current decoder state. */
+    uint8_t ucWindow[ OTA_DECOMPRESS_WINDOW_SIZE ];
+    uint8_t ucOutput[ otaconfigDECOMPRESS_OUTPUT_BUF_SIZE ];
+} OTA_Decompressor_t;
+
+/* Results of the streaming decompressor. */
+typedef enum
+{
+    eOTA_Decompress_Ok = 0,       /* All input was consumed. */
+    eOTA_Decompress_BadData,      /* The decoder state was corrupted. */
+    eOTA_Decompress_OutputFailed, /* The output callback refused the data. */
+    eOTA_Decompress_BadParams     /* A NULL pointer was supplied. */
+} OTA_DecompressResult_t;
+
+/**
+ * @brief Reset the decompressor to the start of a new stream.
+ */
+void OTA_Decompress_Init( OTA_Decompressor_t * pxDec );
+
+/**
+ * @brief Decompress the next piece of the stream.
+ *
+ * Output is staged internally and passed to xOutput whenever the staging buffer
+ * fills. Call OTA_Decompress_Flush() after the last input to push the remainder.
+ */
+OTA_DecompressResult_t OTA_Decompress_Feed( OTA_Decompressor_t * pxDec,
+                                            const uint8_t * pucIn,
+                                            uint32_t ulInSize,
+                                            OTA_DecompressOutput_t xOutput,
+                                            void * pvContext );
+
+/**
+ * @brief Pass any staged output to xOutput.
+ */
+OTA_DecompressResult_t OTA_Decompress_Flush( OTA_Decompressor_t * pxDec,
+                                             OTA_DecompressOutput_t xOutput,
+                                             void * pvContext );
+
+#endif /* ifndef _AWS_OTA_DECOMPRESS_H_ */
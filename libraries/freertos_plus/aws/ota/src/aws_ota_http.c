@@ -0,0 +1,691 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_ota_http.c
+ * @brief HTTP/1.1 range request client for the OTA data plane.
+ */
+
+/* Standard library includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* OTA includes. */
+#include "aws_ota_http.h"
+
+#define OTA_HTTP_DEFAULT_PORT          80U
+#define OTA_HTTPS_DEFAULT_PORT         443U
+#define OTA_HTTP_STATUS_PARTIAL        206UL /* The only acceptable response to a range request. */
+
+static const char pcOTA_HTTP_Scheme[] = "http://";
+static const char pcOTA_HTTPS_Scheme[] = "https://";
+static const char pcOTA_HTTP_ContentLengthHeader[] = "content-length:";
+static const char pcOTA_HTTP_ConnectionHeader[] = "connection:";
+static const char pcOTA_HTTP_CloseToken[] = "close";
+static const char pcOTA_HTTP_RequestTemplate[] = "GET %.*s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%u-%u\r\n\r\n";
+static const char pcOTA_HTTP_RequestTailTemplate[] = " HTTP/1.1\r\nHost: %s\r\nRange: bytes=%u-%u\r\n\r\n";
+
+/*-----------------------------------------------------------*/
+
+/* Case insensitive compare of pcText against the lower case pcToken. */
+
+static BaseType_t prvMatchToken( const char * pcText,
+                                 const char * pcEnd,
+                                 const char * pcToken )
+{
+    BaseType_t xMatch = pdTRUE;
+    char cChar;
+
+    while( ( *pcToken != '\0' ) && ( xMatch == pdTRUE ) )
+    {
+        if( pcText >= pcEnd )
+        {
+            xMatch = pdFALSE;
+        }
+        else
+        {
+            cChar = *pcText;
+
+            if( ( cChar >= 'A' ) && ( cChar <= 'Z' ) )
+            {
+                cChar = ( char ) ( cChar + ( 'a' - 'A' ) );
+            }
+
+            if( cChar != *pcToken )
+            {
+                xMatch = pdFALSE;
+            }
+
+            pcText++;
+            pcToken++;
+        }
+    }
+
+    return xMatch;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Parse an unsigned decimal number, skipping leading white space. */
+
+static BaseType_t prvParseUInt( const char * pcText,
+                                const char * pcEnd,
+                                uint32_t * pulValue )
+{
+    BaseType_t xFound = pdFALSE;
+    uint32_t ulValue = 0UL;
+
+    while( ( pcText < pcEnd ) && ( ( *pcText == ' ' ) || ( *pcText == '\t' ) ) )
+    {
+        pcText++;
+    }
+
+    while( ( pcText < pcEnd ) && ( *pcText >= '0' ) && ( *pcText <= '9' ) )
+    {
+        ulValue = ( ulValue * 10UL ) + ( uint32_t ) ( *pcText - '0' );
+        xFound = pdTRUE;
+        pcText++;
+    }
+
+    *pulValue = ulValue;
+
+    return xFound;
+}
+
+/*-----------------------------------------------------------*/
+
+OTA_HttpResult_t OTA_HTTP_ParseResponseHeader( const char * pcHeader,
+                                               uint32_t ulHeaderLen,
+                                               uint32_t * pulStatus,
+                                               uint32_t * pulContentLength,
+                                               BaseType_t * pxKeepAlive )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_BadResponse;
+    const char * pcEnd;
+    const char * pcLine;
+    const char * pcLineEnd;
+    BaseType_t xHaveLength = pdFALSE;
+
+    if( ( pcHeader == NULL ) || ( pulStatus == NULL ) || ( pulContentLength == NULL ) || ( pxKeepAlive == NULL ) )
+    {
+        eResult = eOTA_HTTP_BadParams;
+    }
+    /* Status line, e.g. "HTTP/1.1 206 Partial Content". */
+    else if( ( ulHeaderLen > 12UL ) && ( prvMatchToken( pcHeader, &pcHeader[ ulHeaderLen ], "http/1." ) == pdTRUE ) &&
+             ( prvParseUInt( &pcHeader[ 8 ], &pcHeader[ ulHeaderLen ], pulStatus ) == pdTRUE ) )
+    {
+        pcEnd = &pcHeader[ ulHeaderLen ];
+
+        /* HTTP/1.1 connections are persistent unless the server says otherwise. */
+        *pxKeepAlive = ( pcHeader[ 7 ] == '1' ) ? pdTRUE : pdFALSE;
+        *pulContentLength = 0UL;
+
+        pcLine = ( const char * ) memchr( pcHeader, '\n', ulHeaderLen );
+
+        while( pcLine != NULL )
+        {
+            pcLine++;
+            pcLineEnd = ( const char * ) memchr( pcLine, '\n', ( size_t ) ( pcEnd - pcLine ) );
+
+            if( pcLineEnd == NULL )
+            {
+                pcLineEnd = pcEnd;
+            }
+
+            if( prvMatchToken( pcLine, pcLineEnd, pcOTA_HTTP_ContentLengthHeader ) == pdTRUE )
+            {
+                xHaveLength = prvParseUInt( &pcLine[ sizeof( pcOTA_HTTP_ContentLengthHeader ) - 1U ], pcLineEnd, pulContentLength );
+            }
+            else if( prvMatchToken( pcLine, pcLineEnd, pcOTA_HTTP_ConnectionHeader ) == pdTRUE )
+            {
+                pcLine = &pcLine[ sizeof( pcOTA_HTTP_ConnectionHeader ) - 1U ];
+
+                while( ( pcLine < pcLineEnd ) && ( *pcLine == ' ' ) )
+                {
+                    pcLine++;
+                }
+
+                if( prvMatchToken( pcLine, pcLineEnd, pcOTA_HTTP_CloseToken ) == pdTRUE )
+                {
+                    *pxKeepAlive = pdFALSE;
+                }
+                else
+                {
+                    *pxKeepAlive = pdTRUE;
+                }
+            }
+            else
+            {
+                /* Not a header we need. */
+            }
+
+            pcLine = ( pcLineEnd < pcEnd ) ? pcLineEnd : NULL;
+        }
+
+        /* Chunked responses have no Content-Length and are not supported. */
+        if( xHaveLength == pdTRUE )
+        {
+            eResult = eOTA_HTTP_Ok;
+        }
+    }
+    else
+    {
+        /* Not an HTTP response. */
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+OTA_HttpResult_t OTA_HTTP_Init( OTA_HttpClient_t * pxClient,
+                                const char * pcURL )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    const char * pcHost = NULL;
+    uint32_t ulHostLen = 0UL;
+    uint32_t ulPort = 0UL;
+
+    if( ( pxClient == NULL ) || ( pcURL == NULL ) )
+    {
+        eResult = eOTA_HTTP_BadParams;
+    }
+    else
+    {
+        memset( pxClient, 0, sizeof( OTA_HttpClient_t ) );
+        pxClient->xSocket = SOCKETS_INVALID_SOCKET;
+
+        if( prvMatchToken( pcURL, &pcURL[ strlen( pcURL ) ], pcOTA_HTTPS_Scheme ) == pdTRUE )
+        {
+            pxClient->xUseTLS = pdTRUE;
+            pxClient->usPort = OTA_HTTPS_DEFAULT_PORT;
+            pcHost = &pcURL[ sizeof( pcOTA_HTTPS_Scheme ) - 1U ];
+        }
+        else if( prvMatchToken( pcURL, &pcURL[ strlen( pcURL ) ], pcOTA_HTTP_Scheme ) == pdTRUE )
+        {
+            pxClient->xUseTLS = pdFALSE;
+            pxClient->usPort = OTA_HTTP_DEFAULT_PORT;
+            pcHost = &pcURL[ sizeof( pcOTA_HTTP_Scheme ) - 1U ];
+        }
+        else
+        {
+            eResult = eOTA_HTTP_BadURL;
+        }
+    }
+
+    if( eResult == eOTA_HTTP_Ok )
+    {
+        while( ( pcHost[ ulHostLen ] != '\0' ) && ( pcHost[ ulHostLen ] != ':' ) &&
+               ( pcHost[ ulHostLen ] != '/' ) && ( pcHost[ ulHostLen ] != '?' ) )
+        {
+            ulHostLen++;
+        }
+
+        pxClient->pcPath = &pcHost[ ulHostLen ];
+
+        if( *pxClient->pcPath == ':' )
+        {
+            if( prvParseUInt( &pxClient->pcPath[ 1 ], &pxClient->pcPath[ strlen( pxClient->pcPath ) ], &ulPort ) == pdTRUE )
+            {
+                pxClient->usPort = ( uint16_t ) ulPort;
+
+                do
+                {
+                    pxClient->pcPath++;
+                } while( ( *pxClient->pcPath >= '0' ) && ( *pxClient->pcPath <= '9' ) );
+            }
+
+            if( ( ulPort == 0UL ) || ( ulPort > 0xffffUL ) )
+            {
+                eResult = eOTA_HTTP_BadURL;
+            }
+        }
+
+        pxClient->ulPathLen = ( uint32_t ) strlen( pxClient->pcPath );
+
+        /* A request target must start with a slash. Paths are sent as they are in
+         * the URL since pre-signed URLs are already percent encoded. */
+        if( ( ulHostLen == 0UL ) || ( ulHostLen >= sizeof( pxClient->cHost ) ) ||
+            ( pxClient->ulPathLen == 0UL ) || ( *pxClient->pcPath != '/' ) )
+        {
+            eResult = eOTA_HTTP_BadURL;
+        }
+        else
+        {
+            memcpy( pxClient->cHost, pcHost, ulHostLen );
+            pxClient->cHost[ ulHostLen ] = '\0';
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Connect to the server named in the URL. */
+
+static OTA_HttpResult_t prvConnect( OTA_HttpClient_t * pxClient )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    SocketsSockaddr_t xServerAddress;
+    const TickType_t xTimeout = pdMS_TO_TICKS( otaconfigHTTP_TIMEOUT_MS );
+    const char * pcChar;
+    BaseType_t xIsIPAddress = pdTRUE;
+
+    xServerAddress.ulAddress = SOCKETS_GetHostByName( pxClient->cHost );
+
+    if( xServerAddress.ulAddress == 0UL )
+    {
+        eResult = eOTA_HTTP_ConnectFailed;
+    }
+    else
+    {
+        pxClient->xSocket = SOCKETS_Socket( SOCKETS_AF_INET, SOCKETS_SOCK_STREAM, SOCKETS_IPPROTO_TCP );
+
+        if( pxClient->xSocket == SOCKETS_INVALID_SOCKET )
+        {
+            eResult = eOTA_HTTP_ConnectFailed;
+        }
+    }
+
+    if( eResult == eOTA_HTTP_Ok )
+    {
+        xServerAddress.ucLength = sizeof( SocketsSockaddr_t );
+        xServerAddress.ucSocketDomain = SOCKETS_AF_INET;
+        xServerAddress.usPort = SOCKETS_htons( pxClient->usPort );
+
+        ( void ) SOCKETS_SetSockOpt( pxClient->xSocket, 0, SOCKETS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+        ( void ) SOCKETS_SetSockOpt( pxClient->xSocket, 0, SOCKETS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+
+        if( pxClient->xUseTLS == pdTRUE )
+        {
+            ( void ) SOCKETS_SetSockOpt( pxClient->xSocket, 0, SOCKETS_SO_REQUIRE_TLS, NULL, ( size_t ) 0 );
+
+            #ifdef otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE
+                if( SOCKETS_SetSockOpt( pxClient->xSocket, 0, SOCKETS_SO_TRUSTED_SERVER_CERTIFICATE,
+                                        otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE,
+                                        sizeof( otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE ) ) != SOCKETS_ERROR_NONE )
+                {
+                    eResult = eOTA_HTTP_ConnectFailed;
+                }
+            #endif
+
+            for( pcChar = pxClient->cHost; *pcChar != '\0'; pcChar++ )
+            {
+                if( ( *pcChar != '.' ) && ( ( *pcChar < '0' ) || ( *pcChar > '9' ) ) )
+                {
+                    xIsIPAddress = pdFALSE;
+                }
+            }
+
+            /* Name based virtual hosting (as used by S3) needs the server name indication. */
+            if( ( eResult == eOTA_HTTP_Ok ) && ( xIsIPAddress == pdFALSE ) )
+            {
+                if( SOCKETS_SetSockOpt( pxClient->xSocket, 0, SOCKETS_SO_SERVER_NAME_INDICATION,
+                                        pxClient->cHost, strlen( pxClient->cHost ) + 1U ) != SOCKETS_ERROR_NONE )
+                {
+                    eResult = eOTA_HTTP_ConnectFailed;
+                }
+            }
+        }
+
+        if( eResult == eOTA_HTTP_Ok )
+        {
+            if( SOCKETS_Connect( pxClient->xSocket, &xServerAddress, ( Socklen_t ) sizeof( xServerAddress ) ) != SOCKETS_ERROR_NONE )
+            {
+                eResult = eOTA_HTTP_ConnectFailed;
+            }
+        }
+
+        if( eResult != eOTA_HTTP_Ok )
+        {
+            ( void ) SOCKETS_Close( pxClient->xSocket );
+            pxClient->xSocket = SOCKETS_INVALID_SOCKET;
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send all of the data, retrying partial sends. */
+
+static OTA_HttpResult_t prvSendAll( OTA_HttpClient_t * pxClient,
+                                    const char * pcData,
+                                    uint32_t ulLen )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    int32_t lSent;
+
+    while( ( ulLen > 0UL ) && ( eResult == eOTA_HTTP_Ok ) )
+    {
+        lSent = SOCKETS_Send( pxClient->xSocket, pcData, ( size_t ) ulLen, 0UL );
+
+        if( lSent <= 0 )
+        {
+            eResult = eOTA_HTTP_SendFailed;
+        }
+        else
+        {
+            pcData = &pcData[ lSent ];
+            ulLen -= ( uint32_t ) lSent;
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send the GET request for the range [ulFirst, ulLast]. */
+
+static OTA_HttpResult_t prvSendRequest( OTA_HttpClient_t * pxClient,
+                                        uint32_t ulFirst,
+                                        uint32_t ulLast )
+{
+    OTA_HttpResult_t eResult;
+    int32_t lLen;
+
+    lLen = snprintf( pxClient->cHeader, /*lint -e586 Intentionally using snprintf. */
+                     sizeof( pxClient->cHeader ),
+                     pcOTA_HTTP_RequestTemplate,
+                     ( int ) pxClient->ulPathLen,
+                     pxClient->pcPath,
+                     pxClient->cHost,
+                     ( unsigned int ) ulFirst,
+                     ( unsigned int ) ulLast );
+
+    if( ( lLen > 0 ) && ( ( uint32_t ) lLen < sizeof( pxClient->cHeader ) ) )
+    {
+        eResult = prvSendAll( pxClient, pxClient->cHeader, ( uint32_t ) lLen );
+    }
+    else
+    {
+        /* Pre-signed URLs carry long query strings so send the path on its own. */
+        eResult = prvSendAll( pxClient, "GET ", 4UL );
+
+        if( eResult == eOTA_HTTP_Ok )
+        {
+            eResult = prvSendAll( pxClient, pxClient->pcPath, pxClient->ulPathLen );
+        }
+
+        if( eResult == eOTA_HTTP_Ok )
+        {
+            lLen = snprintf( pxClient->cHeader, /*lint -e586 Intentionally using snprintf. */
+                             sizeof( pxClient->cHeader ),
+                             pcOTA_HTTP_RequestTailTemplate,
+                             pxClient->cHost,
+                             ( unsigned int ) ulFirst,
+                             ( unsigned int ) ulLast );
+
+            if( ( lLen > 0 ) && ( ( uint32_t ) lLen < sizeof( pxClient->cHeader ) ) )
+            {
+                eResult = prvSendAll( pxClient, pxClient->cHeader, ( uint32_t ) lLen );
+            }
+            else
+            {
+                eResult = eOTA_HTTP_BadURL;
+            }
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Receive the response header into cHeader. On success *pulHeaderLen is the length
+ * of the header including the empty line and *pulReceived the number of bytes in
+ * cHeader, so any bytes after the header are the start of the body. */
+
+static OTA_HttpResult_t prvReceiveHeader( OTA_HttpClient_t * pxClient,
+                                          uint32_t * pulHeaderLen,
+                                          uint32_t * pulReceived )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    uint32_t ulReceived = 0UL;
+    uint32_t ulScan = 0UL;
+    int32_t lRecv;
+
+    *pulHeaderLen = 0UL;
+
+    while( ( *pulHeaderLen == 0UL ) && ( eResult == eOTA_HTTP_Ok ) )
+    {
+        if( ulReceived >= sizeof( pxClient->cHeader ) )
+        {
+            eResult = eOTA_HTTP_BadResponse; /* The header does not fit. */
+        }
+        else
+        {
+            lRecv = SOCKETS_Recv( pxClient->xSocket,
+                                  &pxClient->cHeader[ ulReceived ],
+                                  sizeof( pxClient->cHeader ) - ulReceived,
+                                  0UL );
+
+            if( lRecv <= 0 )
+            {
+                eResult = eOTA_HTTP_RecvFailed;
+            }
+            else
+            {
+                ulReceived += ( uint32_t ) lRecv;
+
+                /* Only scan the new bytes (plus the three before them) for the empty line. */
+                for( ulScan = ( ulScan > 3UL ) ? ( ulScan - 3UL ) : 0UL; ( ulScan + 3UL ) < ulReceived; ulScan++ )
+                {
+                    if( memcmp( &pxClient->cHeader[ ulScan ], "\r\n\r\n", 4 ) == 0 )
+                    {
+                        *pulHeaderLen = ulScan + 4UL;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    *pulReceived = ulReceived;
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Receive the body, passing it to the callback a buffer at a time. */
+
+static OTA_HttpResult_t prvReceiveBody( OTA_HttpClient_t * pxClient,
+                                        const char * pcInitial,
+                                        uint32_t ulInitialLen,
+                                        uint32_t ulOffset,
+                                        uint32_t ulLength,
+                                        uint8_t * pucBuf,
+                                        uint32_t ulBufSize,
+                                        OTA_HttpBodyCallback_t xCallback,
+                                        void * pvContext )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    uint32_t ulReceived = 0UL;
+    uint32_t ulFill = 0UL;
+    uint32_t ulWant;
+    int32_t lRecv;
+
+    while( ( ulReceived < ulLength ) && ( eResult == eOTA_HTTP_Ok ) )
+    {
+        ulWant = ulBufSize - ulFill;
+
+        if( ulWant > ( ulLength - ulReceived ) )
+        {
+            ulWant = ulLength - ulReceived;
+        }
+
+        /* Bytes that arrived with the header come first. */
+        if( ulInitialLen > 0UL )
+        {
+            lRecv = ( int32_t ) ( ( ulInitialLen < ulWant ) ? ulInitialLen : ulWant );
+            memcpy( &pucBuf[ ulFill ], pcInitial, ( size_t ) lRecv );
+            pcInitial = &pcInitial[ lRecv ];
+            ulInitialLen -= ( uint32_t ) lRecv;
+        }
+        else
+        {
+            lRecv = SOCKETS_Recv( pxClient->xSocket, &pucBuf[ ulFill ], ( size_t ) ulWant, 0UL );
+        }
+
+        if( lRecv <= 0 )
+        {
+            eResult = eOTA_HTTP_RecvFailed;
+        }
+        else
+        {
+            ulFill += ( uint32_t ) lRecv;
+            ulReceived += ( uint32_t ) lRecv;
+
+            if( ( ulFill == ulBufSize ) || ( ulReceived == ulLength ) )
+            {
+                if( xCallback( pvContext, ( ulOffset + ulReceived ) - ulFill, pucBuf, ulFill ) != pdTRUE )
+                {
+                    eResult = eOTA_HTTP_BodyRejected;
+                }
+
+                ulFill = 0UL;
+            }
+        }
+    }
+
+    /* Anything beyond the body would leave the connection out of step. */
+    if( ( eResult == eOTA_HTTP_Ok ) && ( ulInitialLen > 0UL ) )
+    {
+        eResult = eOTA_HTTP_BadResponse;
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+OTA_HttpResult_t OTA_HTTP_GetRange( OTA_HttpClient_t * pxClient,
+                                    uint32_t ulOffset,
+                                    uint32_t ulLength,
+                                    uint8_t * pucBuf,
+                                    uint32_t ulBufSize,
+                                    OTA_HttpBodyCallback_t xCallback,
+                                    void * pvContext )
+{
+    OTA_HttpResult_t eResult = eOTA_HTTP_Ok;
+    BaseType_t xReused;
+    BaseType_t xKeepAlive = pdFALSE;
+    uint32_t ulStatus = 0UL;
+    uint32_t ulContentLength = 0UL;
+    uint32_t ulHeaderLen = 0UL;
+    uint32_t ulReceived = 0UL;
+    uint32_t ulAttempt;
+
+    if( ( pxClient == NULL ) || ( pucBuf == NULL ) || ( ulBufSize == 0UL ) || ( xCallback == NULL ) || ( ulLength == 0UL ) )
+    {
+        eResult = eOTA_HTTP_BadParams;
+    }
+    else
+    {
+        /* A kept alive connection may have been closed by the server while idle. That
+         * shows up as a failure before any response byte so retry once on a new one. */
+        for( ulAttempt = 0UL; ulAttempt < 2UL; ulAttempt++ )
+        {
+            xReused = ( pxClient->xSocket != SOCKETS_INVALID_SOCKET ) ? pdTRUE : pdFALSE;
+            eResult = eOTA_HTTP_Ok;
+            ulReceived = 0UL;
+
+            if( xReused == pdFALSE )
+            {
+                eResult = prvConnect( pxClient );
+            }
+
+            if( eResult == eOTA_HTTP_Ok )
+            {
+                eResult = prvSendRequest( pxClient, ulOffset, ( ulOffset + ulLength ) - 1UL );
+            }
+
+            if( eResult == eOTA_HTTP_Ok )
+            {
+                eResult = prvReceiveHeader( pxClient, &ulHeaderLen, &ulReceived );
+            }
+
+            if( ( xReused == pdTRUE ) && ( ulReceived == 0UL ) &&
+                ( ( eResult == eOTA_HTTP_SendFailed ) || ( eResult == eOTA_HTTP_RecvFailed ) ) )
+            {
+                OTA_HTTP_Close( pxClient );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if( eResult == eOTA_HTTP_Ok )
+        {
+            eResult = OTA_HTTP_ParseResponseHeader( pxClient->cHeader, ulHeaderLen, &ulStatus, &ulContentLength, &xKeepAlive );
+
+            if( ( eResult == eOTA_HTTP_Ok ) && ( ( ulStatus != OTA_HTTP_STATUS_PARTIAL ) || ( ulContentLength != ulLength ) ) )
+            {
+                eResult = eOTA_HTTP_BadResponse;
+            }
+        }
+
+        if( eResult == eOTA_HTTP_Ok )
+        {
+            eResult = prvReceiveBody( pxClient,
+                                      &pxClient->cHeader[ ulHeaderLen ],
+                                      ulReceived - ulHeaderLen,
+                                      ulOffset,
+                                      ulLength,
+                                      pucBuf,
+                                      ulBufSize,
+                                      xCallback,
+                                      pvContext );
+        }
+
+        if( ( eResult != eOTA_HTTP_Ok ) || ( xKeepAlive == pdFALSE ) )
+        {
+            OTA_HTTP_Close( pxClient );
+        }
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+void OTA_HTTP_Close( OTA_HttpClient_t * pxClient )
+{
+    if( ( pxClient != NULL ) && ( pxClient->xSocket != SOCKETS_INVALID_SOCKET ) )
+    {
+        ( void ) SOCKETS_Shutdown( pxClient->xSocket, ( uint32_t ) SOCKETS_SHUT_RDWR );
+        ( void ) SOCKETS_Close( pxClient->xSocket );
+        pxClient->xSocket = SOCKETS_INVALID_SOCKET;
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_ota_http.h
+ * @brief Minimal HTTP/1.1 range request client for the OTA data plane.
+ *
+ * The client downloads byte ranges of a file from a (typically pre-signed) URL over
+ * a single keep-alive connection. Secure sockets provides the transport so https
+ * URLs are served over TLS. Only what the OTA agent needs is implemented: GET with
+ * a Range header, a Content-Length delimited 206 response and connection reuse.
+ *
+ * https servers are verified against the default root certificates of the TLS
+ * layer, which are those of AWS IoT, unless otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE
+ * is defined. Pre-signed S3 URLs therefore fail by default, see below.
+ */
+
+#ifndef _AWS_OTA_HTTP_H_
+#define _AWS_OTA_HTTP_H_
+
+#include "FreeRTOS.h"
+#include "aws_ota_agent_config.h"
+#include "aws_secure_sockets.h"
+
+/**
+ * @brief Maximum number of file blocks fetched by a single range request.
+ *
+ * Larger values amortize the request and response headers over more data but
+ * delay the handling of other agent events until the response has been received.
+ */
+#ifndef otaconfigHTTP_BLOCKS_PER_REQUEST
+    #define otaconfigHTTP_BLOCKS_PER_REQUEST    8U
+#endif
+
+/**
+ * @brief Size of the buffer holding the request line and the response header.
+ */
+#ifndef otaconfigHTTP_HEADER_BUF_SIZE
+    #define otaconfigHTTP_HEADER_BUF_SIZE       512U
+#endif
+
+/**
+ * @brief Maximum length of the host name in the download URL, including the terminator.
+ */
+#ifndef otaconfigHTTP_MAX_HOST_SIZE
+    #define otaconfigHTTP_MAX_HOST_SIZE         128U
+#endif
+
+/**
+ * @brief Send and receive timeout of the HTTP connection.
+ */
+#ifndef otaconfigHTTP_TIMEOUT_MS
+    #define otaconfigHTTP_TIMEOUT_MS            5000U
+#endif
+
+/*
+ * otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE: root certificate that https download
+ * servers are verified against, in PEM format. It has no default.
+ *
+ * Left undefined, the TLS layer only trusts its default root certificates, VeriSign
+ * Class 3 G5, Amazon Root CA 1 and the Starfield cross-signing CA, which are the
+ * roots of the AWS IoT endpoints. The S3 endpoints of pre-signed URLs are not certified by these,
+ * so their downloads fail the TLS handshake and the job fails once the request
+ * momentum is used up. Define it in aws_ota_agent_config.h to the root certificate
+ * of the download server, as a string literal since its size is taken with sizeof:
+ *
+ *   #define otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE \
+ *       "-----BEGIN CERTIFICATE-----\n" \
+ *       ...
+ *       "-----END CERTIFICATE-----\n"
+ *
+ * It replaces the default root certificates for the download connection only.
+ */
+
+/* Results of the HTTP client. */
+typedef enum
+{
+    eOTA_HTTP_Ok = 0,         /* The operation completed. */
+    eOTA_HTTP_BadParams,      /* A NULL pointer or an empty range was supplied. */
+    eOTA_HTTP_BadURL,         /* The URL is not an http or https URL this client can handle. */
+    eOTA_HTTP_ConnectFailed,  /* The server could not be reached. */
+    eOTA_HTTP_SendFailed,     /* The request could not be sent. */
+    eOTA_HTTP_RecvFailed,     /* The connection failed or timed out while receiving. */
+    eOTA_HTTP_BadResponse,    /* The response was malformed or not the requested range. */
+    eOTA_HTTP_BodyRejected    /* The body callback refused the data. */
+} OTA_HttpResult_t;
+
+/**
+ * @brief Callback receiving the body of a range response.
+ *
+ * @param[in] pvContext The context passed to OTA_HTTP_GetRange().
+ * @param[in] ulOffset File offset of the first byte in pucData.
+ * @param[in] pucData Body data. Every call except the last one delivers a full buffer.
+ * @param[in] ulSize Number of bytes in pucData.
+ *
+ * @return pdTRUE to continue receiving, pdFALSE to stop.
+ */
+typedef BaseType_t (* OTA_HttpBodyCallback_t)( void * pvContext,
+                                               uint32_t ulOffset,
+                                               uint8_t * pucData,
+                                               uint32_t ulSize );
+
+/**
+ * @brief HTTP client state.
+ *
+ * The URL is not copied; it must stay valid for as long as the client is used.
+ */
+typedef struct OTA_HttpClient
+{
+    Socket_t xSocket;                              /* Connection to the server or SOCKETS_INVALID_SOCKET. */
+    const char * pcPath;                           /* Path and query of the URL. */
+    uint32_t ulPathLen;                            /* Length of pcPath. */
+    uint16_t usPort;                               /* Server port. */
+    BaseType_t xUseTLS;                            /* pdTRUE for https URLs. */
+    char cHost[ otaconfigHTTP_MAX_HOST_SIZE ];     /* NUL terminated host name. */
+    char cHeader[ otaconfigHTTP_HEADER_BUF_SIZE ]; /* Request and response header staging. */
+} OTA_HttpClient_t;
+
+/**
+ * @brief Prepare a client for the given http:// or https:// URL.
+ *
+ * No connection is made until the first request.
+ */
+OTA_HttpResult_t OTA_HTTP_Init( OTA_HttpClient_t * pxClient,
+                                const char * pcURL );
+
+/**
+ * @brief Download ulLength bytes of the file starting at ulOffset.
+ *
+ * The existing connection is reused if the server kept it open, otherwise a new
+ * one is made. The body is received into pucBuf and passed to xCallback each time
+ * ulBufSize bytes have been received and once more for the remainder. The connection
+ * is closed on any error so the next request starts afresh.
+ */
+OTA_HttpResult_t OTA_HTTP_GetRange( OTA_HttpClient_t * pxClient,
+                                    uint32_t ulOffset,
+                                    uint32_t ulLength,
+                                    uint8_t * pucBuf,
+                                    uint32_t ulBufSize,
+                                    OTA_HttpBodyCallback_t xCallback,
+                                    void * pvContext );
+
+/**
+ * @brief Close the connection to the server, if any.
+ */
+void OTA_HTTP_Close( OTA_HttpClient_t * pxClient );
+
+/**
+ * @brief Parse a response header terminated by an empty line.
+ *
+ * @param[in] pcHeader The response header, not necessarily NUL terminated.
+ * @param[in] ulHeaderLen Length of the header including the terminating empty line.
+ * @param[out] pulStatus HTTP status code.
+ * @param[out] pulContentLength Value of the Content-Length header.
+ * @param[out] pxKeepAlive pdFALSE if the server will close the connection after the response.
+ *
+ * @return eOTA_HTTP_Ok if the status line and Content-Length were found.
+ */
+OTA_HttpResult_t OTA_HTTP_ParseResponseHeader( const char * pcHeader,
+                                               uint32_t ulHeaderLen,
+                                               uint32_t * pulStatus,
+                                               uint32_t * pulContentLength,
+                                               BaseType_t * pxKeepAlive );
+
+#endif /* ifndef _AWS_OTA_HTTP_H_ */
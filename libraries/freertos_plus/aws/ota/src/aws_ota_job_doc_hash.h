@@ -0,0 +1,54 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Generated from aws_iot_ota_agent.c by ota_job_doc_hash.cmake, do not edit. The
+ * OTA module fails to configure when this file does not match the agent. */
+
+#ifndef _AWS_OTA_JOB_DOC_HASH_H_
+#define _AWS_OTA_JOB_DOC_HASH_H_
+
+/* The number of parameters of the job document model. */
+#define OTA_JOB_DOC_HASH_NUM_PARAMS    19U
+
+/* The seed that gives every hashed key its own slot. */
+#define OTA_JOB_DOC_HASH_SEED          0x3669781BUL
+
+/* The parameters compared directly: cOTA_JSON_FileSignatureKey. */
+#define OTA_JOB_DOC_HASH_UNHASHED      0x00004000UL
+
+/* Model parameter index plus one of each slot, or zero. */
+#define OTA_JOB_DOC_HASH_SLOTS \
+    { \
+         0,  5,  0,  0,  0,  0,  0, 13,  0, 14,  0,  0,  0, 19,  0,  0, \
+         2,  0,  0,  0,  0,  0,  0,  0,  7,  0, 17, 11,  0,  0,  0,  0, \
+         0,  0,  0,  0,  0,  0,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0, \
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,  0,  0,  0, \
+         0,  0,  0,  0,  0,  0,  4,  0, 10,  0, 16,  0,  0,  0, 18,  0, \
+         0, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, \
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, \
+         0,  0,  0,  3,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,  6 \
+    }
+
+#endif /* ifndef _AWS_OTA_JOB_DOC_HASH_H_ */
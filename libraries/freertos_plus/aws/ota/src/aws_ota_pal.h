@@ -133,6 +133,59 @@ int16_t prvPAL_WriteBlock( OTA_FileContext_t * const C,
                            uint8_t * const pcData,
                            uint32_t ulBlockSize );
 
+/**
+ * @brief Reopen the receive file of an interrupted transfer.
+ *
+ * Like prvPAL_CreateFileForRx() but the blocks already written to the partition or file
+ * must be preserved. The OTA agent calls this instead of prvPAL_CreateFileForRx() when
+ * the transfer state saved by prvPAL_SaveTransferState() matches the new job.
+ *
+ * @note C->ulImageOffset holds the write frontier of the interrupted transfer.
+ *
+ * @param[in] C OTA file context information.
+ *
+ * @return The OTA PAL layer error code combined with the MCU specific error code. See OTA Agent
+ * error codes information in aws_ota_agent.h.
+ *
+ * kOTA_Err_None is returned when the file was reopened.
+ * kOTA_Err_RxFileCreateFailed is returned if the file can't be reopened. The agent then
+ * starts the transfer over with prvPAL_CreateFileForRx().
+ */
+OTA_Err_t prvPAL_ResumeFileForRx( OTA_FileContext_t * const C );
+
+/**
+ * @brief Persist the transfer state of the active OTA file.
+ *
+ * The state is opaque to the PAL. It must survive a reset and replace any state
+ * saved before.
+ *
+ * @param[in] pucState The transfer state.
+ * @param[in] ulStateSize The size of the transfer state in bytes.
+ *
+ * @return kOTA_Err_None on success or kOTA_Err_RxFileCreateFailed if the state couldn't be saved.
+ */
+OTA_Err_t prvPAL_SaveTransferState( const uint8_t * pucState,
+                                    uint32_t ulStateSize );
+
+/**
+ * @brief Read back the transfer state saved by prvPAL_SaveTransferState().
+ *
+ * @param[out] pucState Buffer receiving the transfer state.
+ * @param[in,out] pulStateSize The size of pucState on input, the size of the saved state on output.
+ *
+ * @return kOTA_Err_None on success or kOTA_Err_NoResumeState if there is no saved
+ * state or it doesn't fit in pucState.
+ */
+OTA_Err_t prvPAL_LoadTransferState( uint8_t * pucState,
+                                    uint32_t * pulStateSize );
+
+/**
+ * @brief Delete the saved transfer state, if any.
+ *
+ * @return kOTA_Err_None on success.
+ */
+OTA_Err_t prvPAL_ClearTransferState( void );
+
 /**
  * @brief Activate the newest MCU image received via OTA.
  *
@@ -30,10 +30,13 @@
 /* Standard includes. */
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
+#include <stdio.h>
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 
 #include "unity_fixture.h"
 #include "unity.h"
@@ -42,6 +45,7 @@
 #include "aws_ota_agent.h"
 #include "aws_clientcredential.h"
 #include "aws_ota_agent_internal.h"
+#include "aws_ota_job_doc_hash.h"
 
 /* Test network header include. */
 #include IOT_TEST_NETWORK_HEADER
@@ -63,6 +67,10 @@
 #define otatestCERT_FILE                  "rsasigner.crt"
 #define otatestATTRIBUTES                 3
 #define otatestFILE_ID                    0
+#define otatestBENCH_ITERATIONS           200U  /* Number of times the benchmark parses the job document. */
+#define otatestBENCH_URL_LENGTH           1024U /* Length of the pre-signed URL in the benchmark job document. */
+#define otatestBENCH_JSON_SIZE            ( 2048U + otatestBENCH_URL_LENGTH )
+#define otatestBENCH_DONT_STORE           0xffffffffUL /* Model destination of parameters that are only checked. */
 static const uint8_t ucOtatestSIGNATURE[] =
 {
     0x38, 0x78, 0xf9, 0xb0, 0xd8, 0xf1, 0xa8, 0xc3, 0x4a, 0xdd, 0x63, 0x44, 0xc1, 0xbc, 0x9f, 0xb3,
@@ -113,11 +121,35 @@ static const uint8_t ucOtatestSIGNATURE[] =
  */
 #define otatestLASER_JSON_WITH_SELF_TEST         "{\"clientToken\":\"mytoken\",\"timestamp\":1508445004,\"execution\":{\"self_test\":\"true\",\"jobId\":\"15\",\"status\":\"QUEUED\",\"queuedAt\":1507697924,\"lastUpdatedAt\":1507697924,\"versionNumber\":1,\"executionNumber\":1,\"jobDocument\":{\"afr_ota\": {\"streamname\": \"1\",\"files\": [{\"filepath\": \"payload.bin\",\"version\":\"1.0.0.0\",\"filesize\": 90860,\"fileid\": 0,\"attr\": 3,\"certfile\":\"rsasigner.crt\", \"" otatestVALID_SIG_METHOD "\":\"OHj5sNjxqMNK3WNEwbyfs/PeSSS1kzLkAQ4MSu0yKNFoGxJrUKuIWhjQbQiPlXcDtXlSXE8ydAwoxnnw5lcwpJsbXxD1K1PwZJoc/3mv5XHXbvvEoFr4yA0rhY4tyrMDBesEtOVrW0yI4mM4Lde5OtdIxo8sjTSPGXo2Ejuhn+LDRD3gKdb1gtPpoJ/YBQmYKXHFQ5QW58GOSlB9prq5v+MloVCATjmzb9tu4msScXYYy41ikEhK2eyfl7/vpc2vMNX6uhyyeZhku9namI4OZmsp72tLL4D4pFt4/nDWYSAo8sQAwns1RNY+j52KfvgvKKN3u6G3suFyVQoxWJu3aA==\"}]}}}}"
 
+/**
+ * @brief Compressed file without the size of the decompressed image, which bounds the output.
+ */
+#define otatestLASER_JSON_COMPRESSED_NO_IMAGE_SIZE    "{\"clientToken\":\"mytoken\",\"timestamp\":1508445004,\"execution\":{\"jobId\":\"15\",\"status\":\"QUEUED\",\"queuedAt\":1507697924,\"lastUpdatedAt\":1507697924,\"versionNumber\":1,\"executionNumber\":1,\"jobDocument\":{\"afr_ota\": {\"streamname\": \"1\",\"files\": [{\"filepath\": \"payload.bin\",\"version\":\"1.0.0.0\",\"filesize\": 90860,\"fileid\": 0,\"attr\": 3,\"compression\": 1,\"certfile\":\"rsasigner.crt\", \"" otatestVALID_SIG_METHOD "\":\"OHj5sNjxqMNK3WNEwbyfs/PeSSS1kzLkAQ4MSu0yKNFoGxJrUKuIWhjQbQiPlXcDtXlSXE8ydAwoxnnw5lcwpJsbXxD1K1PwZJoc/3mv5XHXbvvEoFr4yA0rhY4tyrMDBesEtOVrW0yI4mM4Lde5OtdIxo8sjTSPGXo2Ejuhn+LDRD3gKdb1gtPpoJ/YBQmYKXHFQ5QW58GOSlB9prq5v+MloVCATjmzb9tu4msScXYYy41ikEhK2eyfl7/vpc2vMNX6uhyyeZhku9namI4OZmsp72tLL4D4pFt4/nDWYSAo8sQAwns1RNY+j52KfvgvKKN3u6G3suFyVQoxWJu3aA==\"}]}}}}"
+
 /**
  * @brief Shared MQTT client handle, used across setup, tests, and teardown.
  * But only used by one test at a time. */
 static IotMqttConnection_t xMQTTClientHandle = NULL;
 
+/**
+ * @brief Destination of the parameters extracted by the parser benchmark.
+ */
+typedef struct
+{
+    const char * pcJobId;
+    const char * pcStreamName;
+    const char * pcFilePath;
+    const char * pcCertFile;
+    const char * pcUrl;
+    uint32_t ulFileSize;
+    uint32_t ulFileId;
+    uint32_t ulAttributes;
+    Sig256_t * pxSignature;
+} BenchJobDoc_t;
+
+static BenchJobDoc_t xBenchJobDoc;
+static char cBenchJSON[ otatestBENCH_JSON_SIZE ];
+
 /**
  * @brief Application-defined callback for the OTA agent.
  */
@@ -184,6 +216,7 @@ TEST_GROUP_RUNNER( Full_OTA_AGENT )
     RUN_TEST_CASE( Full_OTA_AGENT, OTA_SetImageState_InvalidParams );
     RUN_TEST_CASE( Full_OTA_AGENT, prvParseJobDocFromJSONandPrvOTA_Close );
     RUN_TEST_CASE( Full_OTA_AGENT, prvParseJSONbyModel_Errors );
+    RUN_TEST_CASE( Full_OTA_AGENT, prvParseJSONbyModel_Benchmark );
 }
 
 TEST( Full_OTA_AGENT, OTA_SetImageState_InvalidParams )
@@ -237,6 +270,7 @@ TEST( Full_OTA_AGENT, prvParseJobDocFromJSONandPrvOTA_Close )
             /* Check the various document field conversions. */
             TEST_ASSERT_EQUAL_STRING( otatestSTREAM_NAME, pxUpdateFile->pucStreamName );
             TEST_ASSERT_EQUAL( otatestFILE_SIZE, pxUpdateFile->ulFileSize );
+            TEST_ASSERT_EQUAL( otatestFILE_SIZE, pxUpdateFile->ulImageSize );
             TEST_ASSERT_EQUAL_STRING( otatestFILE_PATH, pxUpdateFile->pucFilePath );
             TEST_ASSERT_EQUAL_STRING( otatestCERT_FILE, pxUpdateFile->pucCertFilepath );
             TEST_ASSERT_EQUAL( otatestATTRIBUTES, pxUpdateFile->ulFileAttributes );
@@ -376,8 +410,136 @@ TEST( Full_OTA_AGENT, prvParseJSONbyModel_Errors )
         /* Ensure that a JSON document containing bad base64 character is rejected. */
         TEST_ASSERT_EQUAL( NULL, TEST_OTA_prvParseJobDoc( otatestLASER_JSON_WITH_BAD_BASE64,
                                                           sizeof( otatestLASER_JSON_WITH_BAD_BASE64 ) ) );
+
+        /* Ensure that a compressed file is rejected if the decompressed size is unknown. */
+        TEST_ASSERT_EQUAL( NULL, TEST_OTA_prvParseJobDoc( otatestLASER_JSON_COMPRESSED_NO_IMAGE_SIZE,
+                                                          sizeof( otatestLASER_JSON_COMPRESSED_NO_IMAGE_SIZE ) ) );
     }
 
     /* Shut down the OTA Agent. */
     ( void ) OTA_AgentShutdown( pdMS_TO_TICKS( otatestSHUTDOWN_WAIT ) );
 }
+
+/*-----------------------------------------------------------*/
+
+/* Parse the benchmark document otatestBENCH_ITERATIONS times and return the elapsed time in ms. */
+
+static uint32_t prvBenchParseJobDoc( const JSON_DocModelHash_t * pxKeyHash )
+{
+    /* The job document model of the agent, in the same order so that the key hash of the
+     * agent applies, storing into a test structure. Strings are referenced in place so
+     * only the signature is allocated. */
+    static const JSON_DocParam_t xBenchModel[ OTA_JOB_DOC_HASH_NUM_PARAMS ] =
+    {
+        { "clientToken",            pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_StringInDoc, JSMN_STRING    },
+        { "execution",              pdTRUE,  { otatestBENCH_DONT_STORE                      }, eModelParamType_Object,      JSMN_OBJECT    },
+        { "jobId",                  pdTRUE,  { offsetof( BenchJobDoc_t, pcJobId )           }, eModelParamType_StringInDoc, JSMN_STRING    },
+        { "statusDetails",          pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_Object,      JSMN_OBJECT    },
+        { "self_test",              pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_Ident,       JSMN_STRING    },
+        { "updatedBy",              pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_UInt32,      JSMN_STRING    },
+        { "jobDocument",            pdTRUE,  { otatestBENCH_DONT_STORE                      }, eModelParamType_Object,      JSMN_OBJECT    },
+        { "afr_ota",                pdTRUE,  { otatestBENCH_DONT_STORE                      }, eModelParamType_Object,      JSMN_OBJECT    },
+        { "streamname",             pdTRUE,  { offsetof( BenchJobDoc_t, pcStreamName )      }, eModelParamType_StringInDoc, JSMN_STRING    },
+        { "files",                  pdTRUE,  { otatestBENCH_DONT_STORE                      }, eModelParamType_Array,       JSMN_ARRAY     },
+        { "filepath",               pdTRUE,  { offsetof( BenchJobDoc_t, pcFilePath )        }, eModelParamType_StringInDoc, JSMN_STRING    },
+        { "filesize",               pdTRUE,  { offsetof( BenchJobDoc_t, ulFileSize )        }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { "fileid",                 pdTRUE,  { offsetof( BenchJobDoc_t, ulFileId )          }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { "certfile",               pdTRUE,  { offsetof( BenchJobDoc_t, pcCertFile )        }, eModelParamType_StringInDoc, JSMN_STRING    },
+        { otatestVALID_SIG_METHOD,  pdTRUE,  { offsetof( BenchJobDoc_t, pxSignature )       }, eModelParamType_SigBase64,   JSMN_STRING    },
+        { "attr",                   pdFALSE, { offsetof( BenchJobDoc_t, ulAttributes )      }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { "compression",            pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { "imagesize",              pdFALSE, { otatestBENCH_DONT_STORE                      }, eModelParamType_UInt32,      JSMN_PRIMITIVE },
+        { "url",                    pdFALSE, { offsetof( BenchJobDoc_t, pcUrl )             }, eModelParamType_StringInDoc, JSMN_STRING    },
+    };
+    JSON_DocModel_t xDocModel;
+    uint32_t ulIteration, ulScanIndex;
+    TickType_t xStart = xTaskGetTickCount();
+
+    for( ulIteration = 0U; ulIteration < otatestBENCH_ITERATIONS; ulIteration++ )
+    {
+        memset( &xDocModel, 0, sizeof( xDocModel ) );
+        xDocModel.ulContextBase = ( uint32_t ) &xBenchJobDoc;
+        xDocModel.ulContextSize = sizeof( xBenchJobDoc );
+        xDocModel.pxBodyDef = xBenchModel;
+        xDocModel.usNumModelParams = ( uint16_t ) ( sizeof( xBenchModel ) / sizeof( xBenchModel[ 0 ] ) );
+        xDocModel.pxKeyHash = pxKeyHash;
+
+        for( ulScanIndex = 0U; ulScanIndex < xDocModel.usNumModelParams; ulScanIndex++ )
+        {
+            if( xBenchModel[ ulScanIndex ].bRequired == ( bool_t ) pdTRUE )
+            {
+                xDocModel.ulParamsRequiredBitmap |= ( 1UL << ulScanIndex );
+            }
+        }
+
+        TEST_ASSERT_EQUAL( eDocParseErr_None, TEST_OTA_prvParseJSONbyModel( cBenchJSON, strlen( cBenchJSON ), &xDocModel ) );
+
+        if( ulIteration < ( otatestBENCH_ITERATIONS - 1U ) )
+        {
+            vPortFree( xBenchJobDoc.pxSignature );
+            xBenchJobDoc.pxSignature = NULL;
+        }
+    }
+
+    return ( uint32_t ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_AGENT, prvParseJSONbyModel_Benchmark )
+{
+    /* The key hash the agent generates for its job document model. */
+    static const JSON_DocModelHash_t xKeyHash =
+    {
+        OTA_JOB_DOC_HASH_SEED,
+        OTA_JOB_DOC_HASH_UNHASHED,
+        OTA_JOB_DOC_HASH_SLOTS
+    };
+    char cUrl[ otatestBENCH_URL_LENGTH + 1U ];
+    uint32_t ulSearchMs, ulHashMs;
+
+    /* A job document as sent by the service for a file that may also be downloaded from a
+     * pre-signed URL. The URL and the signature make up most of the document. */
+    memset( cUrl, 'a', otatestBENCH_URL_LENGTH );
+    memcpy( cUrl, "https://", 8 );
+    cUrl[ otatestBENCH_URL_LENGTH ] = '\0';
+    ( void ) snprintf( cBenchJSON, sizeof( cBenchJSON ),
+                       "{\"clientToken\":\"mytoken\",\"timestamp\":1508445004,\"execution\":{\"jobId\":\"AFR_OTA-job-0123456789abcdef\","
+                       "\"status\":\"QUEUED\",\"statusDetails\":{\"updatedBy\":\"0x10000\"},\"queuedAt\":1507697924,"
+                       "\"lastUpdatedAt\":1507697924,\"versionNumber\":1,\"executionNumber\":1,\"jobDocument\":{\"afr_ota\":"
+                       "{\"protocols\":[\"MQTT\",\"HTTP\"],\"streamname\":\"AFR_OTA-stream-0123456789\",\"files\":[{\"filepath\":"
+                       "\"%s\",\"filesize\":%u,\"fileid\":%u,\"certfile\":\"%s\",\"url\":\"%s\",\"attr\":%u,\"%s\":\"%s\"}]}}}}",
+                       otatestFILE_PATH, otatestFILE_SIZE, otatestFILE_ID, otatestCERT_FILE, cUrl, otatestATTRIBUTES,
+                       otatestVALID_SIG_METHOD,
+                       "OHj5sNjxqMNK3WNEwbyfs/PeSSS1kzLkAQ4MSu0yKNFoGxJrUKuIWhjQbQiPlXcDtXlSXE8ydAwoxnnw5lcwpJsbXxD1K1PwZJoc/3mv5XHXbvvEoFr4yA0rhY4tyrMDBesEtOVrW0yI4mM4Lde5OtdIxo8sjTSPGXo2Ejuhn+LDRD3gKdb1gtPpoJ/YBQmYKXHFQ5QW58GOSlB9prq5v+MloVCATjmzb9tu4msScXYYy41ikEhK2eyfl7/vpc2vMNX6uhyyeZhku9namI4OZmsp72tLL4D4pFt4/nDWYSAo8sQAwns1RNY+j52KfvgvKKN3u6G3suFyVQoxWJu3aA==" );
+
+    memset( &xBenchJobDoc, 0, sizeof( xBenchJobDoc ) );
+
+    if( TEST_PROTECT() )
+    {
+        /* Search the model for every key, then look keys up in the perfect hash. The
+         * signature key is not hashed and is found by comparing it directly. */
+        ulSearchMs = prvBenchParseJobDoc( NULL );
+        vPortFree( xBenchJobDoc.pxSignature );
+        memset( &xBenchJobDoc, 0, sizeof( xBenchJobDoc ) );
+        ulHashMs = prvBenchParseJobDoc( &xKeyHash );
+
+        TEST_ASSERT_EQUAL( otatestFILE_SIZE, xBenchJobDoc.ulFileSize );
+        TEST_ASSERT_EQUAL( otatestFILE_ID, xBenchJobDoc.ulFileId );
+        TEST_ASSERT_EQUAL( otatestATTRIBUTES, xBenchJobDoc.ulAttributes );
+        TEST_ASSERT_NOT_NULL( xBenchJobDoc.pcUrl );
+        TEST_ASSERT_EQUAL( 0, strncmp( xBenchJobDoc.pcUrl, cUrl, otatestBENCH_URL_LENGTH ) );
+        TEST_ASSERT_EQUAL( sizeof( ucOtatestSIGNATURE ), xBenchJobDoc.pxSignature->usSize );
+
+        configPRINTF( ( "OTA job document parse: %u bytes, %u us per document searching the model, %u us with the key hash.\r\n",
+                        ( uint32_t ) strlen( cBenchJSON ),
+                        ( ulSearchMs * 1000U ) / otatestBENCH_ITERATIONS,
+                        ( ulHashMs * 1000U ) / otatestBENCH_ITERATIONS ) );
+    }
+
+    if( xBenchJobDoc.pxSignature != NULL )
+    {
+        vPortFree( xBenchJobDoc.pxSignature );
+        xBenchJobDoc.pxSignature = NULL;
+    }
+}
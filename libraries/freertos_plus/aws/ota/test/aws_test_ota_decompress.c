@@ -0,0 +1,402 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+#include "unity.h"
+
+/* OTA includes. */
+#include "aws_ota_decompress.h"
+
+/**
+ * @brief Configuration for this test group.
+ */
+#define otatestDECOMPRESS_IMAGE_SIZE         4096U  /* Size of the generated test image. */
+#define otatestDECOMPRESS_MAX_COMPRESSED     ( otatestDECOMPRESS_IMAGE_SIZE + ( otatestDECOMPRESS_IMAGE_SIZE / 8U ) + 1U )
+#define otatestDECOMPRESS_BLOCK_SIZE         1024U  /* Size of the pieces fed to the decoder, like OTA file blocks. */
+#define otatestDECOMPRESS_BENCH_ITERATIONS   64U    /* Number of times the image is decompressed by the benchmark. */
+
+#define otatestDECOMPRESS_WINDOW_SIZE        ( 1U << otaconfigDECOMPRESS_WINDOW_BITS )
+#define otatestDECOMPRESS_LOOKAHEAD_SIZE     ( 1U << otaconfigDECOMPRESS_LOOKAHEAD_BITS )
+#define otatestDECOMPRESS_MIN_MATCH          2U     /* Shorter matches cost more bits than literals. */
+
+/**
+ * @brief Output sink used by the tests.
+ */
+typedef struct
+{
+    uint8_t * pucBuffer;  /* Destination of the decompressed data. */
+    uint32_t ulCapacity;  /* Size of pucBuffer. */
+    uint32_t ulLength;    /* Number of bytes written so far. */
+    uint32_t ulCalls;     /* Number of times the output callback was invoked. */
+    uint32_t ulFailAfter; /* Refuse the data on this call (0 to never fail). */
+} TestSink_t;
+
+/**
+ * @brief MSB first bit writer used by the test encoder.
+ */
+typedef struct
+{
+    uint8_t * pucOut;
+    uint32_t ulCapacity;
+    uint32_t ulBytes;
+    uint8_t ucCurrent;
+    uint8_t ucUsed;
+} TestBitWriter_t;
+
+static uint8_t ucImage[ otatestDECOMPRESS_IMAGE_SIZE ];
+static uint8_t ucCompressed[ otatestDECOMPRESS_MAX_COMPRESSED ];
+static uint8_t ucOutput[ otatestDECOMPRESS_IMAGE_SIZE ];
+static OTA_Decompressor_t xDecompressor;
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestOutput( void * pvContext,
+                                 const uint8_t * pucData,
+                                 uint32_t ulSize )
+{
+    TestSink_t * pxSink = ( TestSink_t * ) pvContext;
+    BaseType_t xResult = pdFALSE;
+
+    pxSink->ulCalls++;
+
+    if( ( pxSink->ulFailAfter == 0U ) || ( pxSink->ulCalls < pxSink->ulFailAfter ) )
+    {
+        if( ( pxSink->ulLength + ulSize ) <= pxSink->ulCapacity )
+        {
+            memcpy( &pxSink->pucBuffer[ pxSink->ulLength ], pucData, ulSize );
+            pxSink->ulLength += ulSize;
+            xResult = pdTRUE;
+        }
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvPutBits( TestBitWriter_t * pxWriter,
+                        uint32_t ulValue,
+                        uint8_t ucCount )
+{
+    while( ucCount > 0U )
+    {
+        ucCount--;
+        pxWriter->ucCurrent = ( uint8_t ) ( ( pxWriter->ucCurrent << 1 ) | ( ( ulValue >> ucCount ) & 1U ) );
+        pxWriter->ucUsed++;
+
+        if( pxWriter->ucUsed == 8U )
+        {
+            TEST_ASSERT_LESS_THAN_UINT32( pxWriter->ulCapacity, pxWriter->ulBytes );
+            pxWriter->pucOut[ pxWriter->ulBytes ] = pxWriter->ucCurrent;
+            pxWriter->ulBytes++;
+            pxWriter->ucCurrent = 0U;
+            pxWriter->ucUsed = 0U;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Greedy heatshrink compatible encoder. It only needs to produce a valid stream
+ * for the tests, not the best compression ratio. */
+
+static uint32_t prvCompress( const uint8_t * pucIn,
+                             uint32_t ulInSize,
+                             uint8_t * pucOut,
+                             uint32_t ulOutCapacity )
+{
+    TestBitWriter_t xWriter = { pucOut, ulOutCapacity, 0U, 0U, 0U };
+    uint32_t ulPos = 0U;
+    uint32_t ulBestLen;
+    uint32_t ulBestDist;
+    uint32_t ulDist;
+    uint32_t ulLen;
+
+    while( ulPos < ulInSize )
+    {
+        ulBestLen = 0U;
+        ulBestDist = 0U;
+
+        for( ulDist = 1U; ( ulDist <= otatestDECOMPRESS_WINDOW_SIZE ) && ( ulDist <= ulPos ); ulDist++ )
+        {
+            ulLen = 0U;
+
+            while( ( ulLen < otatestDECOMPRESS_LOOKAHEAD_SIZE ) &&
+                   ( ( ulPos + ulLen ) < ulInSize ) &&
+                   ( pucIn[ ulPos + ulLen - ulDist ] == pucIn[ ulPos + ulLen ] ) )
+            {
+                ulLen++;
+            }
+
+            if( ulLen > ulBestLen )
+            {
+                ulBestLen = ulLen;
+                ulBestDist = ulDist;
+            }
+        }
+
+        if( ulBestLen > otatestDECOMPRESS_MIN_MATCH )
+        {
+            prvPutBits( &xWriter, 0U, 1U );
+            prvPutBits( &xWriter, ulBestDist - 1U, ( uint8_t ) otaconfigDECOMPRESS_WINDOW_BITS );
+            prvPutBits( &xWriter, ulBestLen - 1U, ( uint8_t ) otaconfigDECOMPRESS_LOOKAHEAD_BITS );
+            ulPos += ulBestLen;
+        }
+        else
+        {
+            prvPutBits( &xWriter, 1U, 1U );
+            prvPutBits( &xWriter, pucIn[ ulPos ], 8U );
+            ulPos++;
+        }
+    }
+
+    /* Pad the last byte with zeros. A tag bit of zero needs more bits than the
+     * padding can hold so the decoder ignores it. */
+    if( xWriter.ucUsed > 0U )
+    {
+        prvPutBits( &xWriter, 0U, ( uint8_t ) ( 8U - xWriter.ucUsed ) );
+    }
+
+    return xWriter.ulBytes;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Build a compressible image that looks a bit like firmware: runs of repeated
+ * records with a changing counter mixed with a few pseudo random bytes. */
+
+static void prvGenerateImage( void )
+{
+    uint32_t ulIndex;
+    uint32_t ulSeed = 0x1234567UL;
+
+    for( ulIndex = 0U; ulIndex < otatestDECOMPRESS_IMAGE_SIZE; ulIndex++ )
+    {
+        if( ( ulIndex % 64U ) < 48U )
+        {
+            ucImage[ ulIndex ] = ( uint8_t ) ( ( ulIndex % 16U ) + ( ( ulIndex / 256U ) & 0x3U ) );
+        }
+        else
+        {
+            ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+            ucImage[ ulIndex ] = ( uint8_t ) ( ulSeed >> 16 );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Decompress ulCompressedSize bytes of ucCompressed, feeding ulChunk bytes at a time. */
+
+static OTA_DecompressResult_t prvDecompress( uint32_t ulCompressedSize,
+                                             uint32_t ulChunk,
+                                             TestSink_t * pxSink )
+{
+    OTA_DecompressResult_t eResult = eOTA_Decompress_Ok;
+    uint32_t ulOffset = 0U;
+    uint32_t ulSize;
+
+    OTA_Decompress_Init( &xDecompressor );
+
+    while( ( ulOffset < ulCompressedSize ) && ( eResult == eOTA_Decompress_Ok ) )
+    {
+        ulSize = ulCompressedSize - ulOffset;
+
+        if( ulSize > ulChunk )
+        {
+            ulSize = ulChunk;
+        }
+
+        eResult = OTA_Decompress_Feed( &xDecompressor, &ucCompressed[ ulOffset ], ulSize, prvTestOutput, pxSink );
+        ulOffset += ulSize;
+    }
+
+    if( eResult == eOTA_Decompress_Ok )
+    {
+        eResult = OTA_Decompress_Flush( &xDecompressor, prvTestOutput, pxSink );
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Test group definition.
+ */
+TEST_GROUP( Full_OTA_DECOMPRESS );
+
+TEST_SETUP( Full_OTA_DECOMPRESS )
+{
+    prvGenerateImage();
+    memset( ucOutput, 0, sizeof( ucOutput ) );
+}
+
+TEST_TEAR_DOWN( Full_OTA_DECOMPRESS )
+{
+}
+
+TEST_GROUP_RUNNER( Full_OTA_DECOMPRESS )
+{
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_InvalidParams );
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_RoundTripBlocks );
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_RoundTripSingleBytes );
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_ZeroWindowReference );
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_OutputFailure );
+    RUN_TEST_CASE( Full_OTA_DECOMPRESS, Decompress_Benchmark );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_InvalidParams )
+{
+    TestSink_t xSink = { ucOutput, sizeof( ucOutput ), 0U, 0U, 0U };
+
+    OTA_Decompress_Init( &xDecompressor );
+
+    TEST_ASSERT_EQUAL( eOTA_Decompress_BadParams, OTA_Decompress_Feed( NULL, ucCompressed, 1U, prvTestOutput, &xSink ) );
+    TEST_ASSERT_EQUAL( eOTA_Decompress_BadParams, OTA_Decompress_Feed( &xDecompressor, NULL, 1U, prvTestOutput, &xSink ) );
+    TEST_ASSERT_EQUAL( eOTA_Decompress_BadParams, OTA_Decompress_Feed( &xDecompressor, ucCompressed, 1U, NULL, &xSink ) );
+    TEST_ASSERT_EQUAL( eOTA_Decompress_BadParams, OTA_Decompress_Flush( NULL, prvTestOutput, &xSink ) );
+
+    /* An empty feed is allowed and produces nothing. */
+    TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, OTA_Decompress_Feed( &xDecompressor, NULL, 0U, prvTestOutput, &xSink ) );
+    TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, OTA_Decompress_Flush( &xDecompressor, prvTestOutput, &xSink ) );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xSink.ulCalls );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_RoundTripBlocks )
+{
+    TestSink_t xSink = { ucOutput, sizeof( ucOutput ), 0U, 0U, 0U };
+    uint32_t ulCompressedSize = prvCompress( ucImage, sizeof( ucImage ), ucCompressed, sizeof( ucCompressed ) );
+
+    TEST_ASSERT_LESS_THAN_UINT32( sizeof( ucImage ), ulCompressedSize );
+    TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, prvDecompress( ulCompressedSize, otatestDECOMPRESS_BLOCK_SIZE, &xSink ) );
+    TEST_ASSERT_EQUAL_UINT32( sizeof( ucImage ), xSink.ulLength );
+    TEST_ASSERT_EQUAL_UINT32( sizeof( ucImage ), xDecompressor.ulTotalOut );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( ucImage, ucOutput, sizeof( ucImage ) );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_RoundTripSingleBytes )
+{
+    TestSink_t xSink = { ucOutput, sizeof( ucOutput ), 0U, 0U, 0U };
+    uint32_t ulCompressedSize = prvCompress( ucImage, sizeof( ucImage ), ucCompressed, sizeof( ucCompressed ) );
+
+    /* Every state of the decoder must survive running out of input. */
+    TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, prvDecompress( ulCompressedSize, 1U, &xSink ) );
+    TEST_ASSERT_EQUAL_UINT32( sizeof( ucImage ), xSink.ulLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( ucImage, ucOutput, sizeof( ucImage ) );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_ZeroWindowReference )
+{
+    TestSink_t xSink = { ucOutput, sizeof( ucOutput ), 0U, 0U, 0U };
+    TestBitWriter_t xWriter = { ucCompressed, sizeof( ucCompressed ), 0U, 0U, 0U };
+    uint8_t ucExpected[ 5 ] = { 0U, 0U, 0U, 0U, 0xa5U };
+    uint32_t ulCompressedSize;
+
+    /* A back-reference before the start of the stream reads the zero filled window. */
+    prvPutBits( &xWriter, 0U, 1U );
+    prvPutBits( &xWriter, 0U, ( uint8_t ) otaconfigDECOMPRESS_WINDOW_BITS );
+    prvPutBits( &xWriter, 3U, ( uint8_t ) otaconfigDECOMPRESS_LOOKAHEAD_BITS );
+    prvPutBits( &xWriter, 1U, 1U );
+    prvPutBits( &xWriter, 0xa5U, 8U );
+
+    if( xWriter.ucUsed > 0U )
+    {
+        prvPutBits( &xWriter, 0U, ( uint8_t ) ( 8U - xWriter.ucUsed ) );
+    }
+
+    ulCompressedSize = xWriter.ulBytes;
+
+    TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, prvDecompress( ulCompressedSize, otatestDECOMPRESS_BLOCK_SIZE, &xSink ) );
+    TEST_ASSERT_EQUAL_UINT32( sizeof( ucExpected ), xSink.ulLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( ucExpected, ucOutput, sizeof( ucExpected ) );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_OutputFailure )
+{
+    TestSink_t xSink = { ucOutput, sizeof( ucOutput ), 0U, 0U, 2U };
+    uint32_t ulCompressedSize = prvCompress( ucImage, sizeof( ucImage ), ucCompressed, sizeof( ucCompressed ) );
+
+    /* The second flush of the staging buffer is refused so decompression must stop. */
+    TEST_ASSERT_EQUAL( eOTA_Decompress_OutputFailed, prvDecompress( ulCompressedSize, otatestDECOMPRESS_BLOCK_SIZE, &xSink ) );
+    TEST_ASSERT_EQUAL_UINT32( 2U, xSink.ulCalls );
+    TEST_ASSERT_EQUAL_UINT32( otaconfigDECOMPRESS_OUTPUT_BUF_SIZE, xSink.ulLength );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_DECOMPRESS, Decompress_Benchmark )
+{
+    TestSink_t xSink;
+    uint32_t ulCompressedSize = prvCompress( ucImage, sizeof( ucImage ), ucCompressed, sizeof( ucCompressed ) );
+    uint32_t ulIteration;
+    uint32_t ulElapsedMs;
+    TickType_t xStart;
+
+    xStart = xTaskGetTickCount();
+
+    for( ulIteration = 0U; ulIteration < otatestDECOMPRESS_BENCH_ITERATIONS; ulIteration++ )
+    {
+        xSink.pucBuffer = ucOutput;
+        xSink.ulCapacity = sizeof( ucOutput );
+        xSink.ulLength = 0U;
+        xSink.ulCalls = 0U;
+        xSink.ulFailAfter = 0U;
+
+        TEST_ASSERT_EQUAL( eOTA_Decompress_Ok, prvDecompress( ulCompressedSize, otatestDECOMPRESS_BLOCK_SIZE, &xSink ) );
+    }
+
+    ulElapsedMs = ( uint32_t ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+
+    if( ulElapsedMs == 0U )
+    {
+        ulElapsedMs = 1U;
+    }
+
+    configPRINTF( ( "OTA decompress: %u -> %u bytes, %u KB/s, %u bytes of RAM.\r\n",
+                    ulCompressedSize,
+                    ( uint32_t ) sizeof( ucImage ),
+                    ( uint32_t ) ( ( ( sizeof( ucImage ) * otatestDECOMPRESS_BENCH_ITERATIONS ) / ulElapsedMs ) * 1000U / 1024U ),
+                    ( uint32_t ) sizeof( OTA_Decompressor_t ) ) );
+}
@@ -0,0 +1,381 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+#include "unity.h"
+
+/* OTA includes. */
+#include "aws_ota_http.h"
+
+/**
+ * @brief Base URL of the range server of tools/http_range_server, for example
+ * "http://127.0.0.1:9924".
+ *
+ * The tests that download from the server only run when the board defines it.
+ */
+#ifdef otatestHTTP_SERVER_URL
+    #define otatesthttpRANGE_SIZE     4000U /* Not a multiple of the buffer size. */
+    #define otatesthttpBUF_SIZE       256U
+    #define otatesthttpCONN_CHECK     16U   /* Bytes fetched to learn the connection number. */
+
+/**
+ * @brief Body data collected by prvCollectBody().
+ */
+    typedef struct
+    {
+        uint32_t ulNext;                        /* Offset the next body data must start at. */
+        BaseType_t xInOrder;                    /* pdFALSE once data arrived out of order. */
+        uint8_t ucData[ otatesthttpRANGE_SIZE ];
+    } HttpTestBody_t;
+
+    static HttpTestBody_t xBody;
+    static uint8_t ucBuffer[ otatesthttpBUF_SIZE ];
+#endif /* ifdef otatestHTTP_SERVER_URL */
+
+static OTA_HttpClient_t xClient;
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestBody( void * pvContext,
+                               uint32_t ulOffset,
+                               uint8_t * pucData,
+                               uint32_t ulSize )
+{
+    ( void ) pvContext;
+    ( void ) ulOffset;
+    ( void ) pucData;
+    ( void ) ulSize;
+
+    return pdTRUE;
+}
+
+/*-----------------------------------------------------------*/
+
+#ifdef otatestHTTP_SERVER_URL
+
+    /* Collect the body of a range of the file, checking that it arrives in order. */
+    static BaseType_t prvCollectBody( void * pvContext,
+                                      uint32_t ulOffset,
+                                      uint8_t * pucData,
+                                      uint32_t ulSize )
+    {
+        HttpTestBody_t * pxBody = ( HttpTestBody_t * ) pvContext;
+
+        if( ( ulOffset != pxBody->ulNext ) || ( ( ulOffset + ulSize ) > otatesthttpRANGE_SIZE ) )
+        {
+            pxBody->xInOrder = pdFALSE;
+        }
+        else
+        {
+            memcpy( &pxBody->ucData[ ulOffset ], pucData, ulSize );
+            pxBody->ulNext += ulSize;
+        }
+
+        return pxBody->xInOrder;
+    }
+
+/*-----------------------------------------------------------*/
+
+    /* Fetch a few bytes of a connection file, which are all the number of the
+     * connection that served them. */
+    static uint8_t prvGetConnectionNumber( uint32_t ulOffset )
+    {
+        uint32_t ulIndex;
+
+        memset( &xBody, 0, sizeof( xBody ) );
+        xBody.ulNext = ulOffset;
+        xBody.xInOrder = pdTRUE;
+
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_GetRange( &xClient, ulOffset, otatesthttpCONN_CHECK,
+                                                            ucBuffer, sizeof( ucBuffer ), prvCollectBody, &xBody ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xBody.xInOrder );
+        TEST_ASSERT_EQUAL_UINT32( ulOffset + otatesthttpCONN_CHECK, xBody.ulNext );
+
+        for( ulIndex = ulOffset + 1U; ulIndex < xBody.ulNext; ulIndex++ )
+        {
+            TEST_ASSERT_EQUAL_UINT8( xBody.ucData[ ulOffset ], xBody.ucData[ ulIndex ] );
+        }
+
+        return xBody.ucData[ ulOffset ];
+    }
+
+#endif /* ifdef otatestHTTP_SERVER_URL */
+
+/*-----------------------------------------------------------*/
+
+static OTA_HttpResult_t prvParse( const char * pcHeader,
+                                  uint32_t * pulStatus,
+                                  uint32_t * pulContentLength,
+                                  BaseType_t * pxKeepAlive )
+{
+    return OTA_HTTP_ParseResponseHeader( pcHeader, ( uint32_t ) strlen( pcHeader ), pulStatus, pulContentLength, pxKeepAlive );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Test group definition.
+ */
+TEST_GROUP( Full_OTA_HTTP );
+
+TEST_SETUP( Full_OTA_HTTP )
+{
+    memset( &xClient, 0, sizeof( xClient ) );
+    xClient.xSocket = SOCKETS_INVALID_SOCKET;
+}
+
+TEST_TEAR_DOWN( Full_OTA_HTTP )
+{
+    OTA_HTTP_Close( &xClient );
+}
+
+TEST_GROUP_RUNNER( Full_OTA_HTTP )
+{
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_InitParsesURL );
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_InitRejectsBadURL );
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_ParsePartialContent );
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_ParseConnection );
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_ParseRejectsBadResponse );
+    RUN_TEST_CASE( Full_OTA_HTTP, HTTP_GetRangeInvalidParams );
+    #ifdef otatestHTTP_SERVER_URL
+        RUN_TEST_CASE( Full_OTA_HTTP, HTTP_GetRangeKeepAlive );
+        RUN_TEST_CASE( Full_OTA_HTTP, HTTP_GetRangeRetriesDroppedConnection );
+        RUN_TEST_CASE( Full_OTA_HTTP, HTTP_GetRangeResumesFromOffset );
+    #endif
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_InitParsesURL )
+{
+    static const char pcSigned[] = "https://bucket.s3.amazonaws.com/ota/image.bin?X-Amz-Expires=3600&X-Amz-Signature=abc";
+    static const char pcLocal[] = "http://192.168.1.10:8080/image.bin";
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, pcSigned ) );
+    TEST_ASSERT_EQUAL_STRING( "bucket.s3.amazonaws.com", xClient.cHost );
+    TEST_ASSERT_EQUAL_UINT16( 443U, xClient.usPort );
+    TEST_ASSERT_EQUAL( pdTRUE, xClient.xUseTLS );
+    TEST_ASSERT_EQUAL_STRING( "/ota/image.bin?X-Amz-Expires=3600&X-Amz-Signature=abc", xClient.pcPath );
+    TEST_ASSERT_EQUAL_UINT32( strlen( xClient.pcPath ), xClient.ulPathLen );
+    TEST_ASSERT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, pcLocal ) );
+    TEST_ASSERT_EQUAL_STRING( "192.168.1.10", xClient.cHost );
+    TEST_ASSERT_EQUAL_UINT16( 8080U, xClient.usPort );
+    TEST_ASSERT_EQUAL( pdFALSE, xClient.xUseTLS );
+    TEST_ASSERT_EQUAL_STRING( "/image.bin", xClient.pcPath );
+
+    /* The scheme is case insensitive. */
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, "HTTPS://example.com/a" ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xClient.xUseTLS );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_InitRejectsBadURL )
+{
+    char cLongHost[ otaconfigHTTP_MAX_HOST_SIZE + 16U ];
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_Init( NULL, "http://example.com/a" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_Init( &xClient, NULL ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "ftp://example.com/a" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "https://example.com" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "https:///a" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "https://example.com:/a" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "https://example.com:0/a" ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, "https://example.com:70000/a" ) );
+
+    /* The host name must fit the client. */
+    memcpy( cLongHost, "http://", 7 );
+    memset( &cLongHost[ 7 ], 'h', otaconfigHTTP_MAX_HOST_SIZE );
+    strcpy( &cLongHost[ 7U + otaconfigHTTP_MAX_HOST_SIZE ], "/a" );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadURL, OTA_HTTP_Init( &xClient, cLongHost ) );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_ParsePartialContent )
+{
+    uint32_t ulStatus = 0U;
+    uint32_t ulContentLength = 0U;
+    BaseType_t xKeepAlive = pdFALSE;
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, prvParse( "HTTP/1.1 206 Partial Content\r\n"
+                                               "Content-Type: application/octet-stream\r\n"
+                                               "Content-Range: bytes 4096-8191/65536\r\n"
+                                               "Content-Length: 4096\r\n"
+                                               "\r\n",
+                                               &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL_UINT32( 206U, ulStatus );
+    TEST_ASSERT_EQUAL_UINT32( 4096U, ulContentLength );
+    TEST_ASSERT_EQUAL( pdTRUE, xKeepAlive );
+
+    /* Header names are case insensitive. */
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, prvParse( "HTTP/1.1 416 Range Not Satisfiable\r\ncontent-length:   17\r\n\r\n",
+                                               &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL_UINT32( 416U, ulStatus );
+    TEST_ASSERT_EQUAL_UINT32( 17U, ulContentLength );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_ParseConnection )
+{
+    uint32_t ulStatus = 0U;
+    uint32_t ulContentLength = 0U;
+    BaseType_t xKeepAlive = pdTRUE;
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, prvParse( "HTTP/1.1 206 Partial Content\r\nConnection: Close\r\nContent-Length: 1\r\n\r\n",
+                                               &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xKeepAlive );
+
+    /* HTTP/1.0 servers close the connection unless they say otherwise. */
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, prvParse( "HTTP/1.0 206 Partial Content\r\nContent-Length: 1\r\n\r\n",
+                                               &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xKeepAlive );
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, prvParse( "HTTP/1.0 206 Partial Content\r\nConnection: keep-alive\r\nContent-Length: 1\r\n\r\n",
+                                               &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xKeepAlive );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_ParseRejectsBadResponse )
+{
+    uint32_t ulStatus = 0U;
+    uint32_t ulContentLength = 0U;
+    BaseType_t xKeepAlive = pdFALSE;
+
+    /* Chunked responses carry no Content-Length. */
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadResponse, prvParse( "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n",
+                                                        &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadResponse, prvParse( "SSH-2.0-OpenSSH_7.4\r\n\r\n",
+                                                        &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadResponse, prvParse( "HTTP/1.1 abc\r\nContent-Length: 1\r\n\r\n",
+                                                        &ulStatus, &ulContentLength, &xKeepAlive ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, prvParse( "HTTP/1.1 206 Partial Content\r\n\r\n",
+                                                      NULL, &ulContentLength, &xKeepAlive ) );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_HTTP, HTTP_GetRangeInvalidParams )
+{
+    uint8_t ucBuffer[ 16 ];
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, "http://127.0.0.1/image.bin" ) );
+
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_GetRange( NULL, 0U, 1U, ucBuffer, sizeof( ucBuffer ), prvTestBody, NULL ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_GetRange( &xClient, 0U, 0U, ucBuffer, sizeof( ucBuffer ), prvTestBody, NULL ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_GetRange( &xClient, 0U, 1U, NULL, sizeof( ucBuffer ), prvTestBody, NULL ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_GetRange( &xClient, 0U, 1U, ucBuffer, 0U, prvTestBody, NULL ) );
+    TEST_ASSERT_EQUAL( eOTA_HTTP_BadParams, OTA_HTTP_GetRange( &xClient, 0U, 1U, ucBuffer, sizeof( ucBuffer ), NULL, NULL ) );
+
+    /* Nothing was attempted so there is no connection. */
+    TEST_ASSERT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+}
+
+/*-----------------------------------------------------------*/
+
+#ifdef otatestHTTP_SERVER_URL
+
+    TEST( Full_OTA_HTTP, HTTP_GetRangeKeepAlive )
+    {
+        uint8_t ucFirst;
+
+        /* Both requests are served by the same connection. */
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, otatestHTTP_SERVER_URL "/connection" ) );
+        ucFirst = prvGetConnectionNumber( 0U );
+        TEST_ASSERT_NOT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+        TEST_ASSERT_EQUAL_UINT8( ucFirst, prvGetConnectionNumber( otatesthttpCONN_CHECK ) );
+        OTA_HTTP_Close( &xClient );
+
+        /* A server that closes the connection after the response gets a new one for each request. */
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, otatestHTTP_SERVER_URL "/close/connection" ) );
+        ucFirst = prvGetConnectionNumber( 0U );
+        TEST_ASSERT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+        TEST_ASSERT_NOT_EQUAL( ucFirst, prvGetConnectionNumber( otatesthttpCONN_CHECK ) );
+    }
+
+/*-----------------------------------------------------------*/
+
+    TEST( Full_OTA_HTTP, HTTP_GetRangeRetriesDroppedConnection )
+    {
+        uint8_t ucFirst;
+
+        /* The server closes each connection after the response without saying so, like
+         * one that drops idle connections. The client keeps the dead connection. */
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, otatestHTTP_SERVER_URL "/drop-idle/connection" ) );
+        ucFirst = prvGetConnectionNumber( 0U );
+        TEST_ASSERT_NOT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+
+        /* Let the close arrive, then the next request fails on the old connection and
+         * succeeds on a new one. */
+        vTaskDelay( pdMS_TO_TICKS( 100 ) );
+        TEST_ASSERT_NOT_EQUAL( ucFirst, prvGetConnectionNumber( otatesthttpCONN_CHECK ) );
+    }
+
+/*-----------------------------------------------------------*/
+
+    TEST( Full_OTA_HTTP, HTTP_GetRangeResumesFromOffset )
+    {
+        uint32_t ulIndex;
+
+        memset( &xBody, 0, sizeof( xBody ) );
+        xBody.xInOrder = pdTRUE;
+
+        /* The server closes the connection half way through the body. The full
+         * buffers received until then are delivered, the rest of the range is not. */
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, otatestHTTP_SERVER_URL "/drop-body/image.bin" ) );
+        TEST_ASSERT_EQUAL( eOTA_HTTP_RecvFailed, OTA_HTTP_GetRange( &xClient, 0U, otatesthttpRANGE_SIZE,
+                                                                    ucBuffer, sizeof( ucBuffer ), prvCollectBody, &xBody ) );
+        TEST_ASSERT_EQUAL( SOCKETS_INVALID_SOCKET, xClient.xSocket );
+        TEST_ASSERT_EQUAL( pdTRUE, xBody.xInOrder );
+        TEST_ASSERT_EQUAL_UINT32( ( ( otatesthttpRANGE_SIZE / 2U ) / otatesthttpBUF_SIZE ) * otatesthttpBUF_SIZE, xBody.ulNext );
+
+        /* Fetch the rest from where the data stopped, like the agent does from its block bitmap. */
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_Init( &xClient, otatestHTTP_SERVER_URL "/image.bin" ) );
+        TEST_ASSERT_EQUAL( eOTA_HTTP_Ok, OTA_HTTP_GetRange( &xClient, xBody.ulNext, otatesthttpRANGE_SIZE - xBody.ulNext,
+                                                            ucBuffer, sizeof( ucBuffer ), prvCollectBody, &xBody ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xBody.xInOrder );
+        TEST_ASSERT_EQUAL_UINT32( otatesthttpRANGE_SIZE, xBody.ulNext );
+
+        for( ulIndex = 0U; ulIndex < otatesthttpRANGE_SIZE; ulIndex++ )
+        {
+            TEST_ASSERT_EQUAL_UINT8( ( uint8_t ) ( ulIndex * 31U ), xBody.ucData[ ulIndex ] );
+        }
+    }
+
+#endif /* ifdef otatestHTTP_SERVER_URL */
@@ -161,6 +161,8 @@ TEST_GROUP_RUNNER( Full_OTA_PAL )
     RUN_TEST_CASE( Full_OTA_PAL, prvPAL_WriteBlock_WriteSingleByte );
     RUN_TEST_CASE( Full_OTA_PAL, prvPAL_WriteBlock_WriteManyBlocks );
 
+    RUN_TEST_CASE( Full_OTA_PAL, prvPAL_SaveTransferState_LoadAndClear );
+
     /* This test resets the device so it is not valid for an MCU. */
     RUN_TEST_CASE( Full_OTA_PAL, prvPAL_ActivateNewImage );
 
@@ -613,6 +615,34 @@ TEST( Full_OTA_PAL, prvPAL_WriteBlock_WriteManyBlocks )
     }
 }
 
+/**
+ * @brief Save a transfer state, read it back, then clear it. Verify the state is gone.
+ */
+TEST( Full_OTA_PAL, prvPAL_SaveTransferState_LoadAndClear )
+{
+    OTA_Err_t xOtaStatus;
+    uint8_t ucState[ sizeof( ucDummyData ) ];
+    uint32_t ulStateSize = sizeof( ucState );
+
+    xOtaStatus = prvPAL_SaveTransferState( ucDummyData, sizeof( ucDummyData ) );
+    TEST_ASSERT_EQUAL( kOTA_Err_None, xOtaStatus );
+
+    if( TEST_PROTECT() )
+    {
+        xOtaStatus = prvPAL_LoadTransferState( ucState, &ulStateSize );
+        TEST_ASSERT_EQUAL( kOTA_Err_None, xOtaStatus );
+        TEST_ASSERT_EQUAL_UINT32( sizeof( ucDummyData ), ulStateSize );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( ucDummyData, ucState, sizeof( ucDummyData ) );
+    }
+
+    xOtaStatus = prvPAL_ClearTransferState();
+    TEST_ASSERT_EQUAL( kOTA_Err_None, xOtaStatus );
+
+    ulStateSize = sizeof( ucState );
+    xOtaStatus = prvPAL_LoadTransferState( ucState, &ulStateSize );
+    TEST_ASSERT_EQUAL( kOTA_Err_NoResumeState, xOtaStatus );
+}
+
 /**
  * Call prvPAL_ActivateNewImage() and verify success. This function is expected to
  * reset the device, so this test is only supported on the Windows Simulator environment.
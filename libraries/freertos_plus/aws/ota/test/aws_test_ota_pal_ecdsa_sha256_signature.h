@@ -56,6 +56,20 @@ static const uint8_t ucValidSignature[] =
 };
 static const int ucValidSignatureLength = 70;
 
+/**
+ * @brief Valid signature of the image of the OTA transfer simulation, see aws_test_ota_sim.c.
+ */
+static const uint8_t ucSimImageSignature[] =
+{
+    0x30, 0x45, 0x02, 0x21, 0x00, 0xb3, 0x6b, 0xb0, 0xe1, 0xd8, 0xe0, 0x52,
+    0x78, 0xcf, 0xa9, 0xf7, 0x64, 0xbe, 0xdd, 0xe1, 0x39, 0xae, 0x6a, 0x80,
+    0x1b, 0x5a, 0xe9, 0x24, 0x62, 0x90, 0x38, 0xf7, 0x12, 0x23, 0x3c, 0xe6,
+    0x2f, 0x02, 0x20, 0x76, 0x7b, 0x4d, 0x1c, 0x90, 0x82, 0xaf, 0x34, 0x86,
+    0xe4, 0x84, 0x05, 0x44, 0x1b, 0x18, 0xbf, 0x41, 0x32, 0x8d, 0x45, 0x3f,
+    0x7a, 0x9a, 0x4a, 0x91, 0xfa, 0xef, 0x79, 0x16, 0x42, 0x49, 0x75
+};
+static const int ucSimImageSignatureLength = 71;
+
 /**
  * @brief The type of signature method this file defines for the valid signature.
  */
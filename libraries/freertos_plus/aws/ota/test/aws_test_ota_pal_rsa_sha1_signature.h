@@ -86,6 +86,36 @@ static const uint8_t ucValidSignature[] =
 };
 static const int ucValidSignatureLength = 256;
 
+/**
+ * @brief Valid signature of the image of the OTA transfer simulation, see aws_test_ota_sim.c.
+ */
+static const uint8_t ucSimImageSignature[] =
+{
+    0x12, 0xdf, 0x76, 0x4a, 0xd9, 0xb0, 0xe4, 0x2d, 0xa6, 0x4f, 0xf0, 0x44,
+    0x26, 0x65, 0x31, 0x2a, 0x02, 0x80, 0x9e, 0x2a, 0x6d, 0xf3, 0x6b, 0xe0,
+    0xeb, 0x08, 0xe2, 0x90, 0x25, 0x81, 0x33, 0xb1, 0x1e, 0x57, 0x37, 0xfe,
+    0x77, 0x70, 0xc3, 0x8a, 0x23, 0xdc, 0x81, 0xdb, 0x1b, 0x61, 0xa2, 0x79,
+    0x57, 0x17, 0x69, 0x5e, 0x3d, 0xa0, 0x23, 0x02, 0x2e, 0x36, 0xfe, 0x86,
+    0x06, 0xe5, 0x3f, 0x70, 0x38, 0x55, 0xeb, 0x13, 0x17, 0x01, 0x77, 0x7e,
+    0x7a, 0x56, 0xb6, 0x09, 0x38, 0x6b, 0xb7, 0x8d, 0xf9, 0x65, 0xf6, 0xa4,
+    0xa3, 0x85, 0xb8, 0x32, 0x71, 0x58, 0xab, 0x11, 0xe6, 0xdd, 0xd1, 0xd9,
+    0x3a, 0x74, 0x5c, 0x39, 0x10, 0xa3, 0xe8, 0x5d, 0x03, 0x50, 0x6d, 0xaf,
+    0x4e, 0x06, 0x0d, 0xfc, 0xfe, 0xca, 0x39, 0x99, 0x17, 0xda, 0xcf, 0x4c,
+    0xab, 0x55, 0x33, 0xe9, 0xc2, 0xd7, 0x7e, 0x9d, 0x27, 0x86, 0x07, 0x04,
+    0xf0, 0xa5, 0x1d, 0x0e, 0x47, 0x45, 0xa3, 0xbf, 0xfe, 0x08, 0xc4, 0x4e,
+    0x3b, 0x62, 0x7e, 0xec, 0x09, 0xd6, 0x5a, 0xab, 0x1e, 0x33, 0xf3, 0x81,
+    0xca, 0x4f, 0x0b, 0x9f, 0x13, 0xd7, 0x25, 0xfb, 0x56, 0xf5, 0x5f, 0x39,
+    0xb5, 0x1c, 0x15, 0x84, 0x67, 0xe5, 0x24, 0xa0, 0x6e, 0xd5, 0xa3, 0x19,
+    0xd9, 0x74, 0xbb, 0x9b, 0x0f, 0x9a, 0x43, 0xf2, 0x1e, 0x00, 0x22, 0x37,
+    0xff, 0x78, 0x80, 0xb3, 0x28, 0xfe, 0x67, 0xaf, 0x75, 0xa0, 0xbe, 0xdf,
+    0xcf, 0x3e, 0x40, 0xd7, 0xbc, 0x61, 0xb7, 0x9e, 0x69, 0xd0, 0xb2, 0x0d,
+    0xd4, 0x0a, 0x24, 0x28, 0x5b, 0xd8, 0xf2, 0x20, 0xd3, 0xa3, 0x7f, 0xdb,
+    0x8c, 0x71, 0xc2, 0x08, 0x65, 0x61, 0x4a, 0x32, 0x4f, 0x98, 0x24, 0xb9,
+    0x9a, 0x24, 0xf8, 0x61, 0x88, 0x97, 0xf8, 0x8e, 0x73, 0x58, 0x07, 0x46,
+    0xa4, 0x34, 0xe1, 0x8f
+};
+static const int ucSimImageSignatureLength = 256;
+
 /**
  * @brief The type of signature method this file defines for the valid signature.
  */
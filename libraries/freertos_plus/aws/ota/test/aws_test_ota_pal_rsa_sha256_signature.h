@@ -85,6 +85,36 @@ static const uint8_t ucValidSignature[] =
 };
 static const int ucValidSignatureLength = 256;
 
+/**
+ * @brief Valid signature of the image of the OTA transfer simulation, see aws_test_ota_sim.c.
+ */
+static const uint8_t ucSimImageSignature[] =
+{
+    0x2d, 0x4e, 0xbe, 0xcc, 0xc2, 0x9e, 0x5f, 0x95, 0x1e, 0x21, 0x66, 0x0f,
+    0x18, 0xde, 0x9b, 0xa3, 0x5e, 0xc7, 0x19, 0xa0, 0x9a, 0x39, 0xfb, 0x16,
+    0x06, 0x94, 0x92, 0x2d, 0x06, 0x90, 0xde, 0xdf, 0x7c, 0x50, 0x31, 0x85,
+    0xe9, 0xb3, 0x9b, 0x27, 0x89, 0x87, 0xc7, 0x43, 0x44, 0x49, 0x05, 0x75,
+    0xeb, 0x2d, 0xa2, 0xca, 0x02, 0xf0, 0x90, 0xbc, 0x8e, 0x8b, 0x92, 0xc0,
+    0x34, 0x56, 0x2b, 0x3d, 0x17, 0xea, 0x3c, 0xba, 0x07, 0x8d, 0xc5, 0xa6,
+    0x15, 0xb0, 0xf9, 0x38, 0xad, 0x3f, 0x0a, 0x49, 0xba, 0x76, 0xfc, 0xb3,
+    0x27, 0x4e, 0x26, 0xdb, 0x5d, 0x4a, 0x31, 0x17, 0xb6, 0x73, 0xfd, 0xf9,
+    0xb8, 0x56, 0x57, 0xb2, 0x35, 0xb1, 0xd8, 0xd1, 0x6a, 0x45, 0xa8, 0x1e,
+    0x2b, 0x86, 0x83, 0x1c, 0xca, 0x33, 0x4d, 0x6f, 0xde, 0x73, 0x89, 0xb0,
+    0x0b, 0x15, 0x44, 0x45, 0x20, 0xa7, 0xa2, 0x55, 0x59, 0x77, 0xfe, 0x42,
+    0xcd, 0x65, 0x55, 0x39, 0x52, 0xae, 0x31, 0xdd, 0x6f, 0xed, 0x68, 0xe1,
+    0x90, 0x6b, 0xb0, 0x18, 0x58, 0x88, 0xba, 0xe5, 0xee, 0xaf, 0x1f, 0x6c,
+    0x70, 0x84, 0x07, 0xe7, 0x99, 0xb9, 0x98, 0x61, 0xf1, 0x81, 0x6b, 0x1f,
+    0x10, 0x2a, 0xea, 0x9d, 0x27, 0x14, 0x78, 0xf7, 0x69, 0xfb, 0xe9, 0xdc,
+    0xb9, 0xb1, 0x74, 0xbe, 0xa7, 0x58, 0xae, 0x1e, 0x47, 0xe6, 0x4a, 0x16,
+    0x7a, 0x45, 0x01, 0x79, 0x6d, 0x33, 0xc3, 0x0c, 0x61, 0xe3, 0x64, 0x71,
+    0x70, 0xbf, 0x85, 0x24, 0xe4, 0xe1, 0xaa, 0xa1, 0x97, 0xfd, 0x84, 0x40,
+    0x12, 0x5a, 0x3e, 0xa6, 0x30, 0xcc, 0xe7, 0xbf, 0x43, 0x94, 0x96, 0xc9,
+    0xac, 0xb6, 0xf0, 0xd0, 0x9b, 0x74, 0x56, 0x2d, 0x72, 0x3d, 0x9f, 0xf8,
+    0xd5, 0xad, 0x22, 0x85, 0x76, 0xc3, 0xf5, 0x98, 0xe7, 0xb6, 0x6d, 0x93,
+    0xce, 0xf1, 0x73, 0x7f
+};
+static const int ucSimImageSignatureLength = 256;
+
 /**
  * @brief The type of signature method this file defines for the valid signature.
  */
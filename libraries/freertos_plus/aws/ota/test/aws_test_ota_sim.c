@@ -0,0 +1,534 @@
+/*
+ * Amazon FreeRTOS OTA V1.0.2
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_ota_sim.c
+ * @brief Simulated OTA file transfers over a lossy stream.
+ *
+ * The OTA agent's ingest path is driven by a stand-in for the MQTT stream service.
+ * Each stream request returns a burst of the blocks still missing from the agent's
+ * bitmap, subject to the loss, duplication, reordering and link speed of a scenario.
+ * The blocks are written through the platform PAL so a port with a file backed PAL
+ * measures the agent itself. Network time is simulated, CPU time is measured, and
+ * the throughput, duplicate ratio, heap high water mark and time to a verified image
+ * are printed for each scenario. Use the results to tune otaconfigLOG2_FILE_BLOCK_SIZE
+ * and otaconfigFILE_REQUEST_WAIT_MS.
+ *
+ * The image is signed with the test key of the port's signature method, so every
+ * scenario must end with a complete file that passed the signature check. The
+ * signature is ucSimImageSignature of the aws_test_ota_pal_*_signature.h headers,
+ * see the README of the tests for how it was made.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+#include "unity.h"
+
+/* OTA includes. */
+#include "aws_ota_agent.h"
+#include "aws_ota_agent_internal.h"
+#include "aws_ota_pal.h"
+#include "aws_ota_cbor.h"
+#include "aws_ota_cbor_internal.h"
+#include "aws_ota_agent_test_access_declare.h"
+#include "aws_test_ota_config.h"
+#include "cbor.h"
+
+/**
+ * @brief Configuration for this test group.
+ */
+#define otatestsimFILE_SIZE                 ( ( 48U * 1024U ) + 123U ) /* Size of the signed image. Not a multiple of the block size. */
+#define otatestsimMAX_BLOCKS_PER_REQUEST    32U                        /* Most blocks the stream service sends for one request. */
+#define otatestsimMAX_MOMENTUM              32U                        /* Mirrors OTA_MAX_STREAM_REQUEST_MOMENTUM of the agent. */
+#define otatestsimMAX_ROUNDS                1024U                      /* Safety net against a transfer that never completes. */
+#define otatestsimBLOCK_MSG_SIZE            ( OTA_FILE_BLOCK_SIZE + 64U )
+#define otatestsimREQUEST_MSG_SIZE          384U                       /* Matches OTA_REQUEST_MSG_MAX_SIZE of the agent. */
+#define otatestsimBITMAP_SIZE               128U                       /* Matches OTA_MAX_BLOCK_BITMAP_SIZE of the agent. */
+#define otatestsimSERVER_FILE_ID            0U
+
+#define otatestsimNUM_BLOCKS                ( ( otatestsimFILE_SIZE + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE )
+
+#if ( otatestsimNUM_BLOCKS > ( otatestsimBITMAP_SIZE * 8U ) )
+    #error "otatestsimFILE_SIZE needs more blocks than the agent can track. Increase otaconfigLOG2_FILE_BLOCK_SIZE."
+#endif
+
+/**
+ * @brief Link and stream service behaviour of a simulated transfer.
+ */
+typedef struct
+{
+    const char * pcName;
+    uint32_t ulLossPercent;      /* Chance of a block being dropped. */
+    uint32_t ulDuplicatePercent; /* Chance of a block being delivered twice. */
+    uint32_t ulReorderWindow;    /* Blocks of a burst are shuffled within groups of this size (0 or 1 keeps the order). */
+    uint32_t ulLatencyMs;        /* Round trip time of a stream request. */
+    uint32_t ulBandwidthKBps;    /* Link throughput in KB/s. */
+} SimScenario_t;
+
+/**
+ * @brief Measurements of a simulated transfer.
+ */
+typedef struct
+{
+    IngestResult_t eResult;    /* Last ingest result. */
+    uint32_t ulRequests;       /* Number of stream requests made. */
+    uint32_t ulBlocksSent;     /* Number of blocks put on the link by the service. */
+    uint32_t ulBlocksIngested; /* Number of blocks that reached the agent. */
+    uint32_t ulDuplicates;     /* Number of blocks the agent already had. */
+    uint32_t ulNetworkMs;      /* Simulated network and request timer time. */
+    uint32_t ulCpuMs;          /* Measured time spent in the agent and PAL. */
+    uint32_t ulHeapPeak;       /* Largest heap use seen during the transfer. */
+} SimResult_t;
+
+static OTA_FileContext_t xSimFile;
+static uint8_t ucSimMsg[ otatestsimBLOCK_MSG_SIZE ];
+static uint8_t ucSimRequest[ otatestsimREQUEST_MSG_SIZE ];
+static uint8_t ucSimBlock[ OTA_FILE_BLOCK_SIZE ];
+static uint32_t ulSimBurst[ otatestsimMAX_BLOCKS_PER_REQUEST ];
+static uint32_t ulSimRandom;
+
+/*-----------------------------------------------------------*/
+
+/* Deterministic pseudo random numbers so every run of a scenario is identical. */
+
+static uint32_t prvSimRandom( void )
+{
+    ulSimRandom = ( ulSimRandom * 1103515245UL ) + 12345UL;
+
+    return ( ulSimRandom >> 16 ) & 0x7fffUL;
+}
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSimChance( uint32_t ulPercent )
+{
+    return ( ( prvSimRandom() % 100UL ) < ulPercent ) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Copy a string into the heap since the agent frees the context strings on close. */
+
+static uint8_t * prvSimStringDup( const char * pcString )
+{
+    size_t xLen = strlen( pcString ) + 1U;
+    uint8_t * pucCopy = ( uint8_t * ) pvPortMalloc( xLen );
+
+    if( pucCopy != NULL )
+    {
+        memcpy( pucCopy, pcString, xLen );
+    }
+
+    return pucCopy;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Set up the file context the way the agent does after a job document was accepted. */
+
+static BaseType_t prvSimOpenFile( OTA_FileContext_t * C )
+{
+    uint32_t ulBitmapLen = ( otatestsimNUM_BLOCKS + ( BITS_PER_BYTE - 1U ) ) >> LOG2_BITS_PER_BYTE;
+    uint32_t ulPadBits = ( ulBitmapLen * BITS_PER_BYTE ) - otatestsimNUM_BLOCKS;
+    BaseType_t xResult = pdFALSE;
+
+    memset( C, 0, sizeof( OTA_FileContext_t ) );
+    C->pucFilePath = prvSimStringDup( otatestpalFIRMWARE_FILE );
+    C->pucCertFilepath = prvSimStringDup( otatestpalCERTIFICATE_FILE );
+    C->pxSignature = ( Sig256_t * ) pvPortMalloc( sizeof( Sig256_t ) );
+    C->pucRxBlockBitmap = ( uint8_t * ) pvPortMalloc( ulBitmapLen );
+    C->ulFileSize = otatestsimFILE_SIZE;
+    C->ulServerFileID = otatestsimSERVER_FILE_ID;
+    C->ulBlocksRemaining = otatestsimNUM_BLOCKS;
+
+    if( ( C->pucFilePath != NULL ) && ( C->pucCertFilepath != NULL ) &&
+        ( C->pxSignature != NULL ) && ( C->pucRxBlockBitmap != NULL ) )
+    {
+        memset( C->pxSignature, 0, sizeof( Sig256_t ) );
+        C->pxSignature->usSize = ( uint16_t ) ucSimImageSignatureLength;
+        memcpy( C->pxSignature->ucData, ucSimImageSignature, ucSimImageSignatureLength );
+
+        /* A set bit is a missing block. The bits past the last block are cleared like the agent does. */
+        memset( C->pucRxBlockBitmap, 0xff, ulBitmapLen );
+        C->pucRxBlockBitmap[ ulBitmapLen - 1U ] = ( uint8_t ) ( 0xffU >> ulPadBits );
+
+        if( prvPAL_CreateFileForRx( C ) == kOTA_Err_None )
+        {
+            xResult = pdTRUE;
+        }
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Encode a block the way the stream service publishes it. */
+
+static size_t prvSimEncodeBlock( uint32_t ulBlockIndex )
+{
+    CborEncoder xEncoder, xMapEncoder;
+    CborError xCborResult;
+    uint32_t ulOffset = ulBlockIndex * OTA_FILE_BLOCK_SIZE;
+    uint32_t ulBlockSize = OTA_FILE_BLOCK_SIZE;
+    uint32_t ulIndex;
+    size_t xEncodedSize = 0U;
+
+    if( ( ulOffset + ulBlockSize ) > otatestsimFILE_SIZE )
+    {
+        ulBlockSize = otatestsimFILE_SIZE - ulOffset;
+    }
+
+    /* The content is a function of the file offset so any misplaced block fails the signature check. */
+    for( ulIndex = 0U; ulIndex < ulBlockSize; ulIndex++ )
+    {
+        ucSimBlock[ ulIndex ] = ( uint8_t ) ( ( ulOffset + ulIndex ) * 31U );
+    }
+
+    cbor_encoder_init( &xEncoder, ucSimMsg, sizeof( ucSimMsg ), 0 );
+    xCborResult = cbor_encoder_create_map( &xEncoder, &xMapEncoder, 4 );
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_text_stringz( &xMapEncoder, OTA_CBOR_FILEID_KEY );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_int( &xMapEncoder, otatestsimSERVER_FILE_ID );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_text_stringz( &xMapEncoder, OTA_CBOR_BLOCKID_KEY );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_int( &xMapEncoder, ( int64_t ) ulBlockIndex );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_text_stringz( &xMapEncoder, OTA_CBOR_BLOCKSIZE_KEY );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_int( &xMapEncoder, ( int64_t ) ulBlockSize );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_text_stringz( &xMapEncoder, OTA_CBOR_BLOCKPAYLOAD_KEY );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encode_byte_string( &xMapEncoder, ucSimBlock, ulBlockSize );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_encoder_close_container_checked( &xEncoder, &xMapEncoder );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xEncodedSize = cbor_encoder_get_buffer_size( &xEncoder, ucSimMsg );
+    }
+
+    return xEncodedSize;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Collect the blocks the service sends for a request, in the order they arrive. */
+
+static uint32_t prvSimBuildBurst( const OTA_FileContext_t * C,
+                                  const SimScenario_t * pxScenario )
+{
+    uint32_t ulCount = 0U;
+    uint32_t ulBlock;
+    uint32_t ulGroup, ulIndex, ulSwap, ulTemp, ulGroupSize;
+
+    for( ulBlock = 0U; ( ulBlock < otatestsimNUM_BLOCKS ) && ( ulCount < otatestsimMAX_BLOCKS_PER_REQUEST ); ulBlock++ )
+    {
+        if( ( C->pucRxBlockBitmap[ ulBlock >> LOG2_BITS_PER_BYTE ] & ( 1U << ( ulBlock % BITS_PER_BYTE ) ) ) != 0U )
+        {
+            ulSimBurst[ ulCount ] = ulBlock;
+            ulCount++;
+        }
+    }
+
+    /* Shuffle each group of the burst to model the broker reordering messages. */
+    if( pxScenario->ulReorderWindow > 1U )
+    {
+        for( ulGroup = 0U; ulGroup < ulCount; ulGroup += pxScenario->ulReorderWindow )
+        {
+            ulGroupSize = ulCount - ulGroup;
+
+            if( ulGroupSize > pxScenario->ulReorderWindow )
+            {
+                ulGroupSize = pxScenario->ulReorderWindow;
+            }
+
+            for( ulIndex = ulGroupSize - 1U; ulIndex > 0U; ulIndex-- )
+            {
+                ulSwap = prvSimRandom() % ( ulIndex + 1U );
+                ulTemp = ulSimBurst[ ulGroup + ulIndex ];
+                ulSimBurst[ ulGroup + ulIndex ] = ulSimBurst[ ulGroup + ulSwap ];
+                ulSimBurst[ ulGroup + ulSwap ] = ulTemp;
+            }
+        }
+    }
+
+    return ulCount;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Hand one block message to the agent, timing it and sampling the heap. */
+
+static IngestResult_t prvSimIngest( OTA_FileContext_t * C,
+                                    size_t xMsgSize,
+                                    size_t xHeapStart,
+                                    SimResult_t * pxResult )
+{
+    IngestResult_t eResult;
+    OTA_Err_t xCloseResult = kOTA_Err_Uninitialized;
+    TickType_t xStart = xTaskGetTickCount();
+    size_t xHeapUsed;
+
+    eResult = TEST_OTA_prvIngestDataBlock( C, ( const char * ) ucSimMsg, ( uint32_t ) xMsgSize, &xCloseResult );
+
+    pxResult->ulCpuMs += ( uint32_t ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+    pxResult->ulBlocksIngested++;
+
+    if( eResult == eIngest_Result_Duplicate_Continue )
+    {
+        pxResult->ulDuplicates++;
+    }
+
+    xHeapUsed = xHeapStart - xPortGetFreeHeapSize();
+
+    if( xHeapUsed > pxResult->ulHeapPeak )
+    {
+        pxResult->ulHeapPeak = ( uint32_t ) xHeapUsed;
+    }
+
+    return eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Run a transfer until the agent completes the file, gives up or a fatal error occurs. */
+
+static void prvSimRunTransfer( const SimScenario_t * pxScenario,
+                               SimResult_t * pxResult )
+{
+    OTA_FileContext_t * C = &xSimFile;
+    size_t xHeapStart = xPortGetFreeHeapSize();
+    size_t xMsgSize, xRequestSize;
+    uint32_t ulMomentum = 0U;
+    uint32_t ulRound, ulCount, ulIndex, ulBytesOnLink, ulDelivered;
+    IngestResult_t eResult = eIngest_Result_Accepted_Continue;
+    TickType_t xStart;
+
+    memset( pxResult, 0, sizeof( SimResult_t ) );
+    ulSimRandom = 0x4f54415fUL;
+
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( pdTRUE, prvSimOpenFile( C ) );
+    pxResult->ulCpuMs = ( uint32_t ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+
+    for( ulRound = 0U; ( ulRound < otatestsimMAX_ROUNDS ) && ( eResult >= eIngest_Result_Accepted_Continue ); ulRound++ )
+    {
+        if( ulMomentum >= otatestsimMAX_MOMENTUM )
+        {
+            break;
+        }
+
+        /* The agent encodes a request for everything still missing. */
+        xStart = xTaskGetTickCount();
+        TEST_ASSERT_EQUAL( pdTRUE, OTA_CBOR_Encode_GetStreamRequestMessage( ucSimRequest,
+                                                                           sizeof( ucSimRequest ),
+                                                                           &xRequestSize,
+                                                                           "rdy",
+                                                                           otatestsimSERVER_FILE_ID,
+                                                                           ( int32_t ) OTA_FILE_BLOCK_SIZE,
+                                                                           0,
+                                                                           C->pucRxBlockBitmap,
+                                                                           ( otatestsimNUM_BLOCKS + ( BITS_PER_BYTE - 1U ) ) >> LOG2_BITS_PER_BYTE ) );
+        pxResult->ulCpuMs += ( uint32_t ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+        pxResult->ulRequests++;
+        ulMomentum++;
+
+        ulBytesOnLink = ( uint32_t ) xRequestSize;
+        ulDelivered = 0U;
+        ulCount = prvSimBuildBurst( C, pxScenario );
+
+        for( ulIndex = 0U; ( ulIndex < ulCount ) && ( eResult >= eIngest_Result_Accepted_Continue ); ulIndex++ )
+        {
+            xMsgSize = prvSimEncodeBlock( ulSimBurst[ ulIndex ] );
+            TEST_ASSERT_NOT_EQUAL( 0U, xMsgSize );
+            pxResult->ulBlocksSent++;
+            ulBytesOnLink += ( uint32_t ) xMsgSize;
+
+            if( prvSimChance( pxScenario->ulLossPercent ) == pdFALSE )
+            {
+                eResult = prvSimIngest( C, xMsgSize, xHeapStart, pxResult );
+                ulDelivered++;
+
+                if( ( eResult >= eIngest_Result_Accepted_Continue ) &&
+                    ( prvSimChance( pxScenario->ulDuplicatePercent ) == pdTRUE ) )
+                {
+                    pxResult->ulBlocksSent++;
+                    ulBytesOnLink += ( uint32_t ) xMsgSize;
+                    eResult = prvSimIngest( C, xMsgSize, xHeapStart, pxResult );
+                }
+            }
+        }
+
+        /* Any response resets the momentum, just like in the agent's publish callback. */
+        if( ulDelivered > 0U )
+        {
+            ulMomentum = 0U;
+        }
+
+        pxResult->ulNetworkMs += pxScenario->ulLatencyMs +
+                                 ( ( ulBytesOnLink * 1000U ) / ( pxScenario->ulBandwidthKBps * 1024U ) );
+
+        /* The agent only asks again once its request timer expires without a block arriving. */
+        if( eResult >= eIngest_Result_Accepted_Continue )
+        {
+            pxResult->ulNetworkMs += otaconfigFILE_REQUEST_WAIT_MS;
+        }
+    }
+
+    pxResult->eResult = eResult;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Run a scenario, check that the image was completed and print the measurements. */
+
+static void prvSimRunScenario( const SimScenario_t * pxScenario )
+{
+    SimResult_t xResult;
+    uint32_t ulTotalMs;
+
+    prvSimRunTransfer( pxScenario, &xResult );
+
+    ulTotalMs = xResult.ulNetworkMs + xResult.ulCpuMs;
+
+    configPRINTF( ( "OTA sim [%s]: %u bytes in %u blocks of %u, %u requests, %u blocks sent, %u duplicates (%u%%).\r\n",
+                    pxScenario->pcName,
+                    otatestsimFILE_SIZE,
+                    otatestsimNUM_BLOCKS,
+                    ( uint32_t ) OTA_FILE_BLOCK_SIZE,
+                    xResult.ulRequests,
+                    xResult.ulBlocksSent,
+                    xResult.ulDuplicates,
+                    ( xResult.ulDuplicates * 100U ) / ( ( xResult.ulBlocksIngested > 0U ) ? xResult.ulBlocksIngested : 1U ) ) );
+    configPRINTF( ( "OTA sim [%s]: agent %u KB/s over %u ms, heap peak %u bytes, verified image after %u ms (%u KB/s).\r\n",
+                    pxScenario->pcName,
+                    ( otatestsimFILE_SIZE * 1000U ) / ( ( ( xResult.ulCpuMs > 0U ) ? xResult.ulCpuMs : 1U ) * 1024U ),
+                    xResult.ulCpuMs,
+                    xResult.ulHeapPeak,
+                    ulTotalMs,
+                    ( otatestsimFILE_SIZE * 1000U ) / ( ( ( ulTotalMs > 0U ) ? ulTotalMs : 1U ) * 1024U ) ) );
+
+    TEST_ASSERT_EQUAL_INT( eIngest_Result_FileComplete, xResult.eResult );
+    TEST_ASSERT_NULL( xSimFile.pucRxBlockBitmap );
+    TEST_ASSERT_EQUAL_UINT32( 0U, xSimFile.ulBlocksRemaining );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST_GROUP( Full_OTA_SIM );
+
+TEST_SETUP( Full_OTA_SIM )
+{
+    memset( &xSimFile, 0, sizeof( xSimFile ) );
+}
+
+TEST_TEAR_DOWN( Full_OTA_SIM )
+{
+    /* Frees everything allocated by prvSimOpenFile() and aborts the receive file. */
+    ( void ) TEST_OTA_prvOTA_Close( &xSimFile );
+}
+
+TEST_GROUP_RUNNER( Full_OTA_SIM )
+{
+    RUN_TEST_CASE( Full_OTA_SIM, Sim_IdealLink );
+    RUN_TEST_CASE( Full_OTA_SIM, Sim_LossyLink );
+    RUN_TEST_CASE( Full_OTA_SIM, Sim_ReorderedDuplicates );
+    RUN_TEST_CASE( Full_OTA_SIM, Sim_SlowLink );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_SIM, Sim_IdealLink )
+{
+    static const SimScenario_t xScenario = { "ideal", 0U, 0U, 0U, 50U, 256U };
+
+    prvSimRunScenario( &xScenario );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_SIM, Sim_LossyLink )
+{
+    static const SimScenario_t xScenario = { "lossy", 10U, 0U, 0U, 200U, 64U };
+
+    prvSimRunScenario( &xScenario );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_SIM, Sim_ReorderedDuplicates )
+{
+    static const SimScenario_t xScenario = { "reordered", 5U, 10U, 8U, 200U, 64U };
+
+    prvSimRunScenario( &xScenario );
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_OTA_SIM, Sim_SlowLink )
+{
+    static const SimScenario_t xScenario = { "slow", 2U, 2U, 4U, 1000U, 8U };
+
+    prvSimRunScenario( &xScenario );
+}
@@ -143,6 +143,41 @@ from the FreeRTOSIPConfig.h configuration header file. */
 		#define	ipconfigTCP_WIN_SEG_COUNT		( 256 )
 	#endif
 
+	/* The maximum number of blocks in a Selective ACK (SACK, RFC 2018) that is
+	sent when data arrives out of order.  The first block describes the data
+	that has just arrived, the others the most recently received blocks.  Four
+	blocks take 36 bytes of the 40 bytes available for TCP options. */
+	#ifndef ipconfigTCP_SACK_BLOCKS
+		#define ipconfigTCP_SACK_BLOCKS			( 4 )
+	#endif
+
+	#if( ( ipconfigTCP_SACK_BLOCKS < 1 ) || ( ipconfigTCP_SACK_BLOCKS > 4 ) )
+		#error ipconfigTCP_SACK_BLOCKS must be between 1 and 4
+	#endif
+
+	/* Limit the amount of unacknowledged data with a congestion window
+	(RFC 5681).  Slow start, fast recovery and the reaction to a retransmission
+	time-out are common to all algorithms.  NewReno is always available, CUBIC
+	(RFC 8312) is included when ipconfigUSE_TCP_CUBIC is set.  The algorithm can
+	be selected per socket with the option FREERTOS_SO_TCP_CONGESTION.  Off by
+	default, the stack then sends as much as the peer's window allows, as it
+	did before. */
+	#ifndef ipconfigUSE_TCP_CONGESTION_CONTROL
+		#define ipconfigUSE_TCP_CONGESTION_CONTROL	( 0 )
+	#endif
+
+	#ifndef ipconfigUSE_TCP_CUBIC
+		#define ipconfigUSE_TCP_CUBIC			( 0 )
+	#endif
+
+	#ifndef ipconfigTCP_CONGESTION_ALGORITHM
+		#define ipconfigTCP_CONGESTION_ALGORITHM	FREERTOS_TCP_CC_NEWRENO
+	#endif
+
+	#if( ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( ipconfigUSE_TCP_WIN == 0 ) )
+		#error ipconfigUSE_TCP_CONGESTION_CONTROL requires ipconfigUSE_TCP_WIN
+	#endif
+
 	#ifndef ipconfigIGNORE_UNKNOWN_PACKETS
 		/* When non-zero, TCP will not send RST packets in reply to
 		TCP packets which are unknown, or out-of-order. */
@@ -169,6 +204,18 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define	ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME	portMAX_DELAY
 #endif
 
+/* Bound sockets are found through hash tables: one per protocol keyed on the
+local port, and one for TCP keyed on the local port, the remote IP address and
+the remote port.  This sets the number of buckets of each table, which must be
+a power of 2. */
+#ifndef ipconfigSOCKET_HASH_BUCKETS
+	#define ipconfigSOCKET_HASH_BUCKETS			( 16 )
+#endif
+
+#if( ( ipconfigSOCKET_HASH_BUCKETS & ( ipconfigSOCKET_HASH_BUCKETS - 1 ) ) != 0 )
+	#error ipconfigSOCKET_HASH_BUCKETS must be a power of 2
+#endif
+
 /*
  * FreeRTOS debug logging routine (proposal)
  * The macro will be called in the printf() style. Users can define
@@ -273,6 +320,40 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define ipconfigARP_CACHE_ENTRIES		10
 #endif
 
+/* The ARP cache is indexed by two open-addressed hash tables, one keyed on the
+IP address and one on the MAC address of the entries.  This sets the number of
+slots of each table, which must be a power of 2 and larger than
+ipconfigARP_CACHE_ENTRIES.  By default the tables are at most half full. */
+#ifndef ipconfigARP_HASH_SLOTS
+	#if( ipconfigARP_CACHE_ENTRIES <= 8 )
+		#define ipconfigARP_HASH_SLOTS		( 16 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 16 )
+		#define ipconfigARP_HASH_SLOTS		( 32 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 32 )
+		#define ipconfigARP_HASH_SLOTS		( 64 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 64 )
+		#define ipconfigARP_HASH_SLOTS		( 128 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 128 )
+		#define ipconfigARP_HASH_SLOTS		( 256 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 256 )
+		#define ipconfigARP_HASH_SLOTS		( 512 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 512 )
+		#define ipconfigARP_HASH_SLOTS		( 1024 )
+	#elif( ipconfigARP_CACHE_ENTRIES <= 1024 )
+		#define ipconfigARP_HASH_SLOTS		( 2048 )
+	#else
+		#error Please define ipconfigARP_HASH_SLOTS for this number of ARP cache entries
+	#endif
+#endif
+
+#if( ( ipconfigARP_HASH_SLOTS & ( ipconfigARP_HASH_SLOTS - 1 ) ) != 0 )
+	#error ipconfigARP_HASH_SLOTS must be a power of 2
+#endif
+
+#if( ( ipconfigARP_HASH_SLOTS <= ipconfigARP_CACHE_ENTRIES ) || ( ipconfigARP_HASH_SLOTS > 65536 ) )
+	#error ipconfigARP_HASH_SLOTS must be larger than ipconfigARP_CACHE_ENTRIES, and at most 65536
+#endif
+
 #ifndef ipconfigMAX_ARP_RETRANSMISSIONS
 	#define ipconfigMAX_ARP_RETRANSMISSIONS ( 5u )
 #endif
@@ -397,6 +478,49 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#ifndef ipconfigDNS_CACHE_ENTRIES
 		#define ipconfigDNS_CACHE_ENTRIES			1
 	#endif
+
+	/* The names in the DNS cache are found through a hash table with this
+	number of slots, which must be a power of 2.  Names that share a slot are
+	chained. */
+	#ifndef ipconfigDNS_CACHE_HASH_SLOTS
+		#if( ipconfigDNS_CACHE_ENTRIES <= 8 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 8 )
+		#elif( ipconfigDNS_CACHE_ENTRIES <= 16 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 16 )
+		#elif( ipconfigDNS_CACHE_ENTRIES <= 32 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 32 )
+		#elif( ipconfigDNS_CACHE_ENTRIES <= 64 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 64 )
+		#elif( ipconfigDNS_CACHE_ENTRIES <= 128 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 128 )
+		#elif( ipconfigDNS_CACHE_ENTRIES <= 256 )
+			#define ipconfigDNS_CACHE_HASH_SLOTS	( 256 )
+		#else
+			#error Please define ipconfigDNS_CACHE_HASH_SLOTS for this number of DNS cache entries
+		#endif
+	#endif
+
+	#if( ( ipconfigDNS_CACHE_HASH_SLOTS & ( ipconfigDNS_CACHE_HASH_SLOTS - 1 ) ) != 0 )
+		#error ipconfigDNS_CACHE_HASH_SLOTS must be a power of 2
+	#endif
+
+	#if( ipconfigDNS_CACHE_ENTRIES >= 65535 )
+		#error ipconfigDNS_CACHE_ENTRIES must be less than 65535
+	#endif
+
+	/* An entry stays in the cache for the TTL given by the DNS server, but
+	never longer than this number of seconds. */
+	#ifndef ipconfigDNS_CACHE_MAX_TTL
+		#define ipconfigDNS_CACHE_MAX_TTL			( 86400UL )
+	#endif
+
+	/* A name that does not exist, or that has no IPv4 address, is remembered
+	as a negative entry (RFC 2308).  Its TTL is taken from the SOA record in
+	the reply, but is never longer than this number of seconds.  Set it to zero
+	to disable negative caching. */
+	#ifndef ipconfigDNS_CACHE_MAX_NEGATIVE_TTL
+		#define ipconfigDNS_CACHE_MAX_NEGATIVE_TTL	( 300UL )
+	#endif
 #endif /* ipconfigUSE_DNS_CACHE != 0 */
 
 #ifndef ipconfigCHECK_IP_QUEUE_SPACE
@@ -495,6 +619,15 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM 0
 #endif
 
+/* When ipconfigUSE_FAST_CHECKSUM is non-zero, usGenerateChecksum() adds
+32-bit words into a 64-bit accumulator, 32 bytes per loop iteration, and
+folds the carries once at the end.  This avoids a compare and branch per
+word and is faster on most 32-bit CPUs that do not have checksum offloading.
+CPUs without cheap 64-bit additions may prefer the classic version. */
+#ifndef ipconfigUSE_FAST_CHECKSUM
+	#define ipconfigUSE_FAST_CHECKSUM 0
+#endif
+
 #ifndef ipconfigDHCP_REGISTER_HOSTNAME
 	#define ipconfigDHCP_REGISTER_HOSTNAME 0
 #endif
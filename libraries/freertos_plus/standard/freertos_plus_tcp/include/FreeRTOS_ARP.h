@@ -43,7 +43,7 @@ typedef struct xARP_CACHE_TABLE_ROW
 {
 	uint32_t ulIPAddress;		/* The IP address of an ARP cache entry. */
 	MACAddress_t xMACAddress;  /* The MAC address of an ARP cache entry. */
-	uint8_t ucAge;				/* A value that is periodically decremented but can also be refreshed by active communication.  The ARP cache entry is removed if the value reaches zero. */
+	uint32_t ulExpiry;			/* The count of vARPAgeCache() calls at which the ARP cache entry is removed.  It is moved forward by active communication. */
     uint8_t ucValid;			/* pdTRUE: xMACAddress is valid, pdFALSE: waiting for ARP reply */
 } ARPCacheRow_t;
 
@@ -103,8 +103,9 @@ eARPLookupResult_t eARPGetCacheEntry( uint32_t *pulIPAddress, MACAddress_t * con
 
 #endif
 /*
- * Reduce the age count in each entry within the ARP cache.  An entry is no
- * longer considered valid and is deleted if its age reaches zero.
+ * Advance the age of the entries within the ARP cache.  Only the entries that
+ * are about to expire, or that wait for an ARP reply, are visited.  An entry is
+ * no longer considered valid and is deleted when it expires.
  */
 void vARPAgeCache( void );
 
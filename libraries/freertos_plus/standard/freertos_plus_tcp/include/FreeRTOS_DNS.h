@@ -66,6 +66,13 @@ extern BaseType_t xApplicationDNSQueryHook( const char *pcName );
  */
 uint32_t ulDNSHandlePacket( NetworkBufferDescriptor_t *pxNetworkBuffer );
 
+/*
+ * Returns pdTRUE if xSocket is the socket from which the DNS queries are sent.
+ * The replies to that socket are passed to ulDNSHandlePacket() by the IP-task,
+ * which matches them with the outstanding look-ups.
+ */
+BaseType_t xIsDNSSocket( Socket_t xSocket );
+
 #if( ipconfigUSE_LLMNR == 1 )
 	extern const MACAddress_t xLLMNR_MacAdress;
 #endif /* ipconfigUSE_LLMNR */
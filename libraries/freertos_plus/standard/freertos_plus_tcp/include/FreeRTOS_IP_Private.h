@@ -435,6 +435,15 @@ eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucE
  */
 uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t * pucNextData, size_t uxDataLengthBytes );
 
+/*
+ * Update a checksum after a 16-bit or 32-bit field that it covers has been
+ * changed from an old to a new value, as described in RFC 1624.  The checksum
+ * and the field values are passed as they are stored in the packet, the byte
+ * order does not matter as long as it is the same for all of them.
+ */
+uint16_t usChecksumUpdate16( uint16_t usChecksum, uint16_t usOldValue, uint16_t usNewValue );
+uint16_t usChecksumUpdate32( uint16_t usChecksum, uint32_t ulOldValue, uint32_t ulNewValue );
+
 /* Socket related private functions. */
 
 /* 
@@ -469,7 +478,8 @@ BaseType_t xIPIsNetworkTaskReady( void );
 	void vTCPNetStat( void );
 
 	/*
-	 * At least one socket needs to check for timeouts
+	 * Check the TCP sockets whose timer has expired or which asked for
+	 * attention, and return the time until the next timer expires.
 	 */
 	TickType_t xTCPTimerCheck( BaseType_t xWillSleep );
 
@@ -503,6 +513,7 @@ BaseType_t xIPIsNetworkTaskReady( void );
 	{
 		uint32_t ulRemoteIP;		/* IP address of remote machine */
 		uint16_t usRemotePort;		/* Port on remote machine */
+		ListItem_t xConnectionHashItem;	/* Used to reference the socket from the connection hash table. */
 		struct {
 			/* Most compilers do like bit-flags */
 			uint32_t
@@ -535,7 +546,10 @@ BaseType_t xIPIsNetworkTaskReady( void );
 		} bits;
 		uint32_t ulHighestRxAllowed;
 								/* The highest sequence number that we can receive at any moment */
-		uint16_t usTimeout;		/* Time (in ticks) after which this socket needs attention */
+		TickType_t xTimerExpiry;	/* Tick count at which this socket needs attention */
+		UBaseType_t uxTimerIndex;	/* Position + 1 of this socket in the TCP timer heap, 0 when its timer is not running */
+		ListItem_t xAttentionListItem;	/* Used when an API asks the IP-task to attend to this socket */
+		ListItem_t xWakeUpListItem;	/* Used when events are waiting to be passed to the owner of this socket */
 		uint16_t usCurMSS;		/* Current Maximum Segment Size */
 		uint16_t usInitMSS;		/* Initial maximum segment Size */
 		uint16_t usChildCount;	/* In case of a listening socket: number of connections on this port number */
@@ -617,6 +631,7 @@ typedef struct XSOCKET
 	EventGroupHandle_t xEventGroup;
 
 	ListItem_t xBoundSocketListItem; /* Used to reference the socket from a bound sockets list. */
+	ListItem_t xPortHashItem; /* Used to reference the socket from a bucket of the port hash table. */
 	TickType_t xReceiveBlockTime; /* if recv[to] is called while no data is available, wait this amount of time. Unit in clock-ticks */
 	TickType_t xSendBlockTime; /* if send[to] is called while there is not enough space to send, wait this amount of time. Unit in clock-ticks */
 
@@ -661,6 +676,32 @@ typedef struct XSOCKET
 	 */
 	FreeRTOS_Socket_t *pxTCPSocketLookup( uint32_t ulLocalIP, UBaseType_t uxLocalPort, uint32_t ulRemoteIP, UBaseType_t uxRemotePort );
 
+	/*
+	 * Move a bound TCP socket to the bucket of the connection hash table that
+	 * matches its current remote IP address and port.  Called from the IP-task
+	 * once those are known.
+	 */
+	void vSocketRehashTCP( FreeRTOS_Socket_t *pxSocket );
+
+	/*
+	 * Let the timer of a TCP socket expire after xTicks clock ticks, or stop
+	 * it when xTicks is 0.  Only bound sockets have a timer.  Called from the
+	 * IP-task only.
+	 */
+	void vTCPSocketTimerSet( FreeRTOS_Socket_t *pxSocket, TickType_t xTicks );
+
+	/*
+	 * Return the number of clock ticks before the timer of a TCP socket
+	 * expires, at least 1, or 0 when the timer is not running.
+	 */
+	TickType_t xTCPSocketTimerRemaining( const FreeRTOS_Socket_t *pxSocket );
+
+	/*
+	 * Remember to call vSocketWakeUpUser() for a TCP socket that has events
+	 * for its owner, just before the IP-task goes to sleep.
+	 */
+	void vSocketWakeUpUserLater( FreeRTOS_Socket_t *pxSocket );
+
 #endif /* ipconfigUSE_TCP */
 
 /*
@@ -132,6 +132,15 @@ FreeRTOS_setsockopt(). */
 
 #define FREERTOS_SO_SET_LOW_HIGH_WATER	( 18 )
 
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	#define FREERTOS_SO_TCP_CONGESTION		( 19 )		/* Select the congestion control algorithm, parameter is a pointer to BaseType_t holding FREERTOS_TCP_CC_xxx */
+	#define FREERTOS_SO_TCP_CONGESTION_INFO	( 20 )		/* FreeRTOS_getsockopt() only: read the congestion state, parameter is pointer to TCPCongestionInfo_t */
+#endif
+
+/* Values for the option FREERTOS_SO_TCP_CONGESTION. */
+#define FREERTOS_TCP_CC_NEWRENO			( 1 )
+#define FREERTOS_TCP_CC_CUBIC			( 2 )		/* Only available when ipconfigUSE_TCP_CUBIC is set */
+
 #define FREERTOS_NOT_LAST_IN_FRAGMENTED_PACKET 	( 0x80 )  /* For internal use only, but also part of an 8-bit bitwise value. */
 #define FREERTOS_FRAGMENTED_PACKET				( 0x40 )  /* For internal use only, but also part of an 8-bit bitwise value. */
 
@@ -162,6 +171,13 @@ typedef struct xLOW_HIGH_WATER {
 	size_t uxEnoughSpace;	/* Send a GO when buffer space grows above X bytes */
 } LowHighWater_t;
 
+typedef struct xTCP_CONGESTION_INFO {
+	/* Structure to fill for the 'FREERTOS_SO_TCP_CONGESTION_INFO' option */
+	BaseType_t xAlgorithm;	/* FREERTOS_TCP_CC_NEWRENO or FREERTOS_TCP_CC_CUBIC */
+	uint32_t ulCWnd;		/* Congestion window, unit: bytes */
+	uint32_t ulSSThresh;	/* Slow start threshold, unit: bytes */
+} TCPCongestionInfo_t;
+
 /* For compatibility with the expected Berkeley sockets naming. */
 #define socklen_t uint32_t
 
@@ -291,9 +307,30 @@ FreeRTOS_rx_size(). */
  * For advanced applications only:
  * Get a direct pointer to the circular transmit buffer.
  * '*pxLength' will contain the number of bytes that may be written.
+ * After writing up to '*pxLength' bytes, commit them by passing the same
+ * pointer to FreeRTOS_send(), which will then not copy the data:
+ *
+ *		pucHead = FreeRTOS_get_tx_head( xSocket, &xLength );
+ *		xLength = prvFillBuffer( pucHead, xLength );
+ *		FreeRTOS_send( xSocket, pucHead, xLength, 0 );
  */
 uint8_t *FreeRTOS_get_tx_head( Socket_t xSocket, BaseType_t *pxLength );
 
+/*
+ * For advanced applications only:
+ * FreeRTOS_recv() with the FREERTOS_ZERO_COPY flag returns a pointer to the
+ * data in the reception stream, without removing it.  Once the data has been
+ * used, this function releases 'xByteCount' bytes of it:
+ *
+ *		xLength = FreeRTOS_recv( xSocket, &pucData, 0, FREERTOS_ZERO_COPY );
+ *		if( xLength > 0 )
+ *		{
+ *			prvUseData( pucData, xLength );
+ *			FreeRTOS_ReleaseTCPPayloadBuffer( xSocket, pucData, xLength );
+ *		}
+ */
+BaseType_t FreeRTOS_ReleaseTCPPayloadBuffer( Socket_t xSocket, void const *pvBuffer, BaseType_t xByteCount );
+
 #endif /* ipconfigUSE_TCP */
 
 /*
@@ -344,6 +381,7 @@ typedef union xTCP_UDP_HANDLER
 } F_TCP_UDP_Handler_t;
 
 BaseType_t FreeRTOS_setsockopt( Socket_t xSocket, int32_t lLevel, int32_t lOptionName, const void *pvOptionValue, size_t xOptionLength );
+BaseType_t FreeRTOS_getsockopt( Socket_t xSocket, int32_t lLevel, int32_t lOptionName, void *pvOptionValue, size_t *pxOptionLength );
 BaseType_t FreeRTOS_closesocket( Socket_t xSocket );
 uint32_t FreeRTOS_gethostbyname( const char *pcHostName );
 uint32_t FreeRTOS_inet_addr( const char * pcIPAddress );
@@ -74,6 +74,27 @@ typedef struct xTCP_WINSIZE
 	uint32_t ulTxWindowLength;
 } TCPWinSize_t;
 
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+typedef struct xTCP_CONGESTION
+{
+	uint32_t ulCWnd;				/* Congestion window: the number of bytes which may be in flight */
+	uint32_t ulSSThresh;			/* Slow start threshold: below it, the cwnd grows with every ACK */
+	uint32_t ulBytesAcked;			/* Bytes ACK'd which have not yet led to a growth of the cwnd */
+	uint32_t ulSackedBytes;			/* Bytes above SND.UNA which the peer has confirmed with a SACK */
+	uint32_t ulRecover;				/* The highest sequence number sent when a recovery started */
+	TCPTimer_t xRecoveryTimer;		/* The moment at which the current recovery started */
+	uint8_t ucAlgorithm;			/* FREERTOS_TCP_CC_NEWRENO or FREERTOS_TCP_CC_CUBIC */
+	uint8_t ucState;				/* Open, fast recovery or recovery after a time-out */
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+	uint8_t bEpochStarted;			/* CUBIC: xEpochTimer and ulK are valid */
+	uint32_t ulWMax;				/* CUBIC: cwnd just before the last reduction */
+	uint32_t ulOriginPoint;			/* CUBIC: cwnd at the plateau of the cubic function */
+	uint32_t ulK;					/* CUBIC: number of ms it takes to reach the plateau */
+	TCPTimer_t xEpochTimer;			/* CUBIC: start of the current congestion avoidance epoch */
+#endif
+} TCPCongestion_t;
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 /*
  * If TCP time-stamps are being used, they will occupy 12 bytes in
  * each packet, and thus the message space will become smaller
@@ -85,6 +106,10 @@ typedef struct xTCP_WINSIZE
 	#define ipSIZE_TCP_OPTIONS   12u
 #endif
 
+/* A SACK option: NOP, NOP, SACK, LEN, followed by a pair of sequence numbers
+ * for each block */
+#define ipSIZE_TCP_SACK_OPTIONS	( 4u + ( 8u * ipconfigTCP_SACK_BLOCKS ) )
+
 /*
  *	Every TCP connection owns a TCP window for the administration of all packets
  *	It owns two sets of segment descriptors, incoming and outgoing
@@ -123,9 +148,12 @@ typedef struct xTCP_WINDOW
 	List_t xTxQueue;					/* Transmit queue: segments queued for transmission */
 	List_t xWaitQueue;					/* Waiting queue:  outstanding segments */
 	TCPSegment_t *pxHeadSegment;		/* points to a segment which has not been transmitted and it's size is still growing (user data being added) */
-	uint32_t ulOptionsData[ipSIZE_TCP_OPTIONS/sizeof(uint32_t)];	/* Contains the options we send out */
+	uint32_t ulOptionsData[ipSIZE_TCP_SACK_OPTIONS/sizeof(uint32_t)];	/* Contains the options we send out */
 	List_t xTxSegments;					/* A linked list of all transmission segments, sorted on sequence number */
-	List_t xRxSegments;					/* A linked list of reception segments, order depends on sequence of arrival */
+	List_t xRxSegments;					/* A linked list of disjoint blocks of out-of-order data, the most recently received block last */
+	#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		TCPCongestion_t xCongestion;	/* Limits the amount of data in flight, see FreeRTOS_TCP_WIN.c */
+	#endif
 #else
 	/* For tiny TCP, there is only 1 outstanding TX segment */
 	TCPSegment_t xTxSegment;			/* Priority queue */
@@ -202,9 +230,19 @@ uint32_t ulTCPWindowTxGet( TCPWindow_t *pxWindow, uint32_t ulWindowSize, int32_t
 /* Receive a normal ACK */
 uint32_t ulTCPWindowTxAck( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
 
-/* Receive a SACK option */
+/* Receive a SACK option with a single block */
 uint32_t ulTCPWindowTxSack( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast );
 
+/* Receive a SACK option with 'xCount' blocks, stored as pairs of first and
+ * last + 1 sequence numbers in 'pulEdges' */
+uint32_t ulTCPWindowTxSackBlocks( TCPWindow_t *pxWindow, const uint32_t *pulEdges, BaseType_t xCount );
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	/* Select the congestion control algorithm, either FREERTOS_TCP_CC_NEWRENO
+	 * or FREERTOS_TCP_CC_CUBIC.  Returns pdFALSE if it is not available */
+	BaseType_t xTCPWindowCongestionSelect( TCPWindow_t *pxWindow, BaseType_t xAlgorithm );
+#endif
+
 
 #ifdef __cplusplus
 }	/* extern "C" */
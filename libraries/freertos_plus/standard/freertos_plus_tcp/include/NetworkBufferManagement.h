@@ -45,12 +45,29 @@ UBaseType_t uxGetNumberOfFreeNetworkBuffers( void );
 /* Get the lowest number of free network buffers. */
 UBaseType_t uxGetMinimumFreeNetworkBuffers( void );
 
+/* Usage of the storage of the network buffers, see xGetNetworkBufferStats(). */
+typedef struct xNETWORK_BUFFER_STATS
+{
+	size_t uxBlockSize;			/* Size of the buffers in this class, 0 if they come from the heap. */
+	UBaseType_t uxBlockCount;	/* Number of buffers in this class. */
+	size_t uxStaticBytes;		/* RAM reserved for this class, 0 if it uses the heap. */
+	UBaseType_t uxInUse;		/* Number of buffers currently in use. */
+	UBaseType_t uxMaxInUse;		/* Highest number of buffers in use since booting. */
+	UBaseType_t uxFailures;		/* Requests that found no free buffer in this class. */
+} NetworkBufferStats_t;
+
+/* Get the usage of size class 'uxClass' of the buffer allocation scheme.
+Returns pdFAIL when the scheme has no such class.  BufferAllocation_1.c and
+BufferAllocation_2.c have a single class, BufferAllocation_3.c has three. */
+BaseType_t xGetNetworkBufferStats( UBaseType_t uxClass, NetworkBufferStats_t *pxStats );
+
 /* Copy a network buffer into a bigger buffer. */
 NetworkBufferDescriptor_t *pxDuplicateNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer,
 	BaseType_t xNewLength);
 
 /* Increase the size of a Network Buffer.
-In case BufferAllocation_2.c is used, the new space must be allocated. */
+In case BufferAllocation_2.c or BufferAllocation_3.c is used, the new space must
+be allocated. */
 NetworkBufferDescriptor_t *pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
 	size_t xNewSizeBytes );
 
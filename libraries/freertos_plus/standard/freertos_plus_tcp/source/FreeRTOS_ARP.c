@@ -57,6 +57,17 @@ entry is still valid and can therefore be refreshed. */
 	#define arpGRATUITOUS_ARP_PERIOD					( pdMS_TO_TICKS( 20000 ) )
 #endif
 
+/* The two hash indexes of the ARP cache.  A slot holds the number of a row in
+xARPCache[] plus one, or arpINDEX_EMPTY. */
+#define arpINDEX_IP				( 0 )
+#define arpINDEX_MAC			( 1 )
+#define arpINDEX_EMPTY			( 0u )
+
+/* Fibonacci hashing: the multiplication mixes all bits of the key into the
+upper half, of which the lower bits are used. */
+#define arpHASH( ulKey )		( ( UBaseType_t ) ( ( ( uint32_t ) ( ( ulKey ) * 0x9E3779B1UL ) >> 16 ) & ( ipconfigARP_HASH_SLOTS - 1u ) ) )
+#define arpNEXT_SLOT( uxSlot )	( ( ( uxSlot ) + 1u ) & ( ipconfigARP_HASH_SLOTS - 1u ) )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -64,11 +75,83 @@ entry is still valid and can therefore be refreshed. */
  */
 static eARPLookupResult_t prvCacheLookup( uint32_t ulAddressToLookup, MACAddress_t * const pxMACAddress );
 
+/*
+ * Find the row that holds ulIPAddress, returns -1 if there is none.
+ */
+static BaseType_t prvARPFindIP( uint32_t ulIPAddress );
+
+/*
+ * Several rows may hold the same MAC address.  Returns the next valid row with
+ * pxMACAddress, starting at slot *puxSlot of the MAC index, or -1 if there are
+ * no more.  *puxSlot must be initialised with prvARPHashMAC( pxMACAddress ).
+ */
+static BaseType_t prvARPNextMAC( const MACAddress_t *pxMACAddress, UBaseType_t *puxSlot );
+
+/*
+ * The home slot of a MAC address in the MAC index.
+ */
+static UBaseType_t prvARPHashMAC( const MACAddress_t *pxMACAddress );
+
+/*
+ * Add a row to, or remove it from, one of the hash indexes.  The row must not
+ * change its key while it is in the index.
+ */
+static void prvARPIndexInsert( BaseType_t xIndex, BaseType_t xRow );
+static void prvARPIndexRemove( BaseType_t xIndex, BaseType_t xRow );
+
+/*
+ * Maintain the aging heap, see xARPHeap[].
+ */
+static void prvARPHeapSwap( UBaseType_t uxFirst, UBaseType_t uxSecond );
+static void prvARPHeapSetDeadline( BaseType_t xRow, uint32_t ulDeadline );
+
+/*
+ * Get a row for a new entry: a free row, or else the row that would expire
+ * first.  The row is added to the aging heap.
+ */
+static BaseType_t prvARPRowAllocate( void );
+
+/*
+ * Remove a row from the indexes and from the aging heap, and clear it.
+ */
+static void prvARPRowRelease( BaseType_t xRow );
+
+/*
+ * Store a (new) MAC address in a row, which becomes valid.
+ */
+static void prvARPRowSetMAC( BaseType_t xRow, const MACAddress_t *pxMACAddress );
+
 /*-----------------------------------------------------------*/
 
 /* The ARP cache. */
 static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
 
+/* The hash indexes of xARPCache[], on the IP address of the rows that are in
+use and on the MAC address of the valid rows.  Collisions are resolved with
+linear probing, a removal shifts the following slots back so that no
+tombstones are needed. */
+static uint16_t usARPIndex[ 2 ][ ipconfigARP_HASH_SLOTS ];
+
+/* The rows that are in use form a binary min-heap in the first uxARPHeapCount
+items of xARPHeap[], ordered on the value of ulARPClock at which
+vARPAgeCache() must visit the row.  When an entry is refreshed, only its
+ulExpiry is moved forward: its deadline is corrected when it comes on top.  The
+items from uxARPHeapCount up to uxARPRowsUsed hold the rows that have been
+released.  The rows from uxARPRowsUsed have never been used. */
+typedef struct xARP_HEAP_ITEM
+{
+	uint32_t ulDeadline;
+	uint16_t usRow;
+} ARPHeapItem_t;
+
+static ARPHeapItem_t xARPHeap[ ipconfigARP_CACHE_ENTRIES ];
+static uint16_t usARPHeapPosition[ ipconfigARP_CACHE_ENTRIES ];
+static UBaseType_t uxARPHeapCount = 0u;
+static UBaseType_t uxARPRowsUsed = 0u;
+
+/* Counts the calls to vARPAgeCache(). */
+static uint32_t ulARPClock = 0UL;
+
 /* The time at which the last gratuitous ARP was sent.  Gratuitous ARPs are used
 to ensure ARP tables are up to date and to detect IP address conflicts. */
 static TickType_t xLastGratuitousARPTime = ( TickType_t ) 0;
@@ -189,18 +272,17 @@ uint32_t ulTargetProtocolAddress, ulSenderProtocolAddress;
 
 	uint32_t ulARPRemoveCacheEntryByMac( const MACAddress_t * pxMACAddress )
 	{
-	BaseType_t x;
+	BaseType_t xRow;
+	UBaseType_t uxSlot = prvARPHashMAC( pxMACAddress );
 	uint32_t lResult = 0;
 
-		/* For each entry in the ARP cache table. */
-		for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+		/* Find the first entry with this MAC address. */
+		xRow = prvARPNextMAC( pxMACAddress, &uxSlot );
+
+		if( xRow >= 0 )
 		{
-			if( ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
-			{
-				lResult = xARPCache[ x ].ulIPAddress;
-				memset( &xARPCache[ x ], '\0', sizeof( xARPCache[ x ] ) );
-				break;
-			}
+			lResult = xARPCache[ xRow ].ulIPAddress;
+			prvARPRowRelease( xRow );
 		}
 
 		return lResult;
@@ -211,11 +293,11 @@ uint32_t ulTargetProtocolAddress, ulSenderProtocolAddress;
 
 void vARPRefreshCacheEntry( const MACAddress_t * pxMACAddress, const uint32_t ulIPAddress )
 {
-BaseType_t x = 0;
-BaseType_t xIpEntry = -1;
+BaseType_t xIpEntry;
 BaseType_t xMacEntry = -1;
-BaseType_t xUseEntry = 0;
-uint8_t ucMinAgeFound = 0U;
+BaseType_t xUseEntry;
+BaseType_t xRow;
+UBaseType_t uxSlot;
 
 	#if( ipconfigARP_STORES_REMOTE_ADDRESSES == 0 )
 		/* Only process the IP address if it is on the local network.
@@ -233,111 +315,115 @@ uint8_t ucMinAgeFound = 0U;
 		if( pdTRUE )
 	#endif
 	{
-		/* Start with the maximum possible number. */
-		ucMinAgeFound--;
+		/* Does a row in the cache table hold an entry for the IP address
+		being queried? */
+		xIpEntry = prvARPFindIP( ulIPAddress );
 
-		/* For each entry in the ARP cache table. */
-		for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+		if( ulIPAddress == 0UL )
+		{
+			/* The address 0.0.0.0 is never looked up, and it marks the rows
+			that are not in use. */
+		}
+		else if( ( xIpEntry >= 0 ) && ( pxMACAddress == NULL ) )
+		{
+			/* In case the parameter pxMACAddress is NULL, an entry is reserved
+			to indicate that there is an outstanding ARP request.  There is an
+			entry already. */
+		}
+		else if( ( xIpEntry >= 0 ) &&
+				 ( memcmp( xARPCache[ xIpEntry ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+		{
+			/* This function will be called for each received packet, this is
+			by far the most common path.  The aging heap is not touched, the
+			new expiry is seen when the entry comes on top. */
+			xARPCache[ xIpEntry ].ulExpiry = ulARPClock + ( uint32_t ) ipconfigMAX_ARP_AGE;
+
+			if( xARPCache[ xIpEntry ].ucValid == ( uint8_t ) pdFALSE )
+			{
+				prvARPRowSetMAC( xIpEntry, pxMACAddress );
+			}
+		}
+		else
 		{
-			/* Does this line in the cache table hold an entry for the IP
-			address	being queried? */
-			if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+			if( pxMACAddress != NULL )
 			{
-				if( pxMACAddress == NULL )
+				/* See if the MAC address is stored for another IP address: then
+				either of the two entries must be cleared. */
+				uxSlot = prvARPHashMAC( pxMACAddress );
+
+				while( ( xRow = prvARPNextMAC( pxMACAddress, &uxSlot ) ) >= 0 )
 				{
-					/* In case the parameter pxMACAddress is NULL, an entry will be reserved to
-					indicate that there is an outstanding ARP request, This entry will have
-					"ucValid == pdFALSE". */
-					xIpEntry = x;
+				#if( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+					/* If ARP stores the MAC address of IP addresses outside the
+					network, than the MAC address of the gateway should not be
+					overwritten. */
+					BaseType_t bIsLocal[ 2 ];
+					bIsLocal[ 0 ] = ( ( xARPCache[ xRow ].ulIPAddress & xNetworkAddressing.ulNetMask ) == ( ( *ipLOCAL_IP_ADDRESS_POINTER ) & xNetworkAddressing.ulNetMask ) );
+					bIsLocal[ 1 ] = ( ( ulIPAddress & xNetworkAddressing.ulNetMask ) == ( ( *ipLOCAL_IP_ADDRESS_POINTER ) & xNetworkAddressing.ulNetMask ) );
+					if( bIsLocal[ 0 ] == bIsLocal[ 1 ] )
+					{
+						xMacEntry = xRow;
+						break;
+					}
+				#else
+					xMacEntry = xRow;
 					break;
+				#endif
 				}
+			}
+
+			if( xMacEntry >= 0 )
+			{
+				xUseEntry = xMacEntry;
 
-				/* See if the MAC-address also matches. */
-				if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+				if( xIpEntry >= 0 )
 				{
-					/* This function will be called for each received packet
-					As this is by far the most common path the coding standard
-					is relaxed in this case and a return is permitted as an
-					optimisation. */
-					xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
-					xARPCache[ x ].ucValid = ( uint8_t ) pdTRUE;
-					return;
+					/* Both the MAC address as well as the IP address were found in
+					different locations: clear the entry which matches the
+					IP-address */
+					prvARPRowRelease( xIpEntry );
 				}
-
-				/* Found an entry containing ulIPAddress, but the MAC address
-				doesn't match.  Might be an entry with ucValid=pdFALSE, waiting
-				for an ARP reply.  Still want to see if there is match with the
-				given MAC address.ucBytes.  If found, either of the two entries
-				must be cleared. */
-				xIpEntry = x;
 			}
-			else if( ( pxMACAddress != NULL ) && ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+			else if( xIpEntry >= 0 )
 			{
-				/* Found an entry with the given MAC-address, but the IP-address
-				is different.  Continue looping to find a possible match with
-				ulIPAddress. */
-	#if( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
-				/* If ARP stores the MAC address of IP addresses outside the
-				network, than the MAC address of the gateway should not be
-				overwritten. */
-				BaseType_t bIsLocal[ 2 ];
-				bIsLocal[ 0 ] = ( ( xARPCache[ x ].ulIPAddress & xNetworkAddressing.ulNetMask ) == ( ( *ipLOCAL_IP_ADDRESS_POINTER ) & xNetworkAddressing.ulNetMask ) );
-				bIsLocal[ 1 ] = ( ( ulIPAddress & xNetworkAddressing.ulNetMask ) == ( ( *ipLOCAL_IP_ADDRESS_POINTER ) & xNetworkAddressing.ulNetMask ) );
-				if( bIsLocal[ 0 ] == bIsLocal[ 1 ] )
-				{
-					xMacEntry = x;
-				}
-	#else
-				xMacEntry = x;
-	#endif
+				/* An entry containing the IP-address was found, but it had a different MAC address */
+				xUseEntry = xIpEntry;
 			}
-			/* _HT_
-			Shouldn't we test for xARPCache[ x ].ucValid == pdFALSE here ? */
-			else if( xARPCache[ x ].ucAge < ucMinAgeFound )
+			else
 			{
-				/* As the table is traversed, remember the table row that
-				contains the oldest entry (the lowest age count, as ages are
-				decremented to zero) so the row can be re-used if this function
-				needs to add an entry that does not already exist. */
-				ucMinAgeFound = xARPCache[ x ].ucAge;
-				xUseEntry = x;
+				/* If the entry was not found, we use a free row or the oldest
+				entry. */
+				xUseEntry = prvARPRowAllocate();
 			}
-		}
 
-		if( xMacEntry >= 0 )
-		{
-			xUseEntry = xMacEntry;
-
-			if( xIpEntry >= 0 )
+			if( xARPCache[ xUseEntry ].ulIPAddress != ulIPAddress )
 			{
-				/* Both the MAC address as well as the IP address were found in
-				different locations: clear the entry which matches the
-				IP-address */
-				memset( &xARPCache[ xIpEntry ], '\0', sizeof( xARPCache[ xIpEntry ] ) );
-			}
-		}
-		else if( xIpEntry >= 0 )
-		{
-			/* An entry containing the IP-address was found, but it had a different MAC address */
-			xUseEntry = xIpEntry;
-		}
+				if( xARPCache[ xUseEntry ].ulIPAddress != 0UL )
+				{
+					prvARPIndexRemove( arpINDEX_IP, xUseEntry );
+				}
 
-		/* If the entry was not found, we use the oldest entry and set the IPaddress */
-		xARPCache[ xUseEntry ].ulIPAddress = ulIPAddress;
+				xARPCache[ xUseEntry ].ulIPAddress = ulIPAddress;
+				prvARPIndexInsert( arpINDEX_IP, xUseEntry );
+			}
 
-		if( pxMACAddress != NULL )
-		{
-			memcpy( xARPCache[ xUseEntry ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) );
+			if( pxMACAddress != NULL )
+			{
+				prvARPRowSetMAC( xUseEntry, pxMACAddress );
 
-			iptraceARP_TABLE_ENTRY_CREATED( ulIPAddress, (*pxMACAddress) );
-			/* And this entry does not need immediate attention */
-			xARPCache[ xUseEntry ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
-			xARPCache[ xUseEntry ].ucValid = ( uint8_t ) pdTRUE;
-		}
-		else if( xIpEntry < 0 )
-		{
-			xARPCache[ xUseEntry ].ucAge = ( uint8_t ) ipconfigMAX_ARP_RETRANSMISSIONS;
-			xARPCache[ xUseEntry ].ucValid = ( uint8_t ) pdFALSE;
+				iptraceARP_TABLE_ENTRY_CREATED( ulIPAddress, (*pxMACAddress) );
+				/* And this entry does not need immediate attention */
+				xARPCache[ xUseEntry ].ulExpiry = ulARPClock + ( uint32_t ) ipconfigMAX_ARP_AGE;
+				prvARPHeapSetDeadline( xUseEntry, xARPCache[ xUseEntry ].ulExpiry - ( uint32_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST );
+			}
+			else
+			{
+				/* A new entry that waits for an ARP reply: the request is
+				repeated at every call to vARPAgeCache(). */
+				xARPCache[ xUseEntry ].ulExpiry = ulARPClock + ( uint32_t ) ipconfigMAX_ARP_RETRANSMISSIONS;
+				xARPCache[ xUseEntry ].ucValid = ( uint8_t ) pdFALSE;
+				prvARPHeapSetDeadline( xUseEntry, ulARPClock + 1UL );
+			}
 		}
 	}
 }
@@ -346,20 +432,18 @@ uint8_t ucMinAgeFound = 0U;
 #if( ipconfigUSE_ARP_REVERSED_LOOKUP == 1 )
 	eARPLookupResult_t eARPGetCacheEntryByMac( MACAddress_t * const pxMACAddress, uint32_t *pulIPAddress )
 	{
-	BaseType_t x;
+	BaseType_t xRow;
+	UBaseType_t uxSlot = prvARPHashMAC( pxMACAddress );
 	eARPLookupResult_t eReturn = eARPCacheMiss;
 
-		/* Loop through each entry in the ARP cache. */
-		for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+		/* Does a row in the ARP cache table hold an entry for the MAC address
+		being searched? */
+		xRow = prvARPNextMAC( pxMACAddress, &uxSlot );
+
+		if( xRow >= 0 )
 		{
-			/* Does this row in the ARP cache table hold an entry for the MAC
-			address being searched? */
-			if( memcmp( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) ) == 0 )
-			{
-				*pulIPAddress = xARPCache[ x ].ulIPAddress;
-				eReturn = eARPCacheHit;
-				break;
-			}
+			*pulIPAddress = xARPCache[ xRow ].ulIPAddress;
+			eReturn = eARPCacheHit;
 		}
 
 		return eReturn;
@@ -460,74 +544,342 @@ uint32_t ulAddressToLookup;
 
 static eARPLookupResult_t prvCacheLookup( uint32_t ulAddressToLookup, MACAddress_t * const pxMACAddress )
 {
-BaseType_t x;
+BaseType_t xRow;
 eARPLookupResult_t eReturn = eARPCacheMiss;
 
-	/* Loop through each entry in the ARP cache. */
-	for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+	/* Does a row in the ARP cache table hold an entry for the IP address
+	being queried? */
+	xRow = prvARPFindIP( ulAddressToLookup );
+
+	if( xRow >= 0 )
 	{
-		/* Does this row in the ARP cache table hold an entry for the IP address
-		being queried? */
-		if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
+		/* A matching valid entry was found. */
+		if( xARPCache[ xRow ].ucValid == ( uint8_t ) pdFALSE )
+		{
+			/* This entry is waiting an ARP reply, so is not valid. */
+			eReturn = eCantSendPacket;
+		}
+		else
+		{
+			/* A valid entry was found. */
+			memcpy( pxMACAddress->ucBytes, xARPCache[ xRow ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+			eReturn = eARPCacheHit;
+		}
+	}
+
+	return eReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvARPHashMAC( const MACAddress_t *pxMACAddress )
+{
+const uint8_t *pucBytes = pxMACAddress->ucBytes;
+uint32_t ulKey;
+
+	/* The last four bytes differ most between the devices of a vendor. */
+	ulKey = ( ( ( uint32_t ) pucBytes[ 2 ] ) << 24 ) | ( ( ( uint32_t ) pucBytes[ 3 ] ) << 16 ) |
+			( ( ( uint32_t ) pucBytes[ 4 ] ) << 8 ) | ( ( uint32_t ) pucBytes[ 5 ] );
+	ulKey ^= ( ( ( uint32_t ) pucBytes[ 0 ] ) << 8 ) | ( ( uint32_t ) pucBytes[ 1 ] );
+
+	return arpHASH( ulKey );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvARPRowHash( BaseType_t xIndex, BaseType_t xRow )
+{
+UBaseType_t uxReturn;
+
+	if( xIndex == arpINDEX_IP )
+	{
+		uxReturn = arpHASH( xARPCache[ xRow ].ulIPAddress );
+	}
+	else
+	{
+		uxReturn = prvARPHashMAC( &( xARPCache[ xRow ].xMACAddress ) );
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvARPFindIP( uint32_t ulIPAddress )
+{
+UBaseType_t uxSlot = arpHASH( ulIPAddress );
+BaseType_t xRow, xReturn = -1;
+
+	while( usARPIndex[ arpINDEX_IP ][ uxSlot ] != arpINDEX_EMPTY )
+	{
+		xRow = ( BaseType_t ) usARPIndex[ arpINDEX_IP ][ uxSlot ] - 1;
+
+		if( xARPCache[ xRow ].ulIPAddress == ulIPAddress )
+		{
+			xReturn = xRow;
+			break;
+		}
+
+		uxSlot = arpNEXT_SLOT( uxSlot );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvARPNextMAC( const MACAddress_t *pxMACAddress, UBaseType_t *puxSlot )
+{
+BaseType_t xRow, xReturn = -1;
+
+	while( usARPIndex[ arpINDEX_MAC ][ *puxSlot ] != arpINDEX_EMPTY )
+	{
+		xRow = ( BaseType_t ) usARPIndex[ arpINDEX_MAC ][ *puxSlot ] - 1;
+		*puxSlot = arpNEXT_SLOT( *puxSlot );
+
+		if( memcmp( xARPCache[ xRow ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
+		{
+			xReturn = xRow;
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPIndexInsert( BaseType_t xIndex, BaseType_t xRow )
+{
+UBaseType_t uxSlot = prvARPRowHash( xIndex, xRow );
+
+	/* There are more slots than rows, so a free slot will be found. */
+	while( usARPIndex[ xIndex ][ uxSlot ] != arpINDEX_EMPTY )
+	{
+		uxSlot = arpNEXT_SLOT( uxSlot );
+	}
+
+	usARPIndex[ xIndex ][ uxSlot ] = ( uint16_t ) ( xRow + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPIndexRemove( BaseType_t xIndex, BaseType_t xRow )
+{
+UBaseType_t uxSlot = prvARPRowHash( xIndex, xRow );
+UBaseType_t uxNext, uxHome;
+uint16_t *pusIndex = usARPIndex[ xIndex ];
+
+	while( ( pusIndex[ uxSlot ] != ( uint16_t ) ( xRow + 1 ) ) && ( pusIndex[ uxSlot ] != arpINDEX_EMPTY ) )
+	{
+		uxSlot = arpNEXT_SLOT( uxSlot );
+	}
+
+	if( pusIndex[ uxSlot ] != arpINDEX_EMPTY )
+	{
+		pusIndex[ uxSlot ] = arpINDEX_EMPTY;
+
+		/* The slots that follow, up to the next empty slot, may belong to
+		rows that passed the slot that just became empty while probing.  Shift
+		those back so that they can still be found. */
+		for( uxNext = arpNEXT_SLOT( uxSlot ); pusIndex[ uxNext ] != arpINDEX_EMPTY; uxNext = arpNEXT_SLOT( uxNext ) )
 		{
-			/* A matching valid entry was found. */
-			if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+			uxHome = prvARPRowHash( xIndex, ( BaseType_t ) pusIndex[ uxNext ] - 1 );
+
+			/* Can the row move to the empty slot, without ending up in front
+			of its home slot? */
+			if( ( ( uxNext - uxHome ) & ( ipconfigARP_HASH_SLOTS - 1u ) ) >= ( ( uxNext - uxSlot ) & ( ipconfigARP_HASH_SLOTS - 1u ) ) )
 			{
-				/* This entry is waiting an ARP reply, so is not valid. */
-				eReturn = eCantSendPacket;
+				pusIndex[ uxSlot ] = pusIndex[ uxNext ];
+				pusIndex[ uxNext ] = arpINDEX_EMPTY;
+				uxSlot = uxNext;
 			}
-			else
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPHeapSwap( UBaseType_t uxFirst, UBaseType_t uxSecond )
+{
+ARPHeapItem_t xItem = xARPHeap[ uxFirst ];
+
+	xARPHeap[ uxFirst ] = xARPHeap[ uxSecond ];
+	xARPHeap[ uxSecond ] = xItem;
+	usARPHeapPosition[ xARPHeap[ uxFirst ].usRow ] = ( uint16_t ) uxFirst;
+	usARPHeapPosition[ xARPHeap[ uxSecond ].usRow ] = ( uint16_t ) uxSecond;
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPHeapSetDeadline( BaseType_t xRow, uint32_t ulDeadline )
+{
+UBaseType_t uxPosition = ( UBaseType_t ) usARPHeapPosition[ xRow ];
+UBaseType_t uxChild;
+
+	/* The deadlines are compared as the difference to ulARPClock, so that
+	they may wrap around. */
+	xARPHeap[ uxPosition ].ulDeadline = ulDeadline;
+
+	/* Move up while the parent has a later deadline... */
+	while( ( uxPosition > 0u ) &&
+		   ( ( int32_t ) ( xARPHeap[ ( uxPosition - 1u ) / 2u ].ulDeadline - ulDeadline ) > 0 ) )
+	{
+		prvARPHeapSwap( uxPosition, ( uxPosition - 1u ) / 2u );
+		uxPosition = ( uxPosition - 1u ) / 2u;
+	}
+
+	/* ...or move down while a child has an earlier deadline. */
+	for( ;; )
+	{
+		uxChild = ( 2u * uxPosition ) + 1u;
+
+		if( uxChild >= uxARPHeapCount )
+		{
+			break;
+		}
+
+		if( ( ( uxChild + 1u ) < uxARPHeapCount ) &&
+			( ( int32_t ) ( xARPHeap[ uxChild + 1u ].ulDeadline - xARPHeap[ uxChild ].ulDeadline ) < 0 ) )
+		{
+			uxChild++;
+		}
+
+		if( ( int32_t ) ( xARPHeap[ uxChild ].ulDeadline - ulDeadline ) >= 0 )
+		{
+			break;
+		}
+
+		prvARPHeapSwap( uxPosition, uxChild );
+		uxPosition = uxChild;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvARPRowAllocate( void )
+{
+BaseType_t xRow;
+ARPCacheRow_t *pxRow;
+
+	if( uxARPHeapCount == uxARPRowsUsed )
+	{
+		if( uxARPRowsUsed < ( UBaseType_t ) ipconfigARP_CACHE_ENTRIES )
+		{
+			/* Take a row that has never been used. */
+			xARPHeap[ uxARPRowsUsed ].usRow = ( uint16_t ) uxARPRowsUsed;
+			usARPHeapPosition[ uxARPRowsUsed ] = ( uint16_t ) uxARPRowsUsed;
+			uxARPRowsUsed++;
+		}
+		else
+		{
+			/* All rows are in use: re-use the row of the entry that expires
+			first.  Entries that were refreshed since they were put in the heap
+			are put in their place first. */
+			for( ;; )
 			{
-				/* A valid entry was found. */
-				memcpy( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
-				eReturn = eARPCacheHit;
+				pxRow = &( xARPCache[ xARPHeap[ 0 ].usRow ] );
+
+				if( ( pxRow->ucValid == ( uint8_t ) pdFALSE ) ||
+					( ( int32_t ) ( ( pxRow->ulExpiry - ( uint32_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST ) - xARPHeap[ 0 ].ulDeadline ) <= 0 ) )
+				{
+					break;
+				}
+
+				prvARPHeapSetDeadline( ( BaseType_t ) xARPHeap[ 0 ].usRow, pxRow->ulExpiry - ( uint32_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST );
 			}
-			break;
+
+			prvARPRowRelease( ( BaseType_t ) xARPHeap[ 0 ].usRow );
 		}
 	}
 
-	return eReturn;
+	/* The free row at the end of the heap joins the heap, its deadline is set
+	by the caller. */
+	xRow = ( BaseType_t ) xARPHeap[ uxARPHeapCount ].usRow;
+	uxARPHeapCount++;
+
+	return xRow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPRowRelease( BaseType_t xRow )
+{
+UBaseType_t uxPosition = ( UBaseType_t ) usARPHeapPosition[ xRow ];
+
+	if( xARPCache[ xRow ].ucValid != ( uint8_t ) pdFALSE )
+	{
+		prvARPIndexRemove( arpINDEX_MAC, xRow );
+	}
+
+	prvARPIndexRemove( arpINDEX_IP, xRow );
+	memset( &( xARPCache[ xRow ] ), '\0', sizeof( xARPCache[ xRow ] ) );
+
+	/* Move the last item of the heap into the place of this row, and park the
+	row just behind the heap. */
+	uxARPHeapCount--;
+
+	if( uxPosition != uxARPHeapCount )
+	{
+		prvARPHeapSwap( uxPosition, uxARPHeapCount );
+		prvARPHeapSetDeadline( ( BaseType_t ) xARPHeap[ uxPosition ].usRow, xARPHeap[ uxPosition ].ulDeadline );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvARPRowSetMAC( BaseType_t xRow, const MACAddress_t *pxMACAddress )
+{
+	if( xARPCache[ xRow ].ucValid != ( uint8_t ) pdFALSE )
+	{
+		prvARPIndexRemove( arpINDEX_MAC, xRow );
+	}
+
+	memcpy( xARPCache[ xRow ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) );
+	xARPCache[ xRow ].ucValid = ( uint8_t ) pdTRUE;
+	prvARPIndexInsert( arpINDEX_MAC, xRow );
 }
 /*-----------------------------------------------------------*/
 
 void vARPAgeCache( void )
 {
-BaseType_t x;
+BaseType_t xRow;
+ARPCacheRow_t *pxRow;
+int32_t lAge;
 TickType_t xTimeNow;
 
-	/* Loop through each entry in the ARP cache. */
-	for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+	ulARPClock++;
+
+	/* Visit the entries whose deadline has come: the ones that wait for an ARP
+	reply, and the ones that are about to expire. */
+	while( ( uxARPHeapCount > 0u ) && ( ( int32_t ) ( xARPHeap[ 0 ].ulDeadline - ulARPClock ) <= 0 ) )
 	{
-		/* If the entry is valid (its age is greater than zero). */
-		if( xARPCache[ x ].ucAge > 0U )
-		{
-			/* Decrement the age value of the entry in this ARP cache table row.
-			When the age reaches zero it is no longer considered valid. */
-			( xARPCache[ x ].ucAge )--;
+		xRow = ( BaseType_t ) xARPHeap[ 0 ].usRow;
+		pxRow = &( xARPCache[ xRow ] );
 
+		/* The number of calls left before the entry expires. */
+		lAge = ( int32_t ) ( pxRow->ulExpiry - ulARPClock );
+
+		if( ( pxRow->ucValid != ( uint8_t ) pdFALSE ) && ( lAge > ( int32_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST ) )
+		{
+			/* The entry was refreshed after it was put in the heap. */
+			prvARPHeapSetDeadline( xRow, pxRow->ulExpiry - ( uint32_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST );
+		}
+		else
+		{
 			/* If the entry is not yet valid, then it is waiting an ARP
 			reply, and the ARP request should be retransmitted. */
-			if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+			if( pxRow->ucValid == ( uint8_t ) pdFALSE )
 			{
-				FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
+				FreeRTOS_OutputARPRequest( pxRow->ulIPAddress );
 			}
-			else if( xARPCache[ x ].ucAge <= ( uint8_t ) arpMAX_ARP_AGE_BEFORE_NEW_ARP_REQUEST )
+			else
 			{
 				/* This entry will get removed soon.  See if the MAC address is
 				still valid to prevent this happening. */
-				iptraceARP_TABLE_ENTRY_WILL_EXPIRE( xARPCache[ x ].ulIPAddress );
-				FreeRTOS_OutputARPRequest( xARPCache[ x ].ulIPAddress );
-			}
-			else
-			{
-				/* The age has just ticked down, with nothing to do. */
+				iptraceARP_TABLE_ENTRY_WILL_EXPIRE( pxRow->ulIPAddress );
+				FreeRTOS_OutputARPRequest( pxRow->ulIPAddress );
 			}
 
-			if( xARPCache[ x ].ucAge == 0u )
+			if( lAge <= 0 )
 			{
 				/* The entry is no longer valid.  Wipe it out. */
-				iptraceARP_TABLE_ENTRY_EXPIRED( xARPCache[ x ].ulIPAddress );
-				xARPCache[ x ].ulIPAddress = 0UL;
+				iptraceARP_TABLE_ENTRY_EXPIRED( pxRow->ulIPAddress );
+				prvARPRowRelease( xRow );
+			}
+			else
+			{
+				/* Visit it again at the next call. */
+				prvARPHeapSetDeadline( xRow, ulARPClock + 1UL );
 			}
 		}
 	}
@@ -618,6 +970,9 @@ ARPPacket_t *pxARPPacket;
 void FreeRTOS_ClearARP( void )
 {
 	memset( xARPCache, '\0', sizeof( xARPCache ) );
+	memset( usARPIndex, '\0', sizeof( usARPIndex ) );
+	uxARPHeapCount = 0u;
+	uxARPRowsUsed = 0u;
 }
 /*-----------------------------------------------------------*/
 
@@ -630,12 +985,12 @@ void FreeRTOS_ClearARP( void )
 		/* Loop through each entry in the ARP cache. */
 		for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
 		{
-			if( ( xARPCache[ x ].ulIPAddress != 0ul ) && ( xARPCache[ x ].ucAge > 0U ) )
+			if( xARPCache[ x ].ulIPAddress != 0ul )
 			{
 				/* See if the MAC-address also matches, and we're all happy */
-				FreeRTOS_printf( ( "Arp %2ld: %3u - %16lxip : %02x:%02x:%02x : %02x:%02x:%02x\n",
+				FreeRTOS_printf( ( "Arp %2ld: %3lu - %16lxip : %02x:%02x:%02x : %02x:%02x:%02x\n",
 					x,
-					xARPCache[ x ].ucAge,
+					xARPCache[ x ].ulExpiry - ulARPClock,
 					xARPCache[ x ].ulIPAddress,
 					xARPCache[ x ].xMACAddress.ucBytes[0],
 					xARPCache[ x ].xMACAddress.ucBytes[1],
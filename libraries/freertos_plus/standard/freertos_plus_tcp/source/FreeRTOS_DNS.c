@@ -52,12 +52,16 @@
 	#define dnsOUTGOING_FLAGS				0x0001 /* Standard query. */
 	#define dnsRX_FLAGS_MASK				0x0f80 /* The bits of interest in the flags field of incoming DNS messages. */
 	#define dnsEXPECTED_RX_FLAGS			0x0080 /* Should be a response, without any errors. */
+	#define dnsNXDOMAIN_RX_FLAGS			0x0380 /* A response saying that the name does not exist. */
+	#define dnsTRUNCATED_FLAG				0x0002 /* The response did not fit in the message. */
 #else
 	#define dnsDNS_PORT						0x0035
 	#define dnsONE_QUESTION					0x0001
 	#define dnsOUTGOING_FLAGS				0x0100 /* Standard query. */
 	#define dnsRX_FLAGS_MASK				0x800f /* The bits of interest in the flags field of incoming DNS messages. */
 	#define dnsEXPECTED_RX_FLAGS			0x8000 /* Should be a response, without any errors. */
+	#define dnsNXDOMAIN_RX_FLAGS			0x8003 /* A response saying that the name does not exist. */
+	#define dnsTRUNCATED_FLAG				0x0200 /* The response did not fit in the message. */
 
 #endif /* ipconfigBYTE_ORDER */
 
@@ -79,6 +83,7 @@ name field is an offset to the string, rather than the string itself. */
 
 /* Host types. */
 #define dnsTYPE_A_HOST						0x01
+#define dnsTYPE_SOA							0x06
 #define dnsCLASS_IN							0x01
 
 /* LLMNR constants. */
@@ -100,12 +105,78 @@ the query will be responded to with these flags: */
 type. */
 #define dnsPARSE_ERROR					  0UL
 
+/* A look-up that is waiting for a reply.  The value of the list item is the
+identifier of the query, the reply is matched with the request by this
+identifier and by the question. */
+typedef struct xDNS_REQUEST
+{
+	struct xLIST_ITEM xListItem;
+	uint32_t ulIPAddress;				/* The address found, or zero. */
+	SemaphoreHandle_t xReplySemaphore;	/* Given when a blocking look-up has been answered, NULL for a call-back. */
+	#if( ipconfigDNS_USE_CALLBACKS != 0 )
+		TickType_t xRemaningTime;		/* Timeout in ms */
+		FOnDNSEvent pCallbackFunction;	/* Function to be called when the address has been found or when a timeout has beeen reached */
+		TimeOut_t xTimeoutState;
+		void *pvSearchID;
+		TickType_t xRetryTime;			/* The number of clock ticks between two transmissions of the query. */
+		TickType_t xLastSent;			/* The tick count at which the query was last sent. */
+		BaseType_t xAttempts;			/* The number of times that the query has been sent. */
+	#endif
+	char pcName[ 1 ];
+} DNSRequest_t;
+
+/* The outstanding look-ups.  Their queries are all sent from xDNSSocket, the
+replies are passed to the requests by the IP-task. */
+static List_t xDNSRequestList;
+static Socket_t xDNSSocket = NULL;
+
 /*
- * Create a socket and bind it to the standard DNS port number.  Return the
- * the created socket - or NULL if the socket could not be created or bound.
+ * Create a socket and bind it to a random port number.  Return the created
+ * socket - or NULL if the socket could not be created or bound.  This function
+ * is called from the IP-task.
  */
 static Socket_t prvCreateDNSSocket( void );
 
+/*
+ * Allocate a request for pcHostName.  Returns NULL if there is no memory, or
+ * if the DNS socket has not been created yet.
+ */
+static DNSRequest_t *prvCreateDNSRequest( const char *pcHostName );
+
+/*
+ * Give the request an identifier that is not used by any other outstanding
+ * request, and add it to xDNSRequestList.  Returns the identifier.
+ */
+static TickType_t prvAddDNSRequest( DNSRequest_t *pxRequest );
+
+/*
+ * Send a query for pcHostName from the DNS socket.
+ */
+static BaseType_t prvSendDNSRequest( const char *pcHostName, TickType_t xIdentifier );
+
+/*
+ * Find the outstanding request with the same identifier and question as a
+ * reply.  Must be called with the scheduler suspended.
+ */
+static DNSRequest_t *prvFindDNSRequest( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength );
+
+/*
+ * Return pdTRUE if a reply answers one of the outstanding requests.
+ */
+static BaseType_t prvIsDNSRequest( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength );
+
+/*
+ * A reply with a definite answer was received.  Find the request with the same
+ * identifier and question, and pass it the address: either wake up the task
+ * that is waiting for it, or call its call-back function.
+ */
+static void prvDNSRequestDone( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength, uint32_t ulIPAddress );
+
+/*
+ * Return pdTRUE if the (not compressed) name field at pucByte spells pcName.
+ */
+static BaseType_t prvNameFieldMatches( const uint8_t *pucByte, size_t xSourceLen, const char *pcName );
+
 /*
  * Create the DNS message in the zero copy buffer passed in the first parameter.
  */
@@ -122,10 +193,11 @@ static uint8_t *prvSkipNameField( uint8_t *pucByte, size_t xSourceLen );
 static uint32_t prvParseDNSReply( uint8_t *pucUDPPayloadBuffer, size_t xBufferLength, TickType_t xIdentifier );
 
 /*
- * Prepare and send a message to a DNS server.  'xReadTimeOut_ms' will be passed as
- * zero, in case the user has supplied a call-back function.
+ * Send a query and block until the reply has been received, or until
+ * ipconfigDNS_REQUEST_ATTEMPTS queries have timed out.  Other look-ups proceed in
+ * parallel, each with its own identifier.
  */
-static uint32_t prvGetHostByName( const char *pcHostName, TickType_t xIdentifier, TickType_t xReadTimeOut_ms );
+static uint32_t prvGetHostByName( const char *pcHostName, TickType_t xReadTimeOut_ms );
 
 /*
  * The NBNS and the LLMNR protocol share this reply function.
@@ -140,21 +212,59 @@ static uint32_t prvGetHostByName( const char *pcHostName, TickType_t xIdentifier
 
 #if( ipconfigUSE_DNS_CACHE == 1 )
 	static uint8_t *prvReadNameField( uint8_t *pucByte, size_t xSourceLen, char *pcName, size_t xLen );
-	static void prvProcessDNSCache( const char *pcName, uint32_t *pulIP, uint32_t ulTTL, BaseType_t xLookUp );
+
+	/*
+	 * Look up pcName, or store an address for it with a TTL in seconds.  An
+	 * address of zero is stored for a name that is known not to exist.  A look-up
+	 * returns pdTRUE if a valid entry was found, either positive or negative.
+	 */
+	static BaseType_t prvProcessDNSCache( const char *pcName, uint32_t *pulIP, uint32_t ulTTL, BaseType_t xLookUp );
+
+	/*
+	 * Unlink a row from its hash chain and add it to the free rows.
+	 */
+	static void prvDNSCacheRemove( UBaseType_t uxRow );
+
+	/*
+	 * Find the TTL of a negative answer in the SOA record of the authority
+	 * section.  Returns zero when there is no SOA record.
+	 */
+	static uint32_t prvReadNegativeTTL( uint8_t *pucByte, size_t xSourceLen, uint16_t usAuthorities );
 
 	typedef struct xDNS_CACHE_TABLE_ROW
 	{
-		uint32_t ulIPAddress;		/* The IP address of an ARP cache entry. */
+		uint32_t ulIPAddress;		/* The IP address of the host, or zero if the name does not exist. */
 		char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];  /* The name of the host */
-		uint32_t ulTTL; /* Time-to-Live (in seconds) from the DNS server. */
-		uint32_t ulTimeWhenAddedInSeconds;
+		uint32_t ulExpiry;			/* The value of ulDNSCacheSeconds at which the entry is no longer valid. */
+		uint32_t ulHash;			/* The hash of pcName. */
+		uint16_t usNext;			/* The next row + 1 in the hash chain or in the free rows, zero at the end. */
 	} DNSCacheRow_t;
 
 	static DNSCacheRow_t xDNSCache[ ipconfigDNS_CACHE_ENTRIES ];
 
+	/* The first row + 1 of each hash chain, zero when the chain is empty. */
+	static uint16_t usDNSCacheHash[ ipconfigDNS_CACHE_HASH_SLOTS ];
+
+	/* The first free row + 1.  The rows from uxDNSCacheRowsUsed upwards have
+	never been used. */
+	static uint16_t usDNSCacheFree = 0u;
+	static UBaseType_t uxDNSCacheRowsUsed = 0u;
+
+	/* A clock in seconds for the expiry of the entries.  It is moved forward
+	with the tick count each time the cache is accessed. */
+	static uint32_t ulDNSCacheSeconds = 0UL;
+	static TickType_t xDNSCacheSecondsTick = 0u;
+
     void FreeRTOS_dnsclear()
     {
-        memset( xDNSCache, 0x0, sizeof( xDNSCache ) );
+		vTaskSuspendAll();
+		{
+			memset( xDNSCache, 0x0, sizeof( xDNSCache ) );
+			memset( usDNSCacheHash, 0x0, sizeof( usDNSCacheHash ) );
+			usDNSCacheFree = 0u;
+			uxDNSCacheRowsUsed = 0u;
+		}
+		xTaskResumeAll();
     }
 #endif /* ipconfigUSE_DNS_CACHE == 1 */
 
@@ -269,16 +379,8 @@ typedef struct xDNSAnswerRecord DNSAnswerRecord_t;
 
 #if( ipconfigDNS_USE_CALLBACKS != 0 )
 
-	typedef struct xDNS_Callback {
-		TickType_t xRemaningTime;		/* Timeout in ms */
-		FOnDNSEvent pCallbackFunction;	/* Function to be called when the address has been found or when a timeout has beeen reached */
-		TimeOut_t xTimeoutState;
-		void *pvSearchID;
-		struct xLIST_ITEM xListItem;
-		char pcName[ 1 ];
-	} DNSCallback_t;
-
-	static List_t xCallbackList;
+	/* The period of the DNS timer, zero while it is not running. */
+	static TickType_t xDNSTimerPeriod = 0u;
 
 	/* Define FreeRTOS_gethostbyname() as a normal blocking call. */
 	uint32_t FreeRTOS_gethostbyname( const char *pcHostName )
@@ -287,16 +389,9 @@ typedef struct xDNSAnswerRecord DNSAnswerRecord_t;
 	}
 	/*-----------------------------------------------------------*/
 
-	/* Initialise the list of call-back structures. */
-	void vDNSInitialise( void );
-	void vDNSInitialise( void )
-	{
-		vListInitialise( &xCallbackList );
-	}
-	/*-----------------------------------------------------------*/
-
 	/* Iterate through the list of call-back structures and remove
-	old entries which have reached a timeout.
+	old entries which have reached a timeout, and send the query again for
+	the others when it is time.
 	As soon as the list hase become empty, the DNS timer will be stopped
 	In case pvSearchID is supplied, the user wants to cancel a DNS request
 	*/
@@ -304,7 +399,13 @@ typedef struct xDNSAnswerRecord DNSAnswerRecord_t;
 	void vDNSCheckCallBack( void *pvSearchID )
 	{
 	const ListItem_t *pxIterator;
-	const MiniListItem_t* xEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xCallbackList );
+	const MiniListItem_t* xEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xDNSRequestList );
+	List_t xTimedOut;
+	BaseType_t xHasCallbacks = pdFALSE;
+
+		/* The call-backs of the requests that timed out are made after the
+		scheduler has been resumed. */
+		vListInitialise( &xTimedOut );
 
 		vTaskSuspendAll();
 		{
@@ -312,26 +413,55 @@ typedef struct xDNSAnswerRecord DNSAnswerRecord_t;
 				 pxIterator != ( const ListItem_t * ) xEnd;
 				  )
 			{
-				DNSCallback_t *pxCallback = ( DNSCallback_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+				DNSRequest_t *pxCallback = ( DNSRequest_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 				/* Move to the next item because we might remove this item */
 				pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator );
-				if( ( pvSearchID != NULL ) && ( pvSearchID == pxCallback->pvSearchID ) )
+				if( pxCallback->pCallbackFunction == NULL )
+				{
+					/* A blocking look-up, its own task takes care of it. */
+				}
+				else if( ( pvSearchID != NULL ) && ( pvSearchID == pxCallback->pvSearchID ) )
 				{
 					uxListRemove( &pxCallback->xListItem );
 					vPortFree( pxCallback );
 				}
 				else if( xTaskCheckForTimeOut( &pxCallback->xTimeoutState, &pxCallback->xRemaningTime ) != pdFALSE )
 				{
-					pxCallback->pCallbackFunction( pxCallback->pcName, pxCallback->pvSearchID, 0 );
 					uxListRemove( &pxCallback->xListItem );
-					vPortFree( ( void * ) pxCallback );
+					vListInsertEnd( &xTimedOut, &pxCallback->xListItem );
+				}
+				else
+				{
+					xHasCallbacks = pdTRUE;
+
+					if( ( pvSearchID == NULL ) &&
+						( pxCallback->xAttempts < ipconfigDNS_REQUEST_ATTEMPTS ) &&
+						( ( xTaskGetTickCount() - pxCallback->xLastSent ) >= pxCallback->xRetryTime ) )
+					{
+						/* There is no reply yet, send the query again. */
+						if( prvSendDNSRequest( pxCallback->pcName, listGET_LIST_ITEM_VALUE( &( pxCallback->xListItem ) ) ) != pdFAIL )
+						{
+							pxCallback->xAttempts++;
+							pxCallback->xLastSent = xTaskGetTickCount();
+						}
+					}
 				}
 			}
 		}
 		xTaskResumeAll();
 
-		if( listLIST_IS_EMPTY( &xCallbackList ) )
+		while( listLIST_IS_EMPTY( &xTimedOut ) == pdFALSE )
 		{
+			DNSRequest_t *pxCallback = ( DNSRequest_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTimedOut );
+
+			uxListRemove( &pxCallback->xListItem );
+			pxCallback->pCallbackFunction( pxCallback->pcName, pxCallback->pvSearchID, 0 );
+			vPortFree( ( void * ) pxCallback );
+		}
+
+		if( xHasCallbacks == pdFALSE )
+		{
+			xDNSTimerPeriod = 0u;
 			vIPSetDnsTimerEnableState( pdFALSE );
 		}
 	}
@@ -345,70 +475,75 @@ typedef struct xDNSAnswerRecord DNSAnswerRecord_t;
 	/*-----------------------------------------------------------*/
 
 	/* FreeRTOS_gethostbyname_a() was called along with callback parameters.
-	Store them in a list for later reference. */
-	static void vDNSSetCallBack( const char *pcHostName, void *pvSearchID, FOnDNSEvent pCallbackFunction, TickType_t xTimeout, TickType_t xIdentifier );
-	static void vDNSSetCallBack( const char *pcHostName, void *pvSearchID, FOnDNSEvent pCallbackFunction, TickType_t xTimeout, TickType_t xIdentifier )
+	Store them in a list for later reference, and send the first query.  The
+	IP-task will send it again if no reply has been received after xRetryTime. */
+	static void vDNSSetCallBack( const char *pcHostName, void *pvSearchID, FOnDNSEvent pCallbackFunction, TickType_t xTimeout );
+	static void vDNSSetCallBack( const char *pcHostName, void *pvSearchID, FOnDNSEvent pCallbackFunction, TickType_t xTimeout )
 	{
-		size_t lLength = strlen( pcHostName );
-		DNSCallback_t *pxCallback = ( DNSCallback_t * )pvPortMalloc( sizeof( *pxCallback ) + lLength );
+		DNSRequest_t *pxCallback = prvCreateDNSRequest( pcHostName );
+		TickType_t xIdentifier;
 
 		/* Translate from ms to number of clock ticks. */
 		xTimeout /= portTICK_PERIOD_MS;
 		if( pxCallback != NULL )
 		{
-			if( listLIST_IS_EMPTY( &xCallbackList ) )
-			{
-				/* This is the first one, start the DNS timer to check for timeouts */
-				vIPReloadDNSTimer( FreeRTOS_min_uint32( 1000U, xTimeout ) );
-			}
-			strcpy( pxCallback->pcName, pcHostName );
 			pxCallback->pCallbackFunction = pCallbackFunction;
 			pxCallback->pvSearchID = pvSearchID;
 			pxCallback->xRemaningTime = xTimeout;
 			vTaskSetTimeOutState( &pxCallback->xTimeoutState );
-			listSET_LIST_ITEM_OWNER( &( pxCallback->xListItem ), ( void* ) pxCallback );
-			listSET_LIST_ITEM_VALUE( &( pxCallback->xListItem ), xIdentifier );
-			vTaskSuspendAll();
+
+			/* The query will be sent ipconfigDNS_REQUEST_ATTEMPTS times, spread
+			over the time-out. */
+			pxCallback->xRetryTime = FreeRTOS_max_uint32( 1U, xTimeout / ipconfigDNS_REQUEST_ATTEMPTS );
+			pxCallback->xLastSent = xTaskGetTickCount();
+			pxCallback->xAttempts = 1;
+
+			xIdentifier = prvAddDNSRequest( pxCallback );
+
+			if( ( xDNSTimerPeriod == 0u ) || ( pxCallback->xRetryTime < xDNSTimerPeriod ) )
 			{
-				vListInsertEnd( &xCallbackList, &pxCallback->xListItem );
+				/* Start the DNS timer to check for retransmissions and timeouts. */
+				xDNSTimerPeriod = FreeRTOS_min_uint32( 1000U, pxCallback->xRetryTime );
+				vIPReloadDNSTimer( xDNSTimerPeriod );
 			}
-			xTaskResumeAll();
+
+			( void ) prvSendDNSRequest( pcHostName, xIdentifier );
 		}
 	}
-	/*-----------------------------------------------------------*/
 
-	/* A DNS reply was received, see if there is any matching entry and
-	call the handler. */
-	static void vDNSDoCallback( TickType_t xIdentifier, const char *pcName, uint32_t ulIPAddress );
-	static void vDNSDoCallback( TickType_t xIdentifier, const char *pcName, uint32_t ulIPAddress )
+#endif	/* ipconfigDNS_USE_CALLBACKS != 0 */
+/*-----------------------------------------------------------*/
+
+/* Initialise the list of requests, and create the socket from which the
+queries are sent.  This is called by the IP-task each time the network goes
+up. */
+void vDNSInitialise( void );
+void vDNSInitialise( void )
+{
+	if( xDNSSocket == NULL )
 	{
-		const ListItem_t *pxIterator;
-		const MiniListItem_t* xEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xCallbackList );
+		/* As long as there is no socket, no request can have been made. */
+		vListInitialise( &xDNSRequestList );
+		xDNSSocket = prvCreateDNSSocket();
+	}
+}
+/*-----------------------------------------------------------*/
 
-		vTaskSuspendAll();
-		{
-			for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( xEnd );
-				 pxIterator != ( const ListItem_t * ) xEnd;
-				 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
-			{
-				if( listGET_LIST_ITEM_VALUE( pxIterator ) == xIdentifier )
-				{
-					DNSCallback_t *pxCallback = ( DNSCallback_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
-					pxCallback->pCallbackFunction( pcName, pxCallback->pvSearchID, ulIPAddress );
-					uxListRemove( &pxCallback->xListItem );
-					vPortFree( pxCallback );
-					if( listLIST_IS_EMPTY( &xCallbackList ) )
-					{
-						vIPSetDnsTimerEnableState( pdFALSE );
-					}
-					break;
-				}
-			}
-		}
-		xTaskResumeAll();
+BaseType_t xIsDNSSocket( Socket_t xSocket )
+{
+BaseType_t xReturn;
+
+	if( ( xDNSSocket != NULL ) && ( xDNSSocket == xSocket ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
 	}
 
-#endif	/* ipconfigDNS_USE_CALLBACKS != 0 */
+	return xReturn;
+}
 /*-----------------------------------------------------------*/
 
 #if( ipconfigDNS_USE_CALLBACKS == 0 )
@@ -419,24 +554,29 @@ uint32_t FreeRTOS_gethostbyname_a( const char *pcHostName, FOnDNSEvent pCallback
 {
 uint32_t ulIPAddress = 0UL;
 TickType_t xReadTimeOut_ms = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
-TickType_t xIdentifier = 0;
+BaseType_t xHasAnswer = pdFALSE;
 
 	/* If the supplied hostname is IP address, convert it to uint32_t
 	and return. */
 	#if( ipconfigINCLUDE_FULL_INET_ADDR == 1 )
 	{
 		ulIPAddress = FreeRTOS_inet_addr( pcHostName );
+		if( ulIPAddress != 0UL )
+		{
+			xHasAnswer = pdTRUE;
+		}
 	}
 	#endif /* ipconfigINCLUDE_FULL_INET_ADDR == 1 */
 
 	/* If a DNS cache is used then check the cache before issuing another DNS
-	request. */
+	request.  A name that is known not to exist is answered from the cache as
+	well, with an address of zero. */
 	#if( ipconfigUSE_DNS_CACHE == 1 )
 	{
-		if( ulIPAddress == 0UL )
+		if( xHasAnswer == pdFALSE )
 		{
-			ulIPAddress = FreeRTOS_dnslookup( pcHostName );
-			if( ulIPAddress != 0 )
+			xHasAnswer = prvProcessDNSCache( pcHostName, &ulIPAddress, 0, pdTRUE );
+			if( xHasAnswer != pdFALSE )
 			{
 				FreeRTOS_debug_printf( ( "FreeRTOS_gethostbyname: found '%s' in cache: %lxip\n", pcHostName, ulIPAddress ) );
 			}
@@ -448,54 +588,162 @@ TickType_t xIdentifier = 0;
 	}
 	#endif /* ipconfigUSE_DNS_CACHE == 1 */
 
-	/* Generate a unique identifier. */
-	if( 0 == ulIPAddress )
-	{
-		xIdentifier = ( TickType_t )ipconfigRAND32( );
-	}
-
 	#if( ipconfigDNS_USE_CALLBACKS != 0 )
 	{
 		if( pCallback != NULL )
 		{
-			if( ulIPAddress == 0UL )
+			if( xHasAnswer == pdFALSE )
 			{
-				/* The user has provided a callback function, so do not block on recvfrom() */
-				if( 0 != xIdentifier )
-				{
-					xReadTimeOut_ms = 0;
-					vDNSSetCallBack( pcHostName, pvSearchID, pCallback, xTimeout, ( TickType_t )xIdentifier );
-				}
+				/* The user has provided a callback function, so do not block.
+				The IP-task will call it when the reply has been received. */
+				vDNSSetCallBack( pcHostName, pvSearchID, pCallback, xTimeout );
 			}
 			else
 			{
 				/* The IP address is known, do the call-back now. */
 				pCallback( pcHostName, pvSearchID, ulIPAddress );
 			}
+
+			/* Do not block in prvGetHostByName(). */
+			xHasAnswer = pdTRUE;
 		}
 	}
 	#endif
 
-	if( ( ulIPAddress == 0UL ) && ( 0 != xIdentifier ) )
+	if( xHasAnswer == pdFALSE )
 	{
-		ulIPAddress = prvGetHostByName( pcHostName, xIdentifier, xReadTimeOut_ms );
+		ulIPAddress = prvGetHostByName( pcHostName, xReadTimeOut_ms );
 	}
 
 	return ulIPAddress;
 }
 /*-----------------------------------------------------------*/
 
-static uint32_t prvGetHostByName( const char *pcHostName, TickType_t xIdentifier, TickType_t xReadTimeOut_ms )
+static uint32_t prvGetHostByName( const char *pcHostName, TickType_t xReadTimeOut_ms )
+{
+DNSRequest_t *pxRequest;
+uint32_t ulIPAddress = 0UL;
+BaseType_t xAttempt;
+TickType_t xIdentifier;
+
+	pxRequest = prvCreateDNSRequest( pcHostName );
+
+	if( pxRequest != NULL )
+	{
+		pxRequest->xReplySemaphore = xSemaphoreCreateBinary();
+
+		if( pxRequest->xReplySemaphore != NULL )
+		{
+			xIdentifier = prvAddDNSRequest( pxRequest );
+
+			for( xAttempt = 0; xAttempt < ipconfigDNS_REQUEST_ATTEMPTS; xAttempt++ )
+			{
+				if( prvSendDNSRequest( pcHostName, xIdentifier ) != pdFAIL )
+				{
+					/* Wait for the IP-task to pass the reply. */
+					if( xSemaphoreTake( pxRequest->xReplySemaphore, xReadTimeOut_ms ) != pdFALSE )
+					{
+						/* All done. */
+						break;
+					}
+				}
+			}
+
+			vTaskSuspendAll();
+			{
+				/* The request is still in the list if no reply was received. */
+				if( listIS_CONTAINED_WITHIN( &xDNSRequestList, &( pxRequest->xListItem ) ) != pdFALSE )
+				{
+					uxListRemove( &( pxRequest->xListItem ) );
+				}
+			}
+			xTaskResumeAll();
+
+			ulIPAddress = pxRequest->ulIPAddress;
+			vSemaphoreDelete( pxRequest->xReplySemaphore );
+		}
+
+		vPortFree( ( void * ) pxRequest );
+	}
+
+	return ulIPAddress;
+}
+/*-----------------------------------------------------------*/
+
+static DNSRequest_t *prvCreateDNSRequest( const char *pcHostName )
+{
+DNSRequest_t *pxRequest = NULL;
+size_t xLength = strlen( pcHostName );
+
+	if( xDNSSocket != NULL )
+	{
+		pxRequest = ( DNSRequest_t * ) pvPortMalloc( sizeof( *pxRequest ) + xLength );
+	}
+
+	if( pxRequest != NULL )
+	{
+		memset( ( void * ) pxRequest, 0, sizeof( *pxRequest ) );
+		strcpy( pxRequest->pcName, pcHostName );
+		listSET_LIST_ITEM_OWNER( &( pxRequest->xListItem ), ( void * ) pxRequest );
+	}
+
+	return pxRequest;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvAddDNSRequest( DNSRequest_t *pxRequest )
+{
+const ListItem_t *pxIterator;
+const MiniListItem_t* xEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xDNSRequestList );
+TickType_t xIdentifier;
+BaseType_t xInUse = pdTRUE;
+
+	while( xInUse != pdFALSE )
+	{
+		/* Generate a random identifier, and make sure that no other outstanding
+		request uses it. */
+		xIdentifier = ( TickType_t ) ( ipconfigRAND32() & 0xffffUL );
+
+		if( xIdentifier != 0u )
+		{
+			vTaskSuspendAll();
+			{
+				xInUse = pdFALSE;
+
+				for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( xEnd );
+					 pxIterator != ( const ListItem_t * ) xEnd;
+					 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+				{
+					if( listGET_LIST_ITEM_VALUE( pxIterator ) == xIdentifier )
+					{
+						xInUse = pdTRUE;
+						break;
+					}
+				}
+
+				if( xInUse == pdFALSE )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxRequest->xListItem ), xIdentifier );
+					vListInsertEnd( &xDNSRequestList, &( pxRequest->xListItem ) );
+				}
+			}
+			xTaskResumeAll();
+		}
+	}
+
+	return xIdentifier;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendDNSRequest( const char *pcHostName, TickType_t xIdentifier )
 {
 struct freertos_sockaddr xAddress;
-Socket_t xDNSSocket;
 uint32_t ulIPAddress = 0UL;
 uint8_t *pucUDPPayloadBuffer;
-uint32_t ulAddressLength = sizeof( struct freertos_sockaddr );
-BaseType_t xAttempt;
-int32_t lBytes;
 size_t xPayloadLength, xExpectedPayloadLength;
-TickType_t xWriteTimeOut_ms = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
+TickType_t xBlockTime = portMAX_DELAY;
+BaseType_t xFlags = FREERTOS_ZERO_COPY;
+BaseType_t xReturn = pdFAIL;
 
 #if( ipconfigUSE_LLMNR == 1 )
 	BaseType_t bHasDot = pdFALSE;
@@ -521,85 +769,200 @@ TickType_t xWriteTimeOut_ms = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
 	subdomain part and the string end byte. */
 	xExpectedPayloadLength = sizeof( DNSMessage_t ) + strlen( pcHostName ) + sizeof( uint16_t ) + sizeof( uint16_t ) + 2u;
 
-	xDNSSocket = prvCreateDNSSocket();
+	if( xIsCallingFromIPTask() != pdFALSE )
+	{
+		/* A query that is sent again by the IP-task.  It may not wait for
+		itself. */
+		xBlockTime = 0u;
+		xFlags |= FREERTOS_MSG_DONTWAIT;
+	}
+
+	/* Get a buffer.  This uses a maximum delay, but the delay will be
+	capped to ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS so the return value
+	still needs to be tested. */
+	pucUDPPayloadBuffer = ( uint8_t * ) FreeRTOS_GetUDPPayloadBuffer( xExpectedPayloadLength, xBlockTime );
 
-	if( xDNSSocket != NULL )
+	if( pucUDPPayloadBuffer != NULL )
 	{
-		FreeRTOS_setsockopt( xDNSSocket, 0, FREERTOS_SO_SNDTIMEO, ( void * ) &xWriteTimeOut_ms, sizeof( TickType_t ) );
-		FreeRTOS_setsockopt( xDNSSocket, 0, FREERTOS_SO_RCVTIMEO, ( void * ) &xReadTimeOut_ms,  sizeof( TickType_t ) );
+		/* Create the message in the obtained buffer. */
+		xPayloadLength = prvCreateDNSMessage( pucUDPPayloadBuffer, pcHostName, xIdentifier );
+
+		iptraceSENDING_DNS_REQUEST();
 
-		for( xAttempt = 0; xAttempt < ipconfigDNS_REQUEST_ATTEMPTS; xAttempt++ )
+		/* Obtain the DNS server address. */
+		FreeRTOS_GetAddressConfiguration( NULL, NULL, NULL, &ulIPAddress );
+
+		/* Send the DNS message. */
+#if( ipconfigUSE_LLMNR == 1 )
+		if( bHasDot == pdFALSE )
+		{
+			/* Use LLMNR addressing. */
+			( ( DNSMessage_t * ) pucUDPPayloadBuffer) -> usFlags = 0;
+			xAddress.sin_addr = ipLLMNR_IP_ADDR;	/* Is in network byte order. */
+			xAddress.sin_port = FreeRTOS_ntohs( ipLLMNR_PORT );
+		}
+		else
+#endif
 		{
-			/* Get a buffer.  This uses a maximum delay, but the delay will be
-			capped to ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS so the return value
-			still needs to be tested. */
-			pucUDPPayloadBuffer = ( uint8_t * ) FreeRTOS_GetUDPPayloadBuffer( xExpectedPayloadLength, portMAX_DELAY );
+			/* Use DNS server. */
+			xAddress.sin_addr = ulIPAddress;
+			xAddress.sin_port = dnsDNS_PORT;
+		}
 
-			if( pucUDPPayloadBuffer != NULL )
+		if( FreeRTOS_sendto( xDNSSocket, pucUDPPayloadBuffer, xPayloadLength, xFlags, &xAddress, sizeof( xAddress ) ) != 0 )
+		{
+			/* The reply will be passed to prvDNSRequestDone() by the
+			IP-task. */
+			xReturn = pdPASS;
+		}
+		else
+		{
+			/* The message was not sent so the stack will not be
+			releasing the zero copy - it must be released here. */
+			FreeRTOS_ReleaseUDPPayloadBuffer( ( void * ) pucUDPPayloadBuffer );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static DNSRequest_t *prvFindDNSRequest( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength )
+{
+const ListItem_t *pxIterator;
+const MiniListItem_t* xEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xDNSRequestList );
+DNSRequest_t *pxRequest = NULL;
+
+	/* As long as there is no DNS socket, the list of requests is empty and
+	might not have been initialised. */
+	if( xDNSSocket != NULL )
+	{
+		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( xEnd );
+			 pxIterator != ( const ListItem_t * ) xEnd;
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+		{
+			if( listGET_LIST_ITEM_VALUE( pxIterator ) == xIdentifier )
 			{
-				/* Create the message in the obtained buffer. */
-				xPayloadLength = prvCreateDNSMessage( pucUDPPayloadBuffer, pcHostName, xIdentifier );
+				pxRequest = ( DNSRequest_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+				break;
+			}
+		}
 
-				iptraceSENDING_DNS_REQUEST();
+		/* The reply must repeat the question that was asked. */
+		if( ( pxRequest != NULL ) &&
+			( prvNameFieldMatches( pucQuestion, xQuestionLength, pxRequest->pcName ) == pdFALSE ) )
+		{
+			pxRequest = NULL;
+		}
+	}
 
-				/* Obtain the DNS server address. */
-				FreeRTOS_GetAddressConfiguration( NULL, NULL, NULL, &ulIPAddress );
+	return pxRequest;
+}
+/*-----------------------------------------------------------*/
 
-				/* Send the DNS message. */
-#if( ipconfigUSE_LLMNR == 1 )
-				if( bHasDot == pdFALSE )
-				{
-					/* Use LLMNR addressing. */
-					( ( DNSMessage_t * ) pucUDPPayloadBuffer) -> usFlags = 0;
-					xAddress.sin_addr = ipLLMNR_IP_ADDR;	/* Is in network byte order. */
-					xAddress.sin_port = FreeRTOS_ntohs( ipLLMNR_PORT );
-				}
-				else
-#endif
-				{
-					/* Use DNS server. */
-					xAddress.sin_addr = ulIPAddress;
-					xAddress.sin_port = dnsDNS_PORT;
-				}
+static BaseType_t prvIsDNSRequest( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength )
+{
+BaseType_t xReturn;
 
-				ulIPAddress = 0UL;
+	vTaskSuspendAll();
+	{
+		xReturn = ( prvFindDNSRequest( xIdentifier, pucQuestion, xQuestionLength ) != NULL ) ? pdTRUE : pdFALSE;
+	}
+	xTaskResumeAll();
 
-				if( FreeRTOS_sendto( xDNSSocket, pucUDPPayloadBuffer, xPayloadLength, FREERTOS_ZERO_COPY, &xAddress, sizeof( xAddress ) ) != 0 )
-				{
-					/* Wait for the reply. */
-					lBytes = FreeRTOS_recvfrom( xDNSSocket, &pucUDPPayloadBuffer, 0, FREERTOS_ZERO_COPY, &xAddress, &ulAddressLength );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-					if( lBytes > 0 )
-					{
-						/* The reply was received.  Process it. */
-						ulIPAddress = prvParseDNSReply( pucUDPPayloadBuffer, lBytes, xIdentifier );
+static void prvDNSRequestDone( TickType_t xIdentifier, const uint8_t *pucQuestion, size_t xQuestionLength, uint32_t ulIPAddress )
+{
+DNSRequest_t *pxRequest;
 
-						/* Finished with the buffer.  The zero copy interface
-						is being used, so the buffer must be freed by the
-						task. */
-						FreeRTOS_ReleaseUDPPayloadBuffer( ( void * ) pucUDPPayloadBuffer );
+	vTaskSuspendAll();
+	{
+		pxRequest = prvFindDNSRequest( xIdentifier, pucQuestion, xQuestionLength );
 
-						if( ulIPAddress != 0UL )
-						{
-							/* All done. */
-							break;
-						}
-					}
-				}
-				else
-				{
-					/* The message was not sent so the stack will not be
-					releasing the zero copy - it must be released here. */
-					FreeRTOS_ReleaseUDPPayloadBuffer( ( void * ) pucUDPPayloadBuffer );
-				}
+		if( pxRequest != NULL )
+		{
+			uxListRemove( &( pxRequest->xListItem ) );
+			pxRequest->ulIPAddress = ulIPAddress;
+
+			if( pxRequest->xReplySemaphore != NULL )
+			{
+				/* Wake up the task in prvGetHostByName(), it will free the
+				request. */
+				xSemaphoreGive( pxRequest->xReplySemaphore );
+				pxRequest = NULL;
 			}
 		}
+	}
+	xTaskResumeAll();
 
-		/* Finished with the socket. */
-		FreeRTOS_closesocket( xDNSSocket );
+	#if( ipconfigDNS_USE_CALLBACKS != 0 )
+	{
+		if( pxRequest != NULL )
+		{
+			pxRequest->pCallbackFunction( pxRequest->pcName, pxRequest->pvSearchID, ulIPAddress );
+			vPortFree( ( void * ) pxRequest );
+		}
 	}
+	#endif	/* ipconfigDNS_USE_CALLBACKS != 0 */
+}
+/*-----------------------------------------------------------*/
 
-	return ulIPAddress;
+static BaseType_t prvNameFieldMatches( const uint8_t *pucByte, size_t xSourceLen, const char *pcName )
+{
+BaseType_t xReturn = pdFALSE;
+size_t xCount;
+
+	while( xSourceLen > 0u )
+	{
+		xCount = ( size_t ) *( pucByte++ );
+		xSourceLen--;
+
+		if( xCount == 0u )
+		{
+			/* The end of the name field, the name must end as well. */
+			if( *pcName == '\0' )
+			{
+				xReturn = pdTRUE;
+			}
+			break;
+		}
+
+		/* The question is never compressed. */
+		if( ( ( xCount & dnsNAME_IS_OFFSET ) != 0u ) || ( xCount > xSourceLen ) )
+		{
+			break;
+		}
+
+		xSourceLen -= xCount;
+
+		while( ( xCount > 0u ) && ( *pcName != '\0' ) && ( *pcName == ( char ) *pucByte ) )
+		{
+			pcName++;
+			pucByte++;
+			xCount--;
+		}
+
+		/* The label must match completely, and be followed by a dot or by the
+		end of the name. */
+		if( xCount != 0u )
+		{
+			break;
+		}
+
+		if( *pcName == '.' )
+		{
+			pcName++;
+		}
+		else if( *pcName != '\0' )
+		{
+			break;
+		}
+	}
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -860,13 +1223,16 @@ uint32_t ulIPAddress = 0UL;
 	char *pcRequestedName = NULL;
 #endif
 uint8_t *pucByte;
-size_t xSourceBytesRemaining;
-uint16_t x, usDataLength, usQuestions;
+uint8_t *pucQuestion = NULL;
+size_t xSourceBytesRemaining, xQuestionLength;
+uint16_t x, usDataLength, usQuestions, usFlags;
+BaseType_t xAnswerFound = pdFALSE;
 #if( ipconfigUSE_LLMNR == 1 )
 	uint16_t usType = 0, usClass = 0;
 #endif
 #if( ipconfigUSE_DNS_CACHE == 1 )
 	char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ] = "";
+	uint32_t ulTTL = ipconfigDNS_CACHE_MAX_TTL;
 #endif
 
 	/* Ensure that the buffer is of at least minimal DNS message length. */
@@ -892,6 +1258,12 @@ uint16_t x, usDataLength, usQuestions;
 		usQuestions = FreeRTOS_ntohs( pxDNSMessageHeader->usQuestions );
 		for( x = 0; x < usQuestions; x++ )
 		{
+			if( x == 0 )
+			{
+				/* The question is compared with the request. */
+				pucQuestion = pucByte;
+			}
+
 			#if( ipconfigUSE_LLMNR == 1 )
 			{
 				if( x == 0 )
@@ -961,8 +1333,9 @@ uint16_t x, usDataLength, usQuestions;
 
 		/* Search through the answer records. */
 		pxDNSMessageHeader->usAnswers = FreeRTOS_ntohs( pxDNSMessageHeader->usAnswers );
+		usFlags = pxDNSMessageHeader->usFlags & dnsRX_FLAGS_MASK;
 
-		if( ( pxDNSMessageHeader->usFlags & dnsRX_FLAGS_MASK ) == dnsEXPECTED_RX_FLAGS )
+		if( ( usFlags == dnsEXPECTED_RX_FLAGS ) || ( usFlags == dnsNXDOMAIN_RX_FLAGS ) )
 		{
 			for( x = 0; x < pxDNSMessageHeader->usAnswers; x++ )
 			{
@@ -994,18 +1367,15 @@ uint16_t x, usDataLength, usQuestions;
 						memcpy( &ulIPAddress,
 								pucByte + sizeof( DNSAnswerRecord_t ),
 								sizeof( uint32_t ) );
+						xAnswerFound = pdTRUE;
 
 						#if( ipconfigUSE_DNS_CACHE == 1 )
 						{
-							prvProcessDNSCache( pcName, &ulIPAddress, pxDNSAnswerRecord->ulTTL, pdFALSE );
+							/* The TTL of the address is limited by the TTL of
+							the CNAME records that led to it. */
+							ulTTL = FreeRTOS_min_uint32( ulTTL, FreeRTOS_ntohl( pxDNSAnswerRecord->ulTTL ) );
 						}
 						#endif /* ipconfigUSE_DNS_CACHE */
-						#if( ipconfigDNS_USE_CALLBACKS != 0 )
-						{
-							/* See if any asynchronous call was made to FreeRTOS_gethostbyname_a() */
-							vDNSDoCallback( ( TickType_t ) pxDNSMessageHeader->usIdentifier, pcName, ulIPAddress );
-						}
-						#endif	/* ipconfigDNS_USE_CALLBACKS != 0 */
 					}
 
 					pucByte += sizeof( DNSAnswerRecord_t ) + sizeof( uint32_t );
@@ -1023,6 +1393,12 @@ uint16_t x, usDataLength, usQuestions;
 					/* Determine the length of the answer data from the header. */
 					usDataLength = FreeRTOS_ntohs( pxDNSAnswerRecord->usDataLength );
 
+					#if( ipconfigUSE_DNS_CACHE == 1 )
+					{
+						ulTTL = FreeRTOS_min_uint32( ulTTL, FreeRTOS_ntohl( pxDNSAnswerRecord->ulTTL ) );
+					}
+					#endif /* ipconfigUSE_DNS_CACHE */
+
 					/* Jump over the answer. */
 					if( xSourceBytesRemaining >= usDataLength )
 					{
@@ -1036,6 +1412,34 @@ uint16_t x, usDataLength, usQuestions;
 					}
 				}
 			}
+
+			/* A definite answer is either an address, or a complete reply
+			in which all answers have been inspected without finding an
+			address: the name does not exist, or it has no IPv4 address. */
+			if( ( ( xAnswerFound != pdFALSE ) ||
+				  ( ( x == pxDNSMessageHeader->usAnswers ) && ( ( pxDNSMessageHeader->usFlags & dnsTRUNCATED_FLAG ) == 0 ) ) ) &&
+				( pucQuestion != NULL ) )
+			{
+				xQuestionLength = ( size_t ) ( ( pucUDPPayloadBuffer + xBufferLength ) - pucQuestion );
+
+				/* Only an answer to one of the outstanding requests is trusted. */
+				if( prvIsDNSRequest( ( TickType_t ) pxDNSMessageHeader->usIdentifier, pucQuestion, xQuestionLength ) != pdFALSE )
+				{
+					#if( ipconfigUSE_DNS_CACHE == 1 )
+					{
+						if( xAnswerFound == pdFALSE )
+						{
+							/* Negative caching. */
+							ulTTL = prvReadNegativeTTL( pucByte, xSourceBytesRemaining, FreeRTOS_ntohs( pxDNSMessageHeader->usAuthorityRRs ) );
+						}
+
+						prvProcessDNSCache( pcName, &ulIPAddress, ulTTL, pdFALSE );
+					}
+					#endif /* ipconfigUSE_DNS_CACHE */
+
+					prvDNSRequestDone( ( TickType_t ) pxDNSMessageHeader->usIdentifier, pucQuestion, xQuestionLength, ulIPAddress );
+				}
+			}
 		}
 #if( ipconfigUSE_LLMNR == 1 )
 		else if( usQuestions && ( usType == dnsTYPE_A_HOST ) && ( usClass == dnsCLASS_IN ) )
@@ -1124,6 +1528,9 @@ uint16_t x, usDataLength, usQuestions;
 		uint8_t *pucSource, *pucTarget;
 		uint8_t ucByte;
 		uint8_t ucNBNSName[ 17 ];
+		#if( ipconfigUSE_DNS_CACHE == 1 )
+			uint32_t ulTTL = dnsNBNS_TTL_VALUE;
+		#endif
 
 		/* Check for minimum buffer size. */
 		if( xBufferLength < sizeof( NBNSRequest_t ) )
@@ -1175,8 +1582,13 @@ uint16_t x, usDataLength, usQuestions;
 				if( ( usFlags & dnsNBNS_FLAGS_RESPONSE ) != 0 )
 				{
 					/* If this is a response from another device,
-					add the name to the DNS cache */
-					prvProcessDNSCache( ( char * ) ucNBNSName, &ulIPAddress, 0, pdFALSE );
+					add the name to the DNS cache.  The answer follows the
+					name, like in the replies that are sent below. */
+					if( xBufferLength >= offsetof( NBNSRequest_t, usType ) + sizeof( NBNSAnswer_t ) )
+					{
+						ulTTL = ulChar2u32( pucUDPPayloadBuffer + offsetof( NBNSRequest_t, usType ) + offsetof( NBNSAnswer_t, ulTTL ) );
+					}
+					prvProcessDNSCache( ( char * ) ucNBNSName, &ulIPAddress, ulTTL, pdFALSE );
 				}
 			}
 			#else
@@ -1259,27 +1671,34 @@ static Socket_t prvCreateDNSSocket( void )
 Socket_t xSocket = NULL;
 struct freertos_sockaddr xAddress;
 BaseType_t xReturn;
-TickType_t xTimeoutTime = pdMS_TO_TICKS( 200 );
+TickType_t xTimeoutTime = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
 
 	/* This must be the first time this function has been called.  Create
 	the socket. */
 	xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP );
 
-	/* Auto bind the port. */
-	xAddress.sin_port = 0u;
-	xReturn = FreeRTOS_bind( xSocket, &xAddress, sizeof( xAddress ) );
-
-	/* Check the bind was successful, and clean up if not. */
-	if( xReturn != 0 )
+	if( xSocket != FREERTOS_INVALID_SOCKET )
 	{
-		FreeRTOS_closesocket( xSocket );
-		xSocket = NULL;
+		/* Set the send timeout.  Nothing is ever read from the socket: the
+		replies are handled by the IP-task. */
+		FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, ( void * ) &xTimeoutTime, sizeof( TickType_t ) );
+
+		/* Auto bind the port.  This is the IP-task, it calls vSocketBind()
+		directly. */
+		xAddress.sin_port = 0u;
+		xReturn = vSocketBind( xSocket, &xAddress, sizeof( xAddress ), pdFALSE );
+
+		/* Check the bind was successful, and clean up if not. */
+		if( xReturn != 0 )
+		{
+			vSocketClose( xSocket );
+			xSocket = NULL;
+		}
 	}
 	else
 	{
-		/* Set the send and receive timeouts. */
-		FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, ( void * ) &xTimeoutTime, sizeof( TickType_t ) );
-		FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, ( void * ) &xTimeoutTime, sizeof( TickType_t ) );
+		/* Change to NULL for easier testing. */
+		xSocket = NULL;
 	}
 
 	return xSocket;
@@ -1332,79 +1751,207 @@ TickType_t xTimeoutTime = pdMS_TO_TICKS( 200 );
 
 #if( ipconfigUSE_DNS_CACHE == 1 )
 
-	static void prvProcessDNSCache( const char *pcName, uint32_t *pulIP, uint32_t ulTTL, BaseType_t xLookUp )
+	static BaseType_t prvProcessDNSCache( const char *pcName, uint32_t *pulIP, uint32_t ulTTL, BaseType_t xLookUp )
 	{
-	BaseType_t x;
 	BaseType_t xFound = pdFALSE;
-	uint32_t ulCurrentTimeSeconds = ( xTaskGetTickCount() / portTICK_PERIOD_MS ) / 1000;
-	static BaseType_t xFreeEntry = 0;
+	uint32_t ulHash = 2166136261UL;
+	uint32_t ulSeconds;
+	const char *pcChar;
+	UBaseType_t uxSlot, uxRow, uxOldest;
+	DNSCacheRow_t *pxRow = NULL;
+
+		/* FNV-1a hash of the name. */
+		for( pcChar = pcName; *pcChar != '\0'; pcChar++ )
+		{
+			ulHash = ( ulHash ^ ( uint8_t ) *pcChar ) * 16777619UL;
+		}
+
+		uxSlot = ( UBaseType_t ) ( ulHash & ( ipconfigDNS_CACHE_HASH_SLOTS - 1u ) );
 
-		/* For each entry in the DNS cache table. */
-		for( x = 0; x < ipconfigDNS_CACHE_ENTRIES; x++ )
+		vTaskSuspendAll();
 		{
-			if( xDNSCache[ x ].pcName[ 0 ] == 0 )
+			/* Move the clock forward by the whole seconds that have passed. */
+			ulSeconds = ( uint32_t ) ( ( xTaskGetTickCount() - xDNSCacheSecondsTick ) / configTICK_RATE_HZ );
+			ulDNSCacheSeconds += ulSeconds;
+			xDNSCacheSecondsTick += ( TickType_t ) ( ulSeconds * configTICK_RATE_HZ );
+
+			for( uxRow = usDNSCacheHash[ uxSlot ]; uxRow != 0u; uxRow = xDNSCache[ uxRow - 1u ].usNext )
 			{
-				continue;
+				if( ( xDNSCache[ uxRow - 1u ].ulHash == ulHash ) && ( strcmp( xDNSCache[ uxRow - 1u ].pcName, pcName ) == 0 ) )
+				{
+					pxRow = &( xDNSCache[ uxRow - 1u ] );
+					break;
+				}
 			}
 
-			if( 0 == strcmp( xDNSCache[ x ].pcName, pcName ) )
+			/* Is this function called for a lookup or to add/update an IP address? */
+			if( xLookUp != pdFALSE )
 			{
-				/* Is this function called for a lookup or to add/update an IP address? */
-				if( xLookUp != pdFALSE )
+				*pulIP = 0UL;
+
+				if( pxRow != NULL )
 				{
 					/* Confirm that the record is still fresh. */
-					if( ulCurrentTimeSeconds < ( xDNSCache[ x ].ulTimeWhenAddedInSeconds + FreeRTOS_ntohl( xDNSCache[ x ].ulTTL ) ) )
+					if( ( int32_t ) ( pxRow->ulExpiry - ulDNSCacheSeconds ) > 0 )
 					{
-						*pulIP = xDNSCache[ x ].ulIPAddress;
+						*pulIP = pxRow->ulIPAddress;
+						xFound = pdTRUE;
 					}
 					else
 					{
 						/* Age out the old cached record. */
-						xDNSCache[ x ].pcName[ 0 ] = 0;
+						prvDNSCacheRemove( uxRow - 1u );
 					}
 				}
+			}
+			else
+			{
+				if( *pulIP != 0UL )
+				{
+					ulTTL = FreeRTOS_min_uint32( ulTTL, ipconfigDNS_CACHE_MAX_TTL );
+				}
 				else
 				{
-					xDNSCache[ x ].ulIPAddress = *pulIP;
-					xDNSCache[ x ].ulTTL = ulTTL;
-					xDNSCache[ x ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+					ulTTL = FreeRTOS_min_uint32( ulTTL, ipconfigDNS_CACHE_MAX_NEGATIVE_TTL );
 				}
 
-				xFound = pdTRUE;
-				break;
-			}
-		}
-
-		if( xFound == pdFALSE )
-		{
-			if( xLookUp != pdFALSE )
-			{
-				*pulIP = 0;
-			}
-			else
-			{
-				/* Add or update the item. */
-				if( strlen( pcName ) < ipconfigDNS_CACHE_NAME_LENGTH )
+				if( ulTTL == 0UL )
 				{
-					strcpy( xDNSCache[ xFreeEntry ].pcName, pcName );
+					/* The answer may not be cached. */
+					if( pxRow != NULL )
+					{
+						prvDNSCacheRemove( uxRow - 1u );
+					}
+				}
+				else
+				{
+					if( ( pxRow == NULL ) && ( strlen( pcName ) < ipconfigDNS_CACHE_NAME_LENGTH ) )
+					{
+						/* Add the item: take a free row, a row that has never
+						been used, or else the row that expires first. */
+						if( ( usDNSCacheFree == 0u ) && ( uxDNSCacheRowsUsed >= ipconfigDNS_CACHE_ENTRIES ) )
+						{
+							uxOldest = 0u;
+
+							for( uxRow = 1u; uxRow < ipconfigDNS_CACHE_ENTRIES; uxRow++ )
+							{
+								if( ( int32_t ) ( xDNSCache[ uxRow ].ulExpiry - xDNSCache[ uxOldest ].ulExpiry ) < 0 )
+								{
+									uxOldest = uxRow;
+								}
+							}
+
+							prvDNSCacheRemove( uxOldest );
+						}
+
+						if( usDNSCacheFree != 0u )
+						{
+							uxRow = usDNSCacheFree;
+							usDNSCacheFree = xDNSCache[ uxRow - 1u ].usNext;
+						}
+						else
+						{
+							uxDNSCacheRowsUsed++;
+							uxRow = uxDNSCacheRowsUsed;
+						}
 
-					xDNSCache[ xFreeEntry ].ulIPAddress = *pulIP;
-					xDNSCache[ xFreeEntry ].ulTTL = ulTTL;
-					xDNSCache[ xFreeEntry ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+						pxRow = &( xDNSCache[ uxRow - 1u ] );
+						strcpy( pxRow->pcName, pcName );
+						pxRow->ulHash = ulHash;
+						pxRow->usNext = usDNSCacheHash[ uxSlot ];
+						usDNSCacheHash[ uxSlot ] = ( uint16_t ) uxRow;
+					}
 
-					xFreeEntry++;
-					if( xFreeEntry == ipconfigDNS_CACHE_ENTRIES )
+					if( pxRow != NULL )
 					{
-						xFreeEntry = 0;
+						pxRow->ulIPAddress = *pulIP;
+						pxRow->ulExpiry = ulDNSCacheSeconds + ulTTL;
 					}
 				}
 			}
 		}
+		xTaskResumeAll();
 
 		if( ( xLookUp == 0 ) || ( *pulIP != 0 ) )
 		{
 			FreeRTOS_debug_printf( ( "prvProcessDNSCache: %s: '%s' @ %lxip\n", xLookUp ? "look-up" : "add", pcName, FreeRTOS_ntohl( *pulIP ) ) );
 		}
+
+		return xFound;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDNSCacheRemove( UBaseType_t uxRow )
+	{
+	uint16_t *pusLink = &( usDNSCacheHash[ xDNSCache[ uxRow ].ulHash & ( ipconfigDNS_CACHE_HASH_SLOTS - 1u ) ] );
+
+		/* Find the link that points to the row, the chains are short. */
+		while( *pusLink != ( uint16_t ) ( uxRow + 1u ) )
+		{
+			pusLink = &( xDNSCache[ *pusLink - 1u ].usNext );
+		}
+
+		*pusLink = xDNSCache[ uxRow ].usNext;
+		xDNSCache[ uxRow ].pcName[ 0 ] = '\0';
+		xDNSCache[ uxRow ].usNext = usDNSCacheFree;
+		usDNSCacheFree = ( uint16_t ) ( uxRow + 1u );
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvReadNegativeTTL( uint8_t *pucByte, size_t xSourceLen, uint16_t usAuthorities )
+	{
+	uint8_t *pucEnd = pucByte + xSourceLen;
+	uint8_t *pucData;
+	DNSAnswerRecord_t *pxDNSAnswerRecord;
+	size_t xDataLength;
+	uint32_t ulTTL = 0UL;
+	uint16_t x;
+
+		/* A negative answer may be cached for the TTL of the SOA record in the
+		authority section, or for its MINIMUM field if that is shorter
+		(RFC 2308). */
+		for( x = 0; x < usAuthorities; x++ )
+		{
+			pucByte = prvSkipNameField( pucByte, ( size_t ) ( pucEnd - pucByte ) );
+
+			if( ( pucByte == NULL ) || ( ( size_t ) ( pucEnd - pucByte ) < sizeof( DNSAnswerRecord_t ) ) )
+			{
+				break;
+			}
+
+			pxDNSAnswerRecord = ( DNSAnswerRecord_t * ) pucByte;
+			pucData = pucByte + sizeof( DNSAnswerRecord_t );
+			xDataLength = ( size_t ) FreeRTOS_ntohs( pxDNSAnswerRecord->usDataLength );
+
+			if( ( size_t ) ( pucEnd - pucData ) < xDataLength )
+			{
+				break;
+			}
+
+			if( usChar2u16( pucByte ) == dnsTYPE_SOA )
+			{
+				/* Skip MNAME and RNAME, then SERIAL, REFRESH, RETRY and EXPIRE
+				come before MINIMUM. */
+				pucByte = prvSkipNameField( pucData, xDataLength );
+
+				if( pucByte != NULL )
+				{
+					pucByte = prvSkipNameField( pucByte, ( size_t ) ( ( pucData + xDataLength ) - pucByte ) );
+				}
+
+				if( ( pucByte != NULL ) && ( ( size_t ) ( ( pucData + xDataLength ) - pucByte ) >= 5u * sizeof( uint32_t ) ) )
+				{
+					ulTTL = FreeRTOS_min_uint32( FreeRTOS_ntohl( pxDNSAnswerRecord->ulTTL ),
+												 ulChar2u32( pucByte + 4u * sizeof( uint32_t ) ) );
+				}
+
+				break;
+			}
+
+			pucByte = pucData + xDataLength;
+		}
+
+		return ulTTL;
 	}
 
 #endif /* ipconfigUSE_DNS_CACHE */
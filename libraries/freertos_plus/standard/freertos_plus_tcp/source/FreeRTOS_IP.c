@@ -1333,14 +1333,14 @@ void vIPNetworkUpCalls( void )
 	}
 	#endif /* ipconfigUSE_NETWORK_EVENT_HOOK */
 
-	#if( ipconfigDNS_USE_CALLBACKS != 0 )
+	#if( ipconfigUSE_DNS != 0 )
 	{
 		/* The following function is declared in FreeRTOS_DNS.c	and 'private' to
 		this library */
 		extern void vDNSInitialise( void );
 		vDNSInitialise();
 	}
-	#endif /* ipconfigDNS_USE_CALLBACKS != 0 */
+	#endif /* ipconfigUSE_DNS != 0 */
 
 	/* Set remaining time to 0 so it will become active immediately. */
 	prvIPTimerReload( &xARPTimer, pdMS_TO_TICKS( ipARP_TIMER_PERIOD_MS ) );
@@ -1735,24 +1735,14 @@ uint8_t ucProtocol;
 
 		/* Update the checksum because the ucTypeOfMessage member in the header
 		has been changed to ipICMP_ECHO_REPLY.  This is faster than calling
-		usGenerateChecksum(). */
-
-		/* due to compiler warning "integer operation result is out of range" */
-
-		usRequest = ( uint16_t ) ( ( uint16_t )ipICMP_ECHO_REQUEST << 8 );
+		usGenerateChecksum().  The type is the high byte of the first 16-bit
+		word, the code in the low byte is not changed.  Swapping the IP
+		addresses does not change any checksum. */
+		usRequest = ( uint16_t ) ( ( uint16_t ) ipICMP_ECHO_REQUEST << 8 );
+		pxICMPHeader->usChecksum = usChecksumUpdate16( pxICMPHeader->usChecksum,
+			FreeRTOS_htons( usRequest ),
+			FreeRTOS_htons( ( uint16_t ) ( ( uint16_t ) ipICMP_ECHO_REPLY << 8 ) ) );
 
-		if( pxICMPHeader->usChecksum >= FreeRTOS_htons( 0xFFFFu - usRequest ) )
-		{
-			pxICMPHeader->usChecksum = ( uint16_t )
-				( ( ( uint32_t ) pxICMPHeader->usChecksum ) +
-					FreeRTOS_htons( usRequest + 1UL ) );
-		}
-		else
-		{
-			pxICMPHeader->usChecksum = ( uint16_t )
-				( ( ( uint32_t ) pxICMPHeader->usChecksum ) +
-					FreeRTOS_htons( usRequest ) );
-		}
 		return eReturnEthernetFrame;
 	}
 
@@ -2029,7 +2019,12 @@ uint8_t ucProtocol;
  *	 method should process. The method's memory iterator is initialized to this value.
  *   uxDataLengthBytes: This argument contains the number of bytes that this method
  *	 should process.
+ *
+ * When ipconfigUSE_FAST_CHECKSUM is defined as non-zero, a second version is
+ * used which adds the 32-bit words to a 64-bit accumulator.  The carries collect
+ * in the upper half of the accumulator, so no carry has to be tested per word.
  */
+#if( ipconfigUSE_FAST_CHECKSUM == 0 )
 uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t * pucNextData, size_t uxDataLengthBytes )
 {
 xUnion32 xSum2, xSum, xTerm;
@@ -2144,6 +2139,130 @@ uint32_t ulAlignBits, ulCarry = 0ul;
 	/* swap the output (little endian platform only). */
 	return FreeRTOS_htons( ( (uint16_t) xSum.u32 ) );
 }
+#else /* ipconfigUSE_FAST_CHECKSUM */
+uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t * pucNextData, size_t uxDataLengthBytes )
+{
+uint64_t ullSum;
+xUnion32 xSum, xTerm;
+xUnionPtr xSource;		/* Points to first byte */
+uint32_t ulAlignBits;
+
+	/* Swap the input (little endian platform only). */
+	ullSum = ( uint64_t ) FreeRTOS_ntohs( ulSum );
+	xTerm.u32 = 0ul;
+
+	xSource.u8ptr = ( uint8_t * ) pucNextData;
+	ulAlignBits = ( ( ( uint32_t ) pucNextData ) & 0x03u ); /* gives 0, 1, 2, or 3 */
+
+	/* The alignment is handled in the same way as in the classic version:
+	an odd leading byte is stored in xTerm, and the sum will be byte-swapped
+	at the end. */
+	if( ( ( ulAlignBits & 1ul ) != 0ul ) && ( uxDataLengthBytes >= ( size_t ) 1 ) )
+	{
+		xTerm.u8[ 1 ] = *( xSource.u8ptr );
+		( xSource.u8ptr )++;
+		uxDataLengthBytes--;
+	}
+
+	if( ( ( ulAlignBits == 1u ) || ( ulAlignBits == 2u ) ) && ( uxDataLengthBytes >= 2u ) )
+	{
+		ullSum += *( xSource.u16ptr );
+		( xSource.u16ptr )++;
+		uxDataLengthBytes -= 2u;
+	}
+
+	/* Word (32-bit) aligned, add 8 words, 32 bytes, per iteration.  The
+	accumulator can take 2^32 of these additions before it overflows, far
+	more than any packet holds. */
+	while( uxDataLengthBytes >= 32u )
+	{
+		ullSum += xSource.u32ptr[ 0 ];
+		ullSum += xSource.u32ptr[ 1 ];
+		ullSum += xSource.u32ptr[ 2 ];
+		ullSum += xSource.u32ptr[ 3 ];
+		ullSum += xSource.u32ptr[ 4 ];
+		ullSum += xSource.u32ptr[ 5 ];
+		ullSum += xSource.u32ptr[ 6 ];
+		ullSum += xSource.u32ptr[ 7 ];
+		xSource.u32ptr += 8;
+		uxDataLengthBytes -= 32u;
+	}
+
+	while( uxDataLengthBytes >= 4u )
+	{
+		ullSum += xSource.u32ptr[ 0 ];
+		xSource.u32ptr++;
+		uxDataLengthBytes -= 4u;
+	}
+
+	if( uxDataLengthBytes >= 2u )
+	{
+		ullSum += xSource.u16ptr[ 0 ];
+		xSource.u16ptr++;
+	}
+
+	if( ( uxDataLengthBytes & ( size_t ) 1 ) != 0u )	/* Maybe one more ? */
+	{
+		xTerm.u8[ 0 ] = xSource.u8ptr[ 0 ];
+	}
+	ullSum += xTerm.u32;
+
+	/* 2^32 and 2^16 are both 1 modulo 0xFFFF, so the 64-bit sum can be
+	folded to 32 and then to 16 bits, adding the carries each time. */
+	ullSum = ( ullSum & 0xffffffffull ) + ( ullSum >> 32 );
+	ullSum = ( ullSum & 0xffffffffull ) + ( ullSum >> 32 );
+	xSum.u32 = ( uint32_t ) ullSum;
+	xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+	xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+	if( ( ulAlignBits & 1u ) != 0u )
+	{
+		/* The sum was calculated starting at an odd position. */
+		xSum.u32 = ( ( xSum.u32 & 0xffu ) << 8 ) | ( ( xSum.u32 & 0xff00u ) >> 8 );
+	}
+
+	/* swap the output (little endian platform only). */
+	return FreeRTOS_htons( ( (uint16_t) xSum.u32 ) );
+}
+#endif /* ipconfigUSE_FAST_CHECKSUM */
+/*-----------------------------------------------------------*/
+
+uint16_t usChecksumUpdate16( uint16_t usChecksum, uint16_t usOldValue, uint16_t usNewValue )
+{
+uint32_t ulSum;
+
+	/* RFC 1624, equation 3: HC' = ~( ~HC + ~m + m' ).  Unlike the older
+	equation of RFC 1141, this never produces a checksum of 0x0000 when the
+	correct one's complement result is 0xFFFF. */
+	ulSum = ( uint32_t ) ( uint16_t ) ~usChecksum;
+	ulSum += ( uint32_t ) ( uint16_t ) ~usOldValue;
+	ulSum += ( uint32_t ) usNewValue;
+	ulSum = ( ulSum & 0xffffu ) + ( ulSum >> 16 );
+	ulSum = ( ulSum & 0xffffu ) + ( ulSum >> 16 );
+
+	return ( uint16_t ) ~ulSum;
+}
+/*-----------------------------------------------------------*/
+
+uint16_t usChecksumUpdate32( uint16_t usChecksum, uint32_t ulOldValue, uint32_t ulNewValue )
+{
+xUnion32 xOld, xNew;
+uint32_t ulSum;
+
+	/* The same as usChecksumUpdate16(), for both halves of a 32-bit field
+	such as an IP address.  Use the halves as they are stored in memory. */
+	xOld.u32 = ulOldValue;
+	xNew.u32 = ulNewValue;
+	ulSum = ( uint32_t ) ( uint16_t ) ~usChecksum;
+	ulSum += ( uint32_t ) ( uint16_t ) ~xOld.u16[ 0 ];
+	ulSum += ( uint32_t ) ( uint16_t ) ~xOld.u16[ 1 ];
+	ulSum += ( uint32_t ) xNew.u16[ 0 ];
+	ulSum += ( uint32_t ) xNew.u16[ 1 ];
+	ulSum = ( ulSum & 0xffffu ) + ( ulSum >> 16 );
+	ulSum = ( ulSum & 0xffffu ) + ( ulSum >> 16 );
+
+	return ( uint16_t ) ~ulSum;
+}
 /*-----------------------------------------------------------*/
 
 void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer, BaseType_t xReleaseAfterSend )
@@ -50,6 +50,17 @@ port number. */
 xBoundUDPSocketsList or xBoundTCPSocketsList */
 #define socketSOCKET_IS_BOUND( pxSocket )	  ( listLIST_ITEM_CONTAINER( & ( pxSocket )->xBoundSocketListItem ) != NULL )
 
+/* The ItemValue of the sockets xPortHashItem member orders the sockets within
+a bucket of a port hash table: sockets bound by the application come first, the
+child sockets of a listening socket (bound internally) after them. */
+#define socketHASH_BOUND_BY_API		( 0u )
+#define socketHASH_BOUND_INTERNAL	( 1u )
+
+/* Map a port number (network byte order) or a TCP connection to a bucket. */
+#define socketPORT_HASH( uxPort )	( ( UBaseType_t ) ( ( ( uxPort ) ^ ( ( uxPort ) >> 8 ) ) & ( ipconfigSOCKET_HASH_BUCKETS - 1 ) ) )
+#define socketCONNECTION_HASH( uxLocalPort, ulRemoteIP, uxRemotePort ) \
+	socketPORT_HASH( ( uint32_t ) ( uxLocalPort ) ^ ( ( uint32_t ) ( uxRemotePort ) * 0x9E37u ) ^ ( ulRemoteIP ) ^ ( ( ulRemoteIP ) >> 16 ) )
+
 /* If FreeRTOS_sendto() is called on a socket that is not bound to a port
 number then, depending on the FreeRTOSIPConfig.h settings, it might be that a
 port number is automatically generated for the socket.  Automatically generated
@@ -71,9 +82,12 @@ range 1024-65535" excluding those already in use (inbound or outbound). */
 /* A block time of 0 simply means "don't block". */
 #define socketDONT_BLOCK				( ( TickType_t ) 0 )
 
-#if( ( ipconfigUSE_TCP == 1 ) && !defined( ipTCP_TIMER_PERIOD_MS ) )
-	#define ipTCP_TIMER_PERIOD_MS	( 1000 )
-#endif
+/* Initial number of entries of the TCP timer heap, it doubles when needed. */
+#define socketTIMER_HEAP_MIN_SIZE		( 8u )
+
+/* Compare two tick counts that are less than half the tick range apart:
+pdTRUE when xA comes before xB. */
+#define socketTIMER_BEFORE( xA, xB )	( ( ( TickType_t ) ( ( xA ) - ( xB ) ) ) > ( portMAX_DELAY >> 1 ) )
 
 /* The next private port number to use when binding a client socket is stored in
 the usNextPortToUse[] array - which has either 1 or two indexes depending on
@@ -105,10 +119,16 @@ respectively. */
 static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol );
 
 /*
- * Return the list item from within pxList that has an item value of
- * xWantedItemValue.  If there is no such list item return NULL.
+ * Return the first socket of protocol xProtocol that is bound to uxPort
+ * (network byte order).  If there is no such socket return NULL.
+ */
+static FreeRTOS_Socket_t *prvPortHashFind( BaseType_t xProtocol, UBaseType_t uxPort );
+
+/*
+ * Return the bucket of the port hash table of xProtocol in which sockets bound
+ * to uxPort (network byte order) are stored.
  */
-static const ListItem_t * pxListFindListItemWithValue( const List_t *pxList, TickType_t xWantedItemValue );
+static List_t *prvPortHashBucket( BaseType_t xProtocol, UBaseType_t uxPort );
 
 /*
  * Return pdTRUE only if pxSocket is valid and bound, as far as can be
@@ -144,6 +164,24 @@ static BaseType_t prvDetermineSocketSize( BaseType_t xDomain, BaseType_t xType,
 	static void prvTCPSetSocketCount( FreeRTOS_Socket_t *pxSocketToDelete );
 #endif  /* ipconfigUSE_TCP == 1 */
 
+#if( ipconfigUSE_TCP == 1 )
+	/*
+	 * Make sure the TCP timer heap has room for one more bound socket.
+	 */
+	static BaseType_t prvTCPTimerReserve( void );
+
+	/*
+	 * Take a socket out of the TCP timer heap, if its timer is running.
+	 */
+	static void prvTCPTimerRemove( FreeRTOS_Socket_t *pxSocket );
+
+	/*
+	 * Called from any task: ask the IP-task to check a TCP socket as soon as
+	 * possible, e.g. because it has new data to send.
+	 */
+	static void prvTCPSocketAttention( FreeRTOS_Socket_t *pxSocket );
+#endif  /* ipconfigUSE_TCP == 1 */
+
 #if( ipconfigUSE_TCP == 1 )
 	/*
 	 * Called from FreeRTOS_connect(): make some checks and if allowed, send a
@@ -168,6 +206,37 @@ List_t xBoundUDPSocketsList;
 	List_t xBoundTCPSocketsList;
 #endif /* ipconfigUSE_TCP == 1 */
 
+/* The same sockets, hashed on their port number so that incoming packets and
+bind() do not have to walk through all of them.  The TCP table also serves as
+the table of listening sockets, as a listening socket comes before its
+children in its bucket.  Connected TCP sockets are found through
+xTCPConnectionHash, which is keyed on the local port, the remote IP address and
+the remote port.  The same protection applies as for the bound lists. */
+static List_t xUDPPortHash[ ipconfigSOCKET_HASH_BUCKETS ];
+
+#if ipconfigUSE_TCP == 1
+	static List_t xTCPPortHash[ ipconfigSOCKET_HASH_BUCKETS ];
+	static List_t xTCPConnectionHash[ ipconfigSOCKET_HASH_BUCKETS ];
+#endif /* ipconfigUSE_TCP == 1 */
+
+#if ipconfigUSE_TCP == 1
+	/* The TCP sockets whose timer is running, in a binary min-heap ordered on
+	xTimerExpiry, so that the IP-task only has to look at the sockets whose
+	timer has expired.  There is room for every bound TCP socket.  Only accessed
+	by the IP-task. */
+	static FreeRTOS_Socket_t **ppxTCPTimerHeap = NULL;
+	static UBaseType_t uxTCPTimerHeapSize = 0u;
+	static UBaseType_t uxTCPTimerCount = 0u;
+
+	/* TCP sockets which the API wants the IP-task to check as soon as possible.
+	Accesses to this list must be done with the scheduler suspended. */
+	static List_t xTCPAttentionList;
+
+	/* TCP sockets that have events for their owner, which will be passed on
+	just before the IP-task goes to sleep.  Only accessed by the IP-task. */
+	static List_t xTCPWakeUpList;
+#endif /* ipconfigUSE_TCP == 1 */
+
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvValidSocket( FreeRTOS_Socket_t *pxSocket, BaseType_t xProtocol, BaseType_t xIsBound )
@@ -195,14 +264,30 @@ BaseType_t xReturn = pdTRUE;
 
 BaseType_t vNetworkSocketsInit( void )
 {
+UBaseType_t uxBucket;
+
 	vListInitialise( &xBoundUDPSocketsList );
 
 	#if( ipconfigUSE_TCP == 1 )
 	{
 		vListInitialise( &xBoundTCPSocketsList );
+		vListInitialise( &xTCPAttentionList );
+		vListInitialise( &xTCPWakeUpList );
 	}
 	#endif  /* ipconfigUSE_TCP == 1 */
 
+	for( uxBucket = 0u; uxBucket < ( UBaseType_t ) ipconfigSOCKET_HASH_BUCKETS; uxBucket++ )
+	{
+		vListInitialise( &( xUDPPortHash[ uxBucket ] ) );
+
+		#if( ipconfigUSE_TCP == 1 )
+		{
+			vListInitialise( &( xTCPPortHash[ uxBucket ] ) );
+			vListInitialise( &( xTCPConnectionHash[ uxBucket ] ) );
+		}
+		#endif  /* ipconfigUSE_TCP == 1 */
+	}
+
 	return pdTRUE;
 }
 /*-----------------------------------------------------------*/
@@ -320,6 +405,8 @@ Socket_t xReturn;
 
 			vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
 			listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
+			vListInitialiseItem( &( pxSocket->xPortHashItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxSocket->xPortHashItem ), ( void * ) pxSocket );
 
 			pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
 			pxSocket->xSendBlockTime	= ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
@@ -330,6 +417,13 @@ Socket_t xReturn;
 			{
 				if( xProtocol == FREERTOS_IPPROTO_TCP )
 				{
+					vListInitialiseItem( &( pxSocket->u.xTCP.xConnectionHashItem ) );
+					listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xConnectionHashItem ), ( void * ) pxSocket );
+					vListInitialiseItem( &( pxSocket->u.xTCP.xAttentionListItem ) );
+					listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xAttentionListItem ), ( void * ) pxSocket );
+					vListInitialiseItem( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+					listSET_LIST_ITEM_OWNER( &( pxSocket->u.xTCP.xWakeUpListItem ), ( void * ) pxSocket );
+
 					/* StreamSize is expressed in number of bytes */
 					/* Round up buffer sizes to nearest multiple of MSS */
 					pxSocket->u.xTCP.usInitMSS	= pxSocket->u.xTCP.usCurMSS = ipconfigTCP_MSS;
@@ -347,6 +441,11 @@ Socket_t xReturn;
 						pxSocket->u.xTCP.uxTxWinSize  = 1u;
 					}
 					#endif
+					#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+					{
+						pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm = ( uint8_t ) ipconfigTCP_CONGESTION_ALGORITHM;
+					}
+					#endif
 					/* The above values are just defaults, and can be overridden by
 					calling FreeRTOS_setsockopt().  No buffers will be allocated until a
 					socket is connected and data is exchanged. */
@@ -1028,13 +1127,21 @@ List_t *pxSocketList;
 		/* Check to ensure the port is not already in use.  If the bind is
 		called internally, a port MAY be used by more than one socket. */
 		if( ( ( xInternal == pdFALSE ) || ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) ) &&
-			( pxListFindListItemWithValue( pxSocketList, ( TickType_t ) pxAddress->sin_port ) != NULL ) )
+			( prvPortHashFind( ( BaseType_t ) pxSocket->ucProtocol, ( UBaseType_t ) pxAddress->sin_port ) != NULL ) )
 		{
 			FreeRTOS_debug_printf( ( "vSocketBind: %sP port %d in use\n",
 				pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ? "TC" : "UD",
 				FreeRTOS_ntohs( pxAddress->sin_port ) ) );
 			xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
 		}
+		#if( ipconfigUSE_TCP == 1 )
+		else if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) && ( prvTCPTimerReserve() == pdFALSE ) )
+		{
+			FreeRTOS_debug_printf( ( "vSocketBind: no space for the timer of TCP port %d\n",
+				FreeRTOS_ntohs( pxAddress->sin_port ) ) );
+			xReturn = -pdFREERTOS_ERRNO_ENOMEM;
+		}
+		#endif /* ipconfigUSE_TCP */
 		else
 		{
 			/* Allocate the port number to the socket.
@@ -1059,6 +1166,24 @@ List_t *pxSocketList;
 				/* Add the socket to 'xBoundUDPSocketsList' or 'xBoundTCPSocketsList' */
 				vListInsertEnd( pxSocketList, &( pxSocket->xBoundSocketListItem ) );
 
+				/* And to the hash tables.  The remote address of a TCP socket
+				is not known yet, vSocketRehashTCP() will move it once it is. */
+				listSET_LIST_ITEM_VALUE( &( pxSocket->xPortHashItem ),
+					( xInternal != pdFALSE ) ? socketHASH_BOUND_INTERNAL : socketHASH_BOUND_BY_API );
+				vListInsert( prvPortHashBucket( ( BaseType_t ) pxSocket->ucProtocol, ( UBaseType_t ) pxAddress->sin_port ),
+					&( pxSocket->xPortHashItem ) );
+
+				#if( ipconfigUSE_TCP == 1 )
+				{
+					if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+					{
+						vListInsertEnd( &( xTCPConnectionHash[ socketCONNECTION_HASH( pxSocket->usLocalPort,
+							pxSocket->u.xTCP.ulRemoteIP, pxSocket->u.xTCP.usRemotePort ) ] ),
+							&( pxSocket->u.xTCP.xConnectionHashItem ) );
+					}
+				}
+				#endif /* ipconfigUSE_TCP */
+
 				#if( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
 				{
 					xTaskResumeAll();
@@ -1173,6 +1298,23 @@ NetworkBufferDescriptor_t *pxNetworkBuffer;
 			/* In case this is a child socket, make sure the child-count of the
 			parent socket is decreased. */
 			prvTCPSetSocketCount( pxSocket );
+
+			/* The socket won't need any more attention of the IP-task. */
+			prvTCPTimerRemove( pxSocket );
+
+			if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xWakeUpListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+			}
+
+			vTaskSuspendAll();
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xAttentionListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxSocket->u.xTCP.xAttentionListItem ) );
+				}
+			}
+			( void ) xTaskResumeAll();
 		}
 	}
 	#endif  /* ipconfigUSE_TCP == 1 */
@@ -1191,6 +1333,16 @@ NetworkBufferDescriptor_t *pxNetworkBuffer;
 		#endif /* ipconfigETHERNET_DRIVER_FILTERS_PACKETS */
 
 		uxListRemove( &( pxSocket->xBoundSocketListItem ) );
+		uxListRemove( &( pxSocket->xPortHashItem ) );
+
+		#if( ipconfigUSE_TCP == 1 )
+		{
+			if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+			{
+				uxListRemove( &( pxSocket->u.xTCP.xConnectionHashItem ) );
+			}
+		}
+		#endif /* ipconfigUSE_TCP */
 
 		#if( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
 		{
@@ -1603,7 +1755,7 @@ FreeRTOS_Socket_t *pxSocket;
 						( pxSocket->u.xTCP.ucTCPState >= eESTABLISHED ) &&
 						( FreeRTOS_outstanding( pxSocket ) != 0 ) )
 					{
-						pxSocket->u.xTCP.usTimeout = 1u; /* to set/clear bSendFullSize */
+						prvTCPSocketAttention( pxSocket ); /* to set/clear bSendFullSize */
 						xSendEventToIPTask( eTCPTimerEvent );
 					}
 				}
@@ -1627,12 +1779,30 @@ FreeRTOS_Socket_t *pxSocket;
 					}
 
 					pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
-					pxSocket->u.xTCP.usTimeout = 1u; /* to set/clear bRxStopped */
+					prvTCPSocketAttention( pxSocket ); /* to set/clear bRxStopped */
 					xSendEventToIPTask( eTCPTimerEvent );
 				}
 				xReturn = 0;
 				break;
 
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+				case FREERTOS_SO_TCP_CONGESTION:	/* Select the congestion control algorithm */
+					{
+						if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+						{
+							break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+						}
+
+						if( xTCPWindowCongestionSelect( &( pxSocket->u.xTCP.xTCPWindow ), *( ( BaseType_t * ) pvOptionValue ) ) == pdFALSE )
+						{
+							FreeRTOS_debug_printf( ( "Set SO_TCP_CONGESTION: algorithm %ld not available\n", *( ( BaseType_t * ) pvOptionValue ) ) );
+							break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+						}
+					}
+					xReturn = 0;
+					break;
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 		#endif  /* ipconfigUSE_TCP == 1 */
 
 		default :
@@ -1646,6 +1816,85 @@ FreeRTOS_Socket_t *pxSocket;
 
 /*-----------------------------------------------------------*/
 
+BaseType_t FreeRTOS_getsockopt( Socket_t xSocket, int32_t lLevel, int32_t lOptionName, void *pvOptionValue, size_t *pxOptionLength )
+{
+/* The standard Berkeley function returns 0 for success. */
+BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+FreeRTOS_Socket_t *pxSocket;
+
+	pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+
+	/* The level is not used, as in FreeRTOS_setsockopt(). */
+	( void ) lLevel;
+
+	configASSERT( xSocket );
+	configASSERT( pxOptionLength );
+
+	switch( lOptionName )
+	{
+		case FREERTOS_SO_RCVTIMEO	:
+		case FREERTOS_SO_SNDTIMEO	:
+			if( *pxOptionLength < sizeof( TickType_t ) )
+			{
+				break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+			}
+
+			if( lOptionName == FREERTOS_SO_RCVTIMEO )
+			{
+				*( ( TickType_t * ) pvOptionValue ) = pxSocket->xReceiveBlockTime;
+			}
+			else
+			{
+				*( ( TickType_t * ) pvOptionValue ) = pxSocket->xSendBlockTime;
+			}
+			*pxOptionLength = sizeof( TickType_t );
+			xReturn = 0;
+			break;
+
+		#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			case FREERTOS_SO_TCP_CONGESTION:
+				if( ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) || ( *pxOptionLength < sizeof( BaseType_t ) ) )
+				{
+					break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+				}
+
+				*( ( BaseType_t * ) pvOptionValue ) = ( BaseType_t ) pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm;
+				*pxOptionLength = sizeof( BaseType_t );
+				xReturn = 0;
+				break;
+
+			case FREERTOS_SO_TCP_CONGESTION_INFO:
+				{
+				TCPCongestionInfo_t *pxInfo = ( TCPCongestionInfo_t * ) pvOptionValue;
+
+					if( ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) || ( *pxOptionLength < sizeof( *pxInfo ) ) )
+					{
+						break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+					}
+
+					/* The IP-task may be changing the values while they are
+					read, they are informative only.  Both are zero as long as
+					the connection has not been made. */
+					pxInfo->xAlgorithm = ( BaseType_t ) pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm;
+					pxInfo->ulCWnd = pxSocket->u.xTCP.xTCPWindow.xCongestion.ulCWnd;
+					pxInfo->ulSSThresh = pxSocket->u.xTCP.xTCPWindow.xCongestion.ulSSThresh;
+					*pxOptionLength = sizeof( *pxInfo );
+				}
+				xReturn = 0;
+				break;
+		#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+		default :
+			/* No other options are handled. */
+			xReturn = -pdFREERTOS_ERRNO_ENOPROTOOPT;
+			break;
+	}
+
+	return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
 /* Find an available port number per https://tools.ietf.org/html/rfc6056. */
 static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol )
 {
@@ -1655,21 +1904,6 @@ uint16_t usIterations = usEphemeralPortCount;
 uint32_t ulRandomSeed = 0;
 uint16_t usResult = 0;
 BaseType_t xGotZeroOnce = pdFALSE;
-const List_t *pxList;
-
-#if ipconfigUSE_TCP == 1
-	if( xProtocol == ( BaseType_t ) FREERTOS_IPPROTO_TCP )
-	{
-		pxList = &xBoundTCPSocketsList;
-	}
-	else
-#endif
-	{
-		pxList = &xBoundUDPSocketsList;
-	}
-
-	/* Avoid compiler warnings if ipconfigUSE_TCP is not defined. */
-	( void ) xProtocol;
 
 	/* Find the next available port using the random seed as a starting
 	point. */
@@ -1699,9 +1933,9 @@ const List_t *pxList;
 
 		/* Check if there's already an open socket with the same protocol
 		and port. */
-		if( NULL == pxListFindListItemWithValue(
-			pxList,
-			( TickType_t )FreeRTOS_htons( usResult ) ) )
+		if( NULL == prvPortHashFind(
+			xProtocol,
+			( UBaseType_t )FreeRTOS_htons( usResult ) ) )
 		{
 			usResult = FreeRTOS_htons( usResult );
 			break;
@@ -1719,23 +1953,48 @@ const List_t *pxList;
 }
 /*-----------------------------------------------------------*/
 
-/* pxListFindListItemWithValue: find a list item in a bound socket list
-'xWantedItemValue' refers to a port number */
-static const ListItem_t * pxListFindListItemWithValue( const List_t *pxList, TickType_t xWantedItemValue )
+static List_t *prvPortHashBucket( BaseType_t xProtocol, UBaseType_t uxPort )
+{
+List_t *pxBucket;
+
+#if ipconfigUSE_TCP == 1
+	if( xProtocol == ( BaseType_t ) FREERTOS_IPPROTO_TCP )
+	{
+		pxBucket = &( xTCPPortHash[ socketPORT_HASH( uxPort ) ] );
+	}
+	else
+#endif
+	{
+		pxBucket = &( xUDPPortHash[ socketPORT_HASH( uxPort ) ] );
+	}
+
+	/* Avoid compiler warnings if ipconfigUSE_TCP is not defined. */
+	( void ) xProtocol;
+
+	return pxBucket;
+}
+/*-----------------------------------------------------------*/
+
+/* prvPortHashFind: find a socket in a bucket of a port hash table.  'uxPort'
+is compared with the item value of the bound list item, the port number in
+network byte order. */
+static FreeRTOS_Socket_t *prvPortHashFind( BaseType_t xProtocol, UBaseType_t uxPort )
 {
-const ListItem_t * pxResult = NULL;
+FreeRTOS_Socket_t *pxResult = NULL;
 
-	if( ( xIPIsNetworkTaskReady() != pdFALSE ) && ( pxList != NULL ) )
+	if( xIPIsNetworkTaskReady() != pdFALSE )
 	{
 		const ListItem_t *pxIterator;
-		const MiniListItem_t *pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( pxList );
+		const MiniListItem_t *pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( prvPortHashBucket( xProtocol, uxPort ) );
 		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
 			 pxIterator != ( const ListItem_t * ) pxEnd;
 			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
 		{
-			if( listGET_LIST_ITEM_VALUE( pxIterator ) == xWantedItemValue )
+			FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			if( socketGET_SOCKET_PORT( pxSocket ) == ( TickType_t ) uxPort )
 			{
-				pxResult = pxIterator;
+				pxResult = pxSocket;
 				break;
 			}
 		}
@@ -1748,22 +2007,9 @@ const ListItem_t * pxResult = NULL;
 
 FreeRTOS_Socket_t *pxUDPSocketLookup( UBaseType_t uxLocalPort )
 {
-const ListItem_t *pxListItem;
-FreeRTOS_Socket_t *pxSocket = NULL;
-
-	/* Looking up a socket is quite simple, find a match with the local port.
-
-	See if there is a list item associated with the port number on the
-	list of bound sockets. */
-	pxListItem = pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) uxLocalPort );
-
-	if( pxListItem != NULL )
-	{
-		/* The owner of the list item is the socket itself. */
-		pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
-		configASSERT( pxSocket != NULL );
-	}
-	return pxSocket;
+	/* Looking up a socket is quite simple, find a match with the local port
+	in the port hash table. */
+	return prvPortHashFind( ( BaseType_t ) FREERTOS_IPPROTO_UDP, uxLocalPort );
 }
 
 /*-----------------------------------------------------------*/
@@ -1936,7 +2182,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 
 		vTaskSuspendAll();
 		{
-			if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+			if( prvPortHashFind( ( BaseType_t ) FREERTOS_IPPROTO_UDP, ( UBaseType_t ) usPortNr ) != NULL )
 			{
 				xFound = pdTRUE;
 			}
@@ -2015,7 +2261,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 				vTCPStateChange( pxSocket, eCONNECT_SYN );
 
 				/* To start an active connect. */
-				pxSocket->u.xTCP.usTimeout = 1u;
+				prvTCPSocketAttention( pxSocket );
 
 				if( xSendEventToIPTask( eTCPTimerEvent ) != pdPASS )
 				{
@@ -2378,14 +2624,16 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 						{
 							pxSocket->u.xTCP.bits.bLowWater = pdFALSE_UNSIGNED;
 							pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
-							pxSocket->u.xTCP.usTimeout = 1u; /* because bLowWater is cleared. */
+							prvTCPSocketAttention( pxSocket ); /* because bLowWater is cleared. */
 							xSendEventToIPTask( eTCPTimerEvent );
 						}
 					}
 				}
 				else
 				{
-					/* Zero-copy reception of data: pvBuffer is a pointer to a pointer. */
+					/* Zero-copy reception of data: pvBuffer is a pointer to a
+					pointer.  The data stays in the stream until it is released
+					with FreeRTOS_ReleaseTCPPayloadBuffer(). */
 					xByteCount = ( BaseType_t ) uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, (uint8_t **)pvBuffer );
 				}
 			}
@@ -2397,6 +2645,46 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP == 1 )
+
+	/*
+	 * Release data that was borrowed from the reception stream with
+	 * FreeRTOS_recv( xSocket, &pucData, 0, FREERTOS_ZERO_COPY ).  'pvBuffer'
+	 * must be the pointer that FreeRTOS_recv() returned, and 'xByteCount' may
+	 * not be larger than the number of bytes it returned.  The space becomes
+	 * available for new data, and the window will be opened again if needed.
+	 */
+	BaseType_t FreeRTOS_ReleaseTCPPayloadBuffer( Socket_t xSocket, void const *pvBuffer, BaseType_t xByteCount )
+	{
+	FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+	uint8_t *pucTail;
+	BaseType_t xResult;
+
+		if( ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdFALSE ) ||
+			( pxSocket->u.xTCP.rxStream == NULL ) ||
+			( xByteCount <= 0 ) )
+		{
+			xResult = -pdFREERTOS_ERRNO_EINVAL;
+		}
+		else if( ( uxStreamBufferGetPtr( pxSocket->u.xTCP.rxStream, &pucTail ) < ( size_t ) xByteCount ) ||
+				 ( pucTail != ( const uint8_t * ) pvBuffer ) )
+		{
+			/* The data was not borrowed, or it has been released already. */
+			xResult = -pdFREERTOS_ERRNO_EINVAL;
+		}
+		else
+		{
+			/* Calling FreeRTOS_recv() with a NULL buffer advances the tail
+			without copying, and takes care of the low-water mark. */
+			xResult = FreeRTOS_recv( xSocket, NULL, ( size_t ) xByteCount, FREERTOS_MSG_DONTWAIT );
+		}
+
+		return xResult;
+	}
+
+#endif /* ipconfigUSE_TCP */
+/*-----------------------------------------------------------*/
+
 #if( ipconfigUSE_TCP == 1 )
 
 	static int32_t prvTCPSendCheck( FreeRTOS_Socket_t *pxSocket, size_t xDataLength )
@@ -2450,7 +2738,9 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 #if( ipconfigUSE_TCP == 1 )
 
 	/* Get a direct pointer to the circular transmit buffer.
-	'*pxLength' will contain the number of bytes that may be written. */
+	'*pxLength' will contain the number of bytes that may be written.  Once the
+	data has been written, it is committed by passing the same pointer to
+	FreeRTOS_send(), which will then not copy it. */
 	uint8_t *FreeRTOS_get_tx_head( Socket_t xSocket, BaseType_t *pxLength )
 	{
     uint8_t *pucReturn = NULL;
@@ -2464,6 +2754,14 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
         if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_TCP, pdFALSE ) == pdTRUE )
         {
             pxBuffer = pxSocket->u.xTCP.txStream;
+
+            if( ( pxBuffer == NULL ) && ( pxSocket->u.xTCP.bits.bMallocError == pdFALSE_UNSIGNED ) )
+            {
+                /* The stream is normally created by the first call to
+                FreeRTOS_send(), which may not have taken place yet. */
+                pxBuffer = prvTCPCreateStream( pxSocket, pdFALSE );
+            }
+
             if( pxBuffer != NULL )
             {
             BaseType_t xSpace = ( BaseType_t )uxStreamBufferGetSpace( pxBuffer );
@@ -2494,10 +2792,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 	BaseType_t xTimed = pdFALSE;
 	TimeOut_t xTimeOut;
 	BaseType_t xCloseAfterSend;
-
-		/* Prevent compiler warnings about unused parameters.  The parameter
-		may be used in future versions. */
-		( void ) xFlags;
+	BaseType_t xZeroCopy = pdFALSE;
 
 		xByteCount = ( BaseType_t ) prvTCPSendCheck( pxSocket, uxDataLength );
 
@@ -2506,6 +2801,16 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 			/* xBytesLeft is number of bytes to send, will count to zero. */
 			xBytesLeft = ( BaseType_t ) uxDataLength;
 
+			/* When pvBuffer was obtained from FreeRTOS_get_tx_head(), the data
+			has been written to the stream already and only the head needs to
+			be advanced.  Such data was written in free space, so there is no
+			need to wait for more space. */
+			if( pvBuffer == ( const void * ) ( pxSocket->u.xTCP.txStream->ucArray + pxSocket->u.xTCP.txStream->uxHead ) )
+			{
+				xZeroCopy = pdTRUE;
+				pvBuffer = NULL;
+			}
+
 			/* xByteCount is number of bytes that can be sent now. */
 			xByteCount = ( BaseType_t ) uxStreamBufferGetSpace( pxSocket->u.xTCP.txStream );
 
@@ -2560,7 +2865,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 
 					/* Send a message to the IP-task so it can work on this
 					socket.  Data is sent, let the IP-task work on it. */
-					pxSocket->u.xTCP.usTimeout = 1u;
+					prvTCPSocketAttention( pxSocket );
 
 					if( xIsCallingFromIPTask() == pdFALSE )
 					{
@@ -2576,10 +2881,21 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 						break;
 					}
 
+					if( xZeroCopy != pdFALSE )
+					{
+						/* More was committed than FreeRTOS_get_tx_head() made
+						available. */
+						break;
+					}
+
 					/* As there are still bytes left to be sent, increase the
 					data pointer. */
 					pvBuffer = ( void * ) ( ( ( const uint8_t * ) pvBuffer) + xByteCount );
 				}
+				else if( xZeroCopy != pdFALSE )
+				{
+					break;
+				}
 
 				/* Not all bytes have been sent. In case the socket is marked as
 				blocking sleep for a while. */
@@ -2707,7 +3023,19 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 				}
 
 				memset( pxSocket->u.xTCP.xPacket.u.ucLastPacket, '\0', sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) );
-				memset( &pxSocket->u.xTCP.xTCPWindow, '\0', sizeof( pxSocket->u.xTCP.xTCPWindow ) );
+				#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+				{
+				uint8_t ucAlgorithm = pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm;
+
+					/* The choice of algorithm survives the cleaning. */
+					memset( &pxSocket->u.xTCP.xTCPWindow, '\0', sizeof( pxSocket->u.xTCP.xTCPWindow ) );
+					pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm = ucAlgorithm;
+				}
+				#else
+				{
+					memset( &pxSocket->u.xTCP.xTCPWindow, '\0', sizeof( pxSocket->u.xTCP.xTCPWindow ) );
+				}
+				#endif
 				memset( &pxSocket->u.xTCP.bits, '\0', sizeof( pxSocket->u.xTCP.bits ) );
 
 				/* Now set the bReuseSocket flag again, because the bits have
@@ -2749,7 +3077,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 			pxSocket->u.xTCP.bits.bUserShutdown = pdTRUE_UNSIGNED;
 
 			/* Let the IP-task perform the shutdown of the connection. */
-			pxSocket->u.xTCP.usTimeout = 1u;
+			prvTCPSocketAttention( pxSocket );
 			xSendEventToIPTask( eTCPTimerEvent );
 			xResult = 0;
 		}
@@ -2763,84 +3091,299 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 
 #if( ipconfigUSE_TCP == 1 )
 
-	/*
-	 * A TCP timer has expired, now check all TCP sockets for:
-	 * - Active connect
-	 * - Send a delayed ACK
-	 * - Send new data
-	 * - Send a keep-alive packet
-	 * - Check for timeout (in non-connected states only)
-	 */
-	TickType_t xTCPTimerCheck( BaseType_t xWillSleep )
+	static void prvTCPTimerPlace( FreeRTOS_Socket_t *pxSocket, UBaseType_t uxIndex )
 	{
-	FreeRTOS_Socket_t *pxSocket;
-	TickType_t xShortest = pdMS_TO_TICKS( ( TickType_t ) ipTCP_TIMER_PERIOD_MS );
-	TickType_t xNow = xTaskGetTickCount();
-	static TickType_t xLastTime = 0u;
-	TickType_t xDelta = xNow - xLastTime;
-	ListItem_t* pxEnd = ( ListItem_t * ) listGET_END_MARKER( &xBoundTCPSocketsList );
-	ListItem_t *pxIterator = ( ListItem_t * ) listGET_HEAD_ENTRY( &xBoundTCPSocketsList );
+		ppxTCPTimerHeap[ uxIndex ] = pxSocket;
+		pxSocket->u.xTCP.uxTimerIndex = uxIndex + 1u;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTCPTimerSiftUp( UBaseType_t uxIndex )
+	{
+	FreeRTOS_Socket_t *pxSocket = ppxTCPTimerHeap[ uxIndex ];
+	UBaseType_t uxParent;
+
+		while( uxIndex > 0u )
+		{
+			uxParent = ( uxIndex - 1u ) / 2u;
+
+			if( socketTIMER_BEFORE( pxSocket->u.xTCP.xTimerExpiry, ppxTCPTimerHeap[ uxParent ]->u.xTCP.xTimerExpiry ) == pdFALSE )
+			{
+				break;
+			}
+
+			prvTCPTimerPlace( ppxTCPTimerHeap[ uxParent ], uxIndex );
+			uxIndex = uxParent;
+		}
+
+		prvTCPTimerPlace( pxSocket, uxIndex );
+	}
+	/*-----------------------------------------------------------*/
 
-		xLastTime = xNow;
+	static void prvTCPTimerSiftDown( UBaseType_t uxIndex )
+	{
+	FreeRTOS_Socket_t *pxSocket = ppxTCPTimerHeap[ uxIndex ];
+	UBaseType_t uxChild;
 
-		if( xDelta == 0u )
+		for( ;; )
 		{
-			xDelta = 1u;
+			uxChild = ( 2u * uxIndex ) + 1u;
+
+			if( uxChild >= uxTCPTimerCount )
+			{
+				break;
+			}
+
+			/* Take the child whose timer expires first. */
+			if( ( ( uxChild + 1u ) < uxTCPTimerCount ) &&
+				( socketTIMER_BEFORE( ppxTCPTimerHeap[ uxChild + 1u ]->u.xTCP.xTimerExpiry, ppxTCPTimerHeap[ uxChild ]->u.xTCP.xTimerExpiry ) != pdFALSE ) )
+			{
+				uxChild++;
+			}
+
+			if( socketTIMER_BEFORE( ppxTCPTimerHeap[ uxChild ]->u.xTCP.xTimerExpiry, pxSocket->u.xTCP.xTimerExpiry ) == pdFALSE )
+			{
+				break;
+			}
+
+			prvTCPTimerPlace( ppxTCPTimerHeap[ uxChild ], uxIndex );
+			uxIndex = uxChild;
 		}
 
-		while( pxIterator != pxEnd )
+		prvTCPTimerPlace( pxSocket, uxIndex );
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTCPTimerReserve( void )
+	{
+	BaseType_t xReturn = pdTRUE;
+	UBaseType_t uxNewSize;
+	FreeRTOS_Socket_t **ppxNewHeap;
+
+		if( ( listCURRENT_LIST_LENGTH( &xBoundTCPSocketsList ) + 1u ) > uxTCPTimerHeapSize )
 		{
-			pxSocket = ( FreeRTOS_Socket_t * )listGET_LIST_ITEM_OWNER( pxIterator );
-			pxIterator = ( ListItem_t * ) listGET_NEXT( pxIterator );
+			uxNewSize = 2u * uxTCPTimerHeapSize;
 
-			/* Sockets with 'tmout == 0' do not need any regular attention. */
-			if( pxSocket->u.xTCP.usTimeout == 0u )
+			if( uxNewSize < socketTIMER_HEAP_MIN_SIZE )
 			{
-				continue;
+				uxNewSize = socketTIMER_HEAP_MIN_SIZE;
 			}
 
-			if( xDelta < ( TickType_t ) pxSocket->u.xTCP.usTimeout )
+			ppxNewHeap = ( FreeRTOS_Socket_t ** ) pvPortMalloc( uxNewSize * sizeof( *ppxNewHeap ) );
+
+			if( ppxNewHeap == NULL )
 			{
-				pxSocket->u.xTCP.usTimeout = ( uint16_t ) ( ( ( TickType_t ) pxSocket->u.xTCP.usTimeout ) - xDelta );
+				xReturn = pdFALSE;
 			}
 			else
 			{
-			int rc ;
-				pxSocket->u.xTCP.usTimeout = 0u;
-				rc = xTCPSocketCheck( pxSocket );
-
-				/* Within this function, the socket might want to send a delayed
-				ack or send out data or whatever it needs to do. */
-				if( rc < 0 )
+				if( ppxTCPTimerHeap != NULL )
 				{
-					/* Continue because the socket was deleted. */
-					continue;
+					memcpy( ppxNewHeap, ppxTCPTimerHeap, uxTCPTimerCount * sizeof( *ppxNewHeap ) );
+					vPortFree( ppxTCPTimerHeap );
 				}
+
+				ppxTCPTimerHeap = ppxNewHeap;
+				uxTCPTimerHeapSize = uxNewSize;
 			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTCPTimerRemove( FreeRTOS_Socket_t *pxSocket )
+	{
+	UBaseType_t uxIndex = pxSocket->u.xTCP.uxTimerIndex;
+	FreeRTOS_Socket_t *pxLast;
 
-			/* In xEventBits the driver may indicate that the socket has
-			important events for the user.  These are only done just before the
-			IP-task goes to sleep. */
-			if( pxSocket->xEventBits != 0u )
+		if( uxIndex != 0u )
+		{
+			uxIndex--;
+			pxSocket->u.xTCP.uxTimerIndex = 0u;
+			uxTCPTimerCount--;
+
+			if( uxIndex < uxTCPTimerCount )
 			{
-				if( xWillSleep != pdFALSE )
+				/* Fill the hole with the last entry and restore the order. */
+				pxLast = ppxTCPTimerHeap[ uxTCPTimerCount ];
+				prvTCPTimerPlace( pxLast, uxIndex );
+
+				if( ( uxIndex > 0u ) &&
+					( socketTIMER_BEFORE( pxLast->u.xTCP.xTimerExpiry, ppxTCPTimerHeap[ ( uxIndex - 1u ) / 2u ]->u.xTCP.xTimerExpiry ) != pdFALSE ) )
 				{
-					/* The IP-task is about to go to sleep, so messages can be
-					sent to the socket owners. */
-					vSocketWakeUpUser( pxSocket );
+					prvTCPTimerSiftUp( uxIndex );
 				}
 				else
 				{
-					/* Or else make sure this will be called again to wake-up
-					the sockets' owner. */
-					xShortest = ( TickType_t ) 0;
+					prvTCPTimerSiftDown( uxIndex );
 				}
 			}
+		}
+	}
+	/*-----------------------------------------------------------*/
 
-			if( ( pxSocket->u.xTCP.usTimeout != 0u ) && ( xShortest > ( TickType_t ) pxSocket->u.xTCP.usTimeout ) )
+	static void prvTCPTimerStart( FreeRTOS_Socket_t *pxSocket, TickType_t xExpiry )
+	{
+		prvTCPTimerRemove( pxSocket );
+
+		/* vSocketBind() has made room for every bound socket. */
+		configASSERT( uxTCPTimerCount < uxTCPTimerHeapSize );
+
+		pxSocket->u.xTCP.xTimerExpiry = xExpiry;
+		ppxTCPTimerHeap[ uxTCPTimerCount ] = pxSocket;
+		uxTCPTimerCount++;
+		prvTCPTimerSiftUp( uxTCPTimerCount - 1u );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTCPSocketTimerSet( FreeRTOS_Socket_t *pxSocket, TickType_t xTicks )
+	{
+		if( ( xTicks != 0u ) && ( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE ) )
+		{
+			prvTCPTimerStart( pxSocket, xTaskGetTickCount() + xTicks );
+		}
+		else
+		{
+			/* Sockets that are not bound never get checked. */
+			prvTCPTimerRemove( pxSocket );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	TickType_t xTCPSocketTimerRemaining( const FreeRTOS_Socket_t *pxSocket )
+	{
+	TickType_t xRemaining = 0u;
+
+		if( pxSocket->u.xTCP.uxTimerIndex != 0u )
+		{
+			xRemaining = pxSocket->u.xTCP.xTimerExpiry - xTaskGetTickCount();
+
+			if( ( xRemaining == 0u ) || ( xRemaining > ( portMAX_DELAY >> 1 ) ) )
+			{
+				/* Expired, but not handled yet. */
+				xRemaining = 1u;
+			}
+		}
+
+		return xRemaining;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTCPSocketAttention( FreeRTOS_Socket_t *pxSocket )
+	{
+		/* Only bound sockets get checked by the IP-task. */
+		if( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE )
+		{
+			vTaskSuspendAll();
 			{
-				xShortest = ( TickType_t ) pxSocket->u.xTCP.usTimeout;
+				if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xAttentionListItem ) ) == NULL )
+				{
+					vListInsertEnd( &xTCPAttentionList, &( pxSocket->u.xTCP.xAttentionListItem ) );
+				}
 			}
+			( void ) xTaskResumeAll();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vSocketWakeUpUserLater( FreeRTOS_Socket_t *pxSocket )
+	{
+		if( ( pxSocket->xEventBits != 0u ) &&
+			( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xWakeUpListItem ) ) == NULL ) )
+		{
+			vListInsertEnd( &xTCPWakeUpList, &( pxSocket->u.xTCP.xWakeUpListItem ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	/*
+	 * A TCP timer has expired, or a socket asked for attention.  Check only
+	 * those sockets for:
+	 * - Active connect
+	 * - Send a delayed ACK
+	 * - Send new data
+	 * - Send a keep-alive packet
+	 * - Check for timeout (in non-connected states only)
+	 */
+	TickType_t xTCPTimerCheck( BaseType_t xWillSleep )
+	{
+	FreeRTOS_Socket_t *pxSocket;
+	TickType_t xNow = xTaskGetTickCount();
+	TickType_t xShortest;
+	UBaseType_t uxCount;
+
+		/* The sockets which asked for attention expire right now. */
+		do
+		{
+			pxSocket = NULL;
+
+			vTaskSuspendAll();
+			{
+				if( listLIST_IS_EMPTY( &xTCPAttentionList ) == pdFALSE )
+				{
+					pxSocket = ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTCPAttentionList );
+					( void ) uxListRemove( &( pxSocket->u.xTCP.xAttentionListItem ) );
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( pxSocket != NULL )
+			{
+				prvTCPTimerStart( pxSocket, xNow );
+			}
+		} while( pxSocket != NULL );
+
+		/* Handle the expired timers.  A socket always sets its next timeout at
+		least one tick ahead, but to be safe, never handle more sockets than
+		there were timers running. */
+		uxCount = uxTCPTimerCount;
+
+		while( ( uxCount > 0u ) && ( uxTCPTimerCount > 0u ) &&
+			   ( socketTIMER_BEFORE( xNow, ppxTCPTimerHeap[ 0 ]->u.xTCP.xTimerExpiry ) == pdFALSE ) )
+		{
+			uxCount--;
+			pxSocket = ppxTCPTimerHeap[ 0 ];
+			prvTCPTimerRemove( pxSocket );
+
+			/* Within this function, the socket might want to send a delayed
+			ack or send out data or whatever it needs to do. */
+			if( xTCPSocketCheck( pxSocket ) < 0 )
+			{
+				/* Continue because the socket was deleted. */
+				continue;
+			}
+
+			vSocketWakeUpUserLater( pxSocket );
+		}
+
+		/* In xEventBits the driver may indicate that the socket has important
+		events for the user.  These are only done just before the IP-task goes
+		to sleep. */
+		if( xWillSleep != pdFALSE )
+		{
+			while( listLIST_IS_EMPTY( &xTCPWakeUpList ) == pdFALSE )
+			{
+				pxSocket = ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xTCPWakeUpList );
+				( void ) uxListRemove( &( pxSocket->u.xTCP.xWakeUpListItem ) );
+				vSocketWakeUpUser( pxSocket );
+			}
+		}
+
+		if( ( listLIST_IS_EMPTY( &xTCPWakeUpList ) == pdFALSE ) ||
+			( listLIST_IS_EMPTY( &xTCPAttentionList ) == pdFALSE ) )
+		{
+			/* Make sure this will be called again soon. */
+			xShortest = ( TickType_t ) 0;
+		}
+		else if( uxTCPTimerCount == 0u )
+		{
+			/* No socket needs attention until an event arrives. */
+			xShortest = portMAX_DELAY;
+		}
+		else
+		{
+			xShortest = xTCPSocketTimerRemaining( ppxTCPTimerHeap[ 0 ] );
 		}
 
 		return xShortest;
@@ -2859,45 +3402,68 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 	 */
 	FreeRTOS_Socket_t *pxTCPSocketLookup( uint32_t ulLocalIP, UBaseType_t uxLocalPort, uint32_t ulRemoteIP, UBaseType_t uxRemotePort )
 	{
-	ListItem_t *pxIterator;
-	FreeRTOS_Socket_t *pxResult = NULL, *pxListenSocket = NULL;
-	MiniListItem_t *pxEnd = ( MiniListItem_t* )listGET_END_MARKER( &xBoundTCPSocketsList );
+	const ListItem_t *pxIterator;
+	const MiniListItem_t *pxEnd;
+	FreeRTOS_Socket_t *pxResult = NULL;
 
 		/* Parameter not yet supported. */
 		( void ) ulLocalIP;
 
-		for( pxIterator  = ( ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( ListItem_t * ) pxEnd;
-			 pxIterator  = ( ListItem_t * ) listGET_NEXT( pxIterator ) )
+		/* For sockets not in listening mode, find a match with xLocalPort,
+		ulRemoteIP AND xRemotePort in the connection hash table. */
+		pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( &( xTCPConnectionHash[ socketCONNECTION_HASH( uxLocalPort, ulRemoteIP, uxRemotePort ) ] ) );
+		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+			 pxIterator != ( const ListItem_t * ) pxEnd;
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
 		{
 			FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-			if( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort )
+			if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+				( pxSocket->u.xTCP.ucTCPState != ( uint8_t ) eTCP_LISTEN ) &&
+				( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) &&
+				( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) )
 			{
-				if( pxSocket->u.xTCP.ucTCPState == eTCP_LISTEN )
-				{
-					/* If this is a socket listening to uxLocalPort, remember it
-					in case there is no perfect match. */
-					pxListenSocket = pxSocket;
-				}
-				else if( ( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) && ( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) )
+				pxResult = pxSocket;
+				break;
+			}
+		}
+
+		if( pxResult == NULL )
+		{
+			/* An exact match was not found, maybe a socket is listening to
+			uxLocalPort.  Listening sockets come before their children in the
+			port hash table. */
+			pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( prvPortHashBucket( ( BaseType_t ) FREERTOS_IPPROTO_TCP, ( UBaseType_t ) FreeRTOS_htons( ( uint16_t ) uxLocalPort ) ) );
+			for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+				 pxIterator != ( const ListItem_t * ) pxEnd;
+				 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+			{
+				FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+				if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+					( pxSocket->u.xTCP.ucTCPState == ( uint8_t ) eTCP_LISTEN ) )
 				{
-					/* For sockets not in listening mode, find a match with
-					xLocalPort, ulRemoteIP AND xRemotePort. */
 					pxResult = pxSocket;
 					break;
 				}
 			}
 		}
-		if( pxResult == NULL )
-		{
-			/* An exact match was not found, maybe a listening socket was
-			found. */
-			pxResult = pxListenSocket;
-		}
 
 		return pxResult;
 	}
+/*-----------------------------------------------------------*/
+
+	void vSocketRehashTCP( FreeRTOS_Socket_t *pxSocket )
+	{
+		/* Only bound sockets are stored in the connection hash table. */
+		if( listLIST_ITEM_CONTAINER( &( pxSocket->u.xTCP.xConnectionHashItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxSocket->u.xTCP.xConnectionHashItem ) );
+			vListInsertEnd( &( xTCPConnectionHash[ socketCONNECTION_HASH( pxSocket->usLocalPort,
+				pxSocket->u.xTCP.ulRemoteIP, pxSocket->u.xTCP.usRemotePort ) ] ),
+				&( pxSocket->u.xTCP.xConnectionHashItem ) );
+		}
+	}
 
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
@@ -3097,7 +3663,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 						pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
 
 						/* bLowWater was reached, send the changed window size. */
-						pxSocket->u.xTCP.usTimeout = 1u;
+						prvTCPSocketAttention( pxSocket );
 						xSendEventToIPTask( eTCPTimerEvent );
 					}
 				}
@@ -3425,7 +3991,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 					pxSocket->u.xTCP.txStream != NULL,
 					FreeRTOS_GetTCPStateName( pxSocket->u.xTCP.ucTCPState ),
 					(age > 999999 ? 999999 : age), /* Format 'age' for printing */
-					pxSocket->u.xTCP.usTimeout,
+					( unsigned ) xTCPSocketTimerRemaining( pxSocket ),
 					ucChildText ) );
 					/* Remove compiler warnings if FreeRTOS_debug_printf() is not defined. */
 					( void ) pxHandleReceive;
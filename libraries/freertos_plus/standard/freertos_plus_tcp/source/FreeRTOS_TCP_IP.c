@@ -93,6 +93,7 @@ the defined MTU size can contain at least a complete TCP packet. */
 #define TCP_OPT_WSOPT			3u   /* TCP Window Scale Option (3-byte long) */
 #define TCP_OPT_SACK_P			4u   /* Advertize that SACK is permitted */
 #define TCP_OPT_SACK_A			5u   /* SACK option with first/last */
+#define TCP_OPT_SACK_MAX_BLOCKS	4u   /* At most 4 SACK blocks fit in the 40 bytes of options */
 #define TCP_OPT_TIMESTAMP		8u   /* Time-stamp option */
 
 #define TCP_OPT_MSS_LEN			4u   /* Length of TCP MSS option. */
@@ -469,7 +470,7 @@ static BaseType_t prvTCPSocketIsActive( UBaseType_t uxStatus )
  * It can send a delayed ACK or new data
  * Sequence of calling (normally) :
  * IP-Task:
- *		xTCPTimerCheck()				// Check all sockets ( declared in FreeRTOS_Sockets.c )
+ *		xTCPTimerCheck()				// Check the sockets whose timer expired ( declared in FreeRTOS_Sockets.c )
  *		xTCPSocketCheck()				// Either send a delayed ACK or call prvTCPSendPacket()
  *		prvTCPSendPacket()				// Either send a SYN or call prvTCPSendRepeated ( regular messages )
  *		prvTCPSendRepeated()			// Send at most 8 messages on a row
@@ -1064,6 +1065,9 @@ uint32_t ulInitialSequenceNumber = 0;
 		/* And remember that the connect/SYN data are prepared. */
 		pxSocket->u.xTCP.bits.bConnPrepared = pdTRUE_UNSIGNED;
 
+		/* The 4-tuple is complete: let pxTCPSocketLookup() find the replies. */
+		vSocketRehashTCP( pxSocket );
+
 		/* Now that the Ethernet address is known, the initial packet can be
 		prepared. */
 		memset( pxSocket->u.xTCP.xPacket.u.ucLastPacket, '\0', sizeof( pxSocket->u.xTCP.xPacket.u.ucLastPacket ) );
@@ -1271,50 +1275,57 @@ UBaseType_t uxNewMSS;
 			{
 				/* Selective ACK: the peer has received a packet but it is missing earlier
 				packets.  At least this packet does not need retransmission anymore
-				ulTCPWindowTxSack( ) takes care of this administration. */
+				ulTCPWindowTxSackBlocks( ) takes care of this administration. */
 				if( pucPtr[0] == TCP_OPT_SACK_A )
 				{
+				uint32_t ulEdges[ 2 * TCP_OPT_SACK_MAX_BLOCKS ];
+				uint32_t ulCount;
+				BaseType_t xBlocks = 0;
+
 					len -= 2;
 					pucPtr += 2;
 
-					while( len >= 8 )
+					while( ( len >= 8 ) && ( xBlocks < ( BaseType_t ) TCP_OPT_SACK_MAX_BLOCKS ) )
 					{
-					uint32_t ulFirst = ulChar2u32( pucPtr );
-					uint32_t ulLast  = ulChar2u32( pucPtr + 4 );
-					uint32_t ulCount = ulTCPWindowTxSack( &pxSocket->u.xTCP.xTCPWindow, ulFirst, ulLast );
-						/* ulTCPWindowTxSack( ) returns the number of bytes which have been acked
-						starting from the head position.
-						Advance the tail pointer in txStream. */
-						if( ( pxSocket->u.xTCP.txStream  != NULL ) && ( ulCount > 0 ) )
-						{
-							/* Just advancing the tail index, 'ulCount' bytes have been confirmed. */
-							uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0, NULL, ( size_t ) ulCount, pdFALSE );
-							pxSocket->xEventBits |= eSOCKET_SEND;
+						ulEdges[ 2 * xBlocks ] = ulChar2u32( pucPtr );
+						ulEdges[ ( 2 * xBlocks ) + 1 ] = ulChar2u32( pucPtr + 4 );
+						xBlocks++;
+						pucPtr += 8;
+						len -= 8;
+					}
 
-							#if ipconfigSUPPORT_SELECT_FUNCTION == 1
+					/* ulTCPWindowTxSackBlocks( ) returns the number of bytes which have been acked
+					starting from the head position.
+					Advance the tail pointer in txStream. */
+					ulCount = ulTCPWindowTxSackBlocks( &pxSocket->u.xTCP.xTCPWindow, ulEdges, xBlocks );
+
+					if( ( pxSocket->u.xTCP.txStream  != NULL ) && ( ulCount > 0 ) )
+					{
+						/* Just advancing the tail index, 'ulCount' bytes have been confirmed. */
+						uxStreamBufferGet( pxSocket->u.xTCP.txStream, 0, NULL, ( size_t ) ulCount, pdFALSE );
+						pxSocket->xEventBits |= eSOCKET_SEND;
+
+						#if ipconfigSUPPORT_SELECT_FUNCTION == 1
+						{
+							if( pxSocket->xSelectBits & eSELECT_WRITE )
 							{
-								if( pxSocket->xSelectBits & eSELECT_WRITE )
-								{
-									/* The field 'xEventBits' is used to store regular socket events (at most 8),
-									as well as 'select events', which will be left-shifted */
-									pxSocket->xEventBits |= ( eSELECT_WRITE << SOCKET_EVENT_BIT_COUNT );
-								}
+								/* The field 'xEventBits' is used to store regular socket events (at most 8),
+								as well as 'select events', which will be left-shifted */
+								pxSocket->xEventBits |= ( eSELECT_WRITE << SOCKET_EVENT_BIT_COUNT );
 							}
-							#endif
+						}
+						#endif
 
-							/* In case the socket owner has installed an OnSent handler,
-							call it now. */
-							#if( ipconfigUSE_CALLBACKS == 1 )
+						/* In case the socket owner has installed an OnSent handler,
+						call it now. */
+						#if( ipconfigUSE_CALLBACKS == 1 )
+						{
+							if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleSent ) )
 							{
-								if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xTCP.pxHandleSent ) )
-								{
-									pxSocket->u.xTCP.pxHandleSent( (Socket_t *)pxSocket, ulCount );
-								}
+								pxSocket->u.xTCP.pxHandleSent( (Socket_t *)pxSocket, ulCount );
 							}
-							#endif /* ipconfigUSE_CALLBACKS == 1  */
 						}
-						pucPtr += 8;
-						len -= 8;
+						#endif /* ipconfigUSE_CALLBACKS == 1  */
 					}
 					/* len should be 0 by now. */
 				}
@@ -1553,9 +1564,9 @@ BaseType_t bAfter  = ( BaseType_t ) NOW_CONNECTED( eTCPState );						/* Is it co
 		{
 			/* Now the socket isn't in an active state anymore so it
 			won't need further attention of the IP-task.
-			Setting time-out to zero means that the socket won't get checked during
+			Stopping its timer means that the socket won't get checked during
 			timer events. */
-			pxSocket->u.xTCP.usTimeout = 0u;
+			vTCPSocketTimerSet( pxSocket, 0u );
 		}
 	}
 	else
@@ -1833,7 +1844,7 @@ int32_t lStreamPos;
 							pxSocket->u.xTCP.usRemotePort,
 							pxSocket->u.xTCP.ucKeepRepCount ) );
 					pxSocket->u.xTCP.bits.bSendKeepAlive = pdTRUE_UNSIGNED;
-					pxSocket->u.xTCP.usTimeout = ( ( uint16_t ) pdMS_TO_TICKS( 2500 ) );
+					vTCPSocketTimerSet( pxSocket, pdMS_TO_TICKS( 2500 ) );
 					pxSocket->u.xTCP.ucKeepRepCount++;
 				}
 			}
@@ -1896,9 +1907,9 @@ TickType_t ulDelayMs = ( TickType_t ) tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
 		FreeRTOS_debug_printf( ( "Connect[%lxip:%u]: next timeout %u: %lu ms\n",
 			pxSocket->u.xTCP.ulRemoteIP, pxSocket->u.xTCP.usRemotePort,
 			pxSocket->u.xTCP.ucRepCount, ulDelayMs ) );
-		pxSocket->u.xTCP.usTimeout = ( uint16_t )pdMS_TO_MIN_TICKS( ulDelayMs );
+		vTCPSocketTimerSet( pxSocket, pdMS_TO_MIN_TICKS( ulDelayMs ) );
 	}
-	else if( pxSocket->u.xTCP.usTimeout == 0u )
+	else if( xTCPSocketTimerRemaining( pxSocket ) == 0u )
 	{
 		/* Let the sliding window mechanism decide what time-out is appropriate. */
 		BaseType_t xResult = xTCPWindowTxHasData( &pxSocket->u.xTCP.xTCPWindow, pxSocket->u.xTCP.ulWindowSize, &ulDelayMs );
@@ -1917,16 +1928,16 @@ TickType_t ulDelayMs = ( TickType_t ) tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
 		{
 			/* ulDelayMs contains the time to wait before a re-transmission. */
 		}
-		pxSocket->u.xTCP.usTimeout = ( uint16_t )pdMS_TO_MIN_TICKS( ulDelayMs );
+		vTCPSocketTimerSet( pxSocket, pdMS_TO_MIN_TICKS( ulDelayMs ) );
 	}
 	else
 	{
-		/* field '.usTimeout' has already been set (by the
-		keep-alive/delayed-ACK mechanism). */
+		/* The timer is already running (set by the keep-alive/delayed-ACK
+		mechanism). */
 	}
 
 	/* Return the number of clock ticks before the timer expires. */
-	return ( TickType_t ) pxSocket->u.xTCP.usTimeout;
+	return xTCPSocketTimerRemaining( pxSocket );
 }
 /*-----------------------------------------------------------*/
 
@@ -2218,8 +2229,23 @@ UBaseType_t uxOptionsLength = pxTCPWindow->ucOptionLength;
 	#if(	ipconfigUSE_TCP_WIN == 1 )
 		if( uxOptionsLength != 0u )
 		{
+		UBaseType_t uxRoom = 0u;
+
 			/* TCP options must be sent because a packet which is out-of-order
-			was received. */
+			was received.  The reply is built in the buffer of that packet:
+			send as many SACK blocks as fit, but at least one, as before. */
+			if( pxNetworkBuffer->xDataLength > ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER ) )
+			{
+				uxRoom = ( UBaseType_t ) ( pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER ) );
+			}
+
+			if( uxRoom < uxOptionsLength )
+			{
+				/* 4 bytes for NOP, NOP, SACK and LEN, and 8 for every block. */
+				uxOptionsLength = ( uxRoom >= 12u ) ? ( 4u + ( 8u * ( ( uxRoom - 4u ) / 8u ) ) ) : 12u;
+				pxTCPWindow->ucOptionLength = ( uint8_t ) uxOptionsLength;
+			}
+
 			if( xTCPWindowLoggingLevel >= 0 )
 				FreeRTOS_debug_printf( ( "SACK[%d,%d]: optlen %lu sending %lu - %lu\n",
 					pxSocket->usLocalPort,
@@ -2229,6 +2255,9 @@ UBaseType_t uxOptionsLength = pxTCPWindow->ucOptionLength;
 					FreeRTOS_ntohl( pxTCPWindow->ulOptionsData[ 2 ] ) - pxSocket->u.xTCP.xTCPWindow.rx.ulFirstSequenceNumber ) );
 			memcpy( pxTCPHeader->ucOptdata, pxTCPWindow->ulOptionsData, ( size_t ) uxOptionsLength );
 
+			/* The length byte of the SACK option: 2 plus 8 bytes per block. */
+			pxTCPHeader->ucOptdata[ 3 ] = ( uint8_t ) ( uxOptionsLength - 2u );
+
 			/* The header length divided by 4, goes into the higher nibble,
 			effectively a shift-left 2. */
 			pxTCPHeader->ucTCPOffset = ( uint8_t )( ( ipSIZE_OF_TCP_HEADER + uxOptionsLength ) << 2 );
@@ -2575,14 +2604,14 @@ int32_t lRxSpace;
 			if( ( ulReceiveLength < ( uint32_t ) pxSocket->u.xTCP.usCurMSS ) ||	/* Received a small message. */
 				( lRxSpace < ( int32_t ) ( 2U * pxSocket->u.xTCP.usCurMSS ) ) )	/* There are less than 2 x MSS space in the Rx buffer. */
 			{
-				pxSocket->u.xTCP.usTimeout = ( uint16_t ) pdMS_TO_MIN_TICKS( DELAYED_ACK_SHORT_DELAY_MS );
+				vTCPSocketTimerSet( pxSocket, pdMS_TO_MIN_TICKS( DELAYED_ACK_SHORT_DELAY_MS ) );
 			}
 			else
 			{
 				/* Normally a delayed ACK should wait 200 ms for a next incoming
 				packet.  Only wait 20 ms here to gain performance.  A slow ACK
 				for full-size message. */
-				pxSocket->u.xTCP.usTimeout = ( uint16_t ) pdMS_TO_MIN_TICKS( DELAYED_ACK_LONGER_DELAY_MS );
+				vTCPSocketTimerSet( pxSocket, pdMS_TO_MIN_TICKS( DELAYED_ACK_LONGER_DELAY_MS ) );
 			}
 
 			if( ( xTCPWindowLoggingLevel > 1 ) && ( ipconfigTCP_MAY_LOG_PORT( pxSocket->usLocalPort ) != pdFALSE ) )
@@ -2593,7 +2622,7 @@ int32_t lRxSpace;
 					pxTCPWindow->rx.ulCurrentSequenceNumber - pxTCPWindow->rx.ulFirstSequenceNumber,
 					pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber - pxTCPWindow->tx.ulFirstSequenceNumber,
 					xSendLength,
-					pxSocket->u.xTCP.usTimeout, lRxSpace ) );
+					( unsigned ) xTCPSocketTimerRemaining( pxSocket ), lRxSpace ) );
 			}
 
 			*ppxNetworkBuffer = NULL;
@@ -3109,6 +3138,14 @@ BaseType_t xResult = pdPASS;
 		xResult = pdPASS;
 	}
 
+	if( pxSocket != NULL )
+	{
+		/* The packet may have caused events for the owner of the socket,
+		e.g. a RST closing it.  They are passed on before the IP-task goes to
+		sleep. */
+		vSocketWakeUpUserLater( pxSocket );
+	}
+
 	/* pdPASS being returned means the buffer has been consumed. */
 	return xResult;
 }
@@ -3181,6 +3218,7 @@ uint32_t ulInitialSequenceNumber;
 		pxReturn->u.xTCP.usRemotePort = FreeRTOS_htons( pxTCPPacket->xTCPHeader.usSourcePort );
 		pxReturn->u.xTCP.ulRemoteIP = FreeRTOS_htonl( pxTCPPacket->xIPHeader.ulSourceIPAddress );
 		pxReturn->u.xTCP.xTCPWindow.ulOurSequenceNumber = ulInitialSequenceNumber;
+		vSocketRehashTCP( pxReturn );
 
 		/* Here is the SYN action. */
 		pxReturn->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = FreeRTOS_ntohl( pxTCPPacket->xTCPHeader.ulSequenceNumber );
@@ -3215,6 +3253,12 @@ struct freertos_sockaddr xAddress;
 	pxNewSocket->u.xTCP.uxRxWinSize  = pxSocket->u.xTCP.uxRxWinSize;
 	pxNewSocket->u.xTCP.uxTxWinSize  = pxSocket->u.xTCP.uxTxWinSize;
 
+	#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	{
+		pxNewSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm = pxSocket->u.xTCP.xTCPWindow.xCongestion.ucAlgorithm;
+	}
+	#endif
+
 	#if( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
 	{
 		pxNewSocket->pxUserSemaphore = pxSocket->pxUserSemaphore;
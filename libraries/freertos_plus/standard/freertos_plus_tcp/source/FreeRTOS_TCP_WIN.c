@@ -63,15 +63,11 @@
 
 	#define xTCPWindowTxNew( pxWindow, ulSequenceNumber, lCount ) xTCPWindowNew( pxWindow, ulSequenceNumber, lCount, pdFALSE )
 
-	/* The code to send a single Selective ACK (SACK):
-	 * NOP (0x01), NOP (0x01), SACK (0x05), LEN (0x0a),
-	 * followed by a lower and a higher sequence number,
-	 * where LEN is 2 + 2*4 = 10 bytes. */
-	#if( ipconfigBYTE_ORDER == pdFREERTOS_BIG_ENDIAN )
-		#define OPTION_CODE_SINGLE_SACK		( 0x0101050aUL )
-	#else
-		#define OPTION_CODE_SINGLE_SACK		( 0x0a050101UL )
-	#endif
+	/* The code to send a Selective ACK (SACK):
+	 * NOP (0x01), NOP (0x01), SACK (0x05), LEN,
+	 * followed by a lower and a higher sequence number for each block,
+	 * where LEN is 2 + 8 bytes per block. */
+	#define OPTION_CODE_SACK( uxBlocks )	FreeRTOS_htonl( 0x01010500UL | ( 2UL + ( 8UL * ( uint32_t ) ( uxBlocks ) ) ) )
 
 	/* Normal retransmission:
 	 * A packet will be retransmitted after a Retransmit Time-Out (RTO).
@@ -88,6 +84,42 @@
 	#define MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW		( 4u )
 
 #endif /* configUSE_TCP_WIN */
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	/* The states of the congestion control: normal operation, fast recovery
+	after a fast retransmission, and recovery after a retransmission time-out.
+	In both recoveries, 'ulRecover' holds the highest sequence number that had
+	been sent when the loss was detected. */
+	#define winCC_OPEN						( 0u )
+	#define winCC_RECOVERY					( 1u )
+	#define winCC_LOSS						( 2u )
+
+	/* As long as ssthresh has not been determined, it is arbitrarily high. */
+	#define winCC_SSTHRESH_INFINITE			( 0xffffffffUL )
+
+	/* RFC 3390: the initial window is min( 4 * MSS, max( 2 * MSS, 4380 ) ). */
+	#define winCC_INITIAL_WINDOW_BYTES		( 4380UL )
+
+	/* RFC 3465: during slow start, a single ACK may grow the cwnd with at
+	most this number of segments. */
+	#define winCC_SLOW_START_LIMIT			( 2UL )
+
+	/* CUBIC: the multiplicative decrease factor beta = 0.7, the scaling
+	constant C = 0.4 and the longest time distance to the plateau taken into
+	account, which keeps the cube within 64 bits. */
+	#define winCUBIC_BETA_NUMERATOR			( 7UL )
+	#define winCUBIC_BETA_DENOMINATOR		( 10UL )
+	#define winCUBIC_C_NUMERATOR			( 2ULL )
+	#define winCUBIC_C_DENOMINATOR			( 5ULL )
+	#define winCUBIC_MAX_DISTANCE_MS		( 1000000UL )
+
+	/* CUBIC: 3 * ( 1 - beta ) / ( 1 + beta ), the additive increase of a Reno
+	flow that shrinks with the same factor beta. */
+	#define winCUBIC_FRIENDLY_NUMERATOR		( 9ULL )
+	#define winCUBIC_FRIENDLY_DENOMINATOR	( 17ULL )
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 /*-----------------------------------------------------------*/
 
 extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem, MiniListItem_t * const pxWhere );
@@ -105,11 +137,31 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
- * Find a segment with a given sequence number in the list of received
- * segments: 'pxWindow->xRxSegments'.
+ * Out-of-order data is stored as disjoint blocks in 'pxWindow->xRxSegments'.
+ * Add the range 'ulFirst' up to 'ulLast' to the blocks, merging it with the
+ * blocks that it overlaps or touches.  The resulting block is moved to the end
+ * of the list, which keeps the most recently received block last.
+ * '*pxIsStored' is set when the range had been stored already.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static TCPSegment_t *xTCPWindowRxMerge( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast, BaseType_t *pxIsStored );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * The data up to 'ulCurrentSequenceNumber' has arrived.  Free the blocks of
+ * out-of-order data that have become contiguous with it and return the new
+ * RCV.NXT.
  */
 #if( ipconfigUSE_TCP_WIN == 1 )
-	static TCPSegment_t *xTCPWindowRxFind( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
+	static uint32_t ulTCPWindowRxAbsorb( TCPWindow_t *pxWindow, uint32_t ulCurrentSequenceNumber );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Prepare a SACK option that describes the blocks of out-of-order data, the
+ * most recently received block first (RFC 2018).
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static void prvTCPWindowRxSack( TCPWindow_t *pxWindow );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
@@ -153,18 +205,6 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 	static void vTCPWindowFree( TCPSegment_t *pxSegment );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
-/*
- * A segment has been received with sequence number 'ulSequenceNumber', where
- * 'ulCurrentSequenceNumber == ulSequenceNumber', which means that exactly this
- * segment was expected.  xTCPWindowRxConfirm() will check if there is already
- * another segment with a sequence number between (ulSequenceNumber) and
- * (ulSequenceNumber+xLength).  Normally none will be found, because the next Rx
- * segment should have a sequence number equal to '(ulSequenceNumber+xLength)'.
- */
-#if( ipconfigUSE_TCP_WIN == 1 )
-	static TCPSegment_t *xTCPWindowRxConfirm( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, uint32_t ulLength );
-#endif /* ipconfigUSE_TCP_WIN == 1 */
-
 /*
  * FreeRTOS+TCP stores data in circular buffers.  Calculate the next position to
  * store.
@@ -190,13 +230,44 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
- * A higher Tx block has been acknowledged.  Now iterate through the xWaitQueue
- * to find a possible condition for a FAST retransmission.
+ * Higher Tx blocks have been acknowledged, the highest one starting at
+ * 'ulFirst'.  Now iterate through the xWaitQueue to find a possible condition
+ * for a FAST retransmission.
  */
 #if( ipconfigUSE_TCP_WIN == 1 )
 	static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t *pxWindow, uint32_t ulFirst );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+/*
+ * Congestion control.  The generic part takes care of the initial window,
+ * slow start, fast recovery (RFC 6582) and time-outs (RFC 5681).  An algorithm
+ * only decides about the new ssthresh after a loss, and about the growth of the
+ * cwnd during congestion avoidance.
+ */
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	typedef struct xTCP_CONGESTION_OPS
+	{
+		uint32_t ( *pxSSThresh )( TCPWindow_t *pxWindow );
+		void ( *pxCongestionAvoidance )( TCPWindow_t *pxWindow, uint32_t ulBytesAcked );
+	} TCPCongestionOps_t;
+
+	static void prvTCPCongestionInit( TCPWindow_t *pxWindow );
+	static void prvTCPCongestionAck( TCPWindow_t *pxWindow, uint32_t ulBytesAcked );
+	static void prvTCPCongestionFastRetransmit( TCPWindow_t *pxWindow );
+	static void prvTCPCongestionTimeout( TCPWindow_t *pxWindow, TCPSegment_t *pxSegment );
+	static uint32_t prvTCPCongestionInFlight( TCPWindow_t *pxWindow );
+	static void prvTCPCongestionPartialAck( TCPWindow_t *pxWindow );
+	static const TCPCongestionOps_t *prvTCPCongestionOps( const TCPWindow_t *pxWindow );
+	static uint32_t prvNewRenoSSThresh( TCPWindow_t *pxWindow );
+	static void prvNewRenoCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulBytesAcked );
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+	static uint32_t prvCubicSSThresh( TCPWindow_t *pxWindow );
+	static void prvCubicCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulBytesAcked );
+	static uint32_t prvCubeRoot( uint64_t ullValue );
+#endif /* ipconfigUSE_TCP_CUBIC */
+
 /*-----------------------------------------------------------*/
 
 /* TCP segment pool. */
@@ -212,6 +283,22 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 /* Logging verbosity level. */
 BaseType_t xTCPWindowLoggingLevel = 0;
 
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static const TCPCongestionOps_t xNewRenoOps =
+	{
+		prvNewRenoSSThresh,
+		prvNewRenoCongestionAvoidance
+	};
+#endif
+
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+	static const TCPCongestionOps_t xCubicOps =
+	{
+		prvCubicSSThresh,
+		prvCubicCongestionAvoidance
+	};
+#endif
+
 #if( ipconfigUSE_TCP_WIN == 1 )
 	/* Some 32-bit arithmetic: comparing sequence numbers */
 	static portINLINE BaseType_t xSequenceLessThanOrEqual( uint32_t a, uint32_t b );
@@ -343,30 +430,76 @@ void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem
 
 #if( ipconfigUSE_TCP_WIN == 1 )
 
-	static TCPSegment_t *xTCPWindowRxFind( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber )
+	static TCPSegment_t *xTCPWindowRxMerge( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast, BaseType_t *pxIsStored )
 	{
 	const ListItem_t *pxIterator;
 	const MiniListItem_t* pxEnd;
 	TCPSegment_t *pxSegment, *pxReturn = NULL;
+	uint32_t ulSegmentLast;
 
-		/* Find a segment with a given sequence number in the list of received
-		segments. */
-
+		*pxIsStored = pdFALSE;
 		pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( &pxWindow->xRxSegments );
 
+		/* The blocks are disjoint and never touch each other.  So a block that
+		touches the new range can not make another block touch it: one pass is
+		enough. */
 		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( const ListItem_t * ) pxEnd;
-			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+			 pxIterator != ( const ListItem_t * ) pxEnd; )
 		{
 			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-			if( pxSegment->ulSequenceNumber == ulSequenceNumber )
+			/* Hop to the next item before the current gets unlinked. */
+			pxIterator = ( const ListItem_t * ) listGET_NEXT( pxIterator );
+
+			ulSegmentLast = pxSegment->ulSequenceNumber + ( uint32_t ) pxSegment->lDataLength;
+
+			if( ( xSequenceLessThanOrEqual( pxSegment->ulSequenceNumber, ulLast ) != pdFALSE ) &&
+				( xSequenceGreaterThanOrEqual( ulSegmentLast, ulFirst ) != pdFALSE ) )
 			{
-				pxReturn = pxSegment;
-				break;
+				if( ( xSequenceLessThanOrEqual( pxSegment->ulSequenceNumber, ulFirst ) != pdFALSE ) &&
+					( xSequenceGreaterThanOrEqual( ulSegmentLast, ulLast ) != pdFALSE ) )
+				{
+					/* The peer has sent this data before. */
+					*pxIsStored = pdTRUE;
+				}
+
+				if( xSequenceLessThan( pxSegment->ulSequenceNumber, ulFirst ) != pdFALSE )
+				{
+					ulFirst = pxSegment->ulSequenceNumber;
+				}
+
+				if( xSequenceGreaterThan( ulSegmentLast, ulLast ) != pdFALSE )
+				{
+					ulLast = ulSegmentLast;
+				}
+
+				if( pxReturn == NULL )
+				{
+					/* Re-use the first block found for the merged range. */
+					pxReturn = pxSegment;
+				}
+				else
+				{
+					vTCPWindowFree( pxSegment );
+				}
 			}
 		}
 
+		if( pxReturn == NULL )
+		{
+			pxReturn = xTCPWindowRxNew( pxWindow, ulFirst, ( int32_t ) ( ulLast - ulFirst ) );
+		}
+		else
+		{
+			pxReturn->ulSequenceNumber = ulFirst;
+			pxReturn->lDataLength = ( int32_t ) ( ulLast - ulFirst );
+			pxReturn->lMaxLength = pxReturn->lDataLength;
+
+			/* Move it to the end of the list. */
+			uxListRemove( &( pxReturn->xListItem ) );
+			vListInsertFifo( &( pxWindow->xRxSegments ), &( pxReturn->xListItem ) );
+		}
+
 		return pxReturn;
 	}
 
@@ -670,6 +803,12 @@ const int32_t l500ms = 500;
 	/* The right-hand side of the transmit window. */
 	pxWindow->tx.ulHighestSequenceNumber = ulSequenceNumber;
 	pxWindow->ulOurSequenceNumber = ulSequenceNumber;
+
+	#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	{
+		prvTCPCongestionInit( pxWindow );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -707,57 +846,81 @@ const int32_t l500ms = 500;
 
 #if( ipconfigUSE_TCP_WIN == 1 )
 
-	static TCPSegment_t *xTCPWindowRxConfirm( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, uint32_t ulLength )
+	static uint32_t ulTCPWindowRxAbsorb( TCPWindow_t *pxWindow, uint32_t ulCurrentSequenceNumber )
 	{
-	TCPSegment_t *pxBest = NULL;
 	const ListItem_t *pxIterator;
-	uint32_t ulNextSequenceNumber = ulSequenceNumber + ulLength;
 	const MiniListItem_t* pxEnd = ( const MiniListItem_t* ) listGET_END_MARKER( &pxWindow->xRxSegments );
 	TCPSegment_t *pxSegment;
+	uint32_t ulSegmentLast;
 
-		/* A segment has been received with sequence number 'ulSequenceNumber',
-		where 'ulCurrentSequenceNumber == ulSequenceNumber', which means that
-		exactly this segment was expected.  xTCPWindowRxConfirm() will check if
-		there is already another segment with a sequence number between (ulSequenceNumber)
-		and (ulSequenceNumber+ulLength).  Normally none will be found, because
-		the next RX segment should have a sequence number equal to
-		'(ulSequenceNumber+ulLength)'. */
-
-		/* Iterate through all RX segments that are stored: */
+		/* The data of a block has been stored in the reception stream when it
+		arrived.  A block that starts at or below RCV.NXT is no longer out of
+		order: its data may be passed to the user.  As the blocks never touch,
+		absorbing one block can not make another one contiguous, but the peer
+		may have sent a segment that covers several blocks at once. */
 		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( const ListItem_t * ) pxEnd;
-			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+			 pxIterator != ( const ListItem_t * ) pxEnd; )
 		{
 			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
-			/* And see if there is a segment for which:
-			'ulSequenceNumber' <= 'pxSegment->ulSequenceNumber' < 'ulNextSequenceNumber'
-			If there are more matching segments, the one with the lowest sequence number
-			shall be taken */
-			if( ( xSequenceGreaterThanOrEqual( pxSegment->ulSequenceNumber, ulSequenceNumber ) != 0 ) &&
-				( xSequenceLessThan( pxSegment->ulSequenceNumber, ulNextSequenceNumber ) != 0 ) )
+
+			/* Hop to the next item before the current gets unlinked. */
+			pxIterator = ( const ListItem_t * ) listGET_NEXT( pxIterator );
+
+			if( xSequenceLessThanOrEqual( pxSegment->ulSequenceNumber, ulCurrentSequenceNumber ) != pdFALSE )
 			{
-				if( ( pxBest == NULL ) || ( xSequenceLessThan( pxSegment->ulSequenceNumber, pxBest->ulSequenceNumber ) != 0 ) )
+				ulSegmentLast = pxSegment->ulSequenceNumber + ( uint32_t ) pxSegment->lDataLength;
+
+				if( xSequenceGreaterThan( ulSegmentLast, ulCurrentSequenceNumber ) != pdFALSE )
 				{
-					pxBest = pxSegment;
+					ulCurrentSequenceNumber = ulSegmentLast;
 				}
+
+				vTCPWindowFree( pxSegment );
 			}
 		}
 
-		if( ( pxBest != NULL ) &&
-			( ( pxBest->ulSequenceNumber != ulSequenceNumber ) || ( pxBest->lDataLength != ( int32_t ) ulLength ) ) )
+		return ulCurrentSequenceNumber;
+	}
+
+#endif /* ipconfgiUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static void prvTCPWindowRxSack( TCPWindow_t *pxWindow )
+	{
+	const ListItem_t *pxIterator;
+	const MiniListItem_t* pxEnd = ( const MiniListItem_t* ) listGET_END_MARKER( &pxWindow->xRxSegments );
+	TCPSegment_t *pxSegment;
+	UBaseType_t uxBlocks = 0u;
+
+		/* Walk back from the end of the list: the most recently received
+		block comes first, and the other blocks are repeated so that the peer
+		learns about them even when some ACK's get lost. */
+		for( pxIterator  = ( const ListItem_t * ) pxEnd->pxPrevious;
+			 ( pxIterator != ( const ListItem_t * ) pxEnd ) && ( uxBlocks < ( UBaseType_t ) ipconfigTCP_SACK_BLOCKS );
+			 pxIterator  = ( const ListItem_t * ) pxIterator->pxPrevious )
 		{
-			FreeRTOS_flush_logging();
-			FreeRTOS_debug_printf( ( "xTCPWindowRxConfirm[%u]: search %lu (+%ld=%lu) found %lu (+%ld=%lu)\n",
-				pxWindow->usPeerPortNumber,
-				ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-				ulLength,
-				ulSequenceNumber + ulLength - pxWindow->rx.ulFirstSequenceNumber,
-				pxBest->ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-				pxBest->lDataLength,
-				pxBest->ulSequenceNumber + ( ( uint32_t ) pxBest->lDataLength ) - pxWindow->rx.ulFirstSequenceNumber ) );
+			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			/* First sequence number that we received, and last + 1. */
+			pxWindow->ulOptionsData[ 1u + ( 2u * uxBlocks ) ] = FreeRTOS_htonl( pxSegment->ulSequenceNumber );
+			pxWindow->ulOptionsData[ 2u + ( 2u * uxBlocks ) ] = FreeRTOS_htonl( pxSegment->ulSequenceNumber + ( uint32_t ) pxSegment->lDataLength );
+			uxBlocks++;
+		}
+
+		if( uxBlocks == 0u )
+		{
+			pxWindow->ucOptionLength = 0u;
 		}
+		else
+		{
+			/* Code OPTION_CODE_SACK is already in network byte order. */
+			pxWindow->ulOptionsData[ 0 ] = OPTION_CODE_SACK( uxBlocks );
 
-		return pxBest;
+			/* Which makes 4 option bytes, plus 8 for every block. */
+			pxWindow->ucOptionLength = ( uint8_t ) ( ( 1u + ( 2u * uxBlocks ) ) * sizeof( pxWindow->ulOptionsData[ 0 ] ) );
+		}
 	}
 
 #endif /* ipconfgiUSE_TCP_WIN == 1 */
@@ -770,6 +933,7 @@ const int32_t l500ms = 500;
 	uint32_t ulCurrentSequenceNumber, ulLast, ulSavedSequenceNumber;
 	int32_t lReturn, lDistance;
 	TCPSegment_t *pxFound;
+	BaseType_t xIsStored;
 
 		/* If lTCPWindowRxCheck( ) returns == 0, the packet will be passed
 		directly to user (segment is expected).  If it returns a positive
@@ -805,31 +969,12 @@ const int32_t l500ms = 500;
 				{
 					ulSavedSequenceNumber = ulCurrentSequenceNumber;
 
-                    /* Clean up all sequence received between ulSequenceNumber and ulSequenceNumber + ulLength since they are duplicated.
-                    If the server is forced to retransmit packets several time in a row it might send a batch of concatenated packet for speed.
-                    So we cannot rely on the packets between ulSequenceNumber and ulSequenceNumber + ulLength to be sequential and it is better to just
-                    clean them out. */
-                    do
-                    {
-                        pxFound = xTCPWindowRxConfirm( pxWindow, ulSequenceNumber, ulLength );
-
-                        if ( pxFound != NULL )
-                        {
-                            /* Remove it because it will be passed to user directly. */
-                            vTCPWindowFree( pxFound );
-                        }
-                    } while ( pxFound );
-
-					/*  Check for following segments that are already in the
-					queue and increment ulCurrentSequenceNumber. */
-					while( ( pxFound = xTCPWindowRxFind( pxWindow, ulCurrentSequenceNumber ) ) != NULL )
-					{
-						ulCurrentSequenceNumber += ( uint32_t ) pxFound->lDataLength;
-
-						/* As all packet below this one have been passed to the
-						user it can be discarded. */
-						vTCPWindowFree( pxFound );
-					}
+					/* Check for blocks of data that are already in the queue
+					and increment ulCurrentSequenceNumber.  If the peer was
+					forced to retransmit several times in a row, it may have
+					sent a batch of concatenated packets, which overlaps
+					stored blocks: these are cleaned up as well. */
+					ulCurrentSequenceNumber = ulTCPWindowRxAbsorb( pxWindow, ulCurrentSequenceNumber );
 
 					if( ulSavedSequenceNumber != ulCurrentSequenceNumber )
 					{
@@ -847,6 +992,10 @@ const int32_t l500ms = 500;
 								listCURRENT_LIST_LENGTH( &pxWindow->xRxSegments ) ) );
 						}
 					}
+
+					/* A hole has been filled, but there may be more.  Keep on
+					reporting the blocks that are still out of order. */
+					prvTCPWindowRxSack( pxWindow );
 				}
 
 				pxWindow->rx.ulCurrentSequenceNumber = ulCurrentSequenceNumber;
@@ -879,6 +1028,13 @@ const int32_t l500ms = 500;
 				Selective ACK (SACK). */
 				lReturn = -1;
 			}
+			else if( xSequenceLessThan( ulSequenceNumber, ulCurrentSequenceNumber ) != pdFALSE )
+			{
+				/* The segment overlaps with data that was accepted already.
+				It can not be stored at a positive offset, the missing part will
+				be sent again. */
+				lReturn = -1;
+			}
 			else if( lDistance > ( int32_t ) ulSpace )
 			{
 				/* The new segment is ahead of rx.ulCurrentSequenceNumber.  The
@@ -888,62 +1044,44 @@ const int32_t l500ms = 500;
 			}
 			else
 			{
-				/* See if there is more data in a contiguous block to make the
-				SACK describe a longer range of data. */
+				/* Store the range of this segment, merged with the adjacent
+				blocks.  This makes the SACK describe a longer range of data,
+				and saves segment descriptors.
 
-				/* TODO: SACK's may also be delayed for a short period
+				TODO: SACK's may also be delayed for a short period
 				 * This is useful because subsequent packets will be SACK'd with
 				 * single one message
 				 */
-				while( ( pxFound = xTCPWindowRxFind( pxWindow, ulLast ) ) != NULL )
-				{
-					ulLast += ( uint32_t ) pxFound->lDataLength;
-				}
+				pxFound = xTCPWindowRxMerge( pxWindow, ulSequenceNumber, ulLast, &xIsStored );
 
-				if( xTCPWindowLoggingLevel >= 1 )
+				if( pxFound == NULL )
 				{
-					FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%d,%d]: seqnr %lu exp %lu (dist %ld) SACK to %lu\n",
-						pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
-						ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-						ulCurrentSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-						( BaseType_t ) ( ulSequenceNumber - ulCurrentSequenceNumber ),	/* want this signed */
-						ulLast - pxWindow->rx.ulFirstSequenceNumber ) );
-				}
-
-				/* Now prepare the SACK message.
-				Code OPTION_CODE_SINGLE_SACK already in network byte order. */
-				pxWindow->ulOptionsData[0] = OPTION_CODE_SINGLE_SACK;
-
-				/* First sequence number that we received. */
-				pxWindow->ulOptionsData[1] = FreeRTOS_htonl( ulSequenceNumber );
-
-				/* Last + 1 */
-				pxWindow->ulOptionsData[2] = FreeRTOS_htonl( ulLast );
-
-				/* Which make 12 (3*4) option bytes. */
-				pxWindow->ucOptionLength = 3 * sizeof( pxWindow->ulOptionsData[ 0 ] );
-
-				pxFound = xTCPWindowRxFind( pxWindow, ulSequenceNumber );
-
-				if( pxFound != NULL )
-				{
-					/* This out-of-sequence packet has been received for a
-					second time.  It is already stored but do send a SACK
-					again. */
+					/* Can not send a SACK, because the segment cannot be
+					stored.  Needs to be stored but there is no segment
+					available. */
 					lReturn = -1;
 				}
 				else
 				{
-					pxFound = xTCPWindowRxNew( pxWindow, ulSequenceNumber, ( int32_t ) ulLength );
-
-					if( pxFound == NULL )
+					if( xTCPWindowLoggingLevel >= 1 )
 					{
-						/* Can not send a SACK, because the segment cannot be
-						stored. */
-						pxWindow->ucOptionLength = 0u;
+						FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%d,%d]: seqnr %lu exp %lu (dist %ld) SACK to %lu\n",
+							pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
+							ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
+							ulCurrentSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
+							( BaseType_t ) ( ulSequenceNumber - ulCurrentSequenceNumber ),	/* want this signed */
+							pxFound->ulSequenceNumber + ( uint32_t ) pxFound->lDataLength - pxWindow->rx.ulFirstSequenceNumber ) );
+					}
 
-						/* Needs to be stored but there is no segment
-						available. */
+					/* Now prepare the SACK message, the block that contains
+					this segment comes first. */
+					prvTCPWindowRxSack( pxWindow );
+
+					if( xIsStored != pdFALSE )
+					{
+						/* This out-of-sequence packet has been received for a
+						second time.  It is already stored but do send a SACK
+						again. */
 						lReturn = -1;
 					}
 					else
@@ -1187,6 +1325,20 @@ const int32_t l500ms = 500;
 			{
 				xHasSpace = pdFALSE;
 			}
+
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			{
+			uint32_t ulInFlight = prvTCPCongestionInFlight( pxWindow );
+
+				/* The congestion window limits the data in flight.  Segments
+				which the peer has confirmed with a SACK have left the network
+				and are not counted. */
+				if( ( ulInFlight != 0UL ) && ( pxWindow->xCongestion.ulCWnd < ulInFlight + ( ( uint32_t ) pxSegment->lDataLength ) ) )
+				{
+					xHasSpace = pdFALSE;
+				}
+			}
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 		}
 
 		return xHasSpace;
@@ -1306,6 +1458,12 @@ const int32_t l500ms = 500;
 					pxSegment = xTCPWindowGetHead( &( pxWindow->xWaitQueue ) );
 					pxSegment->u.bits.ucDupAckCount = pdFALSE_UNSIGNED;
 
+					#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+					{
+						prvTCPCongestionTimeout( pxWindow, pxSegment );
+					}
+					#endif
+
 					/* Some detailed logging. */
 					if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != 0 ) )
 					{
@@ -1409,7 +1567,9 @@ const int32_t l500ms = 500;
 			( pxSegment->u.bits.ucTransmitCount )++;
 
 			/* If there have been several retransmissions (4), decrease the
-			size of the transmission window to at most 2 times MSS. */
+			size of the transmission window to at most 2 times MSS.  When
+			congestion control is used, the cwnd has already been reduced. */
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL == 0 )
 			if( pxSegment->u.bits.ucTransmitCount == MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW )
 			{
 				if( pxWindow->xSize.ulTxWindowLength > ( 2U * pxWindow->usMSS ) )
@@ -1420,6 +1580,7 @@ const int32_t l500ms = 500;
 					pxWindow->xSize.ulTxWindowLength = ( 2UL * pxWindow->usMSS );
 				}
 			}
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL == 0 */
 
 			/* Clear the transmit timer. */
 			vTCPTimerSet( &( pxSegment->xTransmitTimer ) );
@@ -1572,6 +1733,16 @@ const int32_t l500ms = 500;
 				/* All segments below tx.ulCurrentSequenceNumber may be freed. */
 				vTCPWindowFree( pxSegment );
 
+				#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+				{
+					if( xDoUnlink == pdFALSE )
+					{
+						/* The segment had been confirmed earlier by a SACK. */
+						pxWindow->xCongestion.ulSackedBytes -= FreeRTOS_min_uint32( pxWindow->xCongestion.ulSackedBytes, ulDataLength );
+					}
+				}
+				#endif
+
 				/* No need to unlink it any more. */
 				xDoUnlink = pdFALSE;
 			}
@@ -1582,9 +1753,29 @@ const int32_t l500ms = 500;
 				uxListRemove( &pxSegment->xQueueItem );
 			}
 
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			{
+				if( xDoUnlink != pdFALSE )
+				{
+					/* Selectively ACK'd: it has left the network but it can not
+					be freed before the segments in front of it. */
+					pxWindow->xCongestion.ulSackedBytes += ulDataLength;
+				}
+			}
+			#endif
+
 			ulSequenceNumber += ulDataLength;
 		}
 
+		#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		{
+			if( ulBytesConfirmed != 0UL )
+			{
+				prvTCPCongestionAck( pxWindow, ulBytesConfirmed );
+			}
+		}
+		#endif
+
 		return ulBytesConfirmed;
 	}
 #endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -1619,12 +1810,14 @@ const int32_t l500ms = 500;
 			It will be retransmitted far before the RTO. */
 			if( ( pxSegment->u.bits.bAcked == pdFALSE_UNSIGNED ) &&
 				( xSequenceLessThan( pxSegment->ulSequenceNumber, ulFirst ) != pdFALSE ) &&
+				( pxSegment->u.bits.ucDupAckCount < DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT ) &&
 				( ++( pxSegment->u.bits.ucDupAckCount ) == DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT ) )
 			{
 				pxSegment->u.bits.ucTransmitCount = pdFALSE_UNSIGNED;
 
-				/* Not clearing 'ucDupAckCount' yet as more SACK's might come in
-				which might lead to a second fast rexmit. */
+				/* Not clearing 'ucDupAckCount': a segment is only fast
+				retransmitted once.  If the retransmission gets lost as well,
+				the retransmission time-out will clear it. */
 				if( ( xTCPWindowLoggingLevel >= 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
 				{
 					FreeRTOS_debug_printf( ( "prvTCPWindowFastRetransmit: Requeue sequence number %lu < %lu\n",
@@ -1675,24 +1868,58 @@ const int32_t l500ms = 500;
 
 #if( ipconfigUSE_TCP_WIN == 1 )
 
-	uint32_t ulTCPWindowTxSack( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast )
+	uint32_t ulTCPWindowTxSackBlocks( TCPWindow_t *pxWindow, const uint32_t *pulEdges, BaseType_t xCount )
 	{
 	uint32_t ulAckCount = 0UL;
 	uint32_t ulCurrentSequenceNumber = pxWindow->tx.ulCurrentSequenceNumber;
+	uint32_t ulFirst, ulLast, ulHighestFirst;
+	BaseType_t xIndex;
 
-		/* Receive a SACK option. */
-		ulAckCount = prvTCPWindowTxCheckAck( pxWindow, ulFirst, ulLast );
-		prvTCPWindowFastRetransmit( pxWindow, ulFirst );
+		/* Receive a SACK option.  First register all blocks, so that none of
+		the segments that the peer has received will be retransmitted. */
+		ulHighestFirst = ulCurrentSequenceNumber;
 
-		if( ( xTCPWindowLoggingLevel >= 1 ) && ( xSequenceGreaterThan( ulFirst, ulCurrentSequenceNumber ) != pdFALSE ) )
+		for( xIndex = 0; xIndex < xCount; xIndex++ )
 		{
-			FreeRTOS_debug_printf( ( "ulTCPWindowTxSack[%u,%u]: from %lu to %lu (ack = %lu)\n",
-				pxWindow->usPeerPortNumber,
-				pxWindow->usOurPortNumber,
-				ulFirst - pxWindow->tx.ulFirstSequenceNumber,
-				ulLast - pxWindow->tx.ulFirstSequenceNumber,
-				pxWindow->tx.ulCurrentSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) );
-			FreeRTOS_flush_logging( );
+			ulFirst = pulEdges[ 2 * xIndex ];
+			ulLast = pulEdges[ ( 2 * xIndex ) + 1 ];
+
+			ulAckCount += prvTCPWindowTxCheckAck( pxWindow, ulFirst, ulLast );
+
+			if( xSequenceGreaterThan( ulFirst, ulHighestFirst ) != pdFALSE )
+			{
+				ulHighestFirst = ulFirst;
+			}
+
+			if( ( xTCPWindowLoggingLevel >= 1 ) && ( xSequenceGreaterThan( ulFirst, ulCurrentSequenceNumber ) != pdFALSE ) )
+			{
+				FreeRTOS_debug_printf( ( "ulTCPWindowTxSack[%u,%u]: from %lu to %lu (ack = %lu)\n",
+					pxWindow->usPeerPortNumber,
+					pxWindow->usOurPortNumber,
+					ulFirst - pxWindow->tx.ulFirstSequenceNumber,
+					ulLast - pxWindow->tx.ulFirstSequenceNumber,
+					pxWindow->tx.ulCurrentSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) );
+				FreeRTOS_flush_logging( );
+			}
+		}
+
+		/* Then look for the holes, once per received ACK: all segments below
+		the highest block that are still missing, also the ones between the
+		blocks. */
+		if( xCount > 0 )
+		{
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			{
+				if( prvTCPWindowFastRetransmit( pxWindow, ulHighestFirst ) != 0UL )
+				{
+					prvTCPCongestionFastRetransmit( pxWindow );
+				}
+			}
+			#else
+			{
+				prvTCPWindowFastRetransmit( pxWindow, ulHighestFirst );
+			}
+			#endif
 		}
 
 		return ulAckCount;
@@ -1701,6 +1928,482 @@ const int32_t l500ms = 500;
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	uint32_t ulTCPWindowTxSack( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast )
+	{
+	uint32_t ulEdges[ 2 ];
+
+		ulEdges[ 0 ] = ulFirst;
+		ulEdges[ 1 ] = ulLast;
+
+		return ulTCPWindowTxSackBlocks( pxWindow, ulEdges, 1 );
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static const TCPCongestionOps_t *prvTCPCongestionOps( const TCPWindow_t *pxWindow )
+	{
+	const TCPCongestionOps_t *pxOps = &xNewRenoOps;
+
+		#if( ipconfigUSE_TCP_CUBIC != 0 )
+		{
+			if( pxWindow->xCongestion.ucAlgorithm == ( uint8_t ) FREERTOS_TCP_CC_CUBIC )
+			{
+				pxOps = &xCubicOps;
+			}
+		}
+		#else
+		{
+			( void ) pxWindow;
+		}
+		#endif /* ipconfigUSE_TCP_CUBIC */
+
+		return pxOps;
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	BaseType_t xTCPWindowCongestionSelect( TCPWindow_t *pxWindow, BaseType_t xAlgorithm )
+	{
+	BaseType_t xReturn;
+
+		switch( xAlgorithm )
+		{
+			case FREERTOS_TCP_CC_NEWRENO:
+		#if( ipconfigUSE_TCP_CUBIC != 0 )
+			case FREERTOS_TCP_CC_CUBIC:
+		#endif
+				/* The new algorithm takes over the current cwnd and ssthresh. */
+				pxWindow->xCongestion.ucAlgorithm = ( uint8_t ) xAlgorithm;
+				pxWindow->xCongestion.ulBytesAcked = 0UL;
+				#if( ipconfigUSE_TCP_CUBIC != 0 )
+				{
+					pxWindow->xCongestion.bEpochStarted = pdFALSE_UNSIGNED;
+				}
+				#endif
+				xReturn = pdTRUE;
+				break;
+
+			default:
+				/* Unknown, or not included in this build. */
+				xReturn = pdFALSE;
+				break;
+		}
+
+		return xReturn;
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPCongestionInit( TCPWindow_t *pxWindow )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+
+		/* The algorithm is not changed here: it was chosen when the socket
+		was created, or with FREERTOS_SO_TCP_CONGESTION. */
+		pxCC->ulCWnd = FreeRTOS_min_uint32( 4UL * ulMSS, FreeRTOS_max_uint32( 2UL * ulMSS, winCC_INITIAL_WINDOW_BYTES ) );
+		pxCC->ulSSThresh = winCC_SSTHRESH_INFINITE;
+		pxCC->ulBytesAcked = 0UL;
+		pxCC->ulSackedBytes = 0UL;
+		pxCC->ucState = winCC_OPEN;
+
+		#if( ipconfigUSE_TCP_CUBIC != 0 )
+		{
+			pxCC->bEpochStarted = pdFALSE_UNSIGNED;
+			pxCC->ulWMax = 0UL;
+		}
+		#endif
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static uint32_t prvTCPCongestionInFlight( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulOutstanding = 0UL;
+
+		/* The number of bytes sent but not yet acknowledged, not counting the
+		segments which were received by the peer according to a SACK. */
+		if( xSequenceGreaterThan( pxWindow->tx.ulHighestSequenceNumber, pxWindow->tx.ulCurrentSequenceNumber ) != pdFALSE )
+		{
+			ulOutstanding = pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber;
+		}
+
+		return ulOutstanding - FreeRTOS_min_uint32( ulOutstanding, pxWindow->xCongestion.ulSackedBytes );
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPCongestionPartialAck( TCPWindow_t *pxWindow )
+	{
+	TCPSegment_t *pxSegment = xTCPWindowPeekHead( &( pxWindow->xTxSegments ) );
+
+		/* During a fast recovery, an ACK advanced SND.UNA without covering all
+		data sent before the loss.  The segment now at SND.UNA is lost as well.
+		Unless it has been retransmitted since the recovery started, send it
+		again without waiting for more SACK's (RFC 6582). */
+		if( ( pxSegment != NULL ) &&
+			( pxSegment->u.bits.bAcked == pdFALSE_UNSIGNED ) &&
+			( listLIST_ITEM_CONTAINER( &( pxSegment->xQueueItem ) ) == ( void * ) &( pxWindow->xWaitQueue ) ) &&
+			( ulTimerGetAge( &( pxSegment->xTransmitTimer ) ) > ulTimerGetAge( &( pxWindow->xCongestion.xRecoveryTimer ) ) ) )
+		{
+			if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+			{
+				FreeRTOS_debug_printf( ( "prvTCPCongestionPartialAck: Requeue sequence number %lu\n",
+					pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) );
+			}
+
+			pxSegment->u.bits.ucTransmitCount = pdFALSE_UNSIGNED;
+			uxListRemove( &( pxSegment->xQueueItem ) );
+			vListInsertFifo( &( pxWindow->xPriorityQueue ), &( pxSegment->xQueueItem ) );
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPCongestionAck( TCPWindow_t *pxWindow, uint32_t ulBytesAcked )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+	BaseType_t xGrow = pdTRUE;
+
+		/* SND.UNA has advanced by 'ulBytesAcked' bytes. */
+		if( pxCC->ucState != winCC_OPEN )
+		{
+			if( xSequenceGreaterThanOrEqual( pxWindow->tx.ulCurrentSequenceNumber, pxCC->ulRecover ) != pdFALSE )
+			{
+				/* All data that was outstanding when the loss was detected has
+				been acknowledged: the recovery is complete. */
+				if( pxCC->ucState == winCC_RECOVERY )
+				{
+					/* Do not allow a burst of new data (RFC 6582). */
+					pxCC->ulCWnd = FreeRTOS_min_uint32( pxCC->ulSSThresh, prvTCPCongestionInFlight( pxWindow ) + ulMSS );
+					xGrow = pdFALSE;
+				}
+
+				pxCC->ucState = winCC_OPEN;
+			}
+			else if( pxCC->ucState == winCC_RECOVERY )
+			{
+				prvTCPCongestionPartialAck( pxWindow );
+				xGrow = pdFALSE;
+			}
+			else
+			{
+				/* After a time-out, the cwnd grows in slow start. */
+			}
+		}
+
+		if( xGrow != pdFALSE )
+		{
+			if( pxCC->ulCWnd < pxCC->ulSSThresh )
+			{
+				/* Slow start with Appropriate Byte Counting (RFC 3465). */
+				pxCC->ulCWnd += FreeRTOS_min_uint32( ulBytesAcked, winCC_SLOW_START_LIMIT * ulMSS );
+			}
+			else
+			{
+				prvTCPCongestionOps( pxWindow )->pxCongestionAvoidance( pxWindow, ulBytesAcked );
+			}
+
+			/* A cwnd larger than the transmission window would be of no use. */
+			pxCC->ulCWnd = FreeRTOS_min_uint32( pxCC->ulCWnd, FreeRTOS_max_uint32( pxWindow->xSize.ulTxWindowLength, ulMSS ) );
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPCongestionFastRetransmit( TCPWindow_t *pxWindow )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+
+		/* Only the first loss in a window of data reduces the cwnd.  Further
+		losses before 'ulRecover' belong to the same congestion event. */
+		if( pxCC->ucState == winCC_OPEN )
+		{
+			pxCC->ulSSThresh = prvTCPCongestionOps( pxWindow )->pxSSThresh( pxWindow );
+			pxCC->ulCWnd = pxCC->ulSSThresh;
+			pxCC->ulBytesAcked = 0UL;
+			pxCC->ulRecover = pxWindow->tx.ulHighestSequenceNumber;
+			pxCC->ucState = winCC_RECOVERY;
+			vTCPTimerSet( &( pxCC->xRecoveryTimer ) );
+
+			if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+			{
+				FreeRTOS_debug_printf( ( "prvTCPCongestionFastRetransmit[%u,%u]: cwnd = ssthresh = %lu\n",
+					pxWindow->usPeerPortNumber,
+					pxWindow->usOurPortNumber,
+					pxCC->ulSSThresh ) );
+			}
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPCongestionTimeout( TCPWindow_t *pxWindow, TCPSegment_t *pxSegment )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+
+		/* 'pxSegment' will be retransmitted because its RTO expired.  The
+		segments which were sent before an earlier time-out expire one by one,
+		they don't shrink the cwnd again. */
+		if( ( pxCC->ucState != winCC_LOSS ) ||
+			( ulTimerGetAge( &( pxSegment->xTransmitTimer ) ) <= ulTimerGetAge( &( pxCC->xRecoveryTimer ) ) ) )
+		{
+			/* When a retransmission times out again, ssthresh is kept
+			(RFC 5681). */
+			if( pxCC->ucState != winCC_LOSS )
+			{
+				pxCC->ulSSThresh = prvTCPCongestionOps( pxWindow )->pxSSThresh( pxWindow );
+			}
+
+			/* Continue with a loss window of one segment. */
+			pxCC->ulCWnd = ( uint32_t ) pxWindow->usMSS;
+			pxCC->ulBytesAcked = 0UL;
+			pxCC->ulRecover = pxWindow->tx.ulHighestSequenceNumber;
+			pxCC->ucState = winCC_LOSS;
+			vTCPTimerSet( &( pxCC->xRecoveryTimer ) );
+
+			if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+			{
+				FreeRTOS_debug_printf( ( "prvTCPCongestionTimeout[%u,%u]: ssthresh = %lu\n",
+					pxWindow->usPeerPortNumber,
+					pxWindow->usOurPortNumber,
+					pxCC->ulSSThresh ) );
+			}
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static uint32_t prvNewRenoSSThresh( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulFlightSize = 0UL;
+
+		if( xSequenceGreaterThan( pxWindow->tx.ulHighestSequenceNumber, pxWindow->tx.ulCurrentSequenceNumber ) != pdFALSE )
+		{
+			ulFlightSize = pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber;
+		}
+
+		/* RFC 5681: ssthresh = max( FlightSize / 2, 2 * MSS ). */
+		return FreeRTOS_max_uint32( ulFlightSize / 2UL, 2UL * ( uint32_t ) pxWindow->usMSS );
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvNewRenoCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulBytesAcked )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+
+		/* Grow with one MSS for every cwnd worth of acknowledged data, which
+		is one MSS per round-trip. */
+		pxCC->ulBytesAcked += ulBytesAcked;
+
+		if( pxCC->ulBytesAcked >= pxCC->ulCWnd )
+		{
+			pxCC->ulBytesAcked -= pxCC->ulCWnd;
+			pxCC->ulCWnd += ( uint32_t ) pxWindow->usMSS;
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+
+	static uint32_t prvCubeRoot( uint64_t ullValue )
+	{
+	uint64_t ullRoot = 0ULL, ullTerm;
+	int32_t lShift;
+
+		/* Integer cube root, one bit of the result per iteration. */
+		for( lShift = 63; lShift >= 0; lShift -= 3 )
+		{
+			ullRoot <<= 1;
+			ullTerm = ( 3ULL * ullRoot * ( ullRoot + 1ULL ) ) + 1ULL;
+
+			if( ( ullValue >> lShift ) >= ullTerm )
+			{
+				ullValue -= ullTerm << lShift;
+				ullRoot++;
+			}
+		}
+
+		return ( uint32_t ) ullRoot;
+	}
+
+#endif /* ipconfigUSE_TCP_CUBIC */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+
+	static uint32_t prvCubicSSThresh( TCPWindow_t *pxWindow )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+
+		/* Fast convergence: when the cwnd did not reach the previous W_max,
+		the available bandwidth has decreased.  Release some of it to other
+		flows by lowering the plateau to cwnd * ( 1 + beta ) / 2. */
+		if( pxCC->ulCWnd < pxCC->ulWMax )
+		{
+			pxCC->ulWMax = ( uint32_t ) ( ( ( uint64_t ) pxCC->ulCWnd * ( winCUBIC_BETA_DENOMINATOR + winCUBIC_BETA_NUMERATOR ) ) / ( 2UL * winCUBIC_BETA_DENOMINATOR ) );
+		}
+		else
+		{
+			pxCC->ulWMax = pxCC->ulCWnd;
+		}
+
+		pxCC->bEpochStarted = pdFALSE_UNSIGNED;
+
+		return FreeRTOS_max_uint32( ( uint32_t ) ( ( ( uint64_t ) pxCC->ulCWnd * winCUBIC_BETA_NUMERATOR ) / winCUBIC_BETA_DENOMINATOR ),
+			2UL * ( uint32_t ) pxWindow->usMSS );
+	}
+
+#endif /* ipconfigUSE_TCP_CUBIC */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_CUBIC != 0 )
+
+	static void prvCubicCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulBytesAcked )
+	{
+	TCPCongestion_t *pxCC = &( pxWindow->xCongestion );
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+	uint32_t ulDifference, ulElapsed, ulTime, ulDistance, ulIncrements;
+	uint64_t ullDelta, ullTarget, ullFriendly, ullBytesPerMSS;
+
+		if( pxCC->bEpochStarted == pdFALSE_UNSIGNED )
+		{
+			pxCC->bEpochStarted = pdTRUE_UNSIGNED;
+			pxCC->ulBytesAcked = 0UL;
+			vTCPTimerSet( &( pxCC->xEpochTimer ) );
+
+			if( pxCC->ulCWnd < pxCC->ulWMax )
+			{
+				/* K = cubic_root( ( W_max - cwnd ) / C ), with W expressed
+				in segments and K in seconds.  Here K is calculated in ms. */
+				ulDifference = pxCC->ulWMax - pxCC->ulCWnd;
+				pxCC->ulK = prvCubeRoot(
+					( ( ( uint64_t ) ( ulDifference / ulMSS ) ) * ( 1000000000ULL * winCUBIC_C_DENOMINATOR / winCUBIC_C_NUMERATOR ) ) +
+					( ( ( uint64_t ) ( ulDifference % ulMSS ) ) * ( 1000000000ULL * winCUBIC_C_DENOMINATOR / winCUBIC_C_NUMERATOR ) ) / ulMSS );
+				pxCC->ulOriginPoint = pxCC->ulWMax;
+			}
+			else
+			{
+				pxCC->ulK = 0UL;
+				pxCC->ulOriginPoint = pxCC->ulCWnd;
+			}
+		}
+
+		/* The target is the value of the cubic function one RTT from now. */
+		ulElapsed = ulTimerGetAge( &( pxCC->xEpochTimer ) );
+		ulTime = ulElapsed + ( uint32_t ) pxWindow->lSRTT;
+
+		if( ulTime > pxCC->ulK )
+		{
+			ulDistance = ulTime - pxCC->ulK;
+		}
+		else
+		{
+			ulDistance = pxCC->ulK - ulTime;
+		}
+
+		ulDistance = FreeRTOS_min_uint32( ulDistance, winCUBIC_MAX_DISTANCE_MS );
+
+		/* W_cubic( t ) = C * ( t - K )^3 + W_max, converted from seconds to ms
+		and from segments to bytes. */
+		ullDelta = ( ( ( uint64_t ) ulDistance * ulDistance * ulDistance ) / 1000000ULL ) * winCUBIC_C_NUMERATOR * ulMSS /
+			( winCUBIC_C_DENOMINATOR * 1000ULL );
+
+		if( ulTime > pxCC->ulK )
+		{
+			ullTarget = ( uint64_t ) pxCC->ulOriginPoint + ullDelta;
+		}
+		else if( ullDelta < ( uint64_t ) pxCC->ulOriginPoint )
+		{
+			ullTarget = ( uint64_t ) pxCC->ulOriginPoint - ullDelta;
+		}
+		else
+		{
+			ullTarget = 0ULL;
+		}
+
+		/* TCP-friendly region: never grow slower than a Reno flow would, that
+		is W_est( t ) = W_max * beta + 3 * ( 1 - beta ) / ( 1 + beta ) * t / RTT. */
+		ullFriendly = ( ( ( uint64_t ) pxCC->ulWMax * winCUBIC_BETA_NUMERATOR ) / winCUBIC_BETA_DENOMINATOR ) +
+			( ( uint64_t ) ulElapsed * ulMSS * winCUBIC_FRIENDLY_NUMERATOR ) / ( winCUBIC_FRIENDLY_DENOMINATOR * ( uint64_t ) pxWindow->lSRTT );
+
+		if( ullFriendly > ullTarget )
+		{
+			ullTarget = ullFriendly;
+		}
+
+		/* Within one RTT, the cwnd will grow by at most 50%. */
+		if( ullTarget > ( uint64_t ) pxCC->ulCWnd + ( pxCC->ulCWnd / 2UL ) )
+		{
+			ullTarget = ( uint64_t ) pxCC->ulCWnd + ( pxCC->ulCWnd / 2UL );
+		}
+
+		/* Reach the target in one RTT: grow with one MSS for every
+		cwnd * MSS / ( target - cwnd ) bytes acknowledged.  Near the plateau,
+		grow very slowly. */
+		if( ullTarget > ( uint64_t ) pxCC->ulCWnd )
+		{
+			ullBytesPerMSS = ( ( uint64_t ) pxCC->ulCWnd * ulMSS ) / ( ullTarget - pxCC->ulCWnd );
+		}
+		else
+		{
+			ullBytesPerMSS = 100ULL * pxCC->ulCWnd;
+		}
+
+		if( ullBytesPerMSS == 0ULL )
+		{
+			ullBytesPerMSS = 1ULL;
+		}
+
+		pxCC->ulBytesAcked += ulBytesAcked;
+
+		if( ( uint64_t ) pxCC->ulBytesAcked >= ullBytesPerMSS )
+		{
+			ulIncrements = ( uint32_t ) ( pxCC->ulBytesAcked / ullBytesPerMSS );
+			pxCC->ulBytesAcked -= ( uint32_t ) ( ulIncrements * ullBytesPerMSS );
+			pxCC->ulCWnd += ulIncrements * ulMSS;
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CUBIC */
+/*-----------------------------------------------------------*/
+
 /*
 #####   #                      #####   ####  ######
 # # #   #                      # # #  #    #  #    #
@@ -254,6 +254,18 @@ UDPPacket_t *pxUDPPacket = (UDPPacket_t *) pxNetworkBuffer->pucEthernetBuffer;
 		handling them, no use to fill the ARP cache with those IP addresses. */
 		vARPRefreshCacheEntry( &( pxUDPPacket->xEthernetHeader.xSourceAddress ), pxUDPPacket->xIPHeader.ulSourceIPAddress );
 
+		#if( ipconfigUSE_DNS == 1 )
+		{
+			/* The replies to the DNS queries are matched with the outstanding
+			look-ups here, there is no task reading from the DNS socket. */
+			if( xIsDNSSocket( pxSocket ) != pdFALSE )
+			{
+				ulDNSHandlePacket( pxNetworkBuffer );
+				xReturn = pdFAIL; /* FAIL means that we did not consume or release the buffer */
+			}
+		}
+		#endif /* ipconfigUSE_DNS */
+
 		#if( ipconfigUSE_CALLBACKS == 1 )
 		{
 			/* Did the owner of this socket register a reception handler ? */
@@ -410,6 +410,29 @@ UBaseType_t uxGetNumberOfFreeNetworkBuffers( void )
 {
 	return listCURRENT_LIST_LENGTH( &xFreeBuffersList );
 }
+/*-----------------------------------------------------------*/
+
+BaseType_t xGetNetworkBufferStats( UBaseType_t uxClass, NetworkBufferStats_t *pxStats )
+{
+BaseType_t xReturn = pdFAIL;
+
+	/* There is a single class of buffers which can hold the largest frame.
+	Their storage is provided by the network interface, see
+	vNetworkInterfaceAllocateRAMToBuffers(), so its size is estimated. */
+	if( uxClass == 0u )
+	{
+		pxStats->uxBlockSize = ( size_t ) ipTOTAL_ETHERNET_FRAME_SIZE;
+		pxStats->uxBlockCount = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
+		pxStats->uxStaticBytes = ( size_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS * ( ipTOTAL_ETHERNET_FRAME_SIZE + ipBUFFER_PADDING );
+		pxStats->uxInUse = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - uxGetNumberOfFreeNetworkBuffers();
+		pxStats->uxMaxInUse = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - uxMinimumFreeNetworkBuffers;
+		pxStats->uxFailures = 0u;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
 
 NetworkBufferDescriptor_t *pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer, size_t xNewSizeBytes )
 {
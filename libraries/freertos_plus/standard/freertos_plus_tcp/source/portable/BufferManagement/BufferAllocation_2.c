@@ -357,6 +357,27 @@ UBaseType_t uxGetMinimumFreeNetworkBuffers( void )
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xGetNetworkBufferStats( UBaseType_t uxClass, NetworkBufferStats_t *pxStats )
+{
+BaseType_t xReturn = pdFAIL;
+
+	/* There is a single class: the storage comes from the heap, and only the
+	number of descriptors is limited. */
+	if( uxClass == 0u )
+	{
+		pxStats->uxBlockSize = 0u;
+		pxStats->uxBlockCount = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
+		pxStats->uxStaticBytes = 0u;
+		pxStats->uxInUse = ( UBaseType_t ) ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - uxGetNumberOfFreeNetworkBuffers();
+		pxStats->uxMaxInUse = ( UBaseType_t ) ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS - uxMinimumFreeNetworkBuffers );
+		pxStats->uxFailures = 0u;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 NetworkBufferDescriptor_t *pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer, size_t xNewSizeBytes )
 {
 size_t xOriginalLength;
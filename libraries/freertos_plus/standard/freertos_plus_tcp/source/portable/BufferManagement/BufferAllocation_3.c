@@ -0,0 +1,581 @@
+/*
+ * FreeRTOS+TCP V2.0.11
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ *
+ * See the following web page for essential buffer allocation scheme usage and
+ * configuration details:
+ * http://www.FreeRTOS.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/Embedded_Ethernet_Buffer_Management.html
+ *
+ ******************************************************************************/
+
+/* This scheme sits between BufferAllocation_1.c and BufferAllocation_2.c.  Like
+BufferAllocation_2.c the network buffers have a variable size, but the storage
+is taken from three statically allocated pools of fixed size blocks (small,
+medium and large) instead of from the heap.  A request is served from the
+smallest class that can hold it, or from a larger class if that one is
+exhausted.  Small packets such as TCP ACKs and DNS requests do not occupy a
+full MTU-sized block, and neither heap fragmentation nor heap latency play a
+role. */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_UDP_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkInterface.h"
+#include "NetworkBufferManagement.h"
+
+/* The usable size, and the number of blocks, of each size class.  The sizes
+do not include the ipBUFFER_PADDING bytes in front of each buffer.  The small
+class should hold a TCP packet without data, the medium class a DHCP packet,
+and the large class a full Ethernet frame. */
+#ifndef ipconfigBUFFER_ALLOC_3_SMALL_SIZE
+	#define ipconfigBUFFER_ALLOC_3_SMALL_SIZE		( 128u )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_SMALL_COUNT
+	#define ipconfigBUFFER_ALLOC_3_SMALL_COUNT		( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 1 ) / 2 )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE
+	#define ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE		( 512u )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT
+	#define ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT		( 4 )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_LARGE_SIZE
+	#define ipconfigBUFFER_ALLOC_3_LARGE_SIZE		( ipTOTAL_ETHERNET_FRAME_SIZE + 2u )
+#endif
+
+#ifndef ipconfigBUFFER_ALLOC_3_LARGE_COUNT
+	#define ipconfigBUFFER_ALLOC_3_LARGE_COUNT		( ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 1 ) / 2 )
+#endif
+
+/* The obtained network buffer must be large enough to hold a packet that might
+replace the packet that was requested to be sent. */
+#if ipconfigUSE_TCP == 1
+	#define baMINIMAL_BUFFER_SIZE		sizeof( TCPPacket_t )
+#else
+	#define baMINIMAL_BUFFER_SIZE		sizeof( ARPPacket_t )
+#endif /* ipconfigUSE_TCP == 1 */
+
+/* Round up to a multiple of 'sizeof( size_t )'. */
+#define baROUND_UP( x )					( ( ( x ) + sizeof( size_t ) - 1u ) & ~( sizeof( size_t ) - 1u ) )
+
+/* Each block starts with ipBUFFER_PADDING bytes, followed by the buffer.  The
+blocks are a multiple of 'sizeof( size_t )' apart, so every block starts at an
+aligned address, just like memory returned by pvPortMalloc(). */
+#define baBLOCK_STRIDE( xSize )			baROUND_UP( baROUND_UP( xSize ) + ipBUFFER_PADDING )
+
+#define baSMALL_STRIDE					baBLOCK_STRIDE( ipconfigBUFFER_ALLOC_3_SMALL_SIZE )
+#define baMEDIUM_STRIDE					baBLOCK_STRIDE( ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE )
+#define baLARGE_STRIDE					baBLOCK_STRIDE( ipconfigBUFFER_ALLOC_3_LARGE_SIZE )
+
+#define baNUMBER_OF_CLASSES				( 3 )
+
+/*_RB_ This is too complex not to have an explanation. */
+#if defined( ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+	#define ASSERT_CONCAT_(a, b) a##b
+	#define ASSERT_CONCAT(a, b) ASSERT_CONCAT_(a, b)
+	#define STATIC_ASSERT(e) \
+		;enum { ASSERT_CONCAT(assert_line_, __LINE__) = 1/(!!(e)) }
+
+	STATIC_ASSERT( ipconfigETHERNET_MINIMUM_PACKET_BYTES <= baMINIMAL_BUFFER_SIZE );
+#endif
+
+/* The administration of one size class.  Free blocks are linked through their
+first bytes, which hold the pointer to the network buffer descriptor while the
+block is in use. */
+typedef struct xBUFFER_CLASS
+{
+	uint8_t *pucStorage;		/* The first block of this class. */
+	size_t uxBlockSize;			/* Usable size of a block, excluding the padding. */
+	size_t uxStride;			/* Distance between two blocks. */
+	UBaseType_t uxBlockCount;	/* Number of blocks in this class. */
+	void *pvFreeBlocks;			/* Singly linked list of free blocks. */
+	UBaseType_t uxInUse;		/* Number of blocks currently in use. */
+	UBaseType_t uxMaxInUse;		/* Highest value of uxInUse since booting. */
+	UBaseType_t uxFailures;		/* Requests which did not find a free block in this class. */
+} BufferClass_t;
+
+/* The storage of the size classes, declared as 'size_t' to get the alignment
+of that type. */
+static size_t uxSmallBlocks[ ( ipconfigBUFFER_ALLOC_3_SMALL_COUNT * baSMALL_STRIDE ) / sizeof( size_t ) ];
+static size_t uxMediumBlocks[ ( ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT * baMEDIUM_STRIDE ) / sizeof( size_t ) ];
+static size_t uxLargeBlocks[ ( ipconfigBUFFER_ALLOC_3_LARGE_COUNT * baLARGE_STRIDE ) / sizeof( size_t ) ];
+
+static BufferClass_t xBufferClasses[ baNUMBER_OF_CLASSES ] =
+{
+	{ ( uint8_t * ) uxSmallBlocks, baROUND_UP( ipconfigBUFFER_ALLOC_3_SMALL_SIZE ), baSMALL_STRIDE, ipconfigBUFFER_ALLOC_3_SMALL_COUNT, NULL, 0u, 0u, 0u },
+	{ ( uint8_t * ) uxMediumBlocks, baROUND_UP( ipconfigBUFFER_ALLOC_3_MEDIUM_SIZE ), baMEDIUM_STRIDE, ipconfigBUFFER_ALLOC_3_MEDIUM_COUNT, NULL, 0u, 0u, 0u },
+	{ ( uint8_t * ) uxLargeBlocks, baROUND_UP( ipconfigBUFFER_ALLOC_3_LARGE_SIZE ), baLARGE_STRIDE, ipconfigBUFFER_ALLOC_3_LARGE_COUNT, NULL, 0u, 0u, 0u }
+};
+
+/* A list of free (available) NetworkBufferDescriptor_t structures. */
+static List_t xFreeBuffersList;
+
+/* Some statistics about the use of buffers. */
+static size_t uxMinimumFreeNetworkBuffers;
+
+/* Declares the pool of NetworkBufferDescriptor_t structures that are available
+to the system.  All the network buffers referenced from xFreeBuffersList exist
+in this array.  The array is not accessed directly except during initialisation,
+when the xFreeBuffersList is filled (as all the buffers are free when the system
+is booted). */
+static NetworkBufferDescriptor_t xNetworkBufferDescriptors[ ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS ];
+
+/* This constant is defined as false to let FreeRTOS_TCP_IP.c know that the
+network buffers have a variable size: resizing may be necessary */
+const BaseType_t xBufferAllocFixedSize = pdFALSE;
+
+/* The semaphore used to obtain network buffers. */
+static SemaphoreHandle_t xNetworkBufferSemaphore = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Take a block of at least xSize bytes from the smallest class that has one
+ * free.  Returns NULL when no class can hold the request.
+ */
+static uint8_t *prvTakeBlock( size_t xSize );
+
+/*
+ * Return a block taken with prvTakeBlock() to its class.
+ */
+static void prvGiveBlock( uint8_t *pucBlock );
+
+/*-----------------------------------------------------------*/
+
+static uint8_t *prvTakeBlock( size_t xSize )
+{
+uint8_t *pucBlock = NULL;
+BufferClass_t *pxClass;
+BaseType_t xIndex;
+
+	taskENTER_CRITICAL();
+	{
+		for( xIndex = 0; xIndex < baNUMBER_OF_CLASSES; xIndex++ )
+		{
+			pxClass = &( xBufferClasses[ xIndex ] );
+
+			if( pxClass->uxBlockSize < xSize )
+			{
+				continue;
+			}
+
+			if( pxClass->pvFreeBlocks == NULL )
+			{
+				/* The class is exhausted, try a larger one. */
+				pxClass->uxFailures++;
+				continue;
+			}
+
+			pucBlock = ( uint8_t * ) pxClass->pvFreeBlocks;
+			pxClass->pvFreeBlocks = *( ( void ** ) pucBlock );
+			pxClass->uxInUse++;
+
+			if( pxClass->uxMaxInUse < pxClass->uxInUse )
+			{
+				pxClass->uxMaxInUse = pxClass->uxInUse;
+			}
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pucBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveBlock( uint8_t *pucBlock )
+{
+BufferClass_t *pxClass = NULL;
+BaseType_t xIndex;
+
+	/* The class is found from the address of the block. */
+	for( xIndex = 0; xIndex < baNUMBER_OF_CLASSES; xIndex++ )
+	{
+		if( ( pucBlock >= xBufferClasses[ xIndex ].pucStorage ) &&
+			( pucBlock < xBufferClasses[ xIndex ].pucStorage + ( xBufferClasses[ xIndex ].uxStride * xBufferClasses[ xIndex ].uxBlockCount ) ) )
+		{
+			pxClass = &( xBufferClasses[ xIndex ] );
+			break;
+		}
+	}
+
+	configASSERT( pxClass != NULL );
+
+	if( pxClass != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			*( ( void ** ) pucBlock ) = pxClass->pvFreeBlocks;
+			pxClass->pvFreeBlocks = ( void * ) pucBlock;
+			pxClass->uxInUse--;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkBuffersInitialise( void )
+{
+BaseType_t xReturn, x;
+UBaseType_t uxBlock;
+BufferClass_t *pxClass;
+
+	/* Only initialise the buffers and their associated kernel objects if they
+	have not been initialised before. */
+	if( xNetworkBufferSemaphore == NULL )
+	{
+		xNetworkBufferSemaphore = xSemaphoreCreateCounting( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS, ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS );
+		configASSERT( xNetworkBufferSemaphore );
+
+		if( xNetworkBufferSemaphore != NULL )
+		{
+			#if ( configQUEUE_REGISTRY_SIZE > 0 )
+			{
+				vQueueAddToRegistry( xNetworkBufferSemaphore, "NetBufSem" );
+			}
+			#endif /* configQUEUE_REGISTRY_SIZE */
+
+			/* If the trace recorder code is included name the semaphore for viewing
+			in FreeRTOS+Trace.  */
+			#if( ipconfigINCLUDE_EXAMPLE_FREERTOS_PLUS_TRACE_CALLS == 1 )
+			{
+				extern QueueHandle_t xNetworkEventQueue;
+				vTraceSetQueueName( xNetworkEventQueue, "IPStackEvent" );
+				vTraceSetQueueName( xNetworkBufferSemaphore, "NetworkBufferCount" );
+			}
+			#endif /*  ipconfigINCLUDE_EXAMPLE_FREERTOS_PLUS_TRACE_CALLS == 1 */
+
+			vListInitialise( &xFreeBuffersList );
+
+			/* Initialise all the network buffers.  No storage is assigned to
+			the buffers yet. */
+			for( x = 0; x < ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS; x++ )
+			{
+				/* Initialise and set the owner of the buffer list items. */
+				xNetworkBufferDescriptors[ x ].pucEthernetBuffer = NULL;
+				vListInitialiseItem( &( xNetworkBufferDescriptors[ x ].xBufferListItem ) );
+				listSET_LIST_ITEM_OWNER( &( xNetworkBufferDescriptors[ x ].xBufferListItem ), &xNetworkBufferDescriptors[ x ] );
+
+				/* Currently, all buffers are available for use. */
+				vListInsert( &xFreeBuffersList, &( xNetworkBufferDescriptors[ x ].xBufferListItem ) );
+			}
+
+			uxMinimumFreeNetworkBuffers = ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS;
+
+			/* The classes are searched from small to large, and the large class
+			must be able to hold a full Ethernet frame. */
+			configASSERT( xBufferClasses[ 0 ].uxBlockSize < xBufferClasses[ 1 ].uxBlockSize );
+			configASSERT( xBufferClasses[ 1 ].uxBlockSize < xBufferClasses[ 2 ].uxBlockSize );
+			configASSERT( xBufferClasses[ 2 ].uxBlockSize >= ( size_t ) ipTOTAL_ETHERNET_FRAME_SIZE );
+
+			/* Link all blocks of every class in its list of free blocks. */
+			for( x = 0; x < baNUMBER_OF_CLASSES; x++ )
+			{
+				pxClass = &( xBufferClasses[ x ] );
+				pxClass->pvFreeBlocks = NULL;
+
+				for( uxBlock = pxClass->uxBlockCount; uxBlock > 0u; uxBlock-- )
+				{
+				uint8_t *pucBlock = pxClass->pucStorage + ( ( uxBlock - 1u ) * pxClass->uxStride );
+
+					*( ( void ** ) pucBlock ) = pxClass->pvFreeBlocks;
+					pxClass->pvFreeBlocks = ( void * ) pucBlock;
+				}
+			}
+		}
+	}
+
+	if( xNetworkBufferSemaphore == NULL )
+	{
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t *pucGetNetworkBuffer( size_t *pxRequestedSizeBytes )
+{
+uint8_t *pucEthernetBuffer;
+size_t xSize = *pxRequestedSizeBytes;
+
+	if( xSize < baMINIMAL_BUFFER_SIZE )
+	{
+		/* Buffers must be at least large enough to hold a TCP-packet with
+		headers, or an ARP packet, in case TCP is not included. */
+		xSize = baMINIMAL_BUFFER_SIZE;
+	}
+
+	/* Round up xSize to the nearest multiple of N bytes,
+	where N equals 'sizeof( size_t )'. */
+	xSize = baROUND_UP( xSize );
+	*pxRequestedSizeBytes = xSize;
+
+	pucEthernetBuffer = prvTakeBlock( xSize );
+
+	if( pucEthernetBuffer != NULL )
+	{
+		/* Enough space is left at the start of the buffer to place a pointer to
+		the network buffer structure that references this Ethernet buffer.
+		Return a pointer to the start of the Ethernet buffer itself. */
+		pucEthernetBuffer += ipBUFFER_PADDING;
+	}
+
+	return pucEthernetBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vReleaseNetworkBuffer( uint8_t *pucEthernetBuffer )
+{
+	/* There is space before the Ethernet buffer in which a pointer to the
+	network buffer that references this Ethernet buffer is stored.  Remove the
+	space before returning the block to its class. */
+	if( pucEthernetBuffer != NULL )
+	{
+		pucEthernetBuffer -= ipBUFFER_PADDING;
+		prvGiveBlock( pucEthernetBuffer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+NetworkBufferDescriptor_t *pxGetNetworkBufferWithDescriptor( size_t xRequestedSizeBytes, TickType_t xBlockTimeTicks )
+{
+NetworkBufferDescriptor_t *pxReturn = NULL;
+size_t uxCount;
+uint8_t *pucBlock;
+
+	if( ( xRequestedSizeBytes != 0u ) && ( xRequestedSizeBytes < ( size_t ) baMINIMAL_BUFFER_SIZE ) )
+	{
+		/* ARP packets can replace application packets, so the storage must be
+		at least large enough to hold an ARP. */
+		xRequestedSizeBytes = baMINIMAL_BUFFER_SIZE;
+	}
+
+	/* Add 2 bytes to xRequestedSizeBytes and round up xRequestedSizeBytes
+	to the nearest multiple of N bytes, where N equals 'sizeof( size_t )'. */
+	xRequestedSizeBytes = baROUND_UP( xRequestedSizeBytes + 2u );
+
+	/* If there is a semaphore available, there is a network buffer available. */
+	if( xSemaphoreTake( xNetworkBufferSemaphore, xBlockTimeTicks ) == pdPASS )
+	{
+		/* Protect the structure as it is accessed from tasks and interrupts. */
+		taskENTER_CRITICAL();
+		{
+			pxReturn = ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xFreeBuffersList );
+			uxListRemove( &( pxReturn->xBufferListItem ) );
+		}
+		taskEXIT_CRITICAL();
+
+		/* Reading UBaseType_t, no critical section needed. */
+		uxCount = listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+
+		if( uxMinimumFreeNetworkBuffers > uxCount )
+		{
+			uxMinimumFreeNetworkBuffers = uxCount;
+		}
+
+		/* Assign a block of the smallest class that can hold the request. */
+		configASSERT( pxReturn->pucEthernetBuffer == NULL );
+		if( xRequestedSizeBytes > 0 )
+		{
+			pucBlock = prvTakeBlock( xRequestedSizeBytes );
+
+			if( pucBlock == NULL )
+			{
+				/* None of the classes has a free block that is big enough, so
+				the network buffer structure cannot be used and must be
+				released. */
+				vReleaseNetworkBufferAndDescriptor( pxReturn );
+				pxReturn = NULL;
+			}
+			else
+			{
+				/* Store a pointer to the network buffer structure in the
+				padding in front of the buffer, so the pointer value is not
+				overwritten by the application when the buffer is used. */
+				*( ( NetworkBufferDescriptor_t ** ) pucBlock ) = pxReturn;
+				pxReturn->pucEthernetBuffer = pucBlock + ipBUFFER_PADDING;
+
+				/* Store the rounded size of the buffer, the block itself may
+				be larger. */
+				pxReturn->xDataLength = xRequestedSizeBytes;
+
+				#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+				{
+					/* make sure the buffer is not linked */
+					pxReturn->pxNextBuffer = NULL;
+				}
+				#endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+			}
+		}
+		else
+		{
+			/* A descriptor is being returned without an associated buffer being
+			allocated. */
+		}
+	}
+
+	if( pxReturn == NULL )
+	{
+		iptraceFAILED_TO_OBTAIN_NETWORK_BUFFER();
+	}
+	else
+	{
+		iptraceNETWORK_BUFFER_OBTAINED( pxReturn );
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+{
+BaseType_t xListItemAlreadyInFreeList;
+
+	/* Ensure the buffer is returned to the list of free buffers before the
+	counting semaphore is 'given' to say a buffer is available.  Return the
+	block of the buffer payload to its class. */
+	vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+	pxNetworkBuffer->pucEthernetBuffer = NULL;
+
+	taskENTER_CRITICAL();
+	{
+		xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+
+		if( xListItemAlreadyInFreeList == pdFALSE )
+		{
+			vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/*
+	 * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
+	 * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
+	 */
+	if( xListItemAlreadyInFreeList == pdFALSE )
+	{
+		if ( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+		{
+			iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+		}
+	}
+	else
+	{
+		iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the number of free network buffers
+ */
+UBaseType_t uxGetNumberOfFreeNetworkBuffers( void )
+{
+	return listCURRENT_LIST_LENGTH( &xFreeBuffersList );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxGetMinimumFreeNetworkBuffers( void )
+{
+	return uxMinimumFreeNetworkBuffers;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xGetNetworkBufferStats( UBaseType_t uxClass, NetworkBufferStats_t *pxStats )
+{
+BaseType_t xReturn = pdFAIL;
+
+	if( uxClass < ( UBaseType_t ) baNUMBER_OF_CLASSES )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxStats->uxBlockSize = xBufferClasses[ uxClass ].uxBlockSize;
+			pxStats->uxBlockCount = xBufferClasses[ uxClass ].uxBlockCount;
+			pxStats->uxStaticBytes = xBufferClasses[ uxClass ].uxStride * xBufferClasses[ uxClass ].uxBlockCount;
+			pxStats->uxInUse = xBufferClasses[ uxClass ].uxInUse;
+			pxStats->uxMaxInUse = xBufferClasses[ uxClass ].uxMaxInUse;
+			pxStats->uxFailures = xBufferClasses[ uxClass ].uxFailures;
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+NetworkBufferDescriptor_t *pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer, size_t xNewSizeBytes )
+{
+size_t xOriginalLength;
+uint8_t *pucBuffer;
+
+	xOriginalLength = pxNetworkBuffer->xDataLength;
+
+	pucBuffer = pucGetNetworkBuffer( &( xNewSizeBytes ) );
+
+	if( pucBuffer == NULL )
+	{
+		/* In case the allocation fails, return NULL. */
+		pxNetworkBuffer = NULL;
+	}
+	else
+	{
+		pxNetworkBuffer->xDataLength = xNewSizeBytes;
+		if( xNewSizeBytes > xOriginalLength )
+		{
+			xNewSizeBytes = xOriginalLength;
+		}
+
+		/* Copy the padding too, it holds the pointer to the descriptor. */
+		memcpy( pucBuffer - ipBUFFER_PADDING, pxNetworkBuffer->pucEthernetBuffer - ipBUFFER_PADDING, xNewSizeBytes + ipBUFFER_PADDING );
+		vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+		pxNetworkBuffer->pucEthernetBuffer = pucBuffer;
+	}
+
+	return pxNetworkBuffer;
+}
@@ -0,0 +1,328 @@
+/*
+FreeRTOS+TCP V2.0.11
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+*/
+
+/*
+ * Network interface for the FreeRTOS simulator on Linux, using a TAP device.
+ * The TAP device must exist and be up before the application starts, e.g.:
+ *
+ *		ip tuntap add dev tap0 mode tap user $USER
+ *		ip addr add 192.168.0.1/24 dev tap0
+ *		ip link set tap0 up
+ *
+ * The stack can then be reached from the host at the address configured in
+ * FreeRTOSConfig.h, which makes it possible to measure it with the usual Linux
+ * tools (iperf, ping, etc.).
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+
+/* Thread-safe circular buffers are being used to pass received data from the
+Linux thread to the FreeRTOS tasks. */
+#include "FreeRTOS_Stream_Buffer.h"
+
+/* The name of the TAP device, it can be overridden with the environment
+variable FREERTOS_TAP_DEVICE. */
+#ifndef configTAP_DEVICE_NAME
+	#define configTAP_DEVICE_NAME		"tap0"
+#endif
+
+/* The priority of the task that simulates the Ethernet interrupt. */
+#ifndef configMAC_ISR_SIMULATOR_PRIORITY
+	#define configMAC_ISR_SIMULATOR_PRIORITY	( configMAX_PRIORITIES - 1 )
+#endif
+
+/* The number of ticks the interrupt simulator sleeps when there is no data. */
+#ifndef configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY
+	#define configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY	( 1 )
+#endif
+
+/* Size of the thread safe circular buffer used to pass received data from
+the Linux thread to the FreeRTOS simulator. */
+#define xRECV_BUFFER_SIZE  65536
+
+/* If ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES is set to 1, then the Ethernet
+driver will filter incoming packets and only pass the stack those packets it
+considers need processing. */
+#if( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eProcessBuffer
+#else
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * A Linux thread, outside of the control of the FreeRTOS simulator, that
+ * blocks on the TAP device and passes the frames to prvInterruptSimulatorTask().
+ */
+static void *prvTapRecvThread( void *pvParam );
+
+/*
+ * A function that simulates Ethernet interrupts by periodically polling the
+ * circular buffer filled by prvTapRecvThread().
+ */
+static void prvInterruptSimulatorTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The file descriptor of the opened TAP device. */
+static int iTapDevice = -1;
+
+/* Circular buffer filled by the Linux thread. */
+static StreamBuffer_t *xRecvBuffer = NULL;
+
+/* Logs the number of failures, for viewing in the debugger only. */
+static volatile uint32_t ulTapSendFailures = 0;
+static volatile uint32_t ulTapRecvOverflows = 0;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceInitialise( void )
+{
+BaseType_t xReturn = pdFAIL;
+struct ifreq xRequest;
+const char *pcName;
+pthread_t xThread;
+sigset_t xAllSignals, xOldSignals;
+
+	if( iTapDevice >= 0 )
+	{
+		/* The device was opened during an earlier call. */
+		xReturn = pdPASS;
+	}
+	else
+	{
+		pcName = getenv( "FREERTOS_TAP_DEVICE" );
+
+		if( pcName == NULL )
+		{
+			pcName = configTAP_DEVICE_NAME;
+		}
+
+		iTapDevice = open( "/dev/net/tun", O_RDWR );
+
+		if( iTapDevice < 0 )
+		{
+			printf( "xNetworkInterfaceInitialise: can not open /dev/net/tun: %s\n", strerror( errno ) );
+		}
+		else
+		{
+			/* Attach to the TAP device: Ethernet frames, without the extra
+			packet information header. */
+			memset( &xRequest, '\0', sizeof( xRequest ) );
+			xRequest.ifr_flags = IFF_TAP | IFF_NO_PI;
+			strncpy( xRequest.ifr_name, pcName, IFNAMSIZ - 1 );
+
+			if( ioctl( iTapDevice, TUNSETIFF, ( void * ) &xRequest ) < 0 )
+			{
+				printf( "xNetworkInterfaceInitialise: can not attach to %s: %s\n", pcName, strerror( errno ) );
+				close( iTapDevice );
+				iTapDevice = -1;
+			}
+		}
+
+		if( iTapDevice >= 0 )
+		{
+			xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + xRECV_BUFFER_SIZE + 1 );
+			configASSERT( xRecvBuffer );
+			memset( xRecvBuffer, '\0', sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) );
+			xRecvBuffer->LENGTH = xRECV_BUFFER_SIZE + 1;
+
+			/* The simulator uses signals to drive the scheduler, they must not
+			be delivered to the Linux thread.  The thread inherits the mask. */
+			sigfillset( &xAllSignals );
+			pthread_sigmask( SIG_SETMASK, &xAllSignals, &xOldSignals );
+			configASSERT( pthread_create( &xThread, NULL, prvTapRecvThread, NULL ) == 0 );
+			pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+			/* Create a task that simulates an interrupt in a real system.  This
+			will block waiting for packets, then send a message to the IP task
+			when data is available. */
+			xTaskCreate( prvInterruptSimulatorTask, "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, NULL );
+
+			printf( "xNetworkInterfaceInitialise: using TAP device %s\n", pcName );
+			xReturn = pdPASS;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceOutput( NetworkBufferDescriptor_t * const pxNetworkBuffer, BaseType_t bReleaseAfterSend )
+{
+ssize_t xWritten;
+
+	iptraceNETWORK_INTERFACE_TRANSMIT();
+
+	/* A write to a TAP device does not block: the frame is queued by the
+	Linux kernel, or dropped when the device is down.  The write is retried
+	when it was interrupted by the signals of the simulator. */
+	do
+	{
+		xWritten = write( iTapDevice, pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+	} while( ( xWritten < 0 ) && ( errno == EINTR ) );
+
+	if( xWritten != ( ssize_t ) pxNetworkBuffer->xDataLength )
+	{
+		ulTapSendFailures++;
+	}
+
+	/* The buffer has been sent so can be released. */
+	if( bReleaseAfterSend != pdFALSE )
+	{
+		vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTapRecvThread( void *pvParam )
+{
+uint8_t ucBuffer[ ipTOTAL_ETHERNET_FRAME_SIZE ];
+ssize_t xLength;
+size_t uxLength;
+
+	/* THIS IS A LINUX THREAD - DO NOT ATTEMPT ANY FREERTOS CALLS OR TO PRINT
+	OUT MESSAGES HERE. */
+	( void ) pvParam;
+
+	for( ;; )
+	{
+		xLength = read( iTapDevice, ucBuffer, sizeof( ucBuffer ) );
+
+		if( xLength <= 0 )
+		{
+			if( ( xLength < 0 ) && ( errno != EINTR ) )
+			{
+				/* The device went away, do not spin. */
+				usleep( 10000 );
+			}
+			continue;
+		}
+
+		/* Pass the length followed by the frame, or drop the frame when the
+		circular buffer is full. */
+		uxLength = ( size_t ) xLength;
+
+		if( uxStreamBufferGetSpace( xRecvBuffer ) >= ( uxLength + sizeof( uxLength ) ) )
+		{
+			uxStreamBufferAdd( xRecvBuffer, 0, ( const uint8_t * ) &uxLength, sizeof( uxLength ) );
+			uxStreamBufferAdd( xRecvBuffer, 0, ucBuffer, uxLength );
+		}
+		else
+		{
+			ulTapRecvOverflows++;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSimulatorTask( void *pvParameters )
+{
+size_t uxLength;
+uint8_t ucRecvBuffer[ ipTOTAL_ETHERNET_FRAME_SIZE ];
+NetworkBufferDescriptor_t *pxNetworkBuffer;
+IPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
+
+	/* Remove compiler warnings about unused parameters. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Does the circular buffer used to pass data from the Linux thread
+		into the FreeRTOS simulator contain another frame? */
+		if( uxStreamBufferGetSize( xRecvBuffer ) > sizeof( uxLength ) )
+		{
+			uxStreamBufferGet( xRecvBuffer, 0, ( uint8_t * ) &uxLength, sizeof( uxLength ), pdFALSE );
+			uxStreamBufferGet( xRecvBuffer, 0, ucRecvBuffer, uxLength, pdFALSE );
+
+			iptraceNETWORK_INTERFACE_RECEIVE();
+
+			/* Check for minimal size. */
+			if( ( uxLength < sizeof( EthernetHeader_t ) ) ||
+				( ipCONSIDER_FRAME_FOR_PROCESSING( ucRecvBuffer ) != eProcessBuffer ) )
+			{
+				continue;
+			}
+
+			/* Obtain a buffer into which the data can be placed.  This is only
+			an interrupt simulator, not a real interrupt, so it is ok to call
+			the task level function here. */
+			pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxLength, 0 );
+
+			if( pxNetworkBuffer != NULL )
+			{
+				memcpy( pxNetworkBuffer->pucEthernetBuffer, ucRecvBuffer, uxLength );
+				pxNetworkBuffer->xDataLength = uxLength;
+				xRxEvent.pvData = ( void * ) pxNetworkBuffer;
+
+				/* Data was received and stored.  Send a message to the IP task
+				to let it know. */
+				if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 0 ) == pdFAIL )
+				{
+					vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+					iptraceETHERNET_RX_EVENT_LOST();
+				}
+			}
+			else
+			{
+				iptraceETHERNET_RX_EVENT_LOST();
+			}
+		}
+		else
+		{
+			/* There is no real way of simulating an interrupt.  Make sure
+			other tasks can run. */
+			vTaskDelay( configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,597 @@
+/*
+FreeRTOS+TCP V2.0.11
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+*/
+
+/*
+ * A simulated Ethernet wire for the FreeRTOS simulator on Linux.
+ *
+ * The IP-stack keeps its state in global variables, so every instance of
+ * FreeRTOS+TCP runs in its own process.  Two of these processes are connected
+ * back-to-back through a pair of Unix datagram sockets, each frame being one
+ * datagram.  No privileges or network devices are needed, which makes the
+ * wire usable in CI.
+ *
+ * The outgoing direction can be impaired with a propagation delay, a random
+ * loss and a limited bandwidth, see vWireSetImpairment().  Frames leave in
+ * order: a frame is serialised after the previous one has left the wire, and
+ * a frame that does not fit in the transmission queue is dropped (drop-tail),
+ * like a real router would do.  The loss generator is seeded with a constant,
+ * so that a given test run can be repeated.
+ *
+ * Each process selects its own socket path and that of its peer with
+ * configWIRE_LOCAL_PATH and configWIRE_PEER_PATH, or at run time with the
+ * environment variables FREERTOS_WIRE_LOCAL and FREERTOS_WIRE_PEER, e.g.:
+ *
+ *		FREERTOS_WIRE_LOCAL=/tmp/wire_a FREERTOS_WIRE_PEER=/tmp/wire_b ./server &
+ *		FREERTOS_WIRE_LOCAL=/tmp/wire_b FREERTOS_WIRE_PEER=/tmp/wire_a ./client
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+#include "NetworkInterfaceWire.h"
+
+/* Thread-safe circular buffers are being used to pass data to and from the
+Linux threads that are outside of the control of the FreeRTOS simulator. */
+#include "FreeRTOS_Stream_Buffer.h"
+
+#ifndef configWIRE_LOCAL_PATH
+	#define configWIRE_LOCAL_PATH		"/tmp/freertos_wire_a"
+#endif
+
+#ifndef configWIRE_PEER_PATH
+	#define configWIRE_PEER_PATH		"/tmp/freertos_wire_b"
+#endif
+
+/* The impairment that is applied at start-up, see vWireSetImpairment(). */
+#ifndef configWIRE_DELAY_US
+	#define configWIRE_DELAY_US			( 0u )
+#endif
+
+#ifndef configWIRE_LOSS_PPM
+	#define configWIRE_LOSS_PPM			( 0u )
+#endif
+
+#ifndef configWIRE_BITS_PER_SECOND
+	#define configWIRE_BITS_PER_SECOND	( 0u )
+#endif
+
+/* The seed of the loss generator. */
+#ifndef configWIRE_LOSS_SEED
+	#define configWIRE_LOSS_SEED		( 0x2545F491u )
+#endif
+
+/* The number of bytes that may wait in the transmission queue.  With a
+limited bandwidth, this is the buffer of the bottleneck. */
+#ifndef configWIRE_QUEUE_BYTES
+	#define configWIRE_QUEUE_BYTES		( 65536u )
+#endif
+
+/* The priority of the task that simulates the Ethernet interrupt. */
+#ifndef configMAC_ISR_SIMULATOR_PRIORITY
+	#define configMAC_ISR_SIMULATOR_PRIORITY	( configMAX_PRIORITIES - 1 )
+#endif
+
+/* The number of ticks the interrupt simulator sleeps when there is no data. */
+#ifndef configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY
+	#define configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY	( 1 )
+#endif
+
+/* Size of the thread safe circular buffer used to pass received data from
+the Linux thread to the FreeRTOS simulator. */
+#define xRECV_BUFFER_SIZE  65536
+
+#define wireNANO_PER_SECOND		( 1000000000ull )
+#define wireNANO_PER_MICRO		( 1000ull )
+
+/* If ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES is set to 1, then the Ethernet
+driver will filter incoming packets and only pass the stack those packets it
+considers need processing. */
+#if( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eProcessBuffer
+#else
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+/* Every frame in the transmission queue is preceded by this header. */
+typedef struct xWIRE_FRAME_HEADER
+{
+	uint64_t ullDeliverAt;		/* CLOCK_MONOTONIC time at which the frame arrives at the peer. */
+	size_t uxLength;			/* The length of the frame that follows. */
+} WireFrameHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Linux threads, outside of the control of the FreeRTOS simulator, that move
+ * frames between the circular buffers and the datagram socket.
+ */
+static void *prvWireSendThread( void *pvParam );
+static void *prvWireRecvThread( void *pvParam );
+
+/*
+ * A function that simulates Ethernet interrupts by periodically polling the
+ * circular buffer filled by prvWireRecvThread().
+ */
+static void prvInterruptSimulatorTask( void *pvParameters );
+
+/*
+ * Returns the CLOCK_MONOTONIC time in nanoseconds.
+ */
+static uint64_t prvNow( void );
+
+/*
+ * Returns pdTRUE when the simulated loss drops the next frame.
+ */
+static BaseType_t prvFrameIsLost( void );
+
+/*-----------------------------------------------------------*/
+
+/* The datagram socket bound to the local path. */
+static int iWireSocket = -1;
+static struct sockaddr_un xPeerAddress;
+
+/* A pipe used by xNetworkInterfaceOutput() to wake up prvWireSendThread(). */
+static int iWakeUpPipe[ 2 ] = { -1, -1 };
+
+/* Circular buffers used to pass frames to and from the Linux threads. */
+static StreamBuffer_t *xSendBuffer = NULL;
+static StreamBuffer_t *xRecvBuffer = NULL;
+
+/* The current impairment, only accessed from FreeRTOS tasks. */
+static uint64_t ullDelayNs = configWIRE_DELAY_US * wireNANO_PER_MICRO;
+static uint32_t ulLossPPM = configWIRE_LOSS_PPM;
+static uint64_t ullBitsPerSecond = configWIRE_BITS_PER_SECOND;
+
+/* The time at which the last frame queued has left the wire, which is when
+the serialisation of the next frame can start. */
+static uint64_t ullLastDeparture = 0u;
+
+/* The state of the loss generator. */
+static uint32_t ulLossState = configWIRE_LOSS_SEED;
+
+/* Every counter has a single writer, vWireGetStats() reads them. */
+static volatile WireStats_t xWireStats;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceInitialise( void )
+{
+BaseType_t xReturn = pdFAIL;
+struct sockaddr_un xLocalAddress;
+const char *pcLocalPath, *pcPeerPath;
+pthread_t xThread;
+sigset_t xAllSignals, xOldSignals;
+
+	if( iWireSocket >= 0 )
+	{
+		/* The wire was opened during an earlier call. */
+		xReturn = pdPASS;
+	}
+	else
+	{
+		pcLocalPath = getenv( "FREERTOS_WIRE_LOCAL" );
+		pcPeerPath = getenv( "FREERTOS_WIRE_PEER" );
+
+		if( pcLocalPath == NULL )
+		{
+			pcLocalPath = configWIRE_LOCAL_PATH;
+		}
+
+		if( pcPeerPath == NULL )
+		{
+			pcPeerPath = configWIRE_PEER_PATH;
+		}
+
+		memset( &xLocalAddress, '\0', sizeof( xLocalAddress ) );
+		xLocalAddress.sun_family = AF_UNIX;
+		strncpy( xLocalAddress.sun_path, pcLocalPath, sizeof( xLocalAddress.sun_path ) - 1 );
+
+		memset( &xPeerAddress, '\0', sizeof( xPeerAddress ) );
+		xPeerAddress.sun_family = AF_UNIX;
+		strncpy( xPeerAddress.sun_path, pcPeerPath, sizeof( xPeerAddress.sun_path ) - 1 );
+
+		iWireSocket = socket( AF_UNIX, SOCK_DGRAM, 0 );
+
+		if( iWireSocket < 0 )
+		{
+			printf( "xNetworkInterfaceInitialise: socket() failed: %s\n", strerror( errno ) );
+		}
+		else
+		{
+			/* A socket file left behind by an earlier run would make bind()
+			fail. */
+			unlink( pcLocalPath );
+
+			if( bind( iWireSocket, ( struct sockaddr * ) &xLocalAddress, sizeof( xLocalAddress ) ) < 0 )
+			{
+				printf( "xNetworkInterfaceInitialise: can not bind to %s: %s\n", pcLocalPath, strerror( errno ) );
+				close( iWireSocket );
+				iWireSocket = -1;
+			}
+			else if( pipe( iWakeUpPipe ) < 0 )
+			{
+				printf( "xNetworkInterfaceInitialise: pipe() failed: %s\n", strerror( errno ) );
+				close( iWireSocket );
+				iWireSocket = -1;
+			}
+		}
+
+		if( iWireSocket >= 0 )
+		{
+			xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + configWIRE_QUEUE_BYTES + 1 );
+			configASSERT( xSendBuffer );
+			memset( xSendBuffer, '\0', sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) );
+			xSendBuffer->LENGTH = configWIRE_QUEUE_BYTES + 1;
+
+			xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + xRECV_BUFFER_SIZE + 1 );
+			configASSERT( xRecvBuffer );
+			memset( xRecvBuffer, '\0', sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) );
+			xRecvBuffer->LENGTH = xRECV_BUFFER_SIZE + 1;
+
+			/* The simulator uses signals to drive the scheduler, they must not
+			be delivered to the Linux threads.  The threads inherit the mask. */
+			sigfillset( &xAllSignals );
+			pthread_sigmask( SIG_SETMASK, &xAllSignals, &xOldSignals );
+			configASSERT( pthread_create( &xThread, NULL, prvWireSendThread, NULL ) == 0 );
+			configASSERT( pthread_create( &xThread, NULL, prvWireRecvThread, NULL ) == 0 );
+			pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+			/* Create a task that simulates an interrupt in a real system.  This
+			will block waiting for packets, then send a message to the IP task
+			when data is available. */
+			xTaskCreate( prvInterruptSimulatorTask, "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, NULL );
+
+			printf( "xNetworkInterfaceInitialise: wire %s <-> %s\n", pcLocalPath, pcPeerPath );
+			xReturn = pdPASS;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vWireSetImpairment( uint32_t ulDelayUs, uint32_t ulNewLossPPM, uint64_t ullNewBitsPerSecond )
+{
+	taskENTER_CRITICAL();
+	{
+		ullDelayNs = ( ( uint64_t ) ulDelayUs ) * wireNANO_PER_MICRO;
+		ulLossPPM = ulNewLossPPM;
+		ullBitsPerSecond = ullNewBitsPerSecond;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vWireGetStats( WireStats_t *pxStats, BaseType_t xReset )
+{
+	memcpy( pxStats, ( const void * ) &xWireStats, sizeof( *pxStats ) );
+
+	if( xReset != pdFALSE )
+	{
+		/* A frame that is counted while clearing may be lost from the
+		statistics, which is good enough for a measurement. */
+		memset( ( void * ) &xWireStats, '\0', sizeof( xWireStats ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceOutput( NetworkBufferDescriptor_t * const pxNetworkBuffer, BaseType_t bReleaseAfterSend )
+{
+WireFrameHeader_t xHeader;
+uint64_t ullStart, ullDeparture;
+const uint8_t ucWakeUp = 0u;
+
+	iptraceNETWORK_INTERFACE_TRANSMIT();
+
+	xWireStats.ullTxFrames++;
+	xWireStats.ullTxBytes += pxNetworkBuffer->xDataLength;
+
+	if( prvFrameIsLost() != pdFALSE )
+	{
+		xWireStats.ullTxLost++;
+	}
+	else if( uxStreamBufferGetSpace( xSendBuffer ) < ( pxNetworkBuffer->xDataLength + sizeof( xHeader ) ) )
+	{
+		xWireStats.ullTxQueueDrops++;
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			/* The frame is serialised once the wire is free, and arrives at
+			the peer after the propagation delay. */
+			ullStart = prvNow();
+
+			if( ullStart < ullLastDeparture )
+			{
+				ullStart = ullLastDeparture;
+			}
+
+			ullDeparture = ullStart;
+
+			if( ullBitsPerSecond != 0u )
+			{
+				ullDeparture += ( ( ( uint64_t ) pxNetworkBuffer->xDataLength ) * 8u * wireNANO_PER_SECOND ) / ullBitsPerSecond;
+			}
+
+			ullLastDeparture = ullDeparture;
+			xHeader.ullDeliverAt = ullDeparture + ullDelayNs;
+		}
+		taskEXIT_CRITICAL();
+
+		xHeader.uxLength = pxNetworkBuffer->xDataLength;
+		uxStreamBufferAdd( xSendBuffer, 0, ( const uint8_t * ) &xHeader, sizeof( xHeader ) );
+		uxStreamBufferAdd( xSendBuffer, 0, ( const uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+
+		/* Let the Linux thread know that there is work to do.  When the pipe
+		is full it is awake anyway. */
+		( void ) write( iWakeUpPipe[ 1 ], &ucWakeUp, sizeof( ucWakeUp ) );
+	}
+
+	/* The buffer has been sent so can be released. */
+	if( bReleaseAfterSend != pdFALSE )
+	{
+		vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNow( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( ( uint64_t ) xNow.tv_sec ) * wireNANO_PER_SECOND + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFrameIsLost( void )
+{
+BaseType_t xLost = pdFALSE;
+
+	if( ulLossPPM != 0u )
+	{
+		/* A xorshift generator: cheap and the same sequence on every run. */
+		ulLossState ^= ulLossState << 13;
+		ulLossState ^= ulLossState >> 17;
+		ulLossState ^= ulLossState << 5;
+
+		if( ( ulLossState % 1000000u ) < ulLossPPM )
+		{
+			xLost = pdTRUE;
+		}
+	}
+
+	return xLost;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWireSendThread( void *pvParam )
+{
+uint8_t ucBuffer[ ipTOTAL_ETHERNET_FRAME_SIZE ];
+uint8_t ucWakeUp[ 64 ];
+WireFrameHeader_t xHeader;
+struct pollfd xPoll;
+uint64_t ullNow;
+int iTimeout;
+
+	/* THIS IS A LINUX THREAD - DO NOT ATTEMPT ANY FREERTOS CALLS OR TO PRINT
+	OUT MESSAGES HERE. */
+	( void ) pvParam;
+
+	xPoll.fd = iWakeUpPipe[ 0 ];
+	xPoll.events = POLLIN;
+
+	for( ;; )
+	{
+		/* Block until a frame is queued, or until the first frame is due. */
+		iTimeout = -1;
+
+		if( uxStreamBufferGetSize( xSendBuffer ) >= sizeof( xHeader ) )
+		{
+			uxStreamBufferGet( xSendBuffer, 0, ( uint8_t * ) &xHeader, sizeof( xHeader ), pdTRUE );
+		}
+		else
+		{
+			xHeader.uxLength = 0u;
+		}
+
+		/* The header is added before the frame, so the frame may still be on
+		its way in.  xNetworkInterfaceOutput() writes to the pipe after both. */
+		if( ( xHeader.uxLength != 0u ) &&
+			( uxStreamBufferGetSize( xSendBuffer ) >= ( sizeof( xHeader ) + xHeader.uxLength ) ) )
+		{
+			ullNow = prvNow();
+
+			if( xHeader.ullDeliverAt <= ullNow )
+			{
+				uxStreamBufferGet( xSendBuffer, 0, NULL, sizeof( xHeader ), pdFALSE );
+				uxStreamBufferGet( xSendBuffer, 0, ucBuffer, xHeader.uxLength, pdFALSE );
+
+				if( sendto( iWireSocket, ucBuffer, xHeader.uxLength, 0, ( struct sockaddr * ) &xPeerAddress, sizeof( xPeerAddress ) ) < 0 )
+				{
+					/* The peer is not running (yet): the frame is lost on the
+					wire, as it would be with a cable unplugged. */
+					xWireStats.ullTxErrors++;
+				}
+
+				continue;
+			}
+
+			/* Round up to the next millisecond, poll() does not do better.
+			Waking up early once a second is harmless. */
+			ullNow = ( xHeader.ullDeliverAt - ullNow + 999999u ) / 1000000u;
+			iTimeout = ( ullNow < 1000u ) ? ( int ) ullNow : 1000;
+		}
+
+		if( poll( &xPoll, 1, iTimeout ) > 0 )
+		{
+			( void ) read( iWakeUpPipe[ 0 ], ucWakeUp, sizeof( ucWakeUp ) );
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWireRecvThread( void *pvParam )
+{
+uint8_t ucBuffer[ ipTOTAL_ETHERNET_FRAME_SIZE ];
+ssize_t xLength;
+size_t uxLength;
+
+	/* THIS IS A LINUX THREAD - DO NOT ATTEMPT ANY FREERTOS CALLS OR TO PRINT
+	OUT MESSAGES HERE. */
+	( void ) pvParam;
+
+	for( ;; )
+	{
+		xLength = recv( iWireSocket, ucBuffer, sizeof( ucBuffer ), 0 );
+
+		if( xLength <= 0 )
+		{
+			if( ( xLength < 0 ) && ( errno != EINTR ) )
+			{
+				/* Do not spin on a broken socket. */
+				usleep( 10000 );
+			}
+			continue;
+		}
+
+		uxLength = ( size_t ) xLength;
+
+		/* Pass the length followed by the frame, or drop the frame when the
+		circular buffer is full. */
+		if( uxStreamBufferGetSpace( xRecvBuffer ) >= ( uxLength + sizeof( uxLength ) ) )
+		{
+			uxStreamBufferAdd( xRecvBuffer, 0, ( const uint8_t * ) &uxLength, sizeof( uxLength ) );
+			uxStreamBufferAdd( xRecvBuffer, 0, ucBuffer, uxLength );
+			xWireStats.ullRxFrames++;
+			xWireStats.ullRxBytes += uxLength;
+		}
+		else
+		{
+			xWireStats.ullRxDrops++;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSimulatorTask( void *pvParameters )
+{
+size_t uxLength;
+uint8_t ucRecvBuffer[ ipTOTAL_ETHERNET_FRAME_SIZE ];
+NetworkBufferDescriptor_t *pxNetworkBuffer;
+IPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
+
+	/* Remove compiler warnings about unused parameters. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Does the circular buffer used to pass data from the Linux thread
+		into the FreeRTOS simulator contain another frame? */
+		uxLength = 0u;
+
+		if( uxStreamBufferGetSize( xRecvBuffer ) > sizeof( uxLength ) )
+		{
+			uxStreamBufferGet( xRecvBuffer, 0, ( uint8_t * ) &uxLength, sizeof( uxLength ), pdTRUE );
+		}
+
+		/* The length is added before the frame, take the frame only once all
+		of it is there. */
+		if( ( uxLength != 0u ) &&
+			( uxStreamBufferGetSize( xRecvBuffer ) >= ( sizeof( uxLength ) + uxLength ) ) )
+		{
+			uxStreamBufferGet( xRecvBuffer, 0, NULL, sizeof( uxLength ), pdFALSE );
+			uxStreamBufferGet( xRecvBuffer, 0, ucRecvBuffer, uxLength, pdFALSE );
+
+			iptraceNETWORK_INTERFACE_RECEIVE();
+
+			/* Check for minimal size. */
+			if( ( uxLength < sizeof( EthernetHeader_t ) ) ||
+				( ipCONSIDER_FRAME_FOR_PROCESSING( ucRecvBuffer ) != eProcessBuffer ) )
+			{
+				continue;
+			}
+
+			/* Obtain a buffer into which the data can be placed.  This is only
+			an interrupt simulator, not a real interrupt, so it is ok to call
+			the task level function here. */
+			pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxLength, 0 );
+
+			if( pxNetworkBuffer != NULL )
+			{
+				memcpy( pxNetworkBuffer->pucEthernetBuffer, ucRecvBuffer, uxLength );
+				pxNetworkBuffer->xDataLength = uxLength;
+				xRxEvent.pvData = ( void * ) pxNetworkBuffer;
+
+				/* Data was received and stored.  Send a message to the IP task
+				to let it know. */
+				if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 0 ) == pdFAIL )
+				{
+					vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+					iptraceETHERNET_RX_EVENT_LOST();
+				}
+			}
+			else
+			{
+				iptraceETHERNET_RX_EVENT_LOST();
+			}
+		}
+		else
+		{
+			/* There is no real way of simulating an interrupt.  Make sure
+			other tasks can run. */
+			vTaskDelay( configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
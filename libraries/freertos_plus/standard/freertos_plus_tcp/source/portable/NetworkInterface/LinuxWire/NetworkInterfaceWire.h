@@ -0,0 +1,66 @@
+/*
+FreeRTOS+TCP V2.0.11
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+*/
+
+#ifndef NETWORK_INTERFACE_WIRE_H
+#define NETWORK_INTERFACE_WIRE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Counters of the simulated wire, as seen from this end. */
+typedef struct xWIRE_STATS
+{
+	uint64_t ullTxFrames;		/* Frames handed to the wire by the stack. */
+	uint64_t ullTxBytes;		/* Bytes of those frames. */
+	uint64_t ullTxLost;			/* Frames dropped by the simulated loss. */
+	uint64_t ullTxQueueDrops;	/* Frames dropped because the queue was full. */
+	uint64_t ullTxErrors;		/* Frames the peer was not there to receive. */
+	uint64_t ullRxFrames;		/* Frames received from the peer. */
+	uint64_t ullRxBytes;		/* Bytes of those frames. */
+	uint64_t ullRxDrops;		/* Frames dropped because the stack did not keep up. */
+} WireStats_t;
+
+/*
+ * Change the impairment of the outgoing direction of the wire.  Frames
+ * already queued keep their delivery time.
+ *
+ * ulDelayUs:        one-way propagation delay in microseconds.
+ * ulLossPPM:        probability that a frame is lost, in parts per million.
+ * ullBitsPerSecond: the bandwidth of the wire, 0 means unlimited.
+ */
+void vWireSetImpairment( uint32_t ulDelayUs, uint32_t ulLossPPM, uint64_t ullBitsPerSecond );
+
+/*
+ * Copy the counters of the wire into pxStats, and clear them when xReset is
+ * non-zero.
+ */
+void vWireGetStats( WireStats_t *pxStats, BaseType_t xReset );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* NETWORK_INTERFACE_WIRE_H */
@@ -30,6 +30,13 @@ uint32_t TEST_FreeRTOS_TCP_prvParseDNSReply( uint8_t * pucUDPPayloadBuffer,
                                              size_t xBufferLength,
                                              TickType_t xIdentifier );
 
+#if ( ipconfigUSE_DNS_CACHE == 1 )
+    BaseType_t TEST_FreeRTOS_TCP_prvProcessDNSCache( const char * pcName,
+                                                     uint32_t * pulIP,
+                                                     uint32_t ulTTL,
+                                                     BaseType_t xLookUp );
+#endif
+
 void TEST_FreeRTOS_TCP_prvCheckOptions( FreeRTOS_Socket_t * pxSocket,
                                         NetworkBufferDescriptor_t * pxNetworkBuffer );
 
@@ -45,4 +45,15 @@ uint32_t TEST_FreeRTOS_TCP_prvParseDNSReply( uint8_t * pucUDPPayloadBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_DNS_CACHE == 1 )
+    BaseType_t TEST_FreeRTOS_TCP_prvProcessDNSCache( const char * pcName,
+                                                     uint32_t * pulIP,
+                                                     uint32_t ulTTL,
+                                                     BaseType_t xLookUp )
+    {
+        return prvProcessDNSCache( pcName, pulIP, ulTTL, xLookUp );
+    }
+#endif
+/*-----------------------------------------------------------*/
+
 #endif /* ifndef _AWS_FREERTOS_TCP_TEST_ACCESS_DNS_DEFINE_H_ */
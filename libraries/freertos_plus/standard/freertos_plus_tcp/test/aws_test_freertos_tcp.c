@@ -30,10 +30,14 @@
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "list.h"
 #include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
 #include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_ARP.h"
 #include "FreeRTOS_DNS.h"
+#include "NetworkBufferManagement.h"
 
 /* Test includes. */
 #include "unity_fixture.h"
@@ -43,6 +47,44 @@
 /**
  * @brief Configuration for this test group.
  */
+#define tcptestLOOKUP_FIRST_PORT    ( 50000u )     /* Local ports of the sockets of the lookup benchmark. */
+#define tcptestLOOKUP_REMOTE_IP     ( 0xc0a80a00UL ) /* Remote addresses used for missing connections. */
+#define tcptestLOOKUP_COUNT         ( 10000u )     /* Number of lookups per measurement. */
+#define tcptestLOOKUP_CONNECT_PORT  ( 49100u )     /* Ports of the listening sockets of the connected lookups. */
+#define tcptestLOOKUP_CONNECTIONS   ( 4u )         /* Connections made for the connected lookups. */
+#define tcptestLOOKUP_CLOSE_MS      ( 1000u )      /* Time the IP-task gets to close a socket. */
+
+#define tcptestCC_MSS               ( 1460UL )                       /* Segment size of the congestion control simulation. */
+#define tcptestCC_ISS               ( 0x7ffff000UL )                 /* Initial sequence number, wraps during the transfer. */
+#define tcptestCC_TRANSFER_SIZE     ( 100UL * tcptestCC_MSS )        /* Bytes sent in each simulated transfer. */
+#define tcptestCC_WINDOW            ( 32UL * tcptestCC_MSS )         /* Transmission window and the peer's reception window. */
+#define tcptestCC_BUFFER            ( 48UL * tcptestCC_MSS )         /* Size of the simulated transmission buffer. */
+#define tcptestCC_MAX_PACKETS       ( 64u )                          /* Packets that can be on the path in each direction. */
+#define tcptestCC_MAX_DURATION_MS   ( 20000UL )                      /* A transfer taking longer has failed. */
+
+#define tcptestCHECKSUM_BUFFER      ( 1600u )    /* Largest buffer of the checksum fuzz test. */
+#define tcptestCHECKSUM_ROUNDS      ( 20000u )   /* Random buffers compared with the reference. */
+#define tcptestCHECKSUM_BENCHMARK   ( 20000u )   /* Checksums of a full frame per round of the benchmark. */
+#define tcptestCHECKSUM_BENCHMARK_MS ( 500u )    /* Rounds run for at least this long, far above the tick. */
+
+#define tcptestBUFFER_HELD          ( 8u )       /* Network buffers held at the same time by the allocation test. */
+#define tcptestBUFFER_ROUNDS        ( 2000u )    /* Rounds of the allocation latency measurement. */
+
+#define tcptestARP_ADDRESSES        ( ipconfigARP_CACHE_ENTRIES + 4u ) /* Addresses stored in the ARP cache, more than fit. */
+#define tcptestARP_LOOKUPS          ( 20000u )                         /* Lookups per measurement. */
+
+#define tcptestDNS_NAMES            ( ipconfigDNS_CACHE_ENTRIES + 2u ) /* Names stored in the DNS cache, more than fit. */
+
+#define tcptestZERO_COPY_PORT       ( 49000u )   /* Port of the listening socket of the zero-copy test. */
+#define tcptestZERO_COPY_SIZE       ( 1000u )    /* Bytes sent in one segment by the zero-copy test. */
+#define tcptestZERO_COPY_RELEASE    ( 100u )     /* Bytes released first, to check that the tail advances. */
+
+/* Set to 1 where the frames that the stack sends to its own address come
+ * back to it, as on the host, whose wire is its own peer.  The tests that need
+ * connected TCP sockets are skipped otherwise. */
+#ifndef tcptestLOOPBACK
+    #define tcptestLOOPBACK         ( 0 )
+#endif
 
 /*
  * @brief Test group definition.
@@ -68,6 +110,31 @@ TEST_GROUP_RUNNER( Full_FREERTOS_TCP )
 
     /* xProcessReceivedUDPPacket test. */
     RUN_TEST_CASE( Full_FREERTOS_TCP, UDPPacketLength );
+
+    /* pxTCPSocketLookup benchmark. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, TCPSocketLookup );
+
+    /* Congestion control simulation. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, TCPCongestionControl );
+
+    /* Retransmissions with one and with multiple SACK blocks. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, TCPSelectiveAck );
+
+    /* usGenerateChecksum and RFC 1624 update tests. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, usGenerateChecksum );
+    RUN_TEST_CASE( Full_FREERTOS_TCP, usChecksumUpdate );
+
+    /* Zero-copy TCP API test. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, TCPZeroCopy );
+
+    /* Network buffer allocation footprint and latency. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, NetworkBufferAllocation );
+
+    /* ARP cache replacement and lookup time. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, ARPCacheLookup );
+
+    /* DNS cache time-to-live, negative answers and replacement. */
+    RUN_TEST_CASE( Full_FREERTOS_TCP, DNSCache );
 }
 
 TEST( Full_FREERTOS_TCP, prvParseDnsResponse )
@@ -360,3 +427,1173 @@ TEST( Full_FREERTOS_TCP, UDPPacketLength )
     xReturn = xProcessReceivedUDPPacket( &xNetworkBuffer, usPort );
     TEST_ASSERT_EQUAL_UINT32( pdFAIL, xReturn );
 }
+
+#if ( tcptestLOOPBACK == 1 )
+
+/*
+ * Connect a socket to a listening socket of the stack itself, over the wire
+ * that loops back.  Both ends of the connection, and the listening socket,
+ * are returned.
+ */
+static void prvLoopbackConnect( uint16_t usPort,
+                                Socket_t * pxListener,
+                                Socket_t * pxClient,
+                                Socket_t * pxServer )
+{
+    struct freertos_sockaddr xAddress;
+    uint32_t ulIPAddress = FreeRTOS_GetIPAddress();
+
+    /* The stack would ask for its own address in vain. */
+    vARPRefreshCacheEntry( ( const MACAddress_t * ) FreeRTOS_GetMACAddress(), ulIPAddress );
+
+    *pxListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, *pxListener );
+
+    xAddress.sin_addr = 0;
+    xAddress.sin_port = FreeRTOS_htons( usPort );
+    TEST_ASSERT_EQUAL_INT32( 0, FreeRTOS_bind( *pxListener, &xAddress, sizeof( xAddress ) ) );
+    TEST_ASSERT_EQUAL_INT32( 0, FreeRTOS_listen( *pxListener, 1 ) );
+
+    *pxClient = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, *pxClient );
+
+    xAddress.sin_addr = ulIPAddress;
+    TEST_ASSERT_EQUAL_INT32( 0, FreeRTOS_connect( *pxClient, &xAddress, sizeof( xAddress ) ) );
+
+    *pxServer = FreeRTOS_accept( *pxListener, NULL, NULL );
+    TEST_ASSERT_NOT_NULL( *pxServer );
+    TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, *pxServer );
+}
+
+#endif /* if ( tcptestLOOPBACK == 1 ) */
+
+/*
+ * Time uxCount lookups of the sockets in pxSockets, with the scheduler
+ * suspended so that the IP-task does not change the hash tables meanwhile.
+ * The tick count catches up when the scheduler is resumed.  Unless
+ * xListening is set, every socket is looked up with its own remote address
+ * and port, which are zero for sockets that are not connected.
+ */
+static TickType_t prvTimeLookups( Socket_t * pxSockets,
+                                  UBaseType_t uxSockets,
+                                  BaseType_t xListening )
+{
+    TickType_t xStart;
+    UBaseType_t uxIndex, uxFound = 0;
+    FreeRTOS_Socket_t * pxSocket;
+    uint32_t ulRemoteIP;
+    UBaseType_t uxRemotePort;
+
+    xStart = xTaskGetTickCount();
+    vTaskSuspendAll();
+
+    for( uxIndex = 0; uxIndex < tcptestLOOKUP_COUNT; uxIndex++ )
+    {
+        pxSocket = ( FreeRTOS_Socket_t * ) pxSockets[ uxIndex % uxSockets ];
+
+        if( xListening != pdFALSE )
+        {
+            /* No connection exists: the listening socket must be found. */
+            ulRemoteIP = tcptestLOOKUP_REMOTE_IP + ( uxIndex & 0xffu );
+            uxRemotePort = 1024u + uxIndex;
+        }
+        else
+        {
+            ulRemoteIP = pxSocket->u.xTCP.ulRemoteIP;
+            uxRemotePort = pxSocket->u.xTCP.usRemotePort;
+        }
+
+        if( pxTCPSocketLookup( 0, pxSocket->usLocalPort, ulRemoteIP, uxRemotePort ) == pxSocket )
+        {
+            uxFound++;
+        }
+    }
+
+    ( void ) xTaskResumeAll();
+
+    TEST_ASSERT_EQUAL_UINT32( tcptestLOOKUP_COUNT, uxFound );
+
+    return xTaskGetTickCount() - xStart;
+}
+
+#if ( tcptestLOOPBACK == 1 )
+
+/*
+ * Look up a socket, with the scheduler suspended so that the IP-task does not
+ * change the hash tables meanwhile.
+ */
+static FreeRTOS_Socket_t * prvLookup( UBaseType_t uxLocalPort,
+                                      uint32_t ulRemoteIP,
+                                      UBaseType_t uxRemotePort )
+{
+    FreeRTOS_Socket_t * pxFound;
+
+    vTaskSuspendAll();
+    pxFound = pxTCPSocketLookup( 0, uxLocalPort, ulRemoteIP, uxRemotePort );
+    ( void ) xTaskResumeAll();
+
+    return pxFound;
+}
+
+/*
+ * Close xSocket, and wait until the IP-task has unbound it: until a lookup of
+ * the given address no longer finds it.  Returns what that lookup finds then.
+ */
+static FreeRTOS_Socket_t * prvCloseAndLookup( Socket_t xSocket,
+                                              UBaseType_t uxLocalPort,
+                                              uint32_t ulRemoteIP,
+                                              UBaseType_t uxRemotePort )
+{
+    FreeRTOS_Socket_t * pxFound;
+    TickType_t xStart = xTaskGetTickCount();
+
+    TEST_ASSERT_EQUAL_INT32( 1, FreeRTOS_closesocket( xSocket ) );
+
+    for( ; ; )
+    {
+        pxFound = prvLookup( uxLocalPort, ulRemoteIP, uxRemotePort );
+
+        if( ( pxFound != ( FreeRTOS_Socket_t * ) xSocket ) ||
+            ( ( xTaskGetTickCount() - xStart ) > pdMS_TO_TICKS( tcptestLOOKUP_CLOSE_MS ) ) )
+        {
+            break;
+        }
+
+        vTaskDelay( 1 );
+    }
+
+    TEST_ASSERT_NOT_EQUAL( ( FreeRTOS_Socket_t * ) xSocket, pxFound );
+
+    return pxFound;
+}
+
+/*
+ * Look up the sockets of connections over the loopback: a connecting socket
+ * is rehashed once its remote address is known, and so is the child socket
+ * that a listening socket creates for a SYN.  Closing the sockets must remove
+ * them from the connection hash as well as from the port hash.
+ */
+static void prvLookupConnected( void )
+{
+    Socket_t xListeners[ tcptestLOOKUP_CONNECTIONS ];
+    Socket_t xSockets[ 2u * tcptestLOOKUP_CONNECTIONS ];
+    FreeRTOS_Socket_t * pxClient, * pxServer;
+    uint32_t ulIPAddress = FreeRTOS_ntohl( FreeRTOS_GetIPAddress() );
+    UBaseType_t uxIndex, uxServerPort, uxClientPort;
+    TickType_t xConnected;
+
+    for( uxIndex = 0; uxIndex < tcptestLOOKUP_CONNECTIONS; uxIndex++ )
+    {
+        prvLoopbackConnect( ( uint16_t ) ( tcptestLOOKUP_CONNECT_PORT + uxIndex ),
+                            &xListeners[ uxIndex ],
+                            &xSockets[ 2u * uxIndex ],
+                            &xSockets[ ( 2u * uxIndex ) + 1u ] );
+
+        pxClient = ( FreeRTOS_Socket_t * ) xSockets[ 2u * uxIndex ];
+        pxServer = ( FreeRTOS_Socket_t * ) xSockets[ ( 2u * uxIndex ) + 1u ];
+
+        /* Both ends know the address and port of their peer. */
+        TEST_ASSERT_EQUAL_UINT32( ulIPAddress, pxClient->u.xTCP.ulRemoteIP );
+        TEST_ASSERT_EQUAL_UINT32( tcptestLOOKUP_CONNECT_PORT + uxIndex, pxClient->u.xTCP.usRemotePort );
+        TEST_ASSERT_EQUAL_UINT32( ulIPAddress, pxServer->u.xTCP.ulRemoteIP );
+        TEST_ASSERT_EQUAL_UINT32( pxClient->usLocalPort, pxServer->u.xTCP.usRemotePort );
+        TEST_ASSERT_EQUAL_UINT32( tcptestLOOKUP_CONNECT_PORT + uxIndex, pxServer->usLocalPort );
+    }
+
+    /* The child socket, not the listening socket with the same local port,
+     * is found for the address of the client. */
+    xConnected = prvTimeLookups( xSockets, 2u * tcptestLOOKUP_CONNECTIONS, pdFALSE );
+
+    configPRINTF( ( "TCP lookup with %u connections: %u ms per %u exact lookups\r\n",
+                    ( unsigned ) tcptestLOOKUP_CONNECTIONS,
+                    ( unsigned ) ( xConnected * portTICK_PERIOD_MS ),
+                    ( unsigned ) tcptestLOOKUP_COUNT ) );
+
+    pxClient = ( FreeRTOS_Socket_t * ) xSockets[ 0 ];
+    uxServerPort = tcptestLOOKUP_CONNECT_PORT;
+    uxClientPort = pxClient->usLocalPort;
+
+    /* Any other peer gets the listening socket. */
+    TEST_ASSERT_EQUAL_PTR( xListeners[ 0 ], prvLookup( uxServerPort, ulIPAddress, uxClientPort + 1u ) );
+    TEST_ASSERT_EQUAL_PTR( xListeners[ 0 ], prvLookup( uxServerPort, ulIPAddress + 1u, uxClientPort ) );
+
+    /* Once the child socket has left the connection hash, the client's
+     * address leads to the listening socket.  Once that has left the port
+     * hash as well, nothing is found. */
+    TEST_ASSERT_EQUAL_PTR( xListeners[ 0 ], prvCloseAndLookup( xSockets[ 1 ], uxServerPort, ulIPAddress, uxClientPort ) );
+    TEST_ASSERT_NULL( prvCloseAndLookup( xListeners[ 0 ], uxServerPort, ulIPAddress, uxClientPort ) );
+    TEST_ASSERT_NULL( prvCloseAndLookup( xSockets[ 0 ], uxClientPort, ulIPAddress, uxServerPort ) );
+
+    for( uxIndex = 1; uxIndex < tcptestLOOKUP_CONNECTIONS; uxIndex++ )
+    {
+        ( void ) FreeRTOS_closesocket( xSockets[ 2u * uxIndex ] );
+        ( void ) FreeRTOS_closesocket( xSockets[ ( 2u * uxIndex ) + 1u ] );
+        ( void ) FreeRTOS_closesocket( xListeners[ uxIndex ] );
+    }
+}
+
+#endif /* if ( tcptestLOOPBACK == 1 ) */
+
+TEST( Full_FREERTOS_TCP, TCPSocketLookup )
+{
+    static const UBaseType_t uxSocketCounts[] = { 8, 64, 256 };
+    struct freertos_sockaddr xAddress;
+    Socket_t * pxSockets;
+    UBaseType_t uxRound, uxIndex, uxCreated;
+    uint16_t usPort = tcptestLOOKUP_FIRST_PORT;
+    TickType_t xUnconnected, xListening;
+
+    #if ( tcptestLOOPBACK == 1 )
+        prvLookupConnected();
+    #endif
+
+    for( uxRound = 0; uxRound < sizeof( uxSocketCounts ) / sizeof( uxSocketCounts[ 0 ] ); uxRound++ )
+    {
+        pxSockets = pvPortMalloc( uxSocketCounts[ uxRound ] * sizeof( Socket_t ) );
+        TEST_ASSERT_NOT_NULL( pxSockets );
+
+        /* Every socket gets a port of its own: closed sockets are only
+         * unbound by the IP-task, so the ports of a round are not reused. */
+        for( uxCreated = 0; uxCreated < uxSocketCounts[ uxRound ]; uxCreated++ )
+        {
+            pxSockets[ uxCreated ] = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+            if( pxSockets[ uxCreated ] == FREERTOS_INVALID_SOCKET )
+            {
+                break;
+            }
+
+            xAddress.sin_addr = 0;
+            xAddress.sin_port = FreeRTOS_htons( usPort );
+            usPort++;
+
+            if( FreeRTOS_bind( pxSockets[ uxCreated ], &xAddress, sizeof( xAddress ) ) != 0 )
+            {
+                ( void ) FreeRTOS_closesocket( pxSockets[ uxCreated ] );
+                break;
+            }
+        }
+
+        if( uxCreated == uxSocketCounts[ uxRound ] )
+        {
+            /* Bound sockets that are not connected have a remote address
+             * and port of zero. */
+            xUnconnected = prvTimeLookups( pxSockets, uxCreated, pdFALSE );
+
+            for( uxIndex = 0; uxIndex < uxCreated; uxIndex++ )
+            {
+                TEST_ASSERT_EQUAL_INT32( 0, FreeRTOS_listen( pxSockets[ uxIndex ], 1 ) );
+            }
+
+            xListening = prvTimeLookups( pxSockets, uxCreated, pdTRUE );
+
+            configPRINTF( ( "TCP lookup with %u sockets: %u ms per %u exact lookups, %u ms per %u listener lookups\r\n",
+                            ( unsigned ) uxCreated,
+                            ( unsigned ) ( xUnconnected * portTICK_PERIOD_MS ),
+                            ( unsigned ) tcptestLOOKUP_COUNT,
+                            ( unsigned ) ( xListening * portTICK_PERIOD_MS ),
+                            ( unsigned ) tcptestLOOKUP_COUNT ) );
+        }
+        else
+        {
+            configPRINTF( ( "TCP lookup: only %u of %u sockets could be created\r\n",
+                            ( unsigned ) uxCreated,
+                            ( unsigned ) uxSocketCounts[ uxRound ] ) );
+        }
+
+        for( uxIndex = 0; uxIndex < uxCreated; uxIndex++ )
+        {
+            ( void ) FreeRTOS_closesocket( pxSockets[ uxIndex ] );
+        }
+
+        vPortFree( pxSockets );
+
+        if( uxCreated != uxSocketCounts[ uxRound ] )
+        {
+            TEST_IGNORE_MESSAGE( "Not enough memory for the larger socket counts." );
+        }
+    }
+}
+
+#if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+/*
+ * A path for the congestion control simulation: data segments pass a
+ * bottleneck with a drop-tail queue, are lost at random, and arrive after a
+ * one-way delay.  The receiver is a TCP window as well: every segment is
+ * acknowledged at once, with the SACK blocks of the data that arrived out of
+ * order.  ACK's may get lost as well.
+ */
+typedef struct xCONGESTION_PATH
+{
+    uint32_t ulDelayMs;         /* One-way delay, in both directions. */
+    uint32_t ulLossPerMille;    /* Random loss of data segments. */
+    uint32_t ulBytesPerMs;      /* Rate of the bottleneck. */
+    uint32_t ulQueueLength;     /* Segments that fit in the bottleneck queue. */
+    uint32_t ulAckLossPerMille; /* Random loss of ACK's. */
+} CongestionPath_t;
+
+typedef struct xCONGESTION_PACKET
+{
+    uint32_t ulSequenceNumber;  /* Data: first byte.  ACK: the cumulative ACK. */
+    uint32_t ulLength;          /* Data only: length. */
+    uint32_t ulSackEdges[ 2 * ipconfigTCP_SACK_BLOCKS ]; /* ACK only: the SACK blocks. */
+    BaseType_t xSackBlocks;     /* ACK only: number of SACK blocks. */
+    uint32_t ulDepartureUs;     /* Data only: leaves the bottleneck queue. */
+    uint32_t ulArrivalUs;       /* Moment of arrival at the other side. */
+    BaseType_t xInUse;
+} CongestionPacket_t;
+
+static CongestionPacket_t xCongestionData[ tcptestCC_MAX_PACKETS ];
+static CongestionPacket_t xCongestionAcks[ tcptestCC_MAX_PACKETS ];
+static TCPWindow_t xCongestionWindow;
+static TCPWindow_t xCongestionReceiver;
+
+static CongestionPacket_t * prvCongestionSlot( CongestionPacket_t * pxPackets )
+{
+    UBaseType_t uxIndex;
+    CongestionPacket_t * pxReturn = NULL;
+
+    for( uxIndex = 0; uxIndex < tcptestCC_MAX_PACKETS; uxIndex++ )
+    {
+        if( pxPackets[ uxIndex ].xInUse == pdFALSE )
+        {
+            pxReturn = &( pxPackets[ uxIndex ] );
+            break;
+        }
+    }
+
+    return pxReturn;
+}
+
+/* A linear congruential generator, so that every run is the same.  Returns
+ * a number from 0 to 999. */
+static uint32_t prvCongestionRandom( uint32_t * pulRandom )
+{
+    *pulRandom = ( *pulRandom * 1103515245UL ) + 12345UL;
+
+    return ( *pulRandom >> 16 ) % 1000UL;
+}
+
+/*
+ * Put a data segment on the path, unless it is dropped by the random loss
+ * or by a full bottleneck queue.
+ */
+static void prvCongestionSend( const CongestionPath_t * pxPath,
+                               uint32_t ulSequenceNumber,
+                               uint32_t ulLength,
+                               uint32_t ulNowUs,
+                               uint32_t * pulLinkFreeUs,
+                               uint32_t * pulRandom )
+{
+    UBaseType_t uxIndex, uxQueued = 0;
+    CongestionPacket_t * pxPacket;
+
+    for( uxIndex = 0; uxIndex < tcptestCC_MAX_PACKETS; uxIndex++ )
+    {
+        if( ( xCongestionData[ uxIndex ].xInUse != pdFALSE ) &&
+            ( xCongestionData[ uxIndex ].ulDepartureUs > ulNowUs ) )
+        {
+            uxQueued++;
+        }
+    }
+
+    pxPacket = prvCongestionSlot( xCongestionData );
+
+    if( ( uxQueued < pxPath->ulQueueLength ) &&
+        ( prvCongestionRandom( pulRandom ) >= pxPath->ulLossPerMille ) &&
+        ( pxPacket != NULL ) )
+    {
+        if( *pulLinkFreeUs < ulNowUs )
+        {
+            *pulLinkFreeUs = ulNowUs;
+        }
+
+        *pulLinkFreeUs += ( ulLength * 1000UL ) / pxPath->ulBytesPerMs;
+
+        pxPacket->ulSequenceNumber = ulSequenceNumber;
+        pxPacket->ulLength = ulLength;
+        pxPacket->ulDepartureUs = *pulLinkFreeUs;
+        pxPacket->ulArrivalUs = *pulLinkFreeUs + ( pxPath->ulDelayMs * 1000UL );
+        pxPacket->xInUse = pdTRUE;
+    }
+}
+
+/*
+ * The receiver: pass the data segments that have arrived to the reception
+ * window and send an ACK for each of them, with at most xSackBlocks of the
+ * SACK blocks that the window prepared.
+ */
+static void prvCongestionReceive( const CongestionPath_t * pxPath,
+                                  uint32_t ulNowUs,
+                                  BaseType_t xSackBlocks,
+                                  uint32_t * pulRandom )
+{
+    TCPWindow_t * pxReceiver = &( xCongestionReceiver );
+    UBaseType_t uxIndex;
+    BaseType_t xBlock;
+    CongestionPacket_t * pxData, * pxAck;
+
+    for( uxIndex = 0; uxIndex < tcptestCC_MAX_PACKETS; uxIndex++ )
+    {
+        pxData = &( xCongestionData[ uxIndex ] );
+
+        if( ( pxData->xInUse == pdFALSE ) || ( pxData->ulArrivalUs > ulNowUs ) )
+        {
+            continue;
+        }
+
+        pxData->xInUse = pdFALSE;
+
+        /* The application reads all data at once, the space is always the
+         * full window. */
+        ( void ) lTCPWindowRxCheck( pxReceiver, pxData->ulSequenceNumber, pxData->ulLength, tcptestCC_WINDOW );
+
+        pxAck = prvCongestionSlot( xCongestionAcks );
+
+        if( ( pxAck == NULL ) || ( prvCongestionRandom( pulRandom ) < pxPath->ulAckLossPerMille ) )
+        {
+            continue;
+        }
+
+        pxAck->ulSequenceNumber = pxReceiver->rx.ulCurrentSequenceNumber;
+        pxAck->xSackBlocks = 0;
+
+        /* The option is NOP, NOP, SACK, LEN followed by the blocks. */
+        if( pxReceiver->ucOptionLength != 0u )
+        {
+            pxAck->xSackBlocks = FreeRTOS_min_int32( xSackBlocks, ( ( int32_t ) pxReceiver->ucOptionLength - 4 ) / 8 );
+
+            for( xBlock = 0; xBlock < 2 * pxAck->xSackBlocks; xBlock++ )
+            {
+                pxAck->ulSackEdges[ xBlock ] = FreeRTOS_ntohl( pxReceiver->ulOptionsData[ xBlock + 1 ] );
+            }
+        }
+
+        pxAck->ulArrivalUs = ulNowUs + ( pxPath->ulDelayMs * 1000UL );
+        pxAck->xInUse = pdTRUE;
+    }
+}
+
+/*
+ * Transfer tcptestCC_TRANSFER_SIZE bytes over the path with the window code
+ * of FreeRTOS+TCP.  The time runs in ticks, as it does for the window code.
+ * The receiver reports at most xSackBlocks SACK blocks in each ACK.  Returns
+ * the goodput in bytes per second, or 0 if the transfer did not finish in
+ * time, and the number of bytes that were sent more than once.
+ */
+static uint32_t prvCongestionTransfer( const CongestionPath_t * pxPath,
+                                       BaseType_t xAlgorithm,
+                                       BaseType_t xSackBlocks,
+                                       uint32_t * pulRetransmitted )
+{
+    TCPWindow_t * pxWindow = &( xCongestionWindow );
+    TickType_t xStart, xNow;
+    uint32_t ulNowUs, ulLinkFreeUs = 0UL, ulRandom = 1UL;
+    uint32_t ulAdded = 0UL, ulAcked = 0UL, ulLength, ulElapsedMs;
+    uint32_t ulHighestSent = tcptestCC_ISS;
+    int32_t lPosition;
+    UBaseType_t uxIndex;
+    CongestionPacket_t * pxAck;
+
+    memset( xCongestionData, 0, sizeof( xCongestionData ) );
+    memset( xCongestionAcks, 0, sizeof( xCongestionAcks ) );
+    memset( pxWindow, 0, sizeof( *pxWindow ) );
+    memset( &( xCongestionReceiver ), 0, sizeof( xCongestionReceiver ) );
+    *pulRetransmitted = 0UL;
+
+    /* The window functions are normally only called by the IP-task, which
+     * shares the segment pool.  Keep the scheduler suspended while they are
+     * used. */
+    vTaskSuspendAll();
+    {
+        vTCPWindowCreate( pxWindow, tcptestCC_WINDOW, tcptestCC_WINDOW, 0UL, tcptestCC_ISS, tcptestCC_MSS );
+        ( void ) xTCPWindowCongestionSelect( pxWindow, xAlgorithm );
+        vTCPWindowCreate( &( xCongestionReceiver ), tcptestCC_WINDOW, tcptestCC_WINDOW, tcptestCC_ISS, 0UL, tcptestCC_MSS );
+    }
+    ( void ) xTaskResumeAll();
+
+    xStart = xTaskGetTickCount();
+    xNow = xStart;
+
+    while( ( ulAcked < tcptestCC_TRANSFER_SIZE ) &&
+           ( ( xNow - xStart ) < pdMS_TO_TICKS( tcptestCC_MAX_DURATION_MS ) ) )
+    {
+        ulNowUs = ( uint32_t ) ( xNow - xStart ) * portTICK_PERIOD_MS * 1000UL;
+
+        vTaskSuspendAll();
+        {
+            prvCongestionReceive( pxPath, ulNowUs, xSackBlocks, &ulRandom );
+
+            for( uxIndex = 0; uxIndex < tcptestCC_MAX_PACKETS; uxIndex++ )
+            {
+                pxAck = &( xCongestionAcks[ uxIndex ] );
+
+                if( ( pxAck->xInUse != pdFALSE ) && ( pxAck->ulArrivalUs <= ulNowUs ) )
+                {
+                    /* Like prvCheckOptions() does, handle the SACK first. */
+                    if( pxAck->xSackBlocks != 0 )
+                    {
+                        ulAcked += ulTCPWindowTxSackBlocks( pxWindow, pxAck->ulSackEdges, pxAck->xSackBlocks );
+                    }
+
+                    ulAcked += ulTCPWindowTxAck( pxWindow, pxAck->ulSequenceNumber );
+                    pxAck->xInUse = pdFALSE;
+                }
+            }
+
+            /* The application keeps the transmission buffer filled. */
+            while( ( ulAdded < tcptestCC_TRANSFER_SIZE ) && ( ( ulAdded - ulAcked ) < tcptestCC_BUFFER ) )
+            {
+                ulLength = FreeRTOS_min_uint32( tcptestCC_MSS, tcptestCC_TRANSFER_SIZE - ulAdded );
+
+                if( lTCPWindowTxAdd( pxWindow, ulLength, ( int32_t ) ( ulAdded % tcptestCC_BUFFER ), tcptestCC_BUFFER ) <= 0 )
+                {
+                    break;
+                }
+
+                ulAdded += ulLength;
+            }
+
+            while( ( ulLength = ulTCPWindowTxGet( pxWindow, tcptestCC_WINDOW, &lPosition ) ) != 0UL )
+            {
+                if( ( int32_t ) ( pxWindow->ulOurSequenceNumber - ulHighestSent ) < 0 )
+                {
+                    *pulRetransmitted += ulLength;
+                }
+                else
+                {
+                    ulHighestSent = pxWindow->ulOurSequenceNumber + ulLength;
+                }
+
+                prvCongestionSend( pxPath, pxWindow->ulOurSequenceNumber, ulLength, ulNowUs, &ulLinkFreeUs, &ulRandom );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        vTaskDelay( 1 );
+        xNow = xTaskGetTickCount();
+    }
+
+    ulElapsedMs = ( uint32_t ) ( xNow - xStart ) * portTICK_PERIOD_MS;
+
+    configPRINTF( ( "TCP %s, %d SACK blocks, delay %u ms, loss %u/1000: %u bytes in %u ms, %u bytes/s, %u retransmitted, cwnd %u ssthresh %u\r\n",
+                    ( xAlgorithm == FREERTOS_TCP_CC_CUBIC ) ? "CUBIC" : "NewReno",
+                    ( int ) xSackBlocks,
+                    ( unsigned ) pxPath->ulDelayMs,
+                    ( unsigned ) pxPath->ulLossPerMille,
+                    ( unsigned ) ulAcked,
+                    ( unsigned ) ulElapsedMs,
+                    ( unsigned ) ( ( ( uint64_t ) ulAcked * 1000ULL ) / FreeRTOS_max_uint32( ulElapsedMs, 1UL ) ),
+                    ( unsigned ) *pulRetransmitted,
+                    ( unsigned ) pxWindow->xCongestion.ulCWnd,
+                    ( unsigned ) pxWindow->xCongestion.ulSSThresh ) );
+
+    vTaskSuspendAll();
+    {
+        vTCPWindowDestroy( pxWindow );
+        vTCPWindowDestroy( &( xCongestionReceiver ) );
+    }
+    ( void ) xTaskResumeAll();
+
+    return ( ulAcked < tcptestCC_TRANSFER_SIZE ) ? 0UL : ( uint32_t ) ( ( ( uint64_t ) ulAcked * 1000ULL ) / FreeRTOS_max_uint32( ulElapsedMs, 1UL ) );
+}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+TEST( Full_FREERTOS_TCP, TCPCongestionControl )
+{
+    #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        /* Delay in ms, loss per mille, bottleneck rate in bytes per ms,
+         * queue length in segments, ACK loss per mille, and the minimum
+         * goodput in bytes/s. */
+        static const struct
+        {
+            CongestionPath_t xPath;
+            uint32_t ulMinimumGoodput;
+        }
+        xPaths[] =
+        {
+            { { 10, 0,  200, 8,  0 }, 100000 },
+            { { 10, 10, 200, 8,  0 }, 0      },
+            { { 25, 20, 200, 8,  0 }, 0      },
+            { { 50, 0,  500, 16, 0 }, 0      },
+            { { 50, 30, 500, 16, 0 }, 0      },
+        };
+        static const BaseType_t xAlgorithms[] =
+        {
+            FREERTOS_TCP_CC_NEWRENO,
+            #if ( ipconfigUSE_TCP_CUBIC != 0 )
+                FREERTOS_TCP_CC_CUBIC,
+            #endif
+        };
+        UBaseType_t uxAlgorithm, uxPath;
+        uint32_t ulGoodput, ulRetransmitted;
+
+        for( uxAlgorithm = 0; uxAlgorithm < sizeof( xAlgorithms ) / sizeof( xAlgorithms[ 0 ] ); uxAlgorithm++ )
+        {
+            for( uxPath = 0; uxPath < sizeof( xPaths ) / sizeof( xPaths[ 0 ] ); uxPath++ )
+            {
+                ulGoodput = prvCongestionTransfer( &( xPaths[ uxPath ].xPath ), xAlgorithms[ uxAlgorithm ], ipconfigTCP_SACK_BLOCKS, &ulRetransmitted );
+
+                TEST_ASSERT_NOT_EQUAL_MESSAGE( 0UL, ulGoodput, "Simulated transfer did not complete" );
+                TEST_ASSERT_TRUE_MESSAGE( ulGoodput >= xPaths[ uxPath ].ulMinimumGoodput, "Goodput below the minimum for this path" );
+            }
+        }
+    #else /* if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+        TEST_IGNORE_MESSAGE( "ipconfigUSE_TCP_CONGESTION_CONTROL is not enabled." );
+    #endif /* if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_FREERTOS_TCP, TCPSelectiveAck )
+{
+    #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        /* Lossy paths: delay in ms, loss per mille, bottleneck rate in bytes
+         * per ms, queue length in segments and ACK loss per mille.  When
+         * ACK's get lost, the repeated blocks tell the sender what it missed. */
+        static const CongestionPath_t xPaths[] =
+        {
+            { 10, 20, 200, 8,  400 },
+            { 25, 20, 200, 16, 400 },
+            { 50, 20, 200, 8,  400 },
+            { 50, 50, 200, 16, 400 },
+        };
+        UBaseType_t uxPath;
+        uint32_t ulSingle, ulMultiple, ulSingleTotal = 0UL, ulMultipleTotal = 0UL;
+
+        for( uxPath = 0; uxPath < sizeof( xPaths ) / sizeof( xPaths[ 0 ] ); uxPath++ )
+        {
+            /* The receiver reports one block, like it did before... */
+            TEST_ASSERT_NOT_EQUAL_MESSAGE( 0UL,
+                                           prvCongestionTransfer( &( xPaths[ uxPath ] ), FREERTOS_TCP_CC_NEWRENO, 1, &ulSingle ),
+                                           "Simulated transfer did not complete" );
+
+            /* ...and as many blocks as the option can hold. */
+            TEST_ASSERT_NOT_EQUAL_MESSAGE( 0UL,
+                                           prvCongestionTransfer( &( xPaths[ uxPath ] ), FREERTOS_TCP_CC_NEWRENO, ipconfigTCP_SACK_BLOCKS, &ulMultiple ),
+                                           "Simulated transfer did not complete" );
+
+            configPRINTF( ( "Path %u ms, %u/1000 lost: %u bytes retransmitted with 1 SACK block, %u with %d\r\n",
+                            ( unsigned ) xPaths[ uxPath ].ulDelayMs,
+                            ( unsigned ) xPaths[ uxPath ].ulLossPerMille,
+                            ( unsigned ) ulSingle,
+                            ( unsigned ) ulMultiple,
+                            ( int ) ipconfigTCP_SACK_BLOCKS ) );
+
+            /* The blocks tell the sender which segments have arrived, so it
+             * sends fewer of them again.  Every path loses segments, and the
+             * losses are the same in both runs, so each path must gain. */
+            TEST_ASSERT_TRUE_MESSAGE( ulMultiple < ulSingle, "Multiple SACK blocks did not reduce the retransmissions on a lossy path" );
+
+            ulSingleTotal += ulSingle;
+            ulMultipleTotal += ulMultiple;
+        }
+
+        configPRINTF( ( "Retransmitted bytes: %u with 1 SACK block, %u with %d SACK blocks\r\n",
+                        ( unsigned ) ulSingleTotal,
+                        ( unsigned ) ulMultipleTotal,
+                        ( int ) ipconfigTCP_SACK_BLOCKS ) );
+    #else /* if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+        TEST_IGNORE_MESSAGE( "ipconfigUSE_TCP_CONGESTION_CONTROL is not enabled." );
+    #endif /* if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) */
+}
+
+/*-----------------------------------------------------------*/
+
+/* A simple pseudo random generator, so that failures can be repeated. */
+static uint32_t prvChecksumRand( uint32_t * pulSeed )
+{
+    *pulSeed = ( *pulSeed * 1103515245UL ) + 12345UL;
+
+    return *pulSeed >> 8;
+}
+
+/* Straightforward RFC 1071 checksum over big-endian 16-bit words, returning
+ * the sum in the same form as usGenerateChecksum(). */
+static uint16_t prvReferenceChecksum( uint32_t ulSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength )
+{
+    size_t uxIndex;
+
+    for( uxIndex = 0; ( uxIndex + 1u ) < uxLength; uxIndex += 2u )
+    {
+        ulSum += ( ( uint32_t ) pucData[ uxIndex ] << 8 ) | pucData[ uxIndex + 1u ];
+    }
+
+    if( ( uxLength & 1u ) != 0u )
+    {
+        ulSum += ( uint32_t ) pucData[ uxLength - 1u ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0UL )
+    {
+        ulSum = ( ulSum & 0xffffUL ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+TEST( Full_FREERTOS_TCP, usGenerateChecksum )
+{
+    uint8_t * pucBuffer;
+    uint32_t ulSeed = 0x1234UL, ulRound, ulStart, ulCount = 0UL;
+    size_t uxOffset, uxLength, uxIndex;
+    TickType_t xStart, xElapsed;
+    volatile uint16_t usSink = 0u;
+
+    /* Allocated, so that the offsets below give every alignment. */
+    pucBuffer = pvPortMalloc( tcptestCHECKSUM_BUFFER + 8u );
+    TEST_ASSERT_NOT_NULL( pucBuffer );
+
+    for( ulRound = 0; ulRound < tcptestCHECKSUM_ROUNDS; ulRound++ )
+    {
+        uxOffset = prvChecksumRand( &ulSeed ) % 8u;
+        uxLength = prvChecksumRand( &ulSeed ) % ( ( ( ulRound & 1UL ) != 0UL ) ? 64u : tcptestCHECKSUM_BUFFER );
+
+        /* Buffers filled with 0xFF produce the most carries. */
+        for( uxIndex = 0; uxIndex < uxLength; uxIndex++ )
+        {
+            pucBuffer[ uxOffset + uxIndex ] = ( ( ulRound % 7UL ) == 0UL ) ? 0xffu : ( uint8_t ) prvChecksumRand( &ulSeed );
+        }
+
+        /* The stack only passes a start value together with 16-bit aligned
+         * data (the pseudo header), for odd addresses it must be zero. */
+        ulStart = ( ( ( ( uintptr_t ) pucBuffer + uxOffset ) & 1u ) != 0u ) ? 0UL : ( prvChecksumRand( &ulSeed ) & 0xffffUL );
+
+        TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( ulStart, pucBuffer + uxOffset, uxLength ),
+                                 usGenerateChecksum( ulStart, pucBuffer + uxOffset, uxLength ) );
+    }
+
+    /* Benchmark: checksums of a full-size aligned frame.  A fast target gets
+     * through a round within a few ticks, so rounds are added until the time
+     * taken can be measured to within a percent. */
+    memset( pucBuffer, 0xa5, tcptestCHECKSUM_BUFFER );
+    xStart = xTaskGetTickCount();
+
+    do
+    {
+        for( ulRound = 0; ulRound < tcptestCHECKSUM_BENCHMARK; ulRound++ )
+        {
+            usSink += usGenerateChecksum( 0UL, pucBuffer, ipconfigNETWORK_MTU );
+        }
+
+        ulCount += tcptestCHECKSUM_BENCHMARK;
+        xElapsed = xTaskGetTickCount() - xStart;
+    } while( xElapsed < pdMS_TO_TICKS( tcptestCHECKSUM_BENCHMARK_MS ) );
+
+    configPRINTF( ( "usGenerateChecksum (%s): %u x %u bytes in %u ms, %u KB/s\r\n",
+                    ( ipconfigUSE_FAST_CHECKSUM != 0 ) ? "fast" : "classic",
+                    ( unsigned ) ulCount,
+                    ( unsigned ) ipconfigNETWORK_MTU,
+                    ( unsigned ) ( xElapsed * portTICK_PERIOD_MS ),
+                    ( unsigned ) ( ( ( uint64_t ) ulCount * ipconfigNETWORK_MTU ) /
+                                   ( uint32_t ) ( xElapsed * portTICK_PERIOD_MS ) ) ) );
+
+    vPortFree( pucBuffer );
+}
+
+TEST( Full_FREERTOS_TCP, usChecksumUpdate )
+{
+    uint8_t ucHeader[ ipSIZE_OF_IPv4_HEADER ];
+    uint32_t ulSeed = 0x5678UL, ulRound, ulOldAddress, ulNewAddress;
+    uint16_t usChecksum, usOldWord, usNewWord;
+    size_t uxIndex;
+
+    for( ulRound = 0; ulRound < tcptestCHECKSUM_ROUNDS; ulRound++ )
+    {
+        for( uxIndex = 0; uxIndex < sizeof( ucHeader ); uxIndex++ )
+        {
+            ucHeader[ uxIndex ] = ( uint8_t ) prvChecksumRand( &ulSeed );
+        }
+
+        /* Bytes 10 and 11 hold the header checksum.  A header with a correct
+         * checksum sums up to 0xFFFF. */
+        ucHeader[ 10 ] = 0u;
+        ucHeader[ 11 ] = 0u;
+        usChecksum = ( uint16_t ) ~FreeRTOS_htons( usGenerateChecksum( 0UL, ucHeader, sizeof( ucHeader ) ) );
+        memcpy( &( ucHeader[ 10 ] ), &usChecksum, sizeof( usChecksum ) );
+
+        /* Rewrite the source address, as NAT would. */
+        memcpy( &ulOldAddress, &( ucHeader[ 12 ] ), sizeof( ulOldAddress ) );
+        ulNewAddress = ( ( ulRound % 3UL ) == 0UL ) ? 0UL : ( prvChecksumRand( &ulSeed ) ^ ( prvChecksumRand( &ulSeed ) << 16 ) );
+        memcpy( &( ucHeader[ 12 ] ), &ulNewAddress, sizeof( ulNewAddress ) );
+        usChecksum = usChecksumUpdate32( usChecksum, ulOldAddress, ulNewAddress );
+        memcpy( &( ucHeader[ 10 ] ), &usChecksum, sizeof( usChecksum ) );
+        TEST_ASSERT_EQUAL_HEX16( 0xffffu, usGenerateChecksum( 0UL, ucHeader, sizeof( ucHeader ) ) );
+
+        /* Rewrite the TTL and protocol word. */
+        memcpy( &usOldWord, &( ucHeader[ 8 ] ), sizeof( usOldWord ) );
+        usNewWord = ( uint16_t ) prvChecksumRand( &ulSeed );
+        memcpy( &( ucHeader[ 8 ] ), &usNewWord, sizeof( usNewWord ) );
+        usChecksum = usChecksumUpdate16( usChecksum, usOldWord, usNewWord );
+        memcpy( &( ucHeader[ 10 ] ), &usChecksum, sizeof( usChecksum ) );
+        TEST_ASSERT_EQUAL_HEX16( 0xffffu, usGenerateChecksum( 0UL, ucHeader, sizeof( ucHeader ) ) );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+TEST( Full_FREERTOS_TCP, TCPZeroCopy )
+{
+    Socket_t xSocket;
+    uint8_t * pucHead;
+    uint8_t ucData = 0u;
+    BaseType_t xLength;
+
+    #if ( tcptestLOOPBACK == 1 )
+        Socket_t xListener, xClient, xServer;
+        uint8_t * pucData;
+        TickType_t xStart;
+        size_t uxIndex;
+    #endif
+
+    xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xSocket );
+
+    /* The transmission stream is created on demand, so that data can be
+     * written before the first call to FreeRTOS_send(). */
+    pucHead = FreeRTOS_get_tx_head( xSocket, &xLength );
+    TEST_ASSERT_NOT_NULL( pucHead );
+    TEST_ASSERT_EQUAL_INT32( FreeRTOS_tx_space( xSocket ), xLength );
+    TEST_ASSERT_TRUE( xLength >= ( BaseType_t ) ipconfigTCP_TX_BUFFER_LENGTH );
+
+    /* Nothing was borrowed from the reception stream. */
+    TEST_ASSERT_EQUAL_INT32( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_ReleaseTCPPayloadBuffer( xSocket, &ucData, 1 ) );
+
+    TEST_ASSERT_EQUAL_INT32( 1, FreeRTOS_closesocket( xSocket ) );
+
+    #if ( tcptestLOOPBACK == 1 )
+        prvLoopbackConnect( tcptestZERO_COPY_PORT, &xListener, &xClient, &xServer );
+
+        /* Write the data in place, and commit it by passing the head back. */
+        pucHead = FreeRTOS_get_tx_head( xClient, &xLength );
+        TEST_ASSERT_NOT_NULL( pucHead );
+        TEST_ASSERT_TRUE( xLength >= ( BaseType_t ) tcptestZERO_COPY_SIZE );
+
+        for( uxIndex = 0; uxIndex < tcptestZERO_COPY_SIZE; uxIndex++ )
+        {
+            pucHead[ uxIndex ] = ( uint8_t ) ( uxIndex * 7u );
+        }
+
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_SIZE, FreeRTOS_send( xClient, pucHead, tcptestZERO_COPY_SIZE, 0 ) );
+
+        /* Wait until all of it has arrived, so that one call lends it all. */
+        xStart = xTaskGetTickCount();
+
+        while( ( FreeRTOS_recvcount( xServer ) < ( BaseType_t ) tcptestZERO_COPY_SIZE ) &&
+               ( ( xTaskGetTickCount() - xStart ) < pdMS_TO_TICKS( 5000 ) ) )
+        {
+            vTaskDelay( 1 );
+        }
+
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_SIZE, FreeRTOS_recv( xServer, &pucData, 0, FREERTOS_ZERO_COPY ) );
+
+        for( uxIndex = 0; uxIndex < tcptestZERO_COPY_SIZE; uxIndex++ )
+        {
+            TEST_ASSERT_EQUAL_HEX8( ( uint8_t ) ( uxIndex * 7u ), pucData[ uxIndex ] );
+        }
+
+        /* Releasing part of the data moves the tail past it only. */
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_RELEASE, FreeRTOS_ReleaseTCPPayloadBuffer( xServer, pucData, tcptestZERO_COPY_RELEASE ) );
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_SIZE - tcptestZERO_COPY_RELEASE, FreeRTOS_recvcount( xServer ) );
+        TEST_ASSERT_EQUAL_INT32( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_ReleaseTCPPayloadBuffer( xServer, pucData, 1 ) );
+
+        pucHead = pucData;
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_SIZE - tcptestZERO_COPY_RELEASE, FreeRTOS_recv( xServer, &pucData, 0, FREERTOS_ZERO_COPY ) );
+        TEST_ASSERT_EQUAL_PTR( pucHead + tcptestZERO_COPY_RELEASE, pucData );
+        TEST_ASSERT_EQUAL_HEX8( ( uint8_t ) ( tcptestZERO_COPY_RELEASE * 7u ), pucData[ 0 ] );
+
+        TEST_ASSERT_EQUAL_INT32( tcptestZERO_COPY_SIZE - tcptestZERO_COPY_RELEASE,
+                                 FreeRTOS_ReleaseTCPPayloadBuffer( xServer, pucData, tcptestZERO_COPY_SIZE - tcptestZERO_COPY_RELEASE ) );
+        TEST_ASSERT_EQUAL_INT32( 0, FreeRTOS_recvcount( xServer ) );
+
+        ( void ) FreeRTOS_closesocket( xServer );
+        ( void ) FreeRTOS_closesocket( xClient );
+        ( void ) FreeRTOS_closesocket( xListener );
+    #endif /* if ( tcptestLOOPBACK == 1 ) */
+}
+
+/*-----------------------------------------------------------*/
+
+/* Sum the buffers in use, and the static RAM, of all size classes. */
+static UBaseType_t prvBuffersInUse( size_t * puxStaticBytes )
+{
+    NetworkBufferStats_t xStats;
+    UBaseType_t uxClass, uxInUse = 0u;
+
+    *puxStaticBytes = 0u;
+
+    for( uxClass = 0u; xGetNetworkBufferStats( uxClass, &xStats ) == pdPASS; uxClass++ )
+    {
+        uxInUse += xStats.uxInUse;
+        *puxStaticBytes += xStats.uxStaticBytes;
+    }
+
+    return uxInUse;
+}
+
+TEST( Full_FREERTOS_TCP, NetworkBufferAllocation )
+{
+    /* Typical sizes: TCP ACKs, a DNS request, a DHCP packet and full frames. */
+    static const size_t uxSizes[ tcptestBUFFER_HELD ] = { 60u, 60u, 90u, 342u, 60u, 590u, ipTOTAL_ETHERNET_FRAME_SIZE, ipTOTAL_ETHERNET_FRAME_SIZE };
+    NetworkBufferDescriptor_t * pxBuffers[ tcptestBUFFER_HELD ];
+    NetworkBufferStats_t xStats;
+    UBaseType_t uxIndex, uxClass, uxInUseBefore, uxInUseHeld;
+    uint32_t ulRound;
+    size_t uxStaticBytes, uxHeapBefore, uxHeapHeld;
+    TickType_t xStart, xElapsed;
+
+    TEST_ASSERT_EQUAL_INT32( pdPASS, xGetNetworkBufferStats( 0u, &xStats ) );
+    TEST_ASSERT_TRUE( uxGetNumberOfFreeNetworkBuffers() > tcptestBUFFER_HELD );
+
+    /* Keep the IP-task from using buffers during the measurements. */
+    vTaskSuspendAll();
+    {
+        uxInUseBefore = prvBuffersInUse( &uxStaticBytes );
+        uxHeapBefore = xPortGetFreeHeapSize();
+
+        for( uxIndex = 0u; uxIndex < tcptestBUFFER_HELD; uxIndex++ )
+        {
+            pxBuffers[ uxIndex ] = pxGetNetworkBufferWithDescriptor( uxSizes[ uxIndex ], 0u );
+        }
+
+        uxHeapHeld = xPortGetFreeHeapSize();
+        uxInUseHeld = prvBuffersInUse( &uxStaticBytes );
+
+        for( uxIndex = 0u; uxIndex < tcptestBUFFER_HELD; uxIndex++ )
+        {
+            if( pxBuffers[ uxIndex ] != NULL )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxBuffers[ uxIndex ] );
+            }
+        }
+
+        /* Latency of an allocation and a release, averaged over the sizes. */
+        xStart = xTaskGetTickCount();
+
+        for( ulRound = 0u; ulRound < tcptestBUFFER_ROUNDS; ulRound++ )
+        {
+            for( uxIndex = 0u; uxIndex < tcptestBUFFER_HELD; uxIndex++ )
+            {
+                pxBuffers[ 0 ] = pxGetNetworkBufferWithDescriptor( uxSizes[ uxIndex ], 0u );
+
+                if( pxBuffers[ 0 ] != NULL )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxBuffers[ 0 ] );
+                }
+            }
+        }
+
+        xElapsed = xTaskGetTickCount() - xStart;
+    }
+    ( void ) xTaskResumeAll();
+
+    for( uxIndex = 0u; uxIndex < tcptestBUFFER_HELD; uxIndex++ )
+    {
+        TEST_ASSERT_NOT_NULL( pxBuffers[ uxIndex ] );
+    }
+
+    /* Every buffer occupies one descriptor and one block. */
+    TEST_ASSERT_EQUAL_UINT32( uxInUseBefore + tcptestBUFFER_HELD, uxInUseHeld );
+
+    configPRINTF( ( "Network buffers (%s size): %u bytes static, %u bytes of heap for %u buffers, %u ns per allocation and release\r\n",
+                    ( xBufferAllocFixedSize != pdFALSE ) ? "fixed" : "variable",
+                    ( unsigned ) uxStaticBytes,
+                    ( unsigned ) ( uxHeapBefore - uxHeapHeld ),
+                    ( unsigned ) tcptestBUFFER_HELD,
+                    ( unsigned ) ( ( ( uint64_t ) xElapsed * portTICK_PERIOD_MS * 1000000ULL ) / ( tcptestBUFFER_ROUNDS * tcptestBUFFER_HELD ) ) ) );
+
+    for( uxClass = 0u; xGetNetworkBufferStats( uxClass, &xStats ) == pdPASS; uxClass++ )
+    {
+        configPRINTF( ( "    class %u: %u x %u bytes, %u in use, at most %u, %u failures\r\n",
+                        ( unsigned ) uxClass,
+                        ( unsigned ) xStats.uxBlockCount,
+                        ( unsigned ) xStats.uxBlockSize,
+                        ( unsigned ) xStats.uxInUse,
+                        ( unsigned ) xStats.uxMaxInUse,
+                        ( unsigned ) xStats.uxFailures ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* An address on the local network, so that the ARP cache will store it. */
+static uint32_t prvARPTestAddress( UBaseType_t uxIndex )
+{
+    return ( *ipLOCAL_IP_ADDRESS_POINTER & xNetworkAddressing.ulNetMask ) |
+           ( FreeRTOS_htonl( ( uint32_t ) uxIndex + 1UL ) & ~xNetworkAddressing.ulNetMask );
+}
+
+TEST( Full_FREERTOS_TCP, ARPCacheLookup )
+{
+    MACAddress_t xMACAddress = { { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x00 } };
+    MACAddress_t xFound;
+    uint32_t ulAddress;
+    UBaseType_t uxIndex, uxHits = 0, uxWrongMAC = 0, uxLookupHits = 0;
+    BaseType_t xChanged;
+    TickType_t xStart, xElapsed;
+
+    /* The ARP cache is normally only used by the IP-task.  Keep the scheduler
+     * suspended while it is filled with test entries, and clear it at the end
+     * so that the real entries are learned again. */
+    vTaskSuspendAll();
+    {
+        FreeRTOS_ClearARP();
+
+        /* There are more addresses than rows: the oldest entries make place. */
+        for( uxIndex = 0; uxIndex < tcptestARP_ADDRESSES; uxIndex++ )
+        {
+            xMACAddress.ucBytes[ 5 ] = ( uint8_t ) uxIndex;
+            vARPRefreshCacheEntry( &xMACAddress, prvARPTestAddress( uxIndex ) );
+        }
+
+        for( uxIndex = 0; uxIndex < tcptestARP_ADDRESSES; uxIndex++ )
+        {
+            ulAddress = prvARPTestAddress( uxIndex );
+
+            if( eARPGetCacheEntry( &ulAddress, &xFound ) == eARPCacheHit )
+            {
+                uxHits++;
+
+                if( xFound.ucBytes[ 5 ] != ( uint8_t ) uxIndex )
+                {
+                    uxWrongMAC++;
+                }
+            }
+        }
+
+        /* A device that changes its MAC address. */
+        xMACAddress.ucBytes[ 4 ] = 0x01;
+        xMACAddress.ucBytes[ 5 ] = ( uint8_t ) ( tcptestARP_ADDRESSES - 1u );
+        vARPRefreshCacheEntry( &xMACAddress, prvARPTestAddress( tcptestARP_ADDRESSES - 1u ) );
+        ulAddress = prvARPTestAddress( tcptestARP_ADDRESSES - 1u );
+        xChanged = ( eARPGetCacheEntry( &ulAddress, &xFound ) == eARPCacheHit ) &&
+                   ( memcmp( xFound.ucBytes, xMACAddress.ucBytes, sizeof( xFound.ucBytes ) ) == 0 );
+
+        /* The time of a lookup, hits and misses mixed. */
+        xStart = xTaskGetTickCount();
+
+        for( uxIndex = 0; uxIndex < tcptestARP_LOOKUPS; uxIndex++ )
+        {
+            ulAddress = prvARPTestAddress( uxIndex % tcptestARP_ADDRESSES );
+
+            if( eARPGetCacheEntry( &ulAddress, &xFound ) == eARPCacheHit )
+            {
+                uxLookupHits++;
+            }
+        }
+
+        FreeRTOS_ClearARP();
+    }
+    ( void ) xTaskResumeAll();
+
+    /* The tick count catches up when the scheduler is resumed. */
+    xElapsed = xTaskGetTickCount() - xStart;
+
+    configPRINTF( ( "ARP cache with %u entries: %u ms per %u lookups, %u hits\r\n",
+                    ( unsigned ) ipconfigARP_CACHE_ENTRIES,
+                    ( unsigned ) ( xElapsed * portTICK_PERIOD_MS ),
+                    ( unsigned ) tcptestARP_LOOKUPS,
+                    ( unsigned ) uxLookupHits ) );
+
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( ipconfigARP_CACHE_ENTRIES, uxHits, "Every row of the ARP cache must be used" );
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE( 0, uxWrongMAC, "ARP cache returned the MAC address of another entry" );
+    TEST_ASSERT_TRUE_MESSAGE( xChanged, "ARP cache did not store the new MAC address" );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_DNS_CACHE == 1 )
+    /* Write the name "d" followed by four hexadecimal digits. */
+    static void prvDNSTestName( char * pcName,
+                                UBaseType_t uxIndex )
+    {
+        static const char cDigits[] = "0123456789abcdef";
+        BaseType_t xDigit;
+
+        pcName[ 0 ] = 'd';
+
+        for( xDigit = 4; xDigit > 0; xDigit-- )
+        {
+            pcName[ xDigit ] = cDigits[ uxIndex & 0x0fu ];
+            uxIndex >>= 4;
+        }
+
+        pcName[ 5 ] = '\0';
+    }
+#endif /* ipconfigUSE_DNS_CACHE == 1 */
+
+TEST( Full_FREERTOS_TCP, DNSCache )
+{
+    #if ( ipconfigUSE_DNS_CACHE == 1 )
+        /* An answer for "other.test" with a TTL of one hour. */
+        uint8_t ucUnsolicitedReply[] =
+        {
+            0x12, 0x34, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+            0x05, 'o',  't',  'h',  'e',  'r',  0x04, 't',  'e',  's',  't',  0x00,
+            0x00, 0x01, 0x00, 0x01, 0xc0, 0x0c, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+            0x0e, 0x10, 0x00, 0x04, 0xc0, 0x00, 0x02, 0x0b
+        };
+        const uint32_t ulCachedAddress = FreeRTOS_inet_addr_quick( 192, 0, 2, 10 );
+        uint32_t ulAddress;
+        char pcName[ 6 ];
+        UBaseType_t uxIndex, uxWrong = 0;
+        TickType_t xStart, xElapsed;
+
+        FreeRTOS_dnsclear();
+
+        /* A positive answer is cached, until an answer with a TTL of zero. */
+        ulAddress = ulCachedAddress;
+        TEST_FreeRTOS_TCP_prvProcessDNSCache( "cache.test", &ulAddress, 3600UL, pdFALSE );
+        TEST_ASSERT_EQUAL_UINT32( ulCachedAddress, FreeRTOS_dnslookup( "cache.test" ) );
+        TEST_FreeRTOS_TCP_prvProcessDNSCache( "cache.test", &ulAddress, 0UL, pdFALSE );
+        TEST_ASSERT_EQUAL_UINT32( 0, FreeRTOS_dnslookup( "cache.test" ) );
+
+        /* A cached negative answer is returned without sending a query. */
+        ulAddress = 0UL;
+        TEST_FreeRTOS_TCP_prvProcessDNSCache( "missing.test", &ulAddress, 60UL, pdFALSE );
+        xStart = xTaskGetTickCount();
+        ulAddress = FreeRTOS_gethostbyname( "missing.test" );
+        xElapsed = xTaskGetTickCount() - xStart;
+        TEST_ASSERT_EQUAL_UINT32( 0, ulAddress );
+        TEST_ASSERT_TRUE_MESSAGE( xElapsed < pdMS_TO_TICKS( 100u ), "A negative answer was not taken from the DNS cache" );
+
+        /* A reply that does not answer an outstanding request is not cached. */
+        ulAddress = TEST_FreeRTOS_TCP_prvParseDNSReply( ucUnsolicitedReply,
+                                                        sizeof( ucUnsolicitedReply ),
+                                                        *( uint16_t * ) ucUnsolicitedReply );
+        TEST_ASSERT_EQUAL_UINT32( FreeRTOS_inet_addr_quick( 192, 0, 2, 11 ), ulAddress );
+        TEST_ASSERT_EQUAL_UINT32( 0, FreeRTOS_dnslookup( "other.test" ) );
+
+        /* There are more names than rows: the entries that expire first make
+         * place.  Keep the IP-task from adding real answers in the meantime. */
+        vTaskSuspendAll();
+        {
+            for( uxIndex = 0; uxIndex < tcptestDNS_NAMES; uxIndex++ )
+            {
+                prvDNSTestName( pcName, uxIndex );
+                ulAddress = ( uint32_t ) uxIndex + 1UL;
+                TEST_FreeRTOS_TCP_prvProcessDNSCache( pcName, &ulAddress, 1000UL + ( uint32_t ) uxIndex, pdFALSE );
+            }
+
+            for( uxIndex = 0; uxIndex < tcptestDNS_NAMES; uxIndex++ )
+            {
+                prvDNSTestName( pcName, uxIndex );
+                ulAddress = ( uxIndex < ( tcptestDNS_NAMES - ipconfigDNS_CACHE_ENTRIES ) ) ? 0UL : ( uint32_t ) uxIndex + 1UL;
+
+                if( FreeRTOS_dnslookup( pcName ) != ulAddress )
+                {
+                    uxWrong++;
+                }
+            }
+
+            FreeRTOS_dnsclear();
+        }
+        ( void ) xTaskResumeAll();
+
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE( 0, uxWrong, "DNS cache did not replace the entries that expire first" );
+    #else /* if ( ipconfigUSE_DNS_CACHE == 1 ) */
+        TEST_IGNORE_MESSAGE( "ipconfigUSE_DNS_CACHE is not enabled." );
+    #endif /* if ( ipconfigUSE_DNS_CACHE == 1 ) */
+}
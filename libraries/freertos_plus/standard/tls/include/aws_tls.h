@@ -41,9 +41,124 @@
 #define TLS_ERROR_HANDSHAKE_FAILED    ( -2001 )   /*!< Error in handshake. */
 #define TLS_ERROR_RNG                 ( -2002 )   /*!< Error in RNG. */
 #define TLS_ERROR_SIGN                ( -2003 )   /*!< Error in sign operation. */
+#define TLS_ERROR_WANT_READ           ( -2004 )   /*!< Handshake waits for data from the network. */
+#define TLS_ERROR_WANT_WRITE          ( -2005 )   /*!< Handshake waits for the network to take data. */
 
 /**@} */
 
+/**
+ * @brief Number of TLS sessions kept for resumption, one per server name.
+ *
+ * A reconnect to a server found in the cache offers the saved session ID and
+ * session ticket, which lets the server skip the key exchange and the client
+ * certificate signature. Set to 0 to disable session resumption.
+ */
+#ifndef tlsconfigSESSION_CACHE_ENTRIES
+    #define tlsconfigSESSION_CACHE_ENTRIES          2
+#endif
+
+/**
+ * @brief Maximum length of a cached server name, including the terminator.
+ *
+ * Connections to longer server names are not cached.
+ */
+#ifndef tlsconfigSESSION_CACHE_MAX_NAME_LENGTH
+    #define tlsconfigSESSION_CACHE_MAX_NAME_LENGTH  96
+#endif
+
+/**
+ * @brief Time after which a cached session is no longer offered.
+ *
+ * A shorter ticket lifetime hint sent by the server takes precedence.
+ */
+#ifndef tlsconfigSESSION_CACHE_LIFETIME_MS
+    #define tlsconfigSESSION_CACHE_LIFETIME_MS      ( 24UL * 60UL * 60UL * 1000UL )
+#endif
+
+/**
+ * @brief Set to 1 to hand cached sessions to the application for storage.
+ *
+ * The application must then provide xApplicationTlsSessionSave() and
+ * xApplicationTlsSessionLoad(), which typically keep the session in flash so
+ * that the first connection after a reset can be resumed too.
+ */
+#ifndef tlsconfigSESSION_CACHE_PERSIST
+    #define tlsconfigSESSION_CACHE_PERSIST          0
+#endif
+
+/**
+ * @brief Largest session ticket that is saved through the persistence hooks.
+ */
+#ifndef tlsconfigSESSION_CACHE_MAX_TICKET_LENGTH
+    #define tlsconfigSESSION_CACHE_MAX_TICKET_LENGTH    512
+#endif
+
+/**
+ * @brief Size of the largest session blob passed to the persistence hooks.
+ */
+#define tlsSESSION_BLOB_MAX_LENGTH    ( 128 + tlsconfigSESSION_CACHE_MAX_TICKET_LENGTH )
+
+/**
+ * @brief Largest TLS record the server is asked to send, in bytes.
+ *
+ * Requested with the RFC 6066 max_fragment_length extension; one of 512,
+ * 1024, 2048 or 4096. Any other value leaves the extension out. Records sent
+ * by the device never exceed this size, so once the handshake is over the
+ * output buffer of the connection shrinks to it, and so does the input
+ * buffer if the server accepted the extension.
+ */
+#ifndef tlsconfigMAX_FRAGMENT_LENGTH
+    #define tlsconfigMAX_FRAGMENT_LENGTH    4096
+#endif
+
+/**
+ * @brief Ciphersuites offered by connections that do not choose their own.
+ *
+ * Define as a comma-separated list of mbedTLS ciphersuite identifiers, most
+ * preferred first, for example:
+ *
+ * @code
+ * #define tlsconfigCIPHERSUITES                                \
+ *     MBEDTLS_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,   \
+ *     MBEDTLS_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256,     \
+ *     MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,         \
+ *     MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256
+ * @endcode
+ *
+ * When left undefined, every ciphersuite enabled in the mbedTLS configuration
+ * is offered in the mbedTLS default order, which puts ChaCha20-Poly1305
+ * first. On cores without AES acceleration it protects records about three
+ * times faster than AES-GCM.
+ */
+
+/**
+ * @brief Handshake statistics, accumulated over all TLS contexts since boot.
+ *
+ * @param[out] ulFullHandshakes Handshakes that performed a full key exchange.
+ * @param[out] ulResumedHandshakes Handshakes that resumed a cached session.
+ * @param[out] ulFailedHandshakes Handshakes that did not complete.
+ * @param[out] ulFullHandshakeMs Total duration of the full handshakes.
+ * @param[out] ulResumedHandshakeMs Total duration of the resumed handshakes.
+ * @param[out] ulLastHandshakeMs Duration of the most recent successful handshake.
+ * @param[out] ulCredentialLoads Number of times the device credentials were
+ * read from the PKCS#11 module and decoded.
+ * @param[out] ulCredentialLoadMs Total time spent loading the device credentials.
+ * @param[out] ulLastHandshakePeakHeap Largest amount of heap in use by the most
+ * recent successful TLS_Connect(), sampled between handshake messages.
+ */
+typedef struct xTLS_METRICS
+{
+    uint32_t ulFullHandshakes;
+    uint32_t ulResumedHandshakes;
+    uint32_t ulFailedHandshakes;
+    uint32_t ulFullHandshakeMs;
+    uint32_t ulResumedHandshakeMs;
+    uint32_t ulLastHandshakeMs;
+    uint32_t ulCredentialLoads;
+    uint32_t ulCredentialLoadMs;
+    uint32_t ulLastHandshakePeakHeap;
+} TLSMetrics_t;
+
 /**
  * @brief Defines callback type for receiving bytes from the network.
  *
@@ -51,7 +166,8 @@
  * @param[out] pucReceiveBuffer Buffer to fill with received data.
  * @param[in] xReceiveLength Length of previous parameter in bytes.
  *
- * @return The number of bytes actually read.
+ * @return The number of bytes actually read, or TLS_ERROR_WANT_READ if a
+ * non-blocking socket has no data yet.
  */
 typedef BaseType_t ( * NetworkRecv_t )( void * pvCallerContext,
                                         unsigned char * pucReceiveBuffer,
@@ -64,7 +180,8 @@ typedef BaseType_t ( * NetworkRecv_t )( void * pvCallerContext,
  * @param[out] pucReceiveBuffer Buffer of data to send.
  * @param[in] xReceiveLength Length of previous parameter in bytes.
  *
- * @return The number of bytes actually sent.
+ * @return The number of bytes actually sent, or TLS_ERROR_WANT_WRITE if a
+ * non-blocking socket cannot take data yet.
  */
 typedef BaseType_t ( * NetworkSend_t )( void * pvCallerContext,
                                         const unsigned char * pucData,
@@ -82,6 +199,12 @@ typedef BaseType_t ( * NetworkSend_t )( void * pvCallerContext,
  * @param[in] pxNetworkSend Caller-defined network send function pointer.
  * @param[in] pvCallerContext Caller-defined context handle to be used with callback
  * functions.
+ * @param[in] ulMaxFragmentLength Largest record the server is asked to send,
+ * or 0 for tlsconfigMAX_FRAGMENT_LENGTH.
+ * @param[in] pxCiphersuites Zero-terminated list of mbedTLS ciphersuite
+ * identifiers to offer, most preferred first, or NULL for the default list
+ * (see tlsconfigCIPHERSUITES). The list must remain valid until the context
+ * is deleted.
  */
 typedef struct xTLS_PARAMS
 {
@@ -95,6 +218,8 @@ typedef struct xTLS_PARAMS
     NetworkRecv_t pxNetworkRecv;
     NetworkSend_t pxNetworkSend;
     void * pvCallerContext;
+    const int * pxCiphersuites;
+    uint32_t ulMaxFragmentLength;
 } TLSParams_t;
 
 /**
@@ -117,6 +242,32 @@ BaseType_t TLS_Init( void ** ppvContext,
  */
 BaseType_t TLS_Connect( void * pvContext );
 
+/**
+ * @brief Prepares a handshake that TLS_ConnectStep() carries out.
+ *
+ * Together the two functions negotiate TLS over a non-blocking socket
+ * without tying up the calling task; TLS_Connect() is both in a loop.
+ *
+ * @param pvContext Opaque context handle for TLS library.
+ *
+ * @return Zero on success. Error return codes have the high bit set.
+ */
+BaseType_t TLS_ConnectStart( void * pvContext );
+
+/**
+ * @brief Advances the handshake as far as the network allows.
+ *
+ * Call again once the socket is readable after TLS_ERROR_WANT_READ, or
+ * writable after TLS_ERROR_WANT_WRITE.
+ *
+ * @param pvContext Opaque context handle for TLS library.
+ *
+ * @return Zero once connected, TLS_ERROR_WANT_READ or TLS_ERROR_WANT_WRITE
+ * while the handshake waits for the network. Other error return codes have
+ * the high bit set and end the handshake.
+ */
+BaseType_t TLS_ConnectStep( void * pvContext );
+
 /**
  * @brief Reads the requested number of bytes from the secure connection
  *
@@ -151,4 +302,61 @@ BaseType_t TLS_Send( void * pvContext,
  */
 void TLS_Cleanup( void * pvContext );
 
+/**
+ * @brief Copies the handshake statistics.
+ *
+ * @param[out] pxMetrics Receives the statistics.
+ */
+void TLS_GetMetrics( TLSMetrics_t * pxMetrics );
+
+/**
+ * @brief Discards the device credentials shared by the TLS contexts.
+ *
+ * The client certificate, the private key handle and the default root
+ * certificates are read and decoded by the first connection and then reused.
+ * Call this after the credentials have been re-provisioned so the next
+ * connection reads them again. Cached sessions are flushed as well.
+ */
+void TLS_InvalidateCredentials( void );
+
+/**
+ * @brief Forgets the cached session for a server, or all of them.
+ *
+ * @param[in] pcDestination Server name, or NULL to empty the cache.
+ */
+void TLS_FlushSessionCache( const char * pcDestination );
+
+#if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+
+/**
+ * @brief Application hook storing a session for a server.
+ *
+ * The blob holds the session master secret and must be kept in storage that
+ * is protected like the device private key.
+ *
+ * @param[in] pcDestination Server name the session belongs to, or NULL
+ * together with a NULL pucBlob to erase all stored sessions.
+ * @param[in] pucBlob Serialized session, or NULL to erase the stored session.
+ * @param[in] xBlobLength Length of pucBlob in bytes.
+ *
+ * @return pdTRUE if the session was stored.
+ */
+    BaseType_t xApplicationTlsSessionSave( const char * pcDestination,
+                                           const uint8_t * pucBlob,
+                                           size_t xBlobLength );
+
+/**
+ * @brief Application hook retrieving the stored session for a server.
+ *
+ * @param[in] pcDestination Server name to look up.
+ * @param[out] pucBlob Buffer of tlsSESSION_BLOB_MAX_LENGTH bytes.
+ * @param[in] xBlobLength Size of pucBlob.
+ *
+ * @return Length of the stored session, or 0 if none was found.
+ */
+    size_t xApplicationTlsSessionLoad( const char * pcDestination,
+                                       uint8_t * pucBlob,
+                                       size_t xBlobLength );
+#endif /* if ( tlsconfigSESSION_CACHE_PERSIST == 1 ) */
+
 #endif /* ifndef __AWS__TLS__H__ */
@@ -31,6 +31,7 @@
 #include "aws_pkcs11.h"
 #include "aws_pkcs11_config.h"
 #include "task.h"
+#include "semphr.h"
 #include "aws_clientcredential_keys.h"
 #include "aws_default_root_certificates.h"
 
@@ -43,6 +44,7 @@
 #include "mbedtls/pk.h"
 #include "mbedtls/pk_internal.h"
 #include "mbedtls/debug.h"
+#include "mbedtls/platform_util.h"
 #ifdef MBEDTLS_DEBUG_C
     #define tlsDEBUG_VERBOSE    4
 #endif
@@ -52,6 +54,28 @@
 #include <time.h>
 #include <stdio.h>
 
+/**
+ * @brief Device credentials shared by all TLS contexts.
+ *
+ * The credentials are read from the PKCS#11 module and decoded by the first
+ * connection, then used read-only by every handshake until
+ * TLS_InvalidateCredentials() is called.
+ *
+ * @param[in] xRootCA Default trusted root certificates.
+ * @param[in] xClientChain Device certificate, followed by the JITR issuer if any.
+ * @param[in] xPrivateKey PKCS#11 handle of the device private key.
+ * @param[in] xKeyAlgo Type of the device private key.
+ * @param[in] ulUsers Number of connections in progress using the credentials.
+ */
+typedef struct TLSCredentials
+{
+    mbedtls_x509_crt xRootCA;
+    mbedtls_x509_crt xClientChain;
+    CK_OBJECT_HANDLE xPrivateKey;
+    mbedtls_pk_type_t xKeyAlgo;
+    uint32_t ulUsers;
+} TLSCredentials_t;
+
 /**
  * @brief Internal context structure.
  *
@@ -61,11 +85,20 @@
  * @param[in] xNetworkRecv Callback for receiving data on an open TCP socket.
  * @param[in] xNetworkSend Callback for sending data on an open TCP socket.
  * @param[in] pvCallerContext Opaque pointer provided by caller for above callbacks.
+ * @param[in] pxCiphersuites Ciphersuites to offer, or NULL for the mbedTLS default.
+ * @param[in] ucMaxFragmentLengthCode max_fragment_length extension code to request.
  * @param[out] xTLSCHandshakeSuccessful Indicates whether TLS handshake was successfully completed.
+ * @param[out] xHandshakePending Set between TLS_ConnectStart() and the end of the handshake.
+ * @param[out] xCacheable Whether the session may be saved to the session cache.
+ * @param[out] xOffered Whether a cached session was offered to the server.
+ * @param[out] xHandshakeStart Tick count at which the handshake started.
+ * @param[out] xHeapStart Free heap when the handshake started.
+ * @param[out] xHeapLowest Lowest free heap seen during the handshake.
+ * @param[out] ucOfferedMaster Master secret of the offered session.
  * @param[out] xMbedSslCtx Connection context for mbedTLS.
  * @param[out] xMbedSslConfig Configuration context for mbedTLS.
- * @param[out] xMbedX509CA Server certificate context for mbedTLS.
- * @param[out] xMbedX509Cli Client certificate context for mbedTLS.
+ * @param[out] xMbedX509CA Caller-supplied server certificate context for mbedTLS.
+ * @param[out] pxCredentials Shared credentials used by the handshake.
  * @param[out] mbedPkAltCtx RSA crypto implementation context for mbedTLS.
  * @param[out] xP11FunctionList PKCS#11 function list structure.
  * @param[out] xP11Session PKCS#11 session context.
@@ -82,13 +115,24 @@ typedef struct TLSContext
     NetworkRecv_t xNetworkRecv;
     NetworkSend_t xNetworkSend;
     void * pvCallerContext;
+    const int * pxCiphersuites;
+    unsigned char ucMaxFragmentLengthCode;
     BaseType_t xTLSHandshakeSuccessful;
 
+    /* Handshake in progress. */
+    BaseType_t xHandshakePending;
+    BaseType_t xCacheable;
+    BaseType_t xOffered;
+    TickType_t xHandshakeStart;
+    size_t xHeapStart;
+    size_t xHeapLowest;
+    unsigned char ucOfferedMaster[ 48 ];
+
     /* mbedTLS. */
     mbedtls_ssl_context xMbedSslCtx;
     mbedtls_ssl_config xMbedSslConfig;
     mbedtls_x509_crt xMbedX509CA;
-    mbedtls_x509_crt xMbedX509Cli;
+    TLSCredentials_t * pxCredentials;
     mbedtls_pk_context xMbedPkCtx;
     mbedtls_pk_info_t xMbedPkInfo;
 
@@ -101,6 +145,46 @@ typedef struct TLSContext
 
 #define TLS_PRINT( X )    vLoggingPrintf X
 
+#if ( tlsconfigSESSION_CACHE_ENTRIES > 0 )
+
+/**
+ * @brief Session saved for resumption.
+ *
+ * @param[in] cDestination Server name the session was negotiated with.
+ * @param[in] xSession Session ID, ticket and master secret. The server
+ * certificate is not kept since it is not used when resuming.
+ * @param[in] xSavedAt Tick count at which the session was saved.
+ * @param[in] xLifetime Ticks after xSavedAt at which the session expires.
+ * @param[in] ulLastUsed Value of the cache clock when last stored or offered.
+ * @param[in] xValid Whether the entry holds a session.
+ */
+    typedef struct TLSSessionCacheEntry
+    {
+        char cDestination[ tlsconfigSESSION_CACHE_MAX_NAME_LENGTH ];
+        mbedtls_ssl_session xSession;
+        TickType_t xSavedAt;
+        TickType_t xLifetime;
+        uint32_t ulLastUsed;
+        BaseType_t xValid;
+    } TLSSessionCacheEntry_t;
+
+    static TLSSessionCacheEntry_t xSessionCache[ tlsconfigSESSION_CACHE_ENTRIES ];
+    static uint32_t ulSessionCacheClock = 0;
+#endif /* if ( tlsconfigSESSION_CACHE_ENTRIES > 0 ) */
+
+/* Guards the shared credentials, the session cache and the handshake statistics. */
+static SemaphoreHandle_t xTlsMutex = NULL;
+static TLSMetrics_t xTlsMetrics = { 0 };
+static TLSCredentials_t * pxSharedCredentials = NULL;
+
+#if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+    #define tlsSESSION_BLOB_VERSION    1
+#endif
+
+#ifdef tlsconfigCIPHERSUITES
+    static const int xDefaultCiphersuites[] = { tlsconfigCIPHERSUITES, 0 };
+#endif
+
 /*
  * Helper routines.
  */
@@ -144,8 +228,15 @@ static int prvNetworkSend( void * pvContext,
                            size_t xDataLength )
 {
     TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
+    BaseType_t xResult = pxCtx->xNetworkSend( pxCtx->pvCallerContext, pucData, xDataLength );
 
-    return ( int ) pxCtx->xNetworkSend( pxCtx->pvCallerContext, pucData, xDataLength );
+    /* A non-blocking caller has no room for the data yet. */
+    if( TLS_ERROR_WANT_WRITE == xResult )
+    {
+        xResult = MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+
+    return ( int ) xResult;
 }
 
 /**
@@ -162,8 +253,15 @@ static int prvNetworkRecv( void * pvContext,
                            size_t xReceiveLength )
 {
     TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
+    BaseType_t xResult = pxCtx->xNetworkRecv( pxCtx->pvCallerContext, pucReceiveBuffer, xReceiveLength );
+
+    /* A non-blocking caller has no data yet. */
+    if( TLS_ERROR_WANT_READ == xResult )
+    {
+        xResult = MBEDTLS_ERR_SSL_WANT_READ;
+    }
 
-    return ( int ) pxCtx->xNetworkRecv( pxCtx->pvCallerContext, pucReceiveBuffer, xReceiveLength );
+    return ( int ) xResult;
 }
 
 /**
@@ -327,46 +425,109 @@ static int prvPrivateKeySigningCallback( void * pvContext,
 }
 
 /**
- * @brief Helper for setting up potentially hardware-based cryptographic context
- * for the client TLS certificate and private key.
+ * @brief Takes the mutex guarding the shared credentials, the session cache
+ * and the statistics, creating it on first use.
  *
- * @param Caller context.
+ * @return pdTRUE if the mutex was taken.
+ */
+static BaseType_t prvLock( void )
+{
+    SemaphoreHandle_t xNewMutex = NULL;
+
+    if( NULL == xTlsMutex )
+    {
+        xNewMutex = xSemaphoreCreateMutex();
+
+        /* Another task may have created the mutex in the meantime. */
+        taskENTER_CRITICAL();
+
+        if( NULL == xTlsMutex )
+        {
+            xTlsMutex = xNewMutex;
+            xNewMutex = NULL;
+        }
+
+        taskEXIT_CRITICAL();
+
+        if( NULL != xNewMutex )
+        {
+            vSemaphoreDelete( xNewMutex );
+        }
+    }
+
+    return ( NULL != xTlsMutex ) &&
+           ( pdTRUE == xSemaphoreTake( xTlsMutex, portMAX_DELAY ) );
+}
+
+/**
+ * @brief Releases the mutex taken by prvLock().
+ */
+static void prvUnlock( void )
+{
+    ( void ) xSemaphoreGive( xTlsMutex );
+}
+
+/**
+ * @brief Adds a completed handshake to the statistics.
+ *
+ * @param[in] xResumed Whether a cached session was resumed.
+ * @param[in] ulDurationMs Duration of the handshake.
+ */
+static void prvRecordHandshake( BaseType_t xResumed,
+                                uint32_t ulDurationMs,
+                                uint32_t ulPeakHeap )
+{
+    if( pdTRUE == prvLock() )
+    {
+        if( pdTRUE == xResumed )
+        {
+            xTlsMetrics.ulResumedHandshakes++;
+            xTlsMetrics.ulResumedHandshakeMs += ulDurationMs;
+        }
+        else
+        {
+            xTlsMetrics.ulFullHandshakes++;
+            xTlsMetrics.ulFullHandshakeMs += ulDurationMs;
+        }
+
+        xTlsMetrics.ulLastHandshakeMs = ulDurationMs;
+        xTlsMetrics.ulLastHandshakePeakHeap = ulPeakHeap;
+        prvUnlock();
+    }
+}
+
+/**
+ * @brief Frees credentials built by prvLoadCredentials().
+ *
+ * @param[in] pxCredentials Credentials no longer used by any context.
+ */
+static void prvFreeCredentials( TLSCredentials_t * pxCredentials )
+{
+    mbedtls_x509_crt_free( &pxCredentials->xRootCA );
+    mbedtls_x509_crt_free( &pxCredentials->xClientChain );
+    vPortFree( pxCredentials );
+}
+
+/**
+ * @brief Reads the device credentials from the PKCS#11 module and decodes
+ * them, together with the default trusted root certificates.
+ *
+ * @param[in] pxCtx Context whose PKCS#11 session is used for the lookups.
+ * @param[out] pxCredentials Initialized credentials to fill in.
  *
  * @return Zero on success.
  */
-static int prvInitializeClientCredential( TLSContext_t * pxCtx )
+static int prvLoadCredentials( TLSContext_t * pxCtx,
+                               TLSCredentials_t * pxCredentials )
 {
     BaseType_t xResult = 0;
-    CK_SLOT_ID xSlotId = 0;
     CK_ULONG xCount = 1;
     CK_ATTRIBUTE xTemplate = { 0 };
     CK_OBJECT_HANDLE xCertObj = 0;
     CK_BYTE * pxCertificate = NULL;
-    mbedtls_pk_type_t xKeyAlgo = ( mbedtls_pk_type_t ) ~0;
     CK_KEY_TYPE xKeyType = ( CK_KEY_TYPE ) ~0;
     char * pcJitrCertificate = keyJITR_DEVICE_CERTIFICATE_AUTHORITY_PEM;
 
-    /* Initialize the mbed contexts. */
-    mbedtls_x509_crt_init( &pxCtx->xMbedX509Cli );
-
-    /* Get the default private key storage ID. */
-    if( CKR_OK == xResult )
-    {
-        xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_GetSlotList( CK_TRUE,
-                                                                         &xSlotId,
-                                                                         &xCount );
-    }
-
-    /* Start a private session with the P#11 module. */
-    if( 0 == xResult )
-    {
-        xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_OpenSession( xSlotId,
-                                                                         CKF_SERIAL_SESSION,
-                                                                         NULL,
-                                                                         NULL,
-                                                                         &pxCtx->xP11Session );
-    }
-
     /* Get the handle of the device private key. */
     if( 0 == xResult )
     {
@@ -381,7 +542,7 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
     if( 0 == xResult )
     {
         xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_FindObjects( pxCtx->xP11Session,
-                                                                         &pxCtx->xP11PrivateKey,
+                                                                         &pxCredentials->xPrivateKey,
                                                                          1,
                                                                          &xCount );
     }
@@ -397,7 +558,7 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
         xTemplate.pValue = &xKeyType;
         xTemplate.ulValueLen = sizeof( CK_KEY_TYPE );
         xResult = pxCtx->xP11FunctionList->C_GetAttributeValue( pxCtx->xP11Session,
-                                                                pxCtx->xP11PrivateKey,
+                                                                pxCredentials->xPrivateKey,
                                                                 &xTemplate,
                                                                 1 );
     }
@@ -407,11 +568,11 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
         switch( xKeyType )
         {
             case CKK_RSA:
-                xKeyAlgo = MBEDTLS_PK_RSA;
+                pxCredentials->xKeyAlgo = MBEDTLS_PK_RSA;
                 break;
 
             case CKK_EC:
-                xKeyAlgo = MBEDTLS_PK_ECKEY;
+                pxCredentials->xKeyAlgo = MBEDTLS_PK_ECKEY;
                 break;
 
             default:
@@ -420,15 +581,6 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
         }
     }
 
-    if( xResult == CKR_OK )
-    {
-        memcpy( &pxCtx->xMbedPkInfo, mbedtls_pk_info_from_type( xKeyAlgo ), sizeof( mbedtls_pk_info_t ) );
-
-        pxCtx->xMbedPkInfo.sign_func = prvPrivateKeySigningCallback;
-        pxCtx->xMbedPkCtx.pk_info = &pxCtx->xMbedPkInfo;
-        pxCtx->xMbedPkCtx.pk_ctx = pxCtx;
-    }
-
     if( 0 == xResult )
     {
         /* Enumerate the first client certificate. */
@@ -489,7 +641,7 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
     /* Decode the client certificate. */
     if( 0 == xResult )
     {
-        xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509Cli,
+        xResult = mbedtls_x509_crt_parse( &pxCredentials->xClientChain,
                                           ( const unsigned char * ) pxCertificate,
                                           xTemplate.ulValueLen );
     }
@@ -504,21 +656,11 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
         /* Decode the JITR issuer. The device client certificate will get
          * inserted as the first certificate in this chain below. */
         xResult = mbedtls_x509_crt_parse(
-            &pxCtx->xMbedX509Cli,
+            &pxCredentials->xClientChain,
             ( const unsigned char * ) pcJitrCertificate,
             1 + strlen( pcJitrCertificate ) );
     }
 
-    /*
-     * Attach the client certificate and private key to the TLS configuration.
-     */
-    if( 0 == xResult )
-    {
-        xResult = mbedtls_ssl_conf_own_cert( &pxCtx->xMbedSslConfig,
-                                             &pxCtx->xMbedX509Cli,
-                                             &pxCtx->xMbedPkCtx );
-    }
-
     if( NULL != pxCertificate )
     {
         vPortFree( pxCertificate );
@@ -529,170 +671,898 @@ static int prvInitializeClientCredential( TLSContext_t * pxCtx )
         TLS_PRINT( ( "ERROR: Loading credentials from flash into TLS context failed with error %d.\r\n", xResult ) );
     }
 
-    return xResult;
-}
-
-/*
- * Interface routines.
- */
-
-BaseType_t TLS_Init( void ** ppvContext,
-                     TLSParams_t * pxParams )
-{
-    BaseType_t xResult = 0;
-    TLSContext_t * pxCtx = NULL;
-    CK_C_GetFunctionList xCkGetFunctionList = NULL;
-
-    /* Allocate an internal context. */
-    pxCtx = ( TLSContext_t * ) pvPortMalloc( sizeof( TLSContext_t ) ); /*lint !e9087 !e9079 Allow casting void* to other types. */
-
-    if( NULL != pxCtx )
+    /* Decode the default root certificates. */
+    if( 0 == xResult )
     {
-        memset( pxCtx, 0, sizeof( TLSContext_t ) );
-        *ppvContext = pxCtx;
-
-        /* Initialize the context. */
-        pxCtx->pcDestination = pxParams->pcDestination;
-        pxCtx->pcServerCertificate = pxParams->pcServerCertificate;
-        pxCtx->ulServerCertificateLength = pxParams->ulServerCertificateLength;
-        pxCtx->ppcAlpnProtocols = pxParams->ppcAlpnProtocols;
-        pxCtx->ulAlpnProtocolsCount = pxParams->ulAlpnProtocolsCount;
-        pxCtx->xNetworkRecv = pxParams->pxNetworkRecv;
-        pxCtx->xNetworkSend = pxParams->pxNetworkSend;
-        pxCtx->pvCallerContext = pxParams->pvCallerContext;
-
-        /* Get the function pointer list for the PKCS#11 module. */
-        xCkGetFunctionList = C_GetFunctionList;
-        xResult = ( BaseType_t ) xCkGetFunctionList( &pxCtx->xP11FunctionList );
+        xResult = mbedtls_x509_crt_parse( &pxCredentials->xRootCA,
+                                          ( const unsigned char * ) tlsVERISIGN_ROOT_CERTIFICATE_PEM,
+                                          tlsVERISIGN_ROOT_CERTIFICATE_LENGTH );
 
-        /* Ensure that the PKCS #11 module is initialized. */
         if( 0 == xResult )
         {
-            xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_Initialize( NULL );
+            xResult = mbedtls_x509_crt_parse( &pxCredentials->xRootCA,
+                                              ( const unsigned char * ) tlsATS1_ROOT_CERTIFICATE_PEM,
+                                              tlsATS1_ROOT_CERTIFICATE_LENGTH );
 
-            /* It is ok if the module was previously initialized. */
-            if( xResult == CKR_CRYPTOKI_ALREADY_INITIALIZED )
+            if( 0 == xResult )
             {
-                xResult = CKR_OK;
+                xResult = mbedtls_x509_crt_parse( &pxCredentials->xRootCA,
+                                                  ( const unsigned char * ) tlsSTARFIELD_ROOT_CERTIFICATE_PEM,
+                                                  tlsSTARFIELD_ROOT_CERTIFICATE_LENGTH );
             }
         }
-    }
-    else
-    {
-        xResult = ( BaseType_t ) CKR_HOST_MEMORY;
+
+        if( 0 != xResult )
+        {
+            /* Default root certificates should be in aws_default_root_certificate.h */
+            TLS_PRINT( ( "ERROR: Failed to parse default server certificates %d \r\n", xResult ) );
+        }
     }
 
     return xResult;
 }
 
-/*-----------------------------------------------------------*/
-
-#ifdef MBEDTLS_DEBUG_C
-    static void prvTlsDebugPrint( void * ctx,
-                                  int lLevel,
-                                  const char * pcFile,
-                                  int lLine,
-                                  const char * pcStr )
-    {
-        /* Unused parameters. */
-        ( void ) ctx;
-        ( void ) pcFile;
-        ( void ) lLine;
-
-        /* Send the debug string to the portable logger. */
-        vLoggingPrintf( "mbedTLS: |%d| %s", lLevel, pcStr );
-    }
-#endif /* ifdef MBEDTLS_DEBUG_C */
-
-/*-----------------------------------------------------------*/
-
-BaseType_t TLS_Connect( void * pvContext )
+/**
+ * @brief Returns the shared credentials, loading them if this is the first
+ * connection since boot or since they were invalidated.
+ *
+ * @param[in] pxCtx Context with an open PKCS#11 session.
+ * @param[out] ppxCredentials Receives the credentials, to be handed back with
+ * prvReleaseCredentials().
+ *
+ * @return Zero on success.
+ */
+static int prvAcquireCredentials( TLSContext_t * pxCtx,
+                                  TLSCredentials_t ** ppxCredentials )
 {
     BaseType_t xResult = 0;
-    TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
-
-    /* Ensure that the FreeRTOS heap is used. */
-    CRYPTO_ConfigureHeap();
+    BaseType_t xLocked = prvLock();
+    TLSCredentials_t * pxCredentials = NULL;
+    TickType_t xLoadStart = 0;
 
-    /* Initialize mbedTLS structures. */
-    mbedtls_ssl_init( &pxCtx->xMbedSslCtx );
-    mbedtls_ssl_config_init( &pxCtx->xMbedSslConfig );
-    mbedtls_x509_crt_init( &pxCtx->xMbedX509CA );
+    if( pdTRUE != xLocked )
+    {
+        xResult = ( BaseType_t ) CKR_HOST_MEMORY;
+    }
 
-    /* Decode the root certificate: either the default or the override. */
-    if( NULL != pxCtx->pcServerCertificate )
+    if( ( 0 == xResult ) && ( NULL == pxSharedCredentials ) )
     {
-        xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509CA,
-                                          ( const unsigned char * ) pxCtx->pcServerCertificate,
-                                          pxCtx->ulServerCertificateLength );
+        pxCredentials = ( TLSCredentials_t * ) pvPortMalloc( sizeof( TLSCredentials_t ) ); /*lint !e9087 !e9079 Allow casting void* to other types. */
 
-        if( 0 != xResult )
+        if( NULL == pxCredentials )
         {
-            TLS_PRINT( ( "ERROR: Failed to parse custom server certificates %d \r\n", xResult ) );
+            xResult = ( BaseType_t ) CKR_HOST_MEMORY;
         }
-    }
-    else
-    {
-        xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509CA,
-                                          ( const unsigned char * ) tlsVERISIGN_ROOT_CERTIFICATE_PEM,
-                                          tlsVERISIGN_ROOT_CERTIFICATE_LENGTH );
-
-        if( 0 == xResult )
+        else
         {
-            xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509CA,
-                                              ( const unsigned char * ) tlsATS1_ROOT_CERTIFICATE_PEM,
-                                              tlsATS1_ROOT_CERTIFICATE_LENGTH );
+            memset( pxCredentials, 0, sizeof( TLSCredentials_t ) );
+            mbedtls_x509_crt_init( &pxCredentials->xRootCA );
+            mbedtls_x509_crt_init( &pxCredentials->xClientChain );
+
+            xLoadStart = xTaskGetTickCount();
+            xResult = prvLoadCredentials( pxCtx, pxCredentials );
 
             if( 0 == xResult )
             {
-                xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509CA,
-                                                  ( const unsigned char * ) tlsSTARFIELD_ROOT_CERTIFICATE_PEM,
-                                                  tlsSTARFIELD_ROOT_CERTIFICATE_LENGTH );
+                xTlsMetrics.ulCredentialLoads++;
+                xTlsMetrics.ulCredentialLoadMs += ( uint32_t ) ( xTaskGetTickCount() - xLoadStart ) * portTICK_PERIOD_MS;
+                pxSharedCredentials = pxCredentials;
+            }
+            else
+            {
+                prvFreeCredentials( pxCredentials );
             }
-        }
-
-        if( 0 != xResult )
-        {
-            /* Default root certificates should be in aws_default_root_certificate.h */
-            TLS_PRINT( ( "ERROR: Failed to parse default server certificates %d \r\n", xResult ) );
         }
     }
 
-    /* Start with protocol defaults. */
     if( 0 == xResult )
     {
-        xResult = mbedtls_ssl_config_defaults( &pxCtx->xMbedSslConfig,
-                                               MBEDTLS_SSL_IS_CLIENT,
-                                               MBEDTLS_SSL_TRANSPORT_STREAM,
-                                               MBEDTLS_SSL_PRESET_DEFAULT );
-
-
-        if( 0 != xResult )
-        {
-            TLS_PRINT( ( "ERROR: Failed to set ssl config defaults %d \r\n", xResult ) );
-        }
+        pxSharedCredentials->ulUsers++;
+        *ppxCredentials = pxSharedCredentials;
     }
 
-    if( 0 == xResult )
+    if( pdTRUE == xLocked )
     {
-        /* Use a callback for additional server certificate validation. */
-        mbedtls_ssl_conf_verify( &pxCtx->xMbedSslConfig,
-                                 &prvCheckCertificate,
-                                 pxCtx );
+        prvUnlock();
+    }
 
-        /* Server certificate validation is mandatory. */
-        mbedtls_ssl_conf_authmode( &pxCtx->xMbedSslConfig, MBEDTLS_SSL_VERIFY_REQUIRED );
+    return xResult;
+}
 
-        /* Set the RNG callback. */
-        mbedtls_ssl_conf_rng( &pxCtx->xMbedSslConfig, &prvGenerateRandomBytes, pxCtx ); /*lint !e546 Nothing wrong here. */
+/**
+ * @brief Hands back credentials returned by prvAcquireCredentials().
+ *
+ * @param[in] pxCredentials Credentials no longer used by the caller.
+ */
+static void prvReleaseCredentials( TLSCredentials_t * pxCredentials )
+{
+    /* The lock was taken successfully when the credentials were acquired, so
+     * the mutex exists. */
+    ( void ) prvLock();
 
-        /* Set issuer certificate. */
-        mbedtls_ssl_conf_ca_chain( &pxCtx->xMbedSslConfig, &pxCtx->xMbedX509CA, NULL );
+    pxCredentials->ulUsers--;
+
+    /* Credentials that were invalidated while in use are freed by their last
+     * user. */
+    if( ( 0 == pxCredentials->ulUsers ) && ( pxCredentials != pxSharedCredentials ) )
+    {
+        prvFreeCredentials( pxCredentials );
+    }
+
+    prvUnlock();
+}
+
+/**
+ * @brief Helper for setting up potentially hardware-based cryptographic context
+ * for the client TLS certificate and private key.
+ *
+ * @param Caller context.
+ *
+ * @return Zero on success.
+ */
+static int prvInitializeClientCredential( TLSContext_t * pxCtx )
+{
+    BaseType_t xResult = 0;
+    CK_SLOT_ID xSlotId = 0;
+    CK_ULONG xCount = 1;
+
+    /* Get the default private key storage ID. */
+    if( CKR_OK == xResult )
+    {
+        xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_GetSlotList( CK_TRUE,
+                                                                         &xSlotId,
+                                                                         &xCount );
+    }
+
+    /* Start a private session with the P#11 module. */
+    if( 0 == xResult )
+    {
+        xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_OpenSession( xSlotId,
+                                                                         CKF_SERIAL_SESSION,
+                                                                         NULL,
+                                                                         NULL,
+                                                                         &pxCtx->xP11Session );
+    }
+
+    /* Get the decoded certificates and the private key handle. */
+    if( 0 == xResult )
+    {
+        xResult = prvAcquireCredentials( pxCtx, &pxCtx->pxCredentials );
+    }
+
+    if( xResult == CKR_OK )
+    {
+        pxCtx->xP11PrivateKey = pxCtx->pxCredentials->xPrivateKey;
+
+        memcpy( &pxCtx->xMbedPkInfo, mbedtls_pk_info_from_type( pxCtx->pxCredentials->xKeyAlgo ), sizeof( mbedtls_pk_info_t ) );
+
+        pxCtx->xMbedPkInfo.sign_func = prvPrivateKeySigningCallback;
+        pxCtx->xMbedPkCtx.pk_info = &pxCtx->xMbedPkInfo;
+        pxCtx->xMbedPkCtx.pk_ctx = pxCtx;
+    }
+
+    /*
+     * Attach the client certificate and private key to the TLS configuration.
+     */
+    if( 0 == xResult )
+    {
+        xResult = mbedtls_ssl_conf_own_cert( &pxCtx->xMbedSslConfig,
+                                             &pxCtx->pxCredentials->xClientChain,
+                                             &pxCtx->xMbedPkCtx );
+    }
+
+    return xResult;
+}
+
+#if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+
+/**
+ * @brief Writes a session in the format handed to the persistence hooks.
+ *
+ * @param[in] pxSession Session to serialize.
+ * @param[out] pucBlob Buffer of tlsSESSION_BLOB_MAX_LENGTH bytes.
+ *
+ * @return Length of the blob, or 0 if the session does not fit.
+ */
+    static size_t prvSerializeSession( const mbedtls_ssl_session * pxSession,
+                                       uint8_t * pucBlob )
+    {
+        size_t xResult = 0;
+        uint8_t * pucNext = pucBlob;
+        uint32_t ulTicketLifetime = 0;
+        size_t xTicketLength = 0;
+        const uint8_t * pucTicket = NULL;
+        uint8_t ucMfl = 0;
+        uint8_t ucTruncHmac = 0;
+        uint8_t ucEtm = 0;
+
+        #if defined( MBEDTLS_SSL_SESSION_TICKETS )
+            ulTicketLifetime = pxSession->ticket_lifetime;
+            xTicketLength = pxSession->ticket_len;
+            pucTicket = pxSession->ticket;
+        #endif
+        #if defined( MBEDTLS_SSL_MAX_FRAGMENT_LENGTH )
+            ucMfl = pxSession->mfl_code;
+        #endif
+        #if defined( MBEDTLS_SSL_TRUNCATED_HMAC )
+            ucTruncHmac = ( uint8_t ) pxSession->trunc_hmac;
+        #endif
+        #if defined( MBEDTLS_SSL_ENCRYPT_THEN_MAC )
+            ucEtm = ( uint8_t ) pxSession->encrypt_then_mac;
+        #endif
+
+        /* A session that does not fit the blob is not persisted. */
+        if( ( xTicketLength <= tlsconfigSESSION_CACHE_MAX_TICKET_LENGTH ) &&
+            ( pxSession->id_len <= sizeof( pxSession->id ) ) )
+        {
+            *pucNext++ = tlsSESSION_BLOB_VERSION;
+            *pucNext++ = ( uint8_t ) ( pxSession->ciphersuite >> 8 );
+            *pucNext++ = ( uint8_t ) pxSession->ciphersuite;
+            *pucNext++ = ( uint8_t ) pxSession->compression;
+            *pucNext++ = ( uint8_t ) pxSession->id_len;
+            memcpy( pucNext, pxSession->id, sizeof( pxSession->id ) );
+            pucNext += sizeof( pxSession->id );
+            memcpy( pucNext, pxSession->master, sizeof( pxSession->master ) );
+            pucNext += sizeof( pxSession->master );
+            *pucNext++ = ( uint8_t ) ( pxSession->verify_result >> 24 );
+            *pucNext++ = ( uint8_t ) ( pxSession->verify_result >> 16 );
+            *pucNext++ = ( uint8_t ) ( pxSession->verify_result >> 8 );
+            *pucNext++ = ( uint8_t ) pxSession->verify_result;
+            *pucNext++ = ucMfl;
+            *pucNext++ = ucTruncHmac;
+            *pucNext++ = ucEtm;
+            *pucNext++ = ( uint8_t ) ( ulTicketLifetime >> 24 );
+            *pucNext++ = ( uint8_t ) ( ulTicketLifetime >> 16 );
+            *pucNext++ = ( uint8_t ) ( ulTicketLifetime >> 8 );
+            *pucNext++ = ( uint8_t ) ulTicketLifetime;
+            *pucNext++ = ( uint8_t ) ( xTicketLength >> 8 );
+            *pucNext++ = ( uint8_t ) xTicketLength;
+
+            if( xTicketLength > 0 )
+            {
+                memcpy( pucNext, pucTicket, xTicketLength );
+                pucNext += xTicketLength;
+            }
+
+            xResult = ( size_t ) ( pucNext - pucBlob );
+        }
+
+        return xResult;
+    }
+
+/**
+ * @brief Reads a session written by prvSerializeSession().
+ *
+ * @param[out] pxSession Initialized session to fill in.
+ * @param[in] pucBlob Serialized session.
+ * @param[in] xBlobLength Length of pucBlob.
+ *
+ * @return Zero on success.
+ */
+    static int prvDeserializeSession( mbedtls_ssl_session * pxSession,
+                                      const uint8_t * pucBlob,
+                                      size_t xBlobLength )
+    {
+        const uint8_t * pucNext = pucBlob;
+        const size_t xFixedLength = 5 + sizeof( pxSession->id ) + sizeof( pxSession->master ) + 13;
+        size_t xTicketLength = 0;
+        uint32_t ulTicketLifetime = 0;
+        uint8_t ucMfl = 0;
+        uint8_t ucTruncHmac = 0;
+        uint8_t ucEtm = 0;
+
+        if( ( xBlobLength < xFixedLength ) || ( tlsSESSION_BLOB_VERSION != pucBlob[ 0 ] ) )
+        {
+            return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+        }
+
+        pucNext++;
+        pxSession->ciphersuite = ( ( int ) pucNext[ 0 ] << 8 ) | ( int ) pucNext[ 1 ];
+        pxSession->compression = pucNext[ 2 ];
+        pxSession->id_len = pucNext[ 3 ];
+        pucNext += 4;
+        memcpy( pxSession->id, pucNext, sizeof( pxSession->id ) );
+        pucNext += sizeof( pxSession->id );
+        memcpy( pxSession->master, pucNext, sizeof( pxSession->master ) );
+        pucNext += sizeof( pxSession->master );
+        pxSession->verify_result = ( ( uint32_t ) pucNext[ 0 ] << 24 ) |
+                                   ( ( uint32_t ) pucNext[ 1 ] << 16 ) |
+                                   ( ( uint32_t ) pucNext[ 2 ] << 8 ) |
+                                   ( uint32_t ) pucNext[ 3 ];
+        ucMfl = pucNext[ 4 ];
+        ucTruncHmac = pucNext[ 5 ];
+        ucEtm = pucNext[ 6 ];
+        ulTicketLifetime = ( ( uint32_t ) pucNext[ 7 ] << 24 ) |
+                           ( ( uint32_t ) pucNext[ 8 ] << 16 ) |
+                           ( ( uint32_t ) pucNext[ 9 ] << 8 ) |
+                           ( uint32_t ) pucNext[ 10 ];
+        xTicketLength = ( ( size_t ) pucNext[ 11 ] << 8 ) | ( size_t ) pucNext[ 12 ];
+        pucNext += 13;
+
+        if( ( pxSession->id_len > sizeof( pxSession->id ) ) ||
+            ( xTicketLength != ( xBlobLength - xFixedLength ) ) )
+        {
+            return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+        }
+
+        #if defined( MBEDTLS_SSL_MAX_FRAGMENT_LENGTH )
+            pxSession->mfl_code = ucMfl;
+        #else
+            ( void ) ucMfl;
+        #endif
+        #if defined( MBEDTLS_SSL_TRUNCATED_HMAC )
+            pxSession->trunc_hmac = ucTruncHmac;
+        #else
+            ( void ) ucTruncHmac;
+        #endif
+        #if defined( MBEDTLS_SSL_ENCRYPT_THEN_MAC )
+            pxSession->encrypt_then_mac = ucEtm;
+        #else
+            ( void ) ucEtm;
+        #endif
+
+        #if defined( MBEDTLS_SSL_SESSION_TICKETS )
+            pxSession->ticket_lifetime = ulTicketLifetime;
+
+            if( xTicketLength > 0 )
+            {
+                pxSession->ticket = mbedtls_calloc( 1, xTicketLength );
+
+                if( NULL == pxSession->ticket )
+                {
+                    return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+                }
+
+                memcpy( pxSession->ticket, pucNext, xTicketLength );
+                pxSession->ticket_len = xTicketLength;
+            }
+        #else
+            ( void ) ulTicketLifetime;
+
+            if( xTicketLength > 0 )
+            {
+                return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+            }
+        #endif /* if defined( MBEDTLS_SSL_SESSION_TICKETS ) */
+
+        return 0;
+    }
+#endif /* if ( tlsconfigSESSION_CACHE_PERSIST == 1 ) */
+
+#if ( tlsconfigSESSION_CACHE_ENTRIES > 0 )
+
+/**
+ * @brief Finds the unexpired cache entry of a server. The caller must hold
+ * the cache mutex.
+ *
+ * @param[in] pcDestination Server name.
+ *
+ * @return The entry, or NULL if the server has no cached session.
+ */
+    static TLSSessionCacheEntry_t * prvSessionCacheFind( const char * pcDestination )
+    {
+        TLSSessionCacheEntry_t * pxFound = NULL;
+        BaseType_t x;
+
+        for( x = 0; x < tlsconfigSESSION_CACHE_ENTRIES; x++ )
+        {
+            if( ( pdTRUE == xSessionCache[ x ].xValid ) &&
+                ( 0 == strcmp( xSessionCache[ x ].cDestination, pcDestination ) ) )
+            {
+                if( ( xTaskGetTickCount() - xSessionCache[ x ].xSavedAt ) < xSessionCache[ x ].xLifetime )
+                {
+                    pxFound = &xSessionCache[ x ];
+                }
+                else
+                {
+                    mbedtls_ssl_session_free( &xSessionCache[ x ].xSession );
+                    xSessionCache[ x ].xValid = pdFALSE;
+                }
+
+                break;
+            }
+        }
+
+        return pxFound;
+    }
+
+/**
+ * @brief Offers the cached session of the server, if any, in the next
+ * handshake.
+ *
+ * When the cache has no session for the server, the persistence hook is
+ * asked for one.
+ *
+ * @param[in] pxCtx TLS context, set up but not yet connected.
+ * @param[out] pucMaster Receives the master secret of the offered session.
+ *
+ * @return pdTRUE if a session was offered.
+ */
+    static BaseType_t prvSessionCacheOffer( TLSContext_t * pxCtx,
+                                            unsigned char * pucMaster )
+    {
+        BaseType_t xOffered = pdFALSE;
+        TLSSessionCacheEntry_t * pxEntry = NULL;
+
+        if( pdTRUE == prvLock() )
+        {
+            pxEntry = prvSessionCacheFind( pxCtx->pcDestination );
+
+            if( ( NULL != pxEntry ) &&
+                ( 0 == mbedtls_ssl_set_session( &pxCtx->xMbedSslCtx, &pxEntry->xSession ) ) )
+            {
+                memcpy( pucMaster, pxEntry->xSession.master, sizeof( pxEntry->xSession.master ) );
+                pxEntry->ulLastUsed = ++ulSessionCacheClock;
+                xOffered = pdTRUE;
+            }
+
+            prvUnlock();
+        }
+
+        #if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+            if( ( pdFALSE == xOffered ) && ( NULL == pxEntry ) )
+            {
+                uint8_t * pucBlob = pvPortMalloc( tlsSESSION_BLOB_MAX_LENGTH ); /*lint !e9079 Allow casting void* to other types. */
+                mbedtls_ssl_session xSession;
+                size_t xBlobLength = 0;
+
+                mbedtls_ssl_session_init( &xSession );
+
+                if( NULL != pucBlob )
+                {
+                    xBlobLength = xApplicationTlsSessionLoad( pxCtx->pcDestination,
+                                                              pucBlob,
+                                                              tlsSESSION_BLOB_MAX_LENGTH );
+                }
+
+                if( ( xBlobLength > 0 ) &&
+                    ( xBlobLength <= tlsSESSION_BLOB_MAX_LENGTH ) &&
+                    ( 0 == prvDeserializeSession( &xSession, pucBlob, xBlobLength ) ) &&
+                    ( 0 == mbedtls_ssl_set_session( &pxCtx->xMbedSslCtx, &xSession ) ) )
+                {
+                    memcpy( pucMaster, xSession.master, sizeof( xSession.master ) );
+                    xOffered = pdTRUE;
+                }
+
+                mbedtls_ssl_session_free( &xSession );
+
+                if( NULL != pucBlob )
+                {
+                    mbedtls_platform_zeroize( pucBlob, tlsSESSION_BLOB_MAX_LENGTH );
+                    vPortFree( pucBlob );
+                }
+            }
+        #endif /* if ( tlsconfigSESSION_CACHE_PERSIST == 1 ) */
+
+        return xOffered;
+    }
+
+/**
+ * @brief Saves the session negotiated by a successful handshake.
+ *
+ * @param[in] pxCtx Connected TLS context.
+ * @param[in] xResumed Whether the handshake resumed a cached session.
+ */
+    static void prvSessionCacheStore( TLSContext_t * pxCtx,
+                                      BaseType_t xResumed )
+    {
+        mbedtls_ssl_session xSession;
+        TLSSessionCacheEntry_t * pxEntry = NULL;
+        uint32_t ulLifetimeS = tlsconfigSESSION_CACHE_LIFETIME_MS / 1000UL;
+        BaseType_t xResumable = pdFALSE;
+        BaseType_t x;
+
+        mbedtls_ssl_session_init( &xSession );
+
+        if( 0 != mbedtls_ssl_get_session( &pxCtx->xMbedSslCtx, &xSession ) )
+        {
+            mbedtls_ssl_session_free( &xSession );
+
+            return;
+        }
+
+        /* The server certificate is only needed for a full handshake, so don't
+         * spend heap on keeping a copy of it. */
+        if( NULL != xSession.peer_cert )
+        {
+            mbedtls_x509_crt_free( xSession.peer_cert );
+            mbedtls_free( xSession.peer_cert );
+            xSession.peer_cert = NULL;
+        }
+
+        xResumable = ( xSession.id_len > 0 ) ? pdTRUE : pdFALSE;
+
+        #if defined( MBEDTLS_SSL_SESSION_TICKETS )
+            if( xSession.ticket_len > 0 )
+            {
+                xResumable = pdTRUE;
+
+                if( ( xSession.ticket_lifetime > 0 ) && ( xSession.ticket_lifetime < ulLifetimeS ) )
+                {
+                    ulLifetimeS = xSession.ticket_lifetime;
+                }
+            }
+        #endif
+
+        if( ulLifetimeS > ( portMAX_DELAY / configTICK_RATE_HZ ) )
+        {
+            ulLifetimeS = portMAX_DELAY / configTICK_RATE_HZ;
+        }
+
+        if( ( pdTRUE == xResumable ) && ( pdTRUE == prvLock() ) )
+        {
+            /* Reuse the entry of this server, else a free one, else the least
+             * recently used one. */
+            for( x = 0; x < tlsconfigSESSION_CACHE_ENTRIES; x++ )
+            {
+                if( ( pdTRUE == xSessionCache[ x ].xValid ) &&
+                    ( 0 == strcmp( xSessionCache[ x ].cDestination, pxCtx->pcDestination ) ) )
+                {
+                    pxEntry = &xSessionCache[ x ];
+                    break;
+                }
+
+                if( ( NULL == pxEntry ) ||
+                    ( ( pdTRUE == pxEntry->xValid ) &&
+                      ( ( pdFALSE == xSessionCache[ x ].xValid ) ||
+                        ( xSessionCache[ x ].ulLastUsed < pxEntry->ulLastUsed ) ) ) )
+                {
+                    pxEntry = &xSessionCache[ x ];
+                }
+            }
+
+            if( pdTRUE == pxEntry->xValid )
+            {
+                mbedtls_ssl_session_free( &pxEntry->xSession );
+            }
+
+            /* The entry takes over the session ticket allocated by
+             * mbedtls_ssl_get_session(). */
+            strcpy( pxEntry->cDestination, pxCtx->pcDestination );
+            memcpy( &pxEntry->xSession, &xSession, sizeof( xSession ) );
+            mbedtls_ssl_session_init( &xSession );
+            pxEntry->xSavedAt = xTaskGetTickCount();
+            pxEntry->xLifetime = ( TickType_t ) ( ulLifetimeS * configTICK_RATE_HZ );
+            pxEntry->ulLastUsed = ++ulSessionCacheClock;
+            pxEntry->xValid = pdTRUE;
+
+            #if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+
+                /* A resumed session has the master secret that was saved by the
+                 * full handshake, so only new sessions are written out. */
+                if( pdFALSE == xResumed )
+                {
+                    uint8_t * pucBlob = pvPortMalloc( tlsSESSION_BLOB_MAX_LENGTH ); /*lint !e9079 Allow casting void* to other types. */
+                    size_t xBlobLength = 0;
+
+                    if( NULL != pucBlob )
+                    {
+                        xBlobLength = prvSerializeSession( &pxEntry->xSession, pucBlob );
+                    }
+
+                    prvUnlock();
+
+                    if( xBlobLength > 0 )
+                    {
+                        ( void ) xApplicationTlsSessionSave( pxCtx->pcDestination, pucBlob, xBlobLength );
+                    }
+
+                    if( NULL != pucBlob )
+                    {
+                        mbedtls_platform_zeroize( pucBlob, tlsSESSION_BLOB_MAX_LENGTH );
+                        vPortFree( pucBlob );
+                    }
+                }
+                else
+                {
+                    prvUnlock();
+                }
+            #else /* if ( tlsconfigSESSION_CACHE_PERSIST == 1 ) */
+                ( void ) xResumed;
+                prvUnlock();
+            #endif /* if ( tlsconfigSESSION_CACHE_PERSIST == 1 ) */
+        }
+
+        mbedtls_ssl_session_free( &xSession );
+    }
+#endif /* if ( tlsconfigSESSION_CACHE_ENTRIES > 0 ) */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Maps a record length to its max_fragment_length extension code.
+ *
+ * @param[in] ulLength Largest record the server may send.
+ *
+ * @return The extension code, or MBEDTLS_SSL_MAX_FRAG_LEN_NONE if the length
+ * is not one that the extension can express.
+ */
+static unsigned char prvMaxFragmentLengthCode( uint32_t ulLength )
+{
+    unsigned char ucCode;
+
+    switch( ulLength )
+    {
+        case 512:
+            ucCode = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+            break;
+
+        case 1024:
+            ucCode = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+            break;
+
+        case 2048:
+            ucCode = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+            break;
+
+        case 4096:
+            ucCode = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+            break;
+
+        default:
+            ucCode = MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+            break;
+    }
+
+    return ucCode;
+}
+
+/*
+ * Interface routines.
+ */
+
+BaseType_t TLS_Init( void ** ppvContext,
+                     TLSParams_t * pxParams )
+{
+    BaseType_t xResult = 0;
+    TLSContext_t * pxCtx = NULL;
+    CK_C_GetFunctionList xCkGetFunctionList = NULL;
+
+    /* Allocate an internal context. */
+    pxCtx = ( TLSContext_t * ) pvPortMalloc( sizeof( TLSContext_t ) ); /*lint !e9087 !e9079 Allow casting void* to other types. */
+
+    if( NULL != pxCtx )
+    {
+        memset( pxCtx, 0, sizeof( TLSContext_t ) );
+        *ppvContext = pxCtx;
+
+        /* Initialize the context. */
+        pxCtx->pcDestination = pxParams->pcDestination;
+        pxCtx->pcServerCertificate = pxParams->pcServerCertificate;
+        pxCtx->ulServerCertificateLength = pxParams->ulServerCertificateLength;
+        pxCtx->ppcAlpnProtocols = pxParams->ppcAlpnProtocols;
+        pxCtx->ulAlpnProtocolsCount = pxParams->ulAlpnProtocolsCount;
+        pxCtx->xNetworkRecv = pxParams->pxNetworkRecv;
+        pxCtx->xNetworkSend = pxParams->pxNetworkSend;
+        pxCtx->pvCallerContext = pxParams->pvCallerContext;
+        pxCtx->pxCiphersuites = pxParams->pxCiphersuites;
+        pxCtx->ucMaxFragmentLengthCode = prvMaxFragmentLengthCode(
+            ( 0U != pxParams->ulMaxFragmentLength ) ? pxParams->ulMaxFragmentLength :
+            ( uint32_t ) tlsconfigMAX_FRAGMENT_LENGTH );
+
+        #ifdef tlsconfigCIPHERSUITES
+            if( NULL == pxCtx->pxCiphersuites )
+            {
+                pxCtx->pxCiphersuites = xDefaultCiphersuites;
+            }
+        #endif
+
+        /* Get the function pointer list for the PKCS#11 module. */
+        xCkGetFunctionList = C_GetFunctionList;
+        xResult = ( BaseType_t ) xCkGetFunctionList( &pxCtx->xP11FunctionList );
+
+        /* Ensure that the PKCS #11 module is initialized. */
+        if( 0 == xResult )
+        {
+            xResult = ( BaseType_t ) pxCtx->xP11FunctionList->C_Initialize( NULL );
+
+            /* It is ok if the module was previously initialized. */
+            if( xResult == CKR_CRYPTOKI_ALREADY_INITIALIZED )
+            {
+                xResult = CKR_OK;
+            }
+        }
+    }
+    else
+    {
+        xResult = ( BaseType_t ) CKR_HOST_MEMORY;
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+#ifdef MBEDTLS_DEBUG_C
+    static void prvTlsDebugPrint( void * ctx,
+                                  int lLevel,
+                                  const char * pcFile,
+                                  int lLine,
+                                  const char * pcStr )
+    {
+        /* Unused parameters. */
+        ( void ) ctx;
+        ( void ) pcFile;
+        ( void ) lLine;
+
+        /* Send the debug string to the portable logger. */
+        vLoggingPrintf( "mbedTLS: |%d| %s", lLevel, pcStr );
+    }
+#endif /* ifdef MBEDTLS_DEBUG_C */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Ends the handshake: records its outcome and releases what only the
+ * handshake needed.
+ *
+ * @param[in] pxCtx TLS context.
+ * @param[in] xResult Outcome of the handshake.
+ *
+ * @return xResult, with PKCS #11 failures converted to a TLS error code.
+ */
+static BaseType_t prvConnectDone( TLSContext_t * pxCtx,
+                                  BaseType_t xResult )
+{
+    BaseType_t xResumed = pdFALSE;
+
+    pxCtx->xHandshakePending = pdFALSE;
+
+    /* Keep track of successful completion of the handshake. */
+    if( 0 == xResult )
+    {
+        pxCtx->xTLSHandshakeSuccessful = pdTRUE;
+
+        /* The server accepted the offered session if the master secret is
+         * unchanged; otherwise it fell back to a full handshake. */
+        if( ( pdTRUE == pxCtx->xOffered ) &&
+            ( 0 == memcmp( pxCtx->ucOfferedMaster,
+                           pxCtx->xMbedSslCtx.session->master,
+                           sizeof( pxCtx->ucOfferedMaster ) ) ) )
+        {
+            xResumed = pdTRUE;
+        }
+
+        prvRecordHandshake( xResumed,
+                            ( uint32_t ) ( xTaskGetTickCount() - pxCtx->xHandshakeStart ) * portTICK_PERIOD_MS,
+                            ( uint32_t ) ( pxCtx->xHeapStart - pxCtx->xHeapLowest ) );
+
+        #if ( tlsconfigSESSION_CACHE_ENTRIES > 0 )
+            if( pdTRUE == pxCtx->xCacheable )
+            {
+                prvSessionCacheStore( pxCtx, xResumed );
+            }
+        #endif
+    }
+    else
+    {
+        if( pdTRUE == prvLock() )
+        {
+            xTlsMetrics.ulFailedHandshakes++;
+            prvUnlock();
+        }
+
+        if( xResult > 0 )
+        {
+            TLS_PRINT( ( "ERROR: TLS_Connect failed with error code %d \r\n", xResult ) );
+            /* Convert PKCS #11 failures to a negative error code. */
+            xResult = TLS_ERROR_HANDSHAKE_FAILED;
+        }
+    }
+
+    if( pdTRUE == pxCtx->xOffered )
+    {
+        mbedtls_platform_zeroize( pxCtx->ucOfferedMaster, sizeof( pxCtx->ucOfferedMaster ) );
+    }
+
+    /* Free up allocated memory. */
+    mbedtls_x509_crt_free( &pxCtx->xMbedX509CA );
+
+    if( NULL != pxCtx->pxCredentials )
+    {
+        prvReleaseCredentials( pxCtx->pxCredentials );
+        pxCtx->pxCredentials = NULL;
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t TLS_ConnectStart( void * pvContext )
+{
+    BaseType_t xResult = 0;
+    TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
+
+    pxCtx->xHandshakePending = pdTRUE;
+    pxCtx->xCacheable = pdFALSE;
+    pxCtx->xOffered = pdFALSE;
+    pxCtx->xHeapStart = xPortGetFreeHeapSize();
+    pxCtx->xHeapLowest = pxCtx->xHeapStart;
+
+    /* Ensure that the FreeRTOS heap is used. */
+    CRYPTO_ConfigureHeap();
+
+    /* Initialize mbedTLS structures. */
+    mbedtls_ssl_init( &pxCtx->xMbedSslCtx );
+    mbedtls_ssl_config_init( &pxCtx->xMbedSslConfig );
+    mbedtls_x509_crt_init( &pxCtx->xMbedX509CA );
+
+    /* Decode the root certificate override. The default root certificates
+     * are decoded once along with the device credentials. */
+    if( NULL != pxCtx->pcServerCertificate )
+    {
+        xResult = mbedtls_x509_crt_parse( &pxCtx->xMbedX509CA,
+                                          ( const unsigned char * ) pxCtx->pcServerCertificate,
+                                          pxCtx->ulServerCertificateLength );
+
+        if( 0 != xResult )
+        {
+            TLS_PRINT( ( "ERROR: Failed to parse custom server certificates %d \r\n", xResult ) );
+        }
+    }
+
+    /* Start with protocol defaults. */
+    if( 0 == xResult )
+    {
+        xResult = mbedtls_ssl_config_defaults( &pxCtx->xMbedSslConfig,
+                                               MBEDTLS_SSL_IS_CLIENT,
+                                               MBEDTLS_SSL_TRANSPORT_STREAM,
+                                               MBEDTLS_SSL_PRESET_DEFAULT );
+
+
+        if( 0 != xResult )
+        {
+            TLS_PRINT( ( "ERROR: Failed to set ssl config defaults %d \r\n", xResult ) );
+        }
+    }
+
+    if( 0 == xResult )
+    {
+        /* Use a callback for additional server certificate validation. */
+        mbedtls_ssl_conf_verify( &pxCtx->xMbedSslConfig,
+                                 &prvCheckCertificate,
+                                 pxCtx );
+
+        /* Server certificate validation is mandatory. */
+        mbedtls_ssl_conf_authmode( &pxCtx->xMbedSslConfig, MBEDTLS_SSL_VERIFY_REQUIRED );
+
+        /* Set the RNG callback. */
+        mbedtls_ssl_conf_rng( &pxCtx->xMbedSslConfig, &prvGenerateRandomBytes, pxCtx ); /*lint !e546 Nothing wrong here. */
+
+        /* Offer the requested ciphersuites in the requested order. */
+        if( NULL != pxCtx->pxCiphersuites )
+        {
+            mbedtls_ssl_conf_ciphersuites( &pxCtx->xMbedSslConfig, pxCtx->pxCiphersuites );
+        }
+
+        /* Ask the server for small records, which lets the record buffers
+         * shrink after the handshake. */
+        #ifdef MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+            if( MBEDTLS_SSL_MAX_FRAG_LEN_NONE != pxCtx->ucMaxFragmentLengthCode )
+            {
+                ( void ) mbedtls_ssl_conf_max_frag_len( &pxCtx->xMbedSslConfig,
+                                                        pxCtx->ucMaxFragmentLengthCode );
+            }
+        #endif
 
         /* Configure the SSL context for the device credentials. */
         xResult = prvInitializeClientCredential( pxCtx );
     }
 
+    if( 0 == xResult )
+    {
+        /* Set issuer certificate. */
+        if( NULL != pxCtx->pcServerCertificate )
+        {
+            mbedtls_ssl_conf_ca_chain( &pxCtx->xMbedSslConfig, &pxCtx->xMbedX509CA, NULL );
+        }
+        else
+        {
+            mbedtls_ssl_conf_ca_chain( &pxCtx->xMbedSslConfig, &pxCtx->pxCredentials->xRootCA, NULL );
+        }
+    }
+
     if( ( 0 == xResult ) && ( NULL != pxCtx->ppcAlpnProtocols ) )
     {
         /* Include an application protocol list in the TLS ClientHello
@@ -722,6 +1592,18 @@ BaseType_t TLS_Connect( void * pvContext )
         xResult = mbedtls_ssl_set_hostname( &pxCtx->xMbedSslCtx, pxCtx->pcDestination );
     }
 
+    #if ( tlsconfigSESSION_CACHE_ENTRIES > 0 )
+
+        /* Offer the session saved by the last connection to this server. */
+        if( ( 0 == xResult ) &&
+            ( NULL != pxCtx->pcDestination ) &&
+            ( strlen( pxCtx->pcDestination ) < tlsconfigSESSION_CACHE_MAX_NAME_LENGTH ) )
+        {
+            pxCtx->xCacheable = pdTRUE;
+            pxCtx->xOffered = prvSessionCacheOffer( pxCtx, pxCtx->ucOfferedMaster );
+        }
+    #endif
+
     /* Set the socket callbacks. */
     if( 0 == xResult )
     {
@@ -731,10 +1613,43 @@ BaseType_t TLS_Connect( void * pvContext )
                              prvNetworkRecv,
                              NULL );
 
-        /* Negotiate. */
-        while( 0 != ( xResult = mbedtls_ssl_handshake( &pxCtx->xMbedSslCtx ) ) )
+        pxCtx->xHandshakeStart = xTaskGetTickCount();
+    }
+    else
+    {
+        xResult = prvConnectDone( pxCtx, xResult );
+    }
+
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t TLS_ConnectStep( void * pvContext )
+{
+    BaseType_t xResult = 0;
+    TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
+
+    if( pdTRUE != pxCtx->xHandshakePending )
+    {
+        xResult = TLS_ERROR_HANDSHAKE_FAILED;
+    }
+    else
+    {
+        /* Negotiate one message at a time, keeping track of the heap in use
+         * at its highest, until the network has to be waited for. */
+        while( ( 0 == xResult ) &&
+               ( MBEDTLS_SSL_HANDSHAKE_OVER != pxCtx->xMbedSslCtx.state ) )
         {
-            if( ( MBEDTLS_ERR_SSL_WANT_READ != xResult ) &&
+            xResult = mbedtls_ssl_handshake_step( &pxCtx->xMbedSslCtx );
+
+            if( xPortGetFreeHeapSize() < pxCtx->xHeapLowest )
+            {
+                pxCtx->xHeapLowest = xPortGetFreeHeapSize();
+            }
+
+            if( ( 0 != xResult ) &&
+                ( MBEDTLS_ERR_SSL_WANT_READ != xResult ) &&
                 ( MBEDTLS_ERR_SSL_WANT_WRITE != xResult ) )
             {
                 /* There was an unexpected error. Per mbedTLS API documentation,
@@ -742,27 +1657,41 @@ BaseType_t TLS_Connect( void * pvContext )
                  * a context that failed the handshake. */
                 prvFreeContext( pxCtx );
                 TLS_PRINT( ( "ERROR: Handshake failed with error code %d \r\n", xResult ) );
-                break;
             }
         }
+
+        if( MBEDTLS_ERR_SSL_WANT_READ == xResult )
+        {
+            xResult = TLS_ERROR_WANT_READ;
+        }
+        else if( MBEDTLS_ERR_SSL_WANT_WRITE == xResult )
+        {
+            xResult = TLS_ERROR_WANT_WRITE;
+        }
+        else
+        {
+            xResult = prvConnectDone( pxCtx, xResult );
+        }
     }
 
-    /* Keep track of successful completion of the handshake. */
+    return xResult;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t TLS_Connect( void * pvContext )
+{
+    BaseType_t xResult = TLS_ConnectStart( pvContext );
+
     if( 0 == xResult )
     {
-        pxCtx->xTLSHandshakeSuccessful = pdTRUE;
-    }
-    else if( xResult > 0 )
-    {
-        TLS_PRINT( ( "ERROR: TLS_Connect failed with error code %d \r\n", xResult ) );
-        /* Convert PKCS #11 failures to a negative error code. */
-        xResult = TLS_ERROR_HANDSHAKE_FAILED;
+        do
+        {
+            xResult = TLS_ConnectStep( pvContext );
+        } while( ( TLS_ERROR_WANT_READ == xResult ) ||
+                 ( TLS_ERROR_WANT_WRITE == xResult ) );
     }
 
-    /* Free up allocated memory. */
-    mbedtls_x509_crt_free( &pxCtx->xMbedX509CA );
-    mbedtls_x509_crt_free( &pxCtx->xMbedX509Cli );
-
     return xResult;
 }
 
@@ -877,7 +1806,13 @@ void TLS_Cleanup( void * pvContext )
 
     if( NULL != pxCtx )
     {
-        if( pdTRUE == pxCtx->xTLSHandshakeSuccessful )
+        if( pdTRUE == pxCtx->xHandshakePending )
+        {
+            /* The handshake was abandoned part way. */
+            prvFreeContext( pxCtx );
+            ( void ) prvConnectDone( pxCtx, TLS_ERROR_HANDSHAKE_FAILED );
+        }
+        else if( pdTRUE == pxCtx->xTLSHandshakeSuccessful )
         {
             prvFreeContext( pxCtx );
         }
@@ -886,3 +1821,74 @@ void TLS_Cleanup( void * pvContext )
         vPortFree( pxCtx );
     }
 }
+
+/*-----------------------------------------------------------*/
+
+void TLS_GetMetrics( TLSMetrics_t * pxMetrics )
+{
+    if( NULL != pxMetrics )
+    {
+        if( pdTRUE == prvLock() )
+        {
+            memcpy( pxMetrics, &xTlsMetrics, sizeof( TLSMetrics_t ) );
+            prvUnlock();
+        }
+        else
+        {
+            memset( pxMetrics, 0, sizeof( TLSMetrics_t ) );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void TLS_InvalidateCredentials( void )
+{
+    if( pdTRUE == prvLock() )
+    {
+        /* Connections in progress keep using the old credentials; the last of
+         * them frees them. */
+        if( ( NULL != pxSharedCredentials ) && ( 0 == pxSharedCredentials->ulUsers ) )
+        {
+            prvFreeCredentials( pxSharedCredentials );
+        }
+
+        pxSharedCredentials = NULL;
+        prvUnlock();
+    }
+
+    /* Sessions negotiated with the old device certificate must not be
+     * resumed. */
+    TLS_FlushSessionCache( NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+void TLS_FlushSessionCache( const char * pcDestination )
+{
+    #if ( tlsconfigSESSION_CACHE_ENTRIES > 0 )
+        BaseType_t x;
+
+        if( pdTRUE == prvLock() )
+        {
+            for( x = 0; x < tlsconfigSESSION_CACHE_ENTRIES; x++ )
+            {
+                if( ( pdTRUE == xSessionCache[ x ].xValid ) &&
+                    ( ( NULL == pcDestination ) ||
+                      ( 0 == strcmp( xSessionCache[ x ].cDestination, pcDestination ) ) ) )
+                {
+                    mbedtls_ssl_session_free( &xSessionCache[ x ].xSession );
+                    xSessionCache[ x ].xValid = pdFALSE;
+                }
+            }
+
+            prvUnlock();
+        }
+
+        #if ( tlsconfigSESSION_CACHE_PERSIST == 1 )
+            ( void ) xApplicationTlsSessionSave( pcDestination, NULL, 0 );
+        #endif
+    #else /* if ( tlsconfigSESSION_CACHE_ENTRIES > 0 ) */
+        ( void ) pcDestination;
+    #endif /* if ( tlsconfigSESSION_CACHE_ENTRIES > 0 ) */
+}
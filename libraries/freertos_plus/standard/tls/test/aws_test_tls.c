@@ -26,12 +26,17 @@
 /* Standard includes. */
 #include <string.h>
 
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
 /* Test framework includes. */
 #include "unity_fixture.h"
 #include "aws_test_runner.h"
 
 /* Secure sockets includes */
 #include "aws_secure_sockets.h"
+#include "aws_tls.h"
 
 /* Credential includes. */
 #include "aws_clientcredential.h"
@@ -96,6 +101,9 @@ TEST_GROUP_RUNNER( Quarantine_TLS )
 {
     RUN_TEST_CASE( Quarantine_TLS, AFQP_TLS_ConnectEC );
     RUN_TEST_CASE( Quarantine_TLS, AFQP_TLS_ConnectBYOCCredentials );
+    RUN_TEST_CASE( Quarantine_TLS, AFQP_TLS_ConnectResumesSession );
+    RUN_TEST_CASE( Quarantine_TLS, AFQP_TLS_ConnectReusesCredentials );
+    RUN_TEST_CASE( Quarantine_TLS, AFQP_TLS_ConnectHeapUsage );
 }
 
 /*-----------------------------------------------------------*/
@@ -358,3 +366,139 @@ TEST( Quarantine_TLS, AFQP_TLS_ConnectBYOCCredentials )
                                 );
 }
 /*-----------------------------------------------------------*/
+
+static void prvConnectAndClose( void )
+{
+    const char * pcAWSIoTAddress = clientcredentialMQTT_BROKER_ENDPOINT;
+    SocketsSockaddr_t xMQTTServerAddress = { 0 };
+    Socket_t xSocket;
+    BaseType_t xResult;
+
+    xMQTTServerAddress.ulAddress = SOCKETS_GetHostByName( pcAWSIoTAddress );
+    xMQTTServerAddress.usPort = SOCKETS_htons( clientcredentialMQTT_BROKER_PORT );
+    xMQTTServerAddress.ucSocketDomain = SOCKETS_AF_INET;
+
+    xSocket = prvSecureSocketCreate();
+
+    if( TEST_PROTECT() )
+    {
+        xResult = SOCKETS_SetSockOpt( xSocket, 0, SOCKETS_SO_SERVER_NAME_INDICATION, pcAWSIoTAddress, 1u + strlen( pcAWSIoTAddress ) );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket set sock opt server name indication failed" );
+
+        xResult = SOCKETS_Connect( xSocket, &xMQTTServerAddress, sizeof( xMQTTServerAddress ) );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket connect failed" );
+
+        xResult = SOCKETS_Shutdown( xSocket, SOCKETS_SHUT_RDWR );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket disconnect failed" );
+    }
+
+    prvSecureSocketClose( xSocket );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Quarantine_TLS, AFQP_TLS_ConnectResumesSession )
+{
+    TLSMetrics_t xBefore;
+    TLSMetrics_t xAfter;
+
+    /* The first connection performs a full handshake and saves the session. */
+    TLS_FlushSessionCache( clientcredentialMQTT_BROKER_ENDPOINT );
+    TLS_GetMetrics( &xBefore );
+    prvConnectAndClose();
+    TLS_GetMetrics( &xAfter );
+    TEST_ASSERT_EQUAL_UINT32( xBefore.ulFullHandshakes + 1, xAfter.ulFullHandshakes );
+
+    /* The reconnect resumes it. */
+    xBefore = xAfter;
+    prvConnectAndClose();
+    TLS_GetMetrics( &xAfter );
+    TEST_ASSERT_EQUAL_UINT32( xBefore.ulResumedHandshakes + 1, xAfter.ulResumedHandshakes );
+
+    configPRINTF( ( "TLS handshake: full %u ms, resumed %u ms\r\n",
+                    xBefore.ulLastHandshakeMs,
+                    xAfter.ulLastHandshakeMs ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Quarantine_TLS, AFQP_TLS_ConnectReusesCredentials )
+{
+    TLSMetrics_t xBefore;
+    TLSMetrics_t xAfter;
+    TickType_t xColdTicks;
+    TickType_t xWarmTicks;
+    uint32_t ulLoadMs;
+
+    /* Force the first connection to read and decode the credentials. Flushing
+     * the session cache makes both connections perform a full handshake. */
+    TLS_InvalidateCredentials();
+    TLS_GetMetrics( &xBefore );
+    xColdTicks = xTaskGetTickCount();
+    prvConnectAndClose();
+    xColdTicks = xTaskGetTickCount() - xColdTicks;
+    TLS_GetMetrics( &xAfter );
+    TEST_ASSERT_EQUAL_UINT32( xBefore.ulCredentialLoads + 1, xAfter.ulCredentialLoads );
+    ulLoadMs = xAfter.ulCredentialLoadMs - xBefore.ulCredentialLoadMs;
+
+    /* The second connection reuses them. */
+    xBefore = xAfter;
+    TLS_FlushSessionCache( NULL );
+    xWarmTicks = xTaskGetTickCount();
+    prvConnectAndClose();
+    xWarmTicks = xTaskGetTickCount() - xWarmTicks;
+    TLS_GetMetrics( &xAfter );
+    TEST_ASSERT_EQUAL_UINT32( xBefore.ulCredentialLoads, xAfter.ulCredentialLoads );
+
+    configPRINTF( ( "TLS connect: %u ms loading credentials, %u ms reusing them (load took %u ms)\r\n",
+                    ( uint32_t ) ( xColdTicks * portTICK_PERIOD_MS ),
+                    ( uint32_t ) ( xWarmTicks * portTICK_PERIOD_MS ),
+                    ulLoadMs ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Quarantine_TLS, AFQP_TLS_ConnectHeapUsage )
+{
+    const char * pcAWSIoTAddress = clientcredentialMQTT_BROKER_ENDPOINT;
+    SocketsSockaddr_t xMQTTServerAddress = { 0 };
+    TLSMetrics_t xMetrics;
+    Socket_t xSocket;
+    BaseType_t xResult;
+    size_t xHeapBefore;
+    size_t xHeapConnected;
+
+    /* Load the credentials first so that they are not counted, and flush the
+     * session so that the measured connection performs a full handshake. */
+    prvConnectAndClose();
+    TLS_FlushSessionCache( pcAWSIoTAddress );
+
+    xMQTTServerAddress.ulAddress = SOCKETS_GetHostByName( pcAWSIoTAddress );
+    xMQTTServerAddress.usPort = SOCKETS_htons( clientcredentialMQTT_BROKER_PORT );
+    xMQTTServerAddress.ucSocketDomain = SOCKETS_AF_INET;
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    xSocket = prvSecureSocketCreate();
+
+    if( TEST_PROTECT() )
+    {
+        xResult = SOCKETS_SetSockOpt( xSocket, 0, SOCKETS_SO_SERVER_NAME_INDICATION, pcAWSIoTAddress, 1u + strlen( pcAWSIoTAddress ) );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket set sock opt server name indication failed" );
+
+        xResult = SOCKETS_Connect( xSocket, &xMQTTServerAddress, sizeof( xMQTTServerAddress ) );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket connect failed" );
+
+        /* The record buffers have shrunk by now. */
+        xHeapConnected = xPortGetFreeHeapSize();
+        TLS_GetMetrics( &xMetrics );
+        TEST_ASSERT_GREATER_THAN_UINT32( 0, xMetrics.ulLastHandshakePeakHeap );
+
+        configPRINTF( ( "TLS connection heap: %u bytes at the handshake peak, %u bytes once connected (%u byte records)\r\n",
+                        xMetrics.ulLastHandshakePeakHeap,
+                        ( uint32_t ) ( xHeapBefore - xHeapConnected ),
+                        ( uint32_t ) tlsconfigMAX_FRAGMENT_LENGTH ) );
+
+        xResult = SOCKETS_Shutdown( xSocket, SOCKETS_SHUT_RDWR );
+        TEST_ASSERT_EQUAL_INT32_MESSAGE( SOCKETS_ERROR_NONE, xResult, "Socket disconnect failed" );
+    }
+
+    prvSecureSocketClose( xSocket );
+}
+/*-----------------------------------------------------------*/
@@ -133,6 +133,18 @@ static void RunTests( void )
         RUN_TEST_GROUP( Full_OTA_PAL );
     #endif
 
+    #if ( testrunnerFULL_OTA_DECOMPRESS_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_OTA_DECOMPRESS );
+    #endif
+
+    #if ( testrunnerFULL_OTA_HTTP_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_OTA_HTTP );
+    #endif
+
+    #if ( testrunnerFULL_OTA_SIM_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_OTA_SIM );
+    #endif
+
     #if ( testrunnerFULL_PKCS11_ENABLED == 1 )
         RUN_TEST_GROUP( Full_PKCS11_CryptoOperation );
         RUN_TEST_GROUP( Full_PKCS11_GeneralPurpose );
@@ -229,6 +241,11 @@ void TEST_RUNNER_RunTests_task( void * pvParameters )
     /* Currently disabled. Will be enabled after cleanup. */
     UNITY_END();
 
+    /* Let the board report the result, e.g. as the exit code of a host process. */
+    #ifdef testrunnerTESTS_COMPLETE_HOOK
+        testrunnerTESTS_COMPLETE_HOOK( Unity.TestFailures );
+    #endif
+
     #ifdef CODE_COVERAGE
         exit( 0 );
     #endif
@@ -29,12 +29,17 @@
 /* Non-Encrypted Echo Server.
  * Update tcptestECHO_SERVER_ADDR# and
  * tcptestECHO_PORT with IP address
- * and port of unencrypted TCP echo server. */
-#define tcptestECHO_SERVER_ADDR0         34
-#define tcptestECHO_SERVER_ADDR1         218
-#define tcptestECHO_SERVER_ADDR2         25
-#define tcptestECHO_SERVER_ADDR3         197
-#define tcptestECHO_PORT                 ( 8883 )
+ * and port of unencrypted TCP echo server.
+ * A board may also define them when compiling, e.g. to use a local server. */
+#ifndef tcptestECHO_SERVER_ADDR0
+    #define tcptestECHO_SERVER_ADDR0     34
+    #define tcptestECHO_SERVER_ADDR1     218
+    #define tcptestECHO_SERVER_ADDR2     25
+    #define tcptestECHO_SERVER_ADDR3     197
+#endif
+#ifndef tcptestECHO_PORT
+    #define tcptestECHO_PORT             ( 8883 )
+#endif
 
 /* Encrypted Echo Server.
  * If tcptestSECURE_SERVER is set to 1, the following must be updated:
@@ -46,7 +51,9 @@
  * using TLS.
  * 5. tcptestECHO_HOST_ROOT_CA with the trusted root certificate of the
  * echo server using TLS. */
-#define tcptestSECURE_SERVER             1
+#ifndef tcptestSECURE_SERVER
+    #define tcptestSECURE_SERVER         1
+#endif
 
 #define tcptestECHO_SERVER_TLS_ADDR0     34
 #define tcptestECHO_SERVER_TLS_ADDR1     218
@@ -54,6 +61,12 @@
 #define tcptestECHO_SERVER_TLS_ADDR3     197
 #define tcptestECHO_PORT_TLS             ( 443 )
 
+/* Host name the DNS tests resolve, the AWS IoT endpoint unless a board
+ * defines it when compiling, e.g. to a name the host resolves itself. */
+#ifndef tcptestDNS_HOST_NAME
+    #define tcptestDNS_HOST_NAME         clientcredentialMQTT_BROKER_ENDPOINT
+#endif
+
 /* Number of times to retry a connection if it fails. */
 #define tcptestRETRY_CONNECTION_TIMES    6
 
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""TCP echo server for the secure sockets tests of the host board.
+
+Echoes back everything each client sends, until the client closes. Run in the
+foreground, or with --daemon to detach once the server listens, which is how
+CTest starts it around the tests:
+
+    echo_server.py --port 9923 --daemon --pid-file echo_server.pid
+    echo_server.py --stop --pid-file echo_server.pid
+"""
+
+import argparse
+import os
+import signal
+import socket
+import socketserver
+import sys
+
+
+class EchoHandler(socketserver.BaseRequestHandler):
+    def handle(self):
+        while True:
+            try:
+                data = self.request.recv(4096)
+            except ConnectionError:
+                return
+            if not data:
+                return
+            try:
+                self.request.sendall(data)
+            except ConnectionError:
+                return
+
+
+class EchoServer(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+def stop(pid_file):
+    try:
+        with open(pid_file) as f:
+            pid = int(f.read())
+    except (OSError, ValueError):
+        return 0
+    try:
+        os.kill(pid, signal.SIGTERM)
+    except ProcessLookupError:
+        pass
+    os.remove(pid_file)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=9923)
+    parser.add_argument("--daemon", action="store_true",
+                        help="detach once listening")
+    parser.add_argument("--pid-file", help="file to write the server pid to")
+    parser.add_argument("--stop", action="store_true",
+                        help="stop the server of --pid-file")
+    args = parser.parse_args()
+
+    if args.stop:
+        return stop(args.pid_file)
+
+    # Bind before detaching, so that the tests never start before the server
+    # accepts connections and a busy port fails the setup.
+    server = EchoServer((args.host, args.port), EchoHandler)
+
+    pid = os.fork() if args.daemon else os.getpid()
+    if pid != 0:
+        if args.pid_file:
+            with open(args.pid_file, "w") as f:
+                f.write(str(pid))
+        if args.daemon:
+            return 0
+    else:
+        os.setsid()
+        devnull = os.open(os.devnull, os.O_RDWR)
+        for fd in (0, 1, 2):
+            os.dup2(devnull, fd)
+
+    signal.signal(signal.SIGTERM, lambda *_: sys.exit(0))
+    server.serve_forever()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
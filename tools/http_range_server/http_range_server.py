@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""HTTP range server for the OTA HTTP tests of the host board.
+
+Serves byte ranges of a generated file over HTTP/1.1 keep-alive connections,
+and misbehaves on request so that the tests can check how the OTA HTTP client
+copes with servers closing connections. Run in the foreground, or with --daemon
+to detach once the server listens, which is how CTest starts it around the
+tests:
+
+    http_range_server.py --port 9924 --daemon --pid-file http_range_server.pid
+    http_range_server.py --stop --pid-file http_range_server.pid
+
+The path names a file, optionally after one behaviour:
+
+    /image.bin             byte i of the file is (i * 31) & 0xff
+    /connection            every byte is the number of the connection, & 0xff,
+                           counting the connections accepted from 1
+    /close/<file>          answer with "Connection: close" and close
+    /drop-idle/<file>      close after the response without saying so, like a
+                           server dropping an idle kept-alive connection
+    /drop-body/<file>      close after sending half of the body
+
+Only GET with a single "Range: bytes=first-last" range is served, answered with
+206. A range past the end of the file gets 416, a missing range 400.
+"""
+
+import argparse
+import os
+import re
+import signal
+import socket
+import socketserver
+import sys
+import threading
+
+BEHAVIOURS = ("close", "drop-idle", "drop-body")
+RANGE = re.compile(r"bytes=(\d+)-(\d+)$")
+
+
+class RangeHandler(socketserver.BaseRequestHandler):
+    def setup(self):
+        with self.server.lock:
+            self.server.connections += 1
+            self.connection_number = self.server.connections
+        self.pending = b""
+
+    def read_request(self):
+        """Returns the request line and the headers, or None once the client
+        has closed the connection."""
+        while b"\r\n\r\n" not in self.pending:
+            try:
+                data = self.request.recv(4096)
+            except ConnectionError:
+                return None
+            if not data:
+                return None
+            self.pending += data
+        head, self.pending = self.pending.split(b"\r\n\r\n", 1)
+        lines = head.decode("latin-1").split("\r\n")
+        headers = {}
+        for line in lines[1:]:
+            name, _, value = line.partition(":")
+            headers[name.strip().lower()] = value.strip()
+        return lines[0], headers
+
+    def content(self, name, first, last):
+        if name == "image.bin":
+            return bytes((i * 31) & 0xFF for i in range(first, last + 1))
+        return bytes([self.connection_number & 0xFF]) * (last - first + 1)
+
+    def respond(self, status, headers, body=b"", sent=None):
+        """Sends a response whose header announces all of body, and the first
+        sent bytes of body, or all of it."""
+        head = "HTTP/1.1 %s\r\n" % status
+        head += "".join("%s: %s\r\n" % h for h in headers)
+        head += "Content-Length: %d\r\n\r\n" % len(body)
+        self.request.sendall(head.encode("latin-1") + body[:sent])
+
+    def handle_request(self, request_line, headers):
+        """Answers one request, and returns False when the connection must be
+        closed afterwards."""
+        try:
+            method, target, version = request_line.split(" ")
+        except ValueError:
+            self.respond("400 Bad Request", [("Connection", "close")])
+            return False
+
+        parts = target.split("?", 1)[0].strip("/").split("/")
+        behaviour = parts[0] if len(parts) == 2 else None
+        name = parts[-1]
+        keep_alive = (version == "HTTP/1.1" and
+                      headers.get("connection", "").lower() != "close")
+        extra = []
+        if behaviour == "close":
+            extra.append(("Connection", "close"))
+            keep_alive = False
+
+        if (method != "GET" or name not in ("image.bin", "connection") or
+                (len(parts) == 2 and behaviour not in BEHAVIOURS) or
+                len(parts) > 2):
+            self.respond("404 Not Found", extra)
+            return keep_alive
+
+        size = self.server.size
+        match = RANGE.match(headers.get("range", ""))
+        if not match:
+            self.respond("400 Bad Request", extra)
+            return keep_alive
+        first, last = int(match.group(1)), int(match.group(2))
+        if first > last or first >= size:
+            self.respond("416 Range Not Satisfiable",
+                         extra + [("Content-Range", "bytes */%d" % size)])
+            return keep_alive
+        last = min(last, size - 1)
+
+        extra.append(("Content-Range", "bytes %d-%d/%d" % (first, last, size)))
+        body = self.content(name, first, last)
+        if behaviour == "drop-body":
+            self.respond("206 Partial Content", extra, body, len(body) // 2)
+            return False
+
+        self.respond("206 Partial Content", extra, body)
+        return keep_alive and behaviour != "drop-idle"
+
+    def handle(self):
+        while True:
+            request = self.read_request()
+            if request is None:
+                return
+            try:
+                if not self.handle_request(*request):
+                    break
+            except ConnectionError:
+                return
+        try:
+            self.request.shutdown(socket.SHUT_RDWR)
+        except OSError:
+            pass
+
+
+class RangeServer(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+    def __init__(self, address, size):
+        super().__init__(address, RangeHandler)
+        self.size = size
+        self.connections = 0
+        self.lock = threading.Lock()
+
+
+def stop(pid_file):
+    try:
+        with open(pid_file) as f:
+            pid = int(f.read())
+    except (OSError, ValueError):
+        return 0
+    try:
+        os.kill(pid, signal.SIGTERM)
+    except ProcessLookupError:
+        pass
+    os.remove(pid_file)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=9924)
+    parser.add_argument("--size", type=int, default=65536,
+                        help="size of the served files")
+    parser.add_argument("--daemon", action="store_true",
+                        help="detach once listening")
+    parser.add_argument("--pid-file", help="file to write the server pid to")
+    parser.add_argument("--stop", action="store_true",
+                        help="stop the server of --pid-file")
+    args = parser.parse_args()
+
+    if args.stop:
+        return stop(args.pid_file)
+
+    # Bind before detaching, so that the tests never start before the server
+    # accepts connections and a busy port fails the setup.
+    server = RangeServer((args.host, args.port), args.size)
+
+    pid = os.fork() if args.daemon else os.getpid()
+    if pid != 0:
+        if args.pid_file:
+            with open(args.pid_file, "w") as f:
+                f.write(str(pid))
+        if args.daemon:
+            return 0
+    else:
+        os.setsid()
+        devnull = os.open(os.devnull, os.O_RDWR)
+        for fd in (0, 1, 2):
+            os.dup2(devnull, fd)
+
+    signal.signal(signal.SIGTERM, lambda *_: sys.exit(0))
+    server.serve_forever()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
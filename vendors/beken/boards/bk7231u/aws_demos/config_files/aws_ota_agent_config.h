@@ -56,6 +56,30 @@
  */
 #define otaconfigFILE_REQUEST_WAIT_MS           2500U
 
+/**
+ * @brief Number of received blocks between saves of the transfer state.
+ *
+ * An interrupted download continues from the last saved state after a reset or
+ * reconnect instead of starting over. Set to 0 to always restart downloads.
+ */
+#define otaconfigRESUME_SAVE_INTERVAL_BLOCKS    32U
+
+/**
+ * @brief Number of file blocks fetched by each HTTP range request.
+ *
+ * Only used when the job document gives a download URL for the file. The
+ * blocks of a request are received one at a time so this doesn't affect RAM use.
+ */
+#define otaconfigHTTP_BLOCKS_PER_REQUEST        8U
+
+/**
+ * @brief Root certificate of the HTTPS download server, in PEM format.
+ *
+ * Left undefined, HTTPS downloads only trust the AWS IoT root certificates, so
+ * downloads from pre-signed S3 URLs fail. See aws_ota_http.h.
+ */
+/* #define otaconfigHTTP_TRUSTED_SERVER_CERTIFICATE    "-----BEGIN CERTIFICATE-----\n...-----END CERTIFICATE-----\n" */
+
 /**
  * @brief The OTA agent task priority. Normally it runs at a low priority.
  */
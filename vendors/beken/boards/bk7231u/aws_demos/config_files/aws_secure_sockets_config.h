@@ -54,4 +54,11 @@
  */
 #define socketsconfigDEFAULT_MAX_NUM_SECURE_SOCKETS     6
 
+/**
+ * @brief Host names kept resolved in the background, so that reconnects do
+ * not wait for DNS. OTA updates arrive over the same MQTT endpoint.
+ */
+#include "aws_clientcredential.h"
+#define socketsconfigDNS_PREFETCH_HOSTS    clientcredentialMQTT_BROKER_ENDPOINT
+
 #endif /* _AWS_SECURE_SOCKETS_CONFIG_H_ */
@@ -31,6 +31,9 @@
 #define testrunnerFULL_OTA_CBOR_ENABLED            testrunnerUNSUPPORTED
 #define testrunnerFULL_OTA_AGENT_ENABLED           testrunnerUNSUPPORTED
 #define testrunnerFULL_OTA_PAL_ENABLED             testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_DECOMPRESS_ENABLED      testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_HTTP_ENABLED            testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_SIM_ENABLED             testrunnerUNSUPPORTED
 #define testrunnerFULL_CBOR_ENABLED                testrunnerUNSUPPORTED
 #define testrunnerFULL_POSIX_ENABLED               testrunnerUNSUPPORTED
 
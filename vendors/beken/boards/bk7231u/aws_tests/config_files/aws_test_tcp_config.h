@@ -73,5 +73,10 @@
  */
 #define         tcptestECHO_TEST_SYNC_TIMEOUT                      180000 /* MS */
 
+/**
+ * @brief       The lwIP secure sockets cache host names, test the cache.
+ */
+#define         tcptestDNS_CACHE                                   1
+
 
 #endif /*AWS_INTEGRATION_TEST_TCP_CONFIG_H */
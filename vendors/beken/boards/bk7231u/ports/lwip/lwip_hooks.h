@@ -0,0 +1,21 @@
+#ifndef __LWIP_HOOKS_H__
+#define __LWIP_HOOKS_H__
+
+#include "lwip/ip_addr.h"
+
+/* Implemented by the secure sockets port, which caches each answer for as
+ * long as its TTL allows. ulAddress is in network byte order. */
+void vSocketsDnsAnswer( const char * pcHostName,
+                        u32_t ulAddress,
+                        u32_t ulTTL );
+
+#define LWIP_HOOK_DNS_ANSWER( name, addr, ttl )                          \
+    do {                                                                 \
+        if( IP_IS_V4( addr ) )                                           \
+        {                                                                \
+            vSocketsDnsAnswer( ( name ), ip_addr_get_ip4_u32( addr ), ( ttl ) ); \
+        }                                                                \
+    } while( 0 )
+
+#endif
+// eof
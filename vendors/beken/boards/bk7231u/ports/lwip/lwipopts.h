@@ -316,6 +316,9 @@
 
 #define MDNS_TABLE_SIZE                 1  // number of mDNS table entries
 #define MDNS_MAX_SERVERS                1  // number of mDNS multicast addresses
+
+/* Lets the secure sockets DNS cache learn the TTL of each answer. */
+#define LWIP_HOOK_FILENAME             "lwip_hooks.h"
 /* TODO: Number of active UDP PCBs is equal to number of active UDP sockets plus
  * two. Need to find the users of these 2 PCBs
  */
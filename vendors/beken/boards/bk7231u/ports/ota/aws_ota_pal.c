@@ -36,6 +36,7 @@
 
 #include "BkDriverFlash.h"
 #include "flash.h"
+#include "kv/kvmgr.h"
 
 /* definitions shared with the resident bootloader. */
 #define AWS_OTA_IMAGE_MAGIC         "@BK"
@@ -46,6 +47,9 @@
 #define AWS_OTA_FLAG_IMG_VALID             0xfcU /* 11111100b The image was accepted as valid by the self test code. */
 #define AWS_OTA_FLAG_IMG_INVALID           0xf8U /* 11111000b The image was NOT accepted by the self test code. */
 
+/* Key-value store item holding the transfer state of an interrupted OTA. */
+#define AWS_OTA_RESUME_STATE_KEY           "ota_resume"
+
 typedef struct
 {
     const OTA_FileContext_t * pxCurOTAFile; /* Current OTA file to be processed. */
@@ -71,6 +75,19 @@ static OTA_Err_t prvPAL_CheckFileSignature( OTA_FileContext_t * const C );
 
 /*-----------------------------------------------------------*/
 
+/* Size of the image in the receive file. It differs from the size of the file
+ * that is received when the file is compressed. */
+static inline uint32_t prvImageSize( const OTA_FileContext_t * C )
+{
+    return ( C->ulImageSize != 0U ) ? C->ulImageSize : C->ulFileSize;
+}
+
+/* Space for the image in the partition, the image descriptor is stored in its last bytes. */
+static inline uint32_t prvImageSpace( void )
+{
+    return ( xCurrentOTAContext.ulPartitionEnd - xCurrentOTAContext.ulPartitionBegin ) - sizeof( OTA_ImageDescriptor_t );
+}
+
 static inline BaseType_t prvContextValidate( OTA_FileContext_t * C )
 {
     return( ( C != NULL ) &&
@@ -133,7 +150,8 @@ OTA_Err_t prvPAL_CreateFileForRx( OTA_FileContext_t * const C )
         bk_logic_partition_t *pt = bk_flash_get_info(BK_PARTITION_OTA);
         if( pt != NULL )
         {
-            if (C->ulFileSize + sizeof(OTA_ImageDescriptor_t) <= pt->partition_length)
+            if( ( pt->partition_length >= sizeof(OTA_ImageDescriptor_t) ) &&
+                ( prvImageSize( C ) <= pt->partition_length - sizeof(OTA_ImageDescriptor_t) ) )
             {
                 bk_flash_enable_security(FLASH_PROTECT_HALF); // half or custom
 
@@ -172,6 +190,82 @@ OTA_Err_t prvPAL_CreateFileForRx( OTA_FileContext_t * const C )
 }
 
 
+/* Reopen the receive file of an interrupted transfer. Same as prvPAL_CreateFileForRx()
+ * but the partition is not erased so the blocks received before the reset are kept. */
+
+OTA_Err_t prvPAL_ResumeFileForRx( OTA_FileContext_t * const C )
+{
+    DEFINE_OTA_METHOD_NAME( "prvPAL_ResumeFileForRx" );
+
+    OTA_Err_t eResult = kOTA_Err_RxFileCreateFailed;
+    bk_logic_partition_t *pt = bk_flash_get_info(BK_PARTITION_OTA);
+
+    if( ( C != NULL ) && ( pt != NULL ) &&
+        ( pt->partition_length >= sizeof(OTA_ImageDescriptor_t) ) &&
+        ( prvImageSize( C ) <= pt->partition_length - sizeof(OTA_ImageDescriptor_t) ) &&
+        ( C->ulImageOffset <= prvImageSize( C ) ) )
+    {
+        bk_flash_enable_security(FLASH_PROTECT_HALF); // half or custom
+
+        xCurrentOTAContext.pxCurOTAFile = C;
+        xCurrentOTAContext.ulPartitionBegin = pt->partition_start_addr;
+        xCurrentOTAContext.ulPartitionEnd = pt->partition_start_addr + pt->partition_length;
+        /* The image always starts at offset 0 and the frontier bounds what was written so far. */
+        xCurrentOTAContext.ulLowImageOffset = 0;
+        xCurrentOTAContext.ulHighImageOffset = C->ulImageOffset;
+        C->pucFile = (uint8_t *)&xCurrentOTAContext;
+        eResult = kOTA_Err_None;
+        OTA_LOG_L1( "[%s] Receive file reopened at offset %u.\r\n", OTA_METHOD_NAME, C->ulImageOffset );
+    }
+    else
+    {
+        OTA_LOG_L1( "[%s] ERROR - Can't resume the receive file.\r\n", OTA_METHOD_NAME );
+    }
+
+    return eResult;
+}
+
+/* The transfer state is kept in the key-value store next to the PKCS#11 objects. */
+
+OTA_Err_t prvPAL_SaveTransferState( const uint8_t * pucState,
+                                    uint32_t ulStateSize )
+{
+    OTA_Err_t eResult = kOTA_Err_None;
+
+    if( aos_kv_set( AWS_OTA_RESUME_STATE_KEY, pucState, ( int ) ulStateSize, 1 ) != RES_OK )
+    {
+        eResult = kOTA_Err_RxFileCreateFailed;
+    }
+
+    return eResult;
+}
+
+OTA_Err_t prvPAL_LoadTransferState( uint8_t * pucState,
+                                    uint32_t * pulStateSize )
+{
+    OTA_Err_t eResult = kOTA_Err_None;
+    int length = ( int ) *pulStateSize;
+
+    if( aos_kv_get( AWS_OTA_RESUME_STATE_KEY, pucState, &length ) != RES_OK )
+    {
+        eResult = kOTA_Err_NoResumeState;
+    }
+    else
+    {
+        *pulStateSize = ( uint32_t ) length;
+    }
+
+    return eResult;
+}
+
+OTA_Err_t prvPAL_ClearTransferState( void )
+{
+    /* Deleting a state that doesn't exist is not an error. */
+    ( void ) aos_kv_del( AWS_OTA_RESUME_STATE_KEY );
+
+    return kOTA_Err_None;
+}
+
 /* Abort receiving the specified OTA update by closing the file. */
 
 OTA_Err_t prvPAL_Abort( OTA_FileContext_t * const C )
@@ -213,9 +307,10 @@ int16_t prvPAL_WriteBlock( OTA_FileContext_t * const C,
         OTA_LOG_L1( "[%s] ERROR - Invalid context.\r\n", OTA_METHOD_NAME );
         lResult = -1; /*TODO: Need a negative error code from the PAL here. */
     }
-    else if( ( ulOffset + ulBlockSize ) > xCurrentOTAContext.ulPartitionEnd )
+    else if( ( ulOffset > prvImageSpace() ) || ( ulBlockSize > ( prvImageSpace() - ulOffset ) ) )
     {
-        /* invalid address. */
+        /* invalid address. The offset is relative to the start of the partition and the
+         * block may neither leave the partition nor overwrite the image descriptor. */
         OTA_LOG_L1( "[%s] ERROR - Invalid ulOffset=%d ulBlockSize=%d.\r\n", OTA_METHOD_NAME, ulOffset, ulBlockSize );
         lResult = -1;
     }
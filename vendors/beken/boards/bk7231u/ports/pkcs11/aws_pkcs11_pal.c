@@ -102,6 +102,63 @@ struct dict_entry
 
 #define DICT_SIZE   ( sizeof( dict ) / sizeof ( struct dict_entry ) )
 
+/* Values of a file length that are not lengths. */
+#define pkcs11palLENGTH_UNKNOWN     0
+#define pkcs11palLENGTH_ABSENT      ( -1 )
+
+/*
+ * Stored length of each file, so that finding an object or sizing the
+ * buffer for its value does not read flash again. Labels sharing a file
+ * use the slot of the first one.
+ */
+static int lFileLength[ DICT_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+/* Returns the length slot of a file. */
+static int * prvFileLength( const char * pcFileName )
+{
+    int i;
+
+    for( i = 0; i < DICT_SIZE; i++ )
+    {
+        if( 0 == strcmp( dict[ i ].filename, pcFileName ) )
+        {
+            break;
+        }
+    }
+
+    return &lFileLength[ i ];
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the stored length of a file, reading it from flash the first time. */
+static int prvGetFileLength( const char * pcFileName )
+{
+    int *pLength = prvFileLength( pcFileName );
+    char buffer;
+    int length = sizeof(buffer);
+    int status;
+
+    if( pkcs11palLENGTH_UNKNOWN == *pLength )
+    {
+        /* Too small a buffer still reports the length of the value. */
+        status = aos_kv_get( pcFileName, &buffer, &length );
+
+        if( RES_ITEM_NOT_FOUND == status )
+        {
+            *pLength = pkcs11palLENGTH_ABSENT;
+        }
+        else if( ( RES_OK == status ) || ( RES_NO_SPACE == status ) )
+        {
+            *pLength = length;
+        }
+    }
+
+    return *pLength;
+}
+
 /*-----------------------------------------------------------*/
 
 /* Converts a label to its respective filename and handle. */
@@ -198,6 +255,11 @@ CK_OBJECT_HANDLE PKCS11_PAL_SaveObject( CK_ATTRIBUTE_PTR    pxLabel,
         if( aos_kv_set( pcFileName, pucData, ulDataSize, 1 ) != RES_OK )
         {
             xHandle = eInvalidHandle;
+            *prvFileLength( pcFileName ) = pkcs11palLENGTH_UNKNOWN;
+        }
+        else
+        {
+            *prvFileLength( pcFileName ) = ulDataSize;
         }
         //os_printf("pxLabel=%s ulDataSize=%d xHandle=%d\n", pxLabel->pValue, ulDataSize, xHandle);
     }
@@ -237,10 +299,7 @@ CK_OBJECT_HANDLE PKCS11_PAL_FindObject( uint8_t * pLabel,
     if( pcFileName != NULL )
     {
         /* Check if object exists/has been created before returning. */
-        char buffer;
-        int length = sizeof(buffer);
-
-        if( RES_ITEM_NOT_FOUND == aos_kv_get( pcFileName, &buffer, &length ) )
+        if( pkcs11palLENGTH_ABSENT == prvGetFileLength( pcFileName ) )
         {
             xHandle = eInvalidHandle;
         }
@@ -290,15 +349,17 @@ CK_RV PKCS11_PAL_GetObjectValue( CK_OBJECT_HANDLE xHandle,
     }
     else
     {
-        char buffer;
-        int length = sizeof(buffer);
+        int length = prvGetFileLength( pcFileName );
         int32_t    status;
 
-        status = aos_kv_get( pcFileName, &buffer, &length );
-        if( RES_ITEM_NOT_FOUND ==  status)
+        if( pkcs11palLENGTH_ABSENT == length )
         {
             ulReturn = CKR_KEY_HANDLE_INVALID;
         }
+        else if( pkcs11palLENGTH_UNKNOWN == length )
+        {
+            ulReturn = CKR_FUNCTION_FAILED;
+        }
         else
         {
             pucData = pvPortMalloc( length );
@@ -311,6 +372,8 @@ CK_RV PKCS11_PAL_GetObjectValue( CK_OBJECT_HANDLE xHandle,
                 status = aos_kv_get( pcFileName, pucData, &length );
                 if ( RES_OK !=  status)
                 {
+                    /* Read the length again next time. */
+                    *prvFileLength( pcFileName ) = pkcs11palLENGTH_UNKNOWN;
                     vPortFree( pucData );
                     ulReturn = CKR_FUNCTION_FAILED;
                 }
@@ -355,6 +418,40 @@ void PKCS11_PAL_GetObjectValueCleanup( uint8_t * pucData,
 
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Tells whether the file of an object also holds a private object.
+ *
+ * The public key of the device is read from the file of its private key, so
+ * the value of the public key object must not be kept in RAM.
+ *
+ * @param[in] xHandle       The handle of the object.
+ *
+ * @return CK_TRUE if another object, which is private, shares the file.
+ */
+CK_BBOOL PKCS11_PAL_SharesPrivateStorage( CK_OBJECT_HANDLE xHandle )
+{
+    CK_BBOOL    xShared     = CK_FALSE;
+    char        *pcFileName = NULL;
+    CK_BBOOL    isPrivate   = CK_FALSE;
+    int         i;
+
+    prvHandleToFilenamePrivate( xHandle, &pcFileName, &isPrivate );
+
+    for( i = 0; ( pcFileName != NULL ) && ( i < DICT_SIZE ); i++ )
+    {
+        if( ( dict[ i ].xHandle != xHandle ) &&
+            ( CK_TRUE == dict[ i ].isPrivate ) &&
+            ( 0 == strcmp( dict[ i ].filename, pcFileName ) ) )
+        {
+            xShared = CK_TRUE;
+        }
+    }
+
+    return xShared;
+}
+
+/*-----------------------------------------------------------*/
+
 static int os_get_random(unsigned char *buf, size_t len)
 {
     int i, j;
@@ -0,0 +1,185 @@
+/*
+ * Amazon FreeRTOS V201906.00 Major
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Test includes. */
+#include "aws_test_runner.h"
+#include "aws_test_runner_config.h"
+#include "unity.h"
+
+/* AWS library includes. */
+#include "aws_system_init.h"
+#include "aws_logging_task.h"
+
+/* Logging Task Defines. */
+#define mainLOGGING_MESSAGE_QUEUE_LENGTH    ( 32 )
+#define mainLOGGING_TASK_STACK_SIZE         ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Unit test defines. */
+#define mainTEST_RUNNER_TASK_STACK_SIZE     ( configMINIMAL_STACK_SIZE * 16 )
+
+/* How long the idle task sleeps on the host between ticks, in microseconds,
+ * rather than spin. */
+#define mainIDLE_SLEEP_US                   ( 1000 )
+
+/*-----------------------------------------------------------*/
+
+/* The exit code of the process, set once the tests have run. */
+static int iExitCode = EXIT_FAILURE;
+
+/* Seed of ulRand(). */
+static uint32_t ulNextRand;
+
+/* The task that runs the tests, see vAssertCalled(). */
+static TaskHandle_t xTestRunnerTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Initializes the libraries and starts the tests, once the scheduler
+ * runs.
+ */
+static void prvStartupTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ulNextRand = ( uint32_t ) time( NULL );
+
+    xLoggingTaskInitialize( mainLOGGING_TASK_STACK_SIZE,
+                            tskIDLE_PRIORITY + 5,
+                            mainLOGGING_MESSAGE_QUEUE_LENGTH );
+
+    xTaskCreate( prvStartupTask,
+                 "Startup",
+                 mainTEST_RUNNER_TASK_STACK_SIZE,
+                 NULL,
+                 tskIDLE_PRIORITY + 1,
+                 NULL );
+
+    /* Returns once the tests have finished, see vTestRunnerFinished(). */
+    vTaskStartScheduler();
+
+    return iExitCode;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartupTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    if( SYSTEM_Init() == pdPASS )
+    {
+        /* Create the task to run unit tests. */
+        xTaskCreate( TEST_RUNNER_RunTests_task,
+                     "RunTests_task",
+                     mainTEST_RUNNER_TASK_STACK_SIZE,
+                     NULL,
+                     tskIDLE_PRIORITY + 1,
+                     &xTestRunnerTask );
+    }
+    else
+    {
+        configPRINTF( ( "Failed to initialize the libraries.\r\n" ) );
+        vTaskEndScheduler();
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vTestRunnerFinished( unsigned int ulFailures )
+{
+    /* Give the logging task time to print the results. */
+    vTaskDelay( pdMS_TO_TICKS( 500 ) );
+
+    iExitCode = ( ulFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vHostPrintString( const char * pcString )
+{
+    /* A task switched out while it holds the lock of stdout would block every
+     * other task that prints. */
+    vTaskSuspendAll();
+    {
+        ( void ) fputs( pcString, stdout );
+        ( void ) fflush( stdout );
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulRand( void )
+{
+    const uint32_t ulMultiplier = 0x015a4e35UL, ulIncrement = 1UL;
+    uint32_t ulReturn;
+
+    taskENTER_CRITICAL();
+    {
+        ulNextRand = ( ulMultiplier * ulNextRand ) + ulIncrement;
+        ulReturn = ulNextRand;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    uint32_t ulLine )
+{
+    ( void ) fprintf( stderr, "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFile );
+
+    /* Tests check that invalid parameters assert, so an assert on the task
+     * that runs them returns to the TEST_PROTECT() of the current test.
+     * Anywhere else it ends the process. */
+    if( ( xTestRunnerTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTestRunnerTask ) )
+    {
+        TEST_ABORT();
+    }
+
+    taskDISABLE_INTERRUPTS();
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    /* The tick interrupts the sleep. */
+    ( void ) usleep( mainIDLE_SLEEP_US );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,143 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * http://www.freertos.org/a00110.html
+ *
+ * The host runs every task on a thread of its own, see the Posix port.  The
+ * stack sizes below only size the bookkeeping that FreeRTOS allocates for a
+ * task; the host thread gets a stack of at least portMIN_HOST_STACK_SIZE.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_IDLE_HOOK                        1
+#define configUSE_TICK_HOOK                        0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK         0
+#define configTICK_RATE_HZ                         ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 128 )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 8 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                    ( 16 )
+#define configUSE_TRACE_FACILITY                   1
+#define configUSE_16_BIT_TICKS                     0
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_MUTEXES                          1
+#define configCHECK_FOR_STACK_OVERFLOW             0 /* The host threads do not run on the FreeRTOS stacks. */
+#define configUSE_RECURSIVE_MUTEXES                1
+#define configQUEUE_REGISTRY_SIZE                  0
+#define configUSE_MALLOC_FAILED_HOOK               1
+#define configUSE_APPLICATION_TASK_TAG             0
+#define configUSE_COUNTING_SEMAPHORES              1
+#define configUSE_ALTERNATIVE_API                  0
+#define configUSE_QUEUE_SETS                       1
+#define configUSE_TASK_NOTIFICATIONS               1
+#define configSUPPORT_STATIC_ALLOCATION            1
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS    3
+#define configMAX_PRIORITIES                       ( 10 )
+#define configENABLE_BACKWARD_COMPATIBILITY        1
+#define configUSE_POSIX_ERRNO                      1
+
+/* Software timer related configuration options. */
+#define configUSE_TIMERS                           1
+#define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                   20
+#define configTIMER_TASK_STACK_DEPTH               ( configMINIMAL_STACK_SIZE * 2 )
+
+/* Event group related definitions. */
+#define configUSE_EVENT_GROUPS                     1
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                      0
+#define configMAX_CO_ROUTINE_PRIORITIES            ( 2 )
+
+/* Run time stats gathering definitions.  The port counts the CPU time of the
+ * process. */
+#define configGENERATE_RUN_TIME_STATS              0
+#define configUSE_STATS_FORMATTING_FUNCTIONS       1
+
+/* Set the following definitions to 1 to include the API function, or zero
+ * to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                   1
+#define INCLUDE_uxTaskPriorityGet                  1
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_vTaskCleanUpResources              0
+#define INCLUDE_vTaskSuspend                       1
+#define INCLUDE_vTaskDelayUntil                    1
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_uxTaskGetStackHighWaterMark        1
+#define INCLUDE_xTaskGetSchedulerState             1
+#define INCLUDE_xTimerGetTimerTaskHandle           0
+#define INCLUDE_xTaskGetIdleTaskHandle             0
+#define INCLUDE_xQueueGetMutexHolder               1
+#define INCLUDE_eTaskGetState                      1
+#define INCLUDE_xEventGroupSetBitsFromISR          1
+#define INCLUDE_xTimerPendFunctionCall             1
+#define INCLUDE_xTaskGetCurrentTaskHandle          1
+#define INCLUDE_xTaskAbortDelay                    1
+
+/* The signal mask of the port has no priority levels, but the kernel asserts
+ * on these being defined the same way for every port. */
+#define configKERNEL_INTERRUPT_PRIORITY            255
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY       191
+
+/* Assert call defined for debug builds.  On the host a failed assert ends the
+ * process, so that the test run reports it rather than hanging. */
+void vAssertCalled( const char * pcFile,
+                    uint32_t ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+/* Logging task definitions.  The string is written to standard output with the
+ * scheduler suspended, see main.c. */
+void vHostPrintString( const char * pcString );
+#define configPRINT_STRING( x )                     vHostPrintString( x )
+
+void vLoggingPrintf( const char * pcFormat,
+                     ... );
+void vLoggingPrint( const char * pcMessage );
+#define configPRINTF( X )                           vLoggingPrintf X
+
+#define configLOGGING_MAX_MESSAGE_LENGTH            ( 256 )
+#define configLOGGING_INCLUDE_TIME_AND_TASK_NAME    ( 0 )
+
+/* The platform FreeRTOS is running on. */
+#define configPLATFORM_NAME                         "Linux"
+
+/* Pseudo random number generator used by some demo tasks. */
+extern uint32_t ulRand( void );
+#define configRAND32()    ulRand()
+
+#endif /* FREERTOS_CONFIG_H */
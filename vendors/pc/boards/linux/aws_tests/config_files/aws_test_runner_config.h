@@ -0,0 +1,70 @@
+/*
+ * Amazon FreeRTOS V1.1.4
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+#ifndef AWS_TEST_RUNNER_CONFIG_H
+#define AWS_TEST_RUNNER_CONFIG_H
+
+#define testrunnerUNSUPPORTED                      0
+
+/* The host has no Wi-Fi, BLE or OTA image storage.  The tests that need AWS
+ * credentials are left to the boards.  The OTA HTTP tests download from a
+ * local range server. */
+#define testrunnerFULL_OTA_CBOR_ENABLED            testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_AGENT_ENABLED           testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_PAL_ENABLED             testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_DECOMPRESS_ENABLED      testrunnerUNSUPPORTED
+#define testrunnerFULL_OTA_SIM_ENABLED             testrunnerUNSUPPORTED
+#define testrunnerFULL_CBOR_ENABLED                testrunnerUNSUPPORTED
+#define testrunnerFULL_POSIX_ENABLED               testrunnerUNSUPPORTED
+#define testrunnerFULL_WIFI_ENABLED                testrunnerUNSUPPORTED
+#define testrunnerFULL_WIFI_PROVISIONING_ENABLED   testrunnerUNSUPPORTED
+#define testrunnerFULL_BLE_END_TO_END_TEST_ENABLED testrunnerUNSUPPORTED
+#define testrunnerFULL_BLE_ENABLED                 testrunnerUNSUPPORTED
+#define testrunnerFULL_MEMORYLEAK_ENABLED          testrunnerUNSUPPORTED
+
+/* Enable tests by setting defines to 1 */
+#define testrunnerFULL_MQTT_ALPN_ENABLED           0
+#define testrunnerFULL_PKCS11_ENABLED              0
+#define testrunnerFULL_CRYPTO_ENABLED              0
+#define testrunnerFULL_MQTT_STRESS_TEST_ENABLED    0
+#define testrunnerFULL_MQTT_AGENT_ENABLED          0
+#define testrunnerFULL_TCP_ENABLED                 1
+#define testrunnerFULL_OTA_HTTP_ENABLED            1
+#define testrunnerFULL_GGD_ENABLED                 0
+#define testrunnerFULL_GGD_HELPER_ENABLED          0
+#define testrunnerFULL_SHADOW_ENABLED              0
+#define testrunnerFULL_SHADOWv4_ENABLED            0
+#define testrunnerFULL_MQTT_ENABLED                0
+#define testrunnerFULL_TLS_ENABLED                 0
+#define testrunnerUTIL_PLATFORM_CLOCK_ENABLED      0
+#define testrunnerFULL_LINEAR_CONTAINERS_ENABLED   0
+#define testrunnerUTIL_PLATFORM_THREADS_ENABLED    0
+
+/* End the process with the number of failed tests once all tests ran, so
+ * that the test run can be scripted. */
+void vTestRunnerFinished( unsigned int ulFailures );
+#define testrunnerTESTS_COMPLETE_HOOK( ulFailures )    vTestRunnerFinished( ulFailures )
+
+#endif /* AWS_TEST_RUNNER_CONFIG_H */
@@ -0,0 +1,423 @@
+/*
+ * Amazon FreeRTOS PKCS #11 PAL V1.0.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_pkcs11_pal.c
+ * @brief Host helpers for the PKCS11 Interface.
+ *
+ * Objects are kept in files in the working directory of the process. The
+ * host C library is only entered with the scheduler suspended, as another
+ * task could otherwise find a host lock held by a task that was switched out.
+ */
+
+/*-----------------------------------------------------------*/
+
+/* Amazon FreeRTOS Includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "aws_pkcs11.h"
+#include "aws_pkcs11_config.h"
+
+/* C runtime includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Host includes. */
+#include <sys/random.h>
+
+/*-----------------------------------------------------------*/
+
+#define pkcs11palFILE_NAME_CLIENT_CERTIFICATE    "FreeRTOS_P11_Certificate.dat"
+#define pkcs11palFILE_NAME_KEY                   "FreeRTOS_P11_Key.dat"
+#define pkcs11palFILE_CODE_SIGN_PUBLIC_KEY       "FreeRTOS_P11_CodeSignKey.dat"
+
+/*-----------------------------------------------------------*/
+
+enum eObjectHandles
+{
+    eInvalidHandle = 0, /* According to PKCS #11 spec, 0 is never a valid object handle. */
+    eAwsDevicePrivateKey = 1,
+    eAwsDevicePublicKey,
+    eAwsDeviceCertificate,
+    eAwsCodeSigningKey
+};
+
+/*-----------------------------------------------------------*/
+
+/* The private and public keys of the device share a file, as the public key
+ * is derived from the private key. */
+static const struct
+{
+    const char * pcLabel;
+    const char * pcFileName;
+    CK_OBJECT_HANDLE xHandle;
+    CK_BBOOL xIsPrivate;
+} xObjects[] =
+{
+    {
+        pkcs11configLABEL_DEVICE_CERTIFICATE_FOR_TLS,
+        pkcs11palFILE_NAME_CLIENT_CERTIFICATE,
+        eAwsDeviceCertificate,
+        CK_FALSE
+    },
+    {
+        pkcs11configLABEL_DEVICE_PRIVATE_KEY_FOR_TLS,
+        pkcs11palFILE_NAME_KEY,
+        eAwsDevicePrivateKey,
+        CK_TRUE
+    },
+    {
+        pkcs11configLABEL_DEVICE_PUBLIC_KEY_FOR_TLS,
+        pkcs11palFILE_NAME_KEY,
+        eAwsDevicePublicKey,
+        CK_FALSE
+    },
+    {
+        pkcs11configLABEL_CODE_VERIFICATION_KEY,
+        pkcs11palFILE_CODE_SIGN_PUBLIC_KEY,
+        eAwsCodeSigningKey,
+        CK_FALSE
+    }
+};
+
+#define pkcs11palNUM_OBJECTS    ( sizeof( xObjects ) / sizeof( xObjects[ 0 ] ) )
+
+/*-----------------------------------------------------------*/
+
+/* Returns the index of the object with a label, or pkcs11palNUM_OBJECTS. */
+static size_t prvLabelToIndex( const uint8_t * pucLabel )
+{
+    size_t i;
+
+    for( i = 0; i < pkcs11palNUM_OBJECTS; i++ )
+    {
+        if( ( pucLabel != NULL ) &&
+            ( 0 == strcmp( xObjects[ i ].pcLabel, ( const char * ) pucLabel ) ) )
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the index of the object with a handle, or pkcs11palNUM_OBJECTS. */
+static size_t prvHandleToIndex( CK_OBJECT_HANDLE xHandle )
+{
+    size_t i;
+
+    for( i = 0; i < pkcs11palNUM_OBJECTS; i++ )
+    {
+        if( xObjects[ i ].xHandle == xHandle )
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the length of a file, or -1 if it cannot be read. */
+static long prvFileLength( const char * pcFileName )
+{
+    FILE * pxFile;
+    long lLength = -1;
+
+    vTaskSuspendAll();
+    {
+        pxFile = fopen( pcFileName, "rb" );
+
+        if( pxFile != NULL )
+        {
+            if( 0 == fseek( pxFile, 0, SEEK_END ) )
+            {
+                lLength = ftell( pxFile );
+            }
+
+            ( void ) fclose( pxFile );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    return lLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Saves an object in non-volatile storage.
+ *
+ * Port-specific file write for cryptographic information.
+ *
+ * @param[in] pxLabel       The label of the object to be stored.
+ * @param[in] pucData       The object data to be saved
+ * @param[in] pulDataSize   Size (in bytes) of object data.
+ *
+ * @return The object handle if successful.
+ * eInvalidHandle = 0 if unsuccessful.
+ */
+CK_OBJECT_HANDLE PKCS11_PAL_SaveObject( CK_ATTRIBUTE_PTR pxLabel,
+                                        uint8_t * pucData,
+                                        uint32_t ulDataSize )
+{
+    CK_OBJECT_HANDLE xHandle = eInvalidHandle;
+    size_t xIndex = prvLabelToIndex( pxLabel->pValue );
+    FILE * pxFile;
+    size_t xWritten = 0;
+
+    if( xIndex < pkcs11palNUM_OBJECTS )
+    {
+        vTaskSuspendAll();
+        {
+            pxFile = fopen( xObjects[ xIndex ].pcFileName, "wb" );
+
+            if( pxFile != NULL )
+            {
+                xWritten = fwrite( pucData, 1, ulDataSize, pxFile );
+
+                if( 0 != fclose( pxFile ) )
+                {
+                    xWritten = 0;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xWritten == ulDataSize )
+        {
+            xHandle = xObjects[ xIndex ].xHandle;
+        }
+    }
+
+    return xHandle;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Translates a PKCS #11 label into an object handle.
+ *
+ * Port-specific object handle retrieval.
+ *
+ *
+ * @param[in] pLabel         Pointer to the label of the object
+ *                           who's handle should be found.
+ * @param[in] usLength       The length of the label, in bytes.
+ *
+ * @return The object handle if operation was successful.
+ * Returns eInvalidHandle if unsuccessful.
+ */
+CK_OBJECT_HANDLE PKCS11_PAL_FindObject( uint8_t * pLabel,
+                                        uint8_t usLength )
+{
+    CK_OBJECT_HANDLE xHandle = eInvalidHandle;
+    size_t xIndex = prvLabelToIndex( pLabel );
+
+    /* Avoid compiler warnings about unused variables. */
+    ( void ) usLength;
+
+    /* Check if object exists/has been created before returning. */
+    if( ( xIndex < pkcs11palNUM_OBJECTS ) &&
+        ( prvFileLength( xObjects[ xIndex ].pcFileName ) >= 0 ) )
+    {
+        xHandle = xObjects[ xIndex ].xHandle;
+    }
+
+    return xHandle;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Gets the value of an object in storage, by handle.
+ *
+ * Port-specific file access for cryptographic information.
+ *
+ * This call dynamically allocates the buffer which object value
+ * data is copied into.  PKCS11_PAL_GetObjectValueCleanup()
+ * should be called after each use to free the dynamically allocated
+ * buffer.
+ *
+ * @sa PKCS11_PAL_GetObjectValueCleanup
+ *
+ * @param[in] xHandle       The handle of the object.
+ * @param[out] ppucData     Pointer to buffer for file data.
+ * @param[out] pulDataSize  Size (in bytes) of data located in file.
+ * @param[out] pIsPrivate   Boolean indicating if value is private (CK_TRUE)
+ *                          or exportable (CK_FALSE)
+ *
+ * @return CKR_OK if operation was successful.  CKR_KEY_HANDLE_INVALID if
+ * no such object handle was found, CKR_DEVICE_MEMORY if memory for
+ * buffer could not be allocated, CKR_FUNCTION_FAILED for device driver
+ * error.
+ */
+CK_RV PKCS11_PAL_GetObjectValue( CK_OBJECT_HANDLE xHandle,
+                                 uint8_t ** ppucData,
+                                 uint32_t * pulDataSize,
+                                 CK_BBOOL * pIsPrivate )
+{
+    CK_RV ulReturn = CKR_OK;
+    size_t xIndex = prvHandleToIndex( xHandle );
+    long lLength = -1;
+    uint8_t * pucData = NULL;
+    FILE * pxFile;
+    size_t xRead = 0;
+
+    if( xIndex < pkcs11palNUM_OBJECTS )
+    {
+        lLength = prvFileLength( xObjects[ xIndex ].pcFileName );
+    }
+
+    if( lLength < 0 )
+    {
+        ulReturn = CKR_KEY_HANDLE_INVALID;
+    }
+    else
+    {
+        /* An empty object still gets a buffer, so that the caller can free it. */
+        pucData = pvPortMalloc( ( size_t ) lLength + 1 );
+
+        if( NULL == pucData )
+        {
+            ulReturn = CKR_DEVICE_MEMORY;
+        }
+    }
+
+    if( CKR_OK == ulReturn )
+    {
+        vTaskSuspendAll();
+        {
+            pxFile = fopen( xObjects[ xIndex ].pcFileName, "rb" );
+
+            if( pxFile != NULL )
+            {
+                xRead = fread( pucData, 1, ( size_t ) lLength, pxFile );
+                ( void ) fclose( pxFile );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( ( pxFile == NULL ) || ( xRead != ( size_t ) lLength ) )
+        {
+            vPortFree( pucData );
+            ulReturn = CKR_FUNCTION_FAILED;
+        }
+        else
+        {
+            *ppucData = pucData;
+            *pulDataSize = ( uint32_t ) lLength;
+            *pIsPrivate = xObjects[ xIndex ].xIsPrivate;
+        }
+    }
+
+    return ulReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Cleanup after PKCS11_GetObjectValue().
+ *
+ * @param[in] pucData       The buffer to free.
+ *                          (*ppucData from PKCS11_PAL_GetObjectValue())
+ * @param[in] ulDataSize    The length of the buffer to free.
+ *                          (*pulDataSize from PKCS11_PAL_GetObjectValue())
+ */
+void PKCS11_PAL_GetObjectValueCleanup( uint8_t * pucData,
+                                       uint32_t ulDataSize )
+{
+    /* Unused parameters. */
+    ( void ) ulDataSize;
+
+    if( NULL != pucData )
+    {
+        vPortFree( pucData );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tells whether the file of an object also holds a private object.
+ *
+ * The public key of the device is read from the file of its private key, so
+ * the value of the public key object must not be kept in RAM.
+ *
+ * @param[in] xHandle       The handle of the object.
+ *
+ * @return CK_TRUE if another object, which is private, shares the file.
+ */
+CK_BBOOL PKCS11_PAL_SharesPrivateStorage( CK_OBJECT_HANDLE xHandle )
+{
+    CK_BBOOL xShared = CK_FALSE;
+    size_t xIndex = prvHandleToIndex( xHandle );
+    size_t i;
+
+    for( i = 0; ( xIndex < pkcs11palNUM_OBJECTS ) && ( i < pkcs11palNUM_OBJECTS ); i++ )
+    {
+        if( ( i != xIndex ) &&
+            ( CK_TRUE == xObjects[ i ].xIsPrivate ) &&
+            ( 0 == strcmp( xObjects[ i ].pcFileName, xObjects[ xIndex ].pcFileName ) ) )
+        {
+            xShared = CK_TRUE;
+        }
+    }
+
+    return xShared;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Entropy for mbedTLS, from the host. */
+int mbedtls_hardware_poll( void * data,
+                           unsigned char * output,
+                           size_t len,
+                           size_t * olen )
+{
+    ssize_t xRead;
+    size_t xTotal = 0;
+
+    ( void ) data;
+
+    while( xTotal < len )
+    {
+        xRead = getrandom( output + xTotal, len - xTotal, 0 );
+
+        if( xRead <= 0 )
+        {
+            break;
+        }
+
+        xTotal += ( size_t ) xRead;
+    }
+
+    *olen = xTotal;
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Amazon FreeRTOS V201906.00 Major
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * Runs the tests of FreeRTOS+TCP.
+ *
+ * The stack runs on the LinuxWire network interface with both ends of the
+ * wire on the same socket, so every frame the stack sends comes back to it.
+ * A test can connect to the address of the stack itself and have real
+ * segments go through the IP-task, most tests call the functions of the
+ * stack directly.
+ *
+ * The exit code is non-zero if a test failed.
+ */
+
+/* Standard includes. */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+
+/* Test includes. */
+#include "aws_test_runner.h"
+#include "aws_test_runner_config.h"
+#include "unity.h"
+
+/* Unit test defines. */
+#define mainTEST_RUNNER_TASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 16 )
+
+/* How long the idle task sleeps on the host between ticks, in microseconds,
+ * rather than spin. */
+#define mainIDLE_SLEEP_US                  ( 1000 )
+
+/*-----------------------------------------------------------*/
+
+/* The address of the stack, on a network of its own. */
+static const uint8_t ucIPAddress[ 4 ] = { 10, 0, 0, 1 };
+static const uint8_t ucMACAddress[ 6 ] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t ucNetMask[ 4 ] = { 255, 255, 255, 0 };
+static const uint8_t ucGatewayAddress[ 4 ] = { 10, 0, 0, 254 };
+static const uint8_t ucDNSServerAddress[ 4 ] = { 10, 0, 0, 254 };
+
+/* The exit code of the process, set once the tests have run. */
+static int iExitCode = EXIT_FAILURE;
+
+/* Seed of ulRand(). */
+static uint32_t ulNextRand;
+
+/* The task that runs the tests, see vAssertCalled(). */
+static TaskHandle_t xTestRunnerTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    char cWirePath[ 64 ];
+
+    /* Both ends of the wire are the same socket, unique to this run. */
+    ( void ) snprintf( cWirePath, sizeof( cWirePath ), "/tmp/freertos_tcp_tests_%d", ( int ) getpid() );
+    ( void ) setenv( "FREERTOS_WIRE_LOCAL", cWirePath, 1 );
+    ( void ) setenv( "FREERTOS_WIRE_PEER", cWirePath, 1 );
+
+    ulNextRand = ( uint32_t ) time( NULL );
+
+    ( void ) FreeRTOS_IPInit( ucIPAddress,
+                              ucNetMask,
+                              ucGatewayAddress,
+                              ucDNSServerAddress,
+                              ucMACAddress );
+
+    /* Returns once the tests have finished, see vTestRunnerFinished(). */
+    vTaskStartScheduler();
+
+    ( void ) unlink( cWirePath );
+
+    return iExitCode;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent )
+{
+    if( ( eNetworkEvent == eNetworkUp ) && ( xTestRunnerTask == NULL ) )
+    {
+        xTaskCreate( TEST_RUNNER_RunTests_task,
+                     "RunTests_task",
+                     mainTEST_RUNNER_TASK_STACK_SIZE,
+                     NULL,
+                     tskIDLE_PRIORITY + 1,
+                     &xTestRunnerTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTestRunnerFinished( unsigned int ulFailures )
+{
+    /* Give the output time to leave. */
+    vTaskDelay( pdMS_TO_TICKS( 100 ) );
+
+    iExitCode = ( ulFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
+                                             uint16_t usSourcePort,
+                                             uint32_t ulDestinationAddress,
+                                             uint16_t usDestinationPort )
+{
+    ( void ) ulSourceAddress;
+    ( void ) usSourcePort;
+    ( void ) ulDestinationAddress;
+    ( void ) usDestinationPort;
+
+    return ulRand();
+}
+/*-----------------------------------------------------------*/
+
+void vHostPrintString( const char * pcString )
+{
+    /* A task switched out while it holds the lock of stdout would block every
+     * other task that prints. */
+    vTaskSuspendAll();
+    {
+        ( void ) fputs( pcString, stdout );
+        ( void ) fflush( stdout );
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vLoggingPrintf( const char * pcFormat,
+                     ... )
+{
+    char cMessage[ configLOGGING_MAX_MESSAGE_LENGTH ];
+    va_list xArgs;
+
+    va_start( xArgs, pcFormat );
+    vTaskSuspendAll();
+    {
+        ( void ) vsnprintf( cMessage, sizeof( cMessage ), pcFormat, xArgs );
+    }
+    ( void ) xTaskResumeAll();
+    va_end( xArgs );
+
+    vHostPrintString( cMessage );
+}
+/*-----------------------------------------------------------*/
+
+void vLoggingPrint( const char * pcMessage )
+{
+    vHostPrintString( pcMessage );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulRand( void )
+{
+    const uint32_t ulMultiplier = 0x015a4e35UL, ulIncrement = 1UL;
+    uint32_t ulReturn;
+
+    taskENTER_CRITICAL();
+    {
+        ulNextRand = ( ulMultiplier * ulNextRand ) + ulIncrement;
+        ulReturn = ulNextRand;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    uint32_t ulLine )
+{
+    ( void ) fprintf( stderr, "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFile );
+
+    /* An assert on the task that runs the tests fails the current test.
+     * Anywhere else it ends the process. */
+    if( ( xTestRunnerTask != NULL ) && ( xTaskGetCurrentTaskHandle() == xTestRunnerTask ) )
+    {
+        TEST_ABORT();
+    }
+
+    taskDISABLE_INTERRUPTS();
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    /* The tick interrupts the sleep. */
+    ( void ) usleep( mainIDLE_SLEEP_US );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    configPRINTF( ( "ERROR: Malloc failed.\n" ) );
+    configASSERT( 0 );
+}
+/*-----------------------------------------------------------*/
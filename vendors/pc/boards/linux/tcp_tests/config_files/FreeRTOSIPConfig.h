@@ -0,0 +1,135 @@
+/*
+ * Amazon FreeRTOS V201906.00 Major
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*****************************************************************************
+*
+* See the following URL for configuration information.
+* http://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html
+*
+* The FreeRTOS+TCP tests run one instance of the stack on the LinuxWire network
+* interface, looped back to itself, so that connections to its own address
+* carry real segments.  The features under test are all enabled.
+*
+*****************************************************************************/
+
+#ifndef FREERTOS_IP_CONFIG_H
+#define FREERTOS_IP_CONFIG_H
+
+/* Prototype for the function used to print out, see main.c. */
+extern void vLoggingPrintf( const char * pcFormatString,
+                            ... );
+
+/* Set to 1 to print out debug messages.  If ipconfigHAS_DEBUG_PRINTF is set to
+ * 1 then FreeRTOS_debug_printf should be defined to the function used to print
+ * out the debugging messages. */
+#define ipconfigHAS_DEBUG_PRINTF    0
+#if ( ipconfigHAS_DEBUG_PRINTF == 1 )
+    #define FreeRTOS_debug_printf( X )    configPRINTF( X )
+#endif
+
+/* Set to 1 to print out non debugging messages, for example the output of the
+ * FreeRTOS_netstat() command, and ping replies. */
+#define ipconfigHAS_PRINTF    1
+#if ( ipconfigHAS_PRINTF == 1 )
+    #define FreeRTOS_printf( X )    configPRINTF( X )
+#endif
+
+#define ipconfigBYTE_ORDER                         pdFREERTOS_LITTLE_ENDIAN
+
+/* The wire does not check anything, the stack checks the checksums it
+ * receives. */
+#define ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM     0
+#define ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM     0
+
+/* The checksum tests compare the optimised checksum with a reference. */
+#define ipconfigUSE_FAST_CHECKSUM                  1
+
+#define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    ( pdMS_TO_TICKS( 5000 ) )
+#define ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME       ( pdMS_TO_TICKS( 5000 ) )
+
+/* The address is fixed.  The DNS tests feed replies to the parser and to the
+ * cache directly, no server is asked. */
+#define ipconfigUSE_DHCP                           0
+#define ipconfigUSE_DNS                            1
+#define ipconfigUSE_DNS_CACHE                      ( 1 )
+#define ipconfigDNS_CACHE_NAME_LENGTH              ( 64 )
+#define ipconfigDNS_CACHE_ENTRIES                  ( 4 )
+#define ipconfigDNS_REQUEST_ATTEMPTS               ( 1 )
+#define ipconfigUSE_LLMNR                          0
+#define ipconfigUSE_NBNS                           0
+
+#define ipconfigIP_TASK_PRIORITY                   ( configMAX_PRIORITIES - 2 )
+#define ipconfigIP_TASK_STACK_SIZE_WORDS           ( configMINIMAL_STACK_SIZE * 5 )
+
+#define ipconfigRAND32()    ulRand()
+
+#define ipconfigUSE_NETWORK_EVENT_HOOK             1
+
+#define ipconfigARP_CACHE_ENTRIES                  6
+#define ipconfigMAX_ARP_RETRANSMISSIONS            ( 5 )
+#define ipconfigMAX_ARP_AGE                        150
+#define ipconfigINCLUDE_FULL_INET_ADDR             1
+
+#define ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS     120
+#define ipconfigEVENT_QUEUE_LENGTH                 ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
+
+#define ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND     1
+#define ipconfigUDP_TIME_TO_LIVE                   128
+#define ipconfigTCP_TIME_TO_LIVE                   128
+
+#define ipconfigUSE_TCP                            ( 1 )
+#define ipconfigUSE_TCP_WIN                        ( 1 )
+
+/* The congestion control simulation runs both algorithms, and the selective
+ * acknowledgement test needs more than one SACK block. */
+#define ipconfigUSE_TCP_CONGESTION_CONTROL         ( 1 )
+#define ipconfigUSE_TCP_CUBIC                      ( 1 )
+#define ipconfigTCP_SACK_BLOCKS                    ( 4 )
+
+#define ipconfigNETWORK_MTU                        1500
+#define ipconfigREPLY_TO_INCOMING_PINGS            1
+#define ipconfigSUPPORT_OUTGOING_PINGS             0
+#define ipconfigSUPPORT_SELECT_FUNCTION            0
+#define ipconfigFILTER_OUT_NON_ETHERNET_II_FRAMES  1
+#define ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES    1
+#define ipconfigPACKET_FILLER_SIZE                 2
+
+#define ipconfigTCP_WIN_SEG_COUNT                  64
+#define ipconfigTCP_RX_BUFFER_LENGTH               ( 8 * 1460 )
+#define ipconfigTCP_TX_BUFFER_LENGTH               ( 8 * 1460 )
+
+#define ipconfigIS_VALID_PROG_ADDRESS( x )    ( ( x ) != NULL )
+
+#define ipconfigTCP_HANG_PROTECTION                ( 1 )
+#define ipconfigTCP_HANG_PROTECTION_TIME           ( 30 )
+#define ipconfigTCP_KEEP_ALIVE                     ( 0 )
+
+#define ipconfigSOCKET_HAS_USER_SEMAPHORE          ( 0 )
+#define ipconfigSOCKET_HAS_USER_WAKE_CALLBACK      ( 0 )
+#define ipconfigUSE_CALLBACKS                      ( 0 )
+
+#define portINLINE                                 __inline
+
+#endif /* FREERTOS_IP_CONFIG_H */
@@ -0,0 +1,709 @@
+/*
+ * Amazon FreeRTOS V201906.00 Major
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * Measures FreeRTOS+TCP over the LinuxWire network interface.
+ *
+ * The stack keeps its state in globals, so the program forks into two
+ * processes before the scheduler starts, each with its own stack at the end
+ * of the wire.  The child is the server: it takes every connection, checks
+ * the bytes it receives and reports how many were right.  The parent is the
+ * client: for each scenario it impairs the wire, sends a transfer, and prints
+ * the throughput and the counters of vWireGetStats().  Only the direction of
+ * the data is impaired, the acknowledgements come back unimpaired.
+ *
+ * The exit code is non-zero if a transfer failed or arrived corrupted, so the
+ * benchmark also checks that the stack delivers intact data under loss and
+ * congestion.
+ *
+ *     wire_bench [kilobytes per transfer]
+ */
+
+/* Standard includes. */
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "NetworkInterfaceWire.h"
+
+/* The size of a transfer, unless given on the command line. */
+#define benchDEFAULT_TRANSFER_KB      ( 1024 )
+
+/* The port the server listens on. */
+#define benchPORT                     ( 5001 )
+
+/* How long a transfer may take before it counts as failed. */
+#define benchTRANSFER_TIMEOUT_MS      ( 60000 )
+
+/* The connections the server holds, those that are closing included. */
+#define benchLISTEN_BACKLOG           ( 4 )
+
+/* How long a connection attempt may take. */
+#define benchCONNECT_TIMEOUT_MS       ( 5000 )
+
+/* The number of times the client tries to connect, while the server may
+ * still be starting. */
+#define benchCONNECT_ATTEMPTS         ( 10 )
+
+/* The size of the blocks the client sends and the server receives. */
+#define benchBLOCK_SIZE               ( 4 * 1460 )
+
+#define benchTASK_STACK_SIZE          ( configMINIMAL_STACK_SIZE * 8 )
+#define benchTASK_PRIORITY            ( tskIDLE_PRIORITY + 2 )
+
+/* How long the idle task sleeps on the host between ticks, in microseconds,
+ * rather than spin. */
+#define benchIDLE_SLEEP_US            ( 1000 )
+
+/* What the server replies when the data was corrupted. */
+#define benchCORRUPTED                ( 0xFFFFFFFFUL )
+
+/*-----------------------------------------------------------*/
+
+/* An impairment of the wire, and the congestion control that faces it. */
+typedef struct BenchScenario
+{
+    const char * pcName;
+    uint32_t ulDelayUs;
+    uint32_t ulLossPPM;
+    uint64_t ullBitsPerSecond;
+    BaseType_t xCongestion;
+} BenchScenario_t;
+
+static const BenchScenario_t xScenarios[] =
+{
+    { "unimpaired",                   0,     0,     0,        FREERTOS_TCP_CC_NEWRENO },
+    { "10 Mbit/s",                    0,     0,     10000000, FREERTOS_TCP_CC_NEWRENO },
+    { "10 Mbit/s, 20 ms",             20000, 0,     10000000, FREERTOS_TCP_CC_NEWRENO },
+    { "10 Mbit/s, 20 ms",             20000, 0,     10000000, FREERTOS_TCP_CC_CUBIC   },
+    { "10 Mbit/s, 20 ms, 1% loss",    20000, 10000, 10000000, FREERTOS_TCP_CC_NEWRENO },
+    { "10 Mbit/s, 20 ms, 1% loss",    20000, 10000, 10000000, FREERTOS_TCP_CC_CUBIC   },
+};
+
+/*-----------------------------------------------------------*/
+
+/* Addresses of the two ends of the wire; the client is end 0. */
+static const uint8_t ucIPAddresses[ 2 ][ 4 ] = { { 10, 0, 0, 1 }, { 10, 0, 0, 2 } };
+static const uint8_t ucMACAddresses[ 2 ][ 6 ] =
+{
+    { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 },
+    { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 }
+};
+static const uint8_t ucNetMask[ 4 ] = { 255, 255, 255, 0 };
+static const uint8_t ucGatewayAddress[ 4 ] = { 10, 0, 0, 254 };
+static const uint8_t ucDNSServerAddress[ 4 ] = { 0, 0, 0, 0 };
+
+/* Which end of the wire this process is, 0 for the client. */
+static BaseType_t xEnd = 0;
+
+/* The size of a transfer. */
+static uint32_t ulTransferBytes = benchDEFAULT_TRANSFER_KB * 1024UL;
+
+/* The exit code of the client, set once the scenarios have run. */
+static int iExitCode = EXIT_FAILURE;
+
+/* Seed of ulRand(). */
+static uint32_t ulNextRand;
+
+/* The blocks the client sends and the server receives. */
+static uint8_t ucBlock[ benchBLOCK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Runs the scenarios, on the client.
+ */
+static void prvClientTask( void * pvParameters );
+
+/**
+ * @brief Takes the transfers, on the server.
+ */
+static void prvServerTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The byte at an offset of a transfer, which differs between blocks and
+ * segments so that data delivered at the wrong offset is noticed. */
+static uint8_t prvPatternByte( uint32_t ulOffset )
+{
+    return ( uint8_t ) ( ulOffset ^ ( ulOffset >> 8 ) ^ ( ulOffset >> 16 ) );
+}
+/*-----------------------------------------------------------*/
+
+/* Receives exactly xLength bytes, or fails. */
+static BaseType_t prvRecvAll( Socket_t xSocket,
+                              uint8_t * pucBuffer,
+                              size_t xLength )
+{
+    BaseType_t xReceived;
+    size_t xDone = 0;
+
+    while( xDone < xLength )
+    {
+        xReceived = FreeRTOS_recv( xSocket, &pucBuffer[ xDone ], xLength - xDone, 0 );
+
+        if( xReceived <= 0 )
+        {
+            return pdFAIL;
+        }
+
+        xDone += ( size_t ) xReceived;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+/* Sends exactly xLength bytes, or fails. */
+static BaseType_t prvSendAll( Socket_t xSocket,
+                              const uint8_t * pucBuffer,
+                              size_t xLength )
+{
+    BaseType_t xSent;
+    size_t xDone = 0;
+
+    while( xDone < xLength )
+    {
+        xSent = FreeRTOS_send( xSocket, &pucBuffer[ xDone ], xLength - xDone, 0 );
+
+        if( xSent <= 0 )
+        {
+            return pdFAIL;
+        }
+
+        xDone += ( size_t ) xSent;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+/* Shuts a connection down gracefully, then closes the socket. */
+static void prvClose( Socket_t xSocket )
+{
+    uint8_t ucDrain[ 16 ];
+
+    ( void ) FreeRTOS_shutdown( xSocket, FREERTOS_SHUT_RDWR );
+
+    /* Receive fails once the peer has closed its side too, and returns zero
+     * when it times out. */
+    while( FreeRTOS_recv( xSocket, ucDrain, sizeof( ucDrain ), 0 ) > 0 )
+    {
+    }
+
+    ( void ) FreeRTOS_closesocket( xSocket );
+}
+/*-----------------------------------------------------------*/
+
+static Socket_t prvSocket( void )
+{
+    Socket_t xSocket;
+
+    xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    configASSERT( xSocket != FREERTOS_INVALID_SOCKET );
+
+    return xSocket;
+}
+/*-----------------------------------------------------------*/
+
+/* Bounds how long a socket blocks, connecting included. */
+static void prvSetTimeout( Socket_t xSocket,
+                           TickType_t xTimeout )
+{
+    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+}
+/*-----------------------------------------------------------*/
+
+/* Connects to the server, retrying while it is not listening yet. */
+static Socket_t prvConnect( BaseType_t xCongestion )
+{
+    struct freertos_sockaddr xServer;
+    Socket_t xSocket;
+    BaseType_t xAttempt;
+    BaseType_t xResult;
+
+    xServer.sin_addr = FreeRTOS_inet_addr_quick( ucIPAddresses[ 1 ][ 0 ],
+                                                 ucIPAddresses[ 1 ][ 1 ],
+                                                 ucIPAddresses[ 1 ][ 2 ],
+                                                 ucIPAddresses[ 1 ][ 3 ] );
+    xServer.sin_port = FreeRTOS_htons( benchPORT );
+
+    for( xAttempt = 0; xAttempt < benchCONNECT_ATTEMPTS; xAttempt++ )
+    {
+        xSocket = prvSocket();
+        prvSetTimeout( xSocket, pdMS_TO_TICKS( benchCONNECT_TIMEOUT_MS ) );
+
+        if( FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_TCP_CONGESTION, &xCongestion, sizeof( xCongestion ) ) != 0 )
+        {
+            configPRINTF( ( "Congestion control %d is not available.\n", ( int ) xCongestion ) );
+            ( void ) FreeRTOS_closesocket( xSocket );
+            break;
+        }
+
+        xResult = FreeRTOS_connect( xSocket, &xServer, sizeof( xServer ) );
+
+        if( xResult == 0 )
+        {
+            prvSetTimeout( xSocket, pdMS_TO_TICKS( benchTRANSFER_TIMEOUT_MS ) );
+
+            return xSocket;
+        }
+
+        configPRINTF( ( "Connect failed: %d.\n", ( int ) xResult ) );
+        ( void ) FreeRTOS_closesocket( xSocket );
+        vTaskDelay( pdMS_TO_TICKS( 500 ) );
+    }
+
+    return FREERTOS_INVALID_SOCKET;
+}
+/*-----------------------------------------------------------*/
+
+/* Sends one transfer, and returns pdPASS if the server received all of it
+ * intact. */
+static BaseType_t prvTransfer( Socket_t xSocket )
+{
+    uint32_t ulLength = FreeRTOS_htonl( ulTransferBytes );
+    uint32_t ulReply;
+    uint32_t ulOffset;
+    uint32_t ulSize;
+    uint32_t ulIndex;
+
+    if( prvSendAll( xSocket, ( const uint8_t * ) &ulLength, sizeof( ulLength ) ) != pdPASS )
+    {
+        return pdFAIL;
+    }
+
+    for( ulOffset = 0; ulOffset < ulTransferBytes; ulOffset += ulSize )
+    {
+        ulSize = ulTransferBytes - ulOffset;
+
+        if( ulSize > sizeof( ucBlock ) )
+        {
+            ulSize = sizeof( ucBlock );
+        }
+
+        for( ulIndex = 0; ulIndex < ulSize; ulIndex++ )
+        {
+            ucBlock[ ulIndex ] = prvPatternByte( ulOffset + ulIndex );
+        }
+
+        if( prvSendAll( xSocket, ucBlock, ulSize ) != pdPASS )
+        {
+            return pdFAIL;
+        }
+    }
+
+    if( prvRecvAll( xSocket, ( uint8_t * ) &ulReply, sizeof( ulReply ) ) != pdPASS )
+    {
+        configPRINTF( ( "No reply from the server.\n" ) );
+        return pdFAIL;
+    }
+
+    if( FreeRTOS_ntohl( ulReply ) != ulTransferBytes )
+    {
+        configPRINTF( ( "The server received %u good bytes of %u.\n",
+                        ( unsigned ) FreeRTOS_ntohl( ulReply ),
+                        ( unsigned ) ulTransferBytes ) );
+        return pdFAIL;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvClientTask( void * pvParameters )
+{
+    const BenchScenario_t * pxScenario;
+    Socket_t xSocket;
+    WireStats_t xStats;
+    TickType_t xStart;
+    TickType_t xTicks = 0;
+    BaseType_t xResult;
+    size_t xIndex;
+    uint32_t ulFailures = 0;
+
+    ( void ) pvParameters;
+
+    configPRINTF( ( "%u KB per transfer, client to server.\n", ( unsigned ) ( ulTransferBytes / 1024UL ) ) );
+    configPRINTF( ( "%-26s %-7s %9s %8s %10s %9s %6s %6s\n",
+                    "Wire", "CC", "KB/s", "Frames", "Bytes", "Overhead", "Lost", "Drops" ) );
+
+    for( xIndex = 0; xIndex < sizeof( xScenarios ) / sizeof( xScenarios[ 0 ] ); xIndex++ )
+    {
+        pxScenario = &xScenarios[ xIndex ];
+
+        vWireSetImpairment( pxScenario->ulDelayUs, pxScenario->ulLossPPM, pxScenario->ullBitsPerSecond );
+        vWireGetStats( &xStats, pdTRUE );
+
+        xSocket = prvConnect( pxScenario->xCongestion );
+        xResult = pdFAIL;
+
+        if( xSocket != FREERTOS_INVALID_SOCKET )
+        {
+            /* The handshake is not part of the transfer. */
+            xStart = xTaskGetTickCount();
+            xResult = prvTransfer( xSocket );
+            xTicks = xTaskGetTickCount() - xStart;
+            prvClose( xSocket );
+        }
+
+        vWireGetStats( &xStats, pdFALSE );
+
+        if( xResult != pdPASS )
+        {
+            configPRINTF( ( "%-26s %-7s FAILED: frames %u, lost %u, drops %u, send errors %u, received %u, receive drops %u\n",
+                            pxScenario->pcName,
+                            ( pxScenario->xCongestion == FREERTOS_TCP_CC_CUBIC ) ? "CUBIC" : "NewReno",
+                            ( unsigned ) xStats.ullTxFrames,
+                            ( unsigned ) xStats.ullTxLost,
+                            ( unsigned ) xStats.ullTxQueueDrops,
+                            ( unsigned ) xStats.ullTxErrors,
+                            ( unsigned ) xStats.ullRxFrames,
+                            ( unsigned ) xStats.ullRxDrops ) );
+            ulFailures++;
+            continue;
+        }
+
+        if( xTicks == 0 )
+        {
+            xTicks = 1;
+        }
+
+        /* The overhead is what the wire carried beyond the payload: headers,
+         * acknowledgements of the handshake and retransmissions. */
+        configPRINTF( ( "%-26s %-7s %9u %8u %10u %8u%% %6u %6u\n",
+                        pxScenario->pcName,
+                        ( pxScenario->xCongestion == FREERTOS_TCP_CC_CUBIC ) ? "CUBIC" : "NewReno",
+                        ( unsigned ) ( ( ( uint64_t ) ulTransferBytes * configTICK_RATE_HZ ) / ( 1024U * xTicks ) ),
+                        ( unsigned ) xStats.ullTxFrames,
+                        ( unsigned ) xStats.ullTxBytes,
+                        ( unsigned ) ( ( ( xStats.ullTxBytes - ulTransferBytes ) * 100U ) / ulTransferBytes ),
+                        ( unsigned ) xStats.ullTxLost,
+                        ( unsigned ) xStats.ullTxQueueDrops ) );
+    }
+
+    configPRINTF( ( "%u of %u transfers failed.\n",
+                    ( unsigned ) ulFailures,
+                    ( unsigned ) ( sizeof( xScenarios ) / sizeof( xScenarios[ 0 ] ) ) ) );
+
+    /* Give the output time to leave. */
+    vTaskDelay( pdMS_TO_TICKS( 100 ) );
+
+    iExitCode = ( ulFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+/* Receives one transfer, and replies with the number of bytes received, or
+ * benchCORRUPTED. */
+static void prvServeTransfer( Socket_t xSocket )
+{
+    uint32_t ulLength;
+    uint32_t ulOffset;
+    uint32_t ulReply;
+    uint32_t ulIndex;
+    BaseType_t xReceived;
+    BaseType_t xCorrupted = pdFALSE;
+    WireStats_t xStats;
+
+    if( prvRecvAll( xSocket, ( uint8_t * ) &ulLength, sizeof( ulLength ) ) != pdPASS )
+    {
+        return;
+    }
+
+    ulLength = FreeRTOS_ntohl( ulLength );
+
+    for( ulOffset = 0; ulOffset < ulLength; ulOffset += ( uint32_t ) xReceived )
+    {
+        xReceived = FreeRTOS_recv( xSocket, ucBlock, sizeof( ucBlock ), 0 );
+
+        if( xReceived <= 0 )
+        {
+            vWireGetStats( &xStats, pdFALSE );
+            configPRINTF( ( "Transfer ended after %u bytes of %u: frames %u, received %u, receive drops %u\n",
+                            ( unsigned ) ulOffset,
+                            ( unsigned ) ulLength,
+                            ( unsigned ) xStats.ullTxFrames,
+                            ( unsigned ) xStats.ullRxFrames,
+                            ( unsigned ) xStats.ullRxDrops ) );
+            return;
+        }
+
+        for( ulIndex = 0; ulIndex < ( uint32_t ) xReceived; ulIndex++ )
+        {
+            if( ucBlock[ ulIndex ] != prvPatternByte( ulOffset + ulIndex ) )
+            {
+                xCorrupted = pdTRUE;
+            }
+        }
+    }
+
+    ulReply = FreeRTOS_htonl( ( xCorrupted == pdFALSE ) ? ulOffset : benchCORRUPTED );
+    ( void ) prvSendAll( xSocket, ( const uint8_t * ) &ulReply, sizeof( ulReply ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvServerTask( void * pvParameters )
+{
+    struct freertos_sockaddr xAddress;
+    Socket_t xListener;
+    Socket_t xSocket;
+    socklen_t xSize = sizeof( xAddress );
+
+    ( void ) pvParameters;
+
+    xListener = prvSocket();
+    prvSetTimeout( xListener, portMAX_DELAY );
+
+    xAddress.sin_port = FreeRTOS_htons( benchPORT );
+    configASSERT( FreeRTOS_bind( xListener, &xAddress, sizeof( xAddress ) ) == 0 );
+
+    /* The connection of the previous scenario may still be closing. */
+    configASSERT( FreeRTOS_listen( xListener, benchLISTEN_BACKLOG ) == 0 );
+
+    /* Runs until the client ends, see main(). */
+    for( ; ; )
+    {
+        xSocket = FreeRTOS_accept( xListener, &xAddress, &xSize );
+
+        if( ( xSocket != NULL ) && ( xSocket != FREERTOS_INVALID_SOCKET ) )
+        {
+            prvSetTimeout( xSocket, pdMS_TO_TICKS( benchTRANSFER_TIMEOUT_MS ) );
+            prvServeTransfer( xSocket );
+            prvClose( xSocket );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    char cLocalPath[ 64 ];
+    char cPeerPath[ 64 ];
+    pid_t xServer;
+    int iStatus;
+
+    if( argc > 1 )
+    {
+        ulTransferBytes = ( uint32_t ) strtoul( argv[ 1 ], NULL, 0 ) * 1024UL;
+    }
+
+    /* The ends of the wire, unique to this run. */
+    ( void ) snprintf( cLocalPath, sizeof( cLocalPath ), "/tmp/freertos_wire_%d_0", ( int ) getpid() );
+    ( void ) snprintf( cPeerPath, sizeof( cPeerPath ), "/tmp/freertos_wire_%d_1", ( int ) getpid() );
+
+    /* Nothing of FreeRTOS may exist yet: each process gets its own copy of
+     * the kernel and of the stack. */
+    xServer = fork();
+
+    if( xServer < 0 )
+    {
+        perror( "fork" );
+        return EXIT_FAILURE;
+    }
+
+    if( xServer == 0 )
+    {
+        /* The server ends with the client. */
+        ( void ) prctl( PR_SET_PDEATHSIG, SIGTERM );
+        xEnd = 1;
+        ( void ) setenv( "FREERTOS_WIRE_LOCAL", cPeerPath, 1 );
+        ( void ) setenv( "FREERTOS_WIRE_PEER", cLocalPath, 1 );
+    }
+    else
+    {
+        ( void ) setenv( "FREERTOS_WIRE_LOCAL", cLocalPath, 1 );
+        ( void ) setenv( "FREERTOS_WIRE_PEER", cPeerPath, 1 );
+    }
+
+    ulNextRand = ( uint32_t ) time( NULL ) ^ ( uint32_t ) getpid();
+
+    ( void ) FreeRTOS_IPInit( ucIPAddresses[ xEnd ],
+                              ucNetMask,
+                              ucGatewayAddress,
+                              ucDNSServerAddress,
+                              ucMACAddresses[ xEnd ] );
+
+    /* Returns once the client has run the scenarios. */
+    vTaskStartScheduler();
+
+    if( xServer != 0 )
+    {
+        ( void ) kill( xServer, SIGTERM );
+        ( void ) waitpid( xServer, &iStatus, 0 );
+        ( void ) unlink( cLocalPath );
+        ( void ) unlink( cPeerPath );
+    }
+
+    return iExitCode;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent )
+{
+    static BaseType_t xTaskCreated = pdFALSE;
+
+    if( ( eNetworkEvent == eNetworkUp ) && ( xTaskCreated == pdFALSE ) )
+    {
+        xTaskCreated = pdTRUE;
+        xTaskCreate( ( xEnd == 0 ) ? prvClientTask : prvServerTask,
+                     ( xEnd == 0 ) ? "Client" : "Server",
+                     benchTASK_STACK_SIZE,
+                     NULL,
+                     benchTASK_PRIORITY,
+                     NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
+                                             uint16_t usSourcePort,
+                                             uint32_t ulDestinationAddress,
+                                             uint16_t usDestinationPort )
+{
+    ( void ) ulSourceAddress;
+    ( void ) usSourcePort;
+    ( void ) ulDestinationAddress;
+    ( void ) usDestinationPort;
+
+    return ulRand();
+}
+/*-----------------------------------------------------------*/
+
+void vHostPrintString( const char * pcString )
+{
+    /* A task switched out while it holds the lock of stdout would block every
+     * other task that prints. */
+    vTaskSuspendAll();
+    {
+        ( void ) fputs( pcString, stdout );
+        ( void ) fflush( stdout );
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vLoggingPrintf( const char * pcFormat,
+                     ... )
+{
+    char cMessage[ configLOGGING_MAX_MESSAGE_LENGTH ];
+    va_list xArgs;
+
+    va_start( xArgs, pcFormat );
+    vTaskSuspendAll();
+    {
+        ( void ) vsnprintf( cMessage, sizeof( cMessage ), pcFormat, xArgs );
+    }
+    ( void ) xTaskResumeAll();
+    va_end( xArgs );
+
+    /* Both ends share the terminal. */
+    if( xEnd != 0 )
+    {
+        vHostPrintString( "server: " );
+    }
+
+    vHostPrintString( cMessage );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulRand( void )
+{
+    const uint32_t ulMultiplier = 0x015a4e35UL, ulIncrement = 1UL;
+    uint32_t ulReturn;
+
+    taskENTER_CRITICAL();
+    {
+        ulNextRand = ( ulMultiplier * ulNextRand ) + ulIncrement;
+        ulReturn = ulNextRand;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    uint32_t ulLine )
+{
+    taskDISABLE_INTERRUPTS();
+    ( void ) fprintf( stderr, "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFile );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    /* The tick interrupts the sleep. */
+    ( void ) usleep( benchIDLE_SLEEP_US );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    configPRINTF( ( "ERROR: Malloc failed.\n" ) );
+    configASSERT( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,7 @@
+set(
+    AFR_MANIFEST_SUPPORTED_BOARDS
+    linux
+    CACHE INTERNAL "Supported boards list."
+)
+
+set(AFR_MANIFEST_BOARD_DIR "boards")